@@ -11,6 +11,33 @@
 #       DSP_FILE myfilter.dsp
 #       OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR}/faust_gen
 #   )
+#
+# Vectorized code generation (pair with FaustModule block processing, since
+# vector code only pays off when compute() gets more than one frame):
+#   add_faust_dsp(
+#       TARGET MyModule_Module
+#       DSP_FILE myreverb.dsp
+#       VECTORIZE
+#       VECTOR_SIZE 32
+#   )
+#
+# Fast-math tier for exp/log/pow/sin/cos/tanh (see faust/vcvrack.cpp):
+#   add_faust_dsp(TARGET MyModule_Module DSP_FILE mybell.dsp FAST_MATH MODERATE)
+#
+# Delay lines and tables allocated from the plugin-wide arena instead of being
+# embedded in every instance (Faust -mem, see src/common/FaustArena.hpp):
+#   add_faust_dsp(TARGET MyModule_Module DSP_FILE myreverb.dsp MEMORY_MANAGER)
+#
+# Each DSP also gets <dsp>_params.hpp next to the generated header, with
+# constexpr parameter indices and ranges (see cmake/FaustParams.cmake).
+#
+# One .dsp can be compiled several times with different entry points, e.g. a
+# unit per voice (OUTPUT_NAME is then used for the headers and properties):
+#   add_faust_dsp(TARGET MyModule_Module DSP_FILE drums.dsp
+#                 OUTPUT_NAME drums_kick OPTIONS -pn kick_voice)
+#
+# Per-module options can also be overridden at configure time for
+# benchmarking, e.g. -DFAUST_OPTIONS_big_reverb="-vec;-vs;16;-lv;1"
 
 # Find the faust executable
 find_program(FAUST_EXECUTABLE
@@ -39,21 +66,58 @@ endif()
 set(FAUST_ARCHITECTURE_FILE "${CMAKE_SOURCE_DIR}/faust/vcvrack.cpp"
     CACHE FILEPATH "Faust architecture file for VCV Rack")
 
+# Generator for <dsp>_params.hpp (run in script mode after Faust)
+set(FAUST_PARAMS_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/FaustParams.cmake")
+
 # Function to add Faust DSP sources to a target
 #
 # add_faust_dsp(
 #     TARGET <target_name>          # Required: CMake target to add sources to
 #     DSP_FILE <file.dsp>           # Required: Faust DSP source file
 #     [OUTPUT_DIR <dir>]            # Optional: Output directory (default: CMAKE_CURRENT_BINARY_DIR/faust_gen)
+#     [OUTPUT_NAME <name>]          # Optional: Generated header name (default: filename without extension)
 #     [CLASS_NAME <name>]           # Optional: Generated class name (default: filename without extension)
 #     [LIBRARY_PATH <dir>]          # Optional: Additional include path for Faust libraries
+#     [VECTORIZE]                   # Optional: Vector code (-vec)
+#     [VECTOR_SIZE <n>]             # Optional: Vector size (-vs, implies VECTORIZE)
+#     [LOOP_VARIANT <0|1>]          # Optional: Vector loop variant (-lv, implies VECTORIZE)
+#     [FUN_TASKS]                   # Optional: Separate function per task (-fun, implies VECTORIZE)
+#     [MAX_COPY_DELAY <n>]          # Optional: Max delay copied instead of ring-buffered (-mcd)
+#     [DELAY_LINE_THRESHOLD <n>]    # Optional: Power-of-two delay line threshold (-dlt)
+#     [FAST_MATH <tier>]            # Optional: EXACT (default), MODERATE or AGGRESSIVE
+#     [MEMORY_MANAGER]              # Optional: Arena-allocated buffers (-mem)
+#     [OPTIONS <args>...]           # Optional: Any other Faust compiler options
 # )
+#
+# The resulting code-generation options are recorded in the global property
+# FAUST_CODEGEN_OPTIONS_<output name> so other targets generating the same DSP
+# (e.g. the test harness) stay in sync, and the architecture file to use in
+# FAUST_ARCHITECTURE_FILE_<output name>.
+
+# Architecture file with a fast-math tier and memory mode baked in. The
+# generated header has to carry both itself, since the test harness includes
+# every DSP header in a single translation unit.
+function(faust_variant_architecture_file TIER MEMORY OUT_VAR)
+    set(VARIANT_ARCH "${CMAKE_BINARY_DIR}/faust_arch/vcvrack_fm${TIER}")
+    set(DEFINES "#define FAUST_FAST_MATH_TIER ${TIER}\n")
+    if(MEMORY)
+        string(APPEND VARIANT_ARCH "_mem")
+        string(APPEND DEFINES "#define FAUST_MEMORY_MANAGER 1\n")
+    endif()
+    string(APPEND VARIANT_ARCH ".cpp")
+    file(READ "${FAUST_ARCHITECTURE_FILE}" ARCH_CONTENT)
+    file(WRITE "${VARIANT_ARCH}.tmp" "${DEFINES}${ARCH_CONTENT}")
+    configure_file("${VARIANT_ARCH}.tmp" "${VARIANT_ARCH}" COPYONLY)
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${FAUST_ARCHITECTURE_FILE}")
+    set(${OUT_VAR} "${VARIANT_ARCH}" PARENT_SCOPE)
+endfunction()
+
 function(add_faust_dsp)
     cmake_parse_arguments(
         FAUST
-        ""
-        "TARGET;DSP_FILE;OUTPUT_DIR;CLASS_NAME;LIBRARY_PATH"
-        ""
+        "VECTORIZE;FUN_TASKS;MEMORY_MANAGER"
+        "TARGET;DSP_FILE;OUTPUT_DIR;OUTPUT_NAME;CLASS_NAME;LIBRARY_PATH;VECTOR_SIZE;LOOP_VARIANT;MAX_COPY_DELAY;DELAY_LINE_THRESHOLD;FAST_MATH"
+        "OPTIONS"
         ${ARGN}
     )
 
@@ -70,6 +134,11 @@ function(add_faust_dsp)
     get_filename_component(DSP_FILE_ABS "${FAUST_DSP_FILE}" ABSOLUTE)
     get_filename_component(DSP_NAME "${FAUST_DSP_FILE}" NAME_WE)
 
+    # Default output name from filename
+    if(NOT FAUST_OUTPUT_NAME)
+        set(FAUST_OUTPUT_NAME "${DSP_NAME}")
+    endif()
+
     # Default output directory
     if(NOT FAUST_OUTPUT_DIR)
         set(FAUST_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/faust_gen")
@@ -80,18 +149,76 @@ function(add_faust_dsp)
         set(FAUST_CLASS_NAME "${DSP_NAME}")
     endif()
 
-    # Output file path
-    set(OUTPUT_HPP "${FAUST_OUTPUT_DIR}/${DSP_NAME}.hpp")
+    # Output file paths
+    set(OUTPUT_HPP "${FAUST_OUTPUT_DIR}/${FAUST_OUTPUT_NAME}.hpp")
+    set(PARAMS_HPP "${FAUST_OUTPUT_DIR}/${FAUST_OUTPUT_NAME}_params.hpp")
 
     # Create output directory
     file(MAKE_DIRECTORY "${FAUST_OUTPUT_DIR}")
 
+    # Code-generation options
+    set(CODEGEN_ARGS "")
+    if(FAUST_VECTOR_SIZE OR DEFINED FAUST_LOOP_VARIANT OR FAUST_FUN_TASKS)
+        set(FAUST_VECTORIZE TRUE)
+    endif()
+    if(FAUST_VECTORIZE)
+        list(APPEND CODEGEN_ARGS -vec)
+        if(FAUST_VECTOR_SIZE)
+            list(APPEND CODEGEN_ARGS -vs ${FAUST_VECTOR_SIZE})
+        endif()
+        if(DEFINED FAUST_LOOP_VARIANT)
+            list(APPEND CODEGEN_ARGS -lv ${FAUST_LOOP_VARIANT})
+        endif()
+        if(FAUST_FUN_TASKS)
+            list(APPEND CODEGEN_ARGS -fun)
+        endif()
+    endif()
+    if(DEFINED FAUST_MAX_COPY_DELAY)
+        list(APPEND CODEGEN_ARGS -mcd ${FAUST_MAX_COPY_DELAY})
+    endif()
+    if(DEFINED FAUST_DELAY_LINE_THRESHOLD)
+        list(APPEND CODEGEN_ARGS -dlt ${FAUST_DELAY_LINE_THRESHOLD})
+    endif()
+    list(APPEND CODEGEN_ARGS ${FAUST_OPTIONS})
+
+    # Fast-math tier: EXACT leaves libm calls alone (no -fm)
+    set(TIER 0)
+    if(FAUST_FAST_MATH AND NOT FAUST_FAST_MATH STREQUAL "EXACT")
+        if(FAUST_FAST_MATH STREQUAL "MODERATE")
+            set(TIER 1)
+        elseif(FAUST_FAST_MATH STREQUAL "AGGRESSIVE")
+            set(TIER 2)
+        else()
+            message(FATAL_ERROR "add_faust_dsp: FAST_MATH must be EXACT, MODERATE or AGGRESSIVE (got ${FAUST_FAST_MATH})")
+        endif()
+        list(APPEND CODEGEN_ARGS -fm arch)
+    endif()
+
+    set(ARCH_FILE "${FAUST_ARCHITECTURE_FILE}")
+    if(TIER GREATER 0 OR FAUST_MEMORY_MANAGER)
+        faust_variant_architecture_file(${TIER} "${FAUST_MEMORY_MANAGER}" ARCH_FILE)
+    endif()
+
+    # Configure-time override (for benchmarking modes without editing CMakeLists)
+    if(DEFINED FAUST_OPTIONS_${FAUST_OUTPUT_NAME})
+        set(CODEGEN_ARGS ${FAUST_OPTIONS_${FAUST_OUTPUT_NAME}})
+    endif()
+
+    # Kept out of the override: the architecture file depends on it
+    if(FAUST_MEMORY_MANAGER)
+        list(APPEND CODEGEN_ARGS -mem)
+    endif()
+
+    set_property(GLOBAL PROPERTY FAUST_CODEGEN_OPTIONS_${FAUST_OUTPUT_NAME} "${CODEGEN_ARGS}")
+    set_property(GLOBAL PROPERTY FAUST_ARCHITECTURE_FILE_${FAUST_OUTPUT_NAME} "${ARCH_FILE}")
+
     if(FAUST_FOUND)
         # Build Faust compiler arguments
         set(FAUST_ARGS
             -i                                      # Inline all code
-            -a "${FAUST_ARCHITECTURE_FILE}"         # Use VCV Rack architecture
+            -a "${ARCH_FILE}"                       # Use VCV Rack architecture
             -o "${OUTPUT_HPP}"                      # Output file
+            ${CODEGEN_ARGS}                         # Vectorization etc.
         )
 
         # Add library path if provided
@@ -109,26 +236,39 @@ function(add_faust_dsp)
         # Note: We don't use -cn to let Faust use the default 'mydsp' class name
         # which our VCVRackDSP wrapper expects
         add_custom_command(
-            OUTPUT "${OUTPUT_HPP}"
+            OUTPUT "${OUTPUT_HPP}" "${PARAMS_HPP}"
             COMMAND ${FAUST_EXECUTABLE} ${FAUST_ARGS}
-            DEPENDS "${DSP_FILE_ABS}" "${FAUST_ARCHITECTURE_FILE}"
-            COMMENT "Faust: Compiling ${DSP_NAME}.dsp -> ${DSP_NAME}.hpp"
+            COMMAND ${CMAKE_COMMAND} -DFAUST_HPP=${OUTPUT_HPP} -DPARAMS_HPP=${PARAMS_HPP}
+                    -DDSP_NAME=${FAUST_OUTPUT_NAME} -P ${FAUST_PARAMS_SCRIPT}
+            DEPENDS "${DSP_FILE_ABS}" "${ARCH_FILE}" "${FAUST_PARAMS_SCRIPT}"
+            COMMENT "Faust: Compiling ${DSP_NAME}.dsp -> ${FAUST_OUTPUT_NAME}.hpp"
             VERBATIM
         )
 
-        message(STATUS "Faust DSP: ${DSP_NAME}.dsp -> ${OUTPUT_HPP}")
+        if(CODEGEN_ARGS)
+            message(STATUS "Faust DSP: ${DSP_NAME}.dsp -> ${OUTPUT_HPP} (${CODEGEN_ARGS})")
+        else()
+            message(STATUS "Faust DSP: ${DSP_NAME}.dsp -> ${OUTPUT_HPP}")
+        endif()
 
-        # Add generated header as source (triggers generation)
-        target_sources(${FAUST_TARGET} PRIVATE "${OUTPUT_HPP}")
+        # Add generated headers as sources (triggers generation)
+        target_sources(${FAUST_TARGET} PRIVATE "${OUTPUT_HPP}" "${PARAMS_HPP}")
 
         # Add output directory to include path
         target_include_directories(${FAUST_TARGET} PRIVATE "${FAUST_OUTPUT_DIR}")
     else()
         # Check if pre-generated file exists in source tree
-        set(SRC_GENERATED_HPP "${CMAKE_CURRENT_SOURCE_DIR}/${DSP_NAME}.hpp")
+        set(SRC_GENERATED_HPP "${CMAKE_CURRENT_SOURCE_DIR}/${FAUST_OUTPUT_NAME}.hpp")
         if(EXISTS "${SRC_GENERATED_HPP}")
             message(STATUS "Using pre-generated Faust DSP: ${SRC_GENERATED_HPP}")
-            # Just add include path - the pre-generated file is in source tree
+            # The pre-generated file is in the source tree; its parameter
+            # indices are generated at configure time
+            execute_process(
+                COMMAND ${CMAKE_COMMAND} -DFAUST_HPP=${SRC_GENERATED_HPP} -DPARAMS_HPP=${PARAMS_HPP}
+                        -DDSP_NAME=${FAUST_OUTPUT_NAME} -P ${FAUST_PARAMS_SCRIPT}
+            )
+            set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${SRC_GENERATED_HPP}")
+            target_include_directories(${FAUST_TARGET} PRIVATE "${FAUST_OUTPUT_DIR}")
         else()
             message(WARNING "")
             message(WARNING "Faust compiler not found and no pre-generated file!")
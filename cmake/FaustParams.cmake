@@ -0,0 +1,148 @@
+# FaustParams.cmake - Compile-time parameter indices for a Faust DSP
+#
+# Script mode, run after Faust has generated <dsp>.hpp:
+#   cmake -DFAUST_HPP=<dir>/<dsp>.hpp -DPARAMS_HPP=<dir>/<dsp>_params.hpp
+#         -DDSP_NAME=<dsp> -P FaustParams.cmake
+#
+# Reads buildUserInterface() from the generated header and writes a
+# FaustParams::<dsp> namespace with one enumerator per parameter, numbered
+# in the order MapUI (faust/vcvrack.cpp) assigns indices, plus each
+# parameter's path and init/min/max:
+#
+#   #include "analog_drums_params.hpp"
+#   namespace FP = FaustParams::analog_drums;
+#   mapParam(BD_DECAY_PARAM, FP::BD_DECAY);
+#   faustDsp.setParamValue(FP::BD_TRIG, trig);
+#   float lo = FP::PARAMS[FP::BD_TUNE].min;
+#
+# Enumerators are the label in upper case (non-identifier characters become
+# '_'). A label that appears in more than one group is qualified with its
+# group path everywhere it appears. Modules bind by name, so a Faust reorder
+# only renumbers the constants and a renamed or removed parameter is a
+# compile error.
+
+foreach(var FAUST_HPP PARAMS_HPP DSP_NAME)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "FaustParams.cmake: ${var} is required")
+    endif()
+endforeach()
+
+file(READ "${FAUST_HPP}" CONTENT)
+
+# ';' and '[' would be read as list syntax
+string(REPLACE ";" "" CONTENT "${CONTENT}")
+string(REPLACE "[" "(" CONTENT "${CONTENT}")
+string(REPLACE "]" ")" CONTENT "${CONTENT}")
+string(REGEX MATCHALL "ui_interface->[A-Za-z]+\\([^\n]*\\)" UI_CALLS "${CONTENT}")
+
+set(FLOAT_RE "FAUSTFLOAT\\(([^)]*)\\)")
+set(GROUPS "")
+set(COUNT 0)
+
+# First pass: collect every parameter and the group paths its label
+# appears under, so qualification does not depend on visit order
+foreach(CALL IN LISTS UI_CALLS)
+    if(CALL MATCHES "^ui_interface->open[A-Za-z]*Box\\(\"([^\"]*)\"")
+        list(APPEND GROUPS "${CMAKE_MATCH_1}")
+        continue()
+    elseif(CALL MATCHES "^ui_interface->closeBox\\(")
+        list(LENGTH GROUPS DEPTH)
+        if(DEPTH GREATER 0)
+            list(REMOVE_AT GROUPS -1)
+        endif()
+        continue()
+    elseif(CALL MATCHES "^ui_interface->add(Button|CheckButton)\\(\"([^\"]*)\"")
+        set(LABEL "${CMAKE_MATCH_2}")
+        set(INIT "0.0f")
+        set(MIN "0.0f")
+        set(MAX "1.0f")
+    elseif(CALL MATCHES "^ui_interface->add(HorizontalSlider|VerticalSlider|NumEntry)\\(\"([^\"]*)\", *&[A-Za-z0-9_]+, *${FLOAT_RE}, *${FLOAT_RE}, *${FLOAT_RE}")
+        set(LABEL "${CMAKE_MATCH_2}")
+        set(INIT "${CMAKE_MATCH_3}")
+        set(MIN "${CMAKE_MATCH_4}")
+        set(MAX "${CMAKE_MATCH_5}")
+    else()
+        # Bargraphs (outputs) and declare() are not parameters
+        continue()
+    endif()
+
+    # Path exactly as MapUI builds it
+    set(GROUP_PATH "")
+    foreach(GROUP IN LISTS GROUPS)
+        string(APPEND GROUP_PATH "/${GROUP}")
+    endforeach()
+
+    string(MAKE_C_IDENTIFIER "${LABEL}" NAME)
+    string(TOUPPER "${NAME}" NAME)
+    if(NOT DEFINED LABEL_GROUP_${NAME})
+        set(LABEL_GROUP_${NAME} "${GROUP_PATH}")
+    elseif(NOT LABEL_GROUP_${NAME} STREQUAL GROUP_PATH)
+        set(LABEL_SHARED_${NAME} TRUE)
+    endif()
+
+    set(PARAM_${COUNT}_LABEL "${LABEL}")
+    set(PARAM_${COUNT}_NAME "${NAME}")
+    set(PARAM_${COUNT}_GROUPS "${GROUPS}")
+    set(PARAM_${COUNT}_ENTRY "{\"${GROUP_PATH}/${LABEL}\", ${INIT}, ${MIN}, ${MAX}}")
+    math(EXPR COUNT "${COUNT} + 1")
+endforeach()
+
+# Second pass: enumerator names, the label, or the group-qualified label
+# for a label that appears in more than one group
+set(NAMES "")
+set(ENTRIES "")
+set(ENUM_LINES "")
+if(COUNT GREATER 0)
+    math(EXPR LAST "${COUNT} - 1")
+    foreach(INDEX RANGE ${LAST})
+        set(NAME "${PARAM_${INDEX}_NAME}")
+        if(LABEL_SHARED_${NAME})
+            set(QUALIFIED "${PARAM_${INDEX}_GROUPS}")
+            list(LENGTH QUALIFIED DEPTH)
+            if(DEPTH GREATER 1)
+                list(REMOVE_AT QUALIFIED 0)  # Root box is the DSP name
+            endif()
+            list(APPEND QUALIFIED "${PARAM_${INDEX}_LABEL}")
+            string(REPLACE ";" "_" QUALIFIED "${QUALIFIED}")
+            string(MAKE_C_IDENTIFIER "${QUALIFIED}" NAME)
+            string(TOUPPER "${NAME}" NAME)
+            # A plain label keeps its name wherever it comes
+            if(DEFINED LABEL_GROUP_${NAME} AND NOT LABEL_SHARED_${NAME})
+                set(NAME "${NAME}_${INDEX}")
+            endif()
+        endif()
+        # Still taken (a path that repeats)
+        list(FIND NAMES "${NAME}" CLASH)
+        if(NOT CLASH EQUAL -1)
+            set(NAME "${NAME}_${INDEX}")
+        endif()
+        if(NAME MATCHES "^_[0-9]")
+            set(NAME "P${NAME}")
+        endif()
+        list(APPEND NAMES "${NAME}")
+
+        string(APPEND ENUM_LINES "    ${NAME} = ${INDEX},\n")
+        string(APPEND ENTRIES "    ${PARAM_${INDEX}_ENTRY},\n")
+    endforeach()
+endif()
+
+get_filename_component(SOURCE_NAME "${FAUST_HPP}" NAME)
+string(MAKE_C_IDENTIFIER "${DSP_NAME}" NS)
+
+set(OUT "// Generated by cmake/FaustParams.cmake from ${SOURCE_NAME} - do not edit\n")
+string(APPEND OUT "#pragma once\n\n")
+string(APPEND OUT "namespace FaustParams {\nnamespace ${NS} {\n\n")
+string(APPEND OUT "// Faust parameter indices (MapUI order)\n")
+string(APPEND OUT "enum Param : int {\n${ENUM_LINES}};\n\n")
+string(APPEND OUT "constexpr int NUM_PARAMS = ${COUNT};\n\n")
+string(APPEND OUT "struct ParamInfo {\n")
+string(APPEND OUT "    const char* path;\n    float init;\n    float min;\n    float max;\n};\n")
+if(COUNT GREATER 0)
+    string(APPEND OUT "\nconstexpr ParamInfo PARAMS[NUM_PARAMS] = {\n${ENTRIES}};\n")
+endif()
+string(APPEND OUT "\n} // namespace ${NS}\n} // namespace FaustParams\n")
+
+# Only touch the header when it changes, so dependents don't rebuild
+file(WRITE "${PARAMS_HPP}.tmp" "${OUT}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${PARAMS_HPP}.tmp" "${PARAMS_HPP}")
+file(REMOVE "${PARAMS_HPP}.tmp")
@@ -0,0 +1,99 @@
+# Optional release optimizations: link-time and profile-guided optimization
+#
+#   WIGGLEROOM_LTO=ON         Link-time optimization across CommonLib, the
+#                             *_Module targets and the plugin, so DSP code
+#                             behind the FaustModule boundary can be inlined
+#   WIGGLEROOM_PGO=generate   Instrument every target; build `pgo-train` to
+#                             run the benchmark workloads (faust_bench,
+#                             module_bench) and merge their profile
+#   WIGGLEROOM_PGO=use        Compile with the merged profile
+#
+# Two build trees share the profile through WIGGLEROOM_PGO_DIR:
+#
+#   cmake -B build-pgo -DCMAKE_BUILD_TYPE=Release -DWIGGLEROOM_PGO=generate \
+#         -DWIGGLEROOM_PGO_DIR=$PWD/pgo
+#   cmake --build build-pgo --target pgo-train
+#   cmake -B build -DCMAKE_BUILD_TYPE=Release -DWIGGLEROOM_PGO=use \
+#         -DWIGGLEROOM_PGO_DIR=$PWD/pgo -DWIGGLEROOM_LTO=ON
+#   cmake --build build
+#
+# PGO needs Clang. Its profiles are matched by function, so counts taken in
+# the test executables apply to the same Faust compute() and process() code
+# linked into the plugin. module_bench trains every module from the headers
+# its *_Module target generates (same -pn entry points and OUTPUT_NAME
+# namespaces), so a profile that stops matching the plugin's code shows up
+# as -Wprofile-instr-out-of-date / -Wprofile-instr-unprofiled warnings.
+# GCC keys profiles by object file, and the plugin doesn't share object
+# files with the benchmarks.
+#
+# The instrumented plugin also writes profiles when played in Rack; they
+# land in the same directory and pgo-train merges them in.
+
+option(WIGGLEROOM_LTO "Link-time optimization across the module libraries and plugin" OFF)
+set(WIGGLEROOM_PGO "" CACHE STRING "Profile-guided optimization stage: empty, generate or use")
+set_property(CACHE WIGGLEROOM_PGO PROPERTY STRINGS "" generate use)
+set(WIGGLEROOM_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory for raw and merged PGO profiles")
+set(WIGGLEROOM_PGO_PROFILE "${WIGGLEROOM_PGO_DIR}/wiggleroom.profdata")
+
+if(WIGGLEROOM_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT WIGGLEROOM_LTO_SUPPORTED OUTPUT _ipo_output LANGUAGES CXX)
+    if(NOT WIGGLEROOM_LTO_SUPPORTED)
+        message(WARNING "WIGGLEROOM_LTO: link-time optimization not supported, building without it\n${_ipo_output}")
+    endif()
+endif()
+
+if(WIGGLEROOM_PGO)
+    if(NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        message(FATAL_ERROR "WIGGLEROOM_PGO requires Clang (profiles from the benchmarks have to match the plugin by function)")
+    endif()
+    if(NOT CMAKE_BUILD_TYPE STREQUAL "Release")
+        message(WARNING "WIGGLEROOM_PGO: train and use the profile with CMAKE_BUILD_TYPE=Release")
+    endif()
+
+    if(WIGGLEROOM_PGO STREQUAL "generate")
+        get_filename_component(_compiler_dir ${CMAKE_CXX_COMPILER} DIRECTORY)
+        string(REGEX MATCH "^[0-9]+" _compiler_major "${CMAKE_CXX_COMPILER_VERSION}")
+        find_program(LLVM_PROFDATA
+            NAMES llvm-profdata llvm-profdata-${_compiler_major}
+            HINTS ${_compiler_dir}
+        )
+        if(NOT LLVM_PROFDATA AND APPLE)
+            execute_process(COMMAND xcrun -f llvm-profdata
+                OUTPUT_VARIABLE LLVM_PROFDATA OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+        endif()
+        if(NOT LLVM_PROFDATA)
+            message(FATAL_ERROR "WIGGLEROOM_PGO=generate: llvm-profdata not found (set LLVM_PROFDATA)")
+        endif()
+
+        file(MAKE_DIRECTORY ${WIGGLEROOM_PGO_DIR}/raw)
+        add_compile_options(-fprofile-generate=${WIGGLEROOM_PGO_DIR}/raw)
+        add_link_options(-fprofile-generate=${WIGGLEROOM_PGO_DIR}/raw)
+    elseif(WIGGLEROOM_PGO STREQUAL "use")
+        if(NOT EXISTS ${WIGGLEROOM_PGO_PROFILE})
+            message(FATAL_ERROR "WIGGLEROOM_PGO=use: no profile at ${WIGGLEROOM_PGO_PROFILE} (build pgo-train in a WIGGLEROOM_PGO=generate tree first)")
+        endif()
+        # Profile mismatch warnings stay on: they are how a DSP the training
+        # runs no longer reach shows up
+        add_compile_options(
+            -fprofile-use=${WIGGLEROOM_PGO_PROFILE}
+            -Wno-backend-plugin
+        )
+        add_link_options(-fprofile-use=${WIGGLEROOM_PGO_PROFILE})
+    else()
+        message(FATAL_ERROR "WIGGLEROOM_PGO must be empty, generate or use (got '${WIGGLEROOM_PGO}')")
+    endif()
+endif()
+
+# Turn on link-time optimization for the given targets (no-op unless WIGGLEROOM_LTO)
+function(wiggleroom_enable_lto)
+    if(NOT WIGGLEROOM_LTO OR NOT WIGGLEROOM_LTO_SUPPORTED)
+        return()
+    endif()
+    foreach(target ${ARGN})
+        get_target_property(_type ${target} TYPE)
+        if(NOT _type STREQUAL "INTERFACE_LIBRARY")
+            set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION ON)
+        endif()
+    endforeach()
+endfunction()
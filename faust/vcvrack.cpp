@@ -15,8 +15,22 @@
  Usage:
    faust -i -a vcvrack.cpp mydsp.dsp -o MyDSP.hpp
 
+ Scalar and vector code generation (-vec -vs <n> -lv <0|1> -fun) as well
+ as -mcd/-dlt all produce the same 'mydsp' interface, so the wrapper below
+ is unchanged. Vector code processes compute() in vs-sized chunks and only
+ helps when called with more than one frame (FaustModule block mode).
+
+ Memory-managed code (-mem, add_faust_dsp(... MEMORY_MANAGER)) keeps delay
+ lines and tables out of the class; FAUST_MEMORY_MANAGER is then baked in
+ and the wrapper creates the DSP through the plugin arena (FaustArena.hpp).
+
+ getStateSize() / saveState() / restoreState() copy an instance's whole
+ state (the object plus, with -mem, its arena blocks) to another instance
+ of the same module, for warm-started test renders.
+
  The generated class provides:
-   - init(int sample_rate)
+   - init(int sample_rate) / instanceClear() / setSampleRate(int sample_rate)
+   - getSampleRate()
    - compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs)
    - getNumInputs() / getNumOutputs() / getNumParams()
    - setParamValue(int index, FAUSTFLOAT value)
@@ -30,16 +44,108 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <math.h>
 #include <string>
 #include <vector>
 
-// Fast math function aliases for Faust -fm arch mode
-// These map fast_* functions to standard math functions
+// Fast math functions for Faust -fm arch mode
+//
+// Three accuracy tiers live side by side; each generated header picks one via
+// FAUST_FAST_MATH_TIER (set by add_faust_dsp(... FAST_MATH <tier>)):
+//   0 = Exact       libm, bit-identical to non -fm builds
+//   1 = Moderate    range reduction + polynomial, ~1e-7..1e-6 error
+//   2 = Aggressive  low-order polynomial/rational, ~1e-4 error
+// Error bounds (measured over the stated ranges):
+//   exp2            relative   moderate 3e-7   aggressive 6e-5
+//   exp/exp10       relative   moderate 4e-6   aggressive 6e-5  (|x| < 80)
+//   log2/log/log10  absolute   moderate 1e-6   aggressive 9e-5  (log2 units)
+//   sin/cos         absolute   moderate 8e-7   aggressive 2e-4  (|x| < 10,
+//                   range reduction error grows with |x|, faster under -ffast-math)
+//   tanh            absolute   moderate 2e-7   aggressive 1e-4
+// Out of range inputs clamp instead of producing inf/denormals: exp2 to
+// [-126, 127], log2 to the normal float range (log2(0) = -126).
+// pow() uses exp2(y * log2(x)) for x > 0, so its relative error grows with
+// |y * log2(x)|; zero/negative bases fall back to libm. Functions not listed
+// (inverse trig, rounding, sqrt, ...) are exact in every tier, and the
+// double precision versions always forward to libm.
 // Wrapped in include guard to avoid redefinition when multiple headers are included
 #ifndef FAUST_FAST_MATH_DEFINED
 #define FAUST_FAST_MATH_DEFINED
+namespace FaustFastMath {
+
+// Tier-independent helpers
+namespace Detail {
+inline float bitsToFloat(uint32_t bits) { float f; std::memcpy(&f, &bits, sizeof(f)); return f; }
+inline uint32_t floatToBits(float f) { uint32_t bits; std::memcpy(&bits, &f, sizeof(bits)); return bits; }
+
+// floor() without the libm call (valid for |x| < 2^31)
+inline int floorToInt(float x) {
+    int i = static_cast<int>(x);
+    return i - (x < static_cast<float>(i));
+}
+
+// The kernels below are branch-free (clamps and selects only) so that loops
+// calling them auto-vectorize, which matters most for -vec generated code.
+
+// 2^x: x = k + f with f in [-0.5, 0.5], 2^f from a Taylor polynomial.
+// x is clamped to [-126, 127] (no denormals, no infinities).
+template<int Degree>
+inline float exp2(float x) {
+    x = std::min(std::max(x, -126.0f), 127.0f);
+    int k = floorToInt(x + 0.5f);
+    float f = (x - static_cast<float>(k)) * 0.69314718f;
+    float p;
+    if (Degree >= 6) {
+        p = 1.0f + f * (1.0f + f * (0.5f + f * (0.16666667f + f * (0.041666667f
+            + f * (0.0083333333f + f * 0.0013888889f)))));
+    } else {
+        p = 1.0f + f * (1.0f + f * (0.5f + f * (0.16666667f + f * 0.041666667f)));
+    }
+    return p * bitsToFloat(static_cast<uint32_t>(k + 127) << 23);
+}
+
+// log2(x): x = m * 2^e with m in [sqrt(0.5), sqrt(2)), atanh series in (m-1)/(m+1).
+// x is clamped to the normal float range, so log2(0) = -126 instead of -inf.
+template<int Terms>
+inline float log2(float x) {
+    x = std::min(std::max(x, 1.17549435e-38f), 3.40282347e38f);
+    uint32_t bits = floatToBits(x);
+    int e = static_cast<int>(bits >> 23) - 127;
+    float m = bitsToFloat((bits & 0x007fffff) | 0x3f800000);
+    bool high = m > 1.41421356f;
+    m = high ? m * 0.5f : m;
+    e += high;
+    float t = (m - 1.0f) / (m + 1.0f);
+    float t2 = t * t;
+    float p;
+    if (Terms >= 4) {
+        p = 1.0f + t2 * (0.33333333f + t2 * (0.2f + t2 * 0.14285714f));
+    } else {
+        p = 1.0f + t2 * 0.33333333f;
+    }
+    return static_cast<float>(e) + 2.8853901f * t * p;  // 2/ln(2)
+}
+
+// sin(x): reduce to [-pi, pi], fold to [-pi/2, pi/2], odd Taylor polynomial
+template<int Degree>
+inline float sin(float x) {
+    float k = static_cast<float>(floorToInt(x * 0.15915494f + 0.5f));
+    float r = (x - k * 6.28125f) - k * 0.0019353072f;  // Two-part 2*pi
+    r = (r > 1.5707964f) ? 3.1415927f - r : r;
+    r = (r < -1.5707964f) ? -3.1415927f - r : r;
+    float r2 = r * r;
+    if (Degree >= 11) {
+        return r * (1.0f + r2 * (-0.16666667f + r2 * (0.0083333333f + r2 * (-0.00019841270f
+            + r2 * (2.7557319e-6f + r2 * -2.5052108e-8f)))));
+    }
+    return r * (1.0f + r2 * (-0.16666667f + r2 * (0.0083333333f + r2 * -0.00019841270f)));
+}
+} // namespace Detail
+
+// Tier 0: libm
+namespace Exact {
 inline float fast_acosf(float x) { return std::acos(x); }
 inline float fast_asinf(float x) { return std::asin(x); }
 inline float fast_atanf(float x) { return std::atan(x); }
@@ -65,8 +171,80 @@ inline float fast_sinhf(float x) { return std::sinh(x); }
 inline float fast_sqrtf(float x) { return std::sqrt(x); }
 inline float fast_tanf(float x) { return std::tan(x); }
 inline float fast_tanhf(float x) { return std::tanh(x); }
-
-// Double precision versions
+} // namespace Exact
+
+// Tiers 1 and 2 share everything except the kernel precision
+namespace Detail {
+template<int ExpDegree, int LogTerms, int SinDegree, bool RationalTanh>
+struct Approx {
+    static float exp2f(float x) { return Detail::exp2<ExpDegree>(x); }
+    static float log2f(float x) { return Detail::log2<LogTerms>(x); }
+    static float sinf(float x) { return Detail::sin<SinDegree>(x); }
+    static float cosf(float x) { return Detail::sin<SinDegree>(x + 1.5707964f); }
+    static float powf(float x, float y) {
+        // Negative bases need libm's integer-exponent rules
+        if (x < 0.0f) return std::pow(x, y);
+        return (x == 0.0f) ? std::pow(x, y) : exp2f(y * log2f(x));
+    }
+    static float tanhf(float x) {
+        if (RationalTanh) {
+            // Lambert continued fraction (7/6), clamped where it crosses +/-1
+            x = std::min(std::max(x, -4.97f), 4.97f);
+            float x2 = x * x;
+            float y = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)))
+                / (135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f)));
+            return std::min(std::max(y, -1.0f), 1.0f);
+        }
+        x = std::min(std::max(x, -9.0f), 9.0f);
+        float e = exp2f(x * 2.8853901f);  // e^(2x)
+        return (e - 1.0f) / (e + 1.0f);
+    }
+};
+} // namespace Detail
+
+#define FAUST_FAST_MATH_TIER_FUNCTIONS(Impl) \
+inline float fast_acosf(float x) { return std::acos(x); } \
+inline float fast_asinf(float x) { return std::asin(x); } \
+inline float fast_atanf(float x) { return std::atan(x); } \
+inline float fast_atan2f(float y, float x) { return std::atan2(y, x); } \
+inline float fast_ceilf(float x) { return std::ceil(x); } \
+inline float fast_cosf(float x) { return Impl::cosf(x); } \
+inline float fast_coshf(float x) { float e = Impl::exp2f(x * 1.4426950f); return 0.5f * (e + 1.0f / e); } \
+inline float fast_expf(float x) { return Impl::exp2f(x * 1.4426950f); } \
+inline float fast_exp2f(float x) { return Impl::exp2f(x); } \
+inline float fast_exp10f(float x) { return Impl::exp2f(x * 3.3219281f); } \
+inline float fast_fabsf(float x) { return std::fabs(x); } \
+inline float fast_floorf(float x) { return std::floor(x); } \
+inline float fast_fmodf(float x, float y) { return std::fmod(x, y); } \
+inline float fast_logf(float x) { return Impl::log2f(x) * 0.69314718f; } \
+inline float fast_log2f(float x) { return Impl::log2f(x); } \
+inline float fast_log10f(float x) { return Impl::log2f(x) * 0.30103000f; } \
+inline float fast_powf(float x, float y) { return Impl::powf(x, y); } \
+inline float fast_remainderf(float x, float y) { return std::remainder(x, y); } \
+inline float fast_rintf(float x) { return std::rint(x); } \
+inline float fast_roundf(float x) { return std::round(x); } \
+inline float fast_sinf(float x) { return Impl::sinf(x); } \
+inline float fast_sinhf(float x) { float e = Impl::exp2f(x * 1.4426950f); return 0.5f * (e - 1.0f / e); } \
+inline float fast_sqrtf(float x) { return std::sqrt(x); } \
+inline float fast_tanf(float x) { return Impl::sinf(x) / Impl::cosf(x); } \
+inline float fast_tanhf(float x) { return Impl::tanhf(x); }
+
+// Tier 1: polynomial, close to float precision
+namespace Moderate {
+using Impl = Detail::Approx<6, 4, 11, false>;
+FAUST_FAST_MATH_TIER_FUNCTIONS(Impl)
+} // namespace Moderate
+
+// Tier 2: low-order, for CPU-bound patches
+namespace Aggressive {
+using Impl = Detail::Approx<4, 2, 7, true>;
+FAUST_FAST_MATH_TIER_FUNCTIONS(Impl)
+} // namespace Aggressive
+
+#undef FAUST_FAST_MATH_TIER_FUNCTIONS
+
+// Double precision versions (libm in every tier)
+namespace Double {
 inline double fast_acos(double x) { return std::acos(x); }
 inline double fast_asin(double x) { return std::asin(x); }
 inline double fast_atan(double x) { return std::atan(x); }
@@ -92,8 +270,24 @@ inline double fast_sinh(double x) { return std::sinh(x); }
 inline double fast_sqrt(double x) { return std::sqrt(x); }
 inline double fast_tan(double x) { return std::tan(x); }
 inline double fast_tanh(double x) { return std::tanh(x); }
+} // namespace Double
+
+} // namespace FaustFastMath
 #endif // FAUST_FAST_MATH_DEFINED
 
+// Accuracy tier for this header (0 = exact, 1 = moderate, 2 = aggressive)
+#ifndef FAUST_FAST_MATH_TIER
+#define FAUST_FAST_MATH_TIER 0
+#endif
+
+// Memory-managed (-mem) code for this header: buffers come from the arena
+#ifndef FAUST_MEMORY_MANAGER
+#define FAUST_MEMORY_MANAGER 0
+#endif
+#if FAUST_MEMORY_MANAGER
+#include "FaustArena.hpp"
+#endif
+
 // Faust compatibility types
 #ifndef FAUSTFLOAT
 #define FAUSTFLOAT float
@@ -112,6 +306,16 @@ inline double fast_tanh(double x) { return std::tanh(x); }
 namespace FaustGenerated {
 namespace FAUST_CONCAT(NS_, FAUST_MODULE_NAME) {
 
+// fast_* functions used by -fm arch code
+#if FAUST_FAST_MATH_TIER >= 2
+using namespace FaustFastMath::Aggressive;
+#elif FAUST_FAST_MATH_TIER == 1
+using namespace FaustFastMath::Moderate;
+#else
+using namespace FaustFastMath::Exact;
+#endif
+using namespace FaustFastMath::Double;
+
 // Minimal Meta interface (for metadata declarations in DSP)
 struct Meta {
     virtual void declare(const char* key, const char* value) = 0;
@@ -163,7 +367,9 @@ private:
     };
 
     std::vector<ParamInfo> params;
-    std::map<std::string, int> pathToIndex;
+    // Transparent comparators so lookups by const char* don't allocate
+    std::map<std::string, int, std::less<>> pathToIndex;
+    std::map<std::string, int, std::less<>> labelToIndex;  // First param with each label
     std::vector<std::string> pathStack;
 
     std::string buildPath(const char* label) {
@@ -187,6 +393,7 @@ private:
         int index = static_cast<int>(params.size());
         params.push_back(info);
         pathToIndex[info.path] = index;
+        labelToIndex.emplace(label, index);
 
         // Initialize to default value
         *zone = init;
@@ -282,22 +489,16 @@ public:
         return 0.0f;
     }
 
+    // Look up by full path or by label alone. With compile-time indices
+    // (<dsp>_params.hpp, see cmake/FaustParams.cmake) modules don't need this.
     int getParamIndex(const char* path) const {
         auto it = pathToIndex.find(path);
         if (it != pathToIndex.end()) {
             return it->second;
         }
-        // Try matching just the label (last part of path)
-        std::string pathStr(path);
-        for (size_t i = 0; i < params.size(); i++) {
-            const std::string& paramPath = params[i].path;
-            size_t lastSlash = paramPath.rfind('/');
-            std::string label = (lastSlash != std::string::npos)
-                ? paramPath.substr(lastSlash + 1)
-                : paramPath;
-            if (label == pathStr) {
-                return static_cast<int>(i);
-            }
+        auto labelIt = labelToIndex.find(path);
+        if (labelIt != labelToIndex.end()) {
+            return labelIt->second;
         }
         return -1;
     }
@@ -334,13 +535,80 @@ public:
 // Generated DSP class from Faust
 <<includeclass>>
 
+#if FAUST_MEMORY_MANAGER
+// Arena block handed to a DSP instance (see VCVRackDSP snapshots)
+struct ArenaBlock {
+    void* ptr;
+    size_t size;
+};
+
+// Forwards to the plugin arena. While VCVRackDSP is creating an instance,
+// allocate() also records into the calling thread's block list; while it
+// is restoring a snapshot, allocate() hands the recorded blocks back in
+// the same order instead, so memoryCreate() re-points a copied object at
+// its own buffers.
+struct RecordingArena : dsp_memory_manager {
+    struct Replay {
+        const std::vector<ArenaBlock>* blocks;
+        size_t next;
+    };
+    static std::vector<ArenaBlock>*& recording() {
+        static thread_local std::vector<ArenaBlock>* blocks = nullptr;
+        return blocks;
+    }
+    static Replay*& replaying() {
+        static thread_local Replay* replay = nullptr;
+        return replay;
+    }
+    void* allocate(size_t size) override {
+        if (Replay* replay = replaying()) {
+            return (*replay->blocks)[replay->next++].ptr;
+        }
+        void* ptr = WiggleRoom::FaustArena::instance().allocate(size);
+        if (recording()) recording()->push_back({ptr, size});
+        return ptr;
+    }
+    void destroy(void* ptr) override {
+        WiggleRoom::FaustArena::instance().destroy(ptr);
+    }
+};
+
+inline RecordingArena recordingArena;
+inline dsp_memory_manager* mydsp::fManager = &recordingArena;
+#endif
+
 // VCV Rack wrapper class - wraps the generated 'mydsp' class
 class VCVRackDSP {
 private:
+#if FAUST_MEMORY_MANAGER
+    // Arena blocks allocated for this instance, in allocation order (the
+    // class itself and its delay lines/tables), recorded for snapshots
+    static mydsp* createRecorded(std::vector<ArenaBlock>& blocks) {
+        RecordingArena::recording() = &blocks;
+        mydsp* created = mydsp::create();
+        RecordingArena::recording() = nullptr;
+        return created;
+    }
+
+    std::vector<ArenaBlock> blocks;
+    mydsp& dsp = *createRecorded(blocks);
+#else
     mydsp dsp;
+#endif
     MapUI ui;
     int numInputs;
     int numOutputs;
+    int sampleRate = 0;
+
+    // Static tables are shared by every instance of the class, so they are
+    // built once, by the first full init(), and never rebuilt while other
+    // instances (possibly at other rates) read them. The plugin's DSPs only
+    // have rate-independent class tables (os.osc's sine table); a DSP whose
+    // rdtable content depends on ma.SR must not rely on them.
+    static void classInitOnce(int sample_rate) {
+        static const bool built = (mydsp::classInit(sample_rate), true);
+        (void)built;
+    }
 
 public:
     VCVRackDSP() : numInputs(0), numOutputs(0) {
@@ -349,8 +617,95 @@ public:
         dsp.buildUserInterface(&ui);
     }
 
+    ~VCVRackDSP() {
+#if FAUST_MEMORY_MANAGER
+        mydsp::destroy(&dsp);
+#endif
+    }
+
+    // The UI map points into this instance's parameter zones
+    VCVRackDSP(const VCVRackDSP&) = delete;
+    VCVRackDSP& operator=(const VCVRackDSP&) = delete;
+
+    // Full initialization: constants, default parameters, cleared state
     void init(int sample_rate) {
-        dsp.init(sample_rate);
+        classInitOnce(sample_rate);
+        dsp.instanceInit(sample_rate);
+        sampleRate = sample_rate;
+    }
+
+    // Reset delay lines/filter state without touching parameters
+    void instanceClear() {
+        dsp.instanceClear();
+    }
+
+    // Change the sample rate, keeping parameter values. Instance constants
+    // are only recomputed for a new rate; the class tables are left alone.
+    // With clear = false the caller is responsible for calling
+    // instanceClear() before the next compute().
+    void setSampleRate(int sample_rate, bool clear = true) {
+        if (sample_rate != sampleRate) {
+            dsp.instanceConstants(sample_rate);
+            sampleRate = sample_rate;
+        }
+        if (clear) dsp.instanceClear();
+    }
+
+    int getSampleRate() const { return sampleRate; }
+
+    // ========== State Snapshots ==========
+    //
+    // The whole DSP state (delay lines, filter memories, parameters) as a
+    // flat copy: warm a voice up once, save it, and restore it into any
+    // instance of the same DSP initialized at the same sample rate (the
+    // class tables are shared, not part of the state).
+
+    // Bytes saveState() writes
+    size_t getStateSize() const {
+#if FAUST_MEMORY_MANAGER
+        size_t size = sizeof(mydsp);
+        for (const ArenaBlock& block : blocks) {
+            if (block.ptr != static_cast<const void*>(&dsp)) size += block.size;
+        }
+        return size;
+#else
+        return sizeof(mydsp);
+#endif
+    }
+
+    void saveState(void* buffer) const {
+        unsigned char* out = static_cast<unsigned char*>(buffer);
+        std::memcpy(out, static_cast<const void*>(&dsp), sizeof(mydsp));
+#if FAUST_MEMORY_MANAGER
+        out += sizeof(mydsp);
+        for (const ArenaBlock& block : blocks) {
+            if (block.ptr == static_cast<const void*>(&dsp)) continue;
+            std::memcpy(out, block.ptr, block.size);
+            out += block.size;
+        }
+#endif
+    }
+
+    void restoreState(const void* buffer) {
+        const unsigned char* in = static_cast<const unsigned char*>(buffer);
+#if FAUST_MEMORY_MANAGER
+        // The copied object points at the source's buffers; replaying this
+        // instance's blocks (after the object's own, blocks[0]) through
+        // memoryCreate() points it back at its own
+        std::memcpy(static_cast<void*>(&dsp), in, sizeof(mydsp));
+        RecordingArena::Replay replay{&blocks, 1};
+        RecordingArena::replaying() = &replay;
+        dsp.memoryCreate();
+        RecordingArena::replaying() = nullptr;
+        in += sizeof(mydsp);
+        for (const ArenaBlock& block : blocks) {
+            if (block.ptr == static_cast<const void*>(&dsp)) continue;
+            std::memcpy(block.ptr, in, block.size);
+            in += block.size;
+        }
+#else
+        std::memcpy(static_cast<void*>(&dsp), in, sizeof(mydsp));
+#endif
     }
 
     void compute(int count, FAUSTFLOAT** inputs, FAUSTFLOAT** outputs) {
@@ -403,3 +758,5 @@ using VCVRackDSP = FaustGenerated::FAUST_CONCAT(NS_, FAUST_MODULE_NAME)::VCVRack
 
 // Clean up the module name macro so it can be redefined for the next include
 #undef FAUST_MODULE_NAME
+#undef FAUST_FAST_MATH_TIER
+#undef FAUST_MEMORY_MANAGER
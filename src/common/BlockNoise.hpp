@@ -0,0 +1,176 @@
+#pragma once
+
+#include "rack.hpp"
+#include "Random.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Block noise source: four xorshift32 lanes per step
+ *
+ * Stands in for Faust's no.noise where a module feeds noise to its DSP as
+ * an input. fill() writes whole blocks, four white samples per step;
+ * next() hands out one sample at a time from an internal block of BLOCK
+ * samples and refills it when it runs out.
+ *
+ * The four lanes are seeded from one 64-bit seed through SplitMix64, so a
+ * seeded source is reproducible (tests, renders); the default constructor
+ * uses randomSeed(). The lanes step in one SSE2 register where available
+ * and in a plain loop elsewhere, with the same output.
+ *
+ * Colors:
+ *   WHITE   uniform in [-1, 1)
+ *   PINK    -3 dB/octave, Paul Kellet's economy filter on the white block,
+ *           scaled to roughly the white level
+ *   VELVET  sparse +-1 impulses, one at a random position in every grid
+ *           period (setVelvetDensity(), impulses per second); the sign
+ *           comes from a state bit the position does not use
+ *
+ *   BlockNoise noise;                              // or BlockNoise noise(seed)
+ *   float n = noise.next();                        // every sample
+ ******************************************************************************/
+
+class BlockNoise {
+public:
+    enum Color {
+        WHITE,
+        PINK,
+        VELVET
+    };
+
+    static constexpr int BLOCK = 64;
+
+    BlockNoise() {
+        seed(randomSeed());
+    }
+
+    explicit BlockNoise(uint64_t seedValue) {
+        seed(seedValue);
+    }
+
+    void seed(uint64_t seedValue) {
+        uint32_t lanes[4];
+        uint64_t z = seedValue;
+        for (int i = 0; i < 4; i++) {
+            z += 0x9E3779B97F4A7C15ULL;
+            lanes[i] = static_cast<uint32_t>(RandomDetail::mix64(z));
+            if (lanes[i] == 0) lanes[i] = 0x6D2B79F5u;   // xorshift's one fixed point
+        }
+        for (int i = 0; i < 4; i++) state[i] = lanes[i];
+        pink0 = pink1 = pink2 = 0.f;
+        velvetCounter = 0;
+        position = BLOCK;
+    }
+
+    void setColor(Color c) {
+        color = c;
+    }
+
+    Color getColor() const {
+        return color;
+    }
+
+    void setVelvetDensity(float perSecond, float sampleRate) {
+        velvetPeriod = std::max(1, static_cast<int>(sampleRate / std::max(perSecond, 1.f)));
+        velvetCounter = 0;
+    }
+
+    float next() {
+        if (position == BLOCK) {
+            fill(block, BLOCK);
+            position = 0;
+        }
+        return block[position++];
+    }
+
+    // count samples of the current color
+    void fill(float* out, int count) {
+        if (color == VELVET) {
+            fillVelvet(out, count);
+            return;
+        }
+        fillWhite(out, count);
+        if (color == PINK) {
+            shapePink(out, count);
+        }
+    }
+
+private:
+    // Four steps of x ^= x << 13, x ^= x >> 17, x ^= x << 5,
+    // top 24 bits as a signed fraction
+    rack::simd::float_4 step() {
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(state));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+        x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+        x = _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+        _mm_store_si128(reinterpret_cast<__m128i*>(state), x);
+        return rack::simd::float_4(_mm_cvtepi32_ps(_mm_srai_epi32(x, 8))) * (1.f / 8388608.f);
+#else
+        float white[4];
+        for (int i = 0; i < 4; i++) {
+            uint32_t x = state[i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state[i] = x;
+            white[i] = static_cast<float>(static_cast<int32_t>(x) >> 8);
+        }
+        return rack::simd::float_4::load(white) * (1.f / 8388608.f);
+#endif
+    }
+
+    void fillWhite(float* out, int count) {
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            step().store(out + i);
+        }
+        if (i < count) {
+            rack::simd::float_4 tail = step();
+            for (int lane = 0; i < count; i++, lane++) out[i] = tail[lane];
+        }
+    }
+
+    void shapePink(float* out, int count) {
+        for (int i = 0; i < count; i++) {
+            float white = out[i];
+            pink0 = 0.99765f * pink0 + white * 0.0990460f;
+            pink1 = 0.96300f * pink1 + white * 0.2965164f;
+            pink2 = 0.57000f * pink2 + white * 1.0526913f;
+            out[i] = (pink0 + pink1 + pink2 + white * 0.1848f) * 0.33f;
+        }
+    }
+
+    void fillVelvet(float* out, int count) {
+        // At the start of each period the lane's top 24 bits pick the impulse
+        // slot and its lowest bit, which the white sample drops, the sign
+        for (int i = 0; i < count; i += 4) {
+            rack::simd::float_4 white = step();
+            for (int lane = 0; lane < 4 && i + lane < count; lane++) {
+                if (velvetCounter == 0) {
+                    float u = white[lane] * 0.5f + 0.5f;
+                    velvetOffset = static_cast<int>(u * velvetPeriod);
+                    velvetSign = (state[lane] & 1u) ? 1.f : -1.f;
+                }
+                out[i + lane] = velvetCounter == velvetOffset ? velvetSign : 0.f;
+                if (++velvetCounter >= velvetPeriod) velvetCounter = 0;
+            }
+        }
+    }
+
+    alignas(16) uint32_t state[4] = {};
+    Color color = WHITE;
+    float block[BLOCK] = {};
+    int position = BLOCK;
+
+    float pink0 = 0.f, pink1 = 0.f, pink2 = 0.f;
+
+    int velvetPeriod = 24;   // 2000 impulses per second at 48 kHz
+    int velvetCounter = 0;
+    int velvetOffset = 0;
+    float velvetSign = 1.f;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Block rendering on a worker thread (audio thread -> worker -> audio thread)
+ *
+ * Moves a heavy, latency-tolerant signal path (a reverb's wet signal) off
+ * the engine thread. process() pushes one input frame and pops one output
+ * frame per sample through two lock-free single producer / single consumer
+ * rings and never blocks, waits or signals: the worker polls the input
+ * ring's atomic head every POLL_US while blocks keep arriving (backing off
+ * to IDLE_POLL_US once they stop), renders each BLOCK input frames with the
+ * render callback and pushes the result back.
+ *
+ * Output starts with getLatency() frames of silence (DEFAULT_LATENCY_BLOCKS
+ * blocks unless setLatencyBlocks() says otherwise): one block being
+ * collected, one being rendered and the rest as slack for a worker the OS
+ * scheduled late, so the worker has more than a block period per render
+ * while the engine thread runs the rest of the patch. A frame the worker
+ * hasn't delivered in time is output as silence right away; the late
+ * frames are dropped when they arrive, so the latency stays constant.
+ * underrunCount(), lateFrameCount() and droppedFrameCount() keep score
+ * and can be read from any thread.
+ *
+ * The callback only runs while full blocks are queued. Other threads must
+ * not touch the state it renders until finish() (audio thread), drain()
+ * (while process() is not running) or stop() says the worker has finished.
+ *
+ *   BlockWorker<2, 2> worker;
+ *   worker.start([this](int n, float** in, float** out) { ... });   // UI thread
+ *   worker.process(frameIn, frameOut);                              // audio thread
+ ******************************************************************************/
+
+template<int IN_CHANNELS, int OUT_CHANNELS, int BLOCK = 64>
+class BlockWorker {
+    static_assert(BLOCK > 0 && (BLOCK & (BLOCK - 1)) == 0,
+                  "BlockWorker block size must be a power of two");
+
+public:
+    static constexpr int BLOCK_SIZE = BLOCK;
+    static constexpr int MIN_LATENCY_BLOCKS = 2;
+    static constexpr int MAX_LATENCY_BLOCKS = 8;
+    static constexpr int DEFAULT_LATENCY_BLOCKS = 4;
+    static constexpr int POLL_US = 100;          // While blocks are arriving
+    static constexpr int IDLE_POLL_US = 20000;   // After IDLE_POLLS empty polls
+    static constexpr int IDLE_POLLS = 1000;
+
+    using RenderFn = std::function<void(int count, float** in, float** out)>;
+
+    BlockWorker() {
+        for (int c = 0; c < IN_CHANNELS; c++) renderInPtrs[c] = renderIn[c];
+        for (int c = 0; c < OUT_CHANNELS; c++) renderOutPtrs[c] = renderOut[c];
+    }
+
+    ~BlockWorker() {
+        stop();
+    }
+
+    BlockWorker(const BlockWorker&) = delete;
+    BlockWorker& operator=(const BlockWorker&) = delete;
+
+    // Start the thread if it isn't running (allocates, not for the audio thread)
+    void start(RenderFn fn) {
+        if (thread.joinable()) return;
+        render = std::move(fn);
+        stopping.store(false, std::memory_order_relaxed);
+        alive.store(true, std::memory_order_release);
+        thread = std::thread([this] { run(); });
+    }
+
+    // Let the worker finish the block in hand and join it (same thread as start())
+    void stop() {
+        if (!thread.joinable()) return;
+        stopping.store(true, std::memory_order_release);
+        thread.join();
+        alive.store(false, std::memory_order_release);
+    }
+
+    // Safe from any thread; false once stop() has joined the worker
+    bool running() const {
+        return alive.load(std::memory_order_acquire);
+    }
+
+    // Any thread; process() moves the output timeline to it on its next frame
+    void setLatencyBlocks(int blocks) {
+        blocks = std::min(std::max(blocks, MIN_LATENCY_BLOCKS), MAX_LATENCY_BLOCKS);
+        requestedLatency.store(blocks * BLOCK, std::memory_order_relaxed);
+    }
+
+    int getLatencyBlocks() const {
+        return requestedLatency.load(std::memory_order_relaxed) / BLOCK;
+    }
+
+    // Latency in frames
+    int getLatency() const {
+        return requestedLatency.load(std::memory_order_relaxed);
+    }
+
+    // ========== Audio thread ==========
+
+    void process(const float* in, float* out) {
+        int target = requestedLatency.load(std::memory_order_relaxed);
+        if (target != latency) {
+            // Longer: insert silence; shorter: drop frames as they arrive
+            int change = target - latency;
+            latency = target;
+            if (change > 0) silence += change;
+            else skip -= change;
+        }
+
+        if (!input.push(in)) {
+            // Worker stalled: this frame's output will never arrive
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+            if (skip > 0) skip--;
+            else silence++;
+        }
+
+        if (silence > 0) {
+            silence--;
+            for (int c = 0; c < OUT_CHANNELS; c++) out[c] = 0.0f;
+            return;
+        }
+
+        while (skip > 0 && output.pop(out)) skip--;
+        if (output.pop(out)) {
+            late = false;
+            return;
+        }
+
+        for (int c = 0; c < OUT_CHANNELS; c++) out[c] = 0.0f;
+        skip++;
+        lateFrames.fetch_add(1, std::memory_order_relaxed);
+        if (!late) underruns.fetch_add(1, std::memory_order_relaxed);
+        late = true;
+    }
+
+    // True when no block is queued or rendering (stop calling process() first)
+    bool idle() const {
+        return input.size() < BLOCK && !rendering.load();
+    }
+
+    // After the last process(): drop rendered frames so the worker never
+    // waits for output space, then report idle()
+    bool finish() {
+        float frame[OUT_CHANNELS];
+        while (output.pop(frame)) {}
+        return idle();
+    }
+
+    /**
+     * Restart the output timeline: drop rendered frames and queue
+     * getLatency() frames of silence again. The worker must be idle; once it has been
+     * stopped, queued input is dropped too, so the next start() doesn't
+     * render stale frames.
+     */
+    void flush() {
+        float frame[OUT_CHANNELS];
+        while (output.pop(frame)) {}
+        if (!running()) input.clear();
+        int queued = static_cast<int>(input.size());
+        latency = requestedLatency.load(std::memory_order_relaxed);
+        silence = std::max(latency - queued, 0);
+        skip = std::max(queued - latency, 0);
+        late = false;
+    }
+
+    // Times the output ran dry (each run of late frames counts once)
+    uint32_t underrunCount() const {
+        return underruns.load(std::memory_order_relaxed);
+    }
+
+    // Total frames output as silence because the worker was late
+    uint32_t lateFrameCount() const {
+        return lateFrames.load(std::memory_order_relaxed);
+    }
+
+    // Input frames lost because the worker stalled with its input ring full
+    uint32_t droppedFrameCount() const {
+        return droppedFrames.load(std::memory_order_relaxed);
+    }
+
+    // ========== Any thread while process() is not running ==========
+
+    // Let the worker finish what is queued, then flush()
+    void drain() {
+        while (running() && !finish()) {
+            std::this_thread::yield();
+        }
+        flush();
+    }
+
+private:
+    // Interleaved frames; head is written by the producer, tail by the consumer
+    template<int CHANNELS>
+    struct Ring {
+        static constexpr uint32_t CAPACITY = 2 * MAX_LATENCY_BLOCKS * BLOCK;
+
+        bool push(const float* frame) {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) >= CAPACITY) return false;
+            float* slot = data[h & (CAPACITY - 1)];
+            for (int c = 0; c < CHANNELS; c++) slot[c] = frame[c];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(float* frame) {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            if (head.load(std::memory_order_acquire) == t) return false;
+            const float* slot = data[t & (CAPACITY - 1)];
+            for (int c = 0; c < CHANNELS; c++) frame[c] = slot[c];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Block transfers for the worker (caller checked size() / space())
+        void pushBlock(float* const* src, int count) {
+            uint32_t h = head.load(std::memory_order_relaxed);
+            for (int i = 0; i < count; i++) {
+                float* slot = data[(h + i) & (CAPACITY - 1)];
+                for (int c = 0; c < CHANNELS; c++) slot[c] = src[c][i];
+            }
+            head.store(h + count, std::memory_order_release);
+        }
+
+        void popBlock(float* const* dst, int count) {
+            uint32_t t = tail.load(std::memory_order_relaxed);
+            for (int i = 0; i < count; i++) {
+                const float* slot = data[(t + i) & (CAPACITY - 1)];
+                for (int c = 0; c < CHANNELS; c++) dst[c][i] = slot[c];
+            }
+            tail.store(t + count, std::memory_order_release);
+        }
+
+        uint32_t size() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        uint32_t space() const {
+            return CAPACITY - size();
+        }
+
+        // Producer side, only while there is no consumer
+        void clear() {
+            tail.store(head.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+
+        alignas(64) std::atomic<uint32_t> head{0};
+        alignas(64) std::atomic<uint32_t> tail{0};
+        alignas(64) float data[CAPACITY][CHANNELS] = {};
+    };
+
+    void run() {
+        int emptyPolls = 0;
+        while (!stopping.load(std::memory_order_acquire)) {
+            // Set before looking at the ring, so idle() can't miss a block in flight
+            rendering.store(true);
+            if (input.size() >= BLOCK && output.space() >= BLOCK) {
+                input.popBlock(renderInPtrs, BLOCK);
+                render(BLOCK, renderInPtrs, renderOutPtrs);
+                output.pushBlock(renderOutPtrs, BLOCK);
+                rendering.store(false);
+                emptyPolls = 0;
+                continue;
+            }
+            rendering.store(false);
+
+            if (emptyPolls < IDLE_POLLS) emptyPolls++;
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                emptyPolls < IDLE_POLLS ? POLL_US : IDLE_POLL_US));
+        }
+    }
+
+    Ring<IN_CHANNELS> input;
+    Ring<OUT_CHANNELS> output;
+
+    // Audio thread only
+    int latency = DEFAULT_LATENCY_BLOCKS * BLOCK;
+    int silence = DEFAULT_LATENCY_BLOCKS * BLOCK;   // Frames of silence still to output
+    int skip = 0;            // Late frames already replaced by silence
+    bool late = false;       // The last frame was late
+
+    // Set from any thread, followed by the audio thread
+    std::atomic<int> requestedLatency{DEFAULT_LATENCY_BLOCKS * BLOCK};
+
+    // Counted by the audio thread, read anywhere
+    std::atomic<uint32_t> underruns{0};
+    std::atomic<uint32_t> lateFrames{0};
+    std::atomic<uint32_t> droppedFrames{0};
+
+    // Worker thread only
+    RenderFn render;
+    float renderIn[IN_CHANNELS][BLOCK] = {};
+    float renderOut[OUT_CHANNELS][BLOCK] = {};
+    float* renderInPtrs[IN_CHANNELS];
+    float* renderOutPtrs[OUT_CHANNELS];
+
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> alive{false};
+    std::atomic<bool> rendering{false};
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "rack.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Framebuffer-cached base for animated module displays
+ *
+ * NanoVG is immediate mode, so a display that builds its paths in draw()
+ * rebuilds every one of them on every UI frame, even when nothing moved.
+ * CachedDisplay splits a display into two cached layers instead:
+ *
+ *   static   drawStatic(): background, grids, rings, labels. Re-rendered
+ *            when staticGeneration() changes.
+ *   dynamic  drawDynamic(): the animated part, always in the lit layer.
+ *            Re-rendered when dataGeneration() changes.
+ *
+ * Re-renders happen at most refreshRate times a second; every other frame
+ * just composites the two cached images. Rack renders framebuffers from
+ * step() and defers them while a frame is overdue, so a busy UI thread
+ * drops display updates instead of falling further behind.
+ *
+ * A generation is any key that changes when the picture would: a
+ * ScopeRing's framesPublished(), or a few display values folded in with
+ * mix(). The default of 0 means "never changes" (module browser preview).
+ *
+ *   struct MyScope : CachedDisplay<> {
+ *       uint64_t dataGeneration() override { return module ? module->scope.framesPublished() : 0; }
+ *       void drawStatic(const DrawArgs& args) override { ... grid ... }
+ *       void drawDynamic(const DrawArgs& args) override { ... trace ... }
+ *   };
+ ******************************************************************************/
+
+template<typename TBase = rack::widget::Widget>
+struct CachedDisplay : TBase {
+    using DrawArgs = typename TBase::DrawArgs;
+
+    float refreshRate = 30.f;   // Max re-renders per second
+    int staticLayer = 0;        // 0 = panel layer, 1 = lit layer
+
+    CachedDisplay() {
+        staticFb = new LayerFramebuffer(this, false);
+        dynamicFb = new LayerFramebuffer(this, true);
+        this->addChild(staticFb);
+        this->addChild(dynamicFb);
+    }
+
+    virtual void drawStatic(const DrawArgs&) {}
+    virtual void drawDynamic(const DrawArgs&) {}
+    virtual uint64_t staticGeneration() { return 0; }
+    virtual uint64_t dataGeneration() { return 0; }
+
+    // Re-render both layers on the next frame regardless of generations
+    void invalidate() {
+        staticFb->setDirty();
+        dynamicFb->setDirty();
+    }
+
+    void step() override {
+        staticFb->layer = staticLayer;
+        if (staticFb->box.size.x != this->box.size.x || staticFb->box.size.y != this->box.size.y) {
+            staticFb->fitTo(this->box.size);
+            dynamicFb->fitTo(this->box.size);
+            invalidate();
+        }
+
+        uint64_t staticGen = staticGeneration();
+        uint64_t dataGen = dataGeneration();
+        if (staticGen != lastStaticGen || dataGen != lastDataGen) {
+            double now = rack::system::getTime();
+            if (now - lastRender >= 1.0 / refreshRate) {
+                if (staticGen != lastStaticGen) staticFb->setDirty();
+                if (dataGen != lastDataGen) dynamicFb->setDirty();
+                lastStaticGen = staticGen;
+                lastDataGen = dataGen;
+                lastRender = now;
+            }
+        }
+
+        // Children last, so a layer marked dirty above renders this frame
+        TBase::step();
+    }
+
+    // Fold a value into a generation key (floats by bit pattern)
+    static uint64_t mix(uint64_t key, uint64_t value) {
+        return (key ^ value) * 0x100000001B3ULL;
+    }
+
+    static uint64_t mix(uint64_t key, int value) {
+        return mix(key, static_cast<uint64_t>(static_cast<uint32_t>(value)));
+    }
+
+    static uint64_t mix(uint64_t key, float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return mix(key, static_cast<uint64_t>(bits));
+    }
+
+private:
+    // Calls back into the display from inside the framebuffer
+    struct LayerContent : rack::widget::Widget {
+        CachedDisplay* owner;
+        bool dynamic;
+
+        LayerContent(CachedDisplay* owner, bool dynamic) : owner(owner), dynamic(dynamic) {}
+
+        void draw(const DrawArgs& args) override {
+            if (dynamic) owner->drawDynamic(args);
+            else owner->drawStatic(args);
+        }
+    };
+
+    // FramebufferWidget composited in a chosen layer (Rack only composites
+    // framebuffers in layer 0 by default)
+    struct LayerFramebuffer : rack::widget::FramebufferWidget {
+        LayerContent* content;
+        int layer;
+
+        LayerFramebuffer(CachedDisplay* owner, bool dynamic) : layer(dynamic ? 1 : 0) {
+            content = new LayerContent(owner, dynamic);
+            addChild(content);
+        }
+
+        void fitTo(rack::math::Vec size) {
+            this->box.size = size;
+            content->box.size = size;
+        }
+
+        void draw(const DrawArgs& args) override {
+            if (layer == 0) FramebufferWidget::draw(args);
+        }
+
+        void drawLayer(const DrawArgs& args, int l) override {
+            if (layer != 0 && l == layer) FramebufferWidget::draw(args);
+        }
+    };
+
+    LayerFramebuffer* staticFb;
+    LayerFramebuffer* dynamicFb;
+    uint64_t lastStaticGen = 0;
+    uint64_t lastDataGen = 0;
+    double lastRender = -1e9;
+};
+
+} // namespace WiggleRoom
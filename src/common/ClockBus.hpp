@@ -0,0 +1,129 @@
+#pragma once
+
+#include "rack.hpp"
+#include "DSP.hpp"
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Clock bus: tempo, beat phase and edge schedule on one poly cable
+ *
+ * PreFlightClock's Bus output carries its master clock as a 7-channel
+ * polyphonic signal. Channel 0 is the plain x1 clock pulse, so the bus also
+ * drives any clock input. A WiggleRoom module that recognizes the bus reads
+ * tempo in place of estimating it from edge intervals: the first sample
+ * after patching already has the exact period, and tempo changes take
+ * effect without waiting for the next two edges.
+ *
+ *   0  CLOCK   x1 clock pulse (10V, 1ms)
+ *   1  RUN     run gate (10V while running)
+ *   2  RESET   reset pulse (10V, 1ms)
+ *   3  BPM     log2(BPM / 120), the usual VCV BPM CV (0V = 120 BPM)
+ *   4  PHASE   position in the current beat, 0..10V
+ *   5  EDGE    samples until the next x1 edge; 0 on the edge sample itself
+ *   6  SIGNATURE  constant SIGNATURE_VOLTAGE, tells the bus from other poly cables
+ *
+ * EDGE is an exact small integer, so readers tick on EDGE == 0 without a
+ * Schmitt trigger. Cables add one sample of delay to every channel alike,
+ * so the tick lands on the same sample as an edge detector on channel 0.
+ *
+ *   ClockBus::Reader bus;
+ *   if (bus.read(inputs[CLOCK_INPUT])) {
+ *       clockEdge = bus.edge;
+ *       clockPeriod = bus.period;     // seconds per beat
+ *   } else {
+ *       // Existing Schmitt trigger and period estimate
+ *   }
+ ******************************************************************************/
+
+namespace ClockBus {
+
+enum Channel {
+    CLOCK,
+    RUN,
+    RESET,
+    BPM,
+    PHASE,
+    EDGE,
+    SIGNATURE,
+    CHANNELS
+};
+
+// Exactly representable and far from any gate or CV level
+constexpr float SIGNATURE_VOLTAGE = -9.765625f;
+
+inline bool isBus(const rack::engine::Input& in) {
+    return in.getChannels() == CHANNELS && in.getVoltage(SIGNATURE) == SIGNATURE_VOLTAGE;
+}
+
+inline float bpmToVoltage(float bpm) {
+    return std::log2(bpm / 120.f);
+}
+
+struct Frame {
+    bool clock = false;
+    bool run = false;
+    bool reset = false;
+    float bpm = 120.f;
+    double beatPhase = 0.0;     // beats; only the fraction is sent
+    int edgeSamples = 0;
+};
+
+/**
+ * Write one frame (once per sample)
+ *
+ * The BPM voltage is only recomputed when the tempo changes.
+ */
+struct Writer {
+    float lastBpm = -1.f;
+    float bpmVoltage = 0.f;
+
+    void write(rack::engine::Output& out, const Frame& f) {
+        if (f.bpm != lastBpm) {
+            lastBpm = f.bpm;
+            bpmVoltage = bpmToVoltage(f.bpm);
+        }
+        out.setChannels(CHANNELS);
+        out.setVoltage(f.clock ? 10.f : 0.f, CLOCK);
+        out.setVoltage(f.run ? 10.f : 0.f, RUN);
+        out.setVoltage(f.reset ? 10.f : 0.f, RESET);
+        out.setVoltage(bpmVoltage, BPM);
+        out.setVoltage(static_cast<float>(f.beatPhase - std::floor(f.beatPhase)) * 10.f, PHASE);
+        out.setVoltage(static_cast<float>(f.edgeSamples), EDGE);
+        out.setVoltage(SIGNATURE_VOLTAGE, SIGNATURE);
+    }
+};
+
+/**
+ * Decode the bus at a clock input
+ *
+ * read() returns false when the input carries anything else, so callers
+ * fall back to their own edge detection. The period is only recomputed
+ * when the BPM channel changes.
+ */
+struct Reader {
+    bool edge = false;
+    float bpm = 120.f;
+    float period = 0.5f;        // seconds per beat
+    float phase = 0.f;          // 0..1 within the beat
+    int edgeSamples = 0;
+    float lastBpmVoltage = 0.f;
+
+    bool read(const rack::engine::Input& in) {
+        if (!isBus(in)) return false;
+        float bpmVoltage = in.getVoltage(BPM);
+        if (bpmVoltage != lastBpmVoltage) {
+            lastBpmVoltage = bpmVoltage;
+            bpm = 120.f * DSP::fastExp2(bpmVoltage);
+            period = 60.f / bpm;
+        }
+        edgeSamples = static_cast<int>(in.getVoltage(EDGE));
+        edge = (edgeSamples == 0);
+        phase = in.getVoltage(PHASE) * 0.1f;
+        return true;
+    }
+};
+
+} // namespace ClockBus
+
+} // namespace WiggleRoom
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define WR_DENORMALS_SSE 1
+#elif defined(__aarch64__) || defined(__arm__)
+#define WR_DENORMALS_ARM 1
+#endif
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Denormal (subnormal float) protection
+ *
+ * Feedback networks that decay towards zero end up in subnormal floats, which
+ * take a microcode assist on x86 and can cost 100x per operation. Faust DSP
+ * calls are wrapped in a ScopedFlushDenormals so those values become zero:
+ *
+ *   x86/x64   MXCSR FTZ (bit 15) + DAZ (bit 6)
+ *   AArch64   FPCR FZ (bit 24, flushes inputs and outputs)
+ *   ARMv7     FPSCR FZ (bit 24)
+ *
+ * Rack's engine threads usually run with flush-to-zero already set; the
+ * guard only reads the control register then and writes it back only when
+ * it had to change it, so nesting and repeated use are cheap.
+ *
+ * Define WR_DENORMAL_STATS (cmake -DWIGGLEROOM_DENORMAL_STATS=ON) to have
+ * FaustModule count subnormal DSP outputs per module and log them.
+ ******************************************************************************/
+
+namespace DenormalDetail {
+
+#if defined(WR_DENORMALS_SSE)
+constexpr uint32_t FLUSH_BITS = 0x8040;  // FTZ | DAZ
+inline uint32_t readControl() { return _mm_getcsr(); }
+inline void writeControl(uint32_t value) { _mm_setcsr(value); }
+#elif defined(WR_DENORMALS_ARM) && defined(__aarch64__)
+constexpr uint64_t FLUSH_BITS = uint64_t(1) << 24;
+inline uint64_t readControl() {
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(value));
+    return value;
+}
+inline void writeControl(uint64_t value) { __asm__ __volatile__("msr fpcr, %0" : : "r"(value)); }
+#elif defined(WR_DENORMALS_ARM) && defined(__ARM_FP)
+constexpr uint32_t FLUSH_BITS = uint32_t(1) << 24;
+inline uint32_t readControl() {
+    uint32_t value;
+    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(value));
+    return value;
+}
+inline void writeControl(uint32_t value) { __asm__ __volatile__("vmsr fpscr, %0" : : "r"(value)); }
+#else
+constexpr uint32_t FLUSH_BITS = 0;      // Unknown target: guard is a no-op
+inline uint32_t readControl() { return 0; }
+inline void writeControl(uint32_t) {}
+#endif
+
+using ControlWord = decltype(readControl());
+
+} // namespace DenormalDetail
+
+/**
+ * Enable flush-to-zero / denormals-are-zero for the current scope
+ *
+ * Usage:
+ *   {
+ *       ScopedFlushDenormals noDenormals;
+ *       dsp.compute(count, inputs, outputs);
+ *   }
+ */
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() : saved(DenormalDetail::readControl()) {
+        DenormalDetail::ControlWord wanted = saved | DenormalDetail::FLUSH_BITS;
+        changed = (wanted != saved);
+        if (changed) DenormalDetail::writeControl(wanted);
+    }
+
+    ~ScopedFlushDenormals() {
+        if (changed) DenormalDetail::writeControl(saved);
+    }
+
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+private:
+    DenormalDetail::ControlWord saved;
+    bool changed;
+};
+
+/**
+ * True for subnormal floats (zero exponent, non-zero mantissa)
+ *
+ * Bit test rather than std::fpclassify so it still works under -ffast-math.
+ */
+inline bool isSubnormal(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7f800000u) == 0 && (bits & 0x007fffffu) != 0;
+}
+
+/**
+ * Count subnormals in a buffer
+ */
+inline int countSubnormals(const float* values, int count) {
+    int n = 0;
+    for (int i = 0; i < count; i++) n += isSubnormal(values[i]) ? 1 : 0;
+    return n;
+}
+
+} // namespace WiggleRoom
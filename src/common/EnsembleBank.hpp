@@ -0,0 +1,222 @@
+#pragma once
+
+#include "rack.hpp"
+#include "DSP.hpp"
+#include "SimdBank.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Polyphonic tri-phase string ensemble, four channels per float_4
+ *
+ * Each channel is tri_phase_ensemble.dsp: three 12 ms delay lines swept by
+ * a slow (0.6 Hz) plus fast (6 Hz) LFO pair at 0, 120 and 240 degrees,
+ * read with linear interpolation (de.fdelay) and lowpassed by a one-pole
+ * (fi.lowpass(1, tone)):
+ *
+ *   left  = lowpass(v1 + v2 / 2),  right = lowpass(v3 + v2 / 2)
+ *
+ * Every channel sees the same modulation, so tick() runs the three-phase
+ * LFO once per sample (one float_4, one voice per lane) and turns the delay
+ * times into integer taps and interpolation weights. process() then reads
+ * each tap for four channels with two float_4 loads and one lerp. The
+ * lowpass is linear and shared by the voices, so it filters the two stereo
+ * sums instead of each voice.
+ *
+ * setControls() and setMix() run at control rate and smooth their values
+ * with SmooStep (see SimdBank.hpp). Depth and mix ramp linearly between
+ * calls.
+ *
+ *   EnsembleBank ensemble;
+ *   ensemble.setSampleRate(48000.f);
+ *   ensemble.setChannelCount(channels);
+ *   ensemble.setControls(depth, rate, tone, 16);   // every 16 samples
+ *   ensemble.setMix(g, mix, 16);
+ *   ensemble.tick();                               // every sample, then
+ *   ensemble.process(g, in, left, right);          // for each group
+ ******************************************************************************/
+
+class EnsembleBank : public SimdBank<EnsembleBank, 16> {
+public:
+    using float_4 = rack::simd::float_4;
+
+    static constexpr int DELAY_SIZE = 4096;     // de.fdelay(4096, ...)
+    static constexpr int DELAY_MASK = DELAY_SIZE - 1;
+    static constexpr int VOICES = 3;
+
+    EnsembleBank() : delay(MAX_GROUPS * DELAY_SIZE, float_4(0.f)) {}
+
+    void setSampleRate(float rate) {
+        sampleRate = rate;
+        baseDelay = 0.012f * rate;
+    }
+
+    /**
+     * Smooth the shared controls and retune the LFOs and lowpass
+     *
+     * @param depth    0..2 modulation depth
+     * @param rate     LFO speed scale (1 = 0.6 Hz / 6 Hz)
+     * @param tone     lowpass cutoff in Hz
+     * @param samples  samples until the next call
+     */
+    void setControls(float depth, float rate, float tone, int samples) {
+        float target = depth;
+        if (!controlsPrimed) {
+            smoothDepth = depth;
+            smoothRate = rate;
+            smoothTone = tone;
+            depthValue = depth;
+            controlsPrimed = true;
+        } else {
+            float coeff = smoo.coefficient(samples);
+            smoothDepth += (depth - smoothDepth) * coeff;
+            smoothRate += (rate - smoothRate) * coeff;
+            smoothTone += (tone - smoothTone) * coeff;
+            target = smoothDepth;
+        }
+        depthStep = (target - depthValue) / static_cast<float>(std::max(samples, 1));
+
+        slowDelta = 0.6f * smoothRate / sampleRate;
+        fastDelta = 6.f * smoothRate / sampleRate;
+
+        // fi.lowpass(1, tone): bilinear one-pole, c = 1 / tan(pi * fc / SR)
+        float w = std::min(DSP::PI * smoothTone / sampleRate, 1.5f);
+        float c = DSP::fastCos(w) / DSP::fastSin(w);
+        float d = 1.f / (1.f + c);
+        lowpassB0 = d;
+        lowpassA1 = (1.f - c) * d;
+    }
+
+    /**
+     * Smooth one group's dry/wet mix (0 = dry, 1 = wet)
+     */
+    void setMix(int g, float_4 mix, int samples) {
+        Group& grp = groups[g];
+        float_4 target = mix;
+        if (!grp.mixPrimed) {
+            grp.smoothMix = mix;
+            grp.mix = mix;
+            grp.mixPrimed = true;
+        } else {
+            float coeff = smoo.coefficient(samples);
+            grp.smoothMix += (mix - grp.smoothMix) * coeff;
+            target = grp.smoothMix;
+        }
+        grp.mixStep = (target - grp.mix) / static_cast<float>(std::max(samples, 1));
+    }
+
+    /**
+     * Advance the shared LFOs and compute this sample's taps
+     */
+    void tick() {
+        using namespace DSP::FastMathDetail;
+        slowPhase += slowDelta;
+        slowPhase -= floorf(slowPhase);
+        fastPhase += fastDelta;
+        fastPhase -= floorf(fastPhase);
+        depthValue += depthStep;
+
+        // Voices in lanes 0-2 at 0, 1/3 and 2/3 of a cycle
+        const float_4 offsets(0.f, 1.f / 3.f, 2.f / 3.f, 0.f);
+        float_4 slow = DSP::fastSin2pi(float_4(slowPhase) + offsets);
+        float_4 fast = DSP::fastSin2pi(float_4(fastPhase) + offsets);
+        float_4 mod = (slow + fast * 0.15f) * (0.008f * depthValue);
+        float_4 time = vmin(vmax(float_4(1.f), baseDelay * (1.f + mod)), float_4(DELAY_SIZE - 2.f));
+        float_4 whole = floorf(time);
+        float_4 frac = time - whole;
+
+        writePos = (writePos + 1) & DELAY_MASK;
+        for (int v = 0; v < VOICES; v++) {
+            int taps = static_cast<int>(whole[v]);
+            tapNear[v] = (writePos - taps) & DELAY_MASK;
+            tapFar[v] = (writePos - taps - 1) & DELAY_MASK;
+            tapFrac[v] = frac[v];
+        }
+    }
+
+    /**
+     * Run four channels through the ensemble
+     */
+    void process(int g, float_4 in, float_4& left, float_4& right) {
+        Group& grp = groups[g];
+        float_4* line = &delay[g * DELAY_SIZE];
+        line[writePos] = in;
+
+        float_4 voice[VOICES];
+        for (int v = 0; v < VOICES; v++) {
+            float_4 near = line[tapNear[v]];
+            float_4 far = line[tapFar[v]];
+            voice[v] = near + (far - near) * tapFrac[v];
+        }
+
+        float_4 wetL = voice[0] + voice[1] * 0.5f;
+        float_4 wetR = voice[2] + voice[1] * 0.5f;
+        float_4 yL = lowpassB0 * (wetL + grp.lastL) - lowpassA1 * grp.lowL;
+        float_4 yR = lowpassB0 * (wetR + grp.lastR) - lowpassA1 * grp.lowR;
+        grp.lastL = wetL;
+        grp.lastR = wetR;
+        grp.lowL = yL;
+        grp.lowR = yR;
+
+        grp.mix += grp.mixStep;
+        float_4 dry = in * (1.f - grp.mix);
+        left = yL * grp.mix + dry;
+        right = yR * grp.mix + dry;
+    }
+
+    void reset() {
+        SimdBank::reset();
+        controlsPrimed = false;
+        depthStep = 0.f;
+        slowPhase = 0.f;
+        fastPhase = 0.f;
+    }
+
+private:
+    friend SimdBank;
+
+    struct Group {
+        float_4 lastL = 0.f;
+        float_4 lastR = 0.f;
+        float_4 lowL = 0.f;
+        float_4 lowR = 0.f;
+        float_4 smoothMix = 0.f;
+        float_4 mix = 0.f;
+        float_4 mixStep = 0.f;
+        bool mixPrimed = false;
+    };
+
+    void resetGroup(int g) {
+        groups[g] = Group();
+        std::fill(delay.begin() + g * DELAY_SIZE, delay.begin() + (g + 1) * DELAY_SIZE, float_4(0.f));
+    }
+
+    std::vector<float_4> delay;
+    Group groups[MAX_GROUPS];
+
+    // Shared modulation and taps
+    float slowPhase = 0.f;
+    float fastPhase = 0.f;
+    float slowDelta = 0.f;
+    float fastDelta = 0.f;
+    float smoothDepth = 0.f;
+    float smoothRate = 1.f;
+    float smoothTone = 8000.f;
+    float depthValue = 0.f;
+    float depthStep = 0.f;
+    bool controlsPrimed = false;
+    float lowpassB0 = 1.f;
+    float lowpassA1 = 0.f;
+    int writePos = 0;
+    int tapNear[VOICES] = {};
+    int tapFar[VOICES] = {};
+    float tapFrac[VOICES] = {};
+
+    float sampleRate = 48000.f;
+    float baseDelay = 576.f;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+/******************************************************************************
+ * Plugin-wide arena for Faust DSP memory
+ *
+ * DSPs built with add_faust_dsp(... MEMORY_MANAGER) are generated with
+ * Faust's -mem option: delay lines and tables are no longer embedded in the
+ * class, each instance allocates them through mydsp::fManager when it is
+ * created and hands them back when it is destroyed. The architecture file
+ * points fManager at FaustArena::instance() (through a forwarder that
+ * also notes each instance's blocks, for state snapshots).
+ *
+ * Faust fixes every delay line and table length at compile time, so -mem
+ * does not change how much memory an instance uses; the arena only decides
+ * where it lives. Each block is rounded up to a whole cache line and
+ * starts on one. Released blocks go onto a free list for their exact size,
+ * so removing a module and adding another of the same kind reuses its
+ * buffers instead of going back to the system allocator. Memory is
+ * returned to the system when the plugin unloads.
+ *
+ * Allocation only happens when a module is created or removed, never in
+ * process(), so a mutex is fine.
+ ******************************************************************************/
+
+// Faust's memory manager interface (as in faust/dsp/dsp.h)
+#ifndef WR_FAUST_DSP_MEMORY_MANAGER
+#define WR_FAUST_DSP_MEMORY_MANAGER
+struct dsp_memory_manager {
+    virtual ~dsp_memory_manager() {}
+    virtual void begin(size_t) {}
+    virtual void info(size_t, size_t, size_t) {}
+    virtual void end() {}
+    virtual void* allocate(size_t size) = 0;
+    virtual void destroy(void* ptr) = 0;
+};
+#endif
+
+namespace WiggleRoom {
+
+class FaustArena : public dsp_memory_manager {
+public:
+    static constexpr size_t ALIGNMENT = 64;          // One cache line
+
+    static FaustArena& instance() {
+        static FaustArena arena;
+        return arena;
+    }
+
+    ~FaustArena() override {
+        for (void* raw : systemBlocks) std::free(raw);
+    }
+
+    void* allocate(size_t size) override {
+        size_t blockSize = std::max(roundUp(size), ALIGNMENT);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        uint8_t* block;
+        std::vector<uint8_t*>& freeList = freeLists[blockSize];
+        if (!freeList.empty()) {
+            block = freeList.back();
+            freeList.pop_back();
+        } else {
+            block = systemAlloc(blockSize);
+        }
+        inUse += blockSize;
+        sizeOf[block] = blockSize;
+        return block;
+    }
+
+    void destroy(void* ptr) override {
+        if (!ptr) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sizeOf.find(ptr);
+        if (it == sizeOf.end()) return;
+        size_t blockSize = it->second;
+        sizeOf.erase(it);
+        freeLists[blockSize].push_back(static_cast<uint8_t*>(ptr));
+        inUse -= blockSize;
+    }
+
+    // Bytes taken from the system / currently handed out to DSPs
+    size_t bytesReserved() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return reserved;
+    }
+
+    size_t bytesInUse() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return inUse;
+    }
+
+private:
+    FaustArena() = default;
+
+    static size_t roundUp(size_t size) {
+        return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    uint8_t* systemAlloc(size_t size) {
+        void* raw = std::malloc(size + ALIGNMENT);
+        if (!raw) throw std::bad_alloc();
+        systemBlocks.push_back(raw);
+        reserved += size + ALIGNMENT;
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + ALIGNMENT - 1) & ~uintptr_t(ALIGNMENT - 1);
+        return reinterpret_cast<uint8_t*>(aligned);
+    }
+
+    mutable std::mutex mutex;
+    std::unordered_map<size_t, std::vector<uint8_t*>> freeLists;   // By block size
+    std::vector<void*> systemBlocks;
+    std::unordered_map<void*, size_t> sizeOf;   // Size of each live block
+    size_t reserved = 0;
+    size_t inUse = 0;
+};
+
+} // namespace WiggleRoom
@@ -2,11 +2,28 @@
 
 #include "rack.hpp"
 #include "DSP.hpp"
+#include "Denormals.hpp"
+#include "Oversampler.hpp"
+#include "Profiler.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
 #include <vector>
 #include <cstring>
 
 namespace WiggleRoom {
 
+namespace FaustModuleDetail {
+
+// Shared by every FaustModule so deferred clears spread across the patch
+inline uint32_t nextClearSlot() {
+    static std::atomic<uint32_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace FaustModuleDetail
+
 /**
  * Base class for VCV Rack modules wrapping Faust-generated DSP
  *
@@ -15,11 +32,14 @@ namespace WiggleRoom {
  *
  * Usage:
  *   1. Include your generated Faust header (e.g., #include "moog_lpf.hpp")
+ *      and its parameter indices (#include "moog_lpf_params.hpp")
  *   2. Create a module struct inheriting from FaustModule<VCVRackDSP>
  *   3. In the constructor, call config() and then mapParam() for each parameter
  *   4. Define your ModuleWidget as usual
  *
  * Example:
+ *   namespace FP = FaustParams::moog_lpf;
+ *
  *   struct MyFilter : FaustModule<VCVRackDSP> {
  *       enum ParamId { CUTOFF_PARAM, PARAMS_LEN };
  *       enum InputId { AUDIO_INPUT, CUTOFF_CV_INPUT, INPUTS_LEN };
@@ -33,12 +53,43 @@ namespace WiggleRoom {
  *           configInput(CUTOFF_CV_INPUT, "Cutoff CV");
  *           configOutput(AUDIO_OUTPUT, "Audio");
  *
- *           // Map VCV param to Faust param index 0
- *           mapParam(CUTOFF_PARAM, 0);
- *           // Map CV input to modulate Faust param 0 (V/Oct scaling)
- *           mapCVInput(CUTOFF_CV_INPUT, 0, true);
+ *           // Map VCV param to the Faust "cutoff" param
+ *           mapParam(CUTOFF_PARAM, FP::CUTOFF);
+ *           // Map CV input to modulate it (V/Oct scaling)
+ *           mapCVInput(CUTOFF_CV_INPUT, FP::CUTOFF, true);
  *       }
  *   };
+ *
+ * Mapped params and CV are evaluated at control rate (every 16 samples by
+ * default, see setControlRate()) and ramped per sample. Parameters that must
+ * follow audio-rate signals (gates, V/Oct) should be set with setParamValue()
+ * directly in process().
+ *
+ * Effects can skip compute() while idle with setSilenceBypass(), see
+ * computeFrame(). Every compute() runs with flush-to-zero enabled
+ * (Denormals.hpp). Profiling builds (WR_PROFILE, Profiler.hpp) time
+ * compute() and updateFaustParams() in `profile`; a custom process()
+ * starts with WR_PROFILE_SCOPE(profile, "process").
+ *
+ * Nonlinear modules can offer 2x/4x/8x oversampling with
+ * enableOversampling(): compute() then runs at the higher rate and each
+ * audio input/output goes through a polyphase half-band filter
+ * (Oversampler.hpp). Initialize the DSP with initDsp() so it gets the
+ * oversampled rate.
+ *
+ * The reverse, enableRateReduction(), runs compute() at 1/2 or 1/4 of the
+ * engine rate through the same half-band stages, for DSPs with little
+ * content up high (reverb tails). computeFrame() then works in blocks of
+ * at least the divider. enableFixedRate() picks the divider from the
+ * engine rate instead, so physical models run near 48 kHz at 96 or
+ * 192 kHz; their gates go through setGateParam() so triggers shorter
+ * than a block still arrive.
+ *
+ * Only the first initDsp() runs a full init(). A later sample rate change
+ * keeps parameter values, recomputes the rate constants and defers clearing
+ * the delay memory to computeFrame(): modules take staggered slots a few
+ * engine blocks apart and output silence until theirs comes up, so a rate
+ * switch doesn't clear every delay line in the patch inside one callback.
  */
 template<typename FaustDSP>
 struct FaustModule : rack::Module {
@@ -63,10 +114,38 @@ struct FaustModule : rack::Module {
         bool exponential;    // Use V/Oct exponential scaling
         float scale;         // Linear scale factor (default 1.0)
 
+        int slot = -1;               // Index into paramSlots
+        float lastVoltage = 0.0f;    // Cached V/Oct conversion
+        float lastMultiplier = 1.0f;
+
         CVMapping(int input, int faust, bool exp, float s)
             : vcvInputId(input), faustParamIdx(faust), exponential(exp), scale(s) {}
     };
 
+    /**
+     * Control-rate state for one mapped Faust parameter
+     *
+     * Targets are evaluated every controlRateDivider samples; when a target
+     * changes the value is ramped linearly over the next divider samples.
+     */
+    struct ParamSlot {
+        int faustParamIdx;
+        int vcvParamId = -1;     // Knob giving the base value (-1 = Faust init value)
+        bool snap = false;       // Discrete parameter: jump, never ramp
+        bool overridden = false; // Held at overrideValue, knob and CV ignored
+        float overrideValue = 0.0f;
+        bool dirty = false;      // current changed, not yet handed to Faust
+        float minVal = 0.0f;
+        float maxVal = 0.0f;
+        float pending = 0.0f;    // Scratch value while evaluating targets
+        float target = 0.0f;
+        float current = 0.0f;
+        float step = 0.0f;
+        int remaining = 0;
+
+        explicit ParamSlot(int faust) : faustParamIdx(faust) {}
+    };
+
 protected:
     // The Faust DSP instance
     FaustDSP faustDsp;
@@ -74,6 +153,15 @@ protected:
     // Parameter mappings
     std::vector<ParamMapping> paramMappings;
     std::vector<CVMapping> cvMappings;
+    std::vector<std::pair<int, float>> paramOverrides;   // Faust index, value
+
+    // Control-rate parameter pipeline (see updateFaustParams())
+    static constexpr int DEFAULT_CONTROL_RATE = 16;
+    std::vector<ParamSlot> paramSlots;
+    int controlRateDivider = DEFAULT_CONTROL_RATE;
+    int controlCounter = 0;
+    bool paramSlotsBuilt = false;
+    bool paramSlotsPrimed = false;   // false = next evaluation jumps, no ramp
 
     // Audio I/O buffers (single sample processing)
     static constexpr int MAX_IO = 16;
@@ -88,6 +176,145 @@ protected:
 
     bool initialized = false;
 
+    // Deferred state clear after a rate change (see scheduleClear())
+    static constexpr int CLEAR_STAGGER_SLOTS = 16;
+    static constexpr int CLEAR_STAGGER_FRAMES = 64;
+    int clearCountdown = 0;   // Frames until the clear, 0 = none pending
+
+    // Block processing (opt-in, see computeFrame())
+    // Inputs are gathered into real buffers and compute() runs once per block,
+    // which adds blockSize samples of latency. blockSize == 1 is per-sample.
+    static constexpr int MAX_BLOCK_SIZE = 64;
+    int blockSize = 1;
+    int blockPos = 0;
+    std::atomic<int> requestedBlockSize{1};  // Written by UI, applied on audio thread
+    float blockInputs[MAX_IO][MAX_BLOCK_SIZE] = {};
+    float blockOutputs[MAX_IO][MAX_BLOCK_SIZE] = {};
+    float* blockInputPtrs[MAX_IO];
+    float* blockOutputPtrs[MAX_IO];
+
+    // Silence bypass (opt-in, see setSilenceBypass())
+    static constexpr float DEFAULT_SILENCE_THRESHOLD = 1e-5f;  // -100 dBFS
+    float silenceThreshold = DEFAULT_SILENCE_THRESHOLD;
+    float silenceHoldSeconds = 0.0f;   // 0 = disabled
+    int silenceHoldSamples = 0;
+    int silentSamples = 0;
+    bool bypassed = false;
+    bool activityPending = false;      // Set by keepAwake() for the next frame
+    int activityInputs = MAX_IO;       // Inputs that count as activity
+
+    // Oversampling (opt-in, see enableOversampling())
+    // Buffers are only allocated for modules that offer it.
+    int maxOversample = 1;             // 1 = not offered
+    int oversample = 1;
+    std::atomic<int> requestedOversample{1};  // Written by UI, applied on audio thread
+    int engineSampleRate = 0;
+    std::vector<Oversampler> inputOversamplers;
+    std::vector<Oversampler> outputOversamplers;
+    std::vector<float> oversampledBuffer;     // One MAX_OVERSAMPLED_BLOCK run per channel
+    float* oversampledInputPtrs[MAX_IO] = {};
+    float* oversampledOutputPtrs[MAX_IO] = {};
+    static constexpr int MAX_OVERSAMPLED_BLOCK = MAX_BLOCK_SIZE * Oversampler::MAX_FACTOR;
+
+    // Reduced-rate processing (opt-in, see enableRateReduction())
+    static constexpr int MAX_RATE_DIVIDER = Oversampler::MAX_FACTOR;
+    int maxRateDivider = 1;            // 1 = not offered
+    int rateDivider = 1;
+    std::atomic<int> requestedRateDivider{1};  // Written by UI, applied on audio thread
+    std::vector<Oversampler> inputDecimators;
+    std::vector<Oversampler> outputInterpolators;
+    std::vector<float> reducedBuffer;         // One MAX_BLOCK_SIZE run per channel
+    float* reducedInputPtrs[MAX_IO] = {};
+    float* reducedOutputPtrs[MAX_IO] = {};
+
+    // Fixed internal rate (opt-in, see enableFixedRate())
+    int fixedRateTarget = 0;           // 0 = not offered
+    std::atomic<bool> requestedFixedRate{false};  // Written by UI, applied on audio thread
+
+    // Gate params held between compute() calls (see setGateParam())
+    static constexpr int MAX_HELD_GATES = 8;
+    int heldGateParams[MAX_HELD_GATES] = {};
+    float heldGateValues[MAX_HELD_GATES] = {};
+    int numHeldGates = 0;
+
+#ifdef WR_DENORMAL_STATS
+    // Diagnostic build: subnormal DSP outputs, logged when the count grows
+    static constexpr uint64_t DENORMAL_REPORT_FRAMES = uint64_t(1) << 19;  // ~11s at 48kHz
+    uint64_t subnormalOutputs = 0;
+    uint64_t subnormalReported = 0;
+    uint64_t computedFrames = 0;
+#endif
+
+    /**
+     * Run count frames through faustDsp, at the oversampled or reduced rate
+     * if enabled (count must then be a multiple of rateDivider)
+     */
+    void computeBlock(int count, float** in, float** out) {
+        if (rateDivider > 1) {
+            int reduced = count / rateDivider;
+            for (size_t i = 0; i < inputDecimators.size(); i++) {
+                inputDecimators[i].downsample(in[i], reducedInputPtrs[i], reduced);
+            }
+            computeDsp(faustDsp, reduced, reducedInputPtrs, reducedOutputPtrs);
+            for (size_t i = 0; i < outputInterpolators.size(); i++) {
+                outputInterpolators[i].upsample(reducedOutputPtrs[i], out[i], reduced);
+            }
+            return;
+        }
+
+        if (oversample <= 1) {
+            computeDsp(faustDsp, count, in, out);
+            return;
+        }
+
+        int numInputs = static_cast<int>(inputOversamplers.size());
+        int numOutputs = static_cast<int>(outputOversamplers.size());
+        for (int i = 0; i < numInputs; i++) {
+            inputOversamplers[i].upsample(in[i], oversampledInputPtrs[i], count);
+        }
+        computeDsp(faustDsp, count * oversample, oversampledInputPtrs, oversampledOutputPtrs);
+        for (int i = 0; i < numOutputs; i++) {
+            outputOversamplers[i].downsample(oversampledOutputPtrs[i], out[i], count);
+        }
+    }
+
+    /**
+     * Run compute() on a DSP instance with denormals flushed to zero
+     *
+     * Also for the extra Faust DSPs a module runs beside faustDsp, so they
+     * are counted by the profiler and the denormal stats.
+     */
+    template <typename DSP>
+    void computeDsp(DSP& dsp, int count, float** in, float** out) {
+        WR_PROFILE_SCOPE(profile, "compute");
+        ScopedFlushDenormals noDenormals;
+        dsp.compute(count, in, out);
+#ifdef WR_DENORMAL_STATS
+        recordSubnormals(dsp, count, out);
+#endif
+    }
+
+#ifdef WR_DENORMAL_STATS
+    template <typename DSP>
+    void recordSubnormals(DSP& dsp, int count, float** out) {
+        int numOutputs = std::min(dsp.getNumOutputs(), MAX_IO);
+        for (int i = 0; i < numOutputs; i++) {
+            subnormalOutputs += countSubnormals(out[i], count);
+        }
+
+        computedFrames += count;
+        if (computedFrames >= DENORMAL_REPORT_FRAMES) {
+            computedFrames = 0;
+            if (subnormalOutputs != subnormalReported) {
+                INFO("%s: %llu subnormal Faust outputs",
+                     model ? model->slug.c_str() : "FaustModule",
+                     static_cast<unsigned long long>(subnormalOutputs));
+                subnormalReported = subnormalOutputs;
+            }
+        }
+    }
+#endif
+
     /**
      * Map a VCV parameter (knob) directly to a Faust parameter
      *
@@ -111,6 +338,25 @@ protected:
         cvMappings.emplace_back(vcvInputId, faustParamIdx, exponential, scale);
     }
 
+    /**
+     * Hold a Faust parameter at a fixed value, ignoring any knob or CV
+     * mapped to it. The value is not saved with the patch.
+     *
+     * @param faustParamIdx Faust parameter index
+     * @param value         Value sent to Faust
+     */
+    void overrideParam(int faustParamIdx, float value) {
+        paramOverrides.emplace_back(faustParamIdx, value);
+        paramSlotsBuilt = false;
+    }
+
+    bool isParamOverridden(int faustParamIdx) const {
+        for (const auto& o : paramOverrides) {
+            if (o.first == faustParamIdx) return true;
+        }
+        return false;
+    }
+
     /**
      * Set which VCV input/output are the main audio I/O
      * (for simple mono modules)
@@ -120,40 +366,529 @@ protected:
         audioOutputId = outputId;
     }
 
+    /**
+     * Evaluate mapped parameters every N samples instead of every sample
+     *
+     * @param divider  Samples between evaluations (1 = every sample, no ramps)
+     */
+    void setControlRate(int divider) {
+        controlRateDivider = std::max(divider, 1);
+        controlCounter = 0;
+    }
+
+    /**
+     * Stop calling compute() once input and output have been silent for a while
+     *
+     * @param holdSeconds  How long both must stay below the threshold; must
+     *                     cover the longest delay inside the DSP so a pending
+     *                     echo isn't cut off
+     * @param threshold    Peak level in Faust units (1.0 = 5V)
+     *
+     * While bypassed computeFrame() outputs zeros. Any input frame above the
+     * threshold (or a keepAwake() call) resumes processing on that same
+     * frame. The DSP state is kept, and a bypassed DSP has already decayed
+     * below the threshold, so resuming is click-free.
+     */
+    void setSilenceBypass(float holdSeconds, float threshold = DEFAULT_SILENCE_THRESHOLD) {
+        silenceHoldSeconds = std::max(holdSeconds, 0.0f);
+        silenceThreshold = threshold;
+        updateSilenceHold(48000);
+    }
+
+    /**
+     * Only let the first count inputs wake the DSP from silence bypass
+     *
+     * For DSPs whose later inputs are never silent but don't make sound on
+     * their own, such as a noise feed from BlockNoise.hpp.
+     */
+    void setActivityInputs(int count) {
+        activityInputs = std::max(count, 0);
+    }
+
+    /**
+     * Offer oversampling for this module (call from the constructor)
+     *
+     * @param maxFactor  Highest factor offered (2, 4 or 8). Keep it low for
+     *                   DSPs whose delay lines are sized in samples, since
+     *                   they shrink in time at the higher rate.
+     *
+     * Oversampling itself starts off; it is chosen with setOversampling()
+     * (context menu, see appendOversamplingMenu()) and saved with the patch.
+     */
+    void enableOversampling(int maxFactor = Oversampler::MAX_FACTOR) {
+        maxOversample = std::min(std::max(maxFactor, 1), Oversampler::MAX_FACTOR);
+
+        int numInputs = std::min(faustDsp.getNumInputs(), MAX_IO);
+        int numOutputs = std::min(faustDsp.getNumOutputs(), MAX_IO);
+        inputOversamplers.assign(numInputs, Oversampler());
+        outputOversamplers.assign(numOutputs, Oversampler());
+        oversampledBuffer.assign((numInputs + numOutputs) * MAX_OVERSAMPLED_BLOCK, 0.0f);
+        for (int i = 0; i < numInputs; i++) {
+            oversampledInputPtrs[i] = &oversampledBuffer[i * MAX_OVERSAMPLED_BLOCK];
+        }
+        for (int i = 0; i < numOutputs; i++) {
+            oversampledOutputPtrs[i] = &oversampledBuffer[(numInputs + i) * MAX_OVERSAMPLED_BLOCK];
+        }
+    }
+
+    /**
+     * Offer reduced-rate processing (call from the constructor)
+     *
+     * @param maxDivider  Lowest rate offered as a divider of the engine rate
+     *                    (2 or 4)
+     *
+     * Decimation and interpolation use the Oversampler half-band stages,
+     * flat to 0.4x the reduced rate, so it suits DSPs whose output is dark
+     * anyway. It starts off; it is chosen with setRateDivider() (context
+     * menu, see appendRateReductionMenu()) and saved with the patch. Not
+     * combined with oversampling.
+     */
+    void enableRateReduction(int maxDivider = 4) {
+        maxRateDivider = std::min(std::max(maxDivider, 1), MAX_RATE_DIVIDER);
+
+        int numInputs = std::min(faustDsp.getNumInputs(), MAX_IO);
+        int numOutputs = std::min(faustDsp.getNumOutputs(), MAX_IO);
+        inputDecimators.assign(numInputs, Oversampler());
+        outputInterpolators.assign(numOutputs, Oversampler());
+        reducedBuffer.assign((numInputs + numOutputs) * MAX_BLOCK_SIZE, 0.0f);
+        for (int i = 0; i < numInputs; i++) {
+            reducedInputPtrs[i] = &reducedBuffer[i * MAX_BLOCK_SIZE];
+        }
+        for (int i = 0; i < numOutputs; i++) {
+            reducedOutputPtrs[i] = &reducedBuffer[(numInputs + i) * MAX_BLOCK_SIZE];
+        }
+    }
+
+    /**
+     * Offer a fixed internal rate (call from the constructor)
+     *
+     * @param targetRate  Rate the DSP should run at, whatever the engine rate
+     *
+     * When chosen (setFixedRate(), context menu via appendFixedRateMenu(),
+     * saved with the patch), compute() runs at the engine rate divided by
+     * the largest power of two (up to 8) that stays within 10% below
+     * targetRate, through the reduced-rate half-band stages. Rack's rates
+     * are 44.1 or 48 kHz times a power of two, so at 88.2 kHz and up a
+     * DSP asking for 48000 runs at 44.1 or 48 kHz; its cost stops growing
+     * with the engine rate and models tuned in samples sound the same.
+     * Audio outputs are band-limited to 0.4x the internal rate. Params set
+     * directly are sampled once per internal-rate frame; pass gates and
+     * triggers through setGateParam() so short pulses are not missed. Not
+     * combined with oversampling or enableRateReduction().
+     */
+    void enableFixedRate(int targetRate = 48000) {
+        fixedRateTarget = std::max(targetRate, 1);
+        enableRateReduction(MAX_RATE_DIVIDER);
+        maxRateDivider = 1;   // The divider follows the engine rate, not the menu
+    }
+
+    // Divider that brings engineRate down to about fixedRateTarget
+    int fixedRateDivider(int engineRate) const {
+        int divider = 1;
+        while (divider < MAX_RATE_DIVIDER
+               && engineRate / (divider * 2) >= fixedRateTarget * 0.9f) {
+            divider *= 2;
+        }
+        return divider;
+    }
+
+    /**
+     * Set a gate or trigger parameter so that it survives block and
+     * reduced-rate processing
+     *
+     * Between two compute() calls the parameter holds the highest value it
+     * was given, so a trigger high for one engine sample is still high for
+     * the next block the DSP computes. In per-sample mode this is
+     * setParamValue(). At most MAX_HELD_GATES parameters.
+     */
+    void setGateParam(int faustParamIdx, float value) {
+        int i = 0;
+        while (i < numHeldGates && heldGateParams[i] != faustParamIdx) i++;
+        if (i == numHeldGates) {
+            if (numHeldGates == MAX_HELD_GATES) {
+                faustDsp.setParamValue(faustParamIdx, value);
+                return;
+            }
+            heldGateParams[numHeldGates] = faustParamIdx;
+            heldGateValues[numHeldGates++] = value;
+        } else {
+            heldGateValues[i] = std::max(heldGateValues[i], value);
+        }
+        faustDsp.setParamValue(faustParamIdx, heldGateValues[i]);
+    }
+
+    // Start holding afresh after a compute() (see setGateParam())
+    void releaseHeldGates() {
+        numHeldGates = 0;
+    }
+
+    // Rate the DSP runs at: engine rate, oversampled or reduced
+    int dspSampleRate() const {
+        return engineSampleRate * oversample / rateDivider;
+    }
+
+    /**
+     * Initialize the DSP for the engine sample rate (times the oversampling
+     * factor, or divided for reduced-rate processing). Use instead of
+     * faustDsp.init() in process().
+     *
+     * Only the first call is a full init(); after that the same rate costs
+     * nothing and a new one keeps parameters and schedules a clear.
+     */
+    void initDsp(float sampleRate) {
+        int rate = static_cast<int>(sampleRate);
+        if (engineSampleRate == 0) {
+            engineSampleRate = rate;
+            faustDsp.init(dspSampleRate());
+            resetOversamplers();
+            return;
+        }
+        if (rate == engineSampleRate) return;
+
+        engineSampleRate = rate;
+        faustDsp.setSampleRate(dspSampleRate(), false);
+        scheduleClear();
+    }
+
+    /**
+     * Clear the DSP state a few frames from now, muting until then
+     *
+     * Successive calls (across all modules) take successive stagger slots,
+     * so the clears land in different engine blocks.
+     */
+    void scheduleClear() {
+        int slot = static_cast<int>(FaustModuleDetail::nextClearSlot() % CLEAR_STAGGER_SLOTS);
+        clearCountdown = 1 + slot * CLEAR_STAGGER_FRAMES;
+    }
+
+    void clearState() {
+        faustDsp.instanceClear();
+        resetOversamplers();
+        resetBlock();
+        silentSamples = 0;
+        bypassed = false;
+    }
+
+    /**
+     * Switch to a pending oversampling factor (only called at a block boundary)
+     *
+     * The DSP keeps its parameter values; its state is cleared because
+     * delay lines and filters don't carry over to the new rate.
+     */
+    void applyRequestedOversampling() {
+        int requested = requestedOversample.load(std::memory_order_relaxed);
+        if (requested == oversample) return;
+        oversample = requested;
+        for (auto& os : inputOversamplers) os.setFactor(oversample);
+        for (auto& os : outputOversamplers) os.setFactor(oversample);
+        if (engineSampleRate > 0) {
+            faustDsp.setSampleRate(dspSampleRate());
+        }
+    }
+
+    // Divider the next applyRequestedRateDivider() switches to
+    int pendingRateDivider() const {
+        if (fixedRateTarget > 0) {
+            return requestedFixedRate.load(std::memory_order_relaxed)
+                ? fixedRateDivider(engineSampleRate) : 1;
+        }
+        return requestedRateDivider.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Switch to a pending rate divider (only called at a block boundary),
+     * clearing the DSP state like an oversampling change
+     */
+    void applyRequestedRateDivider() {
+        int requested = pendingRateDivider();
+        if (requested == rateDivider) return;
+        rateDivider = requested;
+        for (auto& os : inputDecimators) os.setFactor(rateDivider);
+        for (auto& os : outputInterpolators) os.setFactor(rateDivider);
+        if (engineSampleRate > 0) {
+            faustDsp.setSampleRate(dspSampleRate());
+        }
+    }
+
+    void resetOversamplers() {
+        for (auto& os : inputOversamplers) os.reset();
+        for (auto& os : outputOversamplers) os.reset();
+        for (auto& os : inputDecimators) os.reset();
+        for (auto& os : outputInterpolators) os.reset();
+    }
+
+    /**
+     * Mark the next frame as active, for excitation that doesn't arrive
+     * through the audio inputs (triggers, gates, internal generators)
+     */
+    void keepAwake() {
+        activityPending = true;
+    }
+
+    bool isBypassed() const {
+        return bypassed;
+    }
+
+    void updateSilenceHold(int sampleRate) {
+        silenceHoldSamples = static_cast<int>(silenceHoldSeconds * sampleRate);
+        silentSamples = 0;
+        bypassed = false;
+    }
+
     /**
      * Update all Faust parameters from VCV params and CV inputs
+     *
+     * Call once per sample. Knobs and CV are read every controlRateDivider
+     * samples; changed values are handed to Faust as a per-sample linear
+     * ramp so there is no zipper noise, and unchanged ones cost nothing.
+     * Snapped (switch-like) params jump straight to their new value.
      */
     void updateFaustParams() {
-        // First, apply knob values
+        advanceParamSlots();
+        for (auto& slot : paramSlots) {
+            if (!slot.dirty) continue;
+            slot.dirty = false;
+            faustDsp.setParamValue(slot.faustParamIdx, slot.current);
+        }
+    }
+
+    /**
+     * One frame of the pipeline without touching faustDsp: slots whose
+     * current value moved are marked dirty. For modules that hand the
+     * values to a DSP running elsewhere (clear dirty once sent).
+     */
+    void advanceParamSlots() {
+        WR_PROFILE_SCOPE(profile, "params");
+        if (!paramSlotsBuilt) {
+            buildParamSlots();
+        }
+
+        if (--controlCounter <= 0) {
+            controlCounter = controlRateDivider;
+            evaluateParamTargets();
+        }
+
+        for (auto& slot : paramSlots) {
+            if (slot.remaining <= 0) continue;
+            if (--slot.remaining == 0) {
+                slot.current = slot.target;
+            } else {
+                slot.current += slot.step;
+            }
+            slot.dirty = true;
+        }
+    }
+
+    /**
+     * Group the mappings by Faust parameter (done lazily so that
+     * configParam() snap settings and Faust ranges are known)
+     */
+    void buildParamSlots() {
+        paramSlots.clear();
+
+        auto findSlot = [this](int faustParamIdx) {
+            for (size_t i = 0; i < paramSlots.size(); i++) {
+                if (paramSlots[i].faustParamIdx == faustParamIdx) return static_cast<int>(i);
+            }
+            ParamSlot slot(faustParamIdx);
+            slot.minVal = faustDsp.getParamMin(faustParamIdx);
+            slot.maxVal = faustDsp.getParamMax(faustParamIdx);
+            slot.pending = slot.target = slot.current = faustDsp.getParamInit(faustParamIdx);
+            paramSlots.push_back(slot);
+            return static_cast<int>(paramSlots.size() - 1);
+        };
+
         for (const auto& mapping : paramMappings) {
-            float value = params[mapping.vcvParamId].getValue();
-            faustDsp.setParamValue(mapping.faustParamIdx, value);
+            ParamSlot& slot = paramSlots[findSlot(mapping.faustParamIdx)];
+            slot.vcvParamId = mapping.vcvParamId;
+            if (mapping.vcvParamId < static_cast<int>(paramQuantities.size())
+                && paramQuantities[mapping.vcvParamId]) {
+                slot.snap = paramQuantities[mapping.vcvParamId]->snapEnabled;
+            }
+        }
+
+        for (auto& cv : cvMappings) {
+            cv.slot = findSlot(cv.faustParamIdx);
+        }
+
+        for (const auto& o : paramOverrides) {
+            ParamSlot& slot = paramSlots[findSlot(o.first)];
+            slot.overridden = true;
+            slot.overrideValue = o.second;
+        }
+
+        paramSlotsBuilt = true;
+        paramSlotsPrimed = false;
+        controlCounter = 0;
+    }
+
+    /**
+     * Read knobs/CV and start a ramp for every target that changed
+     */
+    void evaluateParamTargets() {
+        // First, apply knob values
+        for (auto& slot : paramSlots) {
+            if (slot.overridden) {
+                slot.pending = slot.overrideValue;
+            } else {
+                slot.pending = (slot.vcvParamId >= 0)
+                    ? params[slot.vcvParamId].getValue()
+                    : faustDsp.getParamInit(slot.faustParamIdx);
+            }
         }
 
         // Then, apply CV modulation
-        for (const auto& cv : cvMappings) {
+        for (auto& cv : cvMappings) {
             if (!inputs[cv.vcvInputId].isConnected()) continue;
 
+            ParamSlot& slot = paramSlots[cv.slot];
+            if (slot.overridden) continue;
             float voltage = inputs[cv.vcvInputId].getVoltage();
-            float currentValue = faustDsp.getParamValue(cv.faustParamIdx);
 
             if (cv.exponential) {
                 // V/Oct: multiply current value by 2^voltage
-                currentValue *= DSP::voltToFreqMultiplier(voltage);
+                if (voltage != cv.lastVoltage) {
+                    cv.lastVoltage = voltage;
+                    cv.lastMultiplier = DSP::voltToFreqMultiplier(voltage);
+                }
+                slot.pending *= cv.lastMultiplier;
             } else {
                 // Linear: add scaled voltage to current value
-                currentValue += voltage * cv.scale;
+                slot.pending += voltage * cv.scale;
             }
 
             // Clamp to Faust parameter range
-            float minVal = faustDsp.getParamMin(cv.faustParamIdx);
-            float maxVal = faustDsp.getParamMax(cv.faustParamIdx);
-            currentValue = DSP::clamp(currentValue, minVal, maxVal);
+            slot.pending = DSP::clamp(slot.pending, slot.minVal, slot.maxVal);
+        }
+
+        // Hand changed values to Faust
+        for (auto& slot : paramSlots) {
+            if (!paramSlotsPrimed || slot.snap || controlRateDivider <= 1) {
+                slot.target = slot.current = slot.pending;
+                slot.remaining = 0;
+                slot.dirty = true;
+            } else if (slot.pending != slot.target) {
+                slot.target = slot.pending;
+                slot.step = (slot.target - slot.current) / controlRateDivider;
+                slot.remaining = controlRateDivider;
+            }
+        }
+        paramSlotsPrimed = true;
+    }
+
+    /**
+     * Run one sample frame through the Faust DSP
+     *
+     * @param in   getNumInputs() input samples (may be nullptr if the DSP has none)
+     * @param out  getNumOutputs() output samples
+     *
+     * In per-sample mode this is compute(1). In block mode the frame is queued
+     * and the output of the previous block is played back, so parameters set
+     * before this call take effect at the next block boundary. Gate/trigger
+     * pulses shorter than a block can be missed, so only offer block mode on
+     * modules driven purely by audio and slow control values.
+     *
+     * With setSilenceBypass() enabled, a silent input while bypassed returns
+     * zeros without calling compute(). With oversampling, compute() gets
+     * factor times as many frames per call.
+     */
+    void computeFrame(const float* in, float* out) {
+        int numInputs = std::min(faustDsp.getNumInputs(), MAX_IO);
+        int numOutputs = std::min(faustDsp.getNumOutputs(), MAX_IO);
+
+        if (clearCountdown > 0) {
+            if (--clearCountdown > 0) {
+                for (int i = 0; i < numOutputs; i++) out[i] = 0.0f;
+                return;
+            }
+            clearState();
+        }
+
+        if (blockPos == 0) {
+            applyRequestedRateDivider();
+            applyRequestedBlockSize();
+            applyRequestedOversampling();
+        }
 
-            faustDsp.setParamValue(cv.faustParamIdx, currentValue);
+        bool inputActive = false;
+        if (silenceHoldSamples > 0) {
+            inputActive = activityPending;
+            activityPending = false;
+            for (int i = 0; i < std::min(numInputs, activityInputs) && in && !inputActive; i++) {
+                inputActive = std::fabs(in[i]) > silenceThreshold;
+            }
+
+            if (bypassed) {
+                if (!inputActive) {
+                    for (int i = 0; i < numOutputs; i++) out[i] = 0.0f;
+                    return;
+                }
+                bypassed = false;
+                silentSamples = 0;
+            }
+        }
+
+        if (blockSize <= 1) {
+            for (int i = 0; i < numInputs; i++) inputBuffer[i] = in ? in[i] : 0.0f;
+            computeBlock(1, inputPtrs, outputPtrs);
+            releaseHeldGates();
+            for (int i = 0; i < numOutputs; i++) out[i] = outputBuffer[i];
+        } else {
+            for (int i = 0; i < numInputs; i++) blockInputs[i][blockPos] = in ? in[i] : 0.0f;
+            for (int i = 0; i < numOutputs; i++) out[i] = blockOutputs[i][blockPos];
+
+            if (++blockPos >= blockSize) {
+                computeBlock(blockSize, blockInputPtrs, blockOutputPtrs);
+                releaseHeldGates();
+                blockPos = 0;
+            }
+        }
+
+        if (silenceHoldSamples > 0) {
+            updateSilence(out, numOutputs, inputActive);
         }
     }
 
+    /**
+     * Count silent frames and enter bypass after the hold time
+     *
+     * Bypass only starts at a block boundary, so no queued block input is
+     * dropped.
+     */
+    void updateSilence(const float* out, int numOutputs, bool inputActive) {
+        bool silent = !inputActive;
+        for (int i = 0; i < numOutputs && silent; i++) {
+            silent = std::fabs(out[i]) <= silenceThreshold;
+        }
+
+        if (!silent) {
+            silentSamples = 0;
+        } else if (++silentSamples >= silenceHoldSamples && blockPos == 0) {
+            bypassed = true;
+            resetBlock();
+        }
+    }
+
+    /**
+     * Switch to a pending block size (only called at a block boundary)
+     */
+    void applyRequestedBlockSize() {
+        // Reduced rate needs whole divider-sized blocks (8..64 all qualify)
+        int requested = std::max(requestedBlockSize.load(std::memory_order_relaxed), rateDivider);
+        if (requested == blockSize) return;
+        blockSize = requested;
+        resetBlock();
+    }
+
+    /**
+     * Clear queued block I/O (e.g. after init() cleared the DSP state)
+     */
+    void resetBlock() {
+        blockPos = 0;
+        std::memset(blockInputs, 0, sizeof(blockInputs));
+        std::memset(blockOutputs, 0, sizeof(blockOutputs));
+    }
+
     /**
      * Convert VCV audio voltage (+/-5V) to Faust range (+/-1.0)
      */
@@ -169,19 +904,111 @@ protected:
     }
 
 public:
+#ifdef WR_PROFILE
+    ModuleProfile profile{this};   // Section timings, see Profiler.hpp
+#endif
+
     FaustModule() {
         // Initialize buffer pointers
         for (int i = 0; i < MAX_IO; i++) {
             inputPtrs[i] = &inputBuffer[i];
             outputPtrs[i] = &outputBuffer[i];
+            blockInputPtrs[i] = blockInputs[i];
+            blockOutputPtrs[i] = blockOutputs[i];
+        }
+    }
+
+    /**
+     * Request a processing block size (1 = per-sample, or 8/16/32/64)
+     *
+     * Safe to call from the UI thread; the audio thread switches over at
+     * the next block boundary.
+     */
+    void setBlockSize(int size) {
+        int clamped = 1;
+        for (int s : {8, 16, 32, 64}) {
+            if (size >= s) clamped = s;
+        }
+        requestedBlockSize.store(clamped, std::memory_order_relaxed);
+    }
+
+    int getBlockSize() const {
+        return requestedBlockSize.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Request an oversampling factor (1 = off, 2, 4 or 8, capped by
+     * enableOversampling()). Safe to call from the UI thread.
+     */
+    void setOversampling(int factor) {
+        int clamped = 1;
+        for (int f : {2, 4, 8}) {
+            if (factor >= f && f <= maxOversample) clamped = f;
         }
+        requestedOversample.store(clamped, std::memory_order_relaxed);
     }
 
+    int getOversampling() const {
+        return requestedOversample.load(std::memory_order_relaxed);
+    }
+
+    int getMaxOversampling() const {
+        return maxOversample;
+    }
+
+    /**
+     * Request a rate divider (1 = full rate, 2 or 4, capped by
+     * enableRateReduction()). Safe to call from the UI thread.
+     */
+    void setRateDivider(int divider) {
+        int clamped = 1;
+        for (int d : {2, 4}) {
+            if (divider >= d && d <= maxRateDivider) clamped = d;
+        }
+        requestedRateDivider.store(clamped, std::memory_order_relaxed);
+    }
+
+    int getRateDivider() const {
+        return requestedRateDivider.load(std::memory_order_relaxed);
+    }
+
+    int getMaxRateDivider() const {
+        return maxRateDivider;
+    }
+
+    /**
+     * Run at the fixed internal rate (see enableFixedRate()) or at the
+     * engine rate. Safe to call from the UI thread.
+     */
+    void setFixedRate(bool enable) {
+        requestedFixedRate.store(enable && fixedRateTarget > 0, std::memory_order_relaxed);
+    }
+
+    bool getFixedRate() const {
+        return requestedFixedRate.load(std::memory_order_relaxed);
+    }
+
+    int getFixedRateTarget() const {
+        return fixedRateTarget;
+    }
+
+#ifdef WR_DENORMAL_STATS
+    uint64_t getSubnormalOutputs() const {
+        return subnormalOutputs;
+    }
+#endif
+
     /**
      * Called when sample rate changes
      */
     void onSampleRateChange(const rack::engine::Module::SampleRateChangeEvent& e) override {
-        faustDsp.init(static_cast<int>(e.sampleRate));
+        bool first = (engineSampleRate == 0);
+        initDsp(e.sampleRate);
+        if (first) resetBlock();
+        updateSilenceHold(static_cast<int>(e.sampleRate));
+        // Resend every mapped value (init() restores Faust defaults)
+        paramSlotsPrimed = false;
+        controlCounter = 0;
         initialized = true;
     }
 
@@ -192,9 +1019,11 @@ public:
      * Default implementation handles simple mono in -> mono out.
      */
     void process(const rack::engine::Module::ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -216,15 +1045,13 @@ public:
             }
         }
 
-        // Process one sample through Faust DSP
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        // Process one sample frame through Faust DSP
+        float frameOut[MAX_IO] = {};
+        computeFrame(inputBuffer, frameOut);
 
         // Write outputs
-        int numOutputs = faustDsp.getNumOutputs();
-        for (int i = 0; i < numOutputs && i < MAX_IO; i++) {
-            if (audioOutputId >= 0 && i == 0) {
-                outputs[audioOutputId].setVoltage(faustToVCV(outputBuffer[i]));
-            }
+        if (audioOutputId >= 0 && faustDsp.getNumOutputs() > 0) {
+            outputs[audioOutputId].setVoltage(faustToVCV(frameOut[0]));
         }
     }
 
@@ -233,24 +1060,60 @@ public:
      */
     json_t* dataToJson() override {
         json_t* rootJ = json_object();
+        paramsToJson(rootJ, [this](int i) { return faustDsp.getParamValue(i); });
+        settingsToJson(rootJ);
+        return rootJ;
+    }
+
+    /**
+     * Load Faust DSP state from JSON
+     */
+    void dataFromJson(json_t* rootJ) override {
+        paramsFromJson(rootJ, [this](int i, float value) { faustDsp.setParamValue(i, value); });
+        settingsFromJson(rootJ);
+    }
 
-        // Save all Faust parameter values
+protected:
+    /**
+     * Save get(index) for each Faust parameter (by path, overrides skipped).
+     * Modules whose parameters live outside faustDsp pass a get() that
+     * reads them from where they are.
+     */
+    template <typename Get>
+    void paramsToJson(json_t* rootJ, Get get) {
         int numParams = faustDsp.getNumParams();
         for (int i = 0; i < numParams; i++) {
+            if (isParamOverridden(i)) continue;
             const char* path = faustDsp.getParamPath(i);
-            float value = faustDsp.getParamValue(i);
-            json_object_set_new(rootJ, path, json_real(value));
+            json_object_set_new(rootJ, path, json_real(get(i)));
         }
+    }
 
-        return rootJ;
+    // Block size, oversampling, rate divider and fixed rate
+    void settingsToJson(json_t* rootJ) {
+        json_object_set_new(rootJ, "blockSize", json_integer(getBlockSize()));
+        if (maxOversample > 1) {
+            json_object_set_new(rootJ, "oversample", json_integer(getOversampling()));
+        }
+        if (maxRateDivider > 1) {
+            json_object_set_new(rootJ, "rateDivider", json_integer(getRateDivider()));
+        }
+        if (fixedRateTarget > 0) {
+            json_object_set_new(rootJ, "fixedRate", json_boolean(getFixedRate()));
+        }
     }
 
     /**
-     * Load Faust DSP state from JSON
+     * Hand each saved Faust parameter (by path, overrides skipped) to
+     * set(index, value), then resend the mapped values on the next frame.
+     * Modules whose faustDsp runs on another thread pass a set() that
+     * queues the values instead of writing the DSP.
      */
-    void dataFromJson(json_t* rootJ) override {
+    template <typename Set>
+    void paramsFromJson(json_t* rootJ, Set set) {
         int numParams = faustDsp.getNumParams();
         for (int i = 0; i < numParams; i++) {
+            if (isParamOverridden(i)) continue;
             const char* path = faustDsp.getParamPath(i);
             json_t* valueJ = json_object_get(rootJ, path);
             if (valueJ) {
@@ -262,10 +1125,138 @@ public:
                 } else {
                     continue;
                 }
-                faustDsp.setParamValue(i, value);
+                set(i, value);
             }
         }
+
+        paramSlotsPrimed = false;
+        controlCounter = 0;
+    }
+
+    // Block size, oversampling, rate divider and fixed rate
+    void settingsFromJson(json_t* rootJ) {
+        json_t* blockSizeJ = json_object_get(rootJ, "blockSize");
+        if (blockSizeJ) {
+            setBlockSize(static_cast<int>(json_integer_value(blockSizeJ)));
+        }
+
+        json_t* oversampleJ = json_object_get(rootJ, "oversample");
+        if (oversampleJ) {
+            setOversampling(static_cast<int>(json_integer_value(oversampleJ)));
+        }
+
+        json_t* rateDividerJ = json_object_get(rootJ, "rateDivider");
+        if (rateDividerJ) {
+            setRateDivider(static_cast<int>(json_integer_value(rateDividerJ)));
+        }
+
+        json_t* fixedRateJ = json_object_get(rootJ, "fixedRate");
+        if (fixedRateJ) {
+            setFixedRate(json_boolean_value(fixedRateJ));
+        }
     }
 };
 
+/**
+ * Append the processing block size submenu to a module's context menu
+ *
+ * Call from ModuleWidget::appendContextMenu() for modules where block mode
+ * is safe (no short trigger pulses fed through Faust parameters).
+ */
+template<typename TModule>
+inline void appendBlockSizeMenu(rack::ui::Menu* menu, TModule* module) {
+    static const int sizes[] = {1, 8, 16, 32, 64};
+    std::vector<std::string> labels = {"Off (per sample)"};
+    for (int i = 1; i < 5; i++) {
+        labels.push_back(std::to_string(sizes[i]) + " samples");
+    }
+
+    menu->addChild(new rack::ui::MenuSeparator());
+    menu->addChild(rack::createIndexSubmenuItem("Block processing (adds latency)", labels,
+        [=]() {
+            int current = module->getBlockSize();
+            for (size_t i = 0; i < 5; i++) {
+                if (sizes[i] == current) return i;
+            }
+            return (size_t)0;
+        },
+        [=](size_t index) { module->setBlockSize(sizes[index]); }
+    ));
+}
+
+/**
+ * Append the oversampling submenu for modules that called
+ * enableOversampling()
+ */
+template<typename TModule>
+inline void appendOversamplingMenu(rack::ui::Menu* menu, TModule* module) {
+    std::vector<int> factors = {1};
+    for (int f = 2; f <= module->getMaxOversampling(); f *= 2) {
+        factors.push_back(f);
+    }
+    if (factors.size() < 2) return;
+
+    std::vector<std::string> labels = {"Off"};
+    for (size_t i = 1; i < factors.size(); i++) {
+        labels.push_back(std::to_string(factors[i]) + "x");
+    }
+
+    menu->addChild(rack::createIndexSubmenuItem("Oversampling", labels,
+        [=]() {
+            int current = module->getOversampling();
+            for (size_t i = 0; i < factors.size(); i++) {
+                if (factors[i] == current) return i;
+            }
+            return (size_t)0;
+        },
+        [=](size_t index) { module->setOversampling(factors[index]); }
+    ));
+}
+
+/**
+ * Append the processing-rate submenu for modules that called
+ * enableRateReduction()
+ */
+template<typename TModule>
+inline void appendRateReductionMenu(rack::ui::Menu* menu, TModule* module,
+                                    const std::string& title = "Processing rate") {
+    std::vector<int> dividers = {1};
+    for (int d = 2; d <= module->getMaxRateDivider(); d *= 2) {
+        dividers.push_back(d);
+    }
+    if (dividers.size() < 2) return;
+
+    std::vector<std::string> labels = {"Full"};
+    for (size_t i = 1; i < dividers.size(); i++) {
+        labels.push_back("1/" + std::to_string(dividers[i]) + " (eco)");
+    }
+
+    menu->addChild(rack::createIndexSubmenuItem(title, labels,
+        [=]() {
+            int current = module->getRateDivider();
+            for (size_t i = 0; i < dividers.size(); i++) {
+                if (dividers[i] == current) return i;
+            }
+            return (size_t)0;
+        },
+        [=](size_t index) { module->setRateDivider(dividers[index]); }
+    ));
+}
+
+/**
+ * Append the fixed internal rate toggle for modules that called
+ * enableFixedRate()
+ */
+template<typename TModule>
+inline void appendFixedRateMenu(rack::ui::Menu* menu, TModule* module) {
+    int target = module->getFixedRateTarget();
+    if (target <= 0) return;
+
+    std::string label = "Run at " + std::to_string(target / 1000) + " kHz at higher engine rates";
+    menu->addChild(rack::createBoolMenuItem(label, "",
+        [=]() { return module->getFixedRate(); },
+        [=](bool enable) { module->setFixedRate(enable); }
+    ));
+}
+
 } // namespace WiggleRoom
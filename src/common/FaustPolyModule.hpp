@@ -0,0 +1,338 @@
+#pragma once
+
+#include "FaustModule.hpp"
+
+namespace WiggleRoom {
+
+/**
+ * Polyphonic base class for VCV Rack modules wrapping Faust-generated DSP
+ *
+ * Runs one Faust DSP instance per channel (up to 16). The channel count
+ * follows the widest connected poly input (the audio input, every mapped CV
+ * input and any extra inputs registered with addPolyInput()), and all
+ * outputs are set to that many channels.
+ *
+ * Voices live in one contiguous array and only the active channels are
+ * computed, so an idle voice costs nothing. Knob mappings are shared by all
+ * voices; CV mappings read the matching channel of the cable (a mono cable
+ * modulates every voice).
+ *
+ * Parameters go through FaustModule's control-rate pipeline with one target
+ * per channel: every controlRateDivider frames each ParamSlot's base (knob
+ * or Faust init value) plus channel c of its CV is evaluated for all 16
+ * channels at once, four per float_4, and changed targets are ramped over
+ * the next divider frames. Voices only receive values that moved.
+ *
+ * The mapParam()/mapCVInput()/setAudioIO() API is the same as FaustModule.
+ * Modules with custom process() call updateChannels() once per frame (it
+ * also advances the parameter ramps), then per channel updateVoiceParams(c),
+ * voice(c).setParamValue(...) for their own parameters, and
+ * computeVoice(c, in, out).
+ *
+ * Block processing is not available in poly mode: each voice is computed
+ * one sample at a time.
+ *
+ * After a sample rate change voices keep their parameters and are cleared
+ * lazily, on their next computeVoice(), so idle voices cost nothing.
+ *
+ * Example:
+ *   struct MyVoice : FaustPolyModule<VCVRackDSP> {
+ *       MyVoice() {
+ *           config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+ *           ...
+ *           mapParam(CUTOFF_PARAM, FP::CUTOFF);
+ *           mapCVInput(CUTOFF_CV_INPUT, FP::CUTOFF, true);
+ *           addPolyInput(VOCT_INPUT);
+ *       }
+ *   };
+ */
+template<typename FaustDSP>
+struct FaustPolyModule : FaustModule<FaustDSP> {
+    using Base = FaustModule<FaustDSP>;
+
+    static constexpr int MAX_POLY = 16;
+    static constexpr int GROUPS = MAX_POLY / 4;
+
+protected:
+    using float_4 = rack::simd::float_4;
+
+    /**
+     * Per-channel control-rate state for the ParamSlot with the same index
+     */
+    struct VoiceSlot {
+        float_4 pending[GROUPS];
+        float_4 target[GROUPS];
+        float_4 current[GROUPS];
+        float_4 step[GROUPS];
+        int remaining = 0;
+        bool jumped = false;     // Targets replaced outright at the last evaluation
+        bool changed = false;    // current moved this frame, send it to the voices
+    };
+
+    // One DSP instance per channel (Base::faustDsp holds the
+    // reference values used for parameter ranges; patches store voice 0)
+    FaustDSP voices[MAX_POLY];
+
+    // Inputs whose channel count drives the voice count
+    std::vector<int> polyInputIds;
+
+    std::vector<VoiceSlot> voiceSlots;
+
+    int channels = 1;
+    int sampleRate = 0;
+    uint32_t staleVoices = 0;   // Bit c = voice c must be cleared before use
+
+    /**
+     * Register an extra input (e.g. V/Oct or Gate) whose channel count
+     * should drive the number of voices
+     */
+    void addPolyInput(int vcvInputId) {
+        polyInputIds.push_back(vcvInputId);
+    }
+
+    FaustDSP& voice(int c) {
+        return voices[c];
+    }
+
+    /**
+     * Recompute the active channel count and set it on every output, and
+     * advance the parameter pipeline by one frame
+     *
+     * Voices that become active are cleared so they start silent
+     * instead of replaying a stale tail, and get every mapped value.
+     */
+    int updateChannels() {
+        advanceVoiceSlots();
+
+        int count = 1;
+        if (this->audioInputId >= 0) {
+            count = std::max(count, this->inputs[this->audioInputId].getChannels());
+        }
+        for (const auto& cv : this->cvMappings) {
+            count = std::max(count, this->inputs[cv.vcvInputId].getChannels());
+        }
+        for (int id : polyInputIds) {
+            count = std::max(count, this->inputs[id].getChannels());
+        }
+        count = std::min(count, MAX_POLY);
+
+        for (int c = channels; c < count; c++) {
+            voices[c].instanceClear();
+            staleVoices &= ~(1u << c);
+            sendVoiceParams(c, true);
+        }
+        channels = count;
+
+        for (auto& output : this->outputs) {
+            output.setChannels(channels);
+        }
+        return channels;
+    }
+
+    /**
+     * Hand voice c the mapped values that moved this frame
+     */
+    void updateVoiceParams(int c) {
+        sendVoiceParams(c, false);
+    }
+
+    void sendVoiceParams(int c, bool all) {
+        FaustDSP& dsp = voices[c];
+        int group = c >> 2;
+        int lane = c & 3;
+        for (size_t i = 0; i < voiceSlots.size(); i++) {
+            const VoiceSlot& vs = voiceSlots[i];
+            if (all || vs.changed) {
+                dsp.setParamValue(this->paramSlots[i].faustParamIdx, vs.current[group][lane]);
+            }
+        }
+    }
+
+    /**
+     * Per-frame step of the pipeline: evaluate the targets every
+     * controlRateDivider frames, then move each ramping slot one step
+     */
+    void advanceVoiceSlots() {
+        WR_PROFILE_SCOPE(this->profile, "params");
+        if (!this->paramSlotsBuilt) {
+            this->buildParamSlots();
+            voiceSlots.assign(this->paramSlots.size(), VoiceSlot());
+            for (size_t i = 0; i < voiceSlots.size(); i++) {
+                for (int g = 0; g < GROUPS; g++) {
+                    voiceSlots[i].current[g] = float_4(this->paramSlots[i].current);
+                }
+            }
+        }
+
+        if (--this->controlCounter <= 0) {
+            this->controlCounter = this->controlRateDivider;
+            evaluateVoiceTargets();
+        }
+
+        for (auto& vs : voiceSlots) {
+            vs.changed = vs.jumped;
+            vs.jumped = false;
+            if (vs.remaining <= 0) continue;
+            if (--vs.remaining == 0) {
+                for (int g = 0; g < GROUPS; g++) vs.current[g] = vs.target[g];
+            } else {
+                for (int g = 0; g < GROUPS; g++) vs.current[g] += vs.step[g];
+            }
+            vs.changed = true;
+        }
+    }
+
+    /**
+     * Per-channel version of FaustModule::evaluateParamTargets(): the base
+     * comes from the knob or the Faust init value, never from a voice's
+     * current value, so CV cannot accumulate
+     */
+    void evaluateVoiceTargets() {
+        for (size_t i = 0; i < voiceSlots.size(); i++) {
+            const auto& slot = this->paramSlots[i];
+            float base = slot.overridden ? slot.overrideValue
+                : (slot.vcvParamId >= 0) ? this->params[slot.vcvParamId].getValue()
+                : this->faustDsp.getParamInit(slot.faustParamIdx);
+            for (int g = 0; g < GROUPS; g++) voiceSlots[i].pending[g] = float_4(base);
+        }
+
+        for (const auto& cv : this->cvMappings) {
+            const auto& input = this->inputs[cv.vcvInputId];
+            if (!input.isConnected() || this->paramSlots[cv.slot].overridden) continue;
+
+            VoiceSlot& vs = voiceSlots[cv.slot];
+            for (int g = 0; g < GROUPS; g++) {
+                float_4 voltage = input.template getPolyVoltageSimd<float_4>(g * 4);
+                if (cv.exponential) {
+                    vs.pending[g] *= DSP::voltToFreqMultiplier(voltage);
+                } else {
+                    vs.pending[g] += voltage * cv.scale;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < voiceSlots.size(); i++) {
+            const auto& slot = this->paramSlots[i];
+            VoiceSlot& vs = voiceSlots[i];
+            int moved = 0;
+            for (int g = 0; g < GROUPS; g++) {
+                vs.pending[g] = rack::simd::clamp(vs.pending[g], float_4(slot.minVal), float_4(slot.maxVal));
+                moved |= rack::simd::movemask(vs.pending[g] != vs.target[g]);
+            }
+
+            if (!this->paramSlotsPrimed || slot.snap || this->controlRateDivider <= 1) {
+                if (!moved && this->paramSlotsPrimed) continue;
+                for (int g = 0; g < GROUPS; g++) vs.target[g] = vs.current[g] = vs.pending[g];
+                vs.remaining = 0;
+                vs.jumped = true;
+            } else if (moved) {
+                for (int g = 0; g < GROUPS; g++) {
+                    vs.target[g] = vs.pending[g];
+                    vs.step[g] = (vs.target[g] - vs.current[g]) / static_cast<float>(this->controlRateDivider);
+                }
+                vs.remaining = this->controlRateDivider;
+            }
+        }
+        this->paramSlotsPrimed = true;
+    }
+
+    /**
+     * Run one sample frame through voice c
+     *
+     * @param in   getNumInputs() input samples (may be nullptr if the DSP has none)
+     * @param out  getNumOutputs() output samples
+     */
+    void computeVoice(int c, const float* in, float* out) {
+        FaustDSP& dsp = voices[c];
+        int numInputs = std::min(dsp.getNumInputs(), Base::MAX_IO);
+        int numOutputs = std::min(dsp.getNumOutputs(), Base::MAX_IO);
+
+        if (staleVoices & (1u << c)) {
+            dsp.instanceClear();
+            staleVoices &= ~(1u << c);
+        }
+
+        for (int i = 0; i < numInputs; i++) this->inputBuffer[i] = in ? in[i] : 0.0f;
+        this->computeDsp(dsp, 1, this->inputPtrs, this->outputPtrs);
+        for (int i = 0; i < numOutputs; i++) out[i] = this->outputBuffer[i];
+    }
+
+    void initVoices(int sr) {
+        if (sampleRate == 0) {
+            this->faustDsp.init(sr);
+            for (int c = 0; c < MAX_POLY; c++) {
+                voices[c].init(sr);
+            }
+        } else if (sr != sampleRate) {
+            this->faustDsp.setSampleRate(sr, false);
+            for (int c = 0; c < MAX_POLY; c++) {
+                voices[c].setSampleRate(sr, false);
+            }
+            staleVoices = (1u << MAX_POLY) - 1;
+        }
+        sampleRate = sr;
+        this->initialized = true;
+    }
+
+public:
+    void onSampleRateChange(const rack::engine::Module::SampleRateChangeEvent& e) override {
+        initVoices(static_cast<int>(e.sampleRate));
+    }
+
+    /**
+     * Save the voices' parameter values (voice 0 stands for all of them;
+     * faustDsp only holds the Faust init values of unmapped parameters)
+     */
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        this->paramsToJson(rootJ, [this](int i) { return voices[0].getParamValue(i); });
+        this->settingsToJson(rootJ);
+        return rootJ;
+    }
+
+    /**
+     * Load parameter values into faustDsp and every voice
+     */
+    void dataFromJson(json_t* rootJ) override {
+        this->paramsFromJson(rootJ, [this](int i, float value) {
+            this->faustDsp.setParamValue(i, value);
+            for (int c = 0; c < MAX_POLY; c++) {
+                voices[c].setParamValue(i, value);
+            }
+        });
+        this->settingsFromJson(rootJ);
+    }
+
+    /**
+     * Default poly processing: channel c of the audio input -> voice c ->
+     * channel c of the audio output
+     */
+    void process(const rack::engine::Module::ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(this->profile, "process");
+
+        if (!this->initialized) {
+            initVoices(static_cast<int>(args.sampleRate));
+        }
+
+        int numChannels = updateChannels();
+        int numInputs = std::min(this->faustDsp.getNumInputs(), Base::MAX_IO);
+
+        for (int c = 0; c < numChannels; c++) {
+            updateVoiceParams(c);
+
+            float frameIn[Base::MAX_IO] = {};
+            if (this->audioInputId >= 0 && numInputs > 0) {
+                frameIn[0] = Base::vcvToFaust(this->inputs[this->audioInputId].getPolyVoltage(c));
+            }
+
+            float frameOut[Base::MAX_IO] = {};
+            computeVoice(c, frameIn, frameOut);
+
+            if (this->audioOutputId >= 0 && this->faustDsp.getNumOutputs() > 0) {
+                this->outputs[this->audioOutputId].setVoltage(Base::faustToVCV(frameOut[0]), c);
+            }
+        }
+    }
+};
+
+} // namespace WiggleRoom
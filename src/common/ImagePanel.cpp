@@ -0,0 +1,136 @@
+#include "ImagePanel.hpp"
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_STATIC
+#include "stb_image.h"
+
+namespace WiggleRoom {
+
+namespace {
+
+struct CacheEntry {
+    int handle = -1;
+    int refs = 0;
+    unsigned idleSince = 0;   // idleClock when refs last dropped to 0
+};
+
+// Unused textures kept around, so zooming back to a level just left does
+// not decode the file again
+constexpr int KEEP_IDLE = 16;
+unsigned idleClock = 0;
+
+using CacheKey = std::tuple<NVGcontext*, std::string, int>;
+
+std::map<CacheKey, CacheEntry>& entries() {
+    static std::map<CacheKey, CacheEntry> map;
+    return map;
+}
+
+// 2x2 box filter; an odd last row/column is averaged with itself
+void halve(std::vector<unsigned char>& pixels, int& w, int& h) {
+    int nw = std::max(1, (w + 1) / 2);
+    int nh = std::max(1, (h + 1) / 2);
+    std::vector<unsigned char> out((size_t)nw * nh * 4);
+    for (int y = 0; y < nh; y++) {
+        int y0 = std::min(2 * y, h - 1), y1 = std::min(2 * y + 1, h - 1);
+        for (int x = 0; x < nw; x++) {
+            int x0 = std::min(2 * x, w - 1), x1 = std::min(2 * x + 1, w - 1);
+            for (int c = 0; c < 4; c++) {
+                int sum = pixels[((size_t)y0 * w + x0) * 4 + c] + pixels[((size_t)y0 * w + x1) * 4 + c]
+                        + pixels[((size_t)y1 * w + x0) * 4 + c] + pixels[((size_t)y1 * w + x1) * 4 + c];
+                out[((size_t)y * nw + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+    pixels.swap(out);
+    w = nw;
+    h = nh;
+}
+
+int createImage(NVGcontext* vg, const std::string& path, int level) {
+    if (level <= 0) return nvgCreateImage(vg, path.c_str(), 0);
+
+    int w = 0, h = 0, c = 0;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &c, 4);
+    if (!data) return -1;
+    std::vector<unsigned char> pixels(data, data + (size_t)w * h * 4);
+    stbi_image_free(data);
+    for (int l = 0; l < level && (w > 1 || h > 1); l++) {
+        halve(pixels, w, h);
+    }
+    return nvgCreateImageRGBA(vg, w, h, 0, pixels.data());
+}
+
+void deleteEntry(std::map<CacheKey, CacheEntry>::iterator it) {
+    if (it->second.handle > 0) nvgDeleteImage(std::get<0>(it->first), it->second.handle);
+    entries().erase(it);
+}
+
+// Delete the least recently used unused entries beyond KEEP_IDLE
+void trimIdle() {
+    for (;;) {
+        int idle = 0;
+        auto oldest = entries().end();
+        for (auto it = entries().begin(); it != entries().end(); ++it) {
+            if (it->second.refs > 0) continue;
+            idle++;
+            if (oldest == entries().end() || it->second.idleSince < oldest->second.idleSince) oldest = it;
+        }
+        if (idle <= KEEP_IDLE) return;
+        deleteEntry(oldest);
+    }
+}
+
+} // namespace
+
+int ImageCache::acquire(NVGcontext* vg, const std::string& path, int level) {
+    auto inserted = entries().emplace(CacheKey(vg, path, level), CacheEntry());
+    CacheEntry& entry = inserted.first->second;
+    if (inserted.second) entry.handle = createImage(vg, path, level);
+    entry.refs++;
+    return entry.handle;
+}
+
+void ImageCache::release(NVGcontext* vg, const std::string& path, int level) {
+    auto it = entries().find(CacheKey(vg, path, level));
+    if (it == entries().end()) return;
+    if (--it->second.refs > 0) return;
+    it->second.idleSince = ++idleClock;
+    trimIdle();
+}
+
+void ImageCache::releaseIdle(NVGcontext* vg) {
+    for (auto it = entries().begin(); it != entries().end();) {
+        auto next = std::next(it);
+        if (std::get<0>(it->first) == vg && it->second.refs == 0) deleteEntry(it);
+        it = next;
+    }
+}
+
+bool ImageCache::sourceSize(const std::string& path, int& w, int& h) {
+    static std::map<std::string, std::pair<int, int>> sizes;
+    auto it = sizes.find(path);
+    if (it == sizes.end()) {
+        int c = 0;
+        w = h = 0;
+        if (!stbi_info(path.c_str(), &w, &h, &c)) w = h = 0;
+        it = sizes.emplace(path, std::make_pair(w, h)).first;
+    }
+    w = it->second.first;
+    h = it->second.second;
+    return w > 0 && h > 0;
+}
+
+int ImageCache::levelFor(const std::string& path, float screenWidth) {
+    int w = 0, h = 0;
+    if (!sourceSize(path, w, h) || screenWidth <= 0.f) return 0;
+    int level = 0;
+    while (level < MAX_LEVEL && (w >> (level + 1)) >= screenWidth) level++;
+    return level;
+}
+
+} // namespace WiggleRoom
@@ -1,15 +1,48 @@
 #pragma once
 #include "rack.hpp"
+#include <cmath>
+#include <string>
 
 namespace WiggleRoom {
 
+/**
+ * ImageCache - faceplate textures shared by every panel in the process
+ *
+ * Keyed by NanoVG context, path and downscale level, so ten copies of a
+ * module share one texture instead of decoding and uploading the PNG ten
+ * times. Level 0 is the file at full resolution; each further level halves
+ * it (box filtered), so a zoomed-out rack does not hold full-size panels on
+ * the GPU. Handles are reference counted; the last few that fall out of
+ * use are kept so a zoom back to a recent level costs no decode, and the
+ * older ones are deleted. UI thread only.
+ */
+struct ImageCache {
+    // Handle for (vg, path, level), creating it on first use; <= 0 on failure
+    static int acquire(NVGcontext* vg, const std::string& path, int level);
+    static void release(NVGcontext* vg, const std::string& path, int level);
+
+    // Delete the unused textures kept for vg (before the context goes away)
+    static void releaseIdle(NVGcontext* vg);
+
+    // Source image size from the file header (cached); false if unreadable
+    static bool sourceSize(const std::string& path, int& w, int& h);
+
+    // Coarsest level still at least `screenWidth` pixels wide
+    static int levelFor(const std::string& path, float screenWidth);
+
+    static constexpr int MAX_LEVEL = 4;
+};
+
 /**
  * ImagePanel - Renders a PNG/JPG image as a module background
  */
 struct ImagePanel : rack::widget::OpaqueWidget {
     std::string imagePath;
     int imgHandle = -1;
-    bool imageLoaded = false;
+
+    // The cache entry imgHandle came from
+    NVGcontext* handleVg = nullptr;
+    int handleLevel = -1;
 
     ImagePanel(const std::string& path, rack::math::Vec size) {
         imagePath = path;
@@ -17,11 +50,52 @@ struct ImagePanel : rack::widget::OpaqueWidget {
         box.size = size;
     }
 
+    ~ImagePanel() override {
+        releaseImage();
+    }
+
+    void releaseImage() {
+        if (handleVg) ImageCache::release(handleVg, imagePath, handleLevel);
+        forgetImage();
+    }
+
+    // Drop the handle without touching a (possibly dead) context
+    void forgetImage() {
+        imgHandle = -1;
+        handleVg = nullptr;
+        handleLevel = -1;
+    }
+
+    void onContextCreate(const ContextCreateEvent& e) override {
+        forgetImage();
+        OpaqueWidget::onContextCreate(e);
+    }
+
+    void onContextDestroy(const ContextDestroyEvent& e) override {
+        if (handleVg == e.vg) releaseImage();
+        else forgetImage();
+        ImageCache::releaseIdle(e.vg);
+        OpaqueWidget::onContextDestroy(e);
+    }
+
     void draw(const DrawArgs& args) override {
-        // Load image once
-        if (!imageLoaded) {
-            imgHandle = nvgCreateImage(args.vg, imagePath.c_str(), 0);
-            imageLoaded = true;
+        // Pick the texture level from the panel's size on screen (rack zoom
+        // and pixel ratio are both in the current transform)
+        float xform[6] = {1.f, 0.f, 0.f, 1.f, 0.f, 0.f};
+        nvgCurrentTransform(args.vg, xform);
+        float scale = std::sqrt(xform[0] * xform[0] + xform[1] * xform[1]);
+        int level = ImageCache::levelFor(imagePath, box.size.x * scale);
+
+        if (handleVg != args.vg || level != handleLevel) {
+            // A context that changed without a destroy event is gone: forget
+            // its handle rather than delete it against the wrong context
+            if (handleVg != args.vg) forgetImage();
+            // Acquire before releasing so a shared entry is not recreated
+            int handle = ImageCache::acquire(args.vg, imagePath, level);
+            releaseImage();
+            imgHandle = handle;
+            handleVg = args.vg;
+            handleLevel = level;
         }
 
         // Draw dark background first to cover VCV's default white
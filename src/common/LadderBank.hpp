@@ -0,0 +1,128 @@
+#pragma once
+
+#include "rack.hpp"
+#include "DSP.hpp"
+#include "SimdBank.hpp"
+#include <algorithm>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Polyphonic 4-pole ladder lowpass, four voices per float_4
+ *
+ * Each voice is Faust's ve.moog_vcf_2bn (two analog 2-pole sections,
+ * bilinear transform with prewarping), so a voice has the response of
+ * ladder_lpf.dsp. That filter is linear: there is no tanh stage in the
+ * feedback path to vectorize. Every section is
+ * tf2s(0, 0, 1, a1, a0, w1) and keeps b1 = 2 * b0, b2 = b0, so it costs
+ * four multiplies in transposed direct form II:
+ *
+ *   bx = b0 * x
+ *   y  = bx + s1
+ *   s1 = 2 * bx - a1 * y + s2
+ *   s2 = bx - a2 * y
+ *
+ * setControls() runs at control rate. It smooths cutoff and resonance
+ * (SmooStep, see SimdBank.hpp), then retunes the group with the fast
+ * kernels: tan() as fastSin / fastCos, so sixteen voices cost four vector
+ * evaluations instead of sixteen libm calls. Coefficients hold between
+ * calls.
+ *
+ *   LadderBank ladder;
+ *   ladder.setSampleRate(48000.f);
+ *   ladder.setChannelCount(channels);
+ *   ladder.setControls(g, cutoffHz, resonance, 16);   // every 16 samples
+ *   out = ladder.process(g, in);                      // every sample
+ ******************************************************************************/
+
+class LadderBank : public SimdBank<LadderBank, 16> {
+public:
+    using float_4 = rack::simd::float_4;
+
+    void setSampleRate(float rate) {
+        sampleRate = rate;
+    }
+
+    /**
+     * Smooth and retune one group of four voices
+     *
+     * @param cutoff     Hz (clamped to 20..10000 like moog_vcf_2bn)
+     * @param resonance  0..1, 1 = self-oscillation
+     * @param samples    samples since the last call, for the smoothing step
+     */
+    void setControls(int g, float_4 cutoff, float_4 resonance, int samples) {
+        using namespace DSP::FastMathDetail;
+        if (!primed[g]) {
+            smoothCutoff[g] = cutoff;
+            smoothResonance[g] = resonance;
+            primed[g] = true;
+        } else {
+            float coeff = smoo.coefficient(samples);
+            smoothCutoff[g] += (cutoff - smoothCutoff[g]) * coeff;
+            smoothResonance[g] += (resonance - smoothResonance[g]) * coeff;
+        }
+
+        // k is the fourth root of the loop gain; 0.99999 keeps a stability margin
+        constexpr float SQRT2 = 1.41421356f;
+        float_4 fc = vmin(vmax(smoothCutoff[g], float_4(20.f)), float_4(10000.f));
+        float_4 k = vmin(float_4(SQRT2 * 0.99999f), SQRT2 * vmax(smoothResonance[g], float_4(0.f)));
+        float_4 s2k = SQRT2 * k;
+        float_4 ksq = k * k;
+
+        // c = 1 / tan(w1 / 2SR), kept clear of Nyquist at low engine rates
+        float_4 x = vmin(float_4(DSP::PI) * fc / sampleRate, float_4(1.5f));
+        float_4 c = DSP::fastCos(x) / DSP::fastSin(x);
+        float_4 csq = c * c;
+
+        sections[0][g].tune(2.f + s2k, 1.f + s2k + ksq, c, csq);
+        sections[1][g].tune(2.f - s2k, 1.f - s2k + ksq, c, csq);
+    }
+
+    float_4 process(int g, float_4 in) {
+        return sections[1][g].process(sections[0][g].process(in));
+    }
+
+private:
+    friend SimdBank;
+
+    struct Section {
+        float_4 b0 = 0.f;
+        float_4 a1 = 0.f;
+        float_4 a2 = 0.f;
+        float_4 s1 = 0.f;
+        float_4 s2 = 0.f;
+
+        // Bilinear transform of 1 / (s^2 + a1s * s + a0s)
+        void tune(float_4 a1s, float_4 a0s, float_4 c, float_4 csq) {
+            float_4 invD = 1.f / (a0s + a1s * c + csq);
+            b0 = invD;
+            a1 = 2.f * (a0s - csq) * invD;
+            a2 = (a0s - a1s * c + csq) * invD;
+        }
+
+        float_4 process(float_4 x) {
+            float_4 bx = b0 * x;
+            float_4 y = bx + s1;
+            s1 = 2.f * bx - a1 * y + s2;
+            s2 = bx - a2 * y;
+            return y;
+        }
+    };
+
+    void resetGroup(int g) {
+        for (auto& section : sections) {
+            section[g].s1 = 0.f;
+            section[g].s2 = 0.f;
+        }
+        primed[g] = false;
+    }
+
+    Section sections[2][MAX_GROUPS];
+    float_4 smoothCutoff[MAX_GROUPS] = {};
+    float_4 smoothResonance[MAX_GROUPS] = {};
+    bool primed[MAX_GROUPS] = {};
+
+    float sampleRate = 48000.f;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "rack.hpp"
+#include "DSP.hpp"
+#include "SimdBank.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Morphing state-variable filters with equal-power pan, four per float_4
+ *
+ * Each channel is Faust's fi.svf (the trapezoidal SVF) with SpectraHenge's
+ * LP -> BP -> HP morph and cos/sin pan law. fi.svf.lp/bp/hp run three
+ * filters with identical state, so one filter per channel gives all three
+ * responses from v1 (band-pass) and v2 (low-pass):
+ *
+ *   v1 = (ic1 + g * (x - ic2)) / (1 + g * (g + k))
+ *   v2 = ic2 + g * v1
+ *   ic1 = 2 * v1 - ic1,  ic2 = 2 * v2 - ic2
+ *   y  = m0 * x + m1 * v1 + m2 * v2       (hp = x - k * v1 - v2)
+ *   left += y * cos(pan * pi/2),  right += y * sin(pan * pi/2)
+ *
+ * setControls() runs at control rate. It smooths tilt, pan and q
+ * (SmooStep, see SimdBank.hpp), computes the targets with the fast kernels, and ramps g, k, the morph weights and the pan gains to them
+ * linearly over the next `samples` samples, so the per-sample loop has no
+ * transcendental calls and no zipper noise.
+ *
+ *   MorphSvfBank bank;
+ *   bank.setSampleRate(48000.f);
+ *   bank.setChannelCount(8);
+ *   bank.setControls(g, tilt, pan, q, 16);       // every 16 samples
+ *   bank.process(g, in, left, right);            // every sample
+ ******************************************************************************/
+
+class MorphSvfBank : public SimdBank<MorphSvfBank, 8> {
+public:
+    using float_4 = rack::simd::float_4;
+
+    void setSampleRate(float rate) {
+        sampleRate = rate;
+    }
+
+    /**
+     * Smooth the controls of one group and start ramping towards them
+     *
+     * @param tilt     0..1 filter morph (0 = LP, 0.5 = BP, 1 = HP)
+     * @param pan      0..1 stereo position (0 = L, 1 = R)
+     * @param q        SVF resonance, shared by the group
+     * @param samples  samples until the next call (ramp length and smoothing step)
+     */
+    void setControls(int g, float_4 tilt, float_4 pan, float q, int samples) {
+        using namespace DSP::FastMathDetail;
+        Group& grp = groups[g];
+        if (!grp.primed) {
+            grp.tilt = tilt;
+            grp.pan = pan;
+            grp.q = q;
+        } else {
+            float coeff = smoo.coefficient(samples);
+            grp.tilt += (tilt - grp.tilt) * coeff;
+            grp.pan += (pan - grp.pan) * coeff;
+            grp.q += (float_4(q) - grp.q) * coeff;
+        }
+
+        // 80 Hz at tilt 0 to 16 kHz at tilt 1, kept clear of Nyquist
+        float_4 freq = 80.f * DSP::fastExp2(grp.tilt * 7.6439f);
+        float_4 w = vmin(float_4(DSP::PI) * freq / sampleRate, float_4(1.5f));
+        float_4 gain = DSP::fastSin(w) / DSP::fastCos(w);
+        float_4 k = 1.f / grp.q;
+
+        // LP -> BP over tilt 0..0.5, BP -> HP over 0.5..1
+        float_4 upper = grp.tilt >= 0.5f;
+        float_4 lpBp = grp.tilt * 2.f;
+        float_4 bpHp = (grp.tilt - 0.5f) * 2.f;
+        float_4 wLp = rack::simd::ifelse(upper, 0.f, 1.f - lpBp);
+        float_4 wBp = rack::simd::ifelse(upper, 1.f - bpHp, lpBp);
+        float_4 wHp = rack::simd::ifelse(upper, bpHp, 0.f);
+
+        float_4 angle = grp.pan * (DSP::PI * 0.5f);
+
+        Coefficients target;
+        target.g = gain;
+        target.k = k;
+        target.m0 = wHp;
+        target.m1 = wBp - wHp * k;
+        target.m2 = wLp - wHp;
+        target.left = DSP::fastCos(angle);
+        target.right = DSP::fastSin(angle);
+
+        if (!grp.primed || samples <= 1) {
+            grp.coeffs = target;
+            grp.step = Coefficients();
+            grp.primed = true;
+        } else {
+            float inv = 1.f / static_cast<float>(samples);
+            grp.step.g = (target.g - grp.coeffs.g) * inv;
+            grp.step.k = (target.k - grp.coeffs.k) * inv;
+            grp.step.m0 = (target.m0 - grp.coeffs.m0) * inv;
+            grp.step.m1 = (target.m1 - grp.coeffs.m1) * inv;
+            grp.step.m2 = (target.m2 - grp.coeffs.m2) * inv;
+            grp.step.left = (target.left - grp.coeffs.left) * inv;
+            grp.step.right = (target.right - grp.coeffs.right) * inv;
+        }
+    }
+
+    /**
+     * Filter and pan four channels, adding them to the left and right lanes
+     */
+    void process(int g, float_4 in, float_4& left, float_4& right) {
+        Group& grp = groups[g];
+        Coefficients& c = grp.coeffs;
+        c.g += grp.step.g;
+        c.k += grp.step.k;
+        c.m0 += grp.step.m0;
+        c.m1 += grp.step.m1;
+        c.m2 += grp.step.m2;
+        c.left += grp.step.left;
+        c.right += grp.step.right;
+
+        float_4 v1 = (grp.ic1 + c.g * (in - grp.ic2)) / (1.f + c.g * (c.g + c.k));
+        float_4 v2 = grp.ic2 + c.g * v1;
+        grp.ic1 = 2.f * v1 - grp.ic1;
+        grp.ic2 = 2.f * v2 - grp.ic2;
+
+        float_4 y = c.m0 * in + c.m1 * v1 + c.m2 * v2;
+        left += y * c.left;
+        right += y * c.right;
+    }
+
+private:
+    friend SimdBank;
+
+    struct Coefficients {
+        float_4 g = 0.f;
+        float_4 k = 0.f;
+        float_4 m0 = 0.f;
+        float_4 m1 = 0.f;
+        float_4 m2 = 0.f;
+        float_4 left = 0.f;
+        float_4 right = 0.f;
+    };
+
+    struct Group {
+        Coefficients coeffs;
+        Coefficients step;
+        float_4 ic1 = 0.f;
+        float_4 ic2 = 0.f;
+        float_4 tilt = 0.f;
+        float_4 pan = 0.f;
+        float_4 q = 1.f;
+        bool primed = false;
+    };
+
+    void resetGroup(int g) {
+        groups[g] = Group();
+    }
+
+    Group groups[MAX_GROUPS];
+
+    float sampleRate = 48000.f;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "DSP.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Band-limited mipmapped wavetables for ACID9Voice's saw/shark/square morph
+ *
+ * Each frame is morph_osc.lib's waveform at one Shape position (saw ->
+ * sharktooth -> square with the same fold curve and equal-power gains,
+ * 50% pulse width), drawn naively at RENDER_LENGTH points, transformed,
+ * and resynthesized once per octave with only the harmonics that fit:
+ *
+ *   level l keeps harmonics 1..(MAX_HARMONICS >> l), so it is alias-free
+ *   while freq * (MAX_HARMONICS >> l) <= SR / 2
+ *
+ * levelFor() picks the brightest level that stays below Nyquist. read()
+ * interpolates linearly along the phase and between the two nearest Shape
+ * frames: four table reads per sample instead of three analytic
+ * oscillators, a fold and two cos/sin gains.
+ *
+ * The tables (about 1.2 MB) are shared by every instance and rendered on
+ * the first call to shared(), which must happen off the audio thread (the
+ * UI thread, when a module first selects its wavetable engine).
+ *
+ *   const MorphWavetable& table = MorphWavetable::shared();
+ *   float increment = freq / sampleRate;
+ *   float y = table.read(shape * (MorphWavetable::FRAMES - 1),
+ *                        MorphWavetable::levelFor(increment), phase);
+ ******************************************************************************/
+
+class MorphWavetable {
+public:
+    static constexpr int FRAMES = 33;            // Shape 0..1 in steps of 1/32
+    static constexpr int LEVELS = 11;            // 1024 harmonics down to 1
+    static constexpr int MAX_HARMONICS = 1024;   // 20 Hz at 44.1 kHz stays full band
+    static constexpr int MIN_LENGTH = 256;
+    static constexpr int RENDER_LENGTH = 16384;  // Naive frame, aliasing below -75 dB
+
+    static const MorphWavetable& shared() {
+        static const MorphWavetable tables;
+        return tables;
+    }
+
+    /**
+     * Brightest level without harmonics above Nyquist
+     *
+     * @param increment  phase increment per sample (freq / SR)
+     */
+    static int levelFor(float increment) {
+        float top = increment * MAX_HARMONICS;
+        int level = 0;
+        while (top > 0.5f && level < LEVELS - 1) {
+            top *= 0.5f;
+            level++;
+        }
+        return level;
+    }
+
+    /**
+     * @param position  frame position 0..FRAMES-1 (Shape * 32)
+     * @param level     mip level from levelFor()
+     * @param phase     0..1
+     */
+    float read(float position, int level, float phase) const {
+        position = std::min(std::max(position, 0.f), static_cast<float>(FRAMES - 1));
+        int frame = std::min(static_cast<int>(position), FRAMES - 2);
+        float blend = position - frame;
+
+        float x = phase * lengths[level];
+        int i = std::min(static_cast<int>(x), lengths[level] - 1);
+        float frac = x - i;
+
+        const float* a = &data[frame * stride + offsets[level] + i];
+        const float* b = a + stride;
+        float va = a[0] + (a[1] - a[0]) * frac;
+        float vb = b[0] + (b[1] - b[0]) * frac;
+        return va + (vb - va) * blend;
+    }
+
+    /**
+     * 50% square (the last frame), for the sub oscillator
+     */
+    float readSquare(int level, float phase) const {
+        float x = phase * lengths[level];
+        int i = std::min(static_cast<int>(x), lengths[level] - 1);
+        float frac = x - i;
+        const float* a = &data[(FRAMES - 1) * stride + offsets[level] + i];
+        return a[0] + (a[1] - a[0]) * frac;
+    }
+
+private:
+    using Complex = std::complex<double>;
+
+    MorphWavetable() {
+        // Four points per period of the top harmonic keeps the linear
+        // interpolation error low; each level ends with a wrap-around guard
+        stride = 0;
+        for (int l = 0; l < LEVELS; l++) {
+            lengths[l] = std::max(4 * (MAX_HARMONICS >> l), MIN_LENGTH);
+            offsets[l] = stride;
+            stride += lengths[l] + 1;
+        }
+        data.assign(static_cast<size_t>(FRAMES) * stride, 0.f);
+
+        std::vector<Complex> spectrum(RENDER_LENGTH);
+        std::vector<Complex> level(lengths[0]);
+        for (int f = 0; f < FRAMES; f++) {
+            double shape = static_cast<double>(f) / (FRAMES - 1);
+            for (int n = 0; n < RENDER_LENGTH; n++) {
+                spectrum[n] = morph(shape, static_cast<double>(n) / RENDER_LENGTH);
+            }
+            fft(spectrum.data(), RENDER_LENGTH, false);
+
+            for (int l = 0; l < LEVELS; l++) {
+                int length = lengths[l];
+                int harmonics = MAX_HARMONICS >> l;
+                std::fill(level.begin(), level.begin() + length, Complex(0.0));
+                level[0] = spectrum[0];
+                for (int k = 1; k <= harmonics; k++) {
+                    level[k] = spectrum[k];
+                    level[length - k] = std::conj(spectrum[k]);
+                }
+                fft(level.data(), length, true);
+
+                float* table = &data[f * stride + offsets[l]];
+                for (int n = 0; n < length; n++) {
+                    table[n] = static_cast<float>(level[n].real() / RENDER_LENGTH);
+                }
+                table[length] = table[0];
+            }
+        }
+    }
+
+    // morph_osc(freq, shape, 0.5) at one phase, without band-limiting
+    static double morph(double shape, double phase) {
+        double sawToShark = std::min(1.0, shape * 2.0);
+        double sharkToSq = std::max(0.0, (shape - 0.5) * 2.0);
+
+        double saw = 2.0 * phase - 1.0;
+        double thresh = 0.3 + sawToShark * 0.4;
+        double gain = 1.0 + sawToShark * 2.0;
+        double shark = saw > thresh ? thresh - (saw - thresh) * gain : saw;
+        double sq = phase < 0.5 ? -1.0 : 1.0;   // os.pulsetrain is low for the first `duty`
+
+        double quarter = M_PI * 0.5;
+        if (shape > 0.5) {
+            return shark * std::cos(sharkToSq * quarter) + sq * std::sin(sharkToSq * quarter);
+        }
+        return saw * std::cos(sawToShark * quarter) + shark * std::sin(sawToShark * quarter);
+    }
+
+    // In-place radix-2 FFT (n a power of two); the inverse is unscaled
+    static void fft(Complex* x, int n, bool inverse) {
+        for (int i = 1, j = 0; i < n; i++) {
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) std::swap(x[i], x[j]);
+        }
+        for (int len = 2; len <= n; len <<= 1) {
+            Complex step = std::polar(1.0, (inverse ? 2.0 : -2.0) * M_PI / len);
+            for (int i = 0; i < n; i += len) {
+                Complex w = 1.0;
+                for (int k = 0; k < len / 2; k++) {
+                    Complex u = x[i + k];
+                    Complex v = x[i + k + len / 2] * w;
+                    x[i + k] = u + v;
+                    x[i + k + len / 2] = u - v;
+                    w *= step;
+                }
+            }
+        }
+    }
+
+    std::vector<float> data;
+    int lengths[LEVELS] = {};
+    int offsets[LEVELS] = {};
+    int stride = 0;
+};
+
+/******************************************************************************
+ * tri_core_osc.lib on MorphWavetable
+ *
+ * Center, detuned left/right and sub oscillators with the Isotope curve of
+ * tri_core_osc.lib (si.smoo on Isotope, +/-30 cents, side gain iso^2, center
+ * gain 1 - 0.3 * iso^2, pan spread iso). The side oscillators are skipped
+ * while their gain is zero and the sub while its level is zero; their
+ * phases keep running.
+ *
+ * The tables are attached with setTable() rather than in the constructor,
+ * so a module only renders them once the engine is used.
+ *
+ *   TriCoreWavetable osc;
+ *   osc.setTable(MorphWavetable::shared());   // Off the audio thread
+ *   osc.setSampleRate(48000.f);
+ *   osc.process(freq, shape, isotope, subLevel, subSquare, left, right);
+ ******************************************************************************/
+
+class TriCoreWavetable {
+public:
+    void setTable(const MorphWavetable& tables) {
+        table = &tables;
+    }
+
+    bool hasTable() const {
+        return table != nullptr;
+    }
+
+    void setSampleRate(float rate) {
+        sampleRate = rate;
+    }
+
+    void reset() {
+        for (float& p : phases) p = 0.f;
+        subPhase = 0.f;
+        iso = 0.f;
+    }
+
+    /**
+     * @param freq       Hz, already clamped to 20..20000
+     * @param shape      0..1 (saw, sharktooth at 0.5, square)
+     * @param isotope    0..1 detune and spread
+     * @param subLevel   0..1
+     * @param subSquare  square sub instead of sine
+     */
+    void process(float freq, float shape, float isotope, float subLevel, bool subSquare,
+                 float& left, float& right) {
+        iso += (isotope - iso) * 0.001f;                 // si.smoo
+        float position = shape * (MorphWavetable::FRAMES - 1);
+        float increment = freq / sampleRate;
+
+        float center = voice(0, position, increment);
+        float sideAmp = iso * iso;
+        float centerOut = center * (1.f - sideAmp * 0.3f) * 0.5f;
+        left = centerOut;
+        right = centerOut;
+
+        float ratio = DSP::fastExp2(iso * (30.f / 1200.f));
+        if (sideAmp > 0.f) {
+            float oscLeft = voice(1, position, increment / ratio);
+            float oscRight = voice(2, position, increment * ratio);
+            float nearGain = sideAmp * (0.5f + iso * 0.5f);
+            float farGain = sideAmp * (0.5f - iso * 0.5f);
+            left += oscLeft * nearGain + oscRight * farGain;
+            right += oscRight * nearGain + oscLeft * farGain;
+        } else {
+            advance(1, increment / ratio);
+            advance(2, increment * ratio);
+        }
+
+        float subIncrement = increment * 0.5f;
+        if (subLevel > 0.f) {
+            float sub = subSquare
+                ? table->readSquare(MorphWavetable::levelFor(subIncrement), subPhase)
+                : DSP::fastSin2pi(subPhase);
+            left += sub * subLevel * 0.5f;
+            right += sub * subLevel * 0.5f;
+        }
+        subPhase += subIncrement;
+        subPhase -= std::floor(subPhase);
+    }
+
+private:
+    float voice(int v, float position, float increment) {
+        float y = table->read(position, MorphWavetable::levelFor(increment), phases[v]);
+        advance(v, increment);
+        return y;
+    }
+
+    void advance(int v, float increment) {
+        phases[v] += increment;
+        phases[v] -= std::floor(phases[v]);
+    }
+
+    const MorphWavetable* table = nullptr;
+    float phases[3] = {};
+    float subPhase = 0.f;
+    float iso = 0.f;
+    float sampleRate = 48000.f;
+};
+
+} // namespace WiggleRoom
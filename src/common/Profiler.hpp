@@ -0,0 +1,407 @@
+#pragma once
+
+#include "rack.hpp"
+
+#ifdef WR_PROFILE
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define WR_PROFILE_TSC 1
+#elif defined(__aarch64__)
+#define WR_PROFILE_CNTVCT 1
+#endif
+#endif
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Hot-path profiler (diagnostic builds only)
+ *
+ * Define WR_PROFILE (cmake -DWIGGLEROOM_PROFILE=ON) to time named sections
+ * of each module's audio path. Without it every macro below compiles to
+ * nothing.
+ *
+ *   WR_PROFILE_SCOPE(profile, "process");   // times the rest of the scope
+ *   WR_PROFILE_MENU(menu, module);           // in appendContextMenu()
+ *
+ * A scope reads the cycle counter on entry and exit: RDTSC on x86,
+ * CNTVCT_EL0 on AArch64 (a fixed-frequency timer, not core cycles),
+ * steady_clock nanoseconds elsewhere. FaustModule times "process",
+ * "params" (updateFaustParams()) and "compute" (every compute() call) on
+ * its own; hand-written modules hold a ModuleProfile and add scopes around
+ * their own hot sections. Scopes nest, so "process" includes the rest.
+ *
+ * Each section keeps a call count, total and maximum, and a log2
+ * histogram (bucket b counts calls of 2^b to 2^(b+1) ticks). Only the
+ * module's engine thread writes them, so recording is plain relaxed
+ * atomic loads and stores with no locks or read-modify-writes; the UI
+ * reads them while the engine runs. Reset is a flag the engine thread
+ * picks up on its next record.
+ *
+ * Section names are registered plugin-wide the first time each scope runs
+ * (one locked lookup per call site, then a static index). The context
+ * menu shows the module's sections and can copy or save every live
+ * profile as JSON (WiggleRoom-profile.json in the Rack user folder).
+ ******************************************************************************/
+
+#ifdef WR_PROFILE
+
+namespace ProfileDetail {
+
+constexpr int MAX_SECTIONS = 16;
+constexpr int BUCKETS = 40;
+
+inline uint64_t readCounter() {
+#if defined(WR_PROFILE_TSC)
+    return __rdtsc();
+#elif defined(WR_PROFILE_CNTVCT)
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline const char* counterName() {
+#if defined(WR_PROFILE_TSC)
+    return "tsc";
+#elif defined(WR_PROFILE_CNTVCT)
+    return "cntvct";
+#else
+    return "ns";
+#endif
+}
+
+// Ticks per second, or 0 where the counter rate isn't known (TSC)
+inline double counterFrequency() {
+#if defined(WR_PROFILE_TSC)
+    return 0.0;
+#elif defined(WR_PROFILE_CNTVCT)
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(value));
+    return static_cast<double>(value);
+#else
+    return 1e9;
+#endif
+}
+
+// Plugin-wide section names; the last slot collects anything past the limit
+struct SectionNames {
+    std::mutex mutex;
+    const char* names[MAX_SECTIONS] = {};
+    int count = 0;
+};
+
+inline SectionNames& sectionNames() {
+    static SectionNames names;
+    return names;
+}
+
+inline int sectionId(const char* name) {
+    SectionNames& s = sectionNames();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (int i = 0; i < s.count; i++) {
+        if (std::strcmp(s.names[i], name) == 0) return i;
+    }
+    if (s.count == MAX_SECTIONS - 1) {
+        s.names[s.count++] = "other";
+    }
+    if (s.count == MAX_SECTIONS) return MAX_SECTIONS - 1;
+    s.names[s.count] = name;
+    return s.count++;
+}
+
+inline const char* sectionName(int id) {
+    SectionNames& s = sectionNames();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return id < s.count ? s.names[id] : nullptr;
+}
+
+inline void add(std::atomic<uint64_t>& a, uint64_t v) {
+    a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+} // namespace ProfileDetail
+
+/**
+ * Timings of one section in one module
+ */
+struct ProfileSection {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> maxTicks{0};
+    std::atomic<uint32_t> histogram[ProfileDetail::BUCKETS] = {};
+
+    // Engine thread of the owning module only
+    void record(uint64_t t) {
+        int bucket = 0;
+        while (bucket < ProfileDetail::BUCKETS - 1 && (t >> (bucket + 1)) != 0) bucket++;
+        ProfileDetail::add(calls, 1);
+        ProfileDetail::add(ticks, t);
+        if (t > maxTicks.load(std::memory_order_relaxed)) {
+            maxTicks.store(t, std::memory_order_relaxed);
+        }
+        histogram[bucket].store(histogram[bucket].load(std::memory_order_relaxed) + 1,
+                                std::memory_order_relaxed);
+    }
+
+    void clear() {
+        calls.store(0, std::memory_order_relaxed);
+        ticks.store(0, std::memory_order_relaxed);
+        maxTicks.store(0, std::memory_order_relaxed);
+        for (auto& h : histogram) h.store(0, std::memory_order_relaxed);
+    }
+
+    // Upper edge of the histogram bucket holding quantile q (0..1)
+    uint64_t quantile(double q) const {
+        uint64_t total = 0;
+        uint32_t counts[ProfileDetail::BUCKETS];
+        for (int b = 0; b < ProfileDetail::BUCKETS; b++) {
+            counts[b] = histogram[b].load(std::memory_order_relaxed);
+            total += counts[b];
+        }
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(q * (total - 1)) + 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < ProfileDetail::BUCKETS; b++) {
+            seen += counts[b];
+            if (seen >= target) return uint64_t(2) << b;
+        }
+        return uint64_t(2) << (ProfileDetail::BUCKETS - 1);
+    }
+};
+
+class ModuleProfile;
+
+namespace ProfileDetail {
+
+// Live profiles, for the all-modules report (modules come and go on the UI thread)
+struct Registry {
+    std::mutex mutex;
+    std::vector<ModuleProfile*> profiles;
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+} // namespace ProfileDetail
+
+/**
+ * Per-module section timings
+ *
+ * Declare one in the module (FaustModule already has one) and pass it to
+ * WR_PROFILE_SCOPE.
+ */
+class ModuleProfile {
+public:
+    explicit ModuleProfile(rack::engine::Module* owner) : owner(owner) {
+        auto& r = ProfileDetail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.profiles.push_back(this);
+    }
+
+    ~ModuleProfile() {
+        auto& r = ProfileDetail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.profiles.erase(std::remove(r.profiles.begin(), r.profiles.end(), this), r.profiles.end());
+    }
+
+    ModuleProfile(const ModuleProfile&) = delete;
+    ModuleProfile& operator=(const ModuleProfile&) = delete;
+
+    void record(int section, uint64_t ticks) {
+        if (resetRequested.load(std::memory_order_relaxed)) {
+            resetRequested.store(false, std::memory_order_relaxed);
+            for (auto& s : sections) s.clear();
+        }
+        sections[section].record(ticks);
+    }
+
+    // Any thread; applied by the engine thread on its next record
+    void requestReset() {
+        resetRequested.store(true, std::memory_order_relaxed);
+    }
+
+    const ProfileSection& section(int id) const {
+        return sections[id];
+    }
+
+    std::string name() const {
+        std::string slug = owner && owner->model ? owner->model->slug : "module";
+        return owner ? slug + " #" + std::to_string(owner->id) : slug;
+    }
+
+    // One line per section with calls, for the context menu
+    std::vector<std::string> summaryLines() const {
+        std::vector<std::string> lines;
+        for (int id = 0; id < ProfileDetail::MAX_SECTIONS; id++) {
+            const ProfileSection& s = sections[id];
+            uint64_t calls = s.calls.load(std::memory_order_relaxed);
+            const char* sectionName = ProfileDetail::sectionName(id);
+            if (calls == 0 || !sectionName) continue;
+            double mean = static_cast<double>(s.ticks.load(std::memory_order_relaxed)) / calls;
+            char buf[160];
+            std::snprintf(buf, sizeof(buf), "%s: %.0f mean, p99 < %llu, max %llu",
+                          sectionName, mean,
+                          static_cast<unsigned long long>(s.quantile(0.99)),
+                          static_cast<unsigned long long>(s.maxTicks.load(std::memory_order_relaxed)));
+            lines.push_back(buf);
+        }
+        if (lines.empty()) lines.push_back("No samples yet");
+        return lines;
+    }
+
+    json_t* toJson() const {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "slug", json_string(owner && owner->model ? owner->model->slug.c_str() : ""));
+        json_object_set_new(rootJ, "id", json_integer(owner ? owner->id : -1));
+        json_t* sectionsJ = json_object();
+        for (int id = 0; id < ProfileDetail::MAX_SECTIONS; id++) {
+            const ProfileSection& s = sections[id];
+            uint64_t calls = s.calls.load(std::memory_order_relaxed);
+            const char* sectionName = ProfileDetail::sectionName(id);
+            if (calls == 0 || !sectionName) continue;
+
+            json_t* sectionJ = json_object();
+            uint64_t ticks = s.ticks.load(std::memory_order_relaxed);
+            json_object_set_new(sectionJ, "calls", json_integer(static_cast<long long>(calls)));
+            json_object_set_new(sectionJ, "ticks", json_integer(static_cast<long long>(ticks)));
+            json_object_set_new(sectionJ, "mean", json_real(static_cast<double>(ticks) / calls));
+            json_object_set_new(sectionJ, "max", json_integer(static_cast<long long>(
+                s.maxTicks.load(std::memory_order_relaxed))));
+            json_object_set_new(sectionJ, "p50", json_integer(static_cast<long long>(s.quantile(0.5))));
+            json_object_set_new(sectionJ, "p99", json_integer(static_cast<long long>(s.quantile(0.99))));
+            json_t* histogramJ = json_array();
+            for (const auto& h : s.histogram) {
+                json_array_append_new(histogramJ, json_integer(h.load(std::memory_order_relaxed)));
+            }
+            json_object_set_new(sectionJ, "histogram", histogramJ);
+            json_object_set_new(sectionsJ, sectionName, sectionJ);
+        }
+        json_object_set_new(rootJ, "sections", sectionsJ);
+        return rootJ;
+    }
+
+private:
+    rack::engine::Module* owner;
+    ProfileSection sections[ProfileDetail::MAX_SECTIONS];
+    std::atomic<bool> resetRequested{false};
+};
+
+/**
+ * Times its own lifetime into one section of a profile
+ */
+class ProfileScope {
+public:
+    ProfileScope(ModuleProfile& profile, int section)
+        : profile(profile), section(section), start(ProfileDetail::readCounter()) {}
+
+    ~ProfileScope() {
+        profile.record(section, ProfileDetail::readCounter() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ModuleProfile& profile;
+    int section;
+    uint64_t start;
+};
+
+/**
+ * Every live profile:
+ *   {"counter": "tsc", "ticks_per_second": 0, "modules": [{"slug", "id", "sections"}]}
+ * p50/p99 are histogram bucket upper edges, all times in counter ticks.
+ */
+inline json_t* profilesToJson() {
+    json_t* rootJ = json_object();
+    json_object_set_new(rootJ, "counter", json_string(ProfileDetail::counterName()));
+    json_object_set_new(rootJ, "ticks_per_second", json_real(ProfileDetail::counterFrequency()));
+    json_t* modulesJ = json_array();
+    auto& r = ProfileDetail::registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const ModuleProfile* profile : r.profiles) {
+            json_array_append_new(modulesJ, profile->toJson());
+        }
+    }
+    json_object_set_new(rootJ, "modules", modulesJ);
+    return rootJ;
+}
+
+inline void copyProfilesJson() {
+    json_t* rootJ = profilesToJson();
+    char* text = json_dumps(rootJ, JSON_INDENT(2));
+    json_decref(rootJ);
+    if (!text) return;
+    glfwSetClipboardString(APP->window->win, text);
+    std::free(text);
+}
+
+inline void saveProfilesJson() {
+    std::string path = rack::asset::user("WiggleRoom-profile.json");
+    json_t* rootJ = profilesToJson();
+    if (json_dump_file(rootJ, path.c_str(), JSON_INDENT(2)) == 0) {
+        INFO("Wrote profile to %s", path.c_str());
+    } else {
+        WARN("Cannot write %s", path.c_str());
+    }
+    json_decref(rootJ);
+}
+
+/**
+ * Append the "Profile" submenu: this module's sections plus reset and the
+ * all-modules JSON export
+ */
+inline void appendProfileMenu(rack::ui::Menu* menu, ModuleProfile& profile) {
+    menu->addChild(new rack::ui::MenuSeparator());
+    menu->addChild(rack::createSubmenuItem("Profile (" + std::string(ProfileDetail::counterName()) + " ticks)", "",
+        [&profile](rack::ui::Menu* submenu) {
+            submenu->addChild(rack::createMenuLabel(profile.name()));
+            for (const std::string& line : profile.summaryLines()) {
+                submenu->addChild(rack::createMenuLabel(line));
+            }
+            submenu->addChild(new rack::ui::MenuSeparator());
+            submenu->addChild(rack::createMenuItem("Reset", "", [&profile]() { profile.requestReset(); }));
+            submenu->addChild(rack::createMenuItem("Copy all modules as JSON", "", []() { copyProfilesJson(); }));
+            submenu->addChild(rack::createMenuItem("Save all modules as JSON", "", []() { saveProfilesJson(); }));
+        }
+    ));
+}
+
+#define WR_PROFILE_CONCAT_(a, b) a##b
+#define WR_PROFILE_CONCAT(a, b) WR_PROFILE_CONCAT_(a, b)
+#define WR_PROFILE_SCOPE(profile, name)                                                     \
+    static const int WR_PROFILE_CONCAT(wrProfileSection_, __LINE__) =                        \
+        ::WiggleRoom::ProfileDetail::sectionId(name);                                        \
+    ::WiggleRoom::ProfileScope WR_PROFILE_CONCAT(wrProfileScope_, __LINE__)(                 \
+        (profile), WR_PROFILE_CONCAT(wrProfileSection_, __LINE__))
+#define WR_PROFILE_MENU(menu, module) ::WiggleRoom::appendProfileMenu((menu), (module)->profile)
+
+#else
+
+#define WR_PROFILE_SCOPE(profile, name) do {} while (0)
+#define WR_PROFILE_MENU(menu, module) do {} while (0)
+
+#endif
+
+} // namespace WiggleRoom
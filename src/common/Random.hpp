@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Small random number generators
+ *
+ * Pcg32       - PCG XSH-RR 64/32: 16 bytes of state (vs ~2.5 KB for
+ *               std::mt19937), selectable stream, fast float path.
+ * CounterRng  - Stateless hash of (seed, stream, counter): value N of a
+ *               stream can be recomputed in O(1), so per-channel streams
+ *               stay reproducible whatever order they are consumed in.
+ *
+ * Both satisfy UniformRandomBitGenerator and work with <random>
+ * distributions where a particular distribution shape is needed.
+ ******************************************************************************/
+
+namespace RandomDetail {
+
+// SplitMix64 finalizer: a full-avalanche 64-bit mix
+constexpr uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Top 24 bits -> [0, 1)
+inline float toUniform(uint32_t bits) {
+    return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// Lemire's multiply-shift bounded integer in [0, n) (n > 0)
+inline uint32_t toBelow(uint32_t bits, uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(bits) * n) >> 32);
+}
+
+} // namespace RandomDetail
+
+// Non-deterministic seed for instances that are not seeded explicitly
+inline uint64_t randomSeed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+}
+
+struct Pcg32 {
+    using result_type = uint32_t;
+
+    uint64_t state = 0;
+    uint64_t inc = 1;
+
+    Pcg32() {
+        seed(randomSeed());
+    }
+
+    explicit Pcg32(uint64_t seedValue, uint64_t stream = 0) {
+        seed(seedValue, stream);
+    }
+
+    /**
+     * @param stream  Selects one of 2^63 independent sequences for the same seed
+     */
+    void seed(uint64_t seedValue, uint64_t stream = 0) {
+        state = 0;
+        inc = (stream << 1) | 1;
+        next();
+        state += seedValue;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    uint32_t operator()() { return next(); }
+    static constexpr uint32_t min() { return 0; }
+    static constexpr uint32_t max() { return UINT32_MAX; }
+
+    // Uniform float in [0, 1)
+    float uniform() { return RandomDetail::toUniform(next()); }
+
+    // Uniform integer in [0, n)
+    uint32_t below(uint32_t n) { return RandomDetail::toBelow(next(), n); }
+
+    // Uniform integer in [lo, hi]
+    int range(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint32_t>(hi - lo + 1))); }
+
+    // True with probability p
+    bool chance(float p) { return uniform() < p; }
+};
+
+struct CounterRng {
+    using result_type = uint32_t;
+
+    uint64_t key = 0;
+    uint64_t counter = 0;
+
+    CounterRng() = default;
+
+    CounterRng(uint64_t seedValue, uint64_t stream) {
+        seed(seedValue, stream);
+    }
+
+    void seed(uint64_t seedValue, uint64_t stream = 0) {
+        key = RandomDetail::mix64(seedValue ^ RandomDetail::mix64(stream + 0x9E3779B97F4A7C15ULL));
+        counter = 0;
+    }
+
+    // Value `index` of this stream (does not move the counter)
+    uint32_t at(uint64_t index) const {
+        return static_cast<uint32_t>(RandomDetail::mix64(key + index * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+
+    void seek(uint64_t index) { counter = index; }
+
+    uint32_t next() { return at(counter++); }
+
+    uint32_t operator()() { return next(); }
+    static constexpr uint32_t min() { return 0; }
+    static constexpr uint32_t max() { return UINT32_MAX; }
+
+    float uniform() { return RandomDetail::toUniform(next()); }
+    float uniformAt(uint64_t index) const { return RandomDetail::toUniform(at(index)); }
+    uint32_t below(uint32_t n) { return RandomDetail::toBelow(next(), n); }
+    int range(int lo, int hi) { return lo + static_cast<int>(below(static_cast<uint32_t>(hi - lo + 1))); }
+    bool chance(float p) { return uniform() < p; }
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "rack.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Tuned band-pass resonator bank, four bands per float_4
+ *
+ * Each band is Faust's fi.resonbp (analog resonant band-pass, bilinear
+ * transform with prewarping), so a 6-band bank matches the original
+ * spectral_resonator.dsp filters. States and coefficients are stored
+ * struct-of-arrays, one float_4 per four bands, and process() runs a whole
+ * group per instruction. With b1 = 0 and b2 = -b0 a band is three
+ * multiplies in transposed direct form II:
+ *
+ *   y  = b0 * x + s1
+ *   s1 = s2 - a1 * y
+ *   s2 = -b0 * x - a2 * y
+ *
+ * Band i sits at base * spread^(i - (N - 1) / 2), centred on the base
+ * frequency. Bands that would leave the audio range are folded back by
+ * octaves, so large banks keep their pitch classes instead of piling up
+ * at the limit. setChord() only recomputes coefficients when one of its
+ * arguments changed; call it at control rate with smoothed values.
+ *
+ * Even bands are summed to the left output and odd bands to the right.
+ *
+ *   ResonatorBank bank;
+ *   bank.setBandCount(12);
+ *   bank.setSampleRate(48000.f);
+ *   bank.setChord(110.f * std::exp2(volts), spread, q);   // every 16 samples
+ *   bank.process(in, left, right);                         // every sample
+ ******************************************************************************/
+
+class ResonatorBank {
+public:
+    static constexpr int MAX_BANDS = 32;
+    static constexpr int MAX_GROUPS = MAX_BANDS / 4;
+    static constexpr float MIN_FREQ = 20.f;
+    static constexpr float MAX_FREQ = 20000.f;
+
+    ResonatorBank() {
+        setBandCount(6);
+    }
+
+    /**
+     * @param n  1..MAX_BANDS; new bands start silent, existing ones keep ringing
+     */
+    void setBandCount(int n) {
+        n = std::min(std::max(n, 1), MAX_BANDS);
+        if (n == numBands) return;
+        numBands = n;
+        numGroups = (n + 3) / 4;
+        // Removed lanes, including those sharing a group with kept bands
+        for (int band = n; band < MAX_BANDS; band++) {
+            s1[band / 4][band % 4] = 0.f;
+            s2[band / 4][band % 4] = 0.f;
+        }
+        dirty = true;
+    }
+
+    int getBandCount() const {
+        return numBands;
+    }
+
+    void setSampleRate(float rate) {
+        if (rate == sampleRate) return;
+        sampleRate = rate;
+        dirty = true;
+    }
+
+    void setChord(float newBase, float newSpread, float newQ) {
+        if (!dirty && newBase == baseFreq && newSpread == spread && newQ == q) return;
+        baseFreq = newBase;
+        spread = newSpread;
+        q = std::max(newQ, 0.1f);
+        dirty = false;
+        updateCoefficients();
+    }
+
+    void process(float in, float& left, float& right) {
+        using rack::simd::float_4;
+        float_4 x = in;
+        float_4 sum = 0.f;
+        for (int g = 0; g < numGroups; g++) {
+            float_4 bx = b0[g] * x;
+            float_4 y = bx + s1[g];
+            s1[g] = s2[g] - a1[g] * y;
+            s2[g] = -bx - a2[g] * y;
+            sum += y;
+        }
+        left = sum[0] + sum[2];
+        right = sum[1] + sum[3];
+    }
+
+    void reset() {
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            s1[g] = 0.f;
+            s2[g] = 0.f;
+        }
+    }
+
+    // Band frequency after folding (for displays and tests)
+    float bandFrequency(int band) const {
+        float f = baseFreq * std::pow(spread, band - 0.5f * (numBands - 1));
+        float top = std::min(MAX_FREQ, 0.45f * sampleRate);
+        while (f > top) f *= 0.5f;
+        while (f < MIN_FREQ) f *= 2.f;
+        return f;
+    }
+
+private:
+    void updateCoefficients() {
+        // Q-dependent gain compensation as in the original .dsp: 1 at Q <= 10, 0.1 at Q = 100
+        float gain = 1.f / std::max(1.f, q * 0.1f);
+        for (int band = 0; band < MAX_GROUPS * 4; band++) {
+            int g = band / 4;
+            int lane = band % 4;
+            if (band >= numBands) {
+                b0[g][lane] = 0.f;
+                a1[g][lane] = 0.f;
+                a2[g][lane] = 0.f;
+                continue;
+            }
+            // tf2s(0, gain, 0, 1 / Q, 1, wc): peak gain is gain * Q
+            float wc = 2.f * float(M_PI) * bandFrequency(band);
+            float c = 1.f / std::tan(wc * 0.5f / sampleRate);
+            float csq = c * c;
+            float d = 1.f + c / q + csq;
+            b0[g][lane] = gain * c / d;
+            a1[g][lane] = 2.f * (1.f - csq) / d;
+            a2[g][lane] = (1.f - c / q + csq) / d;
+        }
+    }
+
+    rack::simd::float_4 b0[MAX_GROUPS] = {};
+    rack::simd::float_4 a1[MAX_GROUPS] = {};
+    rack::simd::float_4 a2[MAX_GROUPS] = {};
+    rack::simd::float_4 s1[MAX_GROUPS] = {};
+    rack::simd::float_4 s2[MAX_GROUPS] = {};
+
+    int numBands = 0;
+    int numGroups = 0;
+    float sampleRate = 48000.f;
+    float baseFreq = 440.f;
+    float spread = 1.5f;
+    float q = 50.f;
+    bool dirty = true;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "DSP.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Scale quantizer with a precomputed nearest-note table
+ *
+ * A scale is a 12-bit mask relative to its root (bit n = n semitones above
+ * the root). setScale() rebuilds the table only when mask or root change;
+ * quantizing is then a round, a table lookup and an add. The table holds
+ * the signed offset to the nearest in-scale note for each chroma; the
+ * scale repeats every octave, so 12 entries cover every MIDI note. Ties go
+ * to the lower note, and an empty mask leaves notes unchanged.
+ *
+ * Voltages are V/Oct with 0V = C4 (MIDI 60). quantize() also takes a
+ * float_4 so four voices cost about the same as one.
+ *
+ *   ScaleQuantizer q;
+ *   q.setScale(Scales::MASKS[scaleIdx], root);   // once per sample is fine
+ *   float out = q.quantize(in);
+ ******************************************************************************/
+
+namespace Scales {
+
+// Built via (1 << semitone) so each scale reads as its intervals.
+// Covers all 12-TET scales from Ornament & Crime (braids_quantizer_scales)
+// plus common Western/exotic additions.
+static constexpr int MASKS[] = {
+    // --- Diatonic modes ---
+    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 0  Major (Ionian)
+    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 1  Minor (Aeolian)
+    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<10),         // 2  Dorian
+    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 3  Phrygian
+    (1<<0)|(1<<2)|(1<<4)|(1<<6)|(1<<7)|(1<<9)|(1<<11),         // 4  Lydian
+    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<10),         // 5  Mixolydian
+    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<6)|(1<<8)|(1<<10),         // 6  Locrian
+    // --- Minor variants ---
+    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 7  Harmonic Minor
+    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 8  Melodic Minor (asc)
+    (1<<0)|(1<<2)|(1<<3)|(1<<6)|(1<<7)|(1<<8)|(1<<11),         // 9  Hungarian Minor
+    (1<<0)|(1<<2)|(1<<3)|(1<<6)|(1<<7)|(1<<9)|(1<<10),         // 10 Romanian Minor
+    // --- Pentatonic / blues ---
+    (1<<0)|(1<<2)|(1<<4)|(1<<7)|(1<<9),                        // 11 Pentatonic Major
+    (1<<0)|(1<<3)|(1<<5)|(1<<7)|(1<<10),                       // 12 Pentatonic Minor
+    (1<<0)|(1<<2)|(1<<3)|(1<<4)|(1<<7)|(1<<9),                 // 13 Blues Major
+    (1<<0)|(1<<3)|(1<<5)|(1<<6)|(1<<7)|(1<<10),                // 14 Blues Minor
+    // --- Symmetric ---
+    (1<<0)|(1<<2)|(1<<4)|(1<<6)|(1<<8)|(1<<10),                // 15 Whole Tone
+    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<6)|(1<<8)|(1<<9)|(1<<11),  // 16 Diminished (W-H)
+    (1<<0)|(1<<3)|(1<<4)|(1<<7)|(1<<8)|(1<<11),                // 17 Augmented
+    // --- Bebop / jazz ---
+    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<9)|(1<<11),  // 18 Bebop Major
+    (1<<0)|(1<<2)|(1<<3)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<10),  // 19 Bebop Dorian
+    // --- O_C exotic / world ---
+    (1<<0)|(1<<1)|(1<<3)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<10),  // 20 Folk
+    (1<<0)|(1<<2)|(1<<3)|(1<<7)|(1<<8),                        // 21 Hirajoshi
+    (1<<0)|(1<<1)|(1<<5)|(1<<7)|(1<<10),                       // 22 In Sen
+    (1<<0)|(1<<1)|(1<<5)|(1<<6)|(1<<10),                       // 23 Iwato
+    (1<<0)|(1<<2)|(1<<3)|(1<<7)|(1<<9),                        // 24 Kumoi
+    (1<<0)|(1<<1)|(1<<3)|(1<<7)|(1<<8),                        // 25 Pelog (Gamelan)
+    (1<<0)|(1<<1)|(1<<3)|(1<<4)|(1<<6)|(1<<8)|(1<<11),         // 26 Gypsy
+    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 27 Arabian (Double Harmonic)
+    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 28 Flamenco (Phrygian Dom)
+    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<6)|(1<<8)|(1<<11),         // 29 Persian
+    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 30 Neapolitan Minor
+    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 31 Neapolitan Major
+    (1<<0)|(1<<1)|(1<<4)|(1<<6)|(1<<8)|(1<<10)|(1<<11),        // 32 Enigmatic
+    // --- Catch-all ---
+    0xFFF                                                       // 33 Chromatic
+};
+
+static constexpr int NUM_SCALES = sizeof(MASKS) / sizeof(MASKS[0]);
+static constexpr int CHROMATIC = 0xFFF;
+
+inline const std::vector<std::string>& names() {
+    static const std::vector<std::string> v = {
+        "Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian", "Locrian",
+        "Harm Min", "Mel Min", "Hung Min", "Rom Min",
+        "Pent Maj", "Pent Min", "Blues Maj", "Blues Min",
+        "Whole", "Dim W-H", "Augment",
+        "Bebop Maj", "Bebop Dor",
+        "Folk", "Hirajoshi", "In Sen", "Iwato", "Kumoi", "Pelog",
+        "Gypsy", "Arabian", "Flamenco", "Persian", "Neap Min", "Neap Maj", "Enigmatic",
+        "Chromatic"
+    };
+    return v;
+}
+
+// The original 13-scale list, as indices into MASKS
+static constexpr int LEGACY_13[13] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8,
+    11,  // Pent Maj
+    12,  // Pent Min
+    15,  // Whole
+    33   // Chromatic
+};
+
+} // namespace Scales
+
+class ScaleQuantizer {
+public:
+    ScaleQuantizer() {
+        rebuild();
+    }
+
+    /**
+     * @param mask  12-bit scale mask relative to root (bit 0 = root)
+     * @param root  Root chroma 0-11 (0 = C)
+     */
+    void setScale(int newMask, int newRoot = 0) {
+        newMask &= 0xFFF;
+        newRoot = ((newRoot % 12) + 12) % 12;
+        if (newMask == mask && newRoot == root) return;
+        mask = newMask;
+        root = newRoot;
+        rebuild();
+    }
+
+    int getMask() const { return mask; }
+    int getRoot() const { return root; }
+
+    // Mask in absolute chromatic positions (bit 0 = C)
+    int getAbsoluteMask() const { return absoluteMask; }
+
+    bool contains(int note) const {
+        return (absoluteMask >> chromaOf(note)) & 1;
+    }
+
+    // Nearest in-scale MIDI note; may cross into the adjacent octave
+    int quantizeNote(int note) const {
+        return note + offsets[chromaOf(note)];
+    }
+
+    // Nearest in-scale V/Oct (0V = C4)
+    float quantize(float voltage) const {
+        return quantizeSemitone(semitoneOf(voltage));
+    }
+
+    // Voltage rounded to the nearest semitone (0 = C4). Two voltages with
+    // the same semitone always quantize to the same output, so callers can
+    // cache on it.
+    static float semitoneOf(float voltage) {
+        return DSP::FastMathDetail::floorf(voltage * 12.f + 0.5f);
+    }
+
+    // In-scale V/Oct for a whole semitone from semitoneOf()
+    float quantizeSemitone(float semitone) const {
+        return (semitone + offsets[chromaOf(static_cast<int>(semitone))]) * (1.f / 12.f);
+    }
+
+#ifdef WR_DSP_HAS_FLOAT4
+    rack::simd::float_4 quantize(rack::simd::float_4 voltage) const {
+        return quantizeSemitone(semitoneOf(voltage));
+    }
+
+    static rack::simd::float_4 semitoneOf(rack::simd::float_4 voltage) {
+        return DSP::FastMathDetail::floorf(voltage * 12.f + 0.5f);
+    }
+
+    rack::simd::float_4 quantizeSemitone(rack::simd::float_4 semitone) const {
+        using rack::simd::float_4;
+        float_4 octave = DSP::FastMathDetail::floorf(semitone * (1.f / 12.f));
+        float_4 chroma = semitone - octave * 12.f;
+        float_4 offset;
+        for (int i = 0; i < 4; i++) {
+            offset[i] = offsets[static_cast<int>(chroma[i]) & 15];
+        }
+        return (semitone + offset) * (1.f / 12.f);
+    }
+#endif
+
+private:
+    static int chromaOf(int note) {
+        int c = note % 12;
+        return c < 0 ? c + 12 : c;
+    }
+
+    void rebuild() {
+        absoluteMask = ((mask << root) | (mask >> (12 - root))) & 0xFFF;
+        for (int c = 0; c < 12; c++) {
+            offsets[c] = 0;
+            if (absoluteMask == 0 || ((absoluteMask >> c) & 1)) continue;
+            for (int d = 1; d <= 6; d++) {
+                if ((absoluteMask >> ((c - d + 12) % 12)) & 1) { offsets[c] = -d; break; }
+                if ((absoluteMask >> ((c + d) % 12)) & 1) { offsets[c] = d; break; }
+            }
+        }
+        // Entries 12-15 pad the table so a masked lane index stays in bounds
+        for (int c = 12; c < 16; c++) offsets[c] = 0;
+    }
+
+    int mask = Scales::CHROMATIC;
+    int root = 0;
+    int absoluteMask = Scales::CHROMATIC;
+    float offsets[16];   // Semitones to the nearest in-scale note, per chroma
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Lock-free decimated scope ring (audio thread -> UI thread)
+ *
+ * Single producer (process()) and single consumer (a widget's draw()).
+ * The producer folds every `decimation` samples into one frame holding the
+ * per-channel min and max (or just the latest value with peak hold off)
+ * and publishes it; the consumer copies out the newest frames with
+ * snapshot(). Nothing blocks and nothing allocates.
+ *
+ * Publishing bumps `begin` before writing the slot and `end` after, so a
+ * snapshot that raced with the producer can tell which of the frames it
+ * copied may have been overwritten and drops them (seqlock style) instead
+ * of drawing a torn frame.
+ *
+ * Frames are aligned to their size when that fits a cache line: eight
+ * channels of min/max are exactly one 64-byte line per decimated sample.
+ *
+ *   ScopeRing<256, 8> scope;             // module member
+ *   scope.setDecimation(256);
+ *   scope.push(values);                  // audio thread, every sample
+ *   int n = scope.snapshotChannel(lfo, mins, maxs, 256);   // UI thread
+ ******************************************************************************/
+
+template<int CAPACITY, int CHANNELS = 1>
+class ScopeRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "ScopeRing capacity must be a power of two");
+
+    static constexpr int FRAME_BYTES = 2 * CHANNELS * (int)sizeof(float);
+    static constexpr int FRAME_ALIGN = (FRAME_BYTES >= 64) ? 64
+                                     : (FRAME_BYTES & (FRAME_BYTES - 1)) == 0 ? FRAME_BYTES
+                                     : (int)alignof(float);
+
+public:
+    static constexpr int SIZE = CAPACITY;
+    static constexpr int NUM_CHANNELS = CHANNELS;
+
+    struct Frame {
+        float min[CHANNELS];
+        float max[CHANNELS];
+    };
+
+    // ========== Producer (audio thread) ==========
+
+    /**
+     * @param n  Input samples per published frame (>= 1)
+     */
+    void setDecimation(int n) {
+        decimation = std::max(n, 1);
+    }
+
+    int getDecimation() const {
+        return decimation;
+    }
+
+    /**
+     * Peak hold on: a frame keeps the min/max of its window.
+     * Peak hold off: min == max == the window's last sample.
+     */
+    void setPeakHold(bool on) {
+        peakHold = on;
+    }
+
+    void push(const float* values) {
+        if (counter == 0 || !peakHold) {
+            for (int c = 0; c < CHANNELS; c++) {
+                pending.min[c] = values[c];
+                pending.max[c] = values[c];
+            }
+        } else {
+            for (int c = 0; c < CHANNELS; c++) {
+                pending.min[c] = std::min(pending.min[c], values[c]);
+                pending.max[c] = std::max(pending.max[c], values[c]);
+            }
+        }
+        if (++counter >= decimation) {
+            counter = 0;
+            publish(pending);
+        }
+    }
+
+    void push(float value) {
+        static_assert(CHANNELS == 1, "push(float) is for single-channel rings");
+        push(&value);
+    }
+
+    // Restart the current decimation window (published frames are kept)
+    void restartWindow() {
+        counter = 0;
+    }
+
+    // ========== Consumer (UI thread) ==========
+
+    /**
+     * Copy up to maxFrames of the newest frames, oldest first.
+     * @return Number of frames written to out
+     */
+    int snapshot(Frame* out, int maxFrames) const {
+        uint32_t last = end.load(std::memory_order_acquire);
+        int count = std::min(std::min(maxFrames, CAPACITY), (int)std::min<uint32_t>(last, CAPACITY));
+        uint32_t first = last - count;
+        for (int i = 0; i < count; i++) {
+            const Slot& slot = slots[(first + i) & MASK];
+            for (int c = 0; c < CHANNELS; c++) {
+                out[i].min[c] = slot.min[c].load(std::memory_order_relaxed);
+                out[i].max[c] = slot.max[c].load(std::memory_order_relaxed);
+            }
+        }
+        int stale = std::min(staleCount(first), count);
+        if (stale > 0) {
+            count -= stale;
+            std::copy(out + stale, out + stale + count, out);
+        }
+        return count;
+    }
+
+    /**
+     * Copy one channel of up to maxFrames of the newest frames, oldest first.
+     * Either pointer may be null if only one edge is wanted.
+     * @return Number of values written
+     */
+    int snapshotChannel(int channel, float* mins, float* maxs, int maxFrames) const {
+        uint32_t last = end.load(std::memory_order_acquire);
+        int count = std::min(std::min(maxFrames, CAPACITY), (int)std::min<uint32_t>(last, CAPACITY));
+        uint32_t first = last - count;
+        for (int i = 0; i < count; i++) {
+            const Slot& slot = slots[(first + i) & MASK];
+            if (mins) mins[i] = slot.min[channel].load(std::memory_order_relaxed);
+            if (maxs) maxs[i] = slot.max[channel].load(std::memory_order_relaxed);
+        }
+        int stale = std::min(staleCount(first), count);
+        if (stale > 0) {
+            count -= stale;
+            if (mins) std::copy(mins + stale, mins + stale + count, mins);
+            if (maxs) std::copy(maxs + stale, maxs + stale + count, maxs);
+        }
+        return count;
+    }
+
+    /**
+     * Newest frame; false if nothing has been published yet
+     */
+    bool latest(Frame& out) const {
+        for (int attempt = 0; attempt < 4; attempt++) {
+            if (snapshot(&out, 1) == 1) return true;
+            if (end.load(std::memory_order_acquire) == 0) return false;
+        }
+        return false;
+    }
+
+    // Total frames published so far (wraps); lets widgets skip redraws
+    uint32_t framesPublished() const {
+        return end.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr uint32_t MASK = CAPACITY - 1;
+
+    struct alignas(FRAME_ALIGN) Slot {
+        std::atomic<float> min[CHANNELS];
+        std::atomic<float> max[CHANNELS];
+    };
+
+    void publish(const Frame& frame) {
+        uint32_t index = end.load(std::memory_order_relaxed);
+        begin.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = slots[index & MASK];
+        for (int c = 0; c < CHANNELS; c++) {
+            slot.min[c].store(frame.min[c], std::memory_order_relaxed);
+            slot.max[c].store(frame.max[c], std::memory_order_relaxed);
+        }
+        end.store(index + 1, std::memory_order_release);
+    }
+
+    // Leading frames of a copy starting at index `first` that the producer
+    // may have overwritten while we were reading
+    int staleCount(uint32_t first) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t claimed = begin.load(std::memory_order_relaxed);
+        // Indices below claimed - CAPACITY have been (or are being) reused
+        int32_t stale = (int32_t)(claimed - CAPACITY - first);
+        return std::max(stale, 0);
+    }
+
+    Slot slots[CAPACITY] = {};
+    alignas(64) std::atomic<uint32_t> begin{0};
+    std::atomic<uint32_t> end{0};
+
+    // Producer-only state
+    alignas(64) Frame pending = {};
+    int counter = 0;
+    int decimation = 1;
+    bool peakHold = true;
+};
+
+} // namespace WiggleRoom
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "rack.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace WiggleRoom {
+
+/******************************************************************************
+ * Shared pieces of the float_4 banks (LadderBank, MorphSvfBank, EnsembleBank)
+ *
+ * SmooStep is Faust's si.smoo, a one-pole lowpass with a 0.999 pole,
+ * stepped once per control-rate call instead of once per sample. Over an
+ * interval of n samples the pole is 0.999^n, so each step moves a value
+ * 1 - 0.999^n of the way to its target. The coefficient only depends on
+ * the interval, so it is computed when the interval changes and reused by
+ * every group and control in between.
+ *
+ * SimdBank keeps the channel and group counts of a bank that holds four
+ * channels per float_4 group. Groups that come into use are cleared with
+ * the bank's resetGroup(g), so new channels start silent and snap to
+ * their controls.
+ *
+ *   class MyBank : public SimdBank<MyBank, 16> {
+ *       friend SimdBank;
+ *       void resetGroup(int g);   // clear state, unprime smoothing
+ *   };
+ *
+ *   float coeff = smoo.coefficient(samples);   // in setControls()
+ *   value += (target - value) * coeff;
+ ******************************************************************************/
+
+class SmooStep {
+public:
+    // 1 - 0.999^samples, recomputed only when the interval changes
+    float coefficient(int samples) {
+        if (samples != interval) {
+            interval = samples;
+            coeff = 1.f - std::pow(0.999f, static_cast<float>(samples));
+        }
+        return coeff;
+    }
+
+private:
+    int interval = 0;
+    float coeff = 0.f;
+};
+
+template <typename Bank, int MAX_LANES>
+class SimdBank {
+public:
+    static_assert(MAX_LANES % 4 == 0, "SimdBank holds whole float_4 groups");
+
+    static constexpr int MAX_CHANNELS = MAX_LANES;
+    static constexpr int MAX_GROUPS = MAX_LANES / 4;
+
+    /**
+     * @param n  1..MAX_CHANNELS; new channels start silent and snap to their controls
+     */
+    void setChannelCount(int n) {
+        n = std::min(std::max(n, 1), MAX_CHANNELS);
+        if (n == numChannels) return;
+        int groups = (n + 3) / 4;
+        for (int g = numGroups; g < groups; g++) {
+            bank().resetGroup(g);
+        }
+        numChannels = n;
+        numGroups = groups;
+    }
+
+    int getChannelCount() const {
+        return numChannels;
+    }
+
+    int getGroupCount() const {
+        return numGroups;
+    }
+
+    void reset() {
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            bank().resetGroup(g);
+        }
+    }
+
+protected:
+    SmooStep smoo;
+
+private:
+    Bank& bank() {
+        return static_cast<Bank&>(*this);
+    }
+
+    int numChannels = 0;
+    int numGroups = 0;
+};
+
+} // namespace WiggleRoom
@@ -5,12 +5,98 @@
  * No VCV Rack dependencies - fully testable standalone
  ******************************************************************************/
 
-#include <vector>
 #include <cstdint>
 #include <algorithm>
 
 namespace WiggleRoom {
 
+namespace EuclideanDetail {
+
+constexpr int MAX_STEPS = 64;
+
+// Low `steps` bits set
+constexpr uint64_t stepMask(int steps) {
+    return (steps >= 64) ? ~uint64_t(0) : ((uint64_t(1) << steps) - 1);
+}
+
+/**
+ * Bjorklund's algorithm on bitmasks (bit i = step i), no allocation.
+ * Groups are built by appending the second sequence's groups to the
+ * first's until at most one remainder group is left.
+ */
+constexpr uint64_t bjorklund(int steps, int hits) {
+    if (steps <= 0 || hits <= 0) return 0;
+    if (hits >= steps) return stepMask(steps);
+
+    struct Group { uint64_t bits; int len; };
+    Group first[MAX_STEPS] = {};
+    Group second[MAX_STEPS] = {};
+    int numFirst = hits;
+    int numSecond = steps - hits;
+    for (int i = 0; i < numFirst; i++) first[i] = {1, 1};
+    for (int i = 0; i < numSecond; i++) second[i] = {0, 1};
+
+    while (numSecond > 1) {
+        int minSize = std::min(numFirst, numSecond);
+        for (int i = 0; i < minSize; i++) {
+            first[i].bits |= second[i].bits << first[i].len;
+            first[i].len += second[i].len;
+        }
+
+        if (numSecond > numFirst) {
+            // Unpaired second groups become the new remainder
+            for (int i = numFirst; i < numSecond; i++) second[i - numFirst] = second[i];
+            numSecond -= numFirst;
+        } else if (numFirst > numSecond) {
+            // Unpaired first groups become the new remainder
+            int count = 0;
+            for (int i = numSecond; i < numFirst; i++) second[count++] = first[i];
+            numFirst = numSecond;
+            numSecond = count;
+        } else {
+            numSecond = 0;
+        }
+    }
+
+    uint64_t result = 0;
+    int pos = 0;
+    for (int i = 0; i < numFirst; i++) {
+        result |= first[i].bits << pos;
+        pos += first[i].len;
+    }
+    for (int i = 0; i < numSecond; i++) {
+        result |= second[i].bits << pos;
+        pos += second[i].len;
+    }
+    return result;
+}
+
+// Step i of the result is step (i + rotation) of the pattern
+constexpr uint64_t rotate(uint64_t pattern, int steps, int rotation) {
+    if (rotation <= 0 || rotation >= steps) return pattern;
+    return ((pattern >> rotation) | (pattern << (steps - rotation))) & stepMask(steps);
+}
+
+/**
+ * Every unrotated pattern for 1-64 steps, indexed [steps][hits].
+ * Built once at plugin load (about 34 KB); lookups never allocate.
+ */
+struct PatternTable {
+    uint64_t patterns[MAX_STEPS + 1][MAX_STEPS + 1] = {};
+
+    PatternTable() {
+        for (int steps = 1; steps <= MAX_STEPS; steps++) {
+            for (int hits = 0; hits <= steps; hits++) {
+                patterns[steps][hits] = bjorklund(steps, hits);
+            }
+        }
+    }
+};
+
+inline const PatternTable PATTERN_TABLE;
+
+} // namespace EuclideanDetail
+
 struct EuclideanEngine {
     // Configuration
     int steps = 16;      // Total steps in pattern (1-64)
@@ -20,67 +106,19 @@ struct EuclideanEngine {
     // State
     int currentStep = 0; // Current position in sequence (0 to steps-1)
 
-    // Pre-computed pattern
-    std::vector<bool> pattern;
+    // Pre-computed pattern, bit i = step i
+    uint64_t pattern = EuclideanDetail::bjorklund(16, 8);
 
-    // Generate Euclidean rhythm pattern using Bjorklund's algorithm
+    // Look up the Euclidean rhythm for the current configuration
     void generate() {
-        pattern.clear();
-        pattern.resize(steps, false);
-
-        if (steps <= 0) return;
-        if (hits <= 0) return;
-        if (hits >= steps) {
-            pattern.assign(steps, true);
+        if (steps <= 0) {
+            pattern = 0;
             return;
         }
-
-        std::vector<std::vector<bool>> first, second;
-
-        for (int i = 0; i < hits; i++) {
-            first.push_back({true});
-        }
-        for (int i = 0; i < steps - hits; i++) {
-            second.push_back({false});
-        }
-
-        while (second.size() > 1) {
-            size_t minSize = std::min(first.size(), second.size());
-
-            for (size_t i = 0; i < minSize; i++) {
-                first[i].insert(first[i].end(), second[i].begin(), second[i].end());
-            }
-
-            std::vector<std::vector<bool>> newSecond;
-            if (second.size() > first.size()) {
-                for (size_t i = first.size(); i < second.size(); i++) {
-                    newSecond.push_back(std::move(second[i]));
-                }
-            } else if (first.size() > second.size()) {
-                for (size_t i = second.size(); i < first.size(); i++) {
-                    newSecond.push_back(std::move(first[i]));
-                }
-                first.resize(second.size());
-            }
-            second = std::move(newSecond);
-        }
-
-        std::vector<bool> result;
-        result.reserve(steps);
-        for (const auto& seq : first) {
-            result.insert(result.end(), seq.begin(), seq.end());
-        }
-        for (const auto& seq : second) {
-            result.insert(result.end(), seq.begin(), seq.end());
-        }
-
-        pattern.resize(steps);
-        for (int i = 0; i < steps; i++) {
-            int srcIdx = (i + rotation) % steps;
-            pattern[i] = result[srcIdx];
-        }
+        int n = std::min(steps, EuclideanDetail::MAX_STEPS);
+        int k = std::max(0, std::min(hits, n));
+        pattern = EuclideanDetail::rotate(EuclideanDetail::PATTERN_TABLE.patterns[n][k], n, rotation);
     }
-
     void configure(int numSteps, int numHits, int rot = 0) {
         int newSteps = std::max(1, std::min(64, numSteps));
         int newHits = std::max(0, std::min(newSteps, numHits));
@@ -102,10 +140,10 @@ struct EuclideanEngine {
     }
 
     bool tick() {
-        if (steps <= 0 || pattern.empty()) return false;
+        if (steps <= 0) return false;
 
-        bool isHit = pattern[currentStep];
-        currentStep = (currentStep + 1) % steps;
+        bool isHit = (pattern >> currentStep) & 1;
+        currentStep = (currentStep + 1 >= steps) ? 0 : currentStep + 1;
         return isHit;
     }
 
@@ -114,8 +152,8 @@ struct EuclideanEngine {
     }
 
     bool getHit(int step) const {
-        if (step < 0 || step >= (int)pattern.size()) return false;
-        return pattern[step];
+        if (step < 0 || step >= steps) return false;
+        return (pattern >> step) & 1;
     }
 
     int getCurrentStep() const {
@@ -5,68 +5,213 @@
  * via VCV Rack's expander system.
  *
  * Chain: EucSeq -> LogicMangler -> EucBank -> EucMix (left to right)
+ *
+ * Templated on the channel count N (1-8) so the same modules can be built
+ * as a 4-channel (16-state) or 8-channel (256-state) chain. Gates and
+ * triggers travel as packed bit words (bit c = channel c), and the truth
+ * table as one output mask byte per input state. A message carries its
+ * channel count so a module never reads a neighbour of a different width.
+ *
+ * The message is split by how often it changes:
+ *
+ *   hot    - gates, triggers, LFO and CV; rewritten every sample and packed
+ *            into one cache line (two for 8 channels).
+ *   seq    - EucSeq knob settings, only needed for bank storage.
+ *   logic  - LogicMangler truth table and knobs.
+ *
+ * Each cold section carries a generation stamp. A producer takes a fresh
+ * stamp from nextGeneration() whenever the section's values change, and
+ * copies the section into a buffer only if that buffer holds a different
+ * stamp. Rack double-buffers expander messages, so a change is copied at
+ * most twice (once per buffer) and the steady state moves only the hot
+ * section. Stamps are unique across all producers, so swapping one module in
+ * the chain for another can never leave a stale section looking current.
  ******************************************************************************/
 
+#include <atomic>
 #include <cstdint>
 
 namespace WiggleRoom {
 
-struct EuclogicExpanderMessage {
-    // EucSeq state
-    bool gates[4];           // current gate states per channel (pre-logic)
-    bool triggers[4];        // current trigger states
-    float lfo[4];            // LFO values (0-10V)
-    float cv[4];             // CV step values per channel
-    int currentStep[4];      // current step index per channel
-    int totalSteps[4];       // total steps per channel
+namespace EuclogicDetail {
 
-    // Truth table state (populated by LogicMangler)
-    uint8_t truthTableMapping[16];
-    uint8_t truthTableLocks[16];
-    bool postLogicGates[4];  // post-truth-table gate states
-    float probB[4];          // post-logic probability values
-    float colDensity[4];     // per-column density values
+// Shared by every chain width so stamps stay unique across all producers
+inline uint32_t nextGeneration() {
+    static std::atomic<uint32_t> counter{0};
+    uint32_t g;
+    do {
+        g = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    } while (g == 0);
+    return g;
+}
+
+} // namespace EuclogicDetail
+
+template<int N>
+struct EuclogicExpanderMessageT {
+    static_assert(N >= 1 && N <= 8, "Euclogic chains carry 1-8 channels");
+
+    static constexpr int NUM_CHANNELS = N;
+    static constexpr int N_STATES = 1 << N;
+
+    using GateWord = uint8_t;    // bit c = channel c
+
+    // EucSeq per-sample state plus LogicMangler's post-logic gates
+    struct alignas(64) Hot {
+        uint8_t channels;        // N; first so any width can check it
+        bool valid;              // true when message is populated
+        GateWord gates;          // current gate states (pre-logic)
+        GateWord triggers;       // current trigger states
+        GateWord postLogicGates; // post-truth-table gate states
+        uint8_t currentStep[N];  // current step index per channel
+        uint8_t totalSteps[N];   // total steps per channel
+        float lfo[N];            // LFO values (0-10V)
+        float cv[N];             // CV step values per channel
+
+        Hot() { clear(); }
+
+        void clear() {
+            channels = N;
+            valid = false;
+            gates = 0;
+            triggers = 0;
+            postLogicGates = 0;
+            for (int i = 0; i < N; i++) {
+                currentStep[i] = 0;
+                totalSteps[i] = 16;
+                lfo[i] = 0.f;
+                cv[i] = 0.f;
+            }
+        }
+
+        bool gate(int c) const { return (gates >> c) & 1; }
+        bool trigger(int c) const { return (triggers >> c) & 1; }
+        bool postLogicGate(int c) const { return (postLogicGates >> c) & 1; }
+    };
 
     // EucSeq params (for bank storage)
-    int steps[4];
-    int hits[4];
-    int quant[4];
-    float probA[4];
-    bool retrigger[4];
-    bool bipolar[4];
-    float speed;
-    float swing;
+    struct alignas(64) Seq {
+        uint32_t generation;     // 0 = default values
+        int steps[N];
+        int hits[N];
+        int quant[N];
+        float probA[N];
+        bool retrigger[N];
+        bool bipolar[N];
+        float speed;
+        float swing;
 
-    bool valid;              // true when message is populated
+        Seq() { clear(); }
 
-    EuclogicExpanderMessage() { clear(); }
+        void clear() {
+            generation = 0;
+            for (int i = 0; i < N; i++) {
+                steps[i] = 16;
+                hits[i] = 8;
+                quant[i] = 0;
+                probA[i] = 1.f;
+                retrigger[i] = true;
+                bipolar[i] = false;
+            }
+            speed = 8.f;  // x1 index
+            swing = 50.f;
+        }
 
-    void clear() {
-        for (int i = 0; i < 4; i++) {
-            gates[i] = false;
-            triggers[i] = false;
-            lfo[i] = 0.f;
-            cv[i] = 0.f;
-            currentStep[i] = 0;
-            totalSteps[i] = 16;
-            postLogicGates[i] = false;
-            probB[i] = 1.f;
-            colDensity[i] = 0.5f;
-            steps[i] = 16;
-            hits[i] = 8;
-            quant[i] = 0;
-            probA[i] = 1.f;
-            retrigger[i] = true;
-            bipolar[i] = false;
+        // Compares values only (not the generation)
+        bool sameValues(const Seq& o) const {
+            for (int i = 0; i < N; i++) {
+                if (steps[i] != o.steps[i] || hits[i] != o.hits[i] || quant[i] != o.quant[i]
+                    || probA[i] != o.probA[i] || retrigger[i] != o.retrigger[i]
+                    || bipolar[i] != o.bipolar[i]) return false;
+            }
+            return speed == o.speed && swing == o.swing;
         }
-        for (int i = 0; i < 16; i++) {
-            truthTableMapping[i] = static_cast<uint8_t>(i) & 0x0F;
-            truthTableLocks[i] = 0;
+    };
+
+    // Truth table state (populated by LogicMangler)
+    struct alignas(64) Logic {
+        uint32_t generation;     // 0 = default values
+        uint8_t truthTableMapping[N_STATES];  // output mask per input state
+        uint8_t truthTableLocks[N_STATES];    // locked output bits per input state
+        float probB[N];          // post-logic probability values
+        float colDensity[N];     // per-column density values
+
+        Logic() { clear(); }
+
+        void clear() {
+            generation = 0;
+            for (int i = 0; i < N_STATES; i++) {
+                truthTableMapping[i] = static_cast<uint8_t>(i);
+                truthTableLocks[i] = 0;
+            }
+            for (int i = 0; i < N; i++) {
+                probB[i] = 1.f;
+                colDensity[i] = 0.5f;
+            }
         }
-        speed = 8.f;  // x1 index
-        swing = 50.f;
-        valid = false;
+
+        bool sameValues(const Logic& o) const {
+            for (int i = 0; i < N_STATES; i++) {
+                if (truthTableMapping[i] != o.truthTableMapping[i]
+                    || truthTableLocks[i] != o.truthTableLocks[i]) return false;
+            }
+            for (int i = 0; i < N; i++) {
+                if (probB[i] != o.probB[i] || colDensity[i] != o.colDensity[i]) return false;
+            }
+            return true;
+        }
+    };
+
+    Hot hot;
+    Seq seq;
+    Logic logic;
+
+    // Back to defaults; cold sections already at defaults are left alone
+    void clear() {
+        hot.clear();
+        clearSeq();
+        clearLogic();
+    }
+
+    void clearSeq() {
+        if (seq.generation != 0) seq.clear();
+    }
+
+    void clearLogic() {
+        if (logic.generation != 0) logic.clear();
+    }
+
+    // True when populated by a neighbour of the same width
+    bool usable() const {
+        return hot.channels == N && hot.valid;
+    }
+
+    // Fresh, never-zero stamp for a changed cold section
+    static uint32_t nextGeneration() {
+        return EuclogicDetail::nextGeneration();
+    }
+
+    // Copy a cold section only if this buffer holds a different generation
+    void publishSeq(const Seq& src) {
+        if (seq.generation != src.generation) seq = src;
+    }
+
+    void publishLogic(const Logic& src) {
+        if (logic.generation != src.generation) logic = src;
+    }
+
+    // Pass-through for modules in the middle of the chain
+    void forward(const EuclogicExpanderMessageT& src) {
+        hot = src.hot;
+        publishSeq(src.seq);
+        publishLogic(src.logic);
     }
 };
 
+using EuclogicExpanderMessage = EuclogicExpanderMessageT<4>;
+using EuclogicExpanderMessage8 = EuclogicExpanderMessageT<8>;
+
+static_assert(sizeof(EuclogicExpanderMessage::Hot) == 64, "4-channel hot section must stay one cache line");
+static_assert(sizeof(EuclogicExpanderMessage8::Hot) == 128, "8-channel hot section must stay two cache lines");
+
 } // namespace WiggleRoom
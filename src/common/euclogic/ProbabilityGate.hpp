@@ -5,7 +5,7 @@
  * No VCV Rack dependencies - fully testable standalone
  ******************************************************************************/
 
-#include <random>
+#include "../Random.hpp"
 #include <cstdint>
 #include <algorithm>
 
@@ -14,29 +14,30 @@ namespace WiggleRoom {
 struct ProbabilityGate {
     float probability = 1.0f;
 
-    std::mt19937 rng;
-    std::uniform_real_distribution<float> dist{0.0f, 1.0f};
+    Pcg32 rng{0};
     uint32_t seed = 0;
+    uint32_t stream = 0;
 
     ProbabilityGate() {
-        std::random_device rd;
-        seed = rd();
-        rng.seed(seed);
+        seed = static_cast<uint32_t>(randomSeed());
+        rng.seed(seed, stream);
     }
 
-    void setSeed(uint32_t s) {
+    // Gates sharing a seed get independent sequences per stream (e.g. channel index)
+    void setSeed(uint32_t s, uint32_t streamId = 0) {
         seed = s;
-        rng.seed(seed);
+        stream = streamId;
+        rng.seed(seed, stream);
     }
 
     void reset() {
-        rng.seed(seed);
+        rng.seed(seed, stream);
     }
 
     bool test() {
         if (probability <= 0.0f) return false;
         if (probability >= 1.0f) return true;
-        return dist(rng) < probability;
+        return rng.uniform() < probability;
     }
 
     bool process(bool input) {
@@ -48,7 +49,7 @@ struct ProbabilityGate {
         if (!input) return false;
         if (prob <= 0.0f) return false;
         if (prob >= 1.0f) return true;
-        return dist(rng) < prob;
+        return rng.uniform() < prob;
     }
 
     void setProbability(float p) {
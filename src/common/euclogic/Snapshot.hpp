@@ -0,0 +1,97 @@
+#pragma once
+/******************************************************************************
+ * EUCLOGIC SNAPSHOTS AND RECALL
+ *
+ * A snapshot is the cold part of the chain state (EucSeq params plus the
+ * LogicMangler table and knobs), stored as plain data so EucBank's slot
+ * pool can be copied and recalled from process() without allocating.
+ *
+ * Recall travels right to left: EucBank posts a snapshot to its left
+ * neighbour's mailbox, LogicMangler applies its part and posts the same
+ * snapshot on to EucSeq. Each mailbox is single producer / single
+ * consumer and the latest post wins. Neighbours may be processed on
+ * different engine threads, so the mailbox never lets both sides touch
+ * the payload at once; a post that finds the reader busy returns false
+ * and is retried on the next sample. A recall therefore reaches EucSeq
+ * zero to a few samples after EucBank posts it, depending on the engine's
+ * thread order, and is applied before EucSeq's next tick.
+ ******************************************************************************/
+
+#include "ExpanderMessage.hpp"
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace WiggleRoom {
+
+template<int N>
+struct EuclogicSnapshotT {
+    typename EuclogicExpanderMessageT<N>::Seq seq;
+    typename EuclogicExpanderMessageT<N>::Logic logic;
+};
+
+namespace EuclogicDetail {
+
+template<typename T>
+class Mailbox {
+    static_assert(std::is_trivially_copyable<T>::value, "Mailbox payloads are copied between threads");
+
+public:
+    // Producer: false if the consumer is mid-read (try again later)
+    bool post(const T& v) {
+        uint8_t s = state.load(std::memory_order_acquire);
+        if (s == READING) return false;
+        if (!state.compare_exchange_strong(s, WRITING, std::memory_order_acq_rel)) return false;
+        value = v;
+        state.store(FULL, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: true and fills out if a post was waiting
+    bool take(T& out) {
+        uint8_t s = FULL;
+        if (!state.compare_exchange_strong(s, READING, std::memory_order_acq_rel)) return false;
+        out = value;
+        state.store(EMPTY, std::memory_order_release);
+        return true;
+    }
+
+private:
+    enum : uint8_t { EMPTY, WRITING, FULL, READING };
+
+    T value{};
+    std::atomic<uint8_t> state{EMPTY};
+};
+
+} // namespace EuclogicDetail
+
+/**
+ * Mixin for modules that accept a recalled snapshot from their right
+ * neighbour (EucSeq, LogicMangler)
+ */
+template<int N>
+struct EuclogicRecallTargetT {
+    using Snapshot = EuclogicSnapshotT<N>;
+
+    virtual ~EuclogicRecallTargetT() = default;
+
+    bool postRecall(const Snapshot& snapshot) {
+        return recallMailbox.post(snapshot);
+    }
+
+    // Recall target of the given neighbour module, if it is one of this width
+    template<typename TModule>
+    static EuclogicRecallTargetT* of(TModule* module) {
+        return module ? dynamic_cast<EuclogicRecallTargetT*>(module) : nullptr;
+    }
+
+protected:
+    bool takeRecall(Snapshot& out) {
+        return recallMailbox.take(out);
+    }
+
+private:
+    EuclogicDetail::Mailbox<Snapshot> recallMailbox;
+};
+
+} // namespace WiggleRoom
@@ -8,18 +8,64 @@
  *   - Per-cell lock mask (excluded from randomize/mutate)
  *   - Row/column randomize and mutate (respecting locks)
  *   - Per-column density control
+ *   - Bounded, preallocated undo/redo history (no allocation on mutate)
+ *   - Batch evaluation of up to 16 polyphonic lanes (byte shuffle / bit-sliced)
  ******************************************************************************/
 
 #include <array>
-#include <vector>
 #include <cstdint>
-#include <random>
+#include "../Random.hpp"
 #include <cstring>
 #include <algorithm>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace WiggleRoom {
 
-template<int N_CHANNELS>
+/**
+ * Fixed-capacity stack on a ring buffer: pushing onto a full stack drops the
+ * oldest entry. O(1) push/pop, storage is allocated with the owner.
+ */
+template<typename T, int CAPACITY>
+struct HistoryRing {
+    static_assert(CAPACITY > 0, "HistoryRing needs at least one slot");
+
+    std::array<T, CAPACITY> entries{};
+    int top = 0;            // Slot the next push writes
+    int count = 0;
+    int depth = CAPACITY;   // Active limit (1..CAPACITY)
+
+    void push(const T& entry) {
+        entries[top] = entry;
+        top = (top + 1 == CAPACITY) ? 0 : top + 1;
+        if (count < depth) count++;
+    }
+
+    // Newest entry; only valid when !empty()
+    const T& peek() const {
+        return entries[(top == 0) ? CAPACITY - 1 : top - 1];
+    }
+
+    void pop() {
+        if (count == 0) return;
+        top = (top == 0) ? CAPACITY - 1 : top - 1;
+        count--;
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    void clear() { count = 0; }
+
+    // Keeps the newest entries if the depth shrinks
+    void setDepth(int newDepth) {
+        depth = std::max(1, std::min(CAPACITY, newDepth));
+        count = std::min(count, depth);
+    }
+};
+
+template<int N_CHANNELS, int HISTORY_CAPACITY = 64>
 struct TruthTableT {
     static constexpr int N_STATES = (1 << N_CHANNELS);
     static constexpr int N_BITS = N_CHANNELS;
@@ -31,16 +77,16 @@ struct TruthTableT {
     // Per-cell lock mask: if bit is set, that output bit is locked for that input state
     std::array<uint8_t, N_STATES> lockMask{};
 
-    // Unlimited undo/redo history
+    // Bounded undo/redo history (oldest undo steps fall off past the depth)
     struct HistoryEntry {
         std::array<uint8_t, N_STATES> mapping;
         std::array<uint8_t, N_STATES> lockMask;
     };
-    std::vector<HistoryEntry> undoHistory;
-    std::vector<HistoryEntry> redoHistory;
+    HistoryRing<HistoryEntry, HISTORY_CAPACITY> undoHistory;
+    HistoryRing<HistoryEntry, HISTORY_CAPACITY> redoHistory;
 
     // RNG for randomization
-    std::mt19937 rng;
+    Pcg32 rng;
 
     TruthTableT() {
         // Default: pass-through (output mirrors input)
@@ -48,8 +94,6 @@ struct TruthTableT {
             mapping[i] = static_cast<uint8_t>(i) & OUTPUT_MASK;
             lockMask[i] = 0;
         }
-        std::random_device rd;
-        rng.seed(rd());
     }
 
     void setSeed(uint32_t seed) {
@@ -77,6 +121,63 @@ struct TruthTableT {
         return {outputs[0], outputs[1], outputs[2], outputs[3]};
     }
 
+    // ---------------------------------------------------------------
+    // Batch evaluation (polyphonic lanes)
+    // ---------------------------------------------------------------
+    static constexpr int MAX_LANES = 16;
+
+    /**
+     * Lane-major: states[l] is lane l's input index, outputs[l] its output
+     * mask. For 4 channels the 16-entry table fits one register and all 16
+     * lanes are a single byte shuffle (pshufb) where SSSE3 is available.
+     */
+    void evaluateLanes(const uint8_t* states, uint8_t* outputs, int lanes) const {
+        if constexpr (N_CHANNELS == 4) {
+#if defined(__SSSE3__)
+            alignas(16) uint8_t in[MAX_LANES] = {};
+            alignas(16) uint8_t out[MAX_LANES];
+            lanes = std::min(lanes, (int)MAX_LANES);
+            std::memcpy(in, states, lanes);
+            __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mapping.data()));
+            __m128i index = _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(in)),
+                                          _mm_set1_epi8(0x0F));
+            _mm_store_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(table, index));
+            std::memcpy(outputs, out, lanes);
+            return;
+#endif
+        }
+        for (int l = 0; l < lanes; l++) {
+            outputs[l] = mapping[states[l] & (N_STATES - 1)];
+        }
+    }
+
+    /**
+     * Bit-sliced: bit l of inputs[c] is lane l's input c, and outputs[c]
+     * uses the same layout. Every row selects its lanes with one AND per
+     * channel (minterm expansion), so all lanes go through the table
+     * together with no per-lane branching.
+     */
+    void evaluateSliced(const uint16_t inputs[N_CHANNELS], uint16_t outputs[N_CHANNELS],
+                        uint16_t laneMask = 0xFFFF) const {
+        // rows[s] has bit l set iff lane l's input state is s
+        std::array<uint16_t, N_STATES> rows;
+        rows[0] = laneMask;
+        for (int c = 0, n = 1; c < N_CHANNELS; c++, n <<= 1) {
+            for (int s = 0; s < n; s++) {
+                rows[s + n] = rows[s] & inputs[c];
+                rows[s] = rows[s] & static_cast<uint16_t>(~inputs[c]);
+            }
+        }
+
+        for (int c = 0; c < N_CHANNELS; c++) outputs[c] = 0;
+        for (int s = 0; s < N_STATES; s++) {
+            for (int c = 0; c < N_CHANNELS; c++) {
+                uint16_t select = static_cast<uint16_t>(-((mapping[s] >> c) & 1));
+                outputs[c] |= rows[s] & select;
+            }
+        }
+    }
+
     void setMapping(uint8_t inputState, uint8_t outputMask) {
         if (inputState < N_STATES) {
             mapping[inputState] = outputMask & OUTPUT_MASK;
@@ -124,27 +225,27 @@ struct TruthTableT {
     // Undo/Redo (now includes lock state)
     // ---------------------------------------------------------------
     void pushUndo() {
-        undoHistory.push_back({mapping, lockMask});
+        undoHistory.push({mapping, lockMask});
         redoHistory.clear();
     }
 
     bool undo() {
         if (undoHistory.empty()) return false;
-        redoHistory.push_back({mapping, lockMask});
-        auto& entry = undoHistory.back();
+        redoHistory.push({mapping, lockMask});
+        const auto& entry = undoHistory.peek();
         mapping = entry.mapping;
         lockMask = entry.lockMask;
-        undoHistory.pop_back();
+        undoHistory.pop();
         return true;
     }
 
     bool redo() {
         if (redoHistory.empty()) return false;
-        undoHistory.push_back({mapping, lockMask});
-        auto& entry = redoHistory.back();
+        undoHistory.push({mapping, lockMask});
+        const auto& entry = redoHistory.peek();
         mapping = entry.mapping;
         lockMask = entry.lockMask;
-        redoHistory.pop_back();
+        redoHistory.pop();
         return true;
     }
 
@@ -153,12 +254,21 @@ struct TruthTableT {
         redoHistory.clear();
     }
 
+    // Number of undo steps kept (1..HISTORY_CAPACITY)
+    void setHistoryDepth(int depth) {
+        undoHistory.setDepth(depth);
+        redoHistory.setDepth(depth);
+    }
+
+    int getHistoryDepth() const {
+        return undoHistory.depth;
+    }
+
     // ---------------------------------------------------------------
     // Randomize / Mutate (respect locks)
     // ---------------------------------------------------------------
     void randomize() {
         pushUndo();
-        std::uniform_int_distribution<int> dist(0, 1);
         for (int i = 0; i < N_STATES; i++) {
             uint8_t newVal = 0;
             for (int bit = 0; bit < N_CHANNELS; bit++) {
@@ -166,7 +276,7 @@ struct TruthTableT {
                     // Preserve locked bit
                     newVal |= (mapping[i] & (1 << bit));
                 } else {
-                    if (dist(rng)) newVal |= (1 << bit);
+                    if (rng.below(2)) newVal |= (1 << bit);
                 }
             }
             mapping[i] = newVal;
@@ -175,25 +285,22 @@ struct TruthTableT {
 
     void mutate() {
         pushUndo();
-        // Find unlocked cells
-        struct Cell { int state; int bit; };
-        std::vector<Cell> unlocked;
+        // Find unlocked cells (cell = state * N_CHANNELS + bit)
+        std::array<uint16_t, N_STATES * N_CHANNELS> unlocked;
+        int numUnlocked = 0;
         for (int i = 0; i < N_STATES; i++) {
             for (int bit = 0; bit < N_CHANNELS; bit++) {
                 if (!isLocked(i, bit)) {
-                    unlocked.push_back({i, bit});
+                    unlocked[numUnlocked++] = static_cast<uint16_t>(i * N_CHANNELS + bit);
                 }
             }
         }
-        if (unlocked.empty()) return;
-
-        std::uniform_int_distribution<int> countDist(1, std::min(3, (int)unlocked.size()));
-        std::uniform_int_distribution<int> cellDist(0, (int)unlocked.size() - 1);
+        if (numUnlocked == 0) return;
 
-        int numFlips = countDist(rng);
+        int numFlips = rng.range(1, std::min(3, numUnlocked));
         for (int i = 0; i < numFlips; i++) {
-            auto& cell = unlocked[cellDist(rng)];
-            mapping[cell.state] ^= (1 << cell.bit);
+            int cell = unlocked[rng.below(numUnlocked)];
+            mapping[cell / N_CHANNELS] ^= (1 << (cell % N_CHANNELS));
         }
     }
 
@@ -203,10 +310,9 @@ struct TruthTableT {
     void randomizeRow(int row) {
         if (row < 0 || row >= N_STATES) return;
         pushUndo();
-        std::uniform_int_distribution<int> dist(0, 1);
         for (int bit = 0; bit < N_CHANNELS; bit++) {
             if (!isLocked(row, bit)) {
-                if (dist(rng))
+                if (rng.below(2))
                     mapping[row] |= (1 << bit);
                 else
                     mapping[row] &= ~(1 << bit);
@@ -217,10 +323,9 @@ struct TruthTableT {
     void randomizeColumn(int col) {
         if (col < 0 || col >= N_CHANNELS) return;
         pushUndo();
-        std::uniform_int_distribution<int> dist(0, 1);
         for (int i = 0; i < N_STATES; i++) {
             if (!isLocked(i, col)) {
-                if (dist(rng))
+                if (rng.below(2))
                     mapping[i] |= (1 << col);
                 else
                     mapping[i] &= ~(1 << col);
@@ -231,26 +336,26 @@ struct TruthTableT {
     void mutateRow(int row) {
         if (row < 0 || row >= N_STATES) return;
         pushUndo();
-        std::vector<int> unlockedBits;
+        std::array<int, N_CHANNELS> unlockedBits;
+        int numUnlocked = 0;
         for (int bit = 0; bit < N_CHANNELS; bit++) {
-            if (!isLocked(row, bit)) unlockedBits.push_back(bit);
+            if (!isLocked(row, bit)) unlockedBits[numUnlocked++] = bit;
         }
-        if (unlockedBits.empty()) return;
-        std::uniform_int_distribution<int> dist(0, (int)unlockedBits.size() - 1);
-        int bit = unlockedBits[dist(rng)];
+        if (numUnlocked == 0) return;
+        int bit = unlockedBits[rng.below(numUnlocked)];
         mapping[row] ^= (1 << bit);
     }
 
     void mutateColumn(int col) {
         if (col < 0 || col >= N_CHANNELS) return;
         pushUndo();
-        std::vector<int> unlockedRows;
+        std::array<int, N_STATES> unlockedRows;
+        int numUnlocked = 0;
         for (int i = 0; i < N_STATES; i++) {
-            if (!isLocked(i, col)) unlockedRows.push_back(i);
+            if (!isLocked(i, col)) unlockedRows[numUnlocked++] = i;
         }
-        if (unlockedRows.empty()) return;
-        std::uniform_int_distribution<int> dist(0, (int)unlockedRows.size() - 1);
-        int row = unlockedRows[dist(rng)];
+        if (numUnlocked == 0) return;
+        int row = unlockedRows[rng.below(numUnlocked)];
         mapping[row] ^= (1 << col);
     }
 
@@ -258,10 +363,9 @@ struct TruthTableT {
     void setColumnDensity(int col, float density) {
         if (col < 0 || col >= N_CHANNELS) return;
         pushUndo();
-        std::uniform_real_distribution<float> dist(0.f, 1.f);
         for (int i = 0; i < N_STATES; i++) {
             if (!isLocked(i, col)) {
-                if (dist(rng) < density)
+                if (rng.uniform() < density)
                     mapping[i] |= (1 << col);
                 else
                     mapping[i] &= ~(1 << col);
@@ -272,10 +376,9 @@ struct TruthTableT {
     void setRowDensity(int row, float density) {
         if (row < 0 || row >= N_STATES) return;
         pushUndo();
-        std::uniform_real_distribution<float> dist(0.f, 1.f);
         for (int bit = 0; bit < N_CHANNELS; bit++) {
             if (!isLocked(row, bit)) {
-                if (dist(rng) < density)
+                if (rng.uniform() < density)
                     mapping[row] |= (1 << bit);
                 else
                     mapping[row] &= ~(1 << bit);
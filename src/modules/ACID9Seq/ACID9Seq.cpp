@@ -11,11 +11,14 @@
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "CachedDisplay.hpp"
+#include "ClockBus.hpp"
 #include "DSP.hpp"
 #include "ImagePanel.hpp"
 #include "InterferenceEngine.hpp"
 #include "LogicEngine.hpp"
-#include <random>
+#include "ScopeRing.hpp"
+#include "Random.hpp"
 
 using namespace rack;
 
@@ -96,9 +99,9 @@ struct ACID9Seq : Module {
     };
 
     InterferenceEngine engine;
-    LogicEngine logic;
 
     dsp::SchmittTrigger clockTrigger;
+    ClockBus::Reader clockBus;
     dsp::SchmittTrigger resetTrigger;
     dsp::SchmittTrigger mutateATrigger;
     dsp::SchmittTrigger mutateBTrigger;
@@ -125,12 +128,22 @@ struct ACID9Seq : Module {
     float targetVoltage = 0.0f;
 
     // Random for probability
-    std::mt19937 rng{std::random_device{}()};
-    std::uniform_real_distribution<float> probDist{0.0f, 1.0f};
+    Pcg32 rng;
 
     // Slide smoothing
     static constexpr float SLIDE_TIME = 0.05f;
 
+    // Engine state for PlanetaryDisplay, published from the audio thread
+    enum DisplayChannel {
+        DISPLAY_GEAR_A_POS,
+        DISPLAY_GEAR_B_POS,
+        DISPLAY_GEAR_B_LEN,
+        DISPLAY_PITCH,
+        DISPLAY_CHANNELS
+    };
+    static constexpr int DISPLAY_DECIMATION = 64;
+    ScopeRing<4, DISPLAY_CHANNELS> displayState;
+
     ACID9Seq() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -181,26 +194,17 @@ struct ACID9Seq : Module {
         configOutput(GATE_OUTPUT, "Gate");
         configOutput(ACCENT_OUTPUT, "Accent");
         configOutput(SLIDE_OUTPUT, "Slide");
+
+        displayState.setDecimation(DISPLAY_DECIMATION);
+        displayState.setPeakHold(false);
     }
 
     void advanceSequence() {
-        // Advance engine
+        // Advance engine (pitch and logic modes come from its cycle table)
+        engine.setThreshold(static_cast<int>(params[THRESHOLD_PARAM].getValue()));
         engine.onClock();
 
-        // Update logic engine with current state
-        logic.update(
-            engine.getQuantizedPitch(),
-            engine.getPrevPitch(),
-            engine.getPrevPrevPitch(),
-            engine.getGearAValue(),
-            engine.getPrevGearAValue(),
-            engine.getCurrentGearBOffset(),
-            engine.getPrevGearBOffset()
-        );
-
         // Get parameters
-        int threshold = static_cast<int>(params[THRESHOLD_PARAM].getValue());
-
         int gateMode = static_cast<int>(params[GATE_MODE_PARAM].getValue());
         float gateProb = params[GATE_PROB_PARAM].getValue();
 
@@ -211,9 +215,9 @@ struct ACID9Seq : Module {
         float accentProb = params[ACCENT_PROB_PARAM].getValue();
 
         // Evaluate logic with probability
-        gateHigh = logic.evaluateWithProb(gateMode, threshold, gateProb, probDist(rng));
-        slideActive = logic.evaluateWithProb(slideMode, threshold, slideProb, probDist(rng));
-        accentActive = logic.evaluateWithProb(accentMode, threshold, accentProb, probDist(rng));
+        gateHigh = engine.evaluateWithProb(gateMode, gateProb, rng.uniform());
+        slideActive = engine.evaluateWithProb(slideMode, slideProb, rng.uniform());
+        accentActive = engine.evaluateWithProb(accentMode, accentProb, rng.uniform());
 
         // Get target voltage
         targetVoltage = engine.getPitchVoltage();
@@ -277,7 +281,6 @@ struct ACID9Seq : Module {
         // Process reset
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage())) {
             engine.reset();
-            logic.reset();
             gateHigh = false;
             slideActive = false;
             clockDivCounter = 0;
@@ -297,11 +300,19 @@ struct ACID9Seq : Module {
             prevClockDivIdx = clockDivIdx;
         }
 
-        bool extClockTick = clockTrigger.process(inputs[CLOCK_INPUT].getVoltage());
+        // PreFlightClock's bus carries the exact period; other clocks are timed
+        bool extClockTick;
+        bool clockFromBus = clockBus.read(inputs[CLOCK_INPUT]);
+        if (clockFromBus) {
+            extClockTick = clockBus.edge;
+            clockPeriod = clockBus.period;
+        } else {
+            extClockTick = clockTrigger.process(inputs[CLOCK_INPUT].getVoltage());
+        }
 
         // Track time between external clocks
         if (extClockTick) {
-            if (timeSinceExtClock > 0.001f) {  // Ignore very fast re-triggers
+            if (!clockFromBus && timeSinceExtClock > 0.001f) {  // Ignore very fast re-triggers
                 clockPeriod = timeSinceExtClock;
             }
             timeSinceExtClock = 0.f;
@@ -368,6 +379,13 @@ struct ACID9Seq : Module {
         lights[SLIDE_LIGHT].setSmoothBrightness(slideActive ? 1.0f : 0.0f, args.sampleTime);
         lights[ACCENT_LIGHT].setSmoothBrightness(accentActive ? 1.0f : 0.0f, args.sampleTime);
         lights[CLOCK_LIGHT].setSmoothBrightness(clockPulse.process(args.sampleTime) ? 1.0f : 0.0f, args.sampleTime);
+
+        float state[DISPLAY_CHANNELS];
+        state[DISPLAY_GEAR_A_POS] = (float)engine.getGearA().getPosition();
+        state[DISPLAY_GEAR_B_POS] = (float)engine.getGearB().getPosition();
+        state[DISPLAY_GEAR_B_LEN] = (float)engine.getGearBLength();
+        state[DISPLAY_PITCH] = (float)engine.getQuantizedPitch();
+        displayState.push(state);
     }
 
     json_t* dataToJson() override {
@@ -387,25 +405,29 @@ struct ACID9Seq : Module {
 // Include the planetary display after ACID9Seq is defined
 #include "widgets/PlanetaryDisplay.hpp"
 
-// Implement PlanetaryDisplay accessor methods
+// Implement PlanetaryDisplay accessor methods (read the published display state,
+// never the engine itself)
+static int displayValue(ACID9Seq* module, int channel, int fallback) {
+    if (!module) return fallback;
+    decltype(ACID9Seq::displayState)::Frame frame;
+    if (!module->displayState.latest(frame)) return fallback;
+    return static_cast<int>(frame.min[channel]);
+}
+
 int PlanetaryDisplay::getGearAPosition() {
-    if (!module) return 0;
-    return static_cast<ACID9Seq*>(module)->engine.getGearA().getPosition();
+    return displayValue(module, ACID9Seq::DISPLAY_GEAR_A_POS, 0);
 }
 
 int PlanetaryDisplay::getGearBPosition() {
-    if (!module) return 0;
-    return static_cast<ACID9Seq*>(module)->engine.getGearB().getPosition();
+    return displayValue(module, ACID9Seq::DISPLAY_GEAR_B_POS, 0);
 }
 
 int PlanetaryDisplay::getGearBLength() {
-    if (!module) return 7;
-    return static_cast<ACID9Seq*>(module)->engine.getGearBLength();
+    return displayValue(module, ACID9Seq::DISPLAY_GEAR_B_LEN, 7);
 }
 
 int PlanetaryDisplay::getQuantizedPitch() {
-    if (!module) return 12;
-    return static_cast<ACID9Seq*>(module)->engine.getQuantizedPitch();
+    return displayValue(module, ACID9Seq::DISPLAY_PITCH, 12);
 }
 
 struct ACID9SeqWidget : ModuleWidget {
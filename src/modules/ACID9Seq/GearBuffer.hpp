@@ -3,6 +3,7 @@
 #include "rack.hpp"
 #include <vector>
 #include <random>
+#include "Random.hpp"
 #include <cstdint>
 #include <algorithm>
 
@@ -109,7 +110,7 @@ public:
     }
 
     // Randomize all values
-    void randomize(std::mt19937& rng) {
+    void randomize(Pcg32& rng) {
         for (int i = 0; i < length_; i++) {
             data_[i] = generateRandomValue(rng);
         }
@@ -257,12 +258,11 @@ private:
         }
     }
 
-    int generateRandomValue(std::mt19937& rng) const {
+    int generateRandomValue(Pcg32& rng) const {
         switch (type_) {
             case DataType::PITCH: {
                 // Favor common scale degrees (pentatonic-ish distribution)
-                std::uniform_int_distribution<int> dist(0, 24);
-                return dist(rng);
+                return rng.range(0, 24);
             }
             case DataType::OFFSET: {
                 // Favor smaller offsets
@@ -271,8 +271,7 @@ private:
                 return std::min(std::max(val, -12), 12);
             }
             case DataType::GATE: {
-                std::uniform_int_distribution<int> dist(0, 1);
-                return dist(rng);
+                return static_cast<int>(rng.below(2));
             }
             default:
                 return 0;
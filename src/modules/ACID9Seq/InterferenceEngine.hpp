@@ -2,8 +2,12 @@
 
 #include "rack.hpp"
 #include "GearBuffer.hpp"
-#include <random>
+#include "LogicEngine.hpp"
+#include "Random.hpp"
+#include "ScaleQuantizer.hpp"
 #include <cmath>
+#include <cstdint>
+#include <numeric>
 
 namespace WiggleRoom {
 
@@ -15,32 +19,40 @@ namespace WiggleRoom {
  * - Gear B (Modifier): Variable-length offset pattern (harmonic variation)
  *
  * Output pitch = quantize(GearA[i] + GearB[j], scaleMask)
+ *
+ * The gears only interact through their positions, so the output repeats
+ * every lcm(lengthA, lengthB) clocks (16 * lengthB for the odd Gear B
+ * lengths). That cycle is precomputed into a table whenever a gear, the
+ * offset, the scale/root or the logic threshold changes: pitch, gear values
+ * and the result of every LogicEngine mode for each step. A clock is then
+ * a table lookup, and jumpTo() can move to any step of the cycle with the
+ * right logic history.
+ *
+ * The logic modes look at the last two pitches, so the first two clocks
+ * after reset(), a rebuild or a frozen Gear B (whose steps leave the cycle)
+ * are evaluated live from the actual history instead.
  */
 class InterferenceEngine {
 public:
-    // Scale definitions (same as TheArchitect)
-    static constexpr int SCALES[] = {
-        0b101011010101,  // Major (Ionian)
-        0b101101010110,  // Minor (Aeolian)
-        0b101101011010,  // Dorian
-        0b110101011010,  // Phrygian
-        0b101011010110,  // Lydian
-        0b101011011010,  // Mixolydian
-        0b110101101010,  // Locrian
-        0b101101010101,  // Harmonic Minor
-        0b101011010110,  // Melodic Minor
-        0b101010110101,  // Pentatonic Major
-        0b100101010010,  // Pentatonic Minor
-        0b101010101010,  // Whole Tone
-        0b111111111111   // Chromatic
-    };
-
+    // Scale index N selects Scales::MASKS[Scales::LEGACY_13[N]] (the 13
+    // scales TheArchitect offered before its list grew)
     static constexpr int NUM_SCALES = 13;
 
     // Valid lengths for Gear B (prime numbers for interesting interference)
     static constexpr int GEAR_B_LENGTHS[] = {3, 5, 7, 9, 11, 13};
     static constexpr int NUM_GEAR_B_LENGTHS = 6;
 
+    // Longest cycle: lcm of two lengths up to GearBuffer::MAX_STEPS
+    static constexpr int MAX_CYCLE = GearBuffer::MAX_STEPS * GearBuffer::MAX_STEPS;
+
+    // One step of the interference cycle
+    struct CycleStep {
+        int8_t pitch;       // Quantized pitch in semitones
+        int8_t gearA;       // Gear A value
+        int8_t gearB;       // Gear B offset (phase offset applied)
+        uint32_t logic;     // Bit per LogicEngine::Mode
+    };
+
     InterferenceEngine()
         : gearA_(16, GearBuffer::DataType::PITCH)
         , gearB_(7, GearBuffer::DataType::OFFSET)
@@ -48,19 +60,24 @@ public:
         , frozen_(false)
         , root_(0)
         , scaleIndex_(0)
-        , scaleMask_(SCALES[0])
+        , scaleMask_(Scales::MASKS[Scales::LEGACY_13[0]])
         , useScaleBus_(false)
-        , rng_(std::random_device{}())
     {
+        applyScale(scaleMask_, root_);
+
         // Initialize Gear A with a default melodic pattern
         initializeGearA();
 
         // Initialize Gear B with some offsets
         initializeGearB();
+
+        rebuildCycle();
     }
 
     // Process one clock tick
     void onClock() {
+        if (cycleDirty_) rebuildCycle();
+
         // Store previous values for logic engine
         prevGearAValue_ = gearA_.getPitch();
         prevGearBOffset_ = getCurrentGearBOffset();
@@ -72,15 +89,32 @@ public:
             gearB_.advance();
         }
 
-        // Calculate raw pitch (sum of Gear A and Gear B with offset)
-        int rawPitch = gearA_.getPitch() + getCurrentGearBOffset();
-
         // Store previous pitch for logic engine
         prevPrevPitch_ = prevPitch_;
         prevPitch_ = quantizedPitch_;
 
-        // Quantize to scale
-        quantizedPitch_ = quantizeToScale(rawPitch);
+        int step = cycleIndex_[gearA_.getPosition()][gearB_.getPosition()];
+        if (frozen_ || step < 0) {
+            historySteps_ = 0;
+        }
+
+        if (historySteps_ >= 2) {
+            // Last two steps came from this cycle: playback
+            const CycleStep& entry = cycle_[step];
+            quantizedPitch_ = entry.pitch;
+            logicMask_ = entry.logic;
+        } else {
+            // Quantize the sum of Gear A and Gear B (with offset) to scale
+            int rawPitch = gearA_.getPitch() + getCurrentGearBOffset();
+            quantizedPitch_ = quantizeToScale(rawPitch);
+            logicMask_ = evaluateLogic(quantizedPitch_, prevPitch_, prevPrevPitch_,
+                                       gearA_.getPitch(), prevGearAValue_,
+                                       getCurrentGearBOffset(), prevGearBOffset_);
+        }
+
+        if (!frozen_ && step >= 0) {
+            historySteps_ = std::min(historySteps_ + 1, 2);
+        }
     }
 
     // Reset all gears to position 0
@@ -92,6 +126,62 @@ public:
         quantizedPitch_ = 12;
         prevGearAValue_ = 12;
         prevGearBOffset_ = 0;
+        logicMask_ = 0;
+        historySteps_ = 0;
+    }
+
+    /**
+     * Move both gears to a step of the cycle (0 = both at position 0)
+     *
+     * Pitch and logic history are taken from the table, so the next clocks
+     * continue exactly as if the sequence had played up to that step.
+     */
+    void jumpTo(int step) {
+        if (cycleDirty_) rebuildCycle();
+        int k = ((step % cycleLength_) + cycleLength_) % cycleLength_;
+        const CycleStep& entry = cycle_[k];
+        const CycleStep& prev = cycle_[(k + cycleLength_ - 1) % cycleLength_];
+        const CycleStep& prevPrev = cycle_[(k + 2 * cycleLength_ - 2) % cycleLength_];
+
+        gearA_.setPosition(k % gearA_.getLength());
+        gearB_.setPosition(k % gearB_.getLength());
+        quantizedPitch_ = entry.pitch;
+        prevPitch_ = prev.pitch;
+        prevPrevPitch_ = prevPrev.pitch;
+        prevGearAValue_ = prev.gearA;
+        prevGearBOffset_ = prev.gearB;
+        logicMask_ = entry.logic;
+        historySteps_ = 2;
+    }
+
+    // Cycle table, e.g. to show the upcoming phrase (rebuilt on the next clock
+    // after a change)
+    int getCycleLength() const {
+        return cycleLength_;
+    }
+
+    const CycleStep& getCycleStep(int step) const {
+        return cycle_[step];
+    }
+
+    // Index of the current gear positions in the cycle (-1 if unreachable,
+    // e.g. after freezing Gear B with an even length)
+    int getCycleIndex() const {
+        return cycleIndex_[gearA_.getPosition()][gearB_.getPosition()];
+    }
+
+    // Set the LEAP/STEP interval threshold (semitones)
+    void setThreshold(int threshold) {
+        if (threshold == threshold_) return;
+        threshold_ = threshold;
+        cycleDirty_ = true;
+    }
+
+    // Current step's LogicEngine mode, gated by probability
+    bool evaluateWithProb(int modeIndex, float probability, float randomValue) const {
+        if (modeIndex < 0 || modeIndex >= LogicEngine::NUM_MODES_INT) return false;
+        if (!(logicMask_ & (1u << modeIndex))) return false;
+        return randomValue < probability;
     }
 
     // Get current quantized pitch as V/Oct (0V = C4)
@@ -145,7 +235,9 @@ public:
     // Set Gear B length (uses predefined prime lengths)
     void setGearBLengthIndex(int index) {
         index = std::min(std::max(index, 0), NUM_GEAR_B_LENGTHS - 1);
+        if (GEAR_B_LENGTHS[index] == gearB_.getLength()) return;
         gearB_.setLength(GEAR_B_LENGTHS[index]);
+        cycleDirty_ = true;
     }
 
     // Get current Gear B length
@@ -155,7 +247,10 @@ public:
 
     // Set phase offset for Gear B
     void setOffset(int off) {
-        offset_ = off % 16;
+        off %= 16;
+        if (off == offset_) return;
+        offset_ = off;
+        cycleDirty_ = true;
     }
 
     // Freeze/unfreeze Gear B rotation
@@ -166,13 +261,17 @@ public:
     // Set root note (0-11)
     void setRoot(int root) {
         root_ = std::min(std::max(root, 0), 11);
+        if (!useScaleBus_) {
+            applyScale(scaleMask_, root_);
+        }
     }
 
     // Set scale by index (0-12)
     void setScale(int scaleIdx) {
         scaleIndex_ = std::min(std::max(scaleIdx, 0), NUM_SCALES - 1);
         if (!useScaleBus_) {
-            scaleMask_ = SCALES[scaleIndex_];
+            scaleMask_ = Scales::MASKS[Scales::LEGACY_13[scaleIndex_]];
+            applyScale(scaleMask_, root_);
         }
     }
 
@@ -180,7 +279,8 @@ public:
     void updateFromScaleBus(const float* voltages, int channels) {
         if (channels < 12) {
             useScaleBus_ = false;
-            scaleMask_ = SCALES[scaleIndex_];
+            scaleMask_ = Scales::MASKS[Scales::LEGACY_13[scaleIndex_]];
+            applyScale(scaleMask_, root_);
             return;
         }
 
@@ -202,16 +302,21 @@ public:
             if (rootNote < 0) rootNote += 12;
             root_ = rootNote;
         }
+
+        // Bus channels are absolute pitch classes, so no root rotation
+        applyScale(mask, 0);
     }
 
     // Randomize Gear A
     void mutateGearA() {
         gearA_.randomize(rng_);
+        cycleDirty_ = true;
     }
 
     // Randomize Gear B
     void mutateGearB() {
         gearB_.randomize(rng_);
+        cycleDirty_ = true;
     }
 
     // Access to gears for visualization
@@ -241,6 +346,8 @@ public:
 
         json_t* offsetJ = json_object_get(rootJ, "offset");
         if (offsetJ) offset_ = (int)json_integer_value(offsetJ);
+
+        cycleDirty_ = true;
     }
 
 private:
@@ -254,14 +361,26 @@ private:
     int scaleIndex_;    // Fallback scale index
     int scaleMask_;     // Active scale mask
     bool useScaleBus_;  // Using external scale bus
+    ScaleQuantizer quantizer_;
+    int quantizerMask_ = -1;    // Scale the quantizer was last set to
+    int quantizerRoot_ = -1;
 
     int quantizedPitch_ = 12;   // Current quantized pitch
     int prevPitch_ = 12;        // Previous pitch
     int prevPrevPitch_ = 12;    // Pitch before previous
     int prevGearAValue_ = 12;   // Previous Gear A value
     int prevGearBOffset_ = 0;   // Previous Gear B offset
+    uint32_t logicMask_ = 0;    // Current step's LogicEngine results
+
+    // Interference cycle
+    CycleStep cycle_[MAX_CYCLE] = {};
+    int cycleIndex_[GearBuffer::MAX_STEPS][GearBuffer::MAX_STEPS];  // (posA, posB) -> step, -1 = unreachable
+    int cycleLength_ = 1;
+    bool cycleDirty_ = true;
+    int historySteps_ = 0;      // Consecutive clocks in the current cycle (max 2)
+    int threshold_ = 3;         // LEAP/STEP threshold
 
-    std::mt19937 rng_;
+    Pcg32 rng_;
 
     void initializeGearA() {
         // Initialize with a simple melodic pattern (in semitones)
@@ -286,52 +405,62 @@ private:
         }
     }
 
-    // Quantize pitch to scale
-    int quantizeToScale(int pitch) {
-        // Clamp to valid range
-        pitch = std::min(std::max(pitch, 0), 36);
+    void applyScale(int mask, int root) {
+        if (mask == quantizerMask_ && root == quantizerRoot_) return;
+        quantizerMask_ = mask;
+        quantizerRoot_ = root;
+        quantizer_.setScale(mask, root);
+        cycleDirty_ = true;
+    }
 
-        // Get octave and note within octave
-        int octave = pitch / 12;
-        int note = pitch % 12;
+    uint32_t evaluateLogic(int pitch, int prevPitch, int prevPrevPitch,
+                           int gearA, int prevGearA, int gearB, int prevGearB) const {
+        LogicEngine logic;
+        logic.update(pitch, prevPitch, prevPrevPitch, gearA, prevGearA, gearB, prevGearB);
+        uint32_t mask = 0;
+        for (int m = 0; m < LogicEngine::NUM_MODES_INT; m++) {
+            if (logic.evaluate(m, threshold_)) mask |= 1u << m;
+        }
+        return mask;
+    }
 
-        // Transpose relative to root
-        int relNote = (note - root_ + 12) % 12;
+    // Gear values at cycle step k, then the logic with the cycle's own history
+    void rebuildCycle() {
+        int lengthA = gearA_.getLength();
+        int lengthB = gearB_.getLength();
+        cycleLength_ = std::lcm(lengthA, lengthB);
 
-        // Check if note is in scale
-        if ((scaleMask_ >> relNote) & 1) {
-            return pitch;
+        for (auto& row : cycleIndex_) {
+            std::fill(std::begin(row), std::end(row), -1);
         }
-
-        // Find nearest note in scale (prefer lower)
-        for (int off = 1; off <= 6; off++) {
-            int lower = (relNote - off + 12) % 12;
-            int upper = (relNote + off) % 12;
-
-            if ((scaleMask_ >> lower) & 1) {
-                int newNote = (note - off + 12);
-                if (newNote < 0) {
-                    newNote += 12;
-                    if (octave > 0) octave--;
-                }
-                return octave * 12 + (newNote % 12);
-            }
-            if ((scaleMask_ >> upper) & 1) {
-                int newNote = note + off;
-                if (newNote >= 12) {
-                    newNote -= 12;
-                    octave++;
-                }
-                return octave * 12 + newNote;
-            }
+        for (int k = 0; k < cycleLength_; k++) {
+            int posB = k % lengthB;
+            int gearA = gearA_.getValueAt(k % lengthA);
+            int gearB = gearB_.getValueAt((posB + offset_) % lengthB);
+            cycle_[k].gearA = static_cast<int8_t>(gearA);
+            cycle_[k].gearB = static_cast<int8_t>(gearB);
+            cycle_[k].pitch = static_cast<int8_t>(quantizeToScale(gearA + gearB));
+            cycleIndex_[k % lengthA][posB] = k;
+        }
+        for (int k = 0; k < cycleLength_; k++) {
+            const CycleStep& prev = cycle_[(k + cycleLength_ - 1) % cycleLength_];
+            const CycleStep& prevPrev = cycle_[(k + 2 * cycleLength_ - 2) % cycleLength_];
+            cycle_[k].logic = evaluateLogic(cycle_[k].pitch, prev.pitch, prevPrev.pitch,
+                                            cycle_[k].gearA, prev.gearA, cycle_[k].gearB, prev.gearB);
         }
 
-        return pitch;  // Fallback
+        cycleDirty_ = false;
+        historySteps_ = 0;
+    }
+
+    // Quantize pitch to scale (nearest note, ties go lower)
+    int quantizeToScale(int pitch) const {
+        pitch = std::min(std::max(pitch, 0), 36);
+        return quantizer_.quantizeNote(pitch);
     }
 };
 
 // Need to define constexpr array outside class for linkage
-constexpr int InterferenceEngine::SCALES[];
 constexpr int InterferenceEngine::GEAR_B_LENGTHS[];
 
 } // namespace WiggleRoom
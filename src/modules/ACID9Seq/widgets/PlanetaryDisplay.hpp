@@ -13,8 +13,11 @@
  * - Outer ring: 16 LEDs for Gear A (pitch)
  * - Middle ring: Variable LEDs for Gear B (offset)
  * - Center: Current note name with optional animation
+ *
+ * The rings and note are cached and only re-rendered when a playhead, the
+ * note or the alignment flash changes.
  */
-struct PlanetaryDisplay : rack::widget::Widget {
+struct PlanetaryDisplay : CachedDisplay<> {
     ACID9Seq* module = nullptr;
 
     // Colors
@@ -39,7 +42,32 @@ struct PlanetaryDisplay : rack::widget::Widget {
         box.size = rack::Vec(100, 100);
     }
 
-    void draw(const DrawArgs& args) override {
+    void step() override {
+        if (module) {
+            // Flash when both playheads return to position 0
+            bool aligned = (getGearAPosition() == 0 && getGearBPosition() == 0);
+            if (aligned && !wasAligned) {
+                flashAlpha = 1.0f;
+            }
+            wasAligned = aligned;
+
+            // Decay flash
+            flashAlpha *= 0.95f;
+            if (flashAlpha < 0.01f) flashAlpha = 0.0f;
+        }
+        CachedDisplay::step();
+    }
+
+    uint64_t dataGeneration() override {
+        if (!module) return 0;
+        uint64_t key = mix(0, getGearAPosition());
+        key = mix(key, getGearBPosition());
+        key = mix(key, getGearBLength());
+        key = mix(key, getQuantizedPitch());
+        return mix(key, flashAlpha);
+    }
+
+    void drawStatic(const DrawArgs& args) override {
         // Background circle
         float cx = box.size.x / 2;
         float cy = box.size.y / 2;
@@ -56,9 +84,7 @@ struct PlanetaryDisplay : rack::widget::Widget {
         nvgStroke(args.vg);
     }
 
-    void drawLayer(const DrawArgs& args, int layer) override {
-        if (layer != 1) return;
-
+    void drawDynamic(const DrawArgs& args) override {
         float cx = box.size.x / 2;
         float cy = box.size.y / 2;
         float outerRadius = std::min(cx, cy) - 4;
@@ -76,16 +102,6 @@ struct PlanetaryDisplay : rack::widget::Widget {
         int gearBLen = getGearBLength();
         int quantizedPitch = getQuantizedPitch();
 
-        // Check for alignment (both playheads at position 0)
-        bool aligned = (gearAPos == 0 && gearBPos == 0);
-        if (aligned && !wasAligned) {
-            flashAlpha = 1.0f;
-        }
-        wasAligned = aligned;
-
-        // Decay flash
-        flashAlpha *= 0.95f;
-
         // Draw Gear A ring (outer)
         float gearARadius = outerRadius - 5;
         drawGearRing(args, cx, cy, gearARadius, gearALen, gearAPos,
@@ -106,8 +122,6 @@ struct PlanetaryDisplay : rack::widget::Widget {
             nvgFillColor(args.vg, nvgRGBA(0xff, 0xff, 0xff, (int)(flashAlpha * 60)));
             nvgFill(args.vg);
         }
-
-        Widget::drawLayer(args, layer);
     }
 
 private:
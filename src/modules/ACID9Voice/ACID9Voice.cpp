@@ -12,6 +12,7 @@
  * - Insert loop (send/return)
  * - Stereo delay with clock sync and ghost mode
  * - Slide (portamento) control
+ * - Analytic or band-limited wavetable oscillator engine
  *
  * Part of the WiggleRoom VCV Rack plugin
  ******************************************************************************/
@@ -19,11 +20,32 @@
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include "MorphWavetable.hpp"
+#include <atomic>
+#include <cstring>
+
+// The full voice and the chain after the oscillator are generated from
+// acid9voice.dsp as separate DSPs (faust -pn, see CMakeLists.txt), so two
+// Faust headers share this translation unit
+#define FAUST_NO_GLOBAL_ALIAS
+
 #define FAUST_MODULE_NAME ACID9Voice
-#include "acid9voice.hpp"  // Generated by Faust
+#include "acid9voice.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ACID9VoiceChain
+#include "acid9voice_chain.hpp"
+
+#include "acid9voice_params.hpp"
+#include "acid9voice_chain_params.hpp"
 
 using namespace rack;
 
+using VoiceDSP = FaustGenerated::NS_ACID9Voice::VCVRackDSP;
+using ChainDSP = FaustGenerated::NS_ACID9VoiceChain::VCVRackDSP;
+
+namespace FP = FaustParams::acid9voice;
+namespace FP_CHAIN = FaustParams::acid9voice_chain;
+
 extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
@@ -36,6 +58,11 @@ namespace WiggleRoom {
  * Signal Flow:
  *   Tri-Core Osc + Sub -> Grit -> Filter -> VCA -> Insert Loop -> Delay -> Output
  *
+ * The analytic engine is the full Faust voice (acid9voice), the
+ * FaustModule DSP, so oversampling covers its oscillator too. The
+ * wavetable engine bypasses it: TriCoreWavetable feeds the rest of the
+ * voice (acid9voice_chain) at the engine rate.
+ *
  * Inputs:
  *   - V/OCT: Pitch control (0V = C4)
  *   - GATE: Note on/off
@@ -53,7 +80,7 @@ namespace WiggleRoom {
  *   - LEFT/RIGHT: Main stereo output
  *   - SEND: Insert loop send (post-VCA, pre-delay)
  */
-struct ACID9Voice : FaustModule<VCVRackDSP> {
+struct ACID9Voice : FaustModule<VoiceDSP> {
     enum ParamId {
         // Oscillator section
         SHAPE_PARAM,
@@ -100,6 +127,31 @@ struct ACID9Voice : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    enum OscEngine {
+        ENGINE_ANALYTIC,
+        ENGINE_WAVETABLE
+    };
+
+    // Oscillator engines (menu selection applied on the audio thread)
+    std::atomic<int> oscEngine{ENGINE_ANALYTIC};
+    int activeEngine = ENGINE_ANALYTIC;
+    TriCoreWavetable wavetableOsc;     // Tables attached by setOscEngine()
+
+    // Wavetable engine: the chain after the oscillator, with its params
+    // copied from faustDsp (chainParamVoice[i]: the voice index of chain
+    // param i)
+    ChainDSP chainDsp;
+    int chainParamVoice[FP_CHAIN::NUM_PARAMS] = {};
+    float chainIn[2] = {};
+    float chainOut[3] = {};
+    float* chainInPtrs[2] = {&chainIn[0], &chainIn[1]};
+    float* chainOutPtrs[3] = {&chainOut[0], &chainOut[1], &chainOut[2]};
+
+    // Wavetable engine pitch: acid9voice.dsp's slide smoother (ba.tau2pole
+    // of 1 ms, or 60 ms with slide high)
+    float pitchVolts = 0.f;
+    float slidePoles[2] = {};
+
     // Clock tracking for delay sync
     float lastClockVoltage = 0.f;
     float clockPeriodSamples = 0.f;
@@ -151,21 +203,119 @@ struct ACID9Voice : FaustModule<VCVRackDSP> {
         // Light
         configLight(FILTER_MODE_LIGHT, "Filter Mode (ACID/LEAD)");
 
-        // Faust parameter indices (ALPHABETICAL ORDER):
-        // NOTE: delay_ratio was optimized out by Faust (defined but unused)
-        // accent=0, cutoff=1, cutoff_cv=2, decay=3, delay_fb=4, delay_ghost=5,
-        // delay_mix=6, delay_time=7, env_mod=8, filter_mode=9, fm_in=10,
-        // gate=11, grit=12, isotope=13, resonance=14, return_connected=15,
-        // return_in_l=16, return_in_r=17, shape=18, slide=19, sub_level=20,
-        // sub_mode=21, volts=22
-
         // Map VCV params to Faust params (not using mapParam for complex CV handling)
+
+        // Grit saturation and the oscillator alias; the delay buffer
+        // (192000 samples) only covers the 2 s maximum delay at 2x of 48 kHz
+        enableOversampling(2);
+
+        mapChainParams();
+    }
+
+    // The chain's params by path (the -pn entry points number them apart)
+    void mapChainParams() {
+        for (int i = 0; i < FP_CHAIN::NUM_PARAMS; i++) {
+            for (int v = 0; v < FP::NUM_PARAMS; v++) {
+                if (std::strcmp(FP_CHAIN::PARAMS[i].path, FP::PARAMS[v].path) == 0) {
+                    chainParamVoice[i] = v;
+                    break;
+                }
+            }
+        }
+    }
+
+    void initChain(float sampleRate) {
+        int rate = static_cast<int>(sampleRate);
+        if (chainDsp.getSampleRate() == 0) {
+            chainDsp.init(rate);
+        } else {
+            chainDsp.setSampleRate(rate);
+        }
+        wavetableOsc.setSampleRate(sampleRate);
+        slidePoles[0] = std::exp(-1.f / (0.001f * sampleRate));
+        slidePoles[1] = std::exp(-1.f / (0.06f * sampleRate));
+    }
+
+    /**
+     * Select the oscillator engine (UI thread: menu or patch load)
+     *
+     * The wavetables are rendered here the first time the wavetable engine
+     * is chosen, before the audio thread can see the new engine.
+     */
+    void setOscEngine(int engine) {
+        if (engine == ENGINE_WAVETABLE) {
+            if (!wavetableOsc.hasTable()) {
+                wavetableOsc.setTable(MorphWavetable::shared());
+            }
+            oscEngine.store(ENGINE_WAVETABLE, std::memory_order_release);
+        } else {
+            oscEngine.store(ENGINE_ANALYTIC, std::memory_order_release);
+        }
+    }
+
+    int getOscEngine() const {
+        return oscEngine;
+    }
+
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        FaustModule<VoiceDSP>::onSampleRateChange(e);
+        initChain(e.sampleRate);
+    }
+
+    void onReset() override {
+        FaustModule<VoiceDSP>::onReset();
+        chainDsp.instanceClear();
+        wavetableOsc.reset();
+        pitchVolts = 0.f;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustModule<VoiceDSP>::dataToJson();
+        json_object_set_new(rootJ, "oscEngine", json_integer(getOscEngine()));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        FaustModule<VoiceDSP>::dataFromJson(rootJ);
+        json_t* engineJ = json_object_get(rootJ, "oscEngine");
+        if (engineJ) setOscEngine(static_cast<int>(json_integer_value(engineJ)));
+    }
+
+    /**
+     * One frame of the wavetable engine: TriCoreWavetable into the chain,
+     * which takes its params from faustDsp. The chain starts from silence
+     * when the engine is switched to.
+     */
+    void computeWavetableFrame(float voct, float fmIn, float slide, float shape, float isotope,
+                               float subLevel, float subMode, float* out) {
+        if (activeEngine != ENGINE_WAVETABLE) {
+            chainDsp.instanceClear();
+            wavetableOsc.reset();
+            pitchVolts = voct;
+        }
+
+        {
+            WR_PROFILE_SCOPE(profile, "osc");
+            float pole = slidePoles[slide > 0.9f ? 1 : 0];
+            pitchVolts = voct + (pitchVolts - voct) * pole;
+            float freq = clamp(261.62f * DSP::fastExp2(pitchVolts + fmIn * 0.1f), 20.f, 20000.f);
+            wavetableOsc.process(freq, shape, isotope, subLevel, subMode > 0.5f, chainIn[0], chainIn[1]);
+        }
+
+        for (int i = 0; i < FP_CHAIN::NUM_PARAMS; i++) {
+            chainDsp.setParamValue(i, faustDsp.getParamValue(chainParamVoice[i]));
+        }
+        computeDsp(chainDsp, 1, chainInPtrs, chainOutPtrs);
+        for (int i = 0; i < 3; i++) out[i] = chainOut[i];
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
+            initChain(args.sampleRate);
             initialized = true;
         }
 
@@ -244,37 +394,42 @@ struct ACID9Voice : FaustModule<VCVRackDSP> {
             actualDelayTime = clamp(actualDelayTime, 10.f, 2000.f);
         }
 
-        // Set Faust parameters (alphabetical order - delay_ratio optimized out!)
-        faustDsp.setParamValue(0, accent);           // accent
-        faustDsp.setParamValue(1, cutoff);           // cutoff
-        faustDsp.setParamValue(2, cutoffCV);         // cutoff_cv
-        faustDsp.setParamValue(3, decayFinal);        // decay (with CV)
-        faustDsp.setParamValue(4, delayFb);          // delay_fb
-        faustDsp.setParamValue(5, delayGhost);       // delay_ghost
-        faustDsp.setParamValue(6, delayMix);         // delay_mix
-        faustDsp.setParamValue(7, actualDelayTime);  // delay_time
-        faustDsp.setParamValue(8, envMod);           // env_mod
-        faustDsp.setParamValue(9, filterMode);       // filter_mode
-        faustDsp.setParamValue(10, fmIn);            // fm_in
-        faustDsp.setParamValue(11, gate);            // gate
-        faustDsp.setParamValue(12, grit);            // grit
-        faustDsp.setParamValue(13, isotopeFinal);     // isotope (with CV)
-        faustDsp.setParamValue(14, resonance);       // resonance
-        faustDsp.setParamValue(15, returnConnected); // return_connected
-        faustDsp.setParamValue(16, returnL);         // return_in_l
-        faustDsp.setParamValue(17, returnR);         // return_in_r
-        faustDsp.setParamValue(18, shapeFinal);       // shape (with CV)
-        faustDsp.setParamValue(19, slide);           // slide
-        faustDsp.setParamValue(20, subLevel);        // sub_level
-        faustDsp.setParamValue(21, subMode);         // sub_mode
-        faustDsp.setParamValue(22, voct);            // volts
-
-        // Process audio (no input, 3 outputs: L, R, Send)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f, outputSend = 0.0f;
-        float* outputPtrs[3] = { &outputL, &outputR, &outputSend };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        // Set Faust parameters (shape and isotope with CV)
+        faustDsp.setParamValue(FP::ACCENT, accent);
+        faustDsp.setParamValue(FP::CUTOFF, cutoff);
+        faustDsp.setParamValue(FP::CUTOFF_CV, cutoffCV);
+        faustDsp.setParamValue(FP::DECAY, decayFinal);  // with CV
+        faustDsp.setParamValue(FP::DELAY_FB, delayFb);
+        faustDsp.setParamValue(FP::DELAY_GHOST, delayGhost);
+        faustDsp.setParamValue(FP::DELAY_MIX, delayMix);
+        faustDsp.setParamValue(FP::DELAY_TIME, actualDelayTime);
+        faustDsp.setParamValue(FP::ENV_MOD, envMod);
+        faustDsp.setParamValue(FP::FILTER_MODE, filterMode);
+        faustDsp.setParamValue(FP::FM_IN, fmIn);
+        faustDsp.setParamValue(FP::GATE, gate);
+        faustDsp.setParamValue(FP::GRIT, grit);
+        faustDsp.setParamValue(FP::ISOTOPE, isotopeFinal);
+        faustDsp.setParamValue(FP::RESONANCE, resonance);
+        faustDsp.setParamValue(FP::RETURN_CONNECTED, returnConnected);
+        faustDsp.setParamValue(FP::RETURN_IN_L, returnL);
+        faustDsp.setParamValue(FP::RETURN_IN_R, returnR);
+        faustDsp.setParamValue(FP::SHAPE, shapeFinal);
+        faustDsp.setParamValue(FP::SLIDE, slide);
+        faustDsp.setParamValue(FP::SUB_LEVEL, subLevel);
+        faustDsp.setParamValue(FP::SUB_MODE, subMode);
+        faustDsp.setParamValue(FP::VOLTS, voct);
+
+        // 3 outputs: L, R, Send
+        float frameOut[3] = {};
+        int engine = oscEngine.load(std::memory_order_acquire);
+        if (engine == ENGINE_WAVETABLE) {
+            computeWavetableFrame(voct, fmIn, slide, shapeFinal, isotopeFinal, subLevel, subMode, frameOut);
+        } else {
+            if (activeEngine != ENGINE_ANALYTIC) clearState();
+            computeFrame(nullptr, frameOut);
+        }
+        activeEngine = engine;
+        float outputL = frameOut[0], outputR = frameOut[1], outputSend = frameOut[2];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -366,6 +521,18 @@ struct ACID9VoiceWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(Vec(col5, outputY), module, ACID9Voice::LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(Vec(col6, outputY), module, ACID9Voice::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<ACID9Voice*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        menu->addChild(createIndexSubmenuItem("Oscillator engine", {"Analytic", "Wavetable (band-limited)"},
+            [=]() { return (size_t)m->getOscEngine(); },
+            [=](size_t index) { m->setOscEngine(static_cast<int>(index)); }
+        ));
+        appendOversamplingMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -94,8 +94,12 @@ final_cutoff = max(20, min(cv_mod + env_mod_hz, 20000));
 
 pwm = 0.5;
 
-// Generate stereo oscillator signal (attenuated to prevent downstream clipping)
-osc_stereo = tri_core_osc(freq, shape, pwm, isotope, sub_level, sub_mode) : (*(0.6), *(0.6));
+// Stereo tri-core oscillator (the module's analytic engine). Its wavetable
+// engine (MorphWavetable.hpp) replaces this stage and feeds voice_chain
+osc_voice = tri_core_osc(freq, shape, pwm, isotope, sub_level, sub_mode);
+
+// Attenuate the oscillator to prevent downstream clipping
+osc_gain_stereo = *(0.6), *(0.6);
 
 // Grit saturation (stereo)
 grit_stereo(l, r) = grit_sat(grit, l), grit_sat(grit, r);
@@ -148,5 +152,9 @@ output_stereo(l, r, send) = (l * output_gain : fi.dcblocker : ma.tanh),
                             (r * output_gain : fi.dcblocker : ma.tanh),
                             (send * output_gain);
 
-// Main process: chain all stages
-process = osc_stereo : grit_stereo : filter_stereo : vca_stereo : insert_stereo : delay_stereo : output_stereo;
+// Everything after the oscillator: stereo oscillator in, L/R/send out.
+// Generated alone (-pn voice_chain) for the wavetable engine
+voice_chain = osc_gain_stereo : grit_stereo : filter_stereo : vca_stereo : insert_stereo : delay_stereo : output_stereo;
+
+// Main process: chain all stages (the module's oversampled DSP)
+process = osc_voice : voice_chain;
@@ -0,0 +1,21 @@
+// Test wrapper for acid_delay.lib
+import("stdfaust.lib");
+a9_ad = library("acid_delay.lib");
+
+// Test controls
+time = hslider("time", 250, 10, 2000, 1) : si.smoo;
+feedback = hslider("feedback", 0.5, 0, 0.95, 0.01);
+mix = hslider("mix", 0.5, 0, 1, 0.01);
+ghost = hslider("ghost", 0.5, 0, 1, 0.01) : si.smoo;
+ping_pong = hslider("ping_pong", 0, 0, 1, 1);
+
+// Gate for test impulses
+gate = hslider("gate", 0, 0, 10, 0.01);
+trig = (gate > 0.9) & (gate' <= 0.9);
+
+// Test signal: short saw blip when gate triggers
+blip_env = en.ar(0.001, 0.08, trig);
+test_signal = os.sawtooth(220) * blip_env;
+
+// Stereo delay with ghost trails
+process = test_signal <: a9_ad.stereo_delay(time, feedback, mix, ghost, ping_pong);
@@ -0,0 +1,15 @@
+// Test wrapper for acid_filter.lib
+import("stdfaust.lib");
+a9_af = library("acid_filter.lib");
+
+// Test controls
+cutoff = hslider("cutoff", 800, 20, 15000, 1) : si.smoo;
+resonance = hslider("resonance", 0.6, 0, 0.99, 0.01) : si.smoo;
+mode = hslider("mode", 0, 0, 1, 0.01);
+grit = hslider("grit", 0.3, 0, 1, 0.01);
+
+// Test signal (sawtooth for rich harmonics)
+test_signal = os.sawtooth(110);
+
+// Grit into the dual ACID / LEAD filter, as in the voice
+process = test_signal : a9_af.grit_sat(grit) : a9_af.dual_filter(cutoff, resonance, mode) <: _, _;
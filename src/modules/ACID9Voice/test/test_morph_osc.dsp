@@ -0,0 +1,11 @@
+// Test wrapper for morph_osc.lib
+import("stdfaust.lib");
+a9_mo = library("morph_osc.lib");
+
+// Test controls
+freq = hslider("freq", 110, 20, 2000, 1);
+shape = hslider("shape", 0.5, 0, 1, 0.01) : si.smoo;
+pwm = hslider("pwm", 0.5, 0.05, 0.95, 0.01) : si.smoo;
+
+// Stereo output for testing
+process = a9_mo.morph_osc(freq, shape, pwm) <: _, _;
@@ -0,0 +1,14 @@
+// Test wrapper for tri_core_osc.lib
+import("stdfaust.lib");
+a9_tc = library("tri_core_osc.lib");
+
+// Test controls
+freq = hslider("freq", 110, 20, 2000, 1);
+shape = hslider("shape", 0.5, 0, 1, 0.01) : si.smoo;
+pwm = hslider("pwm", 0.5, 0.05, 0.95, 0.01) : si.smoo;
+isotope = hslider("isotope", 0.5, 0, 1, 0.01);
+sub_level = hslider("sub_level", 0.3, 0, 1, 0.01) : si.smoo;
+sub_mode = hslider("sub_mode", 0, 0, 1, 1);
+
+// Stereo three-oscillator core
+process = a9_tc.tri_core_osc(freq, shape, pwm, isotope, sub_level, sub_mode);
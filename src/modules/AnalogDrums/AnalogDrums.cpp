@@ -8,8 +8,67 @@
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
-#define FAUST_MODULE_NAME AnalogDrums
-#include "analog_drums.hpp"  // Generated by Faust
+#include "BlockNoise.hpp"
+#include <memory>
+
+// Each voice and the master bus are generated from analog_drums.dsp as
+// separate DSPs (faust -pn, see CMakeLists.txt), so several Faust headers
+// share this translation unit
+#define FAUST_NO_GLOBAL_ALIAS
+
+#define FAUST_MODULE_NAME AnalogDrumsMaster
+#include "analog_drums_master.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsBD
+#include "analog_drums_bd.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsSD
+#include "analog_drums_sd.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsLT
+#include "analog_drums_lt.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsMT
+#include "analog_drums_mt.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsHT
+#include "analog_drums_ht.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsCB
+#include "analog_drums_cb.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsCH
+#include "analog_drums_ch.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsOH
+#include "analog_drums_oh.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsCY
+#include "analog_drums_cy.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsCP
+#include "analog_drums_cp.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsMA
+#include "analog_drums_ma.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME AnalogDrumsRS
+#include "analog_drums_rs.hpp"
+
+// Faust parameter indices
+#include "analog_drums_master_params.hpp"
+#include "analog_drums_bd_params.hpp"
+#include "analog_drums_sd_params.hpp"
+#include "analog_drums_lt_params.hpp"
+#include "analog_drums_mt_params.hpp"
+#include "analog_drums_ht_params.hpp"
+#include "analog_drums_cb_params.hpp"
+#include "analog_drums_ch_params.hpp"
+#include "analog_drums_oh_params.hpp"
+#include "analog_drums_cy_params.hpp"
+#include "analog_drums_cp_params.hpp"
+#include "analog_drums_ma_params.hpp"
+#include "analog_drums_rs_params.hpp"
 
 using namespace rack;
 
@@ -17,6 +76,120 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+/**
+ * One independently computed drum voice
+ *
+ * Knob/CV bindings are pushed at control rate. A voice sleeps once its
+ * output has stayed below SILENCE_THRESHOLD with its triggers low for the
+ * hold time, and wakes on any of its triggers (OH also on the CH choke)
+ * or a parameter change (so Faust's si.smoo smoothers have settled before
+ * the next hit). Sleeping only with the triggers low keeps the edge
+ * detector in the .dsp armed.
+ *
+ * compute() has the same signature as a Faust DSP's, so the module runs
+ * voices through FaustModule::computeDsp() like its own DSP. The input is
+ * the module's shared white noise; only the noise voices (BD click, SD
+ * snare wires, CP, MA) have an input to read it.
+ */
+struct DrumVoiceUnit {
+    struct Binding {
+        int vcvParamId;
+        int faustParamIdx;
+        int cvInputId;      // -1 = no CV
+        float cvScale;
+        float minVal;
+        float maxVal;
+        float sent = 0.0f;  // Last value handed to Faust
+    };
+
+    struct Trigger {
+        int vcvInputId;
+        int faustParamIdx;
+    };
+
+    std::vector<Binding> bindings;
+    std::vector<Trigger> triggers;
+    bool awake = true;
+    bool primed = false;    // false = resend every binding
+    int quietSamples = 0;
+
+    virtual ~DrumVoiceUnit() = default;
+
+    virtual void init(int sampleRate) = 0;
+    virtual void setParamValue(int faustParamIdx, float value) = 0;
+    virtual float getParamMin(int faustParamIdx) const = 0;
+    virtual float getParamMax(int faustParamIdx) const = 0;
+    virtual int getNumOutputs() = 0;
+    virtual void compute(int count, float** in, float** out) = 0;
+
+    void bindParam(int vcvParamId, int faustParamIdx, int cvInputId = -1, float cvScale = 0.0f) {
+        bindings.push_back({vcvParamId, faustParamIdx, cvInputId, cvScale,
+                            getParamMin(faustParamIdx), getParamMax(faustParamIdx)});
+    }
+
+    void bindTrigger(int vcvInputId, int faustParamIdx) {
+        triggers.push_back({vcvInputId, faustParamIdx});
+    }
+
+    void wake() {
+        awake = true;
+        quietSamples = 0;
+    }
+};
+
+template<typename FaustDSP>
+struct DrumVoice final : DrumVoiceUnit {
+    FaustDSP dsp;
+
+    // Full init the first time; afterwards only the rate constants are
+    // recomputed (bindings are resent either way, primed = false)
+    void init(int sampleRate) override {
+        if (dsp.getSampleRate() == 0) {
+            dsp.init(sampleRate);
+        } else {
+            dsp.setSampleRate(sampleRate);
+        }
+        primed = false;
+        wake();
+    }
+
+    void setParamValue(int faustParamIdx, float value) override {
+        dsp.setParamValue(faustParamIdx, value);
+    }
+
+    float getParamMin(int faustParamIdx) const override {
+        return dsp.getParamMin(faustParamIdx);
+    }
+
+    float getParamMax(int faustParamIdx) const override {
+        return dsp.getParamMax(faustParamIdx);
+    }
+
+    int getNumOutputs() override {
+        return dsp.getNumOutputs();
+    }
+
+    void compute(int count, float** in, float** out) override {
+        dsp.compute(count, in, out);
+    }
+};
+
+using MasterDSP = FaustGenerated::NS_AnalogDrumsMaster::VCVRackDSP;
+
+namespace FP_MASTER = FaustParams::analog_drums_master;
+namespace FP_BD = FaustParams::analog_drums_bd;
+namespace FP_SD = FaustParams::analog_drums_sd;
+namespace FP_LT = FaustParams::analog_drums_lt;
+namespace FP_MT = FaustParams::analog_drums_mt;
+namespace FP_HT = FaustParams::analog_drums_ht;
+namespace FP_CB = FaustParams::analog_drums_cb;
+namespace FP_CH = FaustParams::analog_drums_ch;
+namespace FP_OH = FaustParams::analog_drums_oh;
+namespace FP_CY = FaustParams::analog_drums_cy;
+namespace FP_CP = FaustParams::analog_drums_cp;
+namespace FP_MA = FaustParams::analog_drums_ma;
+namespace FP_RS = FaustParams::analog_drums_rs;
+
 /**
  * AnalogDrums - Virtual Analog Drum Machine
  *
@@ -28,8 +201,11 @@ namespace WiggleRoom {
  *
  * Circuit bending modifications available on most voices.
  * 13 outputs: 12 individual + master mix
+ *
+ * Each voice is its own DSP instance (DrumVoiceUnit) that sleeps while
+ * idle; the master bus (faustDsp) mixes the 12 voice outputs.
  */
-struct AnalogDrums : FaustModule<VCVRackDSP> {
+struct AnalogDrums : FaustModule<MasterDSP> {
     // Voice indices for organization
     enum Voice {
         BD = 0, SD, LT, MT, HT, CB, CH, OH, CY, CP, MA, RS,
@@ -188,6 +364,21 @@ struct AnalogDrums : FaustModule<VCVRackDSP> {
     float lightValues[NUM_VOICES] = {};
     static constexpr float LIGHT_DECAY = 0.05f;
 
+    // Voice sleep: -100 dBFS for 250 ms
+    static constexpr float SILENCE_THRESHOLD = 1e-5f;
+    static constexpr float SLEEP_HOLD_SECONDS = 0.25f;
+
+    std::unique_ptr<DrumVoiceUnit> voices[NUM_VOICES];
+    BlockNoise noise;   // Shared by the noise voices, as no.noise is in the .dsp
+    int sleepHoldSamples = 0;
+    int voiceControlCounter = 0;
+
+    template<typename FaustDSP>
+    DrumVoiceUnit* addVoice(Voice voice) {
+        voices[voice].reset(new DrumVoice<FaustDSP>());
+        return voices[voice].get();
+    }
+
     AnalogDrums() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -305,179 +496,184 @@ struct AnalogDrums : FaustModule<VCVRackDSP> {
         configOutput(RS_OUTPUT, "RS");
         configOutput(MIX_OUTPUT, "Mix");
 
-        // Faust param mapping (alphabetical order)
-        // bd_click=0, bd_decay=1, bd_drive=2, bd_long_decay=3, bd_tone=4, bd_trig=5, bd_tune=6
-        // cb_decay=7, cb_detune=8, cb_trig=9, cb_tune=10
-        // ch_decay=11, ch_spread=12, ch_trig=13, ch_tune=14
-        // cp_reverb=15, cp_spread=16, cp_tone=17, cp_trig=18
-        // cy_decay=19, cy_spread=20, cy_tone=21, cy_trig=22, cy_tune=23
-        // ht_decay=24, ht_pitch_mod=25, ht_trig=26, ht_tune=27
-        // lt_decay=28, lt_pitch_mod=29, lt_trig=30, lt_tune=31
-        // ma_decay=32, ma_tone=33, ma_trig=34
-        // master_comp=35, master_gain=36, master_tone=37
-        // mt_decay=38, mt_pitch_mod=39, mt_trig=40, mt_tune=41
-        // oh_decay=42, oh_spread=43, oh_trig=44, oh_tune=45
-        // rs_decay=46, rs_trig=47, rs_tune=48
-        // sd_detune=49, sd_snap_decay=50, sd_snap_filter=51, sd_snappy=52, sd_tone=53, sd_trig=54, sd_tune=55
-
-        // Map params (we'll set triggers directly in process())
-        mapParam(BD_CLICK_PARAM, 0);
-        mapParam(BD_DECAY_PARAM, 1);
-        mapParam(BD_DRIVE_PARAM, 2);
-        mapParam(BD_LONG_DECAY_PARAM, 3);
-        mapParam(BD_TONE_PARAM, 4);
-        mapParam(BD_TUNE_PARAM, 6);
-        mapParam(CB_DECAY_PARAM, 7);
-        mapParam(CB_DETUNE_PARAM, 8);
-        mapParam(CB_TUNE_PARAM, 10);
-        mapParam(CH_DECAY_PARAM, 11);
-        mapParam(CH_SPREAD_PARAM, 12);
-        mapParam(CH_TUNE_PARAM, 14);
-        mapParam(CP_REVERB_PARAM, 15);
-        mapParam(CP_SPREAD_PARAM, 16);
-        mapParam(CP_TONE_PARAM, 17);
-        mapParam(CY_DECAY_PARAM, 19);
-        mapParam(CY_SPREAD_PARAM, 20);
-        mapParam(CY_TONE_PARAM, 21);
-        mapParam(CY_TUNE_PARAM, 23);
-        mapParam(HT_DECAY_PARAM, 24);
-        mapParam(HT_PITCH_MOD_PARAM, 25);
-        mapParam(HT_TUNE_PARAM, 27);
-        mapParam(LT_DECAY_PARAM, 28);
-        mapParam(LT_PITCH_MOD_PARAM, 29);
-        mapParam(LT_TUNE_PARAM, 31);
-        mapParam(MA_DECAY_PARAM, 32);
-        mapParam(MA_TONE_PARAM, 33);
-        mapParam(MASTER_COMP_PARAM, 35);
-        mapParam(MASTER_GAIN_PARAM, 36);
-        mapParam(MASTER_TONE_PARAM, 37);
-        mapParam(MT_DECAY_PARAM, 38);
-        mapParam(MT_PITCH_MOD_PARAM, 39);
-        mapParam(MT_TUNE_PARAM, 41);
-        mapParam(OH_DECAY_PARAM, 42);
-        mapParam(OH_SPREAD_PARAM, 43);
-        mapParam(OH_TUNE_PARAM, 45);
-        mapParam(RS_DECAY_PARAM, 46);
-        mapParam(RS_TUNE_PARAM, 48);
-        mapParam(SD_DETUNE_PARAM, 49);
-        mapParam(SD_SNAP_DECAY_PARAM, 50);
-        mapParam(SD_SNAP_FILTER_PARAM, 51);
-        mapParam(SD_SNAPPY_PARAM, 52);
-        mapParam(SD_TONE_PARAM, 53);
-        mapParam(SD_TUNE_PARAM, 55);
+        // Master bus params
+        mapParam(MASTER_COMP_PARAM, FP_MASTER::MASTER_COMP);
+        mapParam(MASTER_GAIN_PARAM, FP_MASTER::MASTER_GAIN);
+        mapParam(MASTER_TONE_PARAM, FP_MASTER::MASTER_TONE);
+
+        // Voices: knob (+ CV) bindings and trigger inputs
+        DrumVoiceUnit* bd = addVoice<FaustGenerated::NS_AnalogDrumsBD::VCVRackDSP>(BD);
+        bd->bindParam(BD_CLICK_PARAM, FP_BD::BD_CLICK);
+        bd->bindParam(BD_DECAY_PARAM, FP_BD::BD_DECAY, BD_DECAY_CV_INPUT, 0.1f);
+        bd->bindParam(BD_DRIVE_PARAM, FP_BD::BD_DRIVE);
+        bd->bindParam(BD_LONG_DECAY_PARAM, FP_BD::BD_LONG_DECAY);
+        bd->bindParam(BD_TONE_PARAM, FP_BD::BD_TONE);
+        bd->bindParam(BD_TUNE_PARAM, FP_BD::BD_TUNE, BD_TUNE_CV_INPUT, 0.2f);
+        bd->bindTrigger(BD_TRIG_INPUT, FP_BD::BD_TRIG);
+
+        DrumVoiceUnit* sd = addVoice<FaustGenerated::NS_AnalogDrumsSD::VCVRackDSP>(SD);
+        sd->bindParam(SD_DETUNE_PARAM, FP_SD::SD_DETUNE);
+        sd->bindParam(SD_SNAP_DECAY_PARAM, FP_SD::SD_SNAP_DECAY);
+        sd->bindParam(SD_SNAP_FILTER_PARAM, FP_SD::SD_SNAP_FILTER);
+        sd->bindParam(SD_SNAPPY_PARAM, FP_SD::SD_SNAPPY, SD_SNAPPY_CV_INPUT, 0.1f);
+        sd->bindParam(SD_TONE_PARAM, FP_SD::SD_TONE);
+        sd->bindParam(SD_TUNE_PARAM, FP_SD::SD_TUNE, SD_TUNE_CV_INPUT, 0.2f);
+        sd->bindTrigger(SD_TRIG_INPUT, FP_SD::SD_TRIG);
+
+        DrumVoiceUnit* lt = addVoice<FaustGenerated::NS_AnalogDrumsLT::VCVRackDSP>(LT);
+        lt->bindParam(LT_DECAY_PARAM, FP_LT::LT_DECAY);
+        lt->bindParam(LT_PITCH_MOD_PARAM, FP_LT::LT_PITCH_MOD);
+        lt->bindParam(LT_TUNE_PARAM, FP_LT::LT_TUNE, LT_TUNE_CV_INPUT, 0.2f);
+        lt->bindTrigger(LT_TRIG_INPUT, FP_LT::LT_TRIG);
+
+        DrumVoiceUnit* mt = addVoice<FaustGenerated::NS_AnalogDrumsMT::VCVRackDSP>(MT);
+        mt->bindParam(MT_DECAY_PARAM, FP_MT::MT_DECAY);
+        mt->bindParam(MT_PITCH_MOD_PARAM, FP_MT::MT_PITCH_MOD);
+        mt->bindParam(MT_TUNE_PARAM, FP_MT::MT_TUNE, MT_TUNE_CV_INPUT, 0.2f);
+        mt->bindTrigger(MT_TRIG_INPUT, FP_MT::MT_TRIG);
+
+        DrumVoiceUnit* ht = addVoice<FaustGenerated::NS_AnalogDrumsHT::VCVRackDSP>(HT);
+        ht->bindParam(HT_DECAY_PARAM, FP_HT::HT_DECAY);
+        ht->bindParam(HT_PITCH_MOD_PARAM, FP_HT::HT_PITCH_MOD);
+        ht->bindParam(HT_TUNE_PARAM, FP_HT::HT_TUNE, HT_TUNE_CV_INPUT, 0.2f);
+        ht->bindTrigger(HT_TRIG_INPUT, FP_HT::HT_TRIG);
+
+        DrumVoiceUnit* cb = addVoice<FaustGenerated::NS_AnalogDrumsCB::VCVRackDSP>(CB);
+        cb->bindParam(CB_DECAY_PARAM, FP_CB::CB_DECAY);
+        cb->bindParam(CB_DETUNE_PARAM, FP_CB::CB_DETUNE);
+        cb->bindParam(CB_TUNE_PARAM, FP_CB::CB_TUNE, CB_TUNE_CV_INPUT, 0.2f);
+        cb->bindTrigger(CB_TRIG_INPUT, FP_CB::CB_TRIG);
+
+        DrumVoiceUnit* ch = addVoice<FaustGenerated::NS_AnalogDrumsCH::VCVRackDSP>(CH);
+        ch->bindParam(CH_DECAY_PARAM, FP_CH::CH_DECAY);
+        ch->bindParam(CH_SPREAD_PARAM, FP_CH::CH_SPREAD, CH_SPREAD_CV_INPUT, 0.1f);
+        ch->bindParam(CH_TUNE_PARAM, FP_CH::CH_TUNE, CH_TUNE_CV_INPUT, 0.2f);
+        ch->bindTrigger(CH_TRIG_INPUT, FP_CH::CH_TRIG);
+
+        // OH also listens to the CH trigger (choke)
+        DrumVoiceUnit* oh = addVoice<FaustGenerated::NS_AnalogDrumsOH::VCVRackDSP>(OH);
+        oh->bindParam(OH_DECAY_PARAM, FP_OH::OH_DECAY);
+        oh->bindParam(OH_SPREAD_PARAM, FP_OH::OH_SPREAD, OH_SPREAD_CV_INPUT, 0.1f);
+        oh->bindParam(OH_TUNE_PARAM, FP_OH::OH_TUNE, OH_TUNE_CV_INPUT, 0.2f);
+        oh->bindTrigger(OH_TRIG_INPUT, FP_OH::OH_TRIG);
+        oh->bindTrigger(CH_TRIG_INPUT, FP_OH::CH_TRIG);
+
+        DrumVoiceUnit* cy = addVoice<FaustGenerated::NS_AnalogDrumsCY::VCVRackDSP>(CY);
+        cy->bindParam(CY_DECAY_PARAM, FP_CY::CY_DECAY);
+        cy->bindParam(CY_SPREAD_PARAM, FP_CY::CY_SPREAD);
+        cy->bindParam(CY_TONE_PARAM, FP_CY::CY_TONE);
+        cy->bindParam(CY_TUNE_PARAM, FP_CY::CY_TUNE, CY_TUNE_CV_INPUT, 0.2f);
+        cy->bindTrigger(CY_TRIG_INPUT, FP_CY::CY_TRIG);
+
+        DrumVoiceUnit* cp = addVoice<FaustGenerated::NS_AnalogDrumsCP::VCVRackDSP>(CP);
+        cp->bindParam(CP_REVERB_PARAM, FP_CP::CP_REVERB);
+        cp->bindParam(CP_SPREAD_PARAM, FP_CP::CP_SPREAD);
+        cp->bindParam(CP_TONE_PARAM, FP_CP::CP_TONE);
+        cp->bindTrigger(CP_TRIG_INPUT, FP_CP::CP_TRIG);
+
+        DrumVoiceUnit* ma = addVoice<FaustGenerated::NS_AnalogDrumsMA::VCVRackDSP>(MA);
+        ma->bindParam(MA_DECAY_PARAM, FP_MA::MA_DECAY);
+        ma->bindParam(MA_TONE_PARAM, FP_MA::MA_TONE);
+        ma->bindTrigger(MA_TRIG_INPUT, FP_MA::MA_TRIG);
+
+        DrumVoiceUnit* rs = addVoice<FaustGenerated::NS_AnalogDrumsRS::VCVRackDSP>(RS);
+        rs->bindParam(RS_DECAY_PARAM, FP_RS::RS_DECAY);
+        rs->bindParam(RS_TUNE_PARAM, FP_RS::RS_TUNE);
+        rs->bindTrigger(RS_TRIG_INPUT, FP_RS::RS_TRIG);
     }
 
-    void process(const ProcessArgs& args) override {
-        // Initialize DSP on first run
-        if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
-        }
-
-        // Update params via mapParam
-        updateFaustParams();
-
-        // Apply CV modulation to tune params
-        float bd_tune = params[BD_TUNE_PARAM].getValue();
-        if (inputs[BD_TUNE_CV_INPUT].isConnected()) {
-            bd_tune += inputs[BD_TUNE_CV_INPUT].getVoltage() * 0.2f;
-            bd_tune = clamp(bd_tune, -1.f, 1.f);
+    void initVoices(int sampleRate) {
+        sleepHoldSamples = static_cast<int>(sampleRate * SLEEP_HOLD_SECONDS);
+        for (auto& voice : voices) {
+            voice->init(sampleRate);
         }
-        faustDsp.setParamValue(6, bd_tune);
+        voiceControlCounter = 0;
+    }
 
-        float sd_tune = params[SD_TUNE_PARAM].getValue();
-        if (inputs[SD_TUNE_CV_INPUT].isConnected()) {
-            sd_tune += inputs[SD_TUNE_CV_INPUT].getVoltage() * 0.2f;
-            sd_tune = clamp(sd_tune, -1.f, 1.f);
+    /**
+     * Push changed knob/CV values to a voice, waking it if anything moved
+     */
+    void updateVoiceParams(DrumVoiceUnit& voice) {
+        for (auto& binding : voice.bindings) {
+            float value = params[binding.vcvParamId].getValue();
+            if (binding.cvInputId >= 0 && inputs[binding.cvInputId].isConnected()) {
+                value += inputs[binding.cvInputId].getVoltage() * binding.cvScale;
+                value = clamp(value, binding.minVal, binding.maxVal);
+            }
+            if (voice.primed && value == binding.sent) continue;
+
+            binding.sent = value;
+            voice.setParamValue(binding.faustParamIdx, value);
+            voice.wake();
         }
-        faustDsp.setParamValue(55, sd_tune);  // shifted +1
+        voice.primed = true;
+    }
 
-        // Apply CV modulation to other params
-        float bd_decay = params[BD_DECAY_PARAM].getValue();
-        if (inputs[BD_DECAY_CV_INPUT].isConnected()) {
-            bd_decay += inputs[BD_DECAY_CV_INPUT].getVoltage() * 0.1f;
-            bd_decay = clamp(bd_decay, 0.f, 1.f);
-        }
-        faustDsp.setParamValue(1, bd_decay);
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        FaustModule<MasterDSP>::onSampleRateChange(e);
+        initVoices(static_cast<int>(e.sampleRate));
+    }
 
-        float sd_snappy = params[SD_SNAPPY_PARAM].getValue();
-        if (inputs[SD_SNAPPY_CV_INPUT].isConnected()) {
-            sd_snappy += inputs[SD_SNAPPY_CV_INPUT].getVoltage() * 0.1f;
-            sd_snappy = clamp(sd_snappy, 0.f, 1.f);
-        }
-        faustDsp.setParamValue(52, sd_snappy);  // shifted +1
+    void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
 
-        // CH and OH tune - explicit handling to ensure tune works
-        float ch_tune = params[CH_TUNE_PARAM].getValue();
-        if (inputs[CH_TUNE_CV_INPUT].isConnected()) {
-            ch_tune += inputs[CH_TUNE_CV_INPUT].getVoltage() * 0.2f;
-            ch_tune = clamp(ch_tune, -1.f, 1.f);
+        // Initialize DSP on first run
+        if (!initialized) {
+            initDsp(args.sampleRate);
+            initVoices(static_cast<int>(args.sampleRate));
+            initialized = true;
         }
-        faustDsp.setParamValue(14, ch_tune);  // ch_tune
 
-        float oh_tune = params[OH_TUNE_PARAM].getValue();
-        if (inputs[OH_TUNE_CV_INPUT].isConnected()) {
-            oh_tune += inputs[OH_TUNE_CV_INPUT].getVoltage() * 0.2f;
-            oh_tune = clamp(oh_tune, -1.f, 1.f);
-        }
-        faustDsp.setParamValue(45, oh_tune);  // oh_tune
+        // Master params via mapParam
+        updateFaustParams();
 
-        // CH and OH spread CV modulation
-        float ch_spread = params[CH_SPREAD_PARAM].getValue();
-        if (inputs[CH_SPREAD_CV_INPUT].isConnected()) {
-            ch_spread += inputs[CH_SPREAD_CV_INPUT].getVoltage() * 0.1f;
-            ch_spread = clamp(ch_spread, 0.f, 1.f);
+        // Voice knobs and CV at the same control rate
+        if (--voiceControlCounter <= 0) {
+            voiceControlCounter = controlRateDivider;
+            for (auto& voice : voices) {
+                updateVoiceParams(*voice);
+            }
         }
-        faustDsp.setParamValue(12, ch_spread);  // ch_spread
 
-        float oh_spread = params[OH_SPREAD_PARAM].getValue();
-        if (inputs[OH_SPREAD_CV_INPUT].isConnected()) {
-            oh_spread += inputs[OH_SPREAD_CV_INPUT].getVoltage() * 0.1f;
-            oh_spread = clamp(oh_spread, 0.f, 1.f);
+        // Run the awake voices (sleeping ones output silence)
+        float white = noise.next();
+        float voiceOutputs[NUM_VOICES] = {};
+        for (int i = 0; i < NUM_VOICES; i++) {
+            DrumVoiceUnit& voice = *voices[i];
+
+            if (inputs[BD_TRIG_INPUT + i].getVoltage() > 0.9f) {
+                lightValues[i] = 1.0f;
+            }
+            // Any bound trigger wakes the voice, so OH sees CH's choke edge
+            if (!voice.awake) {
+                for (const auto& trigger : voice.triggers) {
+                    if (inputs[trigger.vcvInputId].getVoltage() > 0.9f) {
+                        voice.wake();
+                        break;
+                    }
+                }
+                if (!voice.awake) continue;
+            }
+
+            bool triggersLow = true;
+            for (const auto& trigger : voice.triggers) {
+                float trig = inputs[trigger.vcvInputId].getVoltage();
+                voice.setParamValue(trigger.faustParamIdx, trig);
+                triggersLow = triggersLow && trig <= 0.9f;
+            }
+
+            float* noiseIn = &white;
+            float* voiceOut = &voiceOutputs[i];
+            computeDsp(voice, 1, &noiseIn, &voiceOut);
+
+            if (triggersLow && std::fabs(voiceOutputs[i]) < SILENCE_THRESHOLD) {
+                if (++voice.quietSamples >= sleepHoldSamples) {
+                    voice.awake = false;
+                }
+            } else {
+                voice.quietSamples = 0;
+            }
         }
-        faustDsp.setParamValue(43, oh_spread);  // oh_spread
-
-        // Get trigger inputs and send to Faust
-        float bdTrig = inputs[BD_TRIG_INPUT].getVoltage();
-        float sdTrig = inputs[SD_TRIG_INPUT].getVoltage();
-        float ltTrig = inputs[LT_TRIG_INPUT].getVoltage();
-        float mtTrig = inputs[MT_TRIG_INPUT].getVoltage();
-        float htTrig = inputs[HT_TRIG_INPUT].getVoltage();
-        float cbTrig = inputs[CB_TRIG_INPUT].getVoltage();
-        float chTrig = inputs[CH_TRIG_INPUT].getVoltage();
-        float ohTrig = inputs[OH_TRIG_INPUT].getVoltage();
-        float cyTrig = inputs[CY_TRIG_INPUT].getVoltage();
-        float cpTrig = inputs[CP_TRIG_INPUT].getVoltage();
-        float maTrig = inputs[MA_TRIG_INPUT].getVoltage();
-        float rsTrig = inputs[RS_TRIG_INPUT].getVoltage();
-
-        // Set trigger params (Faust indices - shifted +1 after master_comp added)
-        faustDsp.setParamValue(5, bdTrig);   // bd_trig
-        faustDsp.setParamValue(9, cbTrig);   // cb_trig
-        faustDsp.setParamValue(13, chTrig);  // ch_trig
-        faustDsp.setParamValue(18, cpTrig);  // cp_trig
-        faustDsp.setParamValue(22, cyTrig);  // cy_trig
-        faustDsp.setParamValue(26, htTrig);  // ht_trig
-        faustDsp.setParamValue(30, ltTrig);  // lt_trig
-        faustDsp.setParamValue(34, maTrig);  // ma_trig
-        faustDsp.setParamValue(40, mtTrig);  // mt_trig (shifted +1)
-        faustDsp.setParamValue(44, ohTrig);  // oh_trig (shifted +1)
-        faustDsp.setParamValue(47, rsTrig);  // rs_trig (shifted +1)
-        faustDsp.setParamValue(54, sdTrig);  // sd_trig (shifted +1)
-
-        // Update trigger LEDs
-        if (bdTrig > 0.9f) lightValues[BD] = 1.0f;
-        if (sdTrig > 0.9f) lightValues[SD] = 1.0f;
-        if (ltTrig > 0.9f) lightValues[LT] = 1.0f;
-        if (mtTrig > 0.9f) lightValues[MT] = 1.0f;
-        if (htTrig > 0.9f) lightValues[HT] = 1.0f;
-        if (cbTrig > 0.9f) lightValues[CB] = 1.0f;
-        if (chTrig > 0.9f) lightValues[CH] = 1.0f;
-        if (ohTrig > 0.9f) lightValues[OH] = 1.0f;
-        if (cyTrig > 0.9f) lightValues[CY] = 1.0f;
-        if (cpTrig > 0.9f) lightValues[CP] = 1.0f;
-        if (maTrig > 0.9f) lightValues[MA] = 1.0f;
-        if (rsTrig > 0.9f) lightValues[RS] = 1.0f;
 
         // Decay LEDs
         for (int i = 0; i < NUM_VOICES; i++) {
@@ -485,33 +681,15 @@ struct AnalogDrums : FaustModule<VCVRackDSP> {
             lights[BD_LIGHT + i].setBrightness(lightValues[i]);
         }
 
-        // Process audio (no input, 13 outputs)
-        float* nullInputs[1] = { nullptr };
-        float outputBuffers[13];
-        float* outputPtrs[13];
-        for (int i = 0; i < 13; i++) {
-            outputBuffers[i] = 0.0f;
-            outputPtrs[i] = &outputBuffers[i];
+        // Output individual voices at 5V peak
+        for (int i = 0; i < NUM_VOICES; i++) {
+            outputs[BD_OUTPUT + i].setVoltage(voiceOutputs[i] * 5.0f);
         }
 
-        faustDsp.compute(1, nullInputs, outputPtrs);
-
-        // Output individual voices at 5V peak
-        outputs[BD_OUTPUT].setVoltage(outputBuffers[0] * 5.0f);
-        outputs[SD_OUTPUT].setVoltage(outputBuffers[1] * 5.0f);
-        outputs[LT_OUTPUT].setVoltage(outputBuffers[2] * 5.0f);
-        outputs[MT_OUTPUT].setVoltage(outputBuffers[3] * 5.0f);
-        outputs[HT_OUTPUT].setVoltage(outputBuffers[4] * 5.0f);
-        outputs[CB_OUTPUT].setVoltage(outputBuffers[5] * 5.0f);
-        outputs[CH_OUTPUT].setVoltage(outputBuffers[6] * 5.0f);
-        outputs[OH_OUTPUT].setVoltage(outputBuffers[7] * 5.0f);
-        outputs[CY_OUTPUT].setVoltage(outputBuffers[8] * 5.0f);
-        outputs[CP_OUTPUT].setVoltage(outputBuffers[9] * 5.0f);
-        outputs[MA_OUTPUT].setVoltage(outputBuffers[10] * 5.0f);
-        outputs[RS_OUTPUT].setVoltage(outputBuffers[11] * 5.0f);
-
-        // Master mix output
-        outputs[MIX_OUTPUT].setVoltage(outputBuffers[12] * 5.0f);
+        // Master mix output (12 inputs, 1 output)
+        float mix = 0.0f;
+        computeFrame(voiceOutputs, &mix);
+        outputs[MIX_OUTPUT].setVoltage(mix * 5.0f);
     }
 };
 
@@ -27,7 +27,7 @@ bd_drive = hslider("bd_drive", 0, 0, 1, 0.001) : si.smoo;  // Circuit bend
 
 bd_trigger = (bd_trig > 0.9) & (bd_trig' <= 0.9);
 
-bd_voice = output
+bd_model(white) = output
 with {
     // Base frequency: 30-80 Hz based on tune
     base_freq = 45 * (2 ^ (bd_tune * 0.5));
@@ -46,7 +46,7 @@ with {
     amp_env = en.ar(0.001, 0.1 + bd_decay * 0.9 + bd_long_decay * 2, bd_trigger);
 
     // Click transient (noise burst)
-    click = no.noise : fi.lowpass(1, 200) * en.ar(0.0001, 0.005, bd_trigger) * bd_click * 2;
+    click = white : fi.lowpass(1, 200) * en.ar(0.0001, 0.005, bd_trigger) * bd_click * 2;
 
     // Combine: click excites resonator, then add direct click
     excite = click + (bd_trigger : ba.impulsify) * 2;
@@ -63,6 +63,9 @@ with {
     output = driven : drum_channel(30);
 };
 
+bd_voice = bd_model(no.noise);
+bd_noise_in = bd_model;   // White noise as input 0 (module build)
+
 //=====================================================================
 // SNARE DRUM (SD)
 // Two bridged-T resonators + HPF noise
@@ -79,7 +82,7 @@ sd_detune = hslider("sd_detune", 0, 0, 1, 0.001) : si.smoo;  // Circuit bend
 
 sd_trigger = (sd_trig > 0.9) & (sd_trig' <= 0.9);
 
-sd_voice = output
+sd_model(white) = output
 with {
     // Two resonator frequencies (shell)
     base_freq = 180 * (2 ^ (sd_tune * 0.3));
@@ -99,12 +102,15 @@ with {
     // Snappy noise (snare wires)
     snap_hpf_freq = 2000 + sd_snap_filter * 6000;
     snap_env = en.ar(0.001, 0.05 + sd_snap_decay * 0.2, sd_trigger);
-    snap = no.noise : fi.highpass(2, snap_hpf_freq) * snap_env * sd_snappy * 1.5;
+    snap = white : fi.highpass(2, snap_hpf_freq) * snap_env * sd_snappy * 1.5;
 
     // Mix shell and snap with compression
     output = (shell_out + snap) : drum_channel(30);
 };
 
+sd_voice = sd_model(no.noise);
+sd_noise_in = sd_model;   // White noise as input 0 (module build)
+
 //=====================================================================
 // TOM DRUMS (LT, MT, HT)
 // Bridged-T resonators, same circuit different tuning
@@ -305,10 +311,10 @@ cp_tone = hslider("cp_tone", 0.5, 0, 1, 0.001) : si.smoo;
 
 cp_trigger = (cp_trig > 0.9) & (cp_trig' <= 0.9);
 
-cp_voice = output
+cp_model(white) = output
 with {
     // Noise source, bandpass filtered
-    noise = no.noise : fi.bandpass(2, 1000 + cp_tone * 1500, 3500);
+    noise = white : fi.bandpass(2, 1000 + cp_tone * 1500, 3500);
 
     // Use a simple counter-based approach for burst timing
     // When trigger arrives, generate 4 bursts at fixed intervals
@@ -335,6 +341,9 @@ with {
     output = (noise * amp_env) : drum_channel(30);
 };
 
+cp_voice = cp_model(no.noise);
+cp_noise_in = cp_model;   // White noise as input 0 (module build)
+
 //=====================================================================
 // MARACAS (MA)
 // High metallic oscillators with ASR envelope
@@ -347,10 +356,10 @@ ma_tone = hslider("ma_tone", 0.7, 0, 1, 0.001) : si.smoo;
 
 ma_trigger = (ma_trig > 0.9) & (ma_trig' <= 0.9);
 
-ma_voice = output
+ma_model(white) = output
 with {
     // High-frequency filtered noise
-    noise = no.noise : fi.highpass(2, 5000 + ma_tone * 5000);
+    noise = white : fi.highpass(2, 5000 + ma_tone * 5000);
 
     // Short ASR envelope
     amp_env = en.ar(0.001, 0.02 + ma_decay * 0.1, ma_trigger);
@@ -358,6 +367,9 @@ with {
     output = (noise * amp_env) : drum_channel(8);
 };
 
+ma_voice = ma_model(no.noise);
+ma_noise_in = ma_model;   // White noise as input 0 (module build)
+
 //=====================================================================
 // RIMSHOT (RS)
 // Triangle oscillator + bridged-T resonator
@@ -413,7 +425,13 @@ master_filter(x) = x : fi.lowpass(1, 2000 + master_tone * 18000);
 master_bus_comp = drum_comp(0.005, 0.15, 0.4, 2 + master_comp * 6, 1.5);
 
 // Final master output: filter -> bus comp -> gain -> soft limit
-master_out = voice_mix : master_filter : master_bus_comp * master_gain : soft_clip : dc_block;
+master_section = master_filter : master_bus_comp * master_gain : soft_clip : dc_block;
+master_out = voice_mix : master_section;
+
+// Master bus fed from 12 voice inputs. The module compiles this and each
+// *_voice (*_noise_in for the noise voices) on its own (faust -pn) so idle
+// voices can be skipped.
+master_bus = si.bus(12) :> *(0.15) : master_section;
 
 //=====================================================================
 // OUTPUT: 13 channels (12 individual + mix)
@@ -6,9 +6,11 @@
 
 #include "rack.hpp"
 #include "FaustModule.hpp"
+#include "BlockWorker.hpp"
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME BigReverb
 #include "big_reverb.hpp"  // Generated by Faust
+#include "big_reverb_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -16,6 +18,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::big_reverb;
+
 /**
  * BigReverb - Lush Stereo Reverb (Zita Rev1)
  *
@@ -29,6 +33,21 @@ namespace WiggleRoom {
  *   - Crossover: Bass/treble split frequency (50-6000Hz)
  *   - Damping: HF rolloff for warmth (100-15000Hz)
  *   - Mix: Dry/Wet balance
+ *
+ * The Faust DSP always runs fully wet; the dry signal and the crossfade
+ * are done here, so the wet path can be moved or slowed down on its own:
+ *
+ *   Offload  renders the wet signal on a worker thread (BlockWorker.hpp).
+ *            The reverb then costs the engine thread almost nothing, at
+ *            2-8 blocks of 64 frames (4 by default, ~5.3ms at 48kHz) of
+ *            extra pre-delay on the wet signal. Silence bypass doesn't
+ *            apply, and the state clear after a rate or quality change
+ *            runs inline. Patch loads queue the saved Faust values through
+ *            wetParams, since the worker may be rendering faustDsp.
+ *   Eco      runs the FDN at 1/2 or 1/4 of the engine rate (see
+ *            FaustModule::enableRateReduction()). Damped tails have almost
+ *            nothing above a few kHz, so at 96kHz this is a 2-4x saving
+ *            without an audible change; the dry path stays at full rate.
  */
 struct BigReverb : FaustModule<VCVRackDSP> {
     enum ParamId {
@@ -55,6 +74,15 @@ struct BigReverb : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    // Offloaded wet path
+    BlockWorker<2, 2> wetWorker;
+    std::atomic<float> wetParams[FP::NUM_PARAMS];   // Latest slot values for the worker
+    std::atomic<bool> wetParamsLoaded{false};       // dataFromJson() filled wetParams
+    std::atomic<bool> offloadRequested{false};
+    bool offloaded = false;       // Audio thread: frames go through wetWorker
+    bool draining = false;        // Audio thread: waiting for the worker to finish
+    float mixSmoothed = 0.5f;     // Dry/wet crossfade, done here at the full rate
+
     BigReverb() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -75,20 +103,65 @@ struct BigReverb : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Map VCV parameters to Faust DSP parameters (alphabetical order)
-        // Faust params: damping=0, decay_high=1, decay_low=2, mix=3, predelay=4, xover=5
-        mapParam(DAMPING_PARAM, 0);
-        mapParam(DECAY_HIGH_PARAM, 1);
-        mapParam(DECAY_LOW_PARAM, 2);
-        mapParam(MIX_PARAM, 3);
-        mapParam(PREDELAY_PARAM, 4);
-        mapParam(XOVER_PARAM, 5);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(DAMPING_PARAM, FP::DAMPING);
+        mapParam(DECAY_HIGH_PARAM, FP::DECAY_HIGH);
+        mapParam(DECAY_LOW_PARAM, FP::DECAY_LOW);
+        mapParam(PREDELAY_PARAM, FP::PREDELAY);
+        mapParam(XOVER_PARAM, FP::XOVER);
+        // Wet only; the dry/wet crossfade is done in process()
+        overrideParam(FP::MIX, 1.f);
+
+        for (int i = 0; i < FP::NUM_PARAMS; i++) {
+            wetParams[i].store(FP::PARAMS[i].init, std::memory_order_relaxed);
+        }
+
+        // Idle sends skip the reverb once the tail is gone (covers 200ms predelay)
+        setSilenceBypass(1.0f);
+        enableRateReduction(4);
+    }
+
+    ~BigReverb() override {
+        // Before wetParams and faustDsp go away
+        wetWorker.stop();
+    }
+
+    // UI thread (menu, dataFromJson). process() switches over once the
+    // worker is idle; turning offload off also stops the worker thread.
+    void setOffload(bool enable) {
+        offloadRequested.store(enable, std::memory_order_relaxed);
+        if (enable) {
+            wetWorker.start([this](int count, float** in, float** out) { renderWet(count, in, out); });
+        } else {
+            wetWorker.stop();
+        }
+    }
+
+    bool getOffload() const {
+        return offloadRequested.load(std::memory_order_relaxed);
+    }
+
+    // Extra wet pre-delay while offloaded, in 64-frame blocks (any thread)
+    void setOffloadLatency(int blocks) {
+        wetWorker.setLatencyBlocks(blocks);
+    }
+
+    int getOffloadLatency() const {
+        return wetWorker.getLatencyBlocks();
+    }
+
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        // The worker may be mid-block; the engine isn't calling process() now
+        wetWorker.drain();
+        FaustModule::onSampleRateChange(e);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -99,31 +172,109 @@ struct BigReverb : FaustModule<VCVRackDSP> {
         }
         mix = clamp(mix, 0.f, 1.f);
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, params[DAMPING_PARAM].getValue());     // damping
-        faustDsp.setParamValue(1, params[DECAY_HIGH_PARAM].getValue());  // decay_high
-        faustDsp.setParamValue(2, params[DECAY_LOW_PARAM].getValue());   // decay_low
-        faustDsp.setParamValue(3, mix);                                   // mix (with CV)
-        faustDsp.setParamValue(4, params[PREDELAY_PARAM].getValue());    // predelay
-        faustDsp.setParamValue(5, params[XOVER_PARAM].getValue());       // xover
-
         // Get stereo input (normalize to Faust range)
         float inputL = inputs[LEFT_INPUT].getVoltage() * 0.2f;  // 5V -> 1.0
         float inputR = inputs[RIGHT_INPUT].isConnected()
             ? inputs[RIGHT_INPUT].getVoltage() * 0.2f
             : inputL;  // Mono to stereo if only left connected
 
-        float* inputPtrs[2] = { &inputL, &inputR };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        float frameIn[2] = { inputL, inputR };
+        float wet[2] = {};
+
+        updateOffloadState();
+        if (offloaded) {
+            if (!draining) {
+                advanceParamSlots();
+                for (auto& slot : paramSlots) {
+                    if (!slot.dirty) continue;
+                    slot.dirty = false;
+                    wetParams[slot.faustParamIdx].store(slot.current, std::memory_order_relaxed);
+                }
+                wetWorker.process(frameIn, wet);
+            }
+        } else {
+            // Loaded values the worker didn't pick up; the mapped slots follow
+            if (wetParamsLoaded.exchange(false, std::memory_order_acquire)) {
+                for (int i = 0; i < FP::NUM_PARAMS; i++) {
+                    faustDsp.setParamValue(i, wetParams[i].load(std::memory_order_relaxed));
+                }
+            }
+            updateFaustParams();
+            computeFrame(frameIn, wet);
+        }
 
-        // Process audio
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        // Smoothed like si.smoo in the .dsp
+        mixSmoothed += (mix - mixSmoothed) * 0.001f;
+        float outputL = inputL * (1.f - mixSmoothed) + wet[0] * mixSmoothed;
+        float outputR = inputR * (1.f - mixSmoothed) + wet[1] * mixSmoothed;
 
         // Output (back to VCV voltage range)
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
         outputs[RIGHT_OUTPUT].setVoltage(outputR * 5.0f);
     }
+
+    /**
+     * Follow offloadRequested. Going inline waits for the worker to finish
+     * its last block (dry only meanwhile), since both would use faustDsp.
+     *
+     * A pending state clear or rate change also runs inline: the FaustModule
+     * bookkeeping stays on the audio thread, and the worker only renders.
+     */
+    void updateOffloadState() {
+        bool want = offloadRequested.load(std::memory_order_relaxed) && wetWorker.running()
+            && clearCountdown == 0 && pendingRateDivider() == rateDivider;
+        if (want && !offloaded) {
+            // process() only stores the slots that move from here on
+            for (const auto& slot : paramSlots) {
+                wetParams[slot.faustParamIdx].store(slot.current, std::memory_order_relaxed);
+            }
+            wetWorker.flush();
+            offloaded = true;
+            draining = false;
+        } else if (!want && offloaded) {
+            draining = true;
+            if (!wetWorker.running() || wetWorker.finish()) {
+                // The worker may have dropped the last stored values
+                for (auto& slot : paramSlots) slot.dirty = true;
+                wetWorker.flush();
+                offloaded = false;
+                draining = false;
+            }
+        } else if (want) {
+            draining = false;
+        }
+    }
+
+    // Worker thread: one block of the wet signal
+    void renderWet(int count, float** in, float** out) {
+        for (int i = 0; i < FP::NUM_PARAMS; i++) {
+            faustDsp.setParamValue(i, wetParams[i].load(std::memory_order_relaxed));
+        }
+        computeBlock(count, in, out);
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustModule::dataToJson();
+        json_object_set_new(rootJ, "offload", json_boolean(getOffload()));
+        json_object_set_new(rootJ, "offloadLatency", json_integer(getOffloadLatency()));
+        return rootJ;
+    }
+
+    // UI thread, maybe while the worker renders: the saved Faust values go
+    // through wetParams, which the worker applies every block and process()
+    // applies to faustDsp once it runs inline
+    void dataFromJson(json_t* rootJ) override {
+        paramsFromJson(rootJ, [this](int i, float value) {
+            wetParams[i].store(value, std::memory_order_relaxed);
+        });
+        wetParamsLoaded.store(true, std::memory_order_release);
+        settingsFromJson(rootJ);
+
+        json_t* latencyJ = json_object_get(rootJ, "offloadLatency");
+        if (latencyJ) setOffloadLatency(static_cast<int>(json_integer_value(latencyJ)));
+        json_t* offloadJ = json_object_get(rootJ, "offload");
+        if (offloadJ) setOffload(json_is_true(offloadJ));
+    }
 };
 
 struct BigReverbWidget : ModuleWidget {
@@ -175,6 +326,36 @@ struct BigReverbWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter + 22, 310), module, BigReverb::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<BigReverb*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        appendRateReductionMenu(menu, m, "Reverb quality");
+        menu->addChild(createBoolMenuItem("Render reverb on a worker thread (adds latency)", "",
+            [=]() { return m->getOffload(); },
+            [=](bool enable) { m->setOffload(enable); }
+        ));
+        if (m->getOffload()) {
+            static const int latencies[] = {2, 4, 8};
+            menu->addChild(createIndexSubmenuItem("Worker latency",
+                {"2 blocks (~2.7ms)", "4 blocks (~5.3ms)", "8 blocks (~10.7ms)"},
+                [=]() {
+                    int current = m->getOffloadLatency();
+                    for (size_t i = 0; i < 3; i++) {
+                        if (latencies[i] >= current) return i;
+                    }
+                    return size_t(2);
+                },
+                [=](size_t index) { m->setOffloadLatency(latencies[index]); }
+            ));
+            menu->addChild(createMenuLabel("Worker underruns: "
+                + std::to_string(m->wetWorker.underrunCount()) + " ("
+                + std::to_string(m->wetWorker.lateFrameCount()) + " frames late, "
+                + std::to_string(m->wetWorker.droppedFrameCount()) + " dropped)"));
+        }
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -10,6 +10,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME ChaosFlute
 #include "chaos_flute.hpp"  // Generated by Faust
+#include "chaos_flute_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +18,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::chaos_flute;
+
 /**
  * ChaosFlute - Physical Flute Model with Chaos Controls
  *
@@ -84,19 +87,24 @@ struct ChaosFlute : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): attack=0, gate=1, growl=2, mouth=3, pressure=4, release=5, reverb=6, volts=7
-        mapParam(ATTACK_PARAM, 0);
-        mapParam(RELEASE_PARAM, 5);
-        mapParam(PRESSURE_PARAM, 4);
-        mapParam(MOUTH_PARAM, 3);
-        mapParam(GROWL_PARAM, 2);
-        mapParam(REVERB_PARAM, 6);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(ATTACK_PARAM, FP::ATTACK);
+        mapParam(RELEASE_PARAM, FP::RELEASE);
+        mapParam(PRESSURE_PARAM, FP::PRESSURE);
+        mapParam(MOUTH_PARAM, FP::MOUTH);
+        mapParam(GROWL_PARAM, FP::GROWL);
+        mapParam(REVERB_PARAM, FP::REVERB);
+
+        // The waveguide costs scale with the engine rate; optionally run near 48 kHz
+        enableFixedRate(48000);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -134,22 +142,20 @@ struct ChaosFlute : FaustModule<VCVRackDSP> {
         }
         reverb = clamp(reverb, 0.f, 1.f);
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, attack);    // attack
-        faustDsp.setParamValue(1, gate);      // gate
-        faustDsp.setParamValue(2, growl);     // growl
-        faustDsp.setParamValue(3, mouth);     // mouth
-        faustDsp.setParamValue(4, pressure);  // pressure
-        faustDsp.setParamValue(5, release);   // release
-        faustDsp.setParamValue(6, reverb);    // reverb
-        faustDsp.setParamValue(7, voct);      // volts
+        // Update Faust parameters
+        faustDsp.setParamValue(FP::ATTACK, attack);
+        setGateParam(FP::GATE, gate);
+        faustDsp.setParamValue(FP::GROWL, growl);
+        faustDsp.setParamValue(FP::MOUTH, mouth);
+        faustDsp.setParamValue(FP::PRESSURE, pressure);
+        faustDsp.setParamValue(FP::RELEASE, release);
+        faustDsp.setParamValue(FP::REVERB, reverb);
+        faustDsp.setParamValue(FP::VOLTS, voct);
 
         // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(nullptr, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -214,6 +220,14 @@ struct ChaosFluteWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 320), module, ChaosFlute::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<ChaosFlute*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        appendFixedRateMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
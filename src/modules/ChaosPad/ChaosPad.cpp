@@ -2,22 +2,131 @@
  * CHAOSPAD
  * Kaoss Pad-style multi-FX for drum mangling
  * 8 stereo effects with X/Y/Z control, clock sync, latch, attenuverters
- * Built with Faust DSP
+ * Built with Faust DSP (one unit per effect, only the selected one runs)
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
-#define FAUST_MODULE_NAME ChaosPad
-#include "chaos_pad.hpp"  // Generated by Faust
+#include <memory>
+
+// Each effect and the dry/wet mix bus are generated from chaos_pad.dsp as
+// separate DSPs (faust -pn, see CMakeLists.txt), so several Faust headers
+// share this translation unit
+#define FAUST_NO_GLOBAL_ALIAS
+
+#define FAUST_MODULE_NAME ChaosPadMix
+#include "chaos_pad_mix.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadLPF
+#include "chaos_pad_lpf.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadBitcrush
+#include "chaos_pad_bitcrush.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadDelay
+#include "chaos_pad_delay.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadGrain
+#include "chaos_pad_grain.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadPitch
+#include "chaos_pad_pitch.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadReverb
+#include "chaos_pad_reverb.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadFlanger
+#include "chaos_pad_flanger.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPadRingMod
+#include "chaos_pad_ringmod.hpp"
+
+#include "chaos_pad_mix_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
+namespace FP = FaustParams::chaos_pad_mix;
+
 extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
-struct ChaosPad : FaustModule<VCVRackDSP> {
+/**
+ * One effect of chaos_pad.dsp, compiled as its own DSP
+ *
+ * Effects only get the shared controls they use, so the parameter indices
+ * are looked up by name when the unit is initialized (-1 = not used).
+ */
+struct FxUnit {
+    enum Control {
+        CLOCK_PERIOD, CLOCK_SYNCED, DIV_MULT, GATE_ENV, X, Y, Z, NUM_CONTROLS
+    };
+
+    virtual ~FxUnit() = default;
+
+    virtual void init(int sampleRate) = 0;
+    virtual void clear() = 0;
+    virtual void setControls(const float* values) = 0;
+    virtual void computeFrame(const float* in, float* out) = 0;
+};
+
+template<typename FaustDSP>
+struct FxVoice final : FxUnit {
+    FaustDSP dsp;
+    int paramIdx[NUM_CONTROLS];
+    float input[2] = {};
+    float output[2] = {};
+    float* inputPtrs[2] = {&input[0], &input[1]};
+    float* outputPtrs[2] = {&output[0], &output[1]};
+
+    void init(int sampleRate) override {
+        if (dsp.getSampleRate() == 0) {
+            dsp.init(sampleRate);
+            static const char* names[NUM_CONTROLS] = {
+                "clock_period", "clock_synced", "div_mult", "gate_env", "x", "y", "z"
+            };
+            for (int c = 0; c < NUM_CONTROLS; c++) {
+                paramIdx[c] = dsp.getParamIndex(names[c]);
+            }
+        } else {
+            // State is cleared with the mix bus (see ChaosPad::process())
+            dsp.setSampleRate(sampleRate, false);
+        }
+    }
+
+    void clear() override {
+        dsp.instanceClear();
+    }
+
+    void setControls(const float* values) override {
+        for (int c = 0; c < NUM_CONTROLS; c++) {
+            if (paramIdx[c] >= 0) dsp.setParamValue(paramIdx[c], values[c]);
+        }
+    }
+
+    void computeFrame(const float* in, float* out) override {
+        ScopedFlushDenormals noDenormals;
+        input[0] = in[0];
+        input[1] = in[1];
+        dsp.compute(1, inputPtrs, outputPtrs);
+        out[0] = output[0];
+        out[1] = output[1];
+    }
+};
+
+using MixDSP = FaustGenerated::NS_ChaosPadMix::VCVRackDSP;
+
+/**
+ * ChaosPad - Kaoss Pad-style multi-FX
+ *
+ * Each effect is its own DSP (FxUnit) and only the selected one runs.
+ * Switching effects clears the incoming unit and crossfades to it with
+ * equal power over FADE_TIME; only during the fade do two units run.
+ * A selection made mid-fade is taken once the fade ends. The dry/wet mix
+ * bus (faustDsp) takes the dry input and the unit output.
+ */
+struct ChaosPad : FaustModule<MixDSP> {
     enum ParamId {
         X_PARAM,
         Y_PARAM,
@@ -79,6 +188,15 @@ struct ChaosPad : FaustModule<VCVRackDSP> {
         "Pitch", "Reverb", "Flanger", "RingMod"
     };
 
+    static constexpr int NUM_FX = 8;
+    static constexpr float FADE_TIME = 0.02f;   // Seconds
+
+    // Effect units, in fx_select order
+    std::unique_ptr<FxUnit> fx[NUM_FX];
+    int activeFx = 0;
+    int fadingFx = -1;       // Outgoing unit during a crossfade
+    float fadePhase = 1.f;   // 0 -> 1 over the crossfade
+
     ChaosPad() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -124,12 +242,70 @@ struct ChaosPad : FaustModule<VCVRackDSP> {
         configOutput(RIGHT_OUTPUT, "Audio R");
 
         // No mapParam/mapCVInput - we handle everything manually in process()
+
+        fx[0].reset(new FxVoice<FaustGenerated::NS_ChaosPadLPF::VCVRackDSP>());
+        fx[1].reset(new FxVoice<FaustGenerated::NS_ChaosPadBitcrush::VCVRackDSP>());
+        fx[2].reset(new FxVoice<FaustGenerated::NS_ChaosPadDelay::VCVRackDSP>());
+        fx[3].reset(new FxVoice<FaustGenerated::NS_ChaosPadGrain::VCVRackDSP>());
+        fx[4].reset(new FxVoice<FaustGenerated::NS_ChaosPadPitch::VCVRackDSP>());
+        fx[5].reset(new FxVoice<FaustGenerated::NS_ChaosPadReverb::VCVRackDSP>());
+        fx[6].reset(new FxVoice<FaustGenerated::NS_ChaosPadFlanger::VCVRackDSP>());
+        fx[7].reset(new FxVoice<FaustGenerated::NS_ChaosPadRingMod::VCVRackDSP>());
+    }
+
+    void initUnits(int sampleRate) {
+        for (auto& unit : fx) unit->init(sampleRate);
+    }
+
+    // Idle units are cleared when selected, so only the running ones here
+    void clearRunningUnits() {
+        fx[activeFx]->clear();
+        if (fadingFx >= 0) fx[fadingFx]->clear();
+    }
+
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        FaustModule::onSampleRateChange(e);
+        initUnits(static_cast<int>(e.sampleRate));
+    }
+
+    void onReset() override {
+        FaustModule::onReset();
+        for (auto& unit : fx) unit->clear();
+        activeFx = 0;
+        fadingFx = -1;
+        fadePhase = 1.f;
+        latchState = false;
+        gateEnv = 0.f;
+        clockTrigger.reset();
+        timeSinceClock = 0.f;
+        clockPeriod = 0.5f;
+        clockDetected = false;
+    }
+
+    // Start a crossfade to the selected effect unless one is running
+    void updateSelection(int selected, float sampleTime) {
+        if (fadingFx >= 0) {
+            fadePhase += sampleTime / FADE_TIME;
+            if (fadePhase < 1.f) return;
+            fadePhase = 1.f;
+            fadingFx = -1;
+        }
+        if (selected == activeFx) return;
+
+        // The unit has been idle: drop its stale delay lines and tails
+        fx[selected]->clear();
+        fadingFx = activeFx;
+        activeFx = selected;
+        fadePhase = 0.f;
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
+            initUnits(static_cast<int>(args.sampleRate));
             initialized = true;
         }
 
@@ -183,18 +359,18 @@ struct ChaosPad : FaustModule<VCVRackDSP> {
         int divMultIdx = clamp((int)std::round(params[CLOCK_DIV_PARAM].getValue()), 0, NUM_DIVMULT - 1);
         float divMultRatio = DIVMULT_VALUES[divMultIdx];
 
-        // --- Set Faust parameters (alphabetical order) ---
-        // 0=clock_period, 1=clock_synced, 2=div_mult, 3=fx_select,
-        // 4=gate_env, 5=mix, 6=x, 7=y, 8=z
-        faustDsp.setParamValue(0, clockPeriod);
-        faustDsp.setParamValue(1, clockDetected ? 1.f : 0.f);
-        faustDsp.setParamValue(2, divMultRatio);
-        faustDsp.setParamValue(3, fxSel);
-        faustDsp.setParamValue(4, gateEnv);
-        faustDsp.setParamValue(5, params[MIX_PARAM].getValue());
-        faustDsp.setParamValue(6, xVal);
-        faustDsp.setParamValue(7, yVal);
-        faustDsp.setParamValue(8, zVal);
+        // --- Set Faust parameters ---
+        float controls[FxUnit::NUM_CONTROLS];
+        controls[FxUnit::CLOCK_PERIOD] = clockPeriod;
+        controls[FxUnit::CLOCK_SYNCED] = clockDetected ? 1.f : 0.f;
+        controls[FxUnit::DIV_MULT] = divMultRatio;
+        controls[FxUnit::GATE_ENV] = gateEnv;
+        controls[FxUnit::X] = xVal;
+        controls[FxUnit::Y] = yVal;
+        controls[FxUnit::Z] = zVal;
+        faustDsp.setParamValue(FP::MIX, params[MIX_PARAM].getValue());
+
+        updateSelection(static_cast<int>(fxSel), dt);
 
         // --- Audio I/O ---
         // Get stereo input (mono-normalized: R copies L if disconnected)
@@ -203,11 +379,31 @@ struct ChaosPad : FaustModule<VCVRackDSP> {
             ? inputs[RIGHT_INPUT].getVoltage() * 0.2f
             : inL;
 
-        float* inputPtrs[2] = { &inL, &inR };
-        float outL = 0.f, outR = 0.f;
-        float* outputPtrs[2] = { &outL, &outR };
+        // --- Effect units (two only while crossfading) ---
+        // The deferred rate-change clear lands this frame: clear the units too
+        if (clearCountdown == 1) clearRunningUnits();
+
+        float dry[2] = { inL, inR };
+        float wet[2] = {};
+        fx[activeFx]->setControls(controls);
+        fx[activeFx]->computeFrame(dry, wet);
+        if (fadingFx >= 0) {
+            float outgoing[2] = {};
+            fx[fadingFx]->setControls(controls);
+            fx[fadingFx]->computeFrame(dry, outgoing);
+            // Equal power: cos/sin quarter-wave
+            float gainIn = std::sin(fadePhase * 0.5f * float(M_PI));
+            float gainOut = std::cos(fadePhase * 0.5f * float(M_PI));
+            wet[0] = wet[0] * gainIn + outgoing[0] * gainOut;
+            wet[1] = wet[1] * gainIn + outgoing[1] * gainOut;
+        }
+
+        // --- Dry/wet mix bus ---
+        float frameIn[4] = { dry[0], dry[1], wet[0], wet[1] };
+        float frameOut[2] = {};
 
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        computeFrame(frameIn, frameOut);
+        float outL = frameOut[0], outR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outL * 5.f);
@@ -315,6 +511,14 @@ struct ChaosPadWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(col5, row7), module, ChaosPad::RIGHT_OUTPUT));
     }
+
+#ifdef WR_PROFILE
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<ChaosPad*>(this->module);
+        if (!m) return;
+        WR_PROFILE_MENU(menu, m);
+    }
+#endif
 };
 
 } // namespace WiggleRoom
@@ -63,6 +63,18 @@ fx5 = fx_reverb(x, y, z, gate_env, clock_period, clock_synced, div_mult);
 fx6 = fx_flanger(x, y, z, gate_env, clock_period, clock_synced, div_mult);
 fx7 = fx_ringmod(x, y, z, gate_env, clock_period, clock_synced, div_mult);
 
+// Each effect is also its own entry point, compiled as a separate DSP for
+// the module (-pn <name>_fx, see CMakeLists.txt) so only the selected one
+// runs; the module crossfades between units when the selection changes
+lpf_fx = fx0;
+bitcrush_fx = fx1;
+delay_fx = fx2;
+grain_fx = fx3;
+pitch_fx = fx4;
+reverb_fx = fx5;
+flanger_fx = fx6;
+ringmod_fx = fx7;
+
 // Split stereo input to all 8 effects, producing 16 outputs (8 stereo pairs)
 // Route: deinterleave L/R so first 8 are all L channels, last 8 are all R channels
 // Then ba.selectn picks the active channel from each group
@@ -89,9 +101,13 @@ dry_wet(dl, dr, wl, wr) =
     ,
     ((dr * (1.0 - mix) + wr * mix) : fi.dcblocker : ma.tanh);
 
+// Mix bus for the module: (dry_l, dry_r, wet_l, wet_r) -> (out_l, out_r)
+mix_bus = dry_wet;
+
 // ==========================================================
 // MAIN PROCESS
 // ==========================================================
 
+// All-in-one version (test harness): every effect runs, fx_select picks one
 // Split stereo input: one copy goes dry, one copy through FX, then mix
 process = _, _ <: (_, _), fx_select_stereo : dry_wet;
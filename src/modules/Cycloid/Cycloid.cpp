@@ -5,8 +5,11 @@
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "CachedDisplay.hpp"
+#include "ClockBus.hpp"
 #include "DSP.hpp"
 #include "ImagePanel.hpp"
+#include "ScopeRing.hpp"
 #include <atomic>
 #include <cmath>
 #include <array>
@@ -33,6 +36,62 @@ inline bool euclideanHit(int step, int hits, int divisions) {
     return ((step * hits) % divisions) < hits;
 }
 
+/**
+ * Unit phasor (cos, sin of a phase in cycles) advanced by complex multiply
+ *
+ * The per-sample rotation is only rebuilt when the step changes (speed,
+ * ratio, clock period, sample rate). The rotor tracks the phase it has
+ * reached and re-seeds from the exact phase with one cos/sin pair when the
+ * caller's phase jumps away from it (clock resync, reset, speed change).
+ */
+struct Rotor {
+    static constexpr double RESYNC_TOLERANCE = 1e-7;  // Cycles
+    static constexpr int NORMALIZE_INTERVAL = 256;     // Samples
+
+    double re = 1.0;        // cos(2 pi phase)
+    double im = 0.0;        // sin(2 pi phase)
+    double phase = 0.0;     // Unwrapped phase the phasor represents
+    double step = 0.0;      // Cycles per sample the rotation was built for
+    double stepRe = 1.0;
+    double stepIm = 0.0;
+    int sinceNormalize = 0;
+
+    void seed(double cycles) {
+        double angle = 2.0 * M_PI * (cycles - std::floor(cycles));
+        re = std::cos(angle);
+        im = std::sin(angle);
+        phase = cycles;
+        sinceNormalize = 0;
+    }
+
+    // Move to `cycles`, expected to be one `newStep` past the last call
+    void advance(double cycles, double newStep) {
+        if (newStep != step) {
+            step = newStep;
+            stepRe = std::cos(2.0 * M_PI * step);
+            stepIm = std::sin(2.0 * M_PI * step);
+        }
+
+        phase += step;
+        if (std::abs(cycles - phase) > RESYNC_TOLERANCE) {
+            seed(cycles);
+            return;
+        }
+
+        double r = re * stepRe - im * stepIm;
+        im = re * stepIm + im * stepRe;
+        re = r;
+
+        // Pull |z| back to 1 (first-order; rounding drift is ~1e-16 per step)
+        if (++sinceNormalize >= NORMALIZE_INTERVAL) {
+            sinceNormalize = 0;
+            double k = 1.5 - 0.5 * (re * re + im * im);
+            re *= k;
+            im *= k;
+        }
+    }
+};
+
 struct Cycloid : Module {
     enum ParamId {
         SPEED_PARAM,
@@ -65,15 +124,19 @@ struct Cycloid : Module {
 
     // Clock detection
     dsp::SchmittTrigger clockTrigger;
+    ClockBus::Reader clockBus;
     dsp::SchmittTrigger resetTrigger;
     dsp::PulseGenerator triggerPulse;
 
-    // Master clock phase (advances by 1.0 per clock pulse)
-    float masterPhase = 0.0f;
+    // Master clock phase (advances by 1.0 per clock pulse). Double so the
+    // internal clock keeps advancing once the phase grows large.
+    double masterPhase = 0.0;
 
     // LFO phases
     float mainPhase = 0.0f;   // Primary rotation (0.0 to 1.0)
     float modPhase = 0.0f;    // Secondary/warp rotation
+    Rotor mainRotor;
+    Rotor modRotor;
 
     // Calculated hand position (for display and output)
     float handX = 0.0f;
@@ -82,16 +145,16 @@ struct Cycloid : Module {
 
     // Clock period tracking for smooth interpolation
     float lastClockPeriod = DEFAULT_CLOCK_PERIOD;
-    float timeSinceLastClock = 0.0f;
-    float masterPhaseAtLastClock = 0.0f;
+    double timeSinceLastClock = 0.0;
+    double masterPhaseAtLastClock = 0.0;
 
     // Slice detection state
     int lastSlice = -1;
 
     // Thread-safe visualization data
-    std::atomic<float> displayMainPhase{0.0f};
-    std::atomic<float> displayModPhase{0.0f};
     std::atomic<float> displayHandAngle{0.0f};
+    std::atomic<float> displayHandX{1.0f};    // Hand position before output scaling
+    std::atomic<float> displayHandY{0.0f};
     std::atomic<float> displayDepth{0.0f};
     std::atomic<int> displayDivisions{8};
     std::atomic<int> displayHits{8};
@@ -99,6 +162,11 @@ struct Cycloid : Module {
     std::atomic<float> displayFlashTime{-1.0f};
     std::atomic<int> displayFlashSlice{-1};
 
+    // Spirograph trail for the display: hand position, TRAIL_RATE points per second
+    static constexpr int TRAIL_LENGTH = 64;
+    static constexpr float TRAIL_RATE = 60.0f;
+    ScopeRing<TRAIL_LENGTH, 2> trail;
+
     // Cached Euclidean pattern for display (simple array, not atomic - ok for display)
     bool euclideanPattern[MAX_DIVISIONS] = {false};
 
@@ -146,16 +214,20 @@ struct Cycloid : Module {
         for (int i = 0; i < MAX_DIVISIONS; i++) {
             euclideanPattern[i] = false;
         }
+
+        trail.setPeakHold(false);
     }
 
     void onReset() override {
-        masterPhase = 0.0f;
+        masterPhase = 0.0;
         mainPhase = 0.0f;
         modPhase = 0.0f;
+        mainRotor.seed(0.0);
+        modRotor.seed(0.0);
         lastSlice = -1;
-        timeSinceLastClock = 0.0f;
+        timeSinceLastClock = 0.0;
         lastClockPeriod = DEFAULT_CLOCK_PERIOD;
-        masterPhaseAtLastClock = 0.0f;
+        masterPhaseAtLastClock = 0.0;
         displayFlashTime.store(-1.0f);
         displayFlashSlice.store(-1);
     }
@@ -206,37 +278,52 @@ struct Cycloid : Module {
         // Clock handling - master phase is locked to clock
         timeSinceLastClock += args.sampleTime;
 
-        float currentMasterPhase;
-        if (inputs[CLOCK_INPUT].isConnected()) {
+        double currentMasterPhase;
+        double masterStep;
+        if (clockBus.read(inputs[CLOCK_INPUT])) {
+            // PreFlightClock's bus: exact period, and the beat phase in
+            // place of interpolating from the last edge
+            if (clockBus.edge) {
+                masterPhase += 1.0;
+                masterPhaseAtLastClock = masterPhase;
+            }
+            lastClockPeriod = std::max(clockBus.period, 0.001f);
+            timeSinceLastClock = clockBus.phase * lastClockPeriod;
+            currentMasterPhase = masterPhaseAtLastClock + clockBus.phase;
+            masterStep = args.sampleTime / (double)lastClockPeriod;
+        } else if (inputs[CLOCK_INPUT].isConnected()) {
             if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), SCHMITT_LOW, SCHMITT_HIGH)) {
-                lastClockPeriod = std::max(timeSinceLastClock, 0.001f);
-                timeSinceLastClock = 0.0f;
-                masterPhase += 1.0f;
+                lastClockPeriod = std::max((float)timeSinceLastClock, 0.001f);
+                timeSinceLastClock = 0.0;
+                masterPhase += 1.0;
                 masterPhaseAtLastClock = masterPhase;
             }
             currentMasterPhase = masterPhaseAtLastClock + (timeSinceLastClock / lastClockPeriod);
+            masterStep = args.sampleTime / (double)lastClockPeriod;
         } else {
-            float masterIncrement = INTERNAL_CLOCK_FREQ * args.sampleTime;
-            masterPhase += masterIncrement;
+            masterStep = INTERNAL_CLOCK_FREQ * (double)args.sampleTime;
+            masterPhase += masterStep;
             currentMasterPhase = masterPhase;
         }
 
-        // Calculate main and mod phases
-        mainPhase = currentMasterPhase * speedRatio;
-        modPhase = currentMasterPhase * speedRatio * warpRatio;
-
-        // Wrap phases
-        mainPhase = mainPhase - std::floor(mainPhase);
-        modPhase = modPhase - std::floor(modPhase);
+        // Calculate main and mod phases (unwrapped, in cycles)
+        double mainCycles = currentMasterPhase * speedRatio;
+        double modCycles = mainCycles * warpRatio;
+        mainPhase = (float)(mainCycles - std::floor(mainCycles));
+        modPhase = (float)(modCycles - std::floor(modCycles));
 
         // Spirograph calculation
-        // Main circle + secondary circle (epicycle)
-        float t1 = mainPhase * DSP::TWO_PI;
-        float t2 = modPhase * DSP::TWO_PI;
+        // Main circle + secondary circle (epicycle), both rotated by complex multiply
+        mainRotor.advance(mainCycles, masterStep * speedRatio);
+        modRotor.advance(modCycles, masterStep * speedRatio * warpRatio);
 
         // Vector addition: main rotation + depth-scaled secondary rotation
-        handX = std::cos(t1) + depth * std::cos(t2);
-        handY = std::sin(t1) + depth * std::sin(t2);
+        handX = (float)(mainRotor.re + depth * modRotor.re);
+        handY = (float)(mainRotor.im + depth * modRotor.im);
+
+        trail.setDecimation((int)(args.sampleRate / TRAIL_RATE));
+        float hand[2] = {handX, handY};
+        trail.push(hand);
 
         // Calculate resulting angle (for slice detection)
         handAngle = std::atan2(handY, handX);
@@ -249,9 +336,9 @@ struct Cycloid : Module {
         if (adjustedAngle >= 1.0f) adjustedAngle -= 1.0f;
 
         // Update display
-        displayMainPhase.store(mainPhase);
-        displayModPhase.store(modPhase);
         displayHandAngle.store(normalizedAngle);
+        displayHandX.store(handX);
+        displayHandY.store(handY);
 
         // Calculate current slice
         int currentSlice = (int)std::floor(adjustedAngle * divisions);
@@ -295,27 +382,47 @@ struct Cycloid : Module {
     }
 };
 
-// Radar display widget
-struct CycloidDisplay : LightWidget {
+// Radar display widget. The background, division spokes and polygon only
+// change with DIVISIONS/OFFSET, so they live in the cached static layer.
+struct CycloidDisplay : WiggleRoom::CachedDisplay<TransparentWidget> {
     Cycloid* module = nullptr;
 
-    // Trail history for spirograph visualization
-    static constexpr int TRAIL_LENGTH = 64;
-    float trailX[TRAIL_LENGTH] = {0};
-    float trailY[TRAIL_LENGTH] = {0};
-    int trailIndex = 0;
-    float lastMainPhase = -1.0f;
+    // Latest copy of the module's spirograph trail
+    decltype(Cycloid::trail)::Frame trailFrames[Cycloid::TRAIL_LENGTH];
 
     CycloidDisplay() {
         box.size = Vec(120.f, 120.f);
+        staticLayer = 1;
+    }
+
+    int divisions() {
+        return clamp(module->displayDivisions.load(), 1, MAX_DIVISIONS);
+    }
+
+    float radius() {
+        return std::min(box.size.x, box.size.y) / 2.0f - 8.0f;
     }
 
-    void drawLayer(const DrawArgs& args, int layer) override {
-        if (layer != 1) return;
+    uint64_t staticGeneration() override {
+        if (!module) return 0;
+        return mix(mix(1, divisions()), module->displayOffset.load());
+    }
+
+    uint64_t dataGeneration() override {
+        if (!module) return 0;
+        uint64_t key = mix(0, static_cast<uint64_t>(module->trail.framesPublished()));
+        key = mix(key, module->displayHits.load());
+        key = mix(key, module->displayFlashSlice.load());
+        key = mix(key, module->displayFlashTime.load());
+        key = mix(key, module->displayDepth.load());
+        key = mix(key, module->displayHandX.load());
+        return mix(key, module->displayHandY.load());
+    }
 
+    void drawStatic(const DrawArgs& args) override {
         float cx = box.size.x / 2.0f;
         float cy = box.size.y / 2.0f;
-        float radius = std::min(cx, cy) - 8.0f;
+        float radius = this->radius();
 
         // Background circle (translucent)
         nvgBeginPath(args.vg);
@@ -338,50 +445,8 @@ struct CycloidDisplay : LightWidget {
             return;
         }
 
-        // Read atomic values
-        float mainPhase = module->displayMainPhase.load();
-        float modPhase = module->displayModPhase.load();
-        float depth = module->displayDepth.load();
-        int divisions = module->displayDivisions.load();
-        int hits = module->displayHits.load();
+        int divisions = this->divisions();
         float offset = module->displayOffset.load();
-        float flashTime = module->displayFlashTime.load();
-        int flashSlice = module->displayFlashSlice.load();
-
-        if (divisions < 1) divisions = 1;
-        if (hits < 1) hits = 1;
-        if (hits > divisions) hits = divisions;
-
-        // Update trail if phase changed significantly
-        if (std::abs(mainPhase - lastMainPhase) > 0.005f || mainPhase < lastMainPhase) {
-            float t1 = mainPhase * DSP::TWO_PI;
-            float t2 = modPhase * DSP::TWO_PI;
-            trailX[trailIndex] = std::cos(t1) + depth * std::cos(t2);
-            trailY[trailIndex] = std::sin(t1) + depth * std::sin(t2);
-            trailIndex = (trailIndex + 1) % TRAIL_LENGTH;
-            lastMainPhase = mainPhase;
-        }
-
-        // Draw spirograph trail (if depth > 0)
-        if (depth > 0.01f) {
-            nvgBeginPath(args.vg);
-            float scale = radius * 0.45f / (1.0f + depth);
-            bool first = true;
-            for (int i = 0; i < TRAIL_LENGTH; i++) {
-                int idx = (trailIndex + i) % TRAIL_LENGTH;
-                float x = cx + trailX[idx] * scale;
-                float y = cy + trailY[idx] * scale;
-                if (first) {
-                    nvgMoveTo(args.vg, x, y);
-                    first = false;
-                } else {
-                    nvgLineTo(args.vg, x, y);
-                }
-            }
-            nvgStrokeWidth(args.vg, 1.0f);
-            nvgStrokeColor(args.vg, nvgRGBA(0, 150, 200, 80));
-            nvgStroke(args.vg);
-        }
 
         // Draw division spokes (dim)
         for (int i = 0; i < divisions; i++) {
@@ -425,6 +490,48 @@ struct CycloidDisplay : LightWidget {
             nvgFill(args.vg);
         }
 
+        // Outer ring
+        nvgBeginPath(args.vg);
+        nvgCircle(args.vg, cx, cy, radius + 2.0f);
+        nvgStrokeWidth(args.vg, 1.0f);
+        nvgStrokeColor(args.vg, nvgRGBA(80, 80, 100, 150));
+        nvgStroke(args.vg);
+    }
+
+    void drawDynamic(const DrawArgs& args) override {
+        if (!module) return;
+
+        float cx = box.size.x / 2.0f;
+        float cy = box.size.y / 2.0f;
+        float radius = this->radius();
+
+        // Read atomic values
+        float depth = module->displayDepth.load();
+        int divisions = this->divisions();
+        float offset = module->displayOffset.load();
+        float flashTime = module->displayFlashTime.load();
+        int flashSlice = module->displayFlashSlice.load();
+
+        // Draw spirograph trail (if depth > 0)
+        int trailCount = module->trail.snapshot(trailFrames, Cycloid::TRAIL_LENGTH);
+        if (depth > 0.01f && trailCount > 1) {
+            nvgBeginPath(args.vg);
+            float scale = radius * 0.45f / (1.0f + depth);
+            for (int i = 0; i < trailCount; i++) {
+                // Peak hold is off, so min == max == the sampled position
+                float x = cx + trailFrames[i].min[0] * scale;
+                float y = cy + trailFrames[i].min[1] * scale;
+                if (i == 0) {
+                    nvgMoveTo(args.vg, x, y);
+                } else {
+                    nvgLineTo(args.vg, x, y);
+                }
+            }
+            nvgStrokeWidth(args.vg, 1.0f);
+            nvgStrokeColor(args.vg, nvgRGBA(0, 150, 200, 80));
+            nvgStroke(args.vg);
+        }
+
         // Draw hit vertices (larger, brighter)
         for (int i = 0; i < divisions; i++) {
             bool isHit = module->euclideanPattern[i];
@@ -464,11 +571,9 @@ struct CycloidDisplay : LightWidget {
             nvgFill(args.vg);
         }
 
-        // Calculate hand position with spirograph
-        float t1 = mainPhase * DSP::TWO_PI;
-        float t2 = modPhase * DSP::TWO_PI;
-        float hx = std::cos(t1) + depth * std::cos(t2);
-        float hy = std::sin(t1) + depth * std::sin(t2);
+        // Hand position as computed by the audio thread
+        float hx = module->displayHandX.load();
+        float hy = module->displayHandY.load();
 
         // Scale and rotate to display coordinates
         float handScale = radius * 0.45f / (1.0f + depth);
@@ -505,13 +610,6 @@ struct CycloidDisplay : LightWidget {
         nvgCircle(args.vg, cx, cy, 3.0f);
         nvgFillColor(args.vg, nvgRGB(150, 150, 180));
         nvgFill(args.vg);
-
-        // Outer ring
-        nvgBeginPath(args.vg);
-        nvgCircle(args.vg, cx, cy, radius + 2.0f);
-        nvgStrokeWidth(args.vg, 1.0f);
-        nvgStrokeColor(args.vg, nvgRGBA(80, 80, 100, 150));
-        nvgStroke(args.vg);
     }
 };
 
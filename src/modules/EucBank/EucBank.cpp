@@ -4,19 +4,36 @@
  *
  * Features:
  *   - 16 bank slots for storing complete chain state
- *   - Save/Load buttons
+ *   - Save/Load buttons; Load recalls the slot into LogicMangler and EucSeq
  *   - Bank select knob (0-15)
- *   - Step trigger input for bank sequencing
+ *   - Step trigger input for bank sequencing (optionally recalling each
+ *     bank as it is reached, or holding Load until the next step)
  *   - Left expander reads from LogicMangler
  *   - Right expander passes CV values to EucMix
+ *
+ * Slots are plain-data snapshots in a fixed pool, so saving and recalling
+ * from process() is a copy with no allocation; recall posts the slot to
+ * the left neighbour's mailbox (see euclogic/Snapshot.hpp) and JSON is
+ * only built in dataToJson()/dataFromJson().
+ *
+ * A recall is posted on the sample of the STEP/RESET edge but is not
+ * sample-accurate at EucSeq: each hop is taken on the neighbour's next
+ * process(), so the pattern arrives up to a few samples later. If EucSeq
+ * is clocked by the same edge, that edge's tick still plays the old
+ * pattern and the recalled one starts on the following tick. Step
+ * EucBank slightly ahead of EucSeq's clock for the recall to land on it.
+ *
+ * Slots and module are templated on channel count (N <= 8) to match the
+ * N-channel Euclogic chain; the panel uses N = 4.
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "DSP.hpp"
 #include "ImagePanel.hpp"
 #include "euclogic/ExpanderMessage.hpp"
-#include <string>
-#include <array>
+#include "euclogic/Snapshot.hpp"
+#include <cstring>
+#include <type_traits>
 
 using namespace rack;
 
@@ -28,39 +45,25 @@ namespace WiggleRoom {
 // Bank slot data
 // ============================================================================
 
-struct BankSlot {
-    // EucSeq state
-    int steps[4] = {16, 16, 16, 16};
-    int hits[4] = {8, 8, 8, 8};
-    int quant[4] = {0, 0, 0, 0};
-    float probA[4] = {1.f, 1.f, 1.f, 1.f};
-    bool retrigger[4] = {true, true, true, true};
-    bool bipolar[4] = {false, false, false, false};
-    float speed = 8.f;  // x1 index
-    float swing = 50.f;
-
-    // LogicMangler state
-    uint8_t truthTableMapping[16];
-    uint8_t truthTableLocks[16];
-    float probB[4] = {1.f, 1.f, 1.f, 1.f};
-    float colDensity[4] = {0.5f, 0.5f, 0.5f, 0.5f};
-
-    std::string name;
-    bool occupied = false;
+template<int N>
+struct BankSlotT {
+    using Snapshot = EuclogicSnapshotT<N>;
+    static constexpr int N_STATES = 1 << N;
+    static constexpr int NAME_LENGTH = 24;
 
-    BankSlot() {
-        for (int i = 0; i < 16; i++) {
-            truthTableMapping[i] = static_cast<uint8_t>(i) & 0x0F;
-            truthTableLocks[i] = 0;
-        }
-    }
+    Snapshot snapshot;          // EucSeq params + LogicMangler table and knobs
+    char name[NAME_LENGTH] = {};
+    bool occupied = false;
 
     json_t* toJson() const {
+        const auto& seq = snapshot.seq;
+        const auto& logic = snapshot.logic;
+
         json_t* rootJ = json_object();
         json_object_set_new(rootJ, "occupied", json_boolean(occupied));
-        json_object_set_new(rootJ, "name", json_string(name.c_str()));
-        json_object_set_new(rootJ, "speed", json_real(speed));
-        json_object_set_new(rootJ, "swing", json_real(swing));
+        json_object_set_new(rootJ, "name", json_string(name));
+        json_object_set_new(rootJ, "speed", json_real(seq.speed));
+        json_object_set_new(rootJ, "swing", json_real(seq.swing));
 
         json_t* stepsJ = json_array();
         json_t* hitsJ = json_array();
@@ -70,15 +73,15 @@ struct BankSlot {
         json_t* bipolarJ = json_array();
         json_t* probBJ = json_array();
         json_t* densJ = json_array();
-        for (int i = 0; i < 4; i++) {
-            json_array_append_new(stepsJ, json_integer(steps[i]));
-            json_array_append_new(hitsJ, json_integer(hits[i]));
-            json_array_append_new(quantJ, json_integer(quant[i]));
-            json_array_append_new(probAJ, json_real(probA[i]));
-            json_array_append_new(retrigJ, json_boolean(retrigger[i]));
-            json_array_append_new(bipolarJ, json_boolean(bipolar[i]));
-            json_array_append_new(probBJ, json_real(probB[i]));
-            json_array_append_new(densJ, json_real(colDensity[i]));
+        for (int i = 0; i < N; i++) {
+            json_array_append_new(stepsJ, json_integer(seq.steps[i]));
+            json_array_append_new(hitsJ, json_integer(seq.hits[i]));
+            json_array_append_new(quantJ, json_integer(seq.quant[i]));
+            json_array_append_new(probAJ, json_real(seq.probA[i]));
+            json_array_append_new(retrigJ, json_boolean(seq.retrigger[i]));
+            json_array_append_new(bipolarJ, json_boolean(seq.bipolar[i]));
+            json_array_append_new(probBJ, json_real(logic.probB[i]));
+            json_array_append_new(densJ, json_real(logic.colDensity[i]));
         }
         json_object_set_new(rootJ, "steps", stepsJ);
         json_object_set_new(rootJ, "hits", hitsJ);
@@ -91,9 +94,9 @@ struct BankSlot {
 
         json_t* ttJ = json_array();
         json_t* lockJ = json_array();
-        for (int i = 0; i < 16; i++) {
-            json_array_append_new(ttJ, json_integer(truthTableMapping[i]));
-            json_array_append_new(lockJ, json_integer(truthTableLocks[i]));
+        for (int i = 0; i < N_STATES; i++) {
+            json_array_append_new(ttJ, json_integer(logic.truthTableMapping[i]));
+            json_array_append_new(lockJ, json_integer(logic.truthTableLocks[i]));
         }
         json_object_set_new(rootJ, "truthTable", ttJ);
         json_object_set_new(rootJ, "lockMask", lockJ);
@@ -102,17 +105,23 @@ struct BankSlot {
     }
 
     void fromJson(json_t* rootJ) {
+        auto& seq = snapshot.seq;
+        auto& logic = snapshot.logic;
+
         json_t* occJ = json_object_get(rootJ, "occupied");
         if (occJ) occupied = json_boolean_value(occJ);
 
         json_t* nameJ = json_object_get(rootJ, "name");
-        if (nameJ) name = json_string_value(nameJ);
+        if (nameJ && json_is_string(nameJ)) {
+            std::strncpy(name, json_string_value(nameJ), NAME_LENGTH - 1);
+            name[NAME_LENGTH - 1] = '\0';
+        }
 
         json_t* speedJ = json_object_get(rootJ, "speed");
-        if (speedJ) speed = json_real_value(speedJ);
+        if (speedJ) seq.speed = json_real_value(speedJ);
 
         json_t* swingJ = json_object_get(rootJ, "swing");
-        if (swingJ) swing = json_real_value(swingJ);
+        if (swingJ) seq.swing = json_real_value(swingJ);
 
         auto readIntArray = [](json_t* arrJ, int* dest, int count) {
             if (arrJ && json_is_array(arrJ)) {
@@ -133,14 +142,14 @@ struct BankSlot {
             }
         };
 
-        readIntArray(json_object_get(rootJ, "steps"), steps, 4);
-        readIntArray(json_object_get(rootJ, "hits"), hits, 4);
-        readIntArray(json_object_get(rootJ, "quant"), quant, 4);
-        readFloatArray(json_object_get(rootJ, "probA"), probA, 4);
-        readBoolArray(json_object_get(rootJ, "retrigger"), retrigger, 4);
-        readBoolArray(json_object_get(rootJ, "bipolar"), bipolar, 4);
-        readFloatArray(json_object_get(rootJ, "probB"), probB, 4);
-        readFloatArray(json_object_get(rootJ, "colDensity"), colDensity, 4);
+        readIntArray(json_object_get(rootJ, "steps"), seq.steps, N);
+        readIntArray(json_object_get(rootJ, "hits"), seq.hits, N);
+        readIntArray(json_object_get(rootJ, "quant"), seq.quant, N);
+        readFloatArray(json_object_get(rootJ, "probA"), seq.probA, N);
+        readBoolArray(json_object_get(rootJ, "retrigger"), seq.retrigger, N);
+        readBoolArray(json_object_get(rootJ, "bipolar"), seq.bipolar, N);
+        readFloatArray(json_object_get(rootJ, "probB"), logic.probB, N);
+        readFloatArray(json_object_get(rootJ, "colDensity"), logic.colDensity, N);
 
         auto readUint8Array = [](json_t* arrJ, uint8_t* dest, int count) {
             if (arrJ && json_is_array(arrJ)) {
@@ -148,8 +157,8 @@ struct BankSlot {
                     dest[i] = json_integer_value(json_array_get(arrJ, i));
             }
         };
-        readUint8Array(json_object_get(rootJ, "truthTable"), truthTableMapping, 16);
-        readUint8Array(json_object_get(rootJ, "lockMask"), truthTableLocks, 16);
+        readUint8Array(json_object_get(rootJ, "truthTable"), logic.truthTableMapping, N_STATES);
+        readUint8Array(json_object_get(rootJ, "lockMask"), logic.truthTableLocks, N_STATES);
     }
 };
 
@@ -157,7 +166,15 @@ struct BankSlot {
 // EucBank Module
 // ============================================================================
 
-struct EucBankModule : Module {
+template<int N>
+struct EucBankModuleT : Module {
+    using Message = EuclogicExpanderMessageT<N>;
+    using BankSlot = BankSlotT<N>;
+    using RecallTarget = EuclogicRecallTargetT<N>;
+
+    static_assert(std::is_trivially_copyable<BankSlot>::value, "Bank slots must copy without allocating");
+
+    static constexpr int NUM_CHANNELS = N;
     static constexpr int NUM_BANKS = 16;
 
     enum ParamId {
@@ -186,6 +203,12 @@ struct EucBankModule : Module {
     BankSlot banks[NUM_BANKS];
     int currentBank = 0;
 
+    // Recall
+    bool recallOnStep = false;     // STEP/RESET also load the bank they select
+    bool loadOnClock = false;      // LOAD waits for the next STEP edge
+    bool loadQueued = false;
+    int recallBank = -1;           // Bank still to be delivered, -1 = none
+
     dsp::SchmittTrigger saveTrigger;
     dsp::SchmittTrigger loadTrigger;
     dsp::SchmittTrigger stepTrigger;
@@ -195,9 +218,9 @@ struct EucBankModule : Module {
     dsp::PulseGenerator loadPulse;
 
     // Expander messages
-    EuclogicExpanderMessage rightMessages[2];
+    Message rightMessages[2];
 
-    EucBankModule() {
+    EucBankModuleT() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
         configParam(BANK_PARAM, 0.f, 15.f, 0.f, "Bank");
@@ -223,77 +246,95 @@ struct EucBankModule : Module {
         currentBank = DSP::clamp(currentBank, 0, NUM_BANKS - 1);
 
         // Step trigger
+        bool stepped = false;
         if (stepTrigger.process(inputs[STEP_INPUT].getVoltage(), 0.1f, 1.0f)) {
             currentBank = (currentBank + 1) % NUM_BANKS;
             params[BANK_PARAM].setValue(currentBank);
+            stepped = true;
         }
 
         // Reset
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage(), 0.1f, 1.0f)) {
             currentBank = 0;
             params[BANK_PARAM].setValue(0.f);
+            stepped = true;
         }
 
         // Save: capture from left expander
         if (saveTrigger.process(params[SAVE_PARAM].getValue())) {
             if (leftExpander.module) {
-                EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(leftExpander.consumerMessage);
-                if (msg && msg->valid) {
+                const Message* msg = static_cast<const Message*>(leftExpander.consumerMessage);
+                if (msg && msg->usable()) {
                     BankSlot& slot = banks[currentBank];
-                    for (int i = 0; i < 4; i++) {
-                        slot.steps[i] = msg->steps[i];
-                        slot.hits[i] = msg->hits[i];
-                        slot.quant[i] = msg->quant[i];
-                        slot.probA[i] = msg->probA[i];
-                        slot.retrigger[i] = msg->retrigger[i];
-                        slot.bipolar[i] = msg->bipolar[i];
-                        slot.probB[i] = msg->probB[i];
-                        slot.colDensity[i] = msg->colDensity[i];
-                    }
-                    slot.speed = msg->speed;
-                    slot.swing = msg->swing;
-                    for (int i = 0; i < 16; i++) {
-                        slot.truthTableMapping[i] = msg->truthTableMapping[i];
-                        slot.truthTableLocks[i] = msg->truthTableLocks[i];
-                    }
+                    slot.snapshot.seq = msg->seq;
+                    slot.snapshot.logic = msg->logic;
                     slot.occupied = true;
                     savePulse.trigger(0.1f);
                 }
             }
         }
 
-        // Load: currently stored for external use
+        // Load: now, or on the next step edge
         if (loadTrigger.process(params[LOAD_PARAM].getValue())) {
-            if (banks[currentBank].occupied) {
-                loadPulse.trigger(0.1f);
+            if (loadOnClock) {
+                loadQueued = true;
+            } else {
+                requestRecall(currentBank);
             }
         }
+        if (stepped && (recallOnStep || loadQueued)) {
+            loadQueued = false;
+            requestRecall(currentBank);
+        }
+        deliverRecall();
 
         lights[SAVE_LIGHT].setBrightness(savePulse.process(dt) ? 1.f : 0.f);
         lights[LOAD_LIGHT].setBrightness(loadPulse.process(dt) ? 1.f : 0.f);
 
         // Forward expander message to the right (pass-through for EucMix)
         if (rightExpander.module) {
-            EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(rightExpander.producerMessage);
+            Message* msg = static_cast<Message*>(rightExpander.producerMessage);
 
             if (leftExpander.module) {
-                EuclogicExpanderMessage* leftMsg = static_cast<EuclogicExpanderMessage*>(leftExpander.consumerMessage);
-                if (leftMsg && leftMsg->valid) {
-                    *msg = *leftMsg;
+                const Message* leftMsg = static_cast<const Message*>(leftExpander.consumerMessage);
+                if (leftMsg && leftMsg->usable()) {
+                    msg->forward(*leftMsg);
                 } else {
                     msg->clear();
                 }
             } else {
                 msg->clear();
             }
-            msg->valid = true;
+            msg->hot.valid = true;
             rightExpander.requestMessageFlip();
         }
     }
 
+    void requestRecall(int bank) {
+        if (banks[bank].occupied) {
+            recallBank = bank;
+            loadPulse.trigger(0.1f);
+        }
+    }
+
+    // Post the pending recall; retried each sample until the neighbour takes it
+    void deliverRecall() {
+        if (recallBank < 0) return;
+        RecallTarget* target = RecallTarget::of(leftExpander.module);
+        if (!target) {
+            recallBank = -1;
+            return;
+        }
+        if (target->postRecall(banks[recallBank].snapshot)) {
+            recallBank = -1;
+        }
+    }
+
     json_t* dataToJson() override {
         json_t* rootJ = json_object();
         json_object_set_new(rootJ, "currentBank", json_integer(currentBank));
+        json_object_set_new(rootJ, "recallOnStep", json_boolean(recallOnStep));
+        json_object_set_new(rootJ, "loadOnClock", json_boolean(loadOnClock));
 
         json_t* banksJ = json_array();
         for (int i = 0; i < NUM_BANKS; i++) {
@@ -308,6 +349,12 @@ struct EucBankModule : Module {
         json_t* bankJ = json_object_get(rootJ, "currentBank");
         if (bankJ) currentBank = json_integer_value(bankJ);
 
+        json_t* recallJ = json_object_get(rootJ, "recallOnStep");
+        if (recallJ) recallOnStep = json_boolean_value(recallJ);
+
+        json_t* clockJ = json_object_get(rootJ, "loadOnClock");
+        if (clockJ) loadOnClock = json_boolean_value(clockJ);
+
         json_t* banksJ = json_object_get(rootJ, "banks");
         if (banksJ && json_is_array(banksJ)) {
             for (int i = 0; i < NUM_BANKS && i < (int)json_array_size(banksJ); i++) {
@@ -317,6 +364,8 @@ struct EucBankModule : Module {
     }
 };
 
+using EucBankModule = EucBankModuleT<4>;
+
 // ============================================================================
 // Bank Display
 // ============================================================================
@@ -368,11 +417,11 @@ struct BankDisplay : LightWidget {
             }
 
             // Bank name
-            if (isOccupied && module && !module->banks[i].name.empty()) {
+            if (isOccupied && module && module->banks[i].name[0] != '\0') {
                 nvgFillColor(args.vg, nvgRGBA(180, 200, 220, 200));
                 nvgFontSize(args.vg, cellH * 0.55f);
                 nvgTextAlign(args.vg, NVG_ALIGN_LEFT | NVG_ALIGN_MIDDLE);
-                nvgText(args.vg, 18.f, y + cellH / 2.f, module->banks[i].name.c_str(), nullptr);
+                nvgText(args.vg, 18.f, y + cellH / 2.f, module->banks[i].name, nullptr);
             }
         }
 
@@ -424,6 +473,14 @@ struct EucBankWidget : ModuleWidget {
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(centerX - 8.f, yInputs)), module, EucBankModule::STEP_INPUT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(centerX + 8.f, yInputs)), module, EucBankModule::RESET_INPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<EucBankModule*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        menu->addChild(createBoolPtrMenuItem("Load bank on step/reset", "", &m->recallOnStep));
+        menu->addChild(createBoolPtrMenuItem("Hold Load until next step", "", &m->loadOnClock));
+    }
 };
 
 } // namespace WiggleRoom
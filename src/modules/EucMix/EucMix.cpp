@@ -7,10 +7,23 @@
  *   - 4x4 toggle switch matrix
  *   - 4x mixed CV outputs
  *   - Output = sum of all inputs whose column switch is on for that row
+ *   - Polyphonic: a switch routes a whole poly cable, channel by channel
+ *
+ * Templated on matrix size (EucMixModuleT<N>) to match the N-channel
+ * Euclogic chain; the panel uses N = 4.
+ *
+ * The switches are read every ROUTE_UPDATE_INTERVAL samples into a list of
+ * the cells that are on; the mix walks that list, adding four channels per
+ * float_4. Cost follows the connections in use, not N * N: the default
+ * diagonal is N adds per channel group. Each output carries as many
+ * channels as the widest input routed to it; mono inputs are added to
+ * every channel.
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "DSP.hpp"
+#include <algorithm>
+#include <cstdint>
 #include "ImagePanel.hpp"
 #include "euclogic/ExpanderMessage.hpp"
 
@@ -20,11 +33,14 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
-struct EucMixModule : Module {
-    static constexpr int SIZE = 4;
+template<int N>
+struct EucMixModuleT : Module {
+    using Message = EuclogicExpanderMessageT<N>;
+
+    static constexpr int SIZE = N;
 
     enum ParamId {
-        ENUMS(MATRIX_PARAM, SIZE * SIZE),  // 16 toggle switches
+        ENUMS(MATRIX_PARAM, SIZE * SIZE),  // row-major toggle switches
         PARAMS_LEN
     };
 
@@ -43,9 +59,26 @@ struct EucMixModule : Module {
         LIGHTS_LEN
     };
 
+    static constexpr int MAX_CHANNELS = 16;
+    static constexpr int MAX_GROUPS = MAX_CHANNELS / 4;
+    static constexpr int ROUTE_UPDATE_INTERVAL = 32;
+    static_assert(SIZE * SIZE <= 64, "switch states are packed into 64 bits");
+
+    // Cells that are on, rebuilt when a switch changes
+    struct Route {
+        uint8_t row;
+        uint8_t col;
+    };
+    Route routes[SIZE * SIZE];
+    int numRoutes = 0;
+    uint64_t routeMask = 0;
+    bool routesValid = false;
+    uint32_t usedCols = 0;      // bit c = column c feeds some row
+    int routeCounter = 0;
+
     bool expanderConnected = false;
 
-    EucMixModule() {
+    EucMixModuleT() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
         for (int row = 0; row < SIZE; row++) {
@@ -62,48 +95,113 @@ struct EucMixModule : Module {
         }
     }
 
+    // Read the switches; rebuild the route list and lights if any changed
+    void updateRoutes() {
+        uint64_t mask = 0;
+        for (int cell = 0; cell < SIZE * SIZE; cell++) {
+            if (params[MATRIX_PARAM + cell].getValue() > 0.5f) {
+                mask |= uint64_t(1) << cell;
+            }
+        }
+        if (routesValid && mask == routeMask) return;
+        routeMask = mask;
+        routesValid = true;
+
+        numRoutes = 0;
+        usedCols = 0;
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                bool on = (mask >> (row * SIZE + col)) & 1;
+                if (on) {
+                    routes[numRoutes++] = {uint8_t(row), uint8_t(col)};
+                    usedCols |= 1u << col;
+                }
+                lights[MATRIX_LIGHT + row * SIZE + col].setBrightness(on ? 1.f : 0.f);
+            }
+        }
+    }
+
     void process(const ProcessArgs& args) override {
-        // Get CV values from expander or inputs
-        float cvIn[SIZE] = {};
+        if (--routeCounter <= 0) {
+            routeCounter = ROUTE_UPDATE_INTERVAL;
+            updateRoutes();
+        }
+
+        // Get CV values from expander or inputs, four channels per float_4.
+        // Mono columns are broadcast so they add to every channel of a row.
+        simd::float_4 cvIn[SIZE][MAX_GROUPS];
+        int colChannels[SIZE] = {};
         expanderConnected = false;
 
         if (leftExpander.module) {
-            EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->valid) {
+            const Message* msg = static_cast<const Message*>(leftExpander.consumerMessage);
+            if (msg && msg->usable()) {
                 expanderConnected = true;
-                for (int i = 0; i < SIZE; i++) {
-                    cvIn[i] = msg->cv[i];
+                for (int col = 0; col < SIZE; col++) {
+                    colChannels[col] = 1;
+                    for (int g = 0; g < MAX_GROUPS; g++) {
+                        cvIn[col][g] = msg->hot.cv[col];
+                    }
                 }
             }
         }
 
         if (!expanderConnected) {
-            for (int i = 0; i < SIZE; i++) {
-                cvIn[i] = inputs[CV_INPUT + i].getVoltage();
+            for (int col = 0; col < SIZE; col++) {
+                if (!(usedCols & (1u << col))) continue;
+                Input& in = inputs[CV_INPUT + col];
+                int channels = std::max(in.getChannels(), 1);
+                colChannels[col] = channels;
+                if (channels == 1) {
+                    simd::float_4 v = in.getVoltage();
+                    for (int g = 0; g < MAX_GROUPS; g++) {
+                        cvIn[col][g] = v;
+                    }
+                } else {
+                    // Lanes past the cable's channel count read as 0V
+                    for (int g = 0; g < MAX_GROUPS; g++) {
+                        int c = 4 * g;
+                        simd::float_4 lanes = simd::float_4(0.f, 1.f, 2.f, 3.f) + float(c);
+                        cvIn[col][g] = simd::ifelse(lanes < float(channels),
+                            in.getVoltageSimd<simd::float_4>(c), 0.f);
+                    }
+                }
             }
         }
 
-        // Matrix mixing
+        // Each row is as wide as its widest routed input
+        int rowChannels[SIZE];
         for (int row = 0; row < SIZE; row++) {
-            float sum = 0.f;
-            for (int col = 0; col < SIZE; col++) {
-                if (params[MATRIX_PARAM + row * SIZE + col].getValue() > 0.5f) {
-                    sum += cvIn[col];
-                }
+            rowChannels[row] = 1;
+        }
+        for (int r = 0; r < numRoutes; r++) {
+            const Route& route = routes[r];
+            rowChannels[route.row] = std::max(rowChannels[route.row], colChannels[route.col]);
+        }
+
+        // Matrix mixing over the cells that are on
+        simd::float_4 sum[SIZE][MAX_GROUPS] = {};
+        for (int r = 0; r < numRoutes; r++) {
+            const Route& route = routes[r];
+            int groups = (rowChannels[route.row] + 3) / 4;
+            for (int g = 0; g < groups; g++) {
+                sum[route.row][g] += cvIn[route.col][g];
             }
-            outputs[CV_OUTPUT + row].setVoltage(DSP::clamp(sum, -10.f, 10.f));
         }
 
-        // Update lights
         for (int row = 0; row < SIZE; row++) {
-            for (int col = 0; col < SIZE; col++) {
-                lights[MATRIX_LIGHT + row * SIZE + col].setBrightness(
-                    params[MATRIX_PARAM + row * SIZE + col].getValue() > 0.5f ? 1.f : 0.f);
+            Output& out = outputs[CV_OUTPUT + row];
+            int groups = (rowChannels[row] + 3) / 4;
+            for (int g = 0; g < groups; g++) {
+                out.setVoltageSimd(simd::clamp(sum[row][g], -10.f, 10.f), 4 * g);
             }
+            out.setChannels(rowChannels[row]);
         }
     }
 };
 
+using EucMixModule = EucMixModuleT<4>;
+
 // ============================================================================
 // Widget
 // ============================================================================
@@ -2,6 +2,10 @@
  * EUCSEQ
  * 4-channel Euclidean sequencer with per-step CV values
  *
+ * The module is templated on its channel count (EucSeqModuleT<N>, N <= 8)
+ * to match the N-channel Euclogic expander chain; the 4-channel panel
+ * instantiates EucSeqModuleT<4>.
+ *
  * Signal flow:
  *   Clock -> Master Speed -> 4x Euclidean Engines -> Prob A -> Outputs
  *
@@ -11,14 +15,18 @@
  *   - Per-step CV values (0-10V or -5V to 5V bipolar) with interactive bar editor
  *   - 4x Gate + 4x Trigger + 4x LFO + 4x CV outputs
  *   - Right expander sends state to LogicMangler
+ *   - Knob settings can be recalled from EucBank
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "DSP.hpp"
 #include "ImagePanel.hpp"
+#include "Profiler.hpp"
 #include "euclogic/EuclideanEngine.hpp"
 #include "euclogic/ProbabilityGate.hpp"
 #include "euclogic/ExpanderMessage.hpp"
+#include "ClockBus.hpp"
+#include "euclogic/Snapshot.hpp"
 #include <atomic>
 #include <vector>
 #include <string>
@@ -79,22 +87,34 @@ struct EucSeqSnapKnob : RoundBlackKnob {
 // HitsParamQuantity - limits hits to current steps value
 // ============================================================================
 
-struct EucSeqModule;
-
 struct EucSeqHitsParamQuantity : ParamQuantity {
-    int channel = 0;
-    float getMaxValue() override;
-    void setValue(float value) override;
+    int stepsParamId = 0;
+
+    float getMaxValue() override {
+        if (module) {
+            return static_cast<float>(static_cast<int>(module->params[stepsParamId].getValue()));
+        }
+        return 64.f;
+    }
+
+    void setValue(float value) override {
+        value = math::clamp(value, getMinValue(), getMaxValue());
+        ParamQuantity::setValue(value);
+    }
 };
 
 // ============================================================================
 // EucSeq Module
 // ============================================================================
 
-struct EucSeqModule : Module {
-    static constexpr int NUM_CHANNELS = 4;
+template<int N>
+struct EucSeqModuleT : Module, EuclogicRecallTargetT<N> {
+    static constexpr int NUM_CHANNELS = N;
     static constexpr int MAX_STEPS = 64;
 
+    using Message = EuclogicExpanderMessageT<N>;
+    using Snapshot = typename EuclogicRecallTargetT<N>::Snapshot;
+
     enum ParamId {
         MASTER_SPEED_PARAM,
         SWING_PARAM,
@@ -141,6 +161,7 @@ struct EucSeqModule : Module {
 
     // Clock state
     dsp::SchmittTrigger clockTrigger;
+    ClockBus::Reader clockBus;
     dsp::SchmittTrigger resetTrigger;
 
     float clockPeriod = EucSeqConstants::DEFAULT_CLOCK_PERIOD;
@@ -162,9 +183,15 @@ struct EucSeqModule : Module {
     std::atomic<bool> gateStates[NUM_CHANNELS];
 
     // Expander message (double-buffered)
-    EuclogicExpanderMessage rightMessages[2];
+    Message rightMessages[2];
+    typename Message::Seq publishedSeq;  // Last params sent, with their generation
+    Snapshot recall;                     // Latest bank recall received
 
-    EucSeqModule() {
+#ifdef WR_PROFILE
+    ModuleProfile profile{this};
+#endif
+
+    EucSeqModuleT() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
         const auto& sr = EucSeqConstants::speedRatios();
@@ -184,7 +211,7 @@ struct EucSeqModule : Module {
             paramQuantities[HITS_PARAM + i]->snapEnabled = true;
 
             auto* hitsQ = new EucSeqHitsParamQuantity();
-            hitsQ->channel = i;
+            hitsQ->stepsParamId = STEPS_PARAM + i;
             hitsQ->module = this;
             hitsQ->paramId = HITS_PARAM + i;
             hitsQ->minValue = 0.f;
@@ -251,8 +278,14 @@ struct EucSeqModule : Module {
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
         float dt = args.sampleTime;
 
+        // Bank recall from EucBank (via LogicMangler)
+        if (this->takeRecall(recall)) {
+            applyRecall(recall.seq);
+        }
+
         // Handle reset
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage(),
                 EucSeqConstants::SCHMITT_LOW, EucSeqConstants::SCHMITT_HIGH)) {
@@ -267,10 +300,17 @@ struct EucSeqModule : Module {
         }
         lights[RUN_LIGHT].setBrightness(running ? 1.f : 0.2f);
 
-        // Clock handling
+        // Clock handling (PreFlightClock's bus carries the exact period)
         timeSinceClock += dt;
         bool clockEdge = false;
-        if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(),
+        if (clockBus.read(inputs[CLOCK_INPUT])) {
+            clockPeriod = clockBus.period;
+            clockLocked = true;
+            if (clockBus.edge) {
+                timeSinceClock = 0.f;
+                clockEdge = true;
+            }
+        } else if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(),
                 EucSeqConstants::SCHMITT_LOW, EucSeqConstants::SCHMITT_HIGH)) {
             if (timeSinceClock > 0.001f) {
                 clockPeriod = timeSinceClock;
@@ -336,7 +376,21 @@ struct EucSeqModule : Module {
         updateExpanderMessage();
     }
 
+    void applyRecall(const typename Message::Seq& seq) {
+        for (int i = 0; i < NUM_CHANNELS; i++) {
+            params[STEPS_PARAM + i].setValue(seq.steps[i]);
+            params[HITS_PARAM + i].setValue(seq.hits[i]);
+            params[QUANT_PARAM + i].setValue(seq.quant[i]);
+            params[PROB_A_PARAM + i].setValue(seq.probA[i]);
+            params[RETRIG_PARAM + i].setValue(seq.retrigger[i] ? 1.f : 0.f);
+            params[BIPOLAR_PARAM + i].setValue(seq.bipolar[i] ? 1.f : 0.f);
+        }
+        params[MASTER_SPEED_PARAM].setValue(seq.speed);
+        params[SWING_PARAM].setValue(seq.swing);
+    }
+
     void processTick() {
+        WR_PROFILE_SCOPE(profile, "tick");
         const auto& quantRatios = EucSeqConstants::quantRatios();
 
         for (int i = 0; i < NUM_CHANNELS; i++) {
@@ -420,37 +474,49 @@ struct EucSeqModule : Module {
     void updateExpanderMessage() {
         // Check if right neighbor is a compatible module
         if (rightExpander.module) {
-            EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(rightExpander.producerMessage);
-            msg->clear();
+            Message* msg = static_cast<Message*>(rightExpander.producerMessage);
+            typename Message::Hot& hot = msg->hot;
+
+            // Params for bank recall; restamped only when something moved
+            typename Message::Seq seq = publishedSeq;
 
+            typename Message::GateWord gates = 0, triggers = 0;
             for (int i = 0; i < NUM_CHANNELS; i++) {
-                msg->gates[i] = gateStates[i].load();
-                msg->triggers[i] = trigPulse[i].remaining > 0.f;
+                gates |= static_cast<typename Message::GateWord>(gateStates[i].load() << i);
+                triggers |= static_cast<typename Message::GateWord>((trigPulse[i].remaining > 0.f) << i);
                 int steps = engines[i].steps;
                 int currentStep = engines[i].currentStep;
                 float phase = (steps > 1) ? (float)currentStep / (float)(steps - 1) : 0.f;
-                msg->lfo[i] = phase * 10.f;
+                hot.lfo[i] = phase * 10.f;
 
                 int stepIdx = (currentStep > 0) ? currentStep - 1 : steps - 1;
                 bool bipolar = params[BIPOLAR_PARAM + i].getValue() > 0.5f;
                 float cvVal = cvValues[i][stepIdx % MAX_STEPS];
-                msg->cv[i] = bipolar ? (cvVal * 10.f - 5.f) : (cvVal * 10.f);
-
-                msg->currentStep[i] = currentStep;
-                msg->totalSteps[i] = steps;
-
-                // Store params for bank recall
-                msg->steps[i] = static_cast<int>(params[STEPS_PARAM + i].getValue());
-                msg->hits[i] = static_cast<int>(params[HITS_PARAM + i].getValue());
-                msg->quant[i] = static_cast<int>(params[QUANT_PARAM + i].getValue());
-                msg->probA[i] = params[PROB_A_PARAM + i].getValue();
-                msg->retrigger[i] = params[RETRIG_PARAM + i].getValue() > 0.5f;
-                msg->bipolar[i] = bipolar;
-            }
+                hot.cv[i] = bipolar ? (cvVal * 10.f - 5.f) : (cvVal * 10.f);
+
+                hot.currentStep[i] = static_cast<uint8_t>(currentStep);
+                hot.totalSteps[i] = static_cast<uint8_t>(steps);
 
-            msg->speed = params[MASTER_SPEED_PARAM].getValue();
-            msg->swing = params[SWING_PARAM].getValue();
-            msg->valid = true;
+                seq.steps[i] = static_cast<int>(params[STEPS_PARAM + i].getValue());
+                seq.hits[i] = static_cast<int>(params[HITS_PARAM + i].getValue());
+                seq.quant[i] = static_cast<int>(params[QUANT_PARAM + i].getValue());
+                seq.probA[i] = params[PROB_A_PARAM + i].getValue();
+                seq.retrigger[i] = params[RETRIG_PARAM + i].getValue() > 0.5f;
+                seq.bipolar[i] = bipolar;
+            }
+            hot.gates = gates;
+            hot.triggers = triggers;
+            hot.postLogicGates = 0;
+            hot.valid = true;
+
+            seq.speed = params[MASTER_SPEED_PARAM].getValue();
+            seq.swing = params[SWING_PARAM].getValue();
+            if (!seq.sameValues(publishedSeq)) {
+                publishedSeq = seq;
+                publishedSeq.generation = Message::nextGeneration();
+            }
+            msg->publishSeq(publishedSeq);
+            msg->clearLogic();
 
             rightExpander.requestMessageFlip();
         }
@@ -493,20 +559,7 @@ struct EucSeqModule : Module {
     }
 };
 
-// HitsParamQuantity implementation
-float EucSeqHitsParamQuantity::getMaxValue() {
-    EucSeqModule* m = dynamic_cast<EucSeqModule*>(module);
-    if (m) {
-        int steps = static_cast<int>(m->params[EucSeqModule::STEPS_PARAM + channel].getValue());
-        return static_cast<float>(steps);
-    }
-    return 64.f;
-}
-
-void EucSeqHitsParamQuantity::setValue(float value) {
-    value = math::clamp(value, getMinValue(), getMaxValue());
-    ParamQuantity::setValue(value);
-}
+using EucSeqModule = EucSeqModuleT<4>;
 
 // ============================================================================
 // CV Step Bar Display
@@ -622,7 +675,7 @@ struct EucSeqPatternDisplay : LightWidget {
         nvgFillColor(args.vg, nvgRGBA(15, 15, 25, 160));
         nvgFill(args.vg);
 
-        float rowHeight = box.size.y / 4.f;
+        float rowHeight = box.size.y / EucSeqModule::NUM_CHANNELS;
 
         if (!module) {
             nvgFillColor(args.vg, nvgRGBA(80, 100, 140, 200));
@@ -632,7 +685,7 @@ struct EucSeqPatternDisplay : LightWidget {
             return;
         }
 
-        for (int ch = 0; ch < 4; ch++) {
+        for (int ch = 0; ch < EucSeqModule::NUM_CHANNELS; ch++) {
             const auto& engine = module->engines[ch];
             float y = ch * rowHeight;
             int steps = engine.steps;
@@ -758,6 +811,14 @@ struct EucSeqWidget : ModuleWidget {
             addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(xBase + outSpacing, yOut2)), module, EucSeqModule::CV_OUTPUT + i));
         }
     }
+
+#ifdef WR_PROFILE
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<EucSeqModule*>(this->module);
+        if (!m) return;
+        WR_PROFILE_MENU(menu, m);
+    }
+#endif
 };
 
 } // namespace WiggleRoom
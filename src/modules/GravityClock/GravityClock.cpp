@@ -10,10 +10,20 @@
  *   - Ratio control for clock divisions (1x, 2x, 4x, etc.)
  *   - Elasticity for steady sync (1.0) or ratcheting decay (<1.0)
  *   - LFO output (ball position) and trigger output (on impact)
+ *   - Multi-ball mode: 4 or 8 balls bouncing 1, 2, 3 ... 8 times as fast,
+ *     on polyphonic outputs (context menu)
+ *
+ * Each flight is a parabola, height = h0 + t * (v0 - g/2 * t), so nothing
+ * is integrated: a drop or bounce fixes the launch height and velocity and
+ * the time of the next floor contact, t = (v0 + sqrt(v0^2 + 2 g h0)) / g.
+ * Per sample a ball costs one polynomial and a compare against that time;
+ * the sample past it relaunches the ball with the sub-sample remainder.
+ * Balls run four to a float_4, so one ball and four cost the same.
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "ImagePanel.hpp"
+#include <atomic>
 
 using namespace rack;
 
@@ -48,16 +58,27 @@ struct GravityClock : Module {
     float detectedPeriod = 0.5f;  // Default ~120 BPM
     bool clockLocked = false;
 
-    // Physics state
-    float position = 0.f;   // Ball height (0 = floor)
-    float velocity = 0.f;   // Ball velocity
-    float targetHeight = 1.f;  // Calculated height for sync
-
-    // Trigger output pulse
-    dsp::PulseGenerator impactPulse;
-
     // Fixed gravity constant (tuned for good feel)
     static constexpr float GRAVITY = 5000.f;
+    // Balls bouncing off the floor slower than this stay down until the next clock
+    static constexpr float SETTLE_VELOCITY = 1.f;
+    static constexpr float NEVER = 1e30f;
+
+    static constexpr int MAX_BALLS = 8;
+    static constexpr int MAX_GROUPS = MAX_BALLS / 4;
+    static constexpr int BALL_COUNTS[] = {1, 4, 8};
+
+    // Current flight of each ball, four per float_4
+    simd::float_4 flightTime[MAX_GROUPS] = {};     // seconds since launch
+    simd::float_4 launchHeight[MAX_GROUPS] = {};
+    simd::float_4 launchVelocity[MAX_GROUPS] = {};
+    simd::float_4 fallRate[MAX_GROUPS] = {};       // g / 2 in flight, 0 once settled
+    simd::float_4 impactTime[MAX_GROUPS];          // floor contact, NEVER once settled
+
+    // Impact trigger pulses (1ms)
+    simd::float_4 pulseTime[MAX_GROUPS] = {};
+
+    std::atomic<int> requestedBalls{1};
 
     GravityClock() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -75,6 +96,58 @@ struct GravityClock : Module {
         configOutput(TRIGGER_OUTPUT, "Impact Trigger");
 
         configLight(LOCK_LIGHT, "Clock Lock");
+
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            impactTime[g] = NEVER;
+        }
+    }
+
+    void setBallCount(int balls) {
+        requestedBalls = clamp(balls, 1, MAX_BALLS);
+    }
+
+    int getBallCount() const {
+        return requestedBalls;
+    }
+
+    // Ball i bounces i + 1 times per period
+    static simd::float_4 ballMultiples(int g) {
+        return simd::float_4(1.f, 2.f, 3.f, 4.f) + 4.f * g;
+    }
+
+    // Drop every ball of a group from rest at its sync height
+    void dropBalls(int g, simd::float_4 height) {
+        flightTime[g] = 0.f;
+        launchHeight[g] = height;
+        launchVelocity[g] = 0.f;
+        fallRate[g] = 0.5f * GRAVITY;
+        impactTime[g] = simd::sqrt(2.f * height / GRAVITY);
+    }
+
+    // Floor contact for the lanes in mask: bounce or settle
+    void impact(int g, int mask, float elasticity) {
+        for (int lane = 0; lane < 4; lane++) {
+            if (!(mask & (1 << lane))) continue;
+            float t = impactTime[g][lane];
+            float speed = GRAVITY * t - launchVelocity[g][lane];   // downward at the floor
+            float v0 = speed * elasticity;                          // upward after the bounce
+            if (v0 > SETTLE_VELOCITY) {
+                // Relaunch from the floor; the next contact is more than
+                // 2 * SETTLE_VELOCITY / GRAVITY (0.4ms) away, longer than a
+                // sample, so a ball lands at most once per sample
+                flightTime[g][lane] -= t;
+                launchHeight[g][lane] = 0.f;
+                launchVelocity[g][lane] = v0;
+                impactTime[g][lane] = 2.f * v0 / GRAVITY;
+                pulseTime[g][lane] = 1e-3f;
+            } else {
+                flightTime[g][lane] = 0.f;
+                launchHeight[g][lane] = 0.f;
+                launchVelocity[g][lane] = 0.f;
+                fallRate[g][lane] = 0.f;
+                impactTime[g][lane] = NEVER;
+            }
+        }
     }
 
     void process(const ProcessArgs& args) override {
@@ -116,52 +189,58 @@ struct GravityClock : Module {
         // Target period = detected period / ratio
         float targetPeriod = detectedPeriod / ratio;
 
-        // Calculate height needed for ball to bounce with this period
-        // Physics: T = 2 * sqrt(2*h/g)  =>  h = g*T^2 / 8
-        targetHeight = (GRAVITY * targetPeriod * targetPeriod) / 8.f;
-        targetHeight = clamp(targetHeight, 0.001f, 1000.f);
-
-        // ========================================
-        // 3. PHYSICS SIMULATION
-        // ========================================
+        int balls = requestedBalls;
+        int groups = (balls + 3) / 4;
         float elasticity = params[ELASTICITY_PARAM].getValue();
 
-        if (resetBall) {
-            // Drop the ball from calculated height
-            position = targetHeight;
-            velocity = 0.f;
-        } else {
-            // Apply gravity
-            velocity -= GRAVITY * dt;
-
-            // Update position
-            position += velocity * dt;
-
-            // Floor collision
-            if (position <= 0.f) {
-                position = 0.f;
-
-                // Only bounce if moving downward with significant velocity
-                if (velocity < -1.f) {
-                    velocity = -velocity * elasticity;
-                    impactPulse.trigger(1e-3f);
-                } else {
-                    // Ball has settled
-                    velocity = 0.f;
-                }
+        for (int g = 0; g < groups; g++) {
+            // Height needed for each ball to bounce with its period
+            // Physics: T = 2 * sqrt(2*h/g)  =>  h = g*T^2 / 8
+            simd::float_4 period = targetPeriod / ballMultiples(g);
+            simd::float_4 targetHeight = simd::clamp((GRAVITY / 8.f) * period * period, 0.001f, 1000.f);
+
+            // ========================================
+            // 3. TRAJECTORY
+            // ========================================
+            if (resetBall) {
+                dropBalls(g, targetHeight);
+            } else {
+                flightTime[g] += dt;
+                int landed = simd::movemask(flightTime[g] >= impactTime[g]);
+                if (landed) impact(g, landed, elasticity);
+            }
+            simd::float_4 t = flightTime[g];
+            simd::float_4 height = launchHeight[g] + t * (launchVelocity[g] - fallRate[g] * t);
+
+            // ========================================
+            // 4. OUTPUTS
+            // ========================================
+            // LFO output: normalized position (0-5V)
+            simd::float_4 lfo = simd::clamp(height / targetHeight, 0.f, 1.f) * 5.f;
+            simd::float_4 trigger = simd::ifelse(pulseTime[g] > 0.f, 10.f, 0.f);
+            pulseTime[g] = simd::fmax(pulseTime[g] - dt, 0.f);
+
+            if (balls == 1) {
+                outputs[LFO_OUTPUT].setVoltage(lfo[0]);
+                outputs[TRIGGER_OUTPUT].setVoltage(trigger[0]);
+            } else {
+                outputs[LFO_OUTPUT].setVoltageSimd(lfo, 4 * g);
+                outputs[TRIGGER_OUTPUT].setVoltageSimd(trigger, 4 * g);
             }
         }
+        outputs[LFO_OUTPUT].setChannels(balls);
+        outputs[TRIGGER_OUTPUT].setChannels(balls);
+    }
 
-        // ========================================
-        // 4. OUTPUTS
-        // ========================================
-        // LFO output: normalized position (0-5V)
-        float normalizedPos = (targetHeight > 0.001f) ? (position / targetHeight) : 0.f;
-        normalizedPos = clamp(normalizedPos, 0.f, 1.f);
-        outputs[LFO_OUTPUT].setVoltage(normalizedPos * 5.f);
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "balls", json_integer(getBallCount()));
+        return rootJ;
+    }
 
-        // Trigger output
-        outputs[TRIGGER_OUTPUT].setVoltage(impactPulse.process(dt) ? 10.f : 0.f);
+    void dataFromJson(json_t* rootJ) override {
+        json_t* ballsJ = json_object_get(rootJ, "balls");
+        if (ballsJ) setBallCount(static_cast<int>(json_integer_value(ballsJ)));
     }
 };
 
@@ -207,6 +286,26 @@ struct GravityClockWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 280), module, GravityClock::TRIGGER_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<GravityClock*>(this->module);
+        if (!m) return;
+
+        std::vector<std::string> labels;
+        for (int balls : GravityClock::BALL_COUNTS) {
+            labels.push_back(balls == 1 ? "1 ball" : std::to_string(balls) + " balls (poly)");
+        }
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createIndexSubmenuItem("Balls", labels,
+            [=]() {
+                for (size_t i = 0; i < labels.size(); i++) {
+                    if (GravityClock::BALL_COUNTS[i] == m->getBallCount()) return i;
+                }
+                return (size_t)0;
+            },
+            [=](size_t index) { m->setBallCount(GravityClock::BALL_COUNTS[index]); }
+        ));
+    }
 };
 
 } // namespace WiggleRoom
@@ -10,6 +10,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME InfiniteFolder
 #include "infinite_folder.hpp"  // Generated by Faust
+#include "infinite_folder_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +18,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::infinite_folder;
+
 /**
  * InfiniteFolder - Sine-based Wavefolder
  *
@@ -70,41 +73,30 @@ struct InfiniteFolder : FaustModule<VCVRackDSP> {
         // Configure outputs
         configOutput(AUDIO_OUTPUT, "Audio");
 
-        // Faust params (alphabetical): drive=0, mix=1, symmetry=2
-        mapParam(DRIVE_PARAM, 0);
-        mapParam(MIX_PARAM, 1);
-        mapParam(SYMMETRY_PARAM, 2);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(DRIVE_PARAM, FP::DRIVE);
+        mapParam(MIX_PARAM, FP::MIX);
+        mapParam(SYMMETRY_PARAM, FP::SYMMETRY);
+
+        // Knob: 1-10x, CV can push to 20x for extreme destruction
+        mapCVInput(DRIVE_CV_INPUT, FP::DRIVE, false, 1.0f);        // 1V = +1x
+        mapCVInput(SYMMETRY_CV_INPUT, FP::SYMMETRY, false, 0.1f);  // ±10V = ±1.0
+
+        // Folding at high drive generates harmonics far above Nyquist
+        enableOversampling();
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
-        // Get drive with CV modulation
-        // Knob: 1-10x, CV can push to 20x for extreme destruction
-        float drive = params[DRIVE_PARAM].getValue();
-        if (inputs[DRIVE_CV_INPUT].isConnected()) {
-            drive += inputs[DRIVE_CV_INPUT].getVoltage();  // 1V = +1x
-        }
-        drive = clamp(drive, 1.f, 20.f);
-
-        // Get symmetry with CV modulation
-        float symmetry = params[SYMMETRY_PARAM].getValue();
-        if (inputs[SYMMETRY_CV_INPUT].isConnected()) {
-            symmetry += inputs[SYMMETRY_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
-        }
-        symmetry = clamp(symmetry, -1.f, 1.f);
-
-        // Get mix
-        float mix = params[MIX_PARAM].getValue();
-
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, drive);     // drive
-        faustDsp.setParamValue(1, mix);       // mix
-        faustDsp.setParamValue(2, symmetry);  // symmetry
+        // Update Faust parameters from knobs and CV (control rate)
+        updateFaustParams();
 
         // Get input and scale down
         // VCV signals are ±5V, scale to ±1.0 for clean folding math
@@ -112,10 +104,7 @@ struct InfiniteFolder : FaustModule<VCVRackDSP> {
 
         // Process audio
         float output = 0.0f;
-        float* inputPtrs[1] = { &input };
-        float* outputPtrs[1] = { &output };
-
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        computeFrame(&input, &output);
 
         // Scale output back to modular level (±5V)
         outputs[AUDIO_OUTPUT].setVoltage(output * 5.0f);
@@ -163,6 +152,14 @@ struct InfiniteFolderWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter, 310), module, InfiniteFolder::AUDIO_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<InfiniteFolder*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        appendOversamplingMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
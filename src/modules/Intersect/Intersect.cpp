@@ -2,9 +2,16 @@
  * INTERSECT
  * Rhythmic trigger generator using discrete gradient analysis
  * Generates Euclidean and Euclidean-adjacent rhythms from CV signals
+ *
+ * Polyphonic: each channel of a poly CV (up to 16) is its own trigger
+ * stream on the Trigger and Step outputs, sampled by the one shared clock.
+ * Density CV may be poly too (one density per channel) or mono (shared).
+ * Band analysis runs four channels per float_4; the display follows
+ * channel 1.
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "ClockBus.hpp"
 #include "DSP.hpp"
 #include "ImagePanel.hpp"
 #include <atomic>
@@ -52,11 +59,13 @@ struct Intersect : Module {
         LIGHTS_LEN
     };
 
+    static constexpr int MAX_CHANNELS = 16;
+    static constexpr int MAX_GROUPS = MAX_CHANNELS / 4;
+
     // Clock detection
     dsp::SchmittTrigger clockTrigger;
+    ClockBus::Reader clockBus;
     dsp::SchmittTrigger resetTrigger;
-    dsp::PulseGenerator triggerPulse;
-    dsp::PulseGenerator gatePulse;  // For gate mode output
 
     // Internal clock (when no external clock)
     float internalPhase = 0.0f;
@@ -73,9 +82,14 @@ struct Intersect : Module {
     int divCounter = 0;
     int historyCounter = 0;
 
-    // Band detection state
-    int lastBandIndex = -999;
-    float currentSteppedVoltage = 0.0f;
+    // Band detection state, four channels per float_4 (bands are whole numbers)
+    simd::float_4 lastBand[MAX_GROUPS];
+    simd::float_4 bandPrimed[MAX_GROUPS];       // all bits set once a channel has sampled
+    simd::float_4 steppedVoltage[MAX_GROUPS];
+
+    // Output pulse per channel: 1ms in trigger mode, one sample period in
+    // gate mode (the longer one wins, as with two pulse generators)
+    simd::float_4 pulseRemaining[MAX_GROUPS];
 
     // Thread-safe visualization data (written by audio, read by UI)
     static const int BUFFER_SIZE = 128;
@@ -119,11 +133,22 @@ struct Intersect : Module {
 
         // Initialize buffer
         cvBuffer.fill(0.5f);
+        resetBands();
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            pulseRemaining[g] = 0.f;
+        }
+    }
+
+    void resetBands() {
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            lastBand[g] = 0.f;
+            bandPrimed[g] = 0.f;
+            steppedVoltage[g] = 0.f;
+        }
     }
 
     void onReset() override {
-        lastBandIndex = -999;
-        currentSteppedVoltage = 0.0f;
+        resetBands();
         internalPhase = 0.0f;
         clockMultCounter = 0;
         timeSinceLastClock = 0.0f;
@@ -155,6 +180,44 @@ struct Intersect : Module {
         }
     }
 
+    static simd::float_4 normalizeCV(simd::float_4 rawCV, bool isUnipolar) {
+        simd::float_4 n = isUnipolar ? rawCV / 10.0f : (rawCV + 5.0f) / 10.0f;
+        return simd::clamp(n, 0.0f, 1.0f);
+    }
+
+    /**
+     * Sample four channels on a clock tick
+     *
+     * @return mask of the channels that fired
+     */
+    int sampleGroup(int g, simd::float_4 normalizedCV, simd::float_4 divisions,
+                    int edgeMode, bool isUnipolar, float pulseDuration) {
+        using simd::float_4;
+        // Calculate current band
+        float_4 band = simd::clamp(simd::floor(normalizedCV * divisions), 0.0f, divisions - 1.0f);
+
+        // Did we cross a line? 0=Rising, 1=Both, 2=Falling
+        float_4 crossed;
+        if (edgeMode == 0) {
+            crossed = band > lastBand[g];
+        } else if (edgeMode == 2) {
+            crossed = band < lastBand[g];
+        } else {
+            crossed = band != lastBand[g];
+        }
+        crossed = crossed & bandPrimed[g];
+        pulseRemaining[g] = simd::ifelse(crossed,
+            simd::fmax(pulseRemaining[g], pulseDuration), pulseRemaining[g]);
+
+        // Stepped voltage (center of band)
+        float_4 bandCenter = (band + 0.5f) / divisions;
+        steppedVoltage[g] = isUnipolar ? bandCenter * 10.0f : bandCenter * 10.0f - 5.0f;
+
+        lastBand[g] = band;
+        bandPrimed[g] = float_4::mask();
+        return simd::movemask(crossed);
+    }
+
     void process(const ProcessArgs& args) override {
         // Handle reset
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage(), SCHMITT_LOW, SCHMITT_HIGH)) {
@@ -173,8 +236,21 @@ struct Intersect : Module {
             // External clock
             timeSinceLastClock += args.sampleTime;
 
-            if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), SCHMITT_LOW, SCHMITT_HIGH)) {
-                lastClockPeriod = std::max(timeSinceLastClock, 0.001f);  // Prevent division by zero
+            // PreFlightClock's bus carries the exact period, and its beat
+            // phase places the multiplied ticks
+            bool clockEdge;
+            if (clockBus.read(inputs[CLOCK_INPUT])) {
+                clockEdge = clockBus.edge;
+                lastClockPeriod = std::max(clockBus.period, 0.001f);
+                timeSinceLastClock = clockBus.phase * lastClockPeriod;
+            } else {
+                clockEdge = clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), SCHMITT_LOW, SCHMITT_HIGH);
+                if (clockEdge) {
+                    lastClockPeriod = std::max(timeSinceLastClock, 0.001f);  // Prevent division by zero
+                }
+            }
+
+            if (clockEdge) {
                 timeSinceLastClock = 0.0f;
                 clockMultCounter = 0;
 
@@ -220,9 +296,10 @@ struct Intersect : Module {
         }
 
         // Get current CV and normalize
-        float rawCV = inputs[CV_INPUT].getVoltage();
+        int channels = std::max(inputs[CV_INPUT].getChannels(), 1);
+        int groups = (channels + 3) / 4;
         bool isUnipolar = params[SCALE_PARAM].getValue() > 0.5f;
-        float normalizedCV = normalizeCV(rawCV, isUnipolar);
+        float normalizedCV = normalizeCV(inputs[CV_INPUT].getVoltage(), isUnipolar);
 
         // Update CV history for visualization (at ~60 FPS equivalent)
         int samplesPerUpdate = std::max(1, (int)(args.sampleRate / 60.0f / BUFFER_SIZE * 2));
@@ -234,56 +311,36 @@ struct Intersect : Module {
             cvBufferWriteIndex.store((writeIdx + 1) % BUFFER_SIZE);
         }
 
-        // Calculate divisions with CV modulation
+        // Calculate divisions with CV modulation (per channel for a poly density CV)
         float densityBase = params[DENSITY_PARAM].getValue();
-        float densityCV = inputs[DENSITY_CV_INPUT].getVoltage() * params[DENSITY_CV_PARAM].getValue();
-        int divisions = DSP::clamp((int)(densityBase + densityCV * DENSITY_CV_SCALE), 1, 32);
-        currentDivisions.store(divisions);
+        float densityAmount = params[DENSITY_CV_PARAM].getValue() * DENSITY_CV_SCALE;
+        Input& densityInput = inputs[DENSITY_CV_INPUT];
+        currentDivisions.store(DSP::clamp((int)(densityBase + densityInput.getVoltage() * densityAmount), 1, 32));
 
         // The main algorithm: sample on clock
         if (shouldSample) {
-            // Calculate current band
-            int currentBandIndex = (int)std::floor(normalizedCV * divisions);
-            if (currentBandIndex >= divisions) currentBandIndex = divisions - 1;
-            if (currentBandIndex < 0) currentBandIndex = 0;
-
-            // Did we cross a line?
-            if (currentBandIndex != lastBandIndex && lastBandIndex != -999) {
-                // Check edge mode: 0=Rising, 1=Both, 2=Falling
-                int edgeMode = (int)std::round(params[EDGE_MODE_PARAM].getValue());
-                bool shouldTrigger = false;
-
-                if (edgeMode == 0) {
-                    // Rising only: trigger when moving to higher band
-                    shouldTrigger = (currentBandIndex > lastBandIndex);
-                } else if (edgeMode == 2) {
-                    // Falling only: trigger when moving to lower band
-                    shouldTrigger = (currentBandIndex < lastBandIndex);
-                } else {
-                    // Both: any band change triggers
-                    shouldTrigger = true;
-                }
-
-                if (shouldTrigger) {
-                    bool isGateMode = params[GATE_MODE_PARAM].getValue() > 0.5f;
-                    if (isGateMode) {
-                        // Gate mode: gate lasts for the effective sample period
-                        gatePulse.trigger(effectiveSamplePeriod);
-                    } else {
-                        // Trigger mode: short 1ms pulse
-                        triggerPulse.trigger(TRIGGER_PULSE_DURATION);
+            int edgeMode = (int)std::round(params[EDGE_MODE_PARAM].getValue());
+            bool isGateMode = params[GATE_MODE_PARAM].getValue() > 0.5f;
+            // Gate mode: gate lasts for the effective sample period
+            float pulseDuration = isGateMode ? effectiveSamplePeriod : TRIGGER_PULSE_DURATION;
+
+            for (int g = 0; g < groups; g++) {
+                int c = 4 * g;
+                simd::float_4 cv = normalizeCV(inputs[CV_INPUT].getVoltageSimd<simd::float_4>(c), isUnipolar);
+                simd::float_4 divisions = simd::clamp(
+                    simd::floor(densityBase + densityInput.getPolyVoltageSimd<simd::float_4>(c) * densityAmount),
+                    1.0f, 32.0f);
+                int fired = sampleGroup(g, cv, divisions, edgeMode, isUnipolar, pulseDuration);
+
+                if (g == 0) {
+                    int band = (int)lastBand[0][0];
+                    displayBandIndex.store(band);
+                    if (fired & 1) {
+                        displayFlashBand.store(band);
+                        displayFlashTime.store(0.0f);
                     }
-                    displayFlashBand.store(currentBandIndex);
-                    displayFlashTime.store(0.0f);
                 }
             }
-
-            // Calculate stepped voltage (center of band)
-            float bandCenter = ((float)currentBandIndex + 0.5f) / divisions;
-            currentSteppedVoltage = denormalizeCV(bandCenter, isUnipolar);
-
-            lastBandIndex = currentBandIndex;
-            displayBandIndex.store(currentBandIndex);
         }
 
         // Update trigger flash timer
@@ -299,14 +356,21 @@ struct Intersect : Module {
         }
 
         // Process outputs
-        bool trigPulse = triggerPulse.process(args.sampleTime);
-        bool gateOutput = gatePulse.process(args.sampleTime);
-        bool outputHigh = trigPulse || gateOutput;
-
-        outputs[TRIG_OUTPUT].setVoltage(outputHigh ? 10.0f : 0.0f);
-        outputs[STEP_OUTPUT].setVoltage(currentSteppedVoltage);
+        bool anyHigh = false;
+        for (int g = 0; g < groups; g++) {
+            int c = 4 * g;
+            simd::float_4 high = pulseRemaining[g] > 0.0f;
+            pulseRemaining[g] = simd::fmax(pulseRemaining[g] - args.sampleTime, 0.0f);
+            // Channels past the cable's count don't light the LED
+            int lanes = std::min(channels - c, 4);
+            anyHigh |= (simd::movemask(high) & ((1 << lanes) - 1)) != 0;
+            outputs[TRIG_OUTPUT].setVoltageSimd(simd::ifelse(high, 10.0f, 0.0f), c);
+            outputs[STEP_OUTPUT].setVoltageSimd(steppedVoltage[g], c);
+        }
+        outputs[TRIG_OUTPUT].setChannels(channels);
+        outputs[STEP_OUTPUT].setChannels(channels);
 
-        lights[TRIG_LIGHT].setBrightness(outputHigh ? 1.0f : 0.0f);
+        lights[TRIG_LIGHT].setBrightness(anyHigh ? 1.0f : 0.0f);
     }
 };
 
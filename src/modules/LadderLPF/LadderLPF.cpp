@@ -6,9 +6,12 @@
 
 #include "rack.hpp"
 #include "FaustModule.hpp"
+#include "LadderBank.hpp"
+#include "Denormals.hpp"
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME LadderLPF
 #include "ladder_lpf.hpp"  // Generated by Faust from ladder_lpf.dsp
+#include "ladder_lpf_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -16,14 +19,22 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::ladder_lpf;
+
 /**
  * LadderLPF - Ladder Lowpass Filter
  *
  * A classic 4-pole resonant lowpass filter.
  * Uses Faust DSP for the filter algorithm.
  *
+ * Polyphonic: a poly cable at Audio In filters every channel with its own
+ * cutoff and resonance (poly CV per channel, mono CV shared). Poly voices
+ * run in LadderBank, the same filter four voices per float_4, with the
+ * controls read every SMOOTH_INTERVAL samples; mono cables use the Faust
+ * DSP.
+ *
  * Inputs:
- *   - Audio In: Signal to filter
+ *   - Audio In: Signal to filter (up to 16 channels)
  *   - Cutoff CV: V/Oct modulation of cutoff frequency
  *   - Resonance CV: Linear modulation of resonance
  *
@@ -51,6 +62,13 @@ struct LadderLPF : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int SMOOTH_INTERVAL = 16;
+    static constexpr float RESONANCE_CV_SCALE = 0.095f;   // +/-10V adds +/-0.95
+
+    LadderBank ladder;
+    int smoothCounter = 0;
+    bool polyActive = false;
+
     LadderLPF() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -73,18 +91,80 @@ struct LadderLPF : FaustModule<VCVRackDSP> {
         setAudioIO(AUDIO_INPUT, AUDIO_OUTPUT);
 
         // Map VCV parameters to Faust DSP parameters
-        // Faust params are indexed in order of declaration in .dsp:
-        //   0 = cutoff
-        //   1 = resonance
-        mapParam(CUTOFF_PARAM, 0);      // Cutoff knob -> Faust param 0
-        mapParam(RESONANCE_PARAM, 1);   // Resonance knob -> Faust param 1
+        mapParam(CUTOFF_PARAM, FP::CUTOFF);
+        mapParam(RESONANCE_PARAM, FP::RESONANCE);
 
         // Map CV inputs to modulate Faust parameters
         // Cutoff CV uses V/Oct exponential scaling (1V = 1 octave up)
-        mapCVInput(CUTOFF_CV_INPUT, 0, true, 1.0f);
+        mapCVInput(CUTOFF_CV_INPUT, FP::CUTOFF, true, 1.0f);
 
         // Resonance CV uses bipolar linear modulation (+/-10V adds +/-0.95)
-        mapCVInput(RESONANCE_CV_INPUT, 1, false, 0.095f);
+        mapCVInput(RESONANCE_CV_INPUT, FP::RESONANCE, false, RESONANCE_CV_SCALE);
+    }
+
+    // Poly voices restart from the current controls
+    void resetLadder() {
+        ladder.reset();
+        smoothCounter = 0;
+    }
+
+    // Per-voice cutoff and resonance, the same mapping as the Faust CV path
+    void updateLadder(float sampleRate) {
+        ladder.setSampleRate(sampleRate);
+        float cutoff = params[CUTOFF_PARAM].getValue();
+        float resonance = params[RESONANCE_PARAM].getValue();
+        Input& cutoffCV = inputs[CUTOFF_CV_INPUT];
+        Input& resonanceCV = inputs[RESONANCE_CV_INPUT];
+        for (int g = 0; g < ladder.getGroupCount(); g++) {
+            int c = g * 4;
+            simd::float_4 fc = cutoff;
+            simd::float_4 res = resonance;
+            if (cutoffCV.isConnected()) {
+                fc *= DSP::voltToFreqMultiplier(cutoffCV.getPolyVoltageSimd<simd::float_4>(c));
+            }
+            if (resonanceCV.isConnected()) {
+                res += resonanceCV.getPolyVoltageSimd<simd::float_4>(c) * RESONANCE_CV_SCALE;
+            }
+            fc = simd::clamp(fc, 20.f, 20000.f);
+            res = simd::clamp(res, 0.f, 0.95f);
+            ladder.setControls(g, fc, res, SMOOTH_INTERVAL);
+        }
+    }
+
+    void process(const ProcessArgs& args) override {
+        int channels = inputs[AUDIO_INPUT].getChannels();
+        if (channels <= 1) {
+            outputs[AUDIO_OUTPUT].setChannels(1);
+            FaustModule::process(args);
+            if (polyActive) {
+                resetLadder();
+                polyActive = false;
+            }
+            return;
+        }
+
+        WR_PROFILE_SCOPE(profile, "process");
+        polyActive = true;
+        ladder.setChannelCount(channels);
+        if (--smoothCounter <= 0) {
+            smoothCounter = SMOOTH_INTERVAL;
+            updateLadder(args.sampleRate);
+        }
+
+        // The filter is linear: voltages go through unscaled
+        ScopedFlushDenormals noDenormals;
+        Input& in = inputs[AUDIO_INPUT];
+        Output& out = outputs[AUDIO_OUTPUT];
+        for (int g = 0; g < ladder.getGroupCount(); g++) {
+            int c = g * 4;
+            out.setVoltageSimd(ladder.process(g, in.getVoltageSimd<simd::float_4>(c)), c);
+        }
+        out.setChannels(channels);
+    }
+
+    void onReset() override {
+        FaustModule::onReset();
+        resetLadder();
     }
 };
 
@@ -123,6 +203,13 @@ struct LadderLPFWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter + 25, 280), module, LadderLPF::AUDIO_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<LadderLPF*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
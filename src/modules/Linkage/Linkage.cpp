@@ -9,6 +9,7 @@
 #include "FaustModule.hpp"
 #define FAUST_MODULE_NAME Linkage
 #include "linkage.hpp"  // Generated by Faust
+#include "linkage_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -16,6 +17,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::linkage;
+
 /**
  * Linkage - Chaotic Percussion Generator
  *
@@ -73,22 +76,26 @@ struct Linkage : FaustModule<VCVRackDSP> {
         configOutput(AUDIO_OUTPUT, "Audio");
 
         // Map VCV parameters to Faust DSP parameters
-        // Faust params (alphabetical): damping=0, gate=1, slack=2, tension=3
-        mapParam(DAMPING_PARAM, 0);
-        mapParam(SLACK_PARAM, 2);
-        mapParam(TENSION_PARAM, 3);
+        mapParam(DAMPING_PARAM, FP::DAMPING);
+        mapParam(SLACK_PARAM, FP::SLACK);
+        mapParam(TENSION_PARAM, FP::TENSION);
 
         // Map CV inputs with linear modulation
         // Tension: ±20 per volt for pitch-like control
         // Slack: ±0.1 per volt for subtle chaos modulation
-        mapCVInput(TENSION_CV_INPUT, 3, false, 20.f);
-        mapCVInput(SLACK_CV_INPUT, 2, false, 0.1f);
+        mapCVInput(TENSION_CV_INPUT, FP::TENSION, false, 20.f);
+        mapCVInput(SLACK_CV_INPUT, FP::SLACK, false, 0.1f);
+
+        // The mass-spring chain costs scale with the engine rate; optionally run near 48 kHz
+        enableFixedRate(48000);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -100,15 +107,11 @@ struct Linkage : FaustModule<VCVRackDSP> {
         if (gateTrigger.process(inputs[GATE_INPUT].getVoltage(), 0.1f, 1.f)) {
             gateValue = 1.f;
         }
-        // Faust param: gate=1
-        faustDsp.setParamValue(1, gateValue);
+        setGateParam(FP::GATE, gateValue);  // One-sample pulse: held until the next compute()
 
         // Process audio (no input, mono output)
-        float* nullInputs[1] = { nullptr };
         float output = 0.f;
-        float* outputPtrs[1] = { &output };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        computeFrame(nullptr, &output);
 
         // Hard clip for safety (physics can be bursty) and scale to VCV levels
         output = clamp(output, -2.f, 2.f);
@@ -157,6 +160,14 @@ struct LinkageWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter, 320), module, Linkage::AUDIO_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<Linkage*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        appendFixedRateMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -9,8 +9,12 @@
  *   - Per-column density knobs
  *   - Row/column randomize and mutate via header buttons
  *   - 4x Probability B knobs + CV inputs
- *   - 4x Gate + 4x Trigger outputs
+ *   - 4x Gate + 4x Trigger outputs (polyphonic: one lane per input channel)
  *   - Right expander sends state to EucBank
+ *   - Applies EucBank recalls and passes them on to EucSeq
+ *
+ * Templated on channel count (LogicManglerModuleT<N>, N <= 8: a 2^N-state
+ * table) to match the N-channel Euclogic chain; the panel uses N = 4.
  ******************************************************************************/
 
 #include "rack.hpp"
@@ -19,6 +23,7 @@
 #include "euclogic/TruthTable.hpp"
 #include "euclogic/ProbabilityGate.hpp"
 #include "euclogic/ExpanderMessage.hpp"
+#include "euclogic/Snapshot.hpp"
 #include <atomic>
 #include <string>
 
@@ -32,8 +37,16 @@ namespace WiggleRoom {
 // LogicMangler Module
 // ============================================================================
 
-struct LogicManglerModule : Module {
-    static constexpr int NUM_CHANNELS = 4;
+template<int N>
+struct LogicManglerModuleT : Module, EuclogicRecallTargetT<N> {
+    using Table = TruthTableT<N>;
+    using Message = EuclogicExpanderMessageT<N>;
+    using RecallTarget = EuclogicRecallTargetT<N>;
+    using Snapshot = typename RecallTarget::Snapshot;
+
+    static constexpr int NUM_CHANNELS = N;
+    static constexpr int N_STATES = Table::N_STATES;
+    static constexpr int MAX_LANES = Table::MAX_LANES;   // Polyphony
     static constexpr float TRIGGER_PULSE_DURATION = 1e-3f;
     static constexpr float RETRIG_GAP_DURATION = 0.5e-3f;
 
@@ -61,11 +74,11 @@ struct LogicManglerModule : Module {
 
     enum LightId {
         ENUMS(GATE_LIGHT, NUM_CHANNELS),
-        ENUMS(LED_MATRIX_LIGHT, 64),  // 16 states x 4 output bits
+        ENUMS(LED_MATRIX_LIGHT, N_STATES * NUM_CHANNELS),  // states x output bits
         LIGHTS_LEN
     };
 
-    TruthTable truthTable;
+    Table truthTable;
     ProbabilityGate probB[NUM_CHANNELS];
 
     dsp::SchmittTrigger gateTriggers[NUM_CHANNELS];
@@ -74,17 +87,22 @@ struct LogicManglerModule : Module {
     dsp::SchmittTrigger undoTrigger;
     dsp::SchmittTrigger redoTrigger;
 
-    dsp::PulseGenerator trigPulse[NUM_CHANNELS];
-    bool prevGateHigh[NUM_CHANNELS] = {};
+    dsp::PulseGenerator trigPulse[MAX_LANES][NUM_CHANNELS];
+    uint16_t prevGateHigh[NUM_CHANNELS] = {};   // Bit l = lane l
 
     std::atomic<uint8_t> currentInputState{0};
     std::atomic<bool> gateStates[NUM_CHANNELS];
     bool expanderConnected = false;
 
     // Expander messages
-    EuclogicExpanderMessage rightMessages[2];
+    Message rightMessages[2];
+    typename Message::Logic publishedLogic;  // Last table/knobs sent, with their generation
+
+    // Bank recall being passed on to EucSeq
+    Snapshot forwardRecall;
+    bool forwardPending = false;
 
-    LogicManglerModule() {
+    LogicManglerModuleT() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
         configButton(RANDOM_PARAM, "Randomize");
@@ -108,10 +126,10 @@ struct LogicManglerModule : Module {
     }
 
     void onReset() override {
-        truthTable = TruthTable();
+        truthTable = Table();
         for (int i = 0; i < NUM_CHANNELS; i++) {
             gateStates[i].store(false);
-            prevGateHigh[i] = false;
+            prevGateHigh[i] = 0;
         }
         currentInputState.store(0);
     }
@@ -132,62 +150,79 @@ struct LogicManglerModule : Module {
         if (redoTrigger.process(params[REDO_PARAM].getValue())) {
             truthTable.redo();
         }
+        processRecall();
 
-        // Get input gates - from expander or direct inputs
-        bool inputGates[NUM_CHANNELS] = {};
+        // Get input gates - from expander or direct inputs.
+        // Bit-sliced: bit l of inputGates[i] is lane l of channel i.
+        uint16_t inputGates[NUM_CHANNELS] = {};
+        int lanes = 1;
         expanderConnected = false;
 
         // Check left expander for EucSeq message
         if (leftExpander.module) {
-            EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->valid) {
+            const Message* msg = static_cast<const Message*>(leftExpander.consumerMessage);
+            if (msg && msg->usable()) {
                 expanderConnected = true;
                 for (int i = 0; i < NUM_CHANNELS; i++) {
-                    inputGates[i] = msg->gates[i];
+                    inputGates[i] = msg->hot.gate(i) ? 1 : 0;
                 }
             }
         }
 
-        // Fallback to direct gate inputs
+        // Fallback to direct gate inputs (mono inputs are shared by every lane)
         if (!expanderConnected) {
             for (int i = 0; i < NUM_CHANNELS; i++) {
-                inputGates[i] = inputs[GATE_INPUT + i].getVoltage() > 1.0f;
+                lanes = std::max(lanes, inputs[GATE_INPUT + i].getChannels());
+            }
+            for (int i = 0; i < NUM_CHANNELS; i++) {
+                for (int l = 0; l < lanes; l++) {
+                    if (inputs[GATE_INPUT + i].getPolyVoltage(l) > 1.0f) inputGates[i] |= 1 << l;
+                }
             }
         }
 
-        // Build input state for truth table
+        // Build input state for truth table (display follows lane 1)
         uint8_t inputState = 0;
         for (int i = 0; i < NUM_CHANNELS; i++) {
-            if (inputGates[i]) inputState |= (1 << i);
+            if (inputGates[i] & 1) inputState |= (1 << i);
         }
         currentInputState.store(inputState);
 
-        // Apply truth table
-        bool postLogicStates[NUM_CHANNELS];
-        truthTable.evaluate(inputGates, postLogicStates);
+        // Apply truth table to every lane at once
+        uint16_t laneMask = static_cast<uint16_t>((1u << lanes) - 1);
+        uint16_t postLogicStates[NUM_CHANNELS];
+        truthTable.evaluateSliced(inputGates, postLogicStates, laneMask);
 
         // Apply Probability B and generate outputs
         for (int i = 0; i < NUM_CHANNELS; i++) {
             float probBBase = params[PROB_B_PARAM + i].getValue();
-            float probBCV = inputs[PROB_B_CV_INPUT + i].getVoltage() / 10.f;
-            float probBVal = DSP::clamp(probBBase + probBCV, 0.f, 1.f);
-
-            bool finalOutput = postLogicStates[i] && probB[i].process(true, probBVal);
+            uint16_t finalGates = 0;
+
+            outputs[GATE_OUTPUT + i].setChannels(lanes);
+            outputs[TRIG_OUTPUT + i].setChannels(lanes);
+            for (int l = 0; l < lanes; l++) {
+                float probBCV = inputs[PROB_B_CV_INPUT + i].getPolyVoltage(l) / 10.f;
+                float probBVal = DSP::clamp(probBBase + probBCV, 0.f, 1.f);
+
+                bool finalOutput = ((postLogicStates[i] >> l) & 1) && probB[i].process(true, probBVal);
+                bool wasHigh = (prevGateHigh[i] >> l) & 1;
+                if (finalOutput && !wasHigh) {
+                    trigPulse[l][i].trigger(TRIGGER_PULSE_DURATION);
+                }
+                if (finalOutput) finalGates |= 1 << l;
 
-            if (finalOutput && !prevGateHigh[i]) {
-                trigPulse[i].trigger(TRIGGER_PULSE_DURATION);
+                outputs[GATE_OUTPUT + i].setVoltage(finalOutput ? 10.f : 0.f, l);
+                outputs[TRIG_OUTPUT + i].setVoltage(trigPulse[l][i].process(dt) ? 10.f : 0.f, l);
             }
 
-            gateStates[i].store(finalOutput);
-            prevGateHigh[i] = finalOutput;
-
-            outputs[GATE_OUTPUT + i].setVoltage(finalOutput ? 10.f : 0.f);
-            outputs[TRIG_OUTPUT + i].setVoltage(trigPulse[i].process(dt) ? 10.f : 0.f);
-            lights[GATE_LIGHT + i].setBrightness(finalOutput ? 1.f : 0.f);
+            bool firstLane = finalGates & 1;
+            gateStates[i].store(firstLane);
+            prevGateHigh[i] = finalGates;
+            lights[GATE_LIGHT + i].setBrightness(firstLane ? 1.f : 0.f);
         }
 
         // Update LED matrix
-        for (int state = 0; state < 16; state++) {
+        for (int state = 0; state < N_STATES; state++) {
             uint8_t outputMask = truthTable.getMapping(state);
             bool isCurrentState = (state == inputState);
             for (int bit = 0; bit < NUM_CHANNELS; bit++) {
@@ -199,49 +234,81 @@ struct LogicManglerModule : Module {
 
         // Send expander message to the right
         if (rightExpander.module) {
-            EuclogicExpanderMessage* msg = static_cast<EuclogicExpanderMessage*>(rightExpander.producerMessage);
+            Message* msg = static_cast<Message*>(rightExpander.producerMessage);
 
             // Forward EucSeq data if available
+            const Message* leftMsg = nullptr;
             if (expanderConnected && leftExpander.module) {
-                EuclogicExpanderMessage* leftMsg = static_cast<EuclogicExpanderMessage*>(leftExpander.consumerMessage);
-                if (leftMsg && leftMsg->valid) {
-                    *msg = *leftMsg;
-                }
+                leftMsg = static_cast<const Message*>(leftExpander.consumerMessage);
+            }
+            if (leftMsg && leftMsg->usable()) {
+                msg->hot = leftMsg->hot;
+                msg->publishSeq(leftMsg->seq);
             } else {
-                msg->clear();
+                msg->hot.clear();
+                msg->clearSeq();
             }
 
-            // Add our truth table state
-            auto mapping = truthTable.serialize();
-            auto locks = truthTable.serializeLocks();
-            for (int i = 0; i < 16; i++) {
-                msg->truthTableMapping[i] = mapping[i];
-                msg->truthTableLocks[i] = locks[i];
+            // Add our truth table state; restamped only when it changes
+            typename Message::Logic logic = publishedLogic;
+            for (int i = 0; i < N_STATES; i++) {
+                logic.truthTableMapping[i] = truthTable.mapping[i];
+                logic.truthTableLocks[i] = truthTable.lockMask[i];
             }
+            typename Message::GateWord postLogic = 0;
             for (int i = 0; i < NUM_CHANNELS; i++) {
-                msg->postLogicGates[i] = gateStates[i].load();
-                msg->probB[i] = params[PROB_B_PARAM + i].getValue();
-                msg->colDensity[i] = params[DENSITY_PARAM + i].getValue();
+                postLogic |= static_cast<typename Message::GateWord>(gateStates[i].load() << i);
+                logic.probB[i] = params[PROB_B_PARAM + i].getValue();
+                logic.colDensity[i] = params[DENSITY_PARAM + i].getValue();
             }
-            msg->valid = true;
+            if (!logic.sameValues(publishedLogic)) {
+                publishedLogic = logic;
+                publishedLogic.generation = Message::nextGeneration();
+            }
+            msg->hot.postLogicGates = postLogic;
+            msg->publishLogic(publishedLogic);
+            msg->hot.valid = true;
 
             rightExpander.requestMessageFlip();
         }
     }
 
+    // Apply a snapshot recalled by EucBank, then hand it to EucSeq
+    void processRecall() {
+        if (this->takeRecall(forwardRecall)) {
+            const auto& logic = forwardRecall.logic;
+            std::array<uint8_t, N_STATES> mapping, locks;
+            for (int i = 0; i < N_STATES; i++) {
+                mapping[i] = logic.truthTableMapping[i];
+                locks[i] = logic.truthTableLocks[i];
+            }
+            truthTable.deserialize(mapping);
+            truthTable.deserializeLocks(locks);
+            for (int i = 0; i < NUM_CHANNELS; i++) {
+                params[PROB_B_PARAM + i].setValue(logic.probB[i]);
+                params[DENSITY_PARAM + i].setValue(logic.colDensity[i]);
+            }
+            forwardPending = true;
+        }
+        if (forwardPending) {
+            RecallTarget* target = RecallTarget::of(leftExpander.module);
+            forwardPending = target && !target->postRecall(forwardRecall);
+        }
+    }
+
     json_t* dataToJson() override {
         json_t* rootJ = json_object();
 
         json_t* mappingJ = json_array();
         auto mapping = truthTable.serialize();
-        for (int i = 0; i < 16; i++) {
+        for (int i = 0; i < N_STATES; i++) {
             json_array_append_new(mappingJ, json_integer(mapping[i]));
         }
         json_object_set_new(rootJ, "truthTable", mappingJ);
 
         json_t* locksJ = json_array();
         auto locks = truthTable.serializeLocks();
-        for (int i = 0; i < 16; i++) {
+        for (int i = 0; i < N_STATES; i++) {
             json_array_append_new(locksJ, json_integer(locks[i]));
         }
         json_object_set_new(rootJ, "lockMask", locksJ);
@@ -252,8 +319,8 @@ struct LogicManglerModule : Module {
     void dataFromJson(json_t* rootJ) override {
         json_t* mappingJ = json_object_get(rootJ, "truthTable");
         if (mappingJ && json_is_array(mappingJ)) {
-            std::array<uint8_t, 16> mapping{};
-            for (int i = 0; i < 16 && i < (int)json_array_size(mappingJ); i++) {
+            std::array<uint8_t, N_STATES> mapping{};
+            for (int i = 0; i < N_STATES && i < (int)json_array_size(mappingJ); i++) {
                 mapping[i] = json_integer_value(json_array_get(mappingJ, i));
             }
             truthTable.deserialize(mapping);
@@ -261,8 +328,8 @@ struct LogicManglerModule : Module {
 
         json_t* locksJ = json_object_get(rootJ, "lockMask");
         if (locksJ && json_is_array(locksJ)) {
-            std::array<uint8_t, 16> locks{};
-            for (int i = 0; i < 16 && i < (int)json_array_size(locksJ); i++) {
+            std::array<uint8_t, N_STATES> locks{};
+            for (int i = 0; i < N_STATES && i < (int)json_array_size(locksJ); i++) {
                 locks[i] = json_integer_value(json_array_get(locksJ, i));
             }
             truthTable.deserializeLocks(locks);
@@ -270,6 +337,8 @@ struct LogicManglerModule : Module {
     }
 };
 
+using LogicManglerModule = LogicManglerModuleT<4>;
+
 // ============================================================================
 // Truth Table Display with lock support
 // ============================================================================
@@ -10,6 +10,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME Matter
 #include "matter.hpp"  // Generated by Faust
+#include "matter_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +18,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::matter;
+
 /**
  * Matter - Physical Model of a Struck Solid in a Tube
  *
@@ -88,24 +91,25 @@ struct Matter : FaustModule<VCVRackDSP> {
         configOutput(RIGHT_OUTPUT, "Right");
 
         // Map VCV parameters to Faust DSP parameters
-        // Faust params (alphabetical): decay=0, gate=1, hardness=2, position=3, structure=4, tube=5, tube_mix=6, volts=7
-        mapParam(DECAY_PARAM, 0);
-        mapParam(HARDNESS_PARAM, 2);
-        mapParam(POSITION_PARAM, 3);
-        mapParam(STRUCTURE_PARAM, 4);
-        mapParam(TUBE_PARAM, 5);
-        mapParam(TUBE_MIX_PARAM, 6);
+        mapParam(DECAY_PARAM, FP::DECAY);
+        mapParam(HARDNESS_PARAM, FP::HARDNESS);
+        mapParam(POSITION_PARAM, FP::POSITION);
+        mapParam(STRUCTURE_PARAM, FP::STRUCTURE);
+        mapParam(TUBE_PARAM, FP::TUBE);
+        mapParam(TUBE_MIX_PARAM, FP::TUBE_MIX);
 
         // Map CV inputs with linear modulation (0.1 scale = ±10V maps to ±1.0)
-        mapCVInput(HARDNESS_CV_INPUT, 2, false, 0.1f);
-        mapCVInput(POSITION_CV_INPUT, 3, false, 0.1f);
-        mapCVInput(STRUCTURE_CV_INPUT, 4, false, 0.1f);
+        mapCVInput(HARDNESS_CV_INPUT, FP::HARDNESS, false, 0.1f);
+        mapCVInput(POSITION_CV_INPUT, FP::POSITION, false, 0.1f);
+        mapCVInput(STRUCTURE_CV_INPUT, FP::STRUCTURE, false, 0.1f);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -113,16 +117,13 @@ struct Matter : FaustModule<VCVRackDSP> {
         updateFaustParams();
 
         // Set gate and V/Oct directly (not mapped)
-        // Faust params (alphabetical): gate=1, volts=7
-        faustDsp.setParamValue(1, inputs[GATE_INPUT].getVoltage());
-        faustDsp.setParamValue(7, inputs[VOCT_INPUT].getVoltage());
+        faustDsp.setParamValue(FP::GATE, inputs[GATE_INPUT].getVoltage());
+        faustDsp.setParamValue(FP::VOLTS, inputs[VOCT_INPUT].getVoltage());
 
         // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(nullptr, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak (VCV standard)
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
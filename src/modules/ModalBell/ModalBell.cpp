@@ -2,14 +2,19 @@
  * MODAL BELL
  * Morphing Percussion Synthesizer - Wood Block to Glockenspiel
  * Uses modal synthesis with 5-instrument interpolation
- * Built with Faust DSP
+ * Mallet exciter built with Faust DSP, modal bank in C++
  ******************************************************************************/
 
 #include "rack.hpp"
-#include "FaustModule.hpp"
+#include "FaustPolyModule.hpp"
 #include "ImagePanel.hpp"
+#include "DSP.hpp"
+#include "ModalVoice.hpp"
+#include "SimdBank.hpp"
+#include <cmath>
 #define FAUST_MODULE_NAME ModalBell
 #include "modal_bell.hpp"  // Generated by Faust
+#include "modal_bell_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +22,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::modal_bell;
+
 /**
  * ModalBell - Morphing Percussion Synthesizer
  *
@@ -31,14 +38,21 @@ namespace WiggleRoom {
  *   - V/Oct: Pitch control (0V = C4)
  *   - Gate: Trigger input (strikes when > 0.5V)
  *
+ * Polyphonic: one bell voice per channel of the V/Oct/Gate/CV cables
+ * (up to 16), outputs carry the same channel count.
+ *
  * Parameters:
  *   - Morph: Instrument type (main macro control)
  *   - Brightness: Harmonic content
  *   - Damping: Choke the sound (0=ring, 1=muted)
  *   - Strike: Position on bar (0=edge, 0.5=center)
  *   - Velocity: Mallet hardness (0=soft wool, 1=hard metal)
+ *
+ * The Faust DSP generates the mallet strike; each voice's modes run in a
+ * ModalVoice, which skips modes that have decayed. The context menu
+ * switches between 9 modes and 16 (richer upper partials on low notes).
  */
-struct ModalBell : FaustModule<VCVRackDSP> {
+struct ModalBell : FaustPolyModule<VCVRackDSP> {
     enum ParamId {
         MORPH_PARAM,
         BRIGHTNESS_PARAM,
@@ -66,6 +80,18 @@ struct ModalBell : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int CONTROL_INTERVAL = 16;
+
+    ModalVoice modal[MAX_POLY];
+    ModalVoice::Controls smoothed[MAX_POLY];
+    SmooStep smoo;
+    bool gateHigh[MAX_POLY] = {};
+    bool smoothedPrimed[MAX_POLY] = {};
+    int modeCount = ModalVoice::STANDARD_MODES;
+    int activeVoices = 0;
+    int controlCounter = 0;
+    float modalSampleRate = 0.f;
+
     ModalBell() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -92,51 +118,129 @@ struct ModalBell : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Map VCV parameters to Faust DSP parameters (alphabetical order)
-        // Faust params: 0=brightness, 1=damping, 2=gate, 3=morph, 4=strike, 5=velocity, 6=volts
-        mapParam(BRIGHTNESS_PARAM, 0);
-        mapParam(DAMPING_PARAM, 1);
-        mapParam(MORPH_PARAM, 3);
-        mapParam(STRIKE_PARAM, 4);
-        mapParam(VELOCITY_PARAM, 5);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(BRIGHTNESS_PARAM, FP::BRIGHTNESS);
+        mapParam(DAMPING_PARAM, FP::DAMPING);
+        mapParam(MORPH_PARAM, FP::MORPH);
+        mapParam(STRIKE_PARAM, FP::STRIKE);
+        mapParam(VELOCITY_PARAM, FP::VELOCITY);
 
         // Map CV inputs (±5V modulation)
-        mapCVInput(BRIGHTNESS_CV_INPUT, 0, false, 0.1f);   // ±50% at ±5V
-        mapCVInput(DAMPING_CV_INPUT, 1, false, 0.1f);      // ±50% at ±5V
-        mapCVInput(MORPH_CV_INPUT, 3, false, 0.1f);        // ±50% at ±5V
-        mapCVInput(STRIKE_CV_INPUT, 4, false, 0.05f);      // ±25% at ±5V (0-0.5 range)
-        mapCVInput(VELOCITY_CV_INPUT, 5, false, 0.1f);     // ±50% at ±5V
+        mapCVInput(BRIGHTNESS_CV_INPUT, FP::BRIGHTNESS, false, 0.1f);  // ±50% at ±5V
+        mapCVInput(DAMPING_CV_INPUT, FP::DAMPING, false, 0.1f);        // ±50% at ±5V
+        mapCVInput(MORPH_CV_INPUT, FP::MORPH, false, 0.1f);            // ±50% at ±5V
+        mapCVInput(STRIKE_CV_INPUT, FP::STRIKE, false, 0.05f);         // ±25% at ±5V (0-0.5 range)
+        mapCVInput(VELOCITY_CV_INPUT, FP::VELOCITY, false, 0.1f);      // ±50% at ±5V
+
+        // Voice count follows the pitch/gate cables
+        addPolyInput(VOCT_INPUT);
+        addPolyInput(GATE_INPUT);
+    }
+
+    void setModeCount(int count) {
+        modeCount = clamp(count, 1, ModalVoice::MAX_MODES);
+    }
+
+    int getModeCount() const {
+        return modeCount;
+    }
+
+    // One si.smoo step towards target, snapping once within epsilon
+    static float smoothStep(float current, float target, float coeff) {
+        float next = current + (target - current) * coeff;
+        return std::fabs(target - next) < 1e-4f ? target : next;
+    }
+
+    // Mode controls of voice c from its Faust parameters (knobs + CV)
+    void updateModalControls(int c, bool snap) {
+        VCVRackDSP& dsp = voice(c);
+        ModalVoice::Controls target;
+        target.brightness = dsp.getParamValue(FP::BRIGHTNESS);
+        target.damping = dsp.getParamValue(FP::DAMPING);
+        target.morph = dsp.getParamValue(FP::MORPH);
+        target.strike = dsp.getParamValue(FP::STRIKE);
+        target.velocity = dsp.getParamValue(FP::VELOCITY);
+        target.volts = dsp.getParamValue(FP::VOLTS);
+
+        ModalVoice::Controls& s = smoothed[c];
+        if (snap || !smoothedPrimed[c]) {
+            s = target;
+            smoothedPrimed[c] = true;
+        } else {
+            // Pitch and velocity are not smoothed, as in the Faust original
+            float coeff = smoo.coefficient(CONTROL_INTERVAL);
+            s.brightness = smoothStep(s.brightness, target.brightness, coeff);
+            s.damping = smoothStep(s.damping, target.damping, coeff);
+            s.morph = smoothStep(s.morph, target.morph, coeff);
+            s.strike = smoothStep(s.strike, target.strike, coeff);
+            s.velocity = target.velocity;
+            s.volts = target.volts;
+        }
+        modal[c].setControls(s, modeCount, modalSampleRate);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
+            initVoices(static_cast<int>(args.sampleRate));
+        }
+        if (args.sampleRate != modalSampleRate) {
+            modalSampleRate = args.sampleRate;
+            for (auto& m : modal) m.reset();
         }
 
-        // Get V/Oct and Gate inputs and send directly to Faust
-        float voct = inputs[VOCT_INPUT].getVoltage();
-        float gate = inputs[GATE_INPUT].getVoltage();
-
-        // Set Faust parameters for inputs
-        // Faust params: 0=brightness, 1=damping, 2=gate, 3=morph, 4=strike, 5=velocity, 6=volts
-        faustDsp.setParamValue(6, voct);   // volts
-        faustDsp.setParamValue(2, gate);   // gate
-
-        // Update all mapped parameters with CV modulation
-        updateFaustParams();
-
-        // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        int numChannels = updateChannels();
+        for (int c = activeVoices; c < numChannels; c++) {
+            modal[c].reset();
+            smoothedPrimed[c] = false;
+        }
+        activeVoices = numChannels;
+
+        bool controlStep = --controlCounter <= 0;
+        if (controlStep) controlCounter = CONTROL_INTERVAL;
+
+        for (int c = 0; c < numChannels; c++) {
+            // Get V/Oct and Gate inputs and send directly to Faust
+            float voct = inputs[VOCT_INPUT].getPolyVoltage(c);
+            float gate = inputs[GATE_INPUT].getPolyVoltage(c);
+
+            voice(c).setParamValue(FP::VOLTS, voct);
+            voice(c).setParamValue(FP::GATE, gate);
+
+            // Update all mapped parameters with CV modulation
+            updateVoiceParams(c);
+
+            // Retune straight away on a strike so it rings at the new pitch
+            bool strike = gate > 0.5f && !gateHigh[c];
+            gateHigh[c] = gate > 0.5f;
+            if (strike || controlStep) {
+                updateModalControls(c, strike);
+                modal[c].update();
+            }
+
+            // Mallet exciter (no input, mono output) -> modal bank
+            float exciter = 0.f;
+            computeVoice(c, nullptr, &exciter);
+            float out = modal[c].process(exciter);
+
+            // Output at 5V peak
+            outputs[LEFT_OUTPUT].setVoltage(out * 5.0f, c);
+            outputs[RIGHT_OUTPUT].setVoltage(out * 5.0f, c);
+        }
+    }
 
-        faustDsp.compute(1, nullInputs, outputPtrs);
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustPolyModule::dataToJson();
+        json_object_set_new(rootJ, "modes", json_integer(modeCount));
+        return rootJ;
+    }
 
-        // Output at 5V peak
-        outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
-        outputs[RIGHT_OUTPUT].setVoltage(outputR * 5.0f);
+    void dataFromJson(json_t* rootJ) override {
+        FaustPolyModule::dataFromJson(rootJ);
+        json_t* modesJ = json_object_get(rootJ, "modes");
+        if (modesJ) setModeCount(static_cast<int>(json_integer_value(modesJ)));
     }
 };
 
@@ -201,6 +305,20 @@ struct ModalBellWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 350), module, ModalBell::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<ModalBell*>(this->module);
+        if (!m) return;
+
+        static const int counts[] = {ModalVoice::STANDARD_MODES, ModalVoice::MAX_MODES};
+        menu->addChild(new MenuSeparator());
+        menu->addChild(createIndexSubmenuItem("Modes",
+            {"9 (standard)", "16 (rich, idle modes are skipped)"},
+            [=]() { return m->getModeCount() == counts[1] ? (size_t)1 : (size_t)0; },
+            [=](size_t index) { m->setModeCount(counts[index]); }
+        ));
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "DSP.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace WiggleRoom {
+
+/**
+ * Modal resonator bank for one bell voice, with amplitude-based culling
+ *
+ * Each mode is Faust's fi.resonbp (peak gain = gain * Q) in transposed
+ * direct form II. Only active modes are computed. At control rate, when the
+ * exciter has been silent, each mode's amplitude is read from its filter
+ * state (for a free-ringing resonator two consecutive outputs give it
+ * exactly) and modes further than CULL_RELATIVE below the loudest mode or
+ * under CULL_FLOOR are dropped with their state. Any exciter signal, i.e.
+ * every strike, brings all modes back. Modes above SR / 2.2 are disabled
+ * instead of being clamped there.
+ *
+ * Mode tuning follows the original modal_bell.dsp: modes 1-3 from the
+ * interpolated instrument presets, higher modes extrapolated from them.
+ */
+struct ModalVoice {
+    static constexpr int STANDARD_MODES = 9;
+    static constexpr int MAX_MODES = 16;
+    static constexpr float CULL_RELATIVE = 1e-6f;      // Power ratio (-60 dB)
+    static constexpr float CULL_FLOOR = 1e-10f;        // Power (-100 dB)
+    static constexpr float EXCITE_THRESHOLD = 1e-6f;
+
+    struct Controls {
+        float brightness = 0.5f;
+        float damping = 0.f;
+        float morph = 0.25f;
+        float strike = 0.3f;
+        float velocity = 0.8f;
+        float volts = 0.f;
+
+        bool operator==(const Controls& o) const {
+            return brightness == o.brightness && damping == o.damping && morph == o.morph &&
+                   strike == o.strike && velocity == o.velocity && volts == o.volts;
+        }
+    };
+
+    struct Mode {
+        float b0 = 0.f, a1 = 0.f, a2 = 0.f;
+        float s1 = 0.f, s2 = 0.f;
+        float cosw = 1.f, invSin2 = 0.f;   // For the amplitude estimate
+    };
+
+    Mode modes[MAX_MODES];
+    int active[MAX_MODES] = {};   // Indices of the modes being computed
+    int numActive = 0;
+    int numEnabled = 0;           // Modes 0..numEnabled-1 are below SR / 2.2
+    bool excited = false;         // Exciter signal since the last cull()
+    bool dirty = true;
+
+    Controls controls;
+    int modeCount = STANDARD_MODES;
+    float sampleRate = 0.f;
+
+    // Output stage: fi.dcblocker, gain compensation
+    float dcIn = 0.f, dcOut = 0.f;
+    float outputGain = 1.f;
+
+    void reset() {
+        for (Mode& m : modes) m.s1 = m.s2 = 0.f;
+        numActive = 0;
+        excited = false;
+        dcIn = dcOut = 0.f;
+    }
+
+    // Takes effect on the next retune(); cheap when nothing changed
+    void setControls(const Controls& c, int count, float rate) {
+        if (c == controls && count == modeCount && rate == sampleRate) return;
+        controls = c;
+        modeCount = count;
+        sampleRate = rate;
+        dirty = true;
+    }
+
+    void retune() {
+        dirty = false;
+        const Controls& c = controls;
+
+        // 5-stage morph interpolation: wood block, marimba, vibraphone, kalimba, glockenspiel
+        static const float R2[] = {1.41f, 3.99f, 3.99f, 6.2f, 2.71f};
+        static const float R3[] = {2.3f, 10.0f, 9.2f, 14.3f, 5.35f};
+        static const float DECAY[] = {0.4f, 1.2f, 4.0f, 2.5f, 3.5f};
+        float pos = DSP::clamp(c.morph, 0.f, 1.f) * 4.f;
+        int seg = std::min(static_cast<int>(pos), 3);
+        float t = pos - seg;
+        float r2 = R2[seg] + (R2[seg + 1] - R2[seg]) * t;
+        float r3 = R3[seg] + (R3[seg + 1] - R3[seg]) * t;
+        float decay = DECAY[seg] + (DECAY[seg + 1] - DECAY[seg]) * t;
+
+        float freq = std::max(20.f, 261.62f * std::exp2(c.volts));
+        // Damping shortens decay; higher notes decay faster (C4 = full decay)
+        float scaledDecay = decay * (1.f - c.damping * 0.95f) * std::sqrt(261.62f / freq);
+        float baseQ = 50.f + scaledDecay * 200.f;
+
+        // Upper partials follow brightness, strike position and velocity
+        static const float GAINS[MAX_MODES] = {
+            1.0f, 0.7f, 0.55f, 0.4f, 0.3f, 0.22f, 0.15f, 0.1f, 0.06f,
+            0.04f, 0.026f, 0.017f, 0.011f, 0.007f, 0.0045f, 0.003f};
+        static const float GROWTH[MAX_MODES] = {
+            0.f, 0.f, 0.f, 0.6f, 0.7f, 0.75f, 0.8f, 0.85f, 0.9f,
+            0.9f, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f, 0.9f};
+        float effectiveBrightness = c.brightness * (0.4f + c.velocity * 0.6f);
+        float rateOfGrowth = r3 / r2;
+
+        float limit = sampleRate / 2.2f;
+        float ratio = 1.f;
+        numEnabled = 0;
+        for (int n = 0; n < modeCount; n++) {
+            if (n == 1) ratio = r2;
+            else if (n == 2) ratio = r3;
+            else if (n > 2) ratio *= rateOfGrowth * GROWTH[n];
+
+            float f = freq * ratio;
+            if (f >= limit) break;   // Ratios only grow from here
+            numEnabled = n + 1;
+
+            // Simulated nodes/antinodes of the bar at the strike position
+            float gain = GAINS[n] * std::sin((n + 1) * c.strike * 3.14159f);
+            if (n > 0) gain *= effectiveBrightness;
+            float q = baseQ / std::sqrt(static_cast<float>(n + 1));
+
+            // tf2s(0, gain, 0, 1 / Q, 1, wc)
+            float w = 2.f * DSP::PI * f / sampleRate;
+            float k = 1.f / std::tan(0.5f * w);
+            float ksq = k * k;
+            float d = 1.f + k / q + ksq;
+            Mode& m = modes[n];
+            m.b0 = gain * k / d;
+            m.a1 = 2.f * (1.f - ksq) / d;
+            m.a2 = (1.f - k / q + ksq) / d;
+            m.cosw = std::cos(w);
+            float sinw = std::sin(w);
+            m.invSin2 = 1.f / (sinw * sinw);
+        }
+
+        // Disabled modes stop ringing
+        int kept = 0;
+        for (int i = 0; i < numActive; i++) {
+            if (active[i] < numEnabled) active[kept++] = active[i];
+        }
+        numActive = kept;
+        for (int n = numEnabled; n < MAX_MODES; n++) modes[n].s1 = modes[n].s2 = 0.f;
+
+        // Boost when brightness is low to maintain usable output
+        outputGain = 2.5f * (1.f + (1.f - effectiveBrightness) * 0.8f) * (0.7f + c.velocity * 0.3f);
+    }
+
+    float process(float x) {
+        if (std::fabs(x) > EXCITE_THRESHOLD) {
+            excited = true;
+            if (numActive != numEnabled || dirty) activateAll();
+        }
+
+        float sum = 0.f;
+        for (int i = 0; i < numActive; i++) {
+            Mode& m = modes[active[i]];
+            float bx = m.b0 * x;
+            float y = bx + m.s1;
+            m.s1 = m.s2 - m.a1 * y;
+            m.s2 = -bx - m.a2 * y;
+            sum += y;
+        }
+
+        // DC blocker (resonant filters can accumulate DC), gain, soft clip
+        float dc = sum - dcIn + 0.995f * dcOut;
+        dcIn = sum;
+        dcOut = dc;
+        return DSP::fastTanh(dc * outputGain);
+    }
+
+    // Control rate: retune if needed, drop modes that have decayed
+    void update() {
+        if (dirty && numActive > 0) retune();
+        if (excited) {
+            excited = false;
+            return;
+        }
+
+        // With no input, y[n] = -s2 / a2 and y[n+1] = s1; a sinusoid's
+        // amplitude follows from two consecutive samples
+        float power[MAX_MODES];
+        float loudest = 0.f;
+        for (int i = 0; i < numActive; i++) {
+            const Mode& m = modes[active[i]];
+            float y0 = -m.s2 / m.a2;
+            float y1 = m.s1;
+            power[i] = (y0 * y0 + y1 * y1 - 2.f * y0 * y1 * m.cosw) * m.invSin2;
+            loudest = std::max(loudest, power[i]);
+        }
+
+        float floor = std::max(CULL_FLOOR, loudest * CULL_RELATIVE);
+        int kept = 0;
+        for (int i = 0; i < numActive; i++) {
+            if (power[i] >= floor) {
+                active[kept++] = active[i];
+            } else {
+                Mode& m = modes[active[i]];
+                m.s1 = m.s2 = 0.f;
+            }
+        }
+        numActive = kept;
+    }
+
+private:
+    void activateAll() {
+        if (dirty) retune();
+        for (int n = 0; n < numEnabled; n++) active[n] = n;
+        numActive = numEnabled;
+    }
+};
+
+} // namespace WiggleRoom
@@ -11,8 +11,10 @@
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include "BlockNoise.hpp"
 #define FAUST_MODULE_NAME NutShaker
-#include "nutshaker.hpp"  // Generated by Faust
+#include "nutshaker_noise_in.hpp"  // Generated by Faust (noise_in entry point)
+#include "nutshaker_noise_in_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -20,6 +22,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::nutshaker_noise_in;
+
 /**
  * NutShaker - Stochastic Percussion Synthesizer
  *
@@ -44,6 +48,9 @@ namespace WiggleRoom {
  *   - Resonance: Shell Q/decay time
  *   - Spread: Harmonic irregularity
  *   - Mix: Dry clicks vs resonated
+ *
+ * The particle cloud's white noise comes from a BlockNoise and is fed to
+ * the DSP as its input.
  */
 struct NutShaker : FaustModule<VCVRackDSP> {
     enum ParamId {
@@ -76,6 +83,8 @@ struct NutShaker : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    BlockNoise noise;
+
     NutShaker() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -105,30 +114,30 @@ struct NutShaker : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Map VCV parameters to Faust DSP parameters (alphabetical order)
-        // Faust params: 0=chaos, 1=density, 2=duration, 3=force, 4=gate,
-        //               5=level, 6=mix, 7=pitch, 8=resonance, 9=spread, 10=voct
-        mapParam(CHAOS_PARAM, 0);
-        mapParam(DENSITY_PARAM, 1);
-        mapParam(DURATION_PARAM, 2);
-        mapParam(FORCE_PARAM, 3);
-        mapParam(LEVEL_PARAM, 5);
-        mapParam(MIX_PARAM, 6);
-        mapParam(PITCH_PARAM, 7);
-        mapParam(RESONANCE_PARAM, 8);
-        mapParam(SPREAD_PARAM, 9);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(CHAOS_PARAM, FP::CHAOS);
+        mapParam(DENSITY_PARAM, FP::DENSITY);
+        mapParam(DURATION_PARAM, FP::DURATION);
+        mapParam(FORCE_PARAM, FP::FORCE);
+        mapParam(LEVEL_PARAM, FP::LEVEL);
+        mapParam(MIX_PARAM, FP::MIX);
+        mapParam(PITCH_PARAM, FP::PITCH);
+        mapParam(RESONANCE_PARAM, FP::RESONANCE);
+        mapParam(SPREAD_PARAM, FP::SPREAD);
 
         // Map CV inputs
-        mapCVInput(FORCE_CV_INPUT, 3, false, 0.1f);       // ±50% at ±5V
-        mapCVInput(DENSITY_CV_INPUT, 1, false, 50.0f);    // ±250/s at ±5V
-        mapCVInput(PITCH_CV_INPUT, 7, true, 1.0f);        // V/Oct exponential
-        mapCVInput(RESONANCE_CV_INPUT, 8, false, 4.0f);   // ±20 Q at ±5V
+        mapCVInput(FORCE_CV_INPUT, FP::FORCE, false, 0.1f);          // ±50% at ±5V
+        mapCVInput(DENSITY_CV_INPUT, FP::DENSITY, false, 50.0f);     // ±250/s at ±5V
+        mapCVInput(PITCH_CV_INPUT, FP::PITCH, true, 1.0f);           // V/Oct exponential
+        mapCVInput(RESONANCE_CV_INPUT, FP::RESONANCE, false, 4.0f);  // ±20 Q at ±5V
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -137,18 +146,17 @@ struct NutShaker : FaustModule<VCVRackDSP> {
         float gate = inputs[GATE_INPUT].getVoltage();
 
         // Set Faust parameters for inputs
-        faustDsp.setParamValue(10, voct);  // voct
-        faustDsp.setParamValue(4, gate);   // gate
+        faustDsp.setParamValue(FP::VOCT, voct);
+        faustDsp.setParamValue(FP::GATE, gate);
 
         // Update all mapped parameters with CV modulation
         updateFaustParams();
 
-        // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        // Process audio (noise in, stereo out)
+        float noiseIn = noise.next();
+        float frameOut[2] = {};
+        computeFrame(&noiseIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
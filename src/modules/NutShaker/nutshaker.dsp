@@ -53,83 +53,91 @@ shake_env = trig : en.adsr(attack_time, decay_time, sustain_level, release_time)
 // Probability per sample - boosted for audibility
 impulse_rate = max(0.0001, shake_env * density * 2.5 / ma.SR);
 
-// Random trigger with probability
-random_val = abs(no.noise);
-seed_impulse = random_val < impulse_rate;
-
-// 3. Impact Sound Generation - FULLER with longer envelope
-// Each collision is a meaty burst of filtered noise
-impact_amp = 0.6 + 0.4 * random_val;  // Random amplitude 0.6-1.0
-
-// Longer, punchier impact envelope for body
-impulse_env = seed_impulse : en.ar(0.001, 0.015);  // 1ms attack, 15ms release - much fuller
-
-// Bandlimited noise burst (less harsh)
-impact_noise = no.noise * impulse_env * impact_amp * shake_env;
-
-// 4. Shell Resonators - EXPANDED for fuller sound
-// 8 resonators including sub-harmonics for body
-
-// Sub-harmonic for body/thump
-f_sub = base_freq * 0.5;
-// Main frequency cluster (irregular shell modes)
-f1 = base_freq;
-f2 = base_freq * 1.12;   // Slightly detuned
-f3 = base_freq * 1.28;   // Minor third-ish
-f4 = base_freq * 1.41;   // Tritone area - adds tension
-f5 = base_freq * 1.62;   // Golden ratio
-f6 = base_freq * 1.89;   // Upper brightness
-// High overtone for attack definition
-f_high = base_freq * 2.4;
-
-// Variable Q values - longer decay for lower freqs
-q_sub = shell_res * 1.5;   // Body rings longer
-q1 = shell_res;
-q2 = shell_res * 0.9;
-q3 = shell_res * 0.8;
-q4 = shell_res * 0.7;
-q5 = shell_res * 0.6;
-q6 = shell_res * 0.5;
-q_high = shell_res * 0.4;  // Shorter high end
-
-// Parallel resonator bank - 8 voices for richness
-input_signal = impact_noise * 60;
-
-resonated = input_signal <:
-    fi.resonbp(f_sub, q_sub, 1.2),   // Sub body
-    fi.resonbp(f1, q1, 1.0),          // Fundamental
-    fi.resonbp(f2, q2, 0.8),          // Detuned
-    fi.resonbp(f3, q3, 0.7),          // Third
-    fi.resonbp(f4, q4, 0.5),          // Tension
-    fi.resonbp(f5, q5, 0.4),          // Golden
-    fi.resonbp(f6, q6, 0.3),          // Bright
-    fi.resonbp(f_high, q_high, 0.25)  // Attack click
-    :> + * 3;
-
-// 5. Dynamic Pitch Wobble (The "Rattle")
-// Subtle pitch variations as particles bounce
-pitch_wobble = no.noise : ba.sAndH(seed_impulse) * chaos * 80;
-// Wider bandwidth filter to let more resonance through
-wobble_filtered = resonated : fi.resonbp(base_freq + pitch_wobble, 1.5, 1.0);
-
-// 6. Add body with low shelf boost
-body_boost = wobble_filtered : fi.lowshelf(2, 3, base_freq * 0.7);
-
-// 7. Final Mix
-// Blend between raw impacts and full resonated sound
-dry_signal = impact_noise * 80;
-wet_signal = body_boost * 2.5;
-
-mixed = dry_signal * (1 - mix) + wet_signal * mix;
-
-// 8. Output Processing
-// Subtle saturation for warmth, then soft limit
-saturated = mixed * level * 4 : *(1.2) : ma.tanh;
-output = saturated : fi.dcblocker;
-
-// Stereo spread - decorrelate L/R slightly
-spread_amount = 0.2;
-left = output * (0.5 + spread_amount * no.noise : si.smooth(0.999));
-right = output * (0.5 - spread_amount * no.noise : si.smooth(0.999));
-
-process = left, right;
+// Every noise-driven stage below draws from one white noise signal. The
+// module feeds it from a BlockNoise as the DSP's input (noise_in);
+// process uses no.noise so the file still runs on its own.
+shaker(noise) = left, right
+with {
+    // Random trigger with probability
+    random_val = abs(noise);
+    seed_impulse = random_val < impulse_rate;
+
+    // 3. Impact Sound Generation - FULLER with longer envelope
+    // Each collision is a meaty burst of filtered noise
+    impact_amp = 0.6 + 0.4 * random_val;  // Random amplitude 0.6-1.0
+
+    // Longer, punchier impact envelope for body
+    impulse_env = seed_impulse : en.ar(0.001, 0.015);  // 1ms attack, 15ms release - much fuller
+
+    // Bandlimited noise burst (less harsh)
+    impact_noise = noise * impulse_env * impact_amp * shake_env;
+
+    // 4. Shell Resonators - EXPANDED for fuller sound
+    // 8 resonators including sub-harmonics for body
+
+    // Sub-harmonic for body/thump
+    f_sub = base_freq * 0.5;
+    // Main frequency cluster (irregular shell modes)
+    f1 = base_freq;
+    f2 = base_freq * 1.12;   // Slightly detuned
+    f3 = base_freq * 1.28;   // Minor third-ish
+    f4 = base_freq * 1.41;   // Tritone area - adds tension
+    f5 = base_freq * 1.62;   // Golden ratio
+    f6 = base_freq * 1.89;   // Upper brightness
+    // High overtone for attack definition
+    f_high = base_freq * 2.4;
+
+    // Variable Q values - longer decay for lower freqs
+    q_sub = shell_res * 1.5;   // Body rings longer
+    q1 = shell_res;
+    q2 = shell_res * 0.9;
+    q3 = shell_res * 0.8;
+    q4 = shell_res * 0.7;
+    q5 = shell_res * 0.6;
+    q6 = shell_res * 0.5;
+    q_high = shell_res * 0.4;  // Shorter high end
+
+    // Parallel resonator bank - 8 voices for richness
+    input_signal = impact_noise * 60;
+
+    resonated = input_signal <:
+        fi.resonbp(f_sub, q_sub, 1.2),   // Sub body
+        fi.resonbp(f1, q1, 1.0),          // Fundamental
+        fi.resonbp(f2, q2, 0.8),          // Detuned
+        fi.resonbp(f3, q3, 0.7),          // Third
+        fi.resonbp(f4, q4, 0.5),          // Tension
+        fi.resonbp(f5, q5, 0.4),          // Golden
+        fi.resonbp(f6, q6, 0.3),          // Bright
+        fi.resonbp(f_high, q_high, 0.25)  // Attack click
+        :> + * 3;
+
+    // 5. Dynamic Pitch Wobble (The "Rattle")
+    // Subtle pitch variations as particles bounce
+    pitch_wobble = noise : ba.sAndH(seed_impulse) * chaos * 80;
+    // Wider bandwidth filter to let more resonance through
+    wobble_filtered = resonated : fi.resonbp(base_freq + pitch_wobble, 1.5, 1.0);
+
+    // 6. Add body with low shelf boost
+    body_boost = wobble_filtered : fi.lowshelf(2, 3, base_freq * 0.7);
+
+    // 7. Final Mix
+    // Blend between raw impacts and full resonated sound
+    dry_signal = impact_noise * 80;
+    wet_signal = body_boost * 2.5;
+
+    mixed = dry_signal * (1 - mix) + wet_signal * mix;
+
+    // 8. Output Processing
+    // Subtle saturation for warmth, then soft limit
+    saturated = mixed * level * 4 : *(1.2) : ma.tanh;
+    output = saturated : fi.dcblocker;
+
+    // Stereo spread - decorrelate L/R slightly
+    spread_amount = 0.2;
+    left = output * (0.5 + spread_amount * noise : si.smooth(0.999));
+    right = output * (0.5 - spread_amount * noise : si.smooth(0.999));
+};
+
+noise_in = shaker;
+
+process = shaker(no.noise);
@@ -0,0 +1,143 @@
+#pragma once
+
+/******************************************************************************
+ * OctoLFO lane kernel
+ *
+ * Branch-free LFO shaping shared by the module (two float_4 banks of four
+ * LFOs) and the standalone test (one float per LFO). Wave selection is a
+ * weighted sum of all five shapes, and skew/curve/fold are blended in with
+ * 0/1 weights, so every lane runs the same instructions whatever its
+ * settings. The exponents and fold gain are cached in Shape and only
+ * recomputed when a knob moves (setSkew()/setCurve()/setFold()).
+ ******************************************************************************/
+
+#include "DSP.hpp"
+
+namespace WiggleRoom {
+namespace OctoLFOKernel {
+
+/**
+ * Per-lane shaping coefficients (T = float or float_4)
+ */
+template<typename T>
+struct Shape {
+    // Wave weights: output = sine*sin + tri*triangle + saw*saw + square*square
+    // (saw = -1 selects the falling saw)
+    T sine = T(1.0f);
+    T tri = T(0.0f);
+    T saw = T(0.0f);
+    T square = T(0.0f);
+
+    T skewOn = T(0.0f);      // 1 = apply skewPower
+    T skewPower = T(1.0f);
+    T curveOn = T(0.0f);     // 1 = apply curvePower
+    T curvePower = T(1.0f);
+    T foldOn = T(0.0f);      // 1 = apply foldGain
+    T foldGain = T(1.0f);
+};
+
+// Scalar coefficients for one lane, written into whichever lane the caller picks
+struct LaneShape {
+    float sine = 1.0f, tri = 0.0f, saw = 0.0f, square = 0.0f;
+    float skewOn = 0.0f, skewPower = 1.0f;
+    float curveOn = 0.0f, curvePower = 1.0f;
+    float foldOn = 0.0f, foldGain = 1.0f;
+
+    // wave: 0 sine, 1 triangle, 2 saw up, 3 saw down, 4 square
+    void setWave(int wave) {
+        sine = (wave == 0) ? 1.0f : 0.0f;
+        tri = (wave == 1) ? 1.0f : 0.0f;
+        saw = (wave == 2) ? 1.0f : (wave == 3) ? -1.0f : 0.0f;
+        square = (wave == 4) ? 1.0f : 0.0f;
+    }
+
+    // Time warping: phase^(2^(-2 * skew))
+    void setSkew(float skew) {
+        skewOn = (std::abs(skew) < 0.001f) ? 0.0f : 1.0f;
+        skewPower = DSP::fastExp2(-skew * 2.f);
+    }
+
+    // Slope warping: normalized^(3^curve)
+    void setCurve(float curve) {
+        curveOn = (std::abs(curve) < 0.001f) ? 0.0f : 1.0f;
+        curvePower = DSP::fastExp2(curve * 1.5849625f);
+    }
+
+    // Harmonic warping: sin(value * (1 + 4 * foldAmount) * pi)
+    void setFold(float foldAmount) {
+        foldOn = (foldAmount < 0.001f) ? 0.0f : 1.0f;
+        foldGain = 1.f + foldAmount * 4.f;
+    }
+};
+
+inline void storeLane(Shape<float>& dst, int, const LaneShape& src) {
+    dst.sine = src.sine;
+    dst.tri = src.tri;
+    dst.saw = src.saw;
+    dst.square = src.square;
+    dst.skewOn = src.skewOn;
+    dst.skewPower = src.skewPower;
+    dst.curveOn = src.curveOn;
+    dst.curvePower = src.curvePower;
+    dst.foldOn = src.foldOn;
+    dst.foldGain = src.foldGain;
+}
+
+#ifdef WR_DSP_HAS_FLOAT4
+inline void storeLane(Shape<rack::simd::float_4>& dst, int lane, const LaneShape& src) {
+    dst.sine[lane] = src.sine;
+    dst.tri[lane] = src.tri;
+    dst.saw[lane] = src.saw;
+    dst.square[lane] = src.square;
+    dst.skewOn[lane] = src.skewOn;
+    dst.skewPower[lane] = src.skewPower;
+    dst.curveOn[lane] = src.curveOn;
+    dst.curvePower[lane] = src.curvePower;
+    dst.foldOn[lane] = src.foldOn;
+    dst.foldGain[lane] = src.foldGain;
+}
+#endif
+
+/**
+ * Base waveform from phase [0, 1), selected by the Shape weights
+ */
+template<typename T>
+inline T wave(T phase, const Shape<T>& s) {
+    using namespace DSP::FastMathDetail;
+    T centred = phase - T(0.5f);
+    T tri = T(1.0f) - T(4.0f) * vmax(centred, T(0.0f) - centred);
+    T saw = phase * T(2.0f) - T(1.0f);
+    T square = select(less(phase, T(0.5f)), T(-1.0f), T(1.0f));
+    return s.sine * DSP::fastSin2pi(phase) + s.tri * tri + s.saw * saw + s.square * square;
+}
+
+/**
+ * Full shaping chain: skew -> wave -> curve -> fold, clamped to [-1, 1]
+ */
+template<typename T>
+inline T shape(T phase, const Shape<T>& s) {
+    using namespace DSP::FastMathDetail;
+    phase += s.skewOn * (DSP::fastPow(phase, s.skewPower) - phase);
+    T output = wave(phase, s);
+
+    T normalized = (output + T(1.0f)) * T(0.5f);
+    normalized += s.curveOn * (DSP::fastPow(normalized, s.curvePower) - normalized);
+    output = normalized * T(2.0f) - T(1.0f);
+
+    T folded = DSP::fastSin2pi(output * s.foldGain * T(0.5f));  // sin(output * gain * pi)
+    output += s.foldOn * (folded - output);
+
+    return vmin(vmax(output, T(-1.0f)), T(1.0f));
+}
+
+/**
+ * Advance a phase in [0, 1) by delta (cycles per sample, >= 0)
+ */
+template<typename T>
+inline T advance(T phase, T delta) {
+    phase += delta;
+    return phase - DSP::FastMathDetail::floorf(phase);
+}
+
+} // namespace OctoLFOKernel
+} // namespace WiggleRoom
@@ -12,10 +12,20 @@
  *     - Curve: Slope warping (log/exp response)
  *     - Fold: Harmonic warping (wave folding)
  *   - Mini scope display per LFO
+ *
+ * The eight LFOs run as two float_4 banks (LFOKernel.hpp); knobs are read
+ * every PARAM_UPDATE_INTERVAL samples and shaping coefficients are only
+ * recomputed when a knob moves.
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "CachedDisplay.hpp"
+#include "ClockBus.hpp"
+#include "DSP.hpp"
 #include "ImagePanel.hpp"
+#include "LFOKernel.hpp"
+#include "Profiler.hpp"
+#include "ScopeRing.hpp"
 #include <cmath>
 #include <vector>
 #include <string>
@@ -122,8 +132,13 @@ static const std::vector<std::string> FOLD_LABELS = {
     "3/4", "1", "5/4", "4/3", "3/2", "2", "3", "4"
 };
 
+// Phase offsets for the N/E/S/W switch
+static const float PHASE_OFFSETS[] = {0.f, 0.25f, 0.5f, 0.75f};
+
 struct OctoLFO : Module {
     static constexpr int NUM_LFOS = 8;
+    static constexpr int NUM_BANKS = NUM_LFOS / 4;   // float_4 banks
+    static constexpr int PARAM_UPDATE_INTERVAL = 16;
     static constexpr int SCOPE_BUFFER_SIZE = 256;  // 4x zoom out for longer waveform display
 
     enum ParamId {
@@ -154,19 +169,35 @@ struct OctoLFO : Module {
 
     // Clock detection
     dsp::SchmittTrigger clockTrigger;
+    ClockBus::Reader clockBus;
     dsp::SchmittTrigger resetTrigger;
     float timeSinceClock = 0.f;
     float clockPeriod = 0.5f;  // Default 120 BPM
     bool clockDetected = false;
 
-    // LFO state
-    float phases[NUM_LFOS] = {};
-
-    // Scope buffers (circular buffer per LFO)
-    float scopeBuffer[NUM_LFOS][SCOPE_BUFFER_SIZE] = {};
-    int scopeWriteIndex[NUM_LFOS] = {};
-    int scopeDownsample = 0;
+    // LFO state, struct-of-arrays: bank b holds LFOs 4b..4b+3
+    simd::float_4 phases[NUM_BANKS];
+    simd::float_4 rates[NUM_BANKS];            // Master * channel rate (cycles per clock)
+    simd::float_4 phaseOffsets[NUM_BANKS];
+    simd::float_4 scales[NUM_BANKS];
+    simd::float_4 unipolarOffsets[NUM_BANKS];  // 5V for unipolar LFOs, 0V for bipolar
+    OctoLFOKernel::Shape<simd::float_4> shapes[NUM_BANKS];
+    int paramCounter = 0;
+
+    // Knob values the cached shapes were computed from
+    OctoLFOKernel::LaneShape laneShapes[NUM_LFOS];
+    float lastSkew[NUM_LFOS];
+    float lastCurve[NUM_LFOS];
+    int lastWave[NUM_LFOS];
+    int lastFold[NUM_LFOS];
+
+    // Scope history for all eight LFOs (min/max per frame, read by MiniScopeWidget)
     static constexpr int SCOPE_DOWNSAMPLE_RATE = 256;  // 4x zoom out for longer waveform display
+    ScopeRing<SCOPE_BUFFER_SIZE, NUM_LFOS> scope;
+
+#ifdef WR_PROFILE
+    ModuleProfile profile{this};
+#endif
 
     OctoLFO() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -213,59 +244,81 @@ struct OctoLFO : Module {
         configInput(CLOCK_INPUT, "Clock");
         configInput(RESET_INPUT, "Reset");
         configLight(CLOCK_LIGHT, "Clock Lock");
-    }
 
-    // Apply skew (time warping) to phase
-    float applySkew(float phase, float skew) {
-        if (std::abs(skew) < 0.001f) return phase;
-        float power = std::pow(2.f, -skew * 2.f);
-        return std::pow(phase, power);
+        for (int b = 0; b < NUM_BANKS; b++) {
+            phases[b] = 0.f;
+        }
+        for (int i = 0; i < NUM_LFOS; i++) {
+            lastSkew[i] = lastCurve[i] = NAN;
+            lastWave[i] = lastFold[i] = -1;
+        }
+        updateLaneParams();
+        scope.setDecimation(SCOPE_DOWNSAMPLE_RATE);
     }
 
-    // Apply curve (slope warping) to amplitude
-    float applyCurve(float value, float curve) {
-        if (std::abs(curve) < 0.001f) return value;
-        float power = std::pow(3.f, curve);
-        return std::pow(value, power);
-    }
+    /**
+     * Read the knobs into the lane arrays
+     *
+     * Exponents and fold gains are only recomputed for knobs that moved.
+     */
+    void updateLaneParams() {
+        int masterRateIndex = static_cast<int>(params[MASTER_RATE_PARAM].getValue());
+        masterRateIndex = clamp(masterRateIndex, 0, (int)MASTER_RATE_VALUES.size() - 1);
+        float masterRate = MASTER_RATE_VALUES[masterRateIndex];
 
-    // Apply fold (harmonic warping) - foldIndex is index into FOLD_VALUES
-    float applyFold(float value, int foldIndex) {
-        if (foldIndex <= 0 || foldIndex >= (int)FOLD_VALUES.size()) return value;
-        float foldAmount = FOLD_VALUES[foldIndex];
-        if (foldAmount < 0.001f) return value;
-        // Fold amount scales the gain for wave folding
-        float gain = 1.f + foldAmount * 4.f;
-        float folded = value * gain;
-        folded = std::sin(folded * M_PI);
-        return folded;
-    }
+        for (int i = 0; i < NUM_LFOS; i++) {
+            int b = i / 4;
+            int lane = i % 4;
+
+            int lfoRateIndex = static_cast<int>(params[RATE_PARAM + i].getValue());
+            lfoRateIndex = clamp(lfoRateIndex, 0, (int)CHANNEL_RATE_VALUES.size() - 1);
+            rates[b][lane] = masterRate * CHANNEL_RATE_VALUES[lfoRateIndex];
+
+            int phaseIndex = clamp(static_cast<int>(params[PHASE_PARAM + i].getValue()), 0, 3);
+            phaseOffsets[b][lane] = PHASE_OFFSETS[phaseIndex];
+            scales[b][lane] = params[SCALE_PARAM + i].getValue();
+
+            // Per-LFO output mode: 0 = bipolar (±5V), 1 = unipolar (0-10V)
+            bool unipolar = params[BIPOLAR_PARAM + i].getValue() > 0.5f;
+            unipolarOffsets[b][lane] = unipolar ? 5.f : 0.f;
 
-    // Generate base waveform from phase [0, 1)
-    float generateWave(float phase, WaveType wave) {
-        switch (wave) {
-            case WAVE_SINE:
-                return std::sin(phase * 2.f * M_PI);
-            case WAVE_TRIANGLE:
-                return (phase < 0.5f) ? (phase * 4.f - 1.f) : (3.f - phase * 4.f);
-            case WAVE_SAW_UP:
-                return phase * 2.f - 1.f;
-            case WAVE_SAW_DOWN:
-                return 1.f - phase * 2.f;
-            case WAVE_SQUARE:
-                return (phase < 0.5f) ? -1.f : 1.f;
-            default:
-                return 0.f;
+            int wave = static_cast<int>(params[WAVE_PARAM + i].getValue());
+            float skew = params[SKEW_PARAM + i].getValue();
+            float curve = params[CURVE_PARAM + i].getValue();
+            int foldIndex = static_cast<int>(params[FOLD_PARAM + i].getValue());
+            if (wave == lastWave[i] && skew == lastSkew[i]
+                && curve == lastCurve[i] && foldIndex == lastFold[i]) {
+                continue;
+            }
+
+            OctoLFOKernel::LaneShape& ls = laneShapes[i];
+            if (wave != lastWave[i]) ls.setWave(wave);
+            if (skew != lastSkew[i]) ls.setSkew(skew);
+            if (curve != lastCurve[i]) ls.setCurve(curve);
+            if (foldIndex != lastFold[i]) {
+                bool valid = foldIndex > 0 && foldIndex < (int)FOLD_VALUES.size();
+                ls.setFold(valid ? FOLD_VALUES[foldIndex] : 0.f);
+            }
+            lastWave[i] = wave;
+            lastSkew[i] = skew;
+            lastCurve[i] = curve;
+            lastFold[i] = foldIndex;
+            OctoLFOKernel::storeLane(shapes[b], lane, ls);
         }
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
         float dt = args.sampleTime;
 
-        // Clock detection
+        // Clock detection (PreFlightClock's bus carries the exact period)
         timeSinceClock += dt;
 
-        if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), 0.1f, 1.f)) {
+        if (clockBus.read(inputs[CLOCK_INPUT])) {
+            clockPeriod = clockBus.period;
+            clockDetected = true;
+            timeSinceClock = 0.f;
+        } else if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), 0.1f, 1.f)) {
             if (timeSinceClock > 0.001f) {
                 clockPeriod = timeSinceClock;
                 clockDetected = true;
@@ -281,78 +334,38 @@ struct OctoLFO : Module {
 
         // Reset handling
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage(), 0.1f, 1.f)) {
-            for (int i = 0; i < NUM_LFOS; i++) {
-                phases[i] = 0.f;
+            for (int b = 0; b < NUM_BANKS; b++) {
+                phases[b] = 0.f;
             }
         }
 
-        // Master rate multiplier
-        int masterRateIndex = static_cast<int>(params[MASTER_RATE_PARAM].getValue());
-        masterRateIndex = clamp(masterRateIndex, 0, (int)MASTER_RATE_VALUES.size() - 1);
-        float masterRate = MASTER_RATE_VALUES[masterRateIndex];
-
-        // Update scope downsample counter
-        scopeDownsample++;
-        bool updateScope = (scopeDownsample >= SCOPE_DOWNSAMPLE_RATE);
-        if (updateScope) scopeDownsample = 0;
-
-        // Process each LFO
-        for (int i = 0; i < NUM_LFOS; i++) {
-            int lfoRateIndex = static_cast<int>(params[RATE_PARAM + i].getValue());
-            lfoRateIndex = clamp(lfoRateIndex, 0, (int)CHANNEL_RATE_VALUES.size() - 1);
-            float lfoRate = CHANNEL_RATE_VALUES[lfoRateIndex];
-            float combinedRate = masterRate * lfoRate;
-            float freq = combinedRate / clockPeriod;
+        if (--paramCounter <= 0) {
+            paramCounter = PARAM_UPDATE_INTERVAL;
+            WR_PROFILE_SCOPE(profile, "params");
+            updateLaneParams();
+        }
 
-            phases[i] += freq * dt;
-            while (phases[i] >= 1.f) phases[i] -= 1.f;
-            while (phases[i] < 0.f) phases[i] += 1.f;
-
-            WaveType wave = static_cast<WaveType>(
-                static_cast<int>(params[WAVE_PARAM + i].getValue()));
-            float skew = params[SKEW_PARAM + i].getValue();
-            float curve = params[CURVE_PARAM + i].getValue();
-            int foldIndex = static_cast<int>(params[FOLD_PARAM + i].getValue());
+        // Process both banks of four LFOs (timed through the scope push)
+        WR_PROFILE_SCOPE(profile, "waves");
+        simd::float_4 cyclesPerSample = dt / clockPeriod;
+        float scopeFrame[NUM_LFOS];
+        for (int b = 0; b < NUM_BANKS; b++) {
+            phases[b] = OctoLFOKernel::advance(phases[b], rates[b] * cyclesPerSample);
 
             // Phase offset: N=0, E=0.25, S=0.5, W=0.75
-            int phaseIndex = static_cast<int>(params[PHASE_PARAM + i].getValue());
-            static const float PHASE_OFFSETS[] = {0.f, 0.25f, 0.5f, 0.75f};
-            float offsetPhase = phases[i] + PHASE_OFFSETS[phaseIndex];
-            if (offsetPhase >= 1.f) offsetPhase -= 1.f;
-            float skewedPhase = applySkew(offsetPhase, skew);
-            float output = generateWave(skewedPhase, wave);
-
-            float normalized = (output + 1.f) * 0.5f;
-            normalized = applyCurve(normalized, curve);
-            output = normalized * 2.f - 1.f;
-
-            output = applyFold(output, foldIndex);
-            output = clamp(output, -1.f, 1.f);
-
-            // Apply per-channel scale
-            float scale = params[SCALE_PARAM + i].getValue();
-            output *= scale;
-
-            // Per-LFO output mode: 0 = bipolar (±5V), 1 = unipolar (0-10V)
-            bool unipolar = params[BIPOLAR_PARAM + i].getValue() > 0.5f;
+            simd::float_4 offsetPhase = OctoLFOKernel::advance(phases[b], phaseOffsets[b]);
+            simd::float_4 output = OctoLFOKernel::shape(offsetPhase, shapes[b]) * scales[b];
 
-            // Apply output mode (after folding to preserve wave shape)
-            float voltage;
-            if (unipolar) {
-                // Unipolar: 0 to 10V
-                voltage = (output + 1.f) * 5.f;
-            } else {
-                // Bipolar: -5V to +5V
-                voltage = output * 5.f;
-            }
-            outputs[LFO_OUTPUT + i].setVoltage(voltage);
+            // Output mode applied after folding to preserve wave shape
+            simd::float_4 voltage = output * 5.f + unipolarOffsets[b];
 
-            // Update scope buffer (downsampled)
-            if (updateScope) {
-                scopeBuffer[i][scopeWriteIndex[i]] = output;
-                scopeWriteIndex[i] = (scopeWriteIndex[i] + 1) % SCOPE_BUFFER_SIZE;
+            for (int lane = 0; lane < 4; lane++) {
+                int i = b * 4 + lane;
+                outputs[LFO_OUTPUT + i].setVoltage(voltage[lane]);
+                scopeFrame[i] = output[lane];
             }
         }
+        scope.push(scopeFrame);
     }
 
     json_t* dataToJson() override {
@@ -370,17 +383,23 @@ struct OctoLFO : Module {
 };
 
 // Mini scope widget for displaying LFO waveform
-struct MiniScopeWidget : Widget {
+struct MiniScopeWidget : WiggleRoom::CachedDisplay<> {
     OctoLFO* module;
     int lfoIndex;
     NVGcolor waveColor;
+    float mins[OctoLFO::SCOPE_BUFFER_SIZE];
+    float maxs[OctoLFO::SCOPE_BUFFER_SIZE];
 
     MiniScopeWidget() {
         box.size = Vec(30, 20);
         waveColor = nvgRGB(0x00, 0xff, 0x80);
     }
 
-    void draw(const DrawArgs& args) override {
+    uint64_t dataGeneration() override {
+        return module ? module->scope.framesPublished() : 0;
+    }
+
+    void drawStatic(const DrawArgs& args) override {
         // Background
         nvgBeginPath(args.vg);
         nvgRect(args.vg, 0, 0, box.size.x, box.size.y);
@@ -401,36 +420,40 @@ struct MiniScopeWidget : Widget {
         nvgStroke(args.vg);
     }
 
-    void drawLayer(const DrawArgs& args, int layer) override {
-        if (layer != 1) return;
+    void drawDynamic(const DrawArgs& args) override {
         if (!module) return;
 
-        // Draw waveform
-        nvgBeginPath(args.vg);
-
-        int bufferSize = OctoLFO::SCOPE_BUFFER_SIZE;
-        int startIndex = module->scopeWriteIndex[lfoIndex];
+        int count = module->scope.snapshotChannel(lfoIndex, mins, maxs, OctoLFO::SCOPE_BUFFER_SIZE);
+        if (count < 2) return;
 
-        for (int i = 0; i < bufferSize; i++) {
-            int idx = (startIndex + i) % bufferSize;
-            float sample = module->scopeBuffer[lfoIndex][idx];
-
-            float x = (float)i / (bufferSize - 1) * box.size.x;
-            float y = (1.f - sample) * 0.5f * box.size.y;
-            y = clamp(y, 1.f, box.size.y - 1.f);
+        // Draw waveform as its min/max envelope: along the maxima, back along the minima
+        auto toY = [&](float sample) {
+            return clamp((1.f - sample) * 0.5f * box.size.y, 1.f, box.size.y - 1.f);
+        };
+        float xScale = box.size.x / (OctoLFO::SCOPE_BUFFER_SIZE - 1);
+        float xStart = (OctoLFO::SCOPE_BUFFER_SIZE - count) * xScale;
 
+        nvgBeginPath(args.vg);
+        for (int i = 0; i < count; i++) {
+            float x = xStart + i * xScale;
             if (i == 0) {
-                nvgMoveTo(args.vg, x, y);
+                nvgMoveTo(args.vg, x, toY(maxs[i]));
             } else {
-                nvgLineTo(args.vg, x, y);
+                nvgLineTo(args.vg, x, toY(maxs[i]));
             }
         }
+        for (int i = count - 1; i >= 0; i--) {
+            nvgLineTo(args.vg, xStart + i * xScale, toY(mins[i]));
+        }
+        nvgClosePath(args.vg);
 
+        NVGcolor fillColor = waveColor;
+        fillColor.a = 0.35f;
+        nvgFillColor(args.vg, fillColor);
+        nvgFill(args.vg);
         nvgStrokeColor(args.vg, waveColor);
         nvgStrokeWidth(args.vg, 1.0f);
         nvgStroke(args.vg);
-
-        Widget::drawLayer(args, layer);
     }
 };
 
@@ -511,6 +534,14 @@ struct OctoLFOWidget : ModuleWidget {
             addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(colOut, y)), module, OctoLFO::LFO_OUTPUT + i));
         }
     }
+
+#ifdef WR_PROFILE
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<OctoLFO*>(this->module);
+        if (!m) return;
+        WR_PROFILE_MENU(menu, m);
+    }
+#endif
 };
 
 } // namespace WiggleRoom
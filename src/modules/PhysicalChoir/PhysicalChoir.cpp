@@ -2,14 +2,30 @@
  * PHYSICAL CHOIR
  * Hybrid Source-Filter Vocal Synthesis
  * Combines physical glottis modeling with formant filtering
+ * Polyphonic singers share one formant tuning and one reverb
  * Built with Faust DSP
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
-#define FAUST_MODULE_NAME PhysicalChoir
-#include "physical_choir.hpp"  // Generated by Faust
+#include "DSP.hpp"
+#include <cmath>
+
+// The mono voice and the reverb bus are generated from physical_choir.dsp
+// as separate DSPs (faust -pn, see CMakeLists.txt), so two Faust headers
+// share this translation unit
+#define FAUST_NO_GLOBAL_ALIAS
+
+#define FAUST_MODULE_NAME PhysicalChoirVoice
+#include "physical_choir_voice.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME PhysicalChoirReverb
+#include "physical_choir_reverb.hpp"
+
+// Faust parameter indices
+#include "physical_choir_voice_params.hpp"
+#include "physical_choir_reverb_params.hpp"
 
 using namespace rack;
 
@@ -17,6 +33,227 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+using VoiceDSP = FaustGenerated::NS_PhysicalChoirVoice::VCVRackDSP;
+using ReverbDSP = FaustGenerated::NS_PhysicalChoirReverb::VCVRackDSP;
+
+namespace FP_VOICE = FaustParams::physical_choir_voice;
+namespace FP_REVERB = FaustParams::physical_choir_reverb;
+
+using simd::float_4;
+
+/**
+ * Formant tuning shared by every singer
+ *
+ * Vowel and throat are common to the whole choir, so the vowel-table
+ * lookup and the F4/F5 filter coefficients are computed once per control
+ * tick. F1-F3 also open with each singer's own envelope; their raw
+ * frequencies are shared and every singer group scales them per lane.
+ */
+struct FormantTuning {
+    float raw[5] = {730.f, 1090.f, 2440.f, 3300.f, 4500.f};   // Hz, after throat scaling
+    float_4 b0[2] = {}, a1[2] = {}, a2[2] = {};                // F4, F5 broadcast to all lanes
+
+    // fi.resonbp(f, q, gain) = tf2s(0, gain, 0, 1 / q, 1, 2 * pi * f), as in ModalBell
+    static void resonbp(float_4 freq, float q, float gain, float sampleTime,
+                        float_4& b0, float_4& a1, float_4& a2) {
+        // c = 1 / tan(pi * f / SR); f <= 0.45 * SR keeps the angle below pi / 2
+        float_4 p = simd::fmin(freq, 0.45f / sampleTime) * (0.5f * sampleTime);
+        float_4 c = DSP::fastCos2pi(p) / DSP::fastSin2pi(p);
+        float_4 csq = c * c;
+        float_4 d = 1.f + c / q + csq;
+        b0 = gain * c / d;
+        a1 = 2.f * (1.f - csq) / d;
+        a2 = (1.f - c / q + csq) / d;
+    }
+
+    void update(float vowel, float throat, float sampleTime) {
+        // Vowel tables from physical_choir.dsp: Ah, Eh, Ee, Oh, Oo
+        static const float TABLE[5][5] = {
+            {730.f, 660.f, 270.f, 570.f, 300.f},
+            {1090.f, 1720.f, 2290.f, 840.f, 870.f},
+            {2440.f, 2410.f, 3010.f, 2410.f, 2240.f},
+            {3300.f, 3300.f, 3500.f, 3500.f, 3300.f},
+            {4500.f, 4500.f, 4800.f, 4700.f, 4500.f}};
+        int seg = std::min(static_cast<int>(vowel), 3);
+        float t = vowel - seg;
+        for (int f = 0; f < 5; f++) {
+            raw[f] = (TABLE[f][seg] * (1.f - t) + TABLE[f][seg + 1] * t) / throat;
+        }
+        resonbp(float_4(std::max(2500.f, raw[3])), 5.f, 0.3f, sampleTime, b0[0], a1[0], a2[0]);
+        resonbp(float_4(std::max(3500.f, raw[4])), 4.f, 0.2f, sampleTime, b0[1], a1[1], a2[1]);
+    }
+};
+
+/**
+ * Four singers of the poly choir, one per float_4 lane
+ *
+ * The choir_voice model of physical_choir.dsp with one glottal source per
+ * singer instead of the four-voice ensemble: each singer has its own
+ * pitch, envelopes, detune and vibrato rate jitter, and the ensemble comes
+ * from the singers themselves. Every state below is four singers wide.
+ * The seven formant filters (F1 and F2 cascaded twice) run in transposed
+ * direct form II, as in ResonatorBank.
+ *
+ * The group sleeps once all four singers have been released and silent
+ * for the hold time, and wakes on the next gate.
+ */
+struct SingerGroup {
+    static constexpr int NUM_FILTERS = 7;
+
+    // Pitch and glottal source
+    float_4 target = 261.626f;   // Hz including detune
+    float_4 freq = 261.626f;
+    float_4 detune = 1.f;
+    float_4 phase = 0.f;
+    DSP::SinePhasor<float_4> vibrato;
+    float_4 vibratoRate = 5.2f;
+    uint32_t noiseState[4] = {};
+
+    // Envelopes (masks are all-ones / all-zeros per lane)
+    float_4 gateMask = 0.f;
+    float_4 ampRamp = 0.f, ampEnv = 0.f;
+    float_4 dip = 0.f, dipRising = 0.f;
+    float_4 openRamp = 0.f, openness = 0.f;
+
+    // Formant filters: F1, F1, F2, F2, F3, F4, F5
+    float_4 b0[NUM_FILTERS] = {}, a1[NUM_FILTERS] = {}, a2[NUM_FILTERS] = {};
+    float_4 s1[NUM_FILTERS] = {}, s2[NUM_FILTERS] = {};
+    float_4 lastHz[3] = {-1.f, -1.f, -1.f};
+
+    bool awake = false;
+    int quietSamples = 0;
+
+    void reset() {
+        freq = target;
+        ampRamp = ampEnv = dip = dipRising = openRamp = openness = 0.f;
+        gateMask = 0.f;
+        for (int i = 0; i < NUM_FILTERS; i++) s1[i] = s2[i] = 0.f;
+        awake = false;
+        quietSamples = 0;
+    }
+
+    void seed(int group) {
+        static const float DETUNE_CENTS[8] = {0.f, 5.f, -5.f, 8.f, -3.f, 3.f, -8.f, 6.f};
+        for (int lane = 0; lane < 4; lane++) {
+            int singer = group * 4 + lane;
+            detune[lane] = std::exp2(DETUNE_CENTS[singer % 8] / 1200.f);
+            noiseState[lane] = 12345u + 2654435761u * static_cast<uint32_t>(singer);
+            // Spread the vibrato phases so the singers don't wobble together
+            vibrato.phase[lane] = 0.37f * singer - std::floor(0.37f * singer);
+        }
+    }
+
+    // Faust's no.noise LCG, one stream per singer
+    float_4 noise() {
+        float_4 out;
+        for (int lane = 0; lane < 4; lane++) {
+            noiseState[lane] = noiseState[lane] * 1103515245u + 12345u;
+            out[lane] = static_cast<int32_t>(noiseState[lane]) * (1.f / 2147483647.f);
+        }
+        return out;
+    }
+
+    // New vibrato rates, as no.lfnoise0(3) in the .dsp
+    void jitter() {
+        float_4 n = noise();
+        vibratoRate = 5.2f + n * 0.5f;
+    }
+
+    /**
+     * Control rate: formant opening envelope and F1-F3 coefficients
+     *
+     * @param steps  Samples since the last call
+     */
+    void update(const FormantTuning& tuning, int steps, float sampleTime) {
+        // en.asr(0.04, 1, 0.3) : si.smooth(0.995)
+        float_4 attack = steps * sampleTime / 0.04f;
+        float_4 release = steps * sampleTime / 0.3f;
+        openRamp = simd::clamp(openRamp + simd::ifelse(gateMask, attack, -release), 0.f, 1.f);
+        openness = openRamp + (openness - openRamp) * std::pow(0.995f, static_cast<float>(steps));
+
+        float_4 hz[3] = {
+            simd::fmax(float_4(150.f), tuning.raw[0] * (0.4f + openness * 0.6f)),
+            simd::fmax(float_4(400.f), tuning.raw[1] * (0.5f + openness * 0.5f)),
+            simd::fmax(float_4(800.f), tuning.raw[2] * (0.7f + openness * 0.3f))};
+        static const float Q[3] = {7.f, 8.f, 6.f};
+        static const float GAIN[4] = {0.8f, 0.6f, 0.7f, 0.5f};
+
+        for (int f = 0; f < 3; f++) {
+            // Sustained notes on a still vowel keep their coefficients
+            if (simd::movemask(hz[f] != lastHz[f]) == 0) continue;
+            lastHz[f] = hz[f];
+            if (f < 2) {
+                FormantTuning::resonbp(hz[f], Q[f], 1.f, sampleTime, b0[2 * f], a1[2 * f], a2[2 * f]);
+                // Same filter shape, second cascade stage only differs in gain
+                b0[2 * f + 1] = b0[2 * f] * GAIN[2 * f + 1];
+                b0[2 * f] *= GAIN[2 * f];
+                a1[2 * f + 1] = a1[2 * f];
+                a2[2 * f + 1] = a2[2 * f];
+            } else {
+                FormantTuning::resonbp(hz[f], Q[f], 0.5f, sampleTime, b0[4], a1[4], a2[4]);
+            }
+        }
+        for (int f = 0; f < 2; f++) {
+            b0[5 + f] = tuning.b0[f];
+            a1[5 + f] = tuning.a1[f];
+            a2[5 + f] = tuning.a2[f];
+        }
+    }
+
+    float_4 filter(int i, float_4 x) {
+        float_4 bx = b0[i] * x;
+        float_4 y = bx + s1[i];
+        s1[i] = s2[i] - a1[i] * y;
+        s2[i] = -bx - a2[i] * y;
+        return y;
+    }
+
+    struct Shared {
+        float sampleTime;
+        float glidePole;
+        float tension;
+        float breath;
+        float_4 ampAttack, ampRelease;
+        float_4 dipAttack, dipRelease;
+    };
+
+    float_4 process(const Shared& sh) {
+        // Envelopes: en.asr(0.08, 1, 0.5) : si.smooth(0.998), en.ar(0.001, 0.06) on each onset
+        ampRamp = simd::clamp(ampRamp + simd::ifelse(gateMask, sh.ampAttack, -sh.ampRelease), 0.f, 1.f);
+        ampEnv = ampRamp + (ampEnv - ampRamp) * 0.998f;
+        dip = simd::clamp(dip + simd::ifelse(dipRising, sh.dipAttack, -sh.dipRelease), 0.f, 1.f);
+        dipRising = dipRising & (dip < 1.f);
+        float_4 articulation = ampEnv * (1.f - dip * 0.7f);
+
+        // Pitch: portamento glide plus vibrato
+        freq = target + (freq - target) * sh.glidePole;
+        float_4 vib = vibrato.process(vibratoRate * sh.sampleTime) * 0.003f;
+        float_4 f = simd::clamp(freq * (1.f + vib), 20.f, 2000.f);
+
+        // Glottal source: polyblep saw and square, naive triangle
+        float_4 dt = f * sh.sampleTime;
+        phase += dt;
+        phase -= DSP::FastMathDetail::floorf(phase);
+        float_4 half = phase + 0.5f;
+        half -= DSP::FastMathDetail::floorf(half);
+        float_4 saw = 2.f * phase - 1.f - DSP::polyblep(phase, dt);
+        float_4 square = simd::ifelse((phase < 0.5f), float_4(1.f), float_4(-1.f))
+                         + DSP::polyblep(phase, dt) - DSP::polyblep(half, dt);
+        float_4 tri = 4.f * simd::abs(phase - 0.5f) - 1.f;
+        float tens = sh.tension;
+        float_4 source = saw * tens + tri * (0.4f * (1.f - tens)) + square * (0.3f * 0.5f * tens);
+
+        float_4 mix = source * (1.f - sh.breath * 0.7f) + noise() * (0.4f * sh.breath);
+
+        // Formant bank
+        float_4 f1 = filter(1, filter(0, mix));
+        float_4 f2 = filter(3, filter(2, mix));
+        float_4 bank = f1 * 0.5f + f2 * 0.3f + filter(4, mix) * 0.1f
+                       + filter(5, mix) * 0.06f + filter(6, mix) * 0.04f;
+        return bank * articulation;
+    }
+};
+
 /**
  * PhysicalChoir - Hybrid Physical Vocal Synthesis
  *
@@ -24,9 +261,15 @@ namespace WiggleRoom {
  * (vocal cords) with formant filtering (vocal tract) for organic,
  * expressive vocal sounds.
  *
+ * With mono V/Oct and Gate cables it plays the original four-voice
+ * ensemble. A polyphonic cable on either input switches to poly mode: one
+ * singer per channel (up to MAX_SINGERS), four singers per SIMD pass,
+ * sharing the vowel's formant tuning and one reverb. Singers are panned
+ * across the stereo field.
+ *
  * Inputs:
- *   - V/Oct: Pitch control (0V = C4)
- *   - Gate: Triggers the voice
+ *   - V/Oct: Pitch control (0V = C4), polyphonic
+ *   - Gate: Triggers the voice, polyphonic
  *
  * Parameters:
  *   - Vowel: Morphs A-E-I-O-U vowel shapes
@@ -36,7 +279,7 @@ namespace WiggleRoom {
  *   - Portamento: Pitch glide time
  *   - Reverb: Choir ambience
  */
-struct PhysicalChoir : FaustModule<VCVRackDSP> {
+struct PhysicalChoir : FaustModule<ReverbDSP> {
     enum ParamId {
         VOWEL_PARAM,
         TENSION_PARAM,
@@ -64,6 +307,35 @@ struct PhysicalChoir : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int MAX_SINGERS = 8;
+    static constexpr int MAX_GROUPS = MAX_SINGERS / 4;
+    static constexpr int SMOOTH_INTERVAL = 16;
+
+    // Singer group sleep: -100 dBFS for 100 ms after release
+    static constexpr float SILENCE_THRESHOLD = 1e-5f;
+    static constexpr float SLEEP_HOLD_SECONDS = 0.1f;
+
+    // Mono voice
+    VoiceDSP monoVoice;
+    float monoOut[2] = {};
+    float* monoOutPtrs[2] = {&monoOut[0], &monoOut[1]};
+
+    // Poly singers
+    SingerGroup groups[MAX_GROUPS];
+    FormantTuning tuning;
+    float_4 panL[MAX_GROUPS], panR[MAX_GROUPS];
+    int smoothCounter = 0;
+    int jitterCounter = 0;
+    bool smoothPrimed = false;
+    float smoothVowel = 0.f, smoothThroat = 1.f;
+    float smoothTension = 0.6f, smoothBreath = 0.05f;
+    int sleepHoldSamples = 4800;
+
+    // Output stage of the poly bus: fi.dcblocker, fi.highpass(1, 60)
+    float dcIn[2] = {}, dcOut[2] = {};
+    float hpIn[2] = {}, hpOut[2] = {};
+    float hpGain = 1.f, hpPole = 0.f;
+
     PhysicalChoir() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -87,76 +359,208 @@ struct PhysicalChoir : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): breath=0, gate=1, portamento=2, reverb=3, tension=4, throat=5, volts=6, vowel=7
-        mapParam(BREATH_PARAM, 0);
-        mapParam(PORTAMENTO_PARAM, 2);
-        mapParam(REVERB_PARAM, 3);
-        mapParam(TENSION_PARAM, 4);
-        mapParam(THROAT_PARAM, 5);
-        mapParam(VOWEL_PARAM, 7);
+        // Reverb bus; the voice parameters are sent by process()
+        mapParam(REVERB_PARAM, FP_REVERB::REVERB);
+
+        // Equal-power pan positions, alternating left and right
+        static const float PAN[MAX_SINGERS] = {-0.5f, 0.5f, -0.2f, 0.2f, -0.8f, 0.8f, -0.35f, 0.35f};
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            groups[g].seed(g);
+            for (int lane = 0; lane < 4; lane++) {
+                float angle = (PAN[g * 4 + lane] + 1.f) * 0.25f * DSP::PI;
+                panL[g][lane] = std::cos(angle);
+                panR[g][lane] = std::sin(angle);
+            }
+        }
     }
 
-    void process(const ProcessArgs& args) override {
-        // Initialize DSP on first run
-        if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
+    void initVoices(float sampleRate) {
+        int rate = static_cast<int>(sampleRate);
+        if (monoVoice.getSampleRate() == 0) {
+            monoVoice.init(rate);
+        } else {
+            monoVoice.setSampleRate(rate);
+        }
+        sleepHoldSamples = static_cast<int>(sampleRate * SLEEP_HOLD_SECONDS);
+        // fi.highpass(1, 60): bilinear one-pole
+        float k = std::tan(DSP::PI * 60.f / sampleRate);
+        hpGain = 1.f / (1.f + k);
+        hpPole = (1.f - k) / (1.f + k);
+        smoothCounter = 0;
+    }
+
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        FaustModule<ReverbDSP>::onSampleRateChange(e);
+        initVoices(e.sampleRate);
+    }
+
+    void onReset() override {
+        FaustModule<ReverbDSP>::onReset();
+        for (auto& group : groups) group.reset();
+        smoothPrimed = false;
+    }
+
+    // Knob plus CV, clamped
+    float knobWithCV(int paramId, int inputId, float scale, float minVal, float maxVal) {
+        float value = params[paramId].getValue();
+        if (inputs[inputId].isConnected()) {
+            value += inputs[inputId].getVoltage() * scale;
         }
+        return clamp(value, minVal, maxVal);
+    }
 
-        // Get V/Oct and Gate inputs
-        float voct = inputs[VOCT_INPUT].getVoltage();
-        float gate = inputs[GATE_INPUT].getVoltage();
+    // Channel c of a poly cable; a mono cable drives every singer
+    static float channelVoltage(Input& input, int c) {
+        int channels = input.getChannels();
+        if (channels == 1) return input.getVoltage(0);
+        return c < channels ? input.getVoltage(c) : 0.f;
+    }
 
-        // Get vowel with CV modulation
-        float vowel = params[VOWEL_PARAM].getValue();
-        if (inputs[VOWEL_CV_INPUT].isConnected()) {
-            vowel += inputs[VOWEL_CV_INPUT].getVoltage() * 0.4f;  // ±10V = ±4 vowels
+    // Control rate: smoothed shared controls and formant tuning
+    void updateSingers(float sampleTime, float vowel, float tension, float breath, float throat) {
+        if (!smoothPrimed) {
+            smoothVowel = vowel;
+            smoothThroat = throat;
+            smoothTension = tension;
+            smoothBreath = breath;
+            smoothPrimed = true;
+        } else {
+            // si.smoo (0.999 per sample) and si.smooth(ba.tau2pole(0.15)) on the vowel
+            float smoo = 1.f - std::pow(0.999f, static_cast<float>(SMOOTH_INTERVAL));
+            float vowelCoeff = 1.f - std::exp(-SMOOTH_INTERVAL * sampleTime / 0.15f);
+            smoothVowel += (vowel - smoothVowel) * vowelCoeff;
+            smoothThroat += (throat - smoothThroat) * smoo;
+            smoothTension += (tension - smoothTension) * smoo;
+            smoothBreath += (breath - smoothBreath) * smoo;
+        }
+        tuning.update(smoothVowel, smoothThroat, sampleTime);
+        for (auto& group : groups) {
+            if (group.awake) group.update(tuning, SMOOTH_INTERVAL, sampleTime);
         }
-        vowel = clamp(vowel, 0.f, 4.f);
+    }
 
-        // Get tension with CV modulation
-        float tension = params[TENSION_PARAM].getValue();
-        if (inputs[TENSION_CV_INPUT].isConnected()) {
-            tension += inputs[TENSION_CV_INPUT].getVoltage() * 0.089f;  // ±10V = ±0.89
+    void processSingers(const ProcessArgs& args, int singers, float portamento, float* out) {
+        ScopedFlushDenormals noDenormals;
+        float sampleTime = args.sampleTime;
+        SingerGroup::Shared shared;
+        shared.sampleTime = sampleTime;
+        shared.glidePole = portamento > 0.f ? std::exp(-sampleTime / portamento) : 0.f;
+        shared.tension = smoothTension;
+        shared.breath = smoothBreath;
+        shared.ampAttack = sampleTime / 0.08f;
+        shared.ampRelease = sampleTime / 0.5f;
+        shared.dipAttack = sampleTime / 0.001f;
+        shared.dipRelease = sampleTime / 0.06f;
+
+        bool newRates = false;
+        if (--jitterCounter <= 0) {
+            jitterCounter = static_cast<int>(args.sampleRate / 3.f);
+            newRates = true;
         }
-        tension = clamp(tension, 0.1f, 0.99f);
 
-        // Get breath with CV modulation
-        float breath = params[BREATH_PARAM].getValue();
-        if (inputs[BREATH_CV_INPUT].isConnected()) {
-            breath += inputs[BREATH_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+        float_4 sumL = 0.f, sumR = 0.f;
+        for (int g = 0; g < MAX_GROUPS; g++) {
+            SingerGroup& group = groups[g];
+
+            // Gates and pitch for this group's channels (> 0.9V as in the .dsp)
+            float_4 gate = 0.f;
+            for (int lane = 0; lane < 4; lane++) {
+                int c = g * 4 + lane;
+                if (c >= singers) continue;
+                if (channelVoltage(inputs[GATE_INPUT], c) > 0.9f) gate[lane] = 10.f;
+                group.target[lane] = 261.626f * std::exp2(channelVoltage(inputs[VOCT_INPUT], c));
+            }
+            float_4 gateMask = (gate > 0.f);
+            float_4 onsets = simd::ifelse(group.gateMask, float_4(0.f), gateMask);
+            group.gateMask = gateMask;
+            group.target *= group.detune;
+
+            if (!group.awake) {
+                if (simd::movemask(gateMask) == 0) continue;
+                group.awake = true;
+                group.quietSamples = 0;
+                group.freq = group.target;
+                group.update(tuning, 1, sampleTime);
+            }
+            group.dipRising = group.dipRising | onsets;
+            if (newRates) group.jitter();
+
+            float_4 y = group.process(shared);
+            sumL += y * panL[g];
+            sumR += y * panR[g];
+
+            // Sleep once released and silent
+            float peak = 0.f;
+            for (int lane = 0; lane < 4; lane++) peak = std::max(peak, std::fabs(y[lane]));
+            if (simd::movemask(gateMask) == 0 && peak < SILENCE_THRESHOLD) {
+                if (++group.quietSamples >= sleepHoldSamples) group.reset();
+            } else {
+                group.quietSamples = 0;
+            }
         }
-        breath = clamp(breath, 0.f, 1.f);
 
-        // Get throat with CV modulation
-        float throat = params[THROAT_PARAM].getValue();
-        if (inputs[THROAT_CV_INPUT].isConnected()) {
-            throat += inputs[THROAT_CV_INPUT].getVoltage() * 0.15f;  // ±10V = ±1.5
+        // dc_block : rumble_hp : *(output_gain), on the summed bus
+        float bus[2] = {sumL[0] + sumL[1] + sumL[2] + sumL[3], sumR[0] + sumR[1] + sumR[2] + sumR[3]};
+        for (int ch = 0; ch < 2; ch++) {
+            float dc = bus[ch] - dcIn[ch] + 0.995f * dcOut[ch];
+            dcIn[ch] = bus[ch];
+            dcOut[ch] = dc;
+            float hp = hpGain * (dc - hpIn[ch]) + hpPole * hpOut[ch];
+            hpIn[ch] = dc;
+            hpOut[ch] = hp;
+            out[ch] = hp * 0.045f;
         }
-        throat = clamp(throat, 0.5f, 2.f);
+    }
+
+    void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
 
-        // Get portamento (no CV)
+        // Initialize DSP on first run
+        if (!initialized) {
+            initDsp(args.sampleRate);
+            initVoices(args.sampleRate);
+            initialized = true;
+        }
+
+        // Reverb bus via mapParam
+        updateFaustParams();
+
+        float vowel = knobWithCV(VOWEL_PARAM, VOWEL_CV_INPUT, 0.4f, 0.f, 4.f);           // ±10V = ±4 vowels
+        float tension = knobWithCV(TENSION_PARAM, TENSION_CV_INPUT, 0.089f, 0.1f, 0.99f);  // ±10V = ±0.89
+        float breath = knobWithCV(BREATH_PARAM, BREATH_CV_INPUT, 0.1f, 0.f, 1.f);          // ±10V = ±1.0
+        float throat = knobWithCV(THROAT_PARAM, THROAT_CV_INPUT, 0.15f, 0.5f, 2.f);        // ±10V = ±1.5
         float portamento = params[PORTAMENTO_PARAM].getValue();
 
-        // Get reverb (no CV)
-        float reverb = params[REVERB_PARAM].getValue();
-
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, breath);      // breath
-        faustDsp.setParamValue(1, gate);        // gate
-        faustDsp.setParamValue(2, portamento);  // portamento
-        faustDsp.setParamValue(3, reverb);      // reverb
-        faustDsp.setParamValue(4, tension);     // tension
-        faustDsp.setParamValue(5, throat);      // throat
-        faustDsp.setParamValue(6, voct);        // volts
-        faustDsp.setParamValue(7, vowel);       // vowel
-
-        // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        int channels = std::max(inputs[VOCT_INPUT].getChannels(), inputs[GATE_INPUT].getChannels());
+        bool poly = channels > 1;
+
+        float voiceOut[2] = {};
+        if (poly) {
+            if (--smoothCounter <= 0) {
+                smoothCounter = SMOOTH_INTERVAL;
+                updateSingers(args.sampleTime, vowel, tension, breath, throat);
+            }
+            processSingers(args, std::min(channels, MAX_SINGERS), portamento, voiceOut);
+        } else {
+            monoVoice.setParamValue(FP_VOICE::BREATH, breath);
+            monoVoice.setParamValue(FP_VOICE::GATE, inputs[GATE_INPUT].getVoltage());
+            monoVoice.setParamValue(FP_VOICE::PORTAMENTO, portamento);
+            monoVoice.setParamValue(FP_VOICE::TENSION, tension);
+            monoVoice.setParamValue(FP_VOICE::THROAT, throat);
+            monoVoice.setParamValue(FP_VOICE::VOLTS, inputs[VOCT_INPUT].getVoltage());
+            monoVoice.setParamValue(FP_VOICE::VOWEL, vowel);
+            ScopedFlushDenormals noDenormals;
+            monoVoice.compute(1, nullptr, monoOutPtrs);
+            voiceOut[0] = monoOut[0];
+            voiceOut[1] = monoOut[1];
+            // Singers start from the current controls next time
+            smoothPrimed = false;
+        }
+
+        // Shared reverb (stereo in, stereo out)
+        float frameOut[2] = {};
+        computeFrame(voiceOut, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -201,4 +201,10 @@ dry_wet(dL, dR, wL, wR) =
     dL * dry_gain + wL * wet_gain,
     dR * dry_gain + wR * wet_gain;
 
-process = (processL, processR) <: (_, _, reverb_process) : dry_wet;
+// The module's poly mode runs the voice in C++ and only uses the reverb
+// bus; both entry points are compiled as separate DSPs (faust -pn, see
+// CMakeLists.txt)
+choir_voice = processL, processR;
+reverb_bus = _, _ <: (_, _, reverb_process) : dry_wet;
+
+process = choir_voice : reverb_bus;
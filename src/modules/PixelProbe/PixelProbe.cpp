@@ -10,10 +10,14 @@
 #include <osdialog.h>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -25,18 +29,249 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+// One level of the HSI pyramid: planar float hue / saturation / intensity,
+// all in 0..1. Row 0 is the top of the image, as in the RGBA buffer.
+struct HsiLevel {
+    int w = 0;
+    int h = 0;
+    std::vector<float> hue;
+    std::vector<float> sat;
+    std::vector<float> intensity;
+
+    void resize(int newW, int newH);
+};
+
+// Hue is circular (0 and 1 are both red), so blending takes each sample the
+// short way round from the first one and wraps the result back into 0..1.
+static float blendHue(const float* hues, const float* weights, int n) {
+    float ref = hues[0];
+    float sum = 0.f;
+    for (int k = 0; k < n; k++) {
+        float hk = hues[k];
+        if (hk - ref > 0.5f) hk -= 1.f;
+        else if (hk - ref < -0.5f) hk += 1.f;
+        sum += hk * weights[k];
+    }
+    return sum - std::floor(sum);
+}
+
 // Immutable image snapshot. The audio thread holds a `shared_ptr<const
 // ImageData>` for the duration of a process() call so it never observes
 // a half-written buffer. New loads create a fresh ImageData and atomically
 // swap the module's shared_ptr — the audio thread either sees the old
 // snapshot or the new one, never a torn state.
+//
+// Alongside the RGBA8 pixels (for the widget's texture) a load precomputes
+// an HSI mip pyramid: level 0 is the image converted once, each further
+// level a 2x2 box filter of the one before, down to 1x1. The audio thread
+// only interpolates these planes; no color math runs per sample.
 struct ImageData {
     std::vector<unsigned char> pixels;  // RGBA8
     int w = 0;
     int h = 0;
     std::string path;
+    std::vector<HsiLevel> levels;       // [0] = full resolution
+
+    void buildLevels();
 };
 
+static void rgbToHsi(float r, float g, float b, float& h, float& s, float& i) {
+    float sum = r + g + b;
+    i = sum / 3.f;
+    float minc = std::min(r, std::min(g, b));
+    s = (sum > 1e-6f) ? (1.f - (3.f * minc / sum)) : 0.f;
+
+    float num = 0.5f * ((r - g) + (r - b));
+    float den = std::sqrt((r - g) * (r - g) + (r - b) * (g - b));
+    float theta = (den > 1e-6f) ? std::acos(clamp(num / den, -1.f, 1.f)) : 0.f;
+    if (b > g) theta = 2.f * (float)M_PI - theta;
+    h = theta / (2.f * (float)M_PI);
+}
+
+void HsiLevel::resize(int newW, int newH) {
+    w = newW;
+    h = newH;
+    size_t n = (size_t)w * h;
+    hue.resize(n);
+    sat.resize(n);
+    intensity.resize(n);
+}
+
+void ImageData::buildLevels() {
+    if (pixels.empty() || w <= 0 || h <= 0) {
+        levels.clear();
+        return;
+    }
+
+    // Resize in place so a recycled sequence frame of the same size keeps
+    // all of its buffers
+    int count = 1;
+    for (int lw = w, lh = h; lw > 1 || lh > 1; lw = (lw + 1) / 2, lh = (lh + 1) / 2) count++;
+    levels.resize(count);
+
+    HsiLevel& base = levels[0];
+    base.resize(w, h);
+    size_t n = (size_t)w * h;
+    for (size_t k = 0; k < n; k++) {
+        rgbToHsi(pixels[k * 4] / 255.f, pixels[k * 4 + 1] / 255.f, pixels[k * 4 + 2] / 255.f,
+                 base.hue[k], base.sat[k], base.intensity[k]);
+    }
+
+    for (int l = 1; l < count; l++) {
+        const HsiLevel& src = levels[l - 1];
+        HsiLevel& dst = levels[l];
+        dst.resize((src.w + 1) / 2, (src.h + 1) / 2);
+        for (int y = 0; y < dst.h; y++) {
+            // Odd sizes: the last row/column folds in a single source texel
+            int y0 = 2 * y, y1 = std::min(2 * y + 1, src.h - 1);
+            for (int x = 0; x < dst.w; x++) {
+                int x0 = 2 * x, x1 = std::min(2 * x + 1, src.w - 1);
+                size_t idx[4] = {
+                    (size_t)y0 * src.w + x0, (size_t)y0 * src.w + x1,
+                    (size_t)y1 * src.w + x0, (size_t)y1 * src.w + x1
+                };
+                float hues[4], sats[4], weights[4] = {0.25f, 0.25f, 0.25f, 0.25f};
+                float ints = 0.f;
+                for (int k = 0; k < 4; k++) {
+                    hues[k] = src.hue[idx[k]];
+                    sats[k] = src.sat[idx[k]];
+                    ints += src.intensity[idx[k]];
+                }
+                size_t d = (size_t)y * dst.w + x;
+                dst.hue[d] = blendHue(hues, weights, 4);
+                dst.sat[d] = 0.25f * (sats[0] + sats[1] + sats[2] + sats[3]);
+                dst.intensity[d] = 0.25f * ints;
+            }
+        }
+    }
+}
+
+// Decode a file into dst, reusing its buffers. Runs on the loader thread.
+static bool decodeImage(ImageData& dst, const std::string& path) {
+    int w = 0, h = 0, c = 0;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &c, 4);
+    if (!data || w <= 0 || h <= 0) {
+        if (data) stbi_image_free(data);
+        dst.pixels.clear();
+        dst.w = 0;
+        dst.h = 0;
+        dst.path = path;
+        dst.levels.clear();
+        return false;
+    }
+    dst.pixels.assign(data, data + ((size_t)w * h * 4));
+    dst.w = w;
+    dst.h = h;
+    dst.path = path;
+    stbi_image_free(data);
+    dst.buildLevels();
+    return true;
+}
+
+// Bounded prefetch ring for image sequences. The loader thread owns the
+// frames and decodes into them; the audio thread looks frames up by key.
+//
+// A slot is published by storing its image and then its key, and
+// unpublished in the reverse order, so a reader that matched a key and
+// then still sees that key after loading the image has the right frame.
+// The loader only rewrites a frame nobody else holds (use_count() == 1
+// once unpublished), which keeps frames immutable while they are read and
+// lets their buffers be reused for the next frame instead of reallocated.
+struct FrameRing {
+    static constexpr int SIZE = 8;
+    static constexpr uint64_t EMPTY = ~uint64_t(0);
+
+    // Loader thread only
+    std::shared_ptr<ImageData> frames[SIZE];
+
+    std::shared_ptr<const ImageData> published[SIZE];
+    std::atomic<uint64_t> keys[SIZE];
+
+    FrameRing() {
+        for (auto& k : keys) k.store(EMPTY, std::memory_order_relaxed);
+    }
+
+    static uint64_t key(uint32_t sequence, int frame) {
+        return ((uint64_t)sequence << 32) | (uint32_t)frame;
+    }
+
+    // Audio thread: the published frame for key, or null
+    std::shared_ptr<const ImageData> find(uint64_t k) const {
+        for (int s = 0; s < SIZE; s++) {
+            if (keys[s].load(std::memory_order_acquire) != k) continue;
+            std::shared_ptr<const ImageData> img = std::atomic_load(&published[s]);
+            if (img && keys[s].load(std::memory_order_acquire) == k) return img;
+        }
+        return nullptr;
+    }
+
+    // ---- Loader thread ----
+
+    bool holds(uint64_t k) const {
+        for (int s = 0; s < SIZE; s++) {
+            if (keys[s].load(std::memory_order_relaxed) == k) return true;
+        }
+        return false;
+    }
+
+    void publish(int s, uint64_t k) {
+        std::atomic_store(&published[s], std::shared_ptr<const ImageData>(frames[s]));
+        keys[s].store(k, std::memory_order_release);
+    }
+
+    // Unpublish slot s for rewriting; false (and left published) if a
+    // reader still holds its frame
+    bool claim(int s) {
+        if (!frames[s]) {
+            frames[s] = std::make_shared<ImageData>();
+            return true;
+        }
+        uint64_t k = keys[s].load(std::memory_order_relaxed);
+        keys[s].store(EMPTY, std::memory_order_release);
+        std::atomic_store(&published[s], std::shared_ptr<const ImageData>());
+        if (frames[s].use_count() == 1) return true;
+        if (k != EMPTY) publish(s, k);
+        return false;
+    }
+
+    void unpublishAll() {
+        for (int s = 0; s < SIZE; s++) {
+            keys[s].store(EMPTY, std::memory_order_release);
+            std::atomic_store(&published[s], std::shared_ptr<const ImageData>());
+        }
+    }
+};
+
+// Bilinear HSI fetch at normalized (u, v); v = 0 is the bottom of the image
+static void sampleLevel(const HsiLevel& level, float u, float v, float& h, float& s, float& i) {
+    float fx = u * (level.w - 1);
+    float fy = (1.f - v) * (level.h - 1);
+    int x0 = clamp((int)fx, 0, level.w - 1);
+    int y0 = clamp((int)fy, 0, level.h - 1);
+    int x1 = std::min(x0 + 1, level.w - 1);
+    int y1 = std::min(y0 + 1, level.h - 1);
+    float tx = fx - x0;
+    float ty = fy - y0;
+
+    size_t idx[4] = {
+        (size_t)y0 * level.w + x0, (size_t)y0 * level.w + x1,
+        (size_t)y1 * level.w + x0, (size_t)y1 * level.w + x1
+    };
+    float weights[4] = {
+        (1.f - tx) * (1.f - ty), tx * (1.f - ty),
+        (1.f - tx) * ty,         tx * ty
+    };
+    float hues[4];
+    s = 0.f;
+    i = 0.f;
+    for (int k = 0; k < 4; k++) {
+        hues[k] = level.hue[idx[k]];
+        s += level.sat[idx[k]] * weights[k];
+        i += level.intensity[idx[k]] * weights[k];
+    }
+    h = blendHue(hues, weights, 4);
+}
+
 struct PixelProbe : Module {
     enum ParamId {
         PAN_X_PARAM,
@@ -48,6 +283,8 @@ struct PixelProbe : Module {
     enum InputId {
         X_INPUT,
         Y_INPUT,
+        FRAME_INPUT,
+        CLOCK_INPUT,
         NUM_INPUTS
     };
     enum OutputId {
@@ -60,7 +297,8 @@ struct PixelProbe : Module {
 
     // The current image. Accessed atomically (free-function shared_ptr
     // atomics, C++17). All loads (audio thread / UI thread / widget) take
-    // a snapshot via atomic_load; loadMedia / clearMedia publish a new
+    // a snapshot via atomic_load; the loader thread (and, for sequences,
+    // the audio thread when it steps to a decoded frame) publish a new
     // snapshot via atomic_store.
     std::shared_ptr<const ImageData> currentImage = std::make_shared<ImageData>();
 
@@ -72,6 +310,58 @@ struct PixelProbe : Module {
     std::atomic<float> sampledU{0.5f};
     std::atomic<float> sampledV{0.5f};
 
+    // How many level-0 texels the probe covers per sample: the distance it
+    // moved (so zoom and CV slew both count), held with a short decay so a
+    // fast scan does not strobe between mip levels at its turning points.
+    float footprint = 0.f;
+    float lastU = 0.5f;
+    float lastV = 0.5f;
+
+    // ---- Background loading -------------------------------------------------
+    // Decoding runs on a loader thread so large images never stall the UI or
+    // patch load. loadMedia() / loadSequence() / clearMedia() only post a
+    // request; the newest request wins and the result of a superseded one is
+    // dropped. The thread starts with the first request.
+    enum RequestKind { REQUEST_NONE, REQUEST_IMAGE, REQUEST_SEQUENCE, REQUEST_CLEAR };
+    struct Request {
+        RequestKind kind = REQUEST_NONE;
+        std::string path;
+        uint32_t serial = 0;
+    };
+
+    std::thread loaderThread;
+    std::mutex loaderMutex;
+    std::condition_variable loaderWake;
+
+    // Guarded by loaderMutex
+    Request pendingRequest;
+    uint32_t latestSerial = 0;
+    bool loaderStop = false;
+    std::string mediaPath;           // what the menu shows and the patch saves
+    bool mediaIsSequence = false;
+
+    // ---- Image sequences ----------------------------------------------------
+    // A folder of frames, decoded ahead of the playhead into frameRing.
+    // The frame is picked by FRAME CV (0..10 V across the sequence) plus a
+    // step per CLOCK edge. If the wanted frame is not decoded yet the last
+    // one keeps playing, so fast scans degrade to skipped frames rather than
+    // dropouts.
+    FrameRing frameRing;
+    std::atomic<uint64_t> sequenceInfo{0};   // (id << 32) | frame count; 0 = none
+    std::atomic<int> wantedFrame{0};         // audio -> loader
+
+    // Loader thread only
+    std::vector<std::string> framePaths;
+    uint32_t sequenceId = 0;
+    int lastWanted = -1;
+    int prefetchDir = 1;
+
+    // Audio thread only
+    dsp::SchmittTrigger clockTrigger;
+    uint32_t playingSequence = 0;
+    int clockFrame = 0;
+    uint64_t shownKey = FrameRing::EMPTY;
+
     PixelProbe() {
         config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
         configParam(PAN_X_PARAM, -1.f, 1.f, 0.f, "Pan X");
@@ -81,6 +371,8 @@ struct PixelProbe : Module {
                      {"Polar (0..10 V)", "Bipolar (-5..+5 V)"});
         configInput(X_INPUT, "X probe (-5..+5 V)");
         configInput(Y_INPUT, "Y probe (-5..+5 V)");
+        configInput(FRAME_INPUT, "Sequence frame (0..10 V)");
+        configInput(CLOCK_INPUT, "Sequence clock");
         configOutput(HUE_OUTPUT, "Hue");
         configOutput(SAT_OUTPUT, "Saturation");
         configOutput(INT_OUTPUT, "Intensity");
@@ -94,48 +386,223 @@ struct PixelProbe : Module {
         std::atomic_store(&currentImage, std::move(img));
     }
 
-    bool loadMedia(const std::string& path) {
-        int w = 0, h = 0, c = 0;
-        unsigned char* data = stbi_load(path.c_str(), &w, &h, &c, 4);
-        if (!data || w <= 0 || h <= 0) {
-            if (data) stbi_image_free(data);
-            return false;
+    ~PixelProbe() override {
+        {
+            std::lock_guard<std::mutex> lock(loaderMutex);
+            loaderStop = true;
         }
-        auto img = std::make_shared<ImageData>();
-        img->pixels.assign(data, data + (w * h * 4));
-        img->w = w;
-        img->h = h;
-        img->path = path;
-        stbi_image_free(data);
-        publishImage(std::move(img));
-        return true;
+        loaderWake.notify_one();
+        if (loaderThread.joinable()) loaderThread.join();
+    }
+
+    // Decode an image file in the background; it replaces the current media
+    // when ready (or clears it if the file cannot be read)
+    void loadMedia(const std::string& path) {
+        postRequest(REQUEST_IMAGE, path);
+    }
+
+    // Play the image files in a folder, in filename order, as a sequence
+    void loadSequence(const std::string& dir) {
+        postRequest(REQUEST_SEQUENCE, dir);
     }
 
     // Reset to the empty-image state (no pixels, no path). Used when a load
     // fails or when restoring a patch that had no image, so state restore is
     // deterministic and the module stops emitting stale colors.
     void clearMedia() {
+        postRequest(REQUEST_CLEAR, "");
+        sequenceInfo.store(0, std::memory_order_release);
         publishImage(std::make_shared<const ImageData>());
     }
 
-    std::string loadedPath() const {
-        return snapshotImage()->path;
+    std::string loadedPath() {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        return mediaPath;
+    }
+
+    bool loadedSequence() {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        return mediaIsSequence && !mediaPath.empty();
     }
 
-    static void rgbToHsi(float r, float g, float b, float& h, float& s, float& i) {
-        float sum = r + g + b;
-        i = sum / 3.f;
-        float minc = std::min(r, std::min(g, b));
-        s = (sum > 1e-6f) ? (1.f - (3.f * minc / sum)) : 0.f;
+    static bool isImageFile(const std::string& path) {
+        std::string ext = string::lowercase(system::getExtension(path));
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp"
+            || ext == ".tga" || ext == ".gif";
+    }
 
-        float num = 0.5f * ((r - g) + (r - b));
-        float den = std::sqrt((r - g) * (r - g) + (r - b) * (g - b));
-        float theta = (den > 1e-6f) ? std::acos(clamp(num / den, -1.f, 1.f)) : 0.f;
-        if (b > g) theta = 2.f * (float)M_PI - theta;
-        h = theta / (2.f * (float)M_PI);
+    // ---- Loader thread ------------------------------------------------------
+
+    void postRequest(RequestKind kind, const std::string& path) {
+        {
+            std::lock_guard<std::mutex> lock(loaderMutex);
+            pendingRequest.kind = kind;
+            pendingRequest.path = path;
+            pendingRequest.serial = ++latestSerial;
+            mediaPath = path;
+            mediaIsSequence = (kind == REQUEST_SEQUENCE);
+            if (!loaderThread.joinable()) {
+                loaderThread = std::thread([this] { loaderMain(); });
+            }
+        }
+        loaderWake.notify_one();
+    }
+
+    void loaderMain() {
+        std::unique_lock<std::mutex> lock(loaderMutex);
+        while (!loaderStop) {
+            if (pendingRequest.kind != REQUEST_NONE) {
+                Request r = pendingRequest;
+                pendingRequest = Request();
+                lock.unlock();
+                handleRequest(r);
+                lock.lock();
+                continue;
+            }
+            if (!framePaths.empty()) {
+                lock.unlock();
+                bool worked = prefetchFrame();
+                lock.lock();
+                if (worked) continue;
+            }
+            // Sequences are polled: the audio thread only moves wantedFrame
+            loaderWake.wait_for(lock, std::chrono::milliseconds(2));
+        }
+    }
+
+    void handleRequest(const Request& r) {
+        stopSequence();
+        if (r.kind == REQUEST_IMAGE) {
+            auto img = std::make_shared<ImageData>();
+            bool ok = decodeImage(*img, r.path);
+            finishRequest(r.serial, ok ? std::move(img) : nullptr, 0);
+        } else if (r.kind == REQUEST_SEQUENCE) {
+            startSequence(r);
+        }
+    }
+
+    // Publish a request's result unless a newer request has replaced it.
+    // A null image means the load failed: fall back to the empty image.
+    void finishRequest(uint32_t serial, std::shared_ptr<const ImageData> img, int frameCount) {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        if (serial != latestSerial) return;
+        if (!img) {
+            mediaPath.clear();
+            img = std::make_shared<const ImageData>();
+        }
+        publishImage(std::move(img));
+        sequenceInfo.store(frameCount > 0 ? FrameRing::key(sequenceId, frameCount) : 0,
+                           std::memory_order_release);
+    }
+
+    void startSequence(const Request& r) {
+        framePaths.clear();
+        for (const std::string& entry : system::getEntries(r.path)) {
+            if (isImageFile(entry)) framePaths.push_back(entry);
+        }
+        std::sort(framePaths.begin(), framePaths.end());
+        if (framePaths.empty()) {
+            finishRequest(r.serial, nullptr, 0);
+            return;
+        }
+
+        // Decode the first frame now so the sequence appears immediately
+        sequenceId++;
+        lastWanted = -1;
+        prefetchDir = 1;
+        wantedFrame.store(0, std::memory_order_relaxed);
+        uint64_t first = FrameRing::key(sequenceId, 0);
+        decodeIntoRing(first, &first, 1);
+        finishRequest(r.serial, frameRing.find(first), (int)framePaths.size());
+    }
+
+    void stopSequence() {
+        sequenceInfo.store(0, std::memory_order_release);
+        framePaths.clear();
+        frameRing.unpublishAll();
+    }
+
+    // Decode the first missing frame of the window ahead of the playhead.
+    // Returns false when there was nothing to do (or no free slot).
+    bool prefetchFrame() {
+        int count = (int)framePaths.size();
+        int wanted = wantedFrame.load(std::memory_order_relaxed);
+        if (wanted < 0 || wanted >= count) wanted = 0;
+        if (wanted != lastWanted) {
+            if (lastWanted >= 0) {
+                // Direction of travel, the short way round the loop
+                int diff = wanted - lastWanted;
+                if (diff > count / 2) diff -= count;
+                else if (diff < -count / 2) diff += count;
+                prefetchDir = (diff < 0) ? -1 : 1;
+            }
+            lastWanted = wanted;
+        }
+
+        // Two slots stay spare for frames the widget and audio thread hold
+        int ahead = std::min(FrameRing::SIZE - 2, count);
+        uint64_t window[FrameRing::SIZE];
+        for (int i = 0; i < ahead; i++) {
+            int f = ((wanted + i * prefetchDir) % count + count) % count;
+            window[i] = FrameRing::key(sequenceId, f);
+        }
+        for (int i = 0; i < ahead; i++) {
+            if (frameRing.holds(window[i])) continue;
+            return decodeIntoRing(window[i], window, ahead);
+        }
+        return false;
+    }
+
+    // Decode frame k into a slot outside `keep` that nobody is reading
+    bool decodeIntoRing(uint64_t k, const uint64_t* keep, int keepCount) {
+        for (int s = 0; s < FrameRing::SIZE; s++) {
+            uint64_t current = frameRing.keys[s].load(std::memory_order_relaxed);
+            if (std::find(keep, keep + keepCount, current) != keep + keepCount) continue;
+            if (!frameRing.claim(s)) continue;
+            // A frame that fails to decode is published empty (outputs 0 V)
+            // rather than retried on every pass
+            decodeImage(*frameRing.frames[s], framePaths[(uint32_t)k]);
+            frameRing.publish(s, k);
+            return true;
+        }
+        return false;
+    }
+
+    // ---- Audio thread -------------------------------------------------------
+
+    // Follow FRAME CV / CLOCK through the current sequence
+    void advanceSequence() {
+        uint64_t info = sequenceInfo.load(std::memory_order_acquire);
+        int count = (int)(uint32_t)info;
+        if (count <= 0) return;
+        uint32_t sequence = (uint32_t)(info >> 32);
+        if (sequence != playingSequence) {
+            playingSequence = sequence;
+            clockFrame = 0;
+        }
+
+        if (clockTrigger.process(inputs[CLOCK_INPUT].getVoltage(), 0.1f, 1.f)) {
+            clockFrame = (clockFrame + 1) % count;
+        }
+        int frame = clockFrame;
+        if (inputs[FRAME_INPUT].isConnected()) {
+            float pos = clamp(inputs[FRAME_INPUT].getVoltage() / 10.f, 0.f, 1.f);
+            frame += (int)(pos * (count - 1) + 0.5f);
+        }
+        frame %= count;
+        wantedFrame.store(frame, std::memory_order_relaxed);
+
+        uint64_t k = FrameRing::key(sequence, frame);
+        if (k == shownKey) return;
+        std::shared_ptr<const ImageData> img = frameRing.find(k);
+        if (!img) return;  // not decoded yet: hold the last frame
+        publishImage(std::move(img));
+        shownKey = k;
     }
 
     void process(const ProcessArgs& /*args*/) override {
+        advanceSequence();
+
         // Pin the current image for the duration of this block — the UI
         // thread can swap currentImage in mid-flight without invalidating
         // the buffers we're reading.
@@ -155,25 +622,36 @@ struct PixelProbe : Module {
         sampledU.store(u, std::memory_order_relaxed);
         sampledV.store(v, std::memory_order_relaxed);
 
-        if (!img || img->pixels.empty() || img->w <= 0 || img->h <= 0) {
+        if (!img || img->levels.empty()) {
             outputs[HUE_OUTPUT].setVoltage(0.f);
             outputs[SAT_OUTPUT].setVoltage(0.f);
             outputs[INT_OUTPUT].setVoltage(0.f);
             return;
         }
 
-        int px = clamp((int)std::round(u * (img->w - 1)), 0, img->w - 1);
-        // Image row 0 is at the top of the canvas; v = 0 sits at the bottom,
-        // so we flip vertically when indexing the pixel buffer.
-        int py = clamp((int)std::round((1.f - v) * (img->h - 1)), 0, img->h - 1);
-        int idx = (py * img->w + px) * 4;
+        // Pick the mip level whose texels match the footprint, and blend the
+        // two nearest levels (trilinear) so sweeping the zoom stays smooth.
+        float moved = std::max(std::fabs(u - lastU) * img->w, std::fabs(v - lastV) * img->h);
+        lastU = u;
+        lastV = v;
+        footprint = std::max(moved, footprint * 0.995f);
 
-        float r = img->pixels[idx]     / 255.f;
-        float g = img->pixels[idx + 1] / 255.f;
-        float b = img->pixels[idx + 2] / 255.f;
+        int top = (int)img->levels.size() - 1;
+        float lod = (footprint > 1.f) ? std::min(std::log2(footprint), (float)top) : 0.f;
+        int l0 = (int)lod;
+        float t = lod - l0;
 
         float h, s, intensity;
-        rgbToHsi(r, g, b, h, s, intensity);
+        sampleLevel(img->levels[l0], u, v, h, s, intensity);
+        if (t > 0.f && l0 < top) {
+            float h1, s1, i1;
+            sampleLevel(img->levels[l0 + 1], u, v, h1, s1, i1);
+            float hues[2] = {h, h1};
+            float weights[2] = {1.f - t, t};
+            h = blendHue(hues, weights, 2);
+            s += (s1 - s) * t;
+            intensity += (i1 - intensity) * t;
+        }
 
         bool bipolar = params[MODE_PARAM].getValue() > 0.5f;
         auto mapOut = [&](float val) {
@@ -186,16 +664,19 @@ struct PixelProbe : Module {
     }
 
     // ---- Persistence ------------------------------------------------------
-    // Persist the loaded image path so patches survive save/load. On load
-    // we attempt to re-read the file; if it has moved or been deleted, the
-    // module behaves as if no image is loaded and the user can re-pick via
-    // the context menu.
+    // Persist the loaded image (or sequence folder) path so patches survive
+    // save/load. On load we queue a re-read; if the file has moved or been
+    // deleted, the module behaves as if no image is loaded and the user can
+    // re-pick via the context menu.
 
     json_t* dataToJson() override {
         json_t* rootJ = json_object();
         std::string p = loadedPath();
         if (!p.empty()) {
             json_object_set_new(rootJ, "loadedPath", json_string(p.c_str()));
+            if (loadedSequence()) {
+                json_object_set_new(rootJ, "sequence", json_true());
+            }
         }
         return rootJ;
     }
@@ -206,11 +687,15 @@ struct PixelProbe : Module {
         if (pJ && json_is_string(pJ)) {
             p = json_string_value(pJ);
         }
-        // Deterministic restore: an empty path, a missing key, or a failed
-        // reload (file moved/deleted) all reset to the empty image so we
-        // never keep outputting colors from a previously-loaded picture.
-        if (p.empty() || !loadMedia(p)) {
-            clearMedia();
+        json_t* seqJ = json_object_get(rootJ, "sequence");
+        bool sequence = seqJ && json_is_true(seqJ);
+        // Deterministic restore: start from the empty image, so an empty
+        // path, a missing key, or a failed reload (file moved/deleted) never
+        // keeps outputting colors from a previously-loaded picture.
+        clearMedia();
+        if (!p.empty()) {
+            if (sequence) loadSequence(p);
+            else loadMedia(p);
         }
     }
 };
@@ -360,6 +845,18 @@ struct LoadMediaItem : MenuItem {
     }
 };
 
+struct LoadSequenceItem : MenuItem {
+    PixelProbe* module = nullptr;
+    void onAction(const event::Action& /*e*/) override {
+        if (!module) return;
+        char* path = osdialog_file(OSDIALOG_OPEN_DIR, nullptr, nullptr, nullptr);
+        if (path) {
+            module->loadSequence(path);
+            std::free(path);
+        }
+    }
+};
+
 struct PixelProbeWidget : ModuleWidget {
     PixelProbeWidget(PixelProbe* module) {
         setModule(module);
@@ -414,6 +911,13 @@ struct PixelProbeWidget : ModuleWidget {
             Vec(colC, yOutputs), module, PixelProbe::SAT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(colR, yOutputs), module, PixelProbe::INT_OUTPUT));
+
+        // Image-sequence playhead: frame CV and clock
+        const float ySequence = yOutputs + 32.f;
+        addInput(createInputCentered<PJ301MPort>(
+            Vec(colL, ySequence), module, PixelProbe::FRAME_INPUT));
+        addInput(createInputCentered<PJ301MPort>(
+            Vec(colR, ySequence), module, PixelProbe::CLOCK_INPUT));
     }
 
     void appendContextMenu(Menu* menu) override {
@@ -422,10 +926,14 @@ struct PixelProbeWidget : ModuleWidget {
         auto* item = createMenuItem<LoadMediaItem>("Load image…");
         item->module = m;
         menu->addChild(item);
+        auto* seqItem = createMenuItem<LoadSequenceItem>("Load image sequence (folder)…");
+        seqItem->module = m;
+        menu->addChild(seqItem);
         if (m) {
             std::string p = m->loadedPath();
             if (!p.empty()) {
-                menu->addChild(createMenuLabel(std::string("Loaded: ") + p));
+                std::string label = m->loadedSequence() ? "Sequence: " : "Loaded: ";
+                menu->addChild(createMenuLabel(label + p));
             }
         }
     }
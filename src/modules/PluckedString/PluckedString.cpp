@@ -2,14 +2,28 @@
  * PLUCKED STRING
  * Karplus-Strong physical model of a plucked string
  * Creates guitar, harp, and plucked instrument sounds
+ * Pool of up to 8 strings into a shared chorus and reverb
  * Built with Faust DSP
  ******************************************************************************/
 
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
-#define FAUST_MODULE_NAME PluckedString
-#include "plucked_string.hpp"  // Generated by Faust
+
+// The string voice and the effects bus are generated from plucked_string.dsp
+// as separate DSPs (faust -pn, see CMakeLists.txt), so two Faust headers
+// share this translation unit
+#define FAUST_NO_GLOBAL_ALIAS
+
+#define FAUST_MODULE_NAME PluckedStringVoice
+#include "plucked_string_voice.hpp"
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME PluckedStringFx
+#include "plucked_string_fx.hpp"
+
+// Faust parameter indices
+#include "plucked_string_voice_params.hpp"
+#include "plucked_string_fx_params.hpp"
 
 using namespace rack;
 
@@ -17,6 +31,48 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+using VoiceDSP = FaustGenerated::NS_PluckedStringVoice::VCVRackDSP;
+using FxDSP = FaustGenerated::NS_PluckedStringFx::VCVRackDSP;
+
+namespace FP_VOICE = FaustParams::plucked_string_voice;
+namespace FP_FX = FaustParams::plucked_string_fx;
+
+/**
+ * One string of the voice pool
+ *
+ * Sleeps once its output has stayed below SILENCE_THRESHOLD with its gate
+ * low for the hold time, and is only woken by a pluck. Sleeping only with
+ * the gate low keeps the edge detector in the .dsp armed.
+ */
+struct StringVoice {
+    VoiceDSP dsp;
+    float output = 0.0f;
+    float* outputPtr = &output;
+
+    float volts = 0.0f;
+    bool gateIn = false;        // Gate for this string (cable or strum)
+    bool pluckPending = false;  // Send a rising edge on the next sample
+    bool stealing = false;      // Fading out before the pending pluck
+    float fade = 1.0f;          // Output gain, falls to 0 while stealing
+    bool awake = false;
+    int quietSamples = 0;
+    uint32_t pluckOrder = 0;    // For oldest-first stealing
+
+    void init(int sampleRate) {
+        if (dsp.getSampleRate() == 0) {
+            dsp.init(sampleRate);
+        } else {
+            dsp.setSampleRate(sampleRate);
+        }
+    }
+
+    float computeSample() {
+        ScopedFlushDenormals noDenormals;
+        dsp.compute(1, nullptr, &outputPtr);
+        return output;
+    }
+};
+
 /**
  * PluckedString - Karplus-Strong Plucked String Synthesizer
  *
@@ -24,16 +80,23 @@ namespace WiggleRoom {
  * delay line feedback loop. Creates realistic guitar, harp, and
  * plucked instrument tones.
  *
+ * Up to 8 strings share one chorus and reverb. With a polyphonic Gate
+ * cable, channel c plays string c. With a mono Gate every rising edge
+ * plucks the next string (strumming): a sleeping string if there is one
+ * (oldest first) or the next in turn (round-robin). A string that is still
+ * ringing is faded out over STEAL_FADE_SECONDS before it is re-plucked.
+ * Only awake strings are computed; they live in one contiguous array.
+ *
  * Inputs:
- *   - V/Oct: Pitch control (0V = C4)
- *   - Gate: Trigger input (plucks when > 1V)
+ *   - V/Oct: Pitch control (0V = C4), polyphonic
+ *   - Gate: Trigger input (plucks when > 0.5V), polyphonic
  *
  * Parameters:
  *   - Damping: String damping (0 = bright/long, 1 = muted/short)
  *   - Position: Pluck position (0 = bridge, 1 = middle)
  *   - Brightness: Excitation brightness
  */
-struct PluckedString : FaustModule<VCVRackDSP> {
+struct PluckedString : FaustModule<FxDSP> {
     enum ParamId {
         DAMPING_PARAM,
         POSITION_PARAM,
@@ -61,6 +124,28 @@ struct PluckedString : FaustModule<VCVRackDSP> {
     enum LightId {
         LIGHTS_LEN
     };
+    enum Stealing {
+        STEAL_OLDEST,
+        STEAL_ROUND_ROBIN
+    };
+
+    static constexpr int MAX_VOICES = 8;
+
+    // String sleep: -80 dBFS for 100 ms
+    static constexpr float SILENCE_THRESHOLD = 1e-4f;
+    static constexpr float SLEEP_HOLD_SECONDS = 0.1f;
+    static constexpr float STEAL_FADE_SECONDS = 0.003f;
+
+    StringVoice voices[MAX_VOICES];
+    int numVoices = MAX_VOICES;
+    int stealing = STEAL_OLDEST;
+    int strumVoice = 0;           // String played by a mono Gate
+    bool strumGate = false;
+    bool polyGates[MAX_VOICES] = {};
+    uint32_t pluckCounter = 0;
+    int sleepHoldSamples = 0;
+    float fadeStep = 1.0f;
+    int voiceControlCounter = 0;
 
     PluckedString() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -86,85 +171,198 @@ struct PluckedString : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): brightness=0, chorus=1, damping=2, gate=3, position=4, reverb=5, strength=6, volts=7
-        mapParam(BRIGHTNESS_PARAM, 0);
-        mapParam(CHORUS_PARAM, 1);
-        mapParam(DAMPING_PARAM, 2);
-        mapParam(POSITION_PARAM, 4);
-        mapParam(REVERB_PARAM, 5);
-        mapParam(STRENGTH_PARAM, 6);
+        // Effects bus: chorus and reverb (±10V = ±1.0 on reverb)
+        mapParam(CHORUS_PARAM, FP_FX::CHORUS);
+        mapParam(REVERB_PARAM, FP_FX::REVERB);
+        mapCVInput(REVERB_CV_INPUT, FP_FX::REVERB, false, 0.1f);
     }
 
-    void process(const ProcessArgs& args) override {
-        // Initialize DSP on first run
-        if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
+    void setVoiceCount(int count) {
+        numVoices = clamp(count, 1, MAX_VOICES);
+    }
+
+    int getVoiceCount() const {
+        return numVoices;
+    }
+
+    void initVoices(int sampleRate) {
+        sleepHoldSamples = static_cast<int>(sampleRate * SLEEP_HOLD_SECONDS);
+        fadeStep = 1.0f / (sampleRate * STEAL_FADE_SECONDS);
+        for (auto& voice : voices) {
+            voice.init(sampleRate);
         }
+        voiceControlCounter = 0;
+    }
 
-        // Get V/Oct and Gate inputs
-        float voct = inputs[VOCT_INPUT].getVoltage();
-        float gate = inputs[GATE_INPUT].getVoltage();
+    void onSampleRateChange(const SampleRateChangeEvent& e) override {
+        FaustModule<FxDSP>::onSampleRateChange(e);
+        initVoices(static_cast<int>(e.sampleRate));
+    }
 
-        // Get damping with CV modulation
-        float damping = params[DAMPING_PARAM].getValue();
-        if (inputs[DAMPING_CV_INPUT].isConnected()) {
-            damping += inputs[DAMPING_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+    float knobWithCV(int paramId, int inputId, float minVal, float maxVal) {
+        float value = params[paramId].getValue();
+        if (inputs[inputId].isConnected()) {
+            value += inputs[inputId].getVoltage() * 0.1f;  // ±10V = ±1.0
         }
-        damping = clamp(damping, 0.f, 1.f);
+        return clamp(value, minVal, maxVal);
+    }
 
-        // Get position with CV modulation
-        float position = params[POSITION_PARAM].getValue();
-        if (inputs[POSITION_CV_INPUT].isConnected()) {
-            position += inputs[POSITION_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+    // String knobs and CV, shared by every string
+    void updateVoiceParams() {
+        float damping = knobWithCV(DAMPING_PARAM, DAMPING_CV_INPUT, 0.f, 1.f);
+        float position = knobWithCV(POSITION_PARAM, POSITION_CV_INPUT, 0.01f, 0.99f);
+        float brightness = knobWithCV(BRIGHTNESS_PARAM, BRIGHTNESS_CV_INPUT, 0.f, 1.f);
+        float strength = knobWithCV(STRENGTH_PARAM, STRENGTH_CV_INPUT, 0.f, 1.f);
+
+        for (int v = 0; v < numVoices; v++) {
+            VoiceDSP& dsp = voices[v].dsp;
+            dsp.setParamValue(FP_VOICE::BRIGHTNESS, brightness);
+            dsp.setParamValue(FP_VOICE::DAMPING, damping);
+            dsp.setParamValue(FP_VOICE::POSITION, position);
+            dsp.setParamValue(FP_VOICE::STRENGTH, strength);
         }
-        position = clamp(position, 0.01f, 0.99f);
+    }
+
+    // String for the next strummed note
+    int allocateVoice() {
+        if (numVoices == 1) return 0;
 
-        // Get brightness with CV modulation
-        float brightness = params[BRIGHTNESS_PARAM].getValue();
-        if (inputs[BRIGHTNESS_CV_INPUT].isConnected()) {
-            brightness += inputs[BRIGHTNESS_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+        if (stealing == STEAL_ROUND_ROBIN) {
+            return (strumVoice + 1) % numVoices;
         }
-        brightness = clamp(brightness, 0.f, 1.f);
 
-        // Get strength with CV modulation
-        float strength = params[STRENGTH_PARAM].getValue();
-        if (inputs[STRENGTH_CV_INPUT].isConnected()) {
-            strength += inputs[STRENGTH_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+        int oldest = 0;
+        for (int v = 0; v < numVoices; v++) {
+            if (!voices[v].awake) return v;
+            if (voices[v].pluckOrder < voices[oldest].pluckOrder) oldest = v;
         }
-        strength = clamp(strength, 0.f, 1.f);
+        return oldest;
+    }
 
-        // Get chorus (no CV for now)
-        float chorus = params[CHORUS_PARAM].getValue();
+    void pluck(int v, float volts) {
+        StringVoice& voice = voices[v];
+        voice.volts = volts;
+        voice.pluckOrder = ++pluckCounter;
+        // A ringing string is faded out first (a single string just
+        // rings on, like the original mono voice)
+        voice.stealing = voice.awake && numVoices > 1;
+        voice.pluckPending = true;
+        voice.awake = true;
+        voice.quietSamples = 0;
+    }
+
+    void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
 
-        // Get reverb with CV modulation
-        float reverb = params[REVERB_PARAM].getValue();
-        if (inputs[REVERB_CV_INPUT].isConnected()) {
-            reverb += inputs[REVERB_CV_INPUT].getVoltage() * 0.1f;  // ±10V = ±1.0
+        // Initialize DSP on first run
+        if (!initialized) {
+            initDsp(args.sampleRate);
+            initVoices(static_cast<int>(args.sampleRate));
+            initialized = true;
         }
-        reverb = clamp(reverb, 0.f, 1.f);
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, brightness);  // brightness
-        faustDsp.setParamValue(1, chorus);      // chorus
-        faustDsp.setParamValue(2, damping);     // damping
-        faustDsp.setParamValue(3, gate);        // gate
-        faustDsp.setParamValue(4, position);    // position
-        faustDsp.setParamValue(5, reverb);      // reverb
-        faustDsp.setParamValue(6, strength);    // strength
-        faustDsp.setParamValue(7, voct);        // volts
+        // Effects bus params via mapParam
+        updateFaustParams();
 
-        // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        if (--voiceControlCounter <= 0) {
+            voiceControlCounter = controlRateDivider;
+            updateVoiceParams();
+        }
+
+        // --- Gates -> strings ---
+        int gateChannels = inputs[GATE_INPUT].getChannels();
+        if (gateChannels > 1) {
+            // One string per channel
+            for (int v = 0; v < numVoices; v++) {
+                bool high = v < gateChannels && inputs[GATE_INPUT].getVoltage(v) > 0.5f;
+                float volts = inputs[VOCT_INPUT].getPolyVoltage(v);
+                if (high && !polyGates[v]) pluck(v, volts);
+                polyGates[v] = high;
+                voices[v].gateIn = high;
+                if (voices[v].awake && !voices[v].stealing) voices[v].volts = volts;
+            }
+        } else {
+            // Strum: each rising edge takes the next string, which then
+            // follows V/Oct until the next one
+            bool high = inputs[GATE_INPUT].getVoltage() > 0.5f;
+            float volts = inputs[VOCT_INPUT].getVoltage();
+            if (high && !strumGate) {
+                strumVoice = allocateVoice();
+                pluck(strumVoice, volts);
+            }
+            strumGate = high;
+            for (int v = 0; v < numVoices; v++) {
+                voices[v].gateIn = high && v == strumVoice;
+            }
+            StringVoice& current = voices[strumVoice];
+            if (current.awake && !current.stealing) current.volts = volts;
+        }
+
+        // --- Run the awake strings ---
+        float sum = 0.0f;
+        for (int v = 0; v < numVoices; v++) {
+            StringVoice& voice = voices[v];
+            if (!voice.awake) continue;
+
+            bool gate = voice.gateIn;
+            if (voice.stealing) {
+                voice.fade -= fadeStep;
+                gate = false;
+                if (voice.fade <= 0.0f) {
+                    // Silent now: drop the old note and pluck from scratch
+                    voice.dsp.instanceClear();
+                    voice.fade = 1.0f;
+                    voice.stealing = false;
+                }
+            }
+            if (voice.pluckPending && !voice.stealing) {
+                // At least one high sample, even for a trigger shorter than the fade
+                gate = true;
+                voice.pluckPending = false;
+            }
+
+            voice.dsp.setParamValue(FP_VOICE::VOLTS, voice.volts);
+            voice.dsp.setParamValue(FP_VOICE::GATE, gate ? 10.0f : 0.0f);
+            float out = voice.computeSample() * voice.fade;
+            sum += out;
+
+            if (!gate && !voice.stealing && std::fabs(out) < SILENCE_THRESHOLD) {
+                if (++voice.quietSamples >= sleepHoldSamples) {
+                    voice.awake = false;
+                }
+            } else {
+                voice.quietSamples = 0;
+            }
+        }
+
+        // Strings that left the pool stop
+        for (int v = numVoices; v < MAX_VOICES; v++) voices[v].awake = false;
 
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        // --- Shared chorus and reverb (mono in, stereo out) ---
+        float frameOut[2] = {};
+        computeFrame(&sum, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
         outputs[RIGHT_OUTPUT].setVoltage(outputR * 5.0f);
     }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustModule<FxDSP>::dataToJson();
+        json_object_set_new(rootJ, "voices", json_integer(numVoices));
+        json_object_set_new(rootJ, "stealing", json_integer(stealing));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        FaustModule<FxDSP>::dataFromJson(rootJ);
+        // Patches from before the voice pool played a single string
+        json_t* voicesJ = json_object_get(rootJ, "voices");
+        setVoiceCount(voicesJ ? static_cast<int>(json_integer_value(voicesJ)) : 1);
+        json_t* stealingJ = json_object_get(rootJ, "stealing");
+        if (stealingJ) stealing = clamp(static_cast<int>(json_integer_value(stealingJ)), 0, 1);
+    }
 };
 
 struct PluckedStringWidget : ModuleWidget {
@@ -224,6 +422,30 @@ struct PluckedStringWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 315), module, PluckedString::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<PluckedString*>(this->module);
+        if (!m) return;
+
+        static const int counts[] = {1, 2, 4, 6, 8};
+        menu->addChild(new MenuSeparator());
+        menu->addChild(createIndexSubmenuItem("Strings",
+            {"1", "2", "4", "6", "8"},
+            [=]() {
+                for (size_t i = 0; i < 5; i++) {
+                    if (counts[i] == m->getVoiceCount()) return i;
+                }
+                return (size_t)0;
+            },
+            [=](size_t index) { m->setVoiceCount(counts[index]); }
+        ));
+        menu->addChild(createIndexSubmenuItem("Strum voice stealing",
+            {"Oldest first", "Round-robin"},
+            [=]() { return (size_t)m->stealing; },
+            [=](size_t index) { m->stealing = static_cast<int>(index); }
+        ));
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -122,5 +122,11 @@ with {
         dryR * (1 - reverb_mix) + wetR * reverb_mix;
 };
 
+// Pooled string voice and the shared effects bus for the module, compiled
+// as separate DSPs (faust -pn, see CMakeLists.txt): voices are summed into
+// one chorus + reverb
+string_voice = dry_signal;
+fx_bus = stereo_chorus : add_reverb;
+
 // Chorus produces stereo (L, R), then feed into reverb
 process = dry_signal : stereo_chorus : add_reverb;
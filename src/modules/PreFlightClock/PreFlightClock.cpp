@@ -1,5 +1,7 @@
 #include "rack.hpp"
 #include "ImagePanel.hpp"
+#include "ClockBus.hpp"
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 
@@ -9,6 +11,22 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+/**
+ * PreFlightClock - master clock with count-in
+ *
+ * Every clock output has an edge schedule: the next edge's index and a
+ * countdown of samples until it. Per sample an output costs a decrement;
+ * countdowns are recomputed only when the tempo changes or an edge fires.
+ * An edge is due on the first sample where beatPhase * ratio reaches the
+ * next integer. The countdown is computed in one division rather than by
+ * summing deltas, so edges that fall exactly on a sample (x32 at 120 BPM
+ * is every 750 samples at 48kHz) stay there instead of slipping one sample
+ * late with accumulated rounding.
+ *
+ * The Bus output publishes tempo, beat phase and the countdown to the next
+ * x1 edge (see ClockBus.hpp), so WiggleRoom clock inputs lock to the tempo
+ * without estimating it.
+ */
 struct PreFlightClock : Module {
     enum ParamId {
         BPM_PARAM,
@@ -42,6 +60,7 @@ struct PreFlightClock : Module {
         DIV8_OUTPUT,
         DIV16_OUTPUT,
         DIV32_OUTPUT,
+        CLOCK_BUS_OUTPUT,
         OUTPUTS_LEN
     };
 
@@ -59,9 +78,28 @@ struct PreFlightClock : Module {
         RUNNING
     };
 
+    static constexpr int NUM_MULTS = 6;
+    static constexpr int NUM_DIVS = 7;
+    static constexpr int NUM_CLOCKS = 1 + NUM_MULTS + NUM_DIVS;
+
+    // Edges per beat: x1, then x2..x32, then /1.5../32
+    static constexpr double CLOCK_RATIOS[NUM_CLOCKS] = {
+        1.0,
+        2.0, 3.0, 4.0, 8.0, 16.0, 32.0,
+        2.0 / 3.0, 0.5, 1.0 / 3.0, 0.25, 0.125, 0.0625, 0.03125
+    };
+
+    // Next edge of one clock output: beatPhase * ratio reaching index,
+    // countdown samples after the current one
+    struct EdgeSchedule {
+        double index = 1.0;
+        int countdown = 0;
+    };
+
     // Clock state
     double beatPhase = 0.0;
-    double prevBeatPhase = 0.0;
+    double scheduledDelta = 0.0;    // beats per sample the countdowns were computed for
+    EdgeSchedule schedules[NUM_CLOCKS];
     State state = STOPPED;
     int countInBeats = 0;
     bool waitingForBeat = false;
@@ -78,9 +116,8 @@ struct PreFlightClock : Module {
     dsp::SchmittTrigger playButtonTrigger;
     dsp::SchmittTrigger stopButtonTrigger;
     dsp::PulseGenerator resetPulse;
-    dsp::PulseGenerator masterPulse;
-    dsp::PulseGenerator multPulses[6]; // x2, x3, x4, x8, x16, x32
-    dsp::PulseGenerator divPulses[7];  // /1.5, /2, /3, /4, /8, /16, /32
+    dsp::PulseGenerator clockPulses[NUM_CLOCKS];
+    ClockBus::Writer busWriter;
 
     // Beat light decay
     float beatBrightness = 0.f;
@@ -117,14 +154,30 @@ struct PreFlightClock : Module {
         configOutput(DIV8_OUTPUT, "Clock /8");
         configOutput(DIV16_OUTPUT, "Clock /16");
         configOutput(DIV32_OUTPUT, "Clock /32");
+        configOutput(CLOCK_BUS_OUTPUT, "Clock bus (7ch poly: clock, run, reset, BPM, phase, edge countdown)");
 
         configLight(STATE_RED_LIGHT, "State");
         configLight(BEAT_LIGHT, "Beat");
     }
 
+    // Samples after the current one until clock i's next edge (0 = due now)
+    int samplesToEdge(int i, double delta) const {
+        double ratio = CLOCK_RATIOS[i];
+        double n = std::ceil((schedules[i].index - beatPhase * ratio) / (delta * ratio));
+        return n < 0.0 ? 0 : static_cast<int>(std::min(n, 1e9));
+    }
+
+    // Pick every clock's next edge after the current phase (after a jump)
+    void resetSchedules() {
+        for (int i = 0; i < NUM_CLOCKS; i++) {
+            schedules[i].index = std::floor(beatPhase * CLOCK_RATIOS[i]) + 1.0;
+        }
+        scheduledDelta = 0.0;
+    }
+
     void onReset() override {
         beatPhase = 0.0;
-        prevBeatPhase = 0.0;
+        resetSchedules();
         state = STOPPED;
         countInBeats = 0;
         waitingForBeat = false;
@@ -179,14 +232,30 @@ struct PreFlightClock : Module {
 
         // --- Phase accumulator (always running) ---
         double delta = static_cast<double>(bpm) / (60.0 * args.sampleRate);
-        prevBeatPhase = beatPhase;
         beatPhase += delta;
 
-        // --- Master beat detection ---
-        bool masterBeat = (std::floor(beatPhase) != std::floor(prevBeatPhase));
+        // --- Edge schedules ---
+        // A tempo change moves every pending edge; otherwise only fired
+        // clocks are rescheduled
+        bool retime = (delta != scheduledDelta);
+        scheduledDelta = delta;
+        bool fired[NUM_CLOCKS];
+        for (int i = 0; i < NUM_CLOCKS; i++) {
+            EdgeSchedule& sched = schedules[i];
+            if (retime) {
+                sched.countdown = samplesToEdge(i, delta);
+            } else {
+                sched.countdown--;
+            }
+            fired[i] = (sched.countdown <= 0);
+            if (fired[i]) {
+                clockPulses[i].trigger(1e-3f);
+                sched.index += 1.0;
+                sched.countdown = samplesToEdge(i, delta);
+            }
+        }
 
-        if (masterBeat) {
-            masterPulse.trigger(1e-3f);
+        if (fired[0]) {
             beatBrightness = 1.f;
 
             // Count-in logic
@@ -216,32 +285,6 @@ struct PreFlightClock : Module {
             }
         }
 
-        // --- Multiplied/divided beat detection ---
-        // Multipliers
-        static const float multRatios[] = {2.f, 3.f, 4.f, 8.f, 16.f, 32.f};
-        for (int i = 0; i < 6; i++) {
-            double r = static_cast<double>(multRatios[i]);
-            if (std::floor(beatPhase * r) != std::floor(prevBeatPhase * r)) {
-                multPulses[i].trigger(1e-3f);
-            }
-        }
-
-        // Dividers
-        static const double divRatios[] = {
-            2.0 / 3.0, // /1.5
-            0.5,        // /2
-            1.0 / 3.0,  // /3
-            0.25,       // /4
-            0.125,      // /8
-            0.0625,     // /16
-            0.03125     // /32
-        };
-        for (int i = 0; i < 7; i++) {
-            if (std::floor(beatPhase * divRatios[i]) != std::floor(prevBeatPhase * divRatios[i])) {
-                divPulses[i].trigger(1e-3f);
-            }
-        }
-
         // --- Metronome audio synthesis ---
         float metroOut = 0.f;
         if (metroEnvelope > 0.001f) {
@@ -253,16 +296,27 @@ struct PreFlightClock : Module {
         }
 
         // --- Set outputs ---
+        bool resetHigh = resetPulse.process(dt);
+        bool masterHigh = clockPulses[0].process(dt);
         outputs[METRO_OUTPUT].setVoltage(metroOut * 5.f);
-        outputs[RESET_OUTPUT].setVoltage(resetPulse.process(dt) ? 10.f : 0.f);
+        outputs[RESET_OUTPUT].setVoltage(resetHigh ? 10.f : 0.f);
         outputs[RUN_OUTPUT].setVoltage(state == RUNNING ? 10.f : 0.f);
-        outputs[MASTER_OUTPUT].setVoltage(masterPulse.process(dt) ? 10.f : 0.f);
+        outputs[MASTER_OUTPUT].setVoltage(masterHigh ? 10.f : 0.f);
 
-        for (int i = 0; i < 6; i++) {
-            outputs[X2_OUTPUT + i].setVoltage(multPulses[i].process(dt) ? 10.f : 0.f);
+        // Clock outputs follow MASTER_OUTPUT in schedule order
+        for (int i = 1; i < NUM_CLOCKS; i++) {
+            outputs[MASTER_OUTPUT + i].setVoltage(clockPulses[i].process(dt) ? 10.f : 0.f);
         }
-        for (int i = 0; i < 7; i++) {
-            outputs[DIV1_5_OUTPUT + i].setVoltage(divPulses[i].process(dt) ? 10.f : 0.f);
+
+        if (outputs[CLOCK_BUS_OUTPUT].isConnected()) {
+            ClockBus::Frame frame;
+            frame.clock = masterHigh;
+            frame.run = (state == RUNNING);
+            frame.reset = resetHigh;
+            frame.bpm = bpm;
+            frame.beatPhase = beatPhase;
+            frame.edgeSamples = fired[0] ? 0 : schedules[0].countdown;
+            busWriter.write(outputs[CLOCK_BUS_OUTPUT], frame);
         }
 
         // --- Lights ---
@@ -310,7 +364,7 @@ struct PreFlightClock : Module {
         json_t* countJ = json_object_get(rootJ, "countInBeats");
         if (countJ) countInBeats = static_cast<int>(json_integer_value(countJ));
 
-        prevBeatPhase = beatPhase;
+        resetSchedules();
         displayState.store(static_cast<int>(state));
         displayCount.store(countInBeats);
     }
@@ -466,6 +520,7 @@ struct PreFlightClockWidget : ModuleWidget {
         // Row 4: /16, /32
         addOutput(createOutputCentered<PJ301MPort>(Vec(xC2, yRow4), module, PreFlightClock::DIV16_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(Vec(xC3, yRow4), module, PreFlightClock::DIV32_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(Vec(xC4, yRow4), module, PreFlightClock::CLOCK_BUS_OUTPUT));
 
         // --- CV inputs at bottom ---
         float yInputRow = 326;
@@ -9,6 +9,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME SaturationEcho
 #include "saturation_echo.hpp"  // Generated by Faust
+#include "saturation_echo_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -16,6 +17,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::saturation_echo;
+
 /**
  * SaturationEcho - Vintage Tape Delay Emulation
  *
@@ -75,20 +78,24 @@ struct SaturationEcho : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical order):
-        // 0=drive, 1=feedback, 2=mix, 3=time, 4=tone, 5=wobble
-        mapParam(DRIVE_PARAM, 0);
-        mapParam(FEEDBACK_PARAM, 1);
-        mapParam(MIX_PARAM, 2);
-        mapParam(TIME_PARAM, 3);
-        mapParam(TONE_PARAM, 4);
-        mapParam(WOBBLE_PARAM, 5);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(DRIVE_PARAM, FP::DRIVE);
+        mapParam(FEEDBACK_PARAM, FP::FEEDBACK);
+        mapParam(MIX_PARAM, FP::MIX);
+        mapParam(TIME_PARAM, FP::TIME);
+        mapParam(TONE_PARAM, FP::TONE);
+        mapParam(WOBBLE_PARAM, FP::WOBBLE);
+
+        // Idle once the repeats have died out (hold covers the 1s max delay)
+        setSilenceBypass(2.0f);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -109,12 +116,12 @@ struct SaturationEcho : FaustModule<VCVRackDSP> {
         feedback = clamp(feedback, 0.f, 1.2f);
 
         // Update Faust parameters
-        faustDsp.setParamValue(0, params[DRIVE_PARAM].getValue());   // drive
-        faustDsp.setParamValue(1, feedback);                          // feedback (with CV)
-        faustDsp.setParamValue(2, params[MIX_PARAM].getValue());      // mix
-        faustDsp.setParamValue(3, time);                              // time (with CV)
-        faustDsp.setParamValue(4, params[TONE_PARAM].getValue());     // tone
-        faustDsp.setParamValue(5, params[WOBBLE_PARAM].getValue());   // wobble
+        faustDsp.setParamValue(FP::DRIVE, params[DRIVE_PARAM].getValue());
+        faustDsp.setParamValue(FP::FEEDBACK, feedback);   // with CV
+        faustDsp.setParamValue(FP::MIX, params[MIX_PARAM].getValue());
+        faustDsp.setParamValue(FP::TIME, time);           // with CV
+        faustDsp.setParamValue(FP::TONE, params[TONE_PARAM].getValue());
+        faustDsp.setParamValue(FP::WOBBLE, params[WOBBLE_PARAM].getValue());
 
         // Get stereo input (normalize to Faust range)
         float inputL = inputs[LEFT_INPUT].getVoltage() * 0.2f;  // 5V -> 1.0
@@ -122,12 +129,12 @@ struct SaturationEcho : FaustModule<VCVRackDSP> {
             ? inputs[RIGHT_INPUT].getVoltage() * 0.2f
             : inputL;  // Mono to stereo if only left connected
 
-        float* inputPtrs[2] = { &inputL, &inputR };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        float frameIn[2] = { inputL, inputR };
+        float frameOut[2] = {};
 
         // Process audio
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        computeFrame(frameIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output (back to VCV voltage range)
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -185,6 +192,13 @@ struct SaturationEchoWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter + 18, 330), module, SaturationEcho::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<SaturationEcho*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -10,6 +10,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME SpaceCello
 #include "space_cello.hpp"  // Generated by Faust
+#include "space_cello_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +18,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::space_cello;
+
 /**
  * SpaceCello - Cathedral Yaybahar
  *
@@ -78,21 +81,26 @@ struct SpaceCello : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): body=0, decay=1, gate=2, reverb=3, spring=4, sympath=5, tube=6, volts=7
-        mapParam(BODY_PARAM, 0);
-        mapParam(DECAY_PARAM, 1);
-        // gate=2 handled manually
-        mapParam(REVERB_PARAM, 3);
-        mapParam(SPRING_PARAM, 4);
-        mapParam(SYMPATH_PARAM, 5);
-        mapParam(TUBE_PARAM, 6);
-        mapParam(PITCH_PARAM, 7);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(BODY_PARAM, FP::BODY);
+        mapParam(DECAY_PARAM, FP::DECAY);
+        // gate handled manually
+        mapParam(REVERB_PARAM, FP::REVERB);
+        mapParam(SPRING_PARAM, FP::SPRING);
+        mapParam(SYMPATH_PARAM, FP::SYMPATH);
+        mapParam(TUBE_PARAM, FP::TUBE);
+        mapParam(PITCH_PARAM, FP::VOLTS);
+
+        // The string model costs scale with the engine rate; optionally run near 48 kHz
+        enableFixedRate(48000);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -127,22 +135,20 @@ struct SpaceCello : FaustModule<VCVRackDSP> {
         float gate = inputs[GATE_INPUT].isConnected() ?
                      (inputs[GATE_INPUT].getVoltage() > 1.0f ? 1.0f : 0.0f) : 0.0f;
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, body);     // body
-        faustDsp.setParamValue(1, decay);    // decay
-        faustDsp.setParamValue(2, gate);     // gate
-        faustDsp.setParamValue(3, reverb);   // reverb
-        faustDsp.setParamValue(4, spring);   // spring
-        faustDsp.setParamValue(5, sympath);  // sympath
-        faustDsp.setParamValue(6, tube);     // tube
-        faustDsp.setParamValue(7, volts);    // volts
+        // Update Faust parameters
+        faustDsp.setParamValue(FP::BODY, body);
+        faustDsp.setParamValue(FP::DECAY, decay);
+        setGateParam(FP::GATE, gate);
+        faustDsp.setParamValue(FP::REVERB, reverb);
+        faustDsp.setParamValue(FP::SPRING, spring);
+        faustDsp.setParamValue(FP::SYMPATH, sympath);
+        faustDsp.setParamValue(FP::TUBE, tube);
+        faustDsp.setParamValue(FP::VOLTS, volts);
 
         // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(nullptr, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output - scale appropriately
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -205,6 +211,14 @@ struct SpaceCelloWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 320), module, SpaceCello::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<SpaceCello*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        appendFixedRateMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -3,15 +3,27 @@
  * 4-Channel Spatial/Spectral Mixer
  * X/Y grid: X = equal-power pan, Y = SVF filter morph (LP→BP→HP)
  * Interactive display with 4 draggable nodes, per-node CV, 2 global LFOs
- * Built with Faust DSP
+ *
+ * The node filters and pan run in C++ (MorphSvfBank, four nodes per
+ * float_4): positions are read every SMOOTH_INTERVAL samples and the
+ * filter coefficients ramp between reads. The Faust DSP mixes the effects
+ * return and limits the stereo bus.
+ *
+ * 8-node mode (context menu) gives each input's left and right signal its
+ * own node: nodes 1-4 take IN 1-4 L, nodes 5-8 take IN 1-4 R (normalled to
+ * L). Nodes 5-8 follow channel 2 of the X/Y CV cables, or the same CV as
+ * their partner node when the cable is mono.
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "CachedDisplay.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include "MorphSvfBank.hpp"
 #include <cmath>
 #define FAUST_MODULE_NAME SpectraHenge
 #include "spectra_henge.hpp"  // Generated by Faust
+#include "spectra_henge_params.hpp"  // Faust parameter indices
 
 #include <atomic>
 
@@ -21,19 +33,29 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
-// Node colors (RGBA for NanoVG)
-static const NVGcolor NODE_COLORS[4] = {
+namespace FP = FaustParams::spectra_henge;
+
+// Node colors (RGBA for NanoVG); nodes 5-8 are lighter tints of their partners
+static const NVGcolor NODE_COLORS[8] = {
     nvgRGBA(0, 200, 255, 255),   // Channel 1: Cyan
     nvgRGBA(255, 80, 180, 255),  // Channel 2: Magenta
     nvgRGBA(255, 180, 0, 255),   // Channel 3: Orange
     nvgRGBA(120, 255, 80, 255),  // Channel 4: Green
+    nvgRGBA(150, 230, 255, 255), // Channel 1 R
+    nvgRGBA(255, 170, 215, 255), // Channel 2 R
+    nvgRGBA(255, 215, 130, 255), // Channel 3 R
+    nvgRGBA(190, 255, 160, 255), // Channel 4 R
 };
 
-static const NVGcolor NODE_GLOW_COLORS[4] = {
+static const NVGcolor NODE_GLOW_COLORS[8] = {
     nvgRGBA(0, 200, 255, 60),
     nvgRGBA(255, 80, 180, 60),
     nvgRGBA(255, 180, 0, 60),
     nvgRGBA(120, 255, 80, 60),
+    nvgRGBA(150, 230, 255, 60),
+    nvgRGBA(255, 170, 215, 60),
+    nvgRGBA(255, 215, 130, 60),
+    nvgRGBA(190, 255, 160, 60),
 };
 
 // ============================================================================
@@ -52,6 +74,14 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
         NODE_Y4_PARAM,
         Q_PARAM,
         SEND_PARAM,      // Send amount (0-1)
+        NODE_X5_PARAM,   // Nodes 5-8 (8-node mode)
+        NODE_X6_PARAM,
+        NODE_X7_PARAM,
+        NODE_X8_PARAM,
+        NODE_Y5_PARAM,
+        NODE_Y6_PARAM,
+        NODE_Y7_PARAM,
+        NODE_Y8_PARAM,
         PARAMS_LEN
     };
     enum InputId {
@@ -88,9 +118,24 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int MAX_NODES = MorphSvfBank::MAX_CHANNELS;
+    static constexpr int SMOOTH_INTERVAL = 16;
+
+    static constexpr int X_PARAMS[MAX_NODES] = {
+        NODE_X1_PARAM, NODE_X2_PARAM, NODE_X3_PARAM, NODE_X4_PARAM,
+        NODE_X5_PARAM, NODE_X6_PARAM, NODE_X7_PARAM, NODE_X8_PARAM};
+    static constexpr int Y_PARAMS[MAX_NODES] = {
+        NODE_Y1_PARAM, NODE_Y2_PARAM, NODE_Y3_PARAM, NODE_Y4_PARAM,
+        NODE_Y5_PARAM, NODE_Y6_PARAM, NODE_Y7_PARAM, NODE_Y8_PARAM};
+
+    MorphSvfBank bank;
+    std::atomic<int> requestedNodes{4};
+    int smoothCounter = 0;
+
     // Thread-safe display positions (written by audio, read by UI)
-    std::atomic<float> displayX[4];
-    std::atomic<float> displayY[4];
+    std::atomic<float> displayX[MAX_NODES];
+    std::atomic<float> displayY[MAX_NODES];
+    std::atomic<int> displayNodes{4};
 
     SpectraHenge() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -105,6 +150,16 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
         configParam(NODE_Y3_PARAM, 0.f, 1.f, 0.75f, "Node 3 Y");
         configParam(NODE_Y4_PARAM, 0.f, 1.f, 0.25f, "Node 4 Y");
 
+        // Nodes 5-8 start just right of their partners
+        configParam(NODE_X5_PARAM, 0.f, 1.f, 0.45f, "Node 5 X");
+        configParam(NODE_X6_PARAM, 0.f, 1.f, 0.95f, "Node 6 X");
+        configParam(NODE_X7_PARAM, 0.f, 1.f, 0.45f, "Node 7 X");
+        configParam(NODE_X8_PARAM, 0.f, 1.f, 0.95f, "Node 8 X");
+        configParam(NODE_Y5_PARAM, 0.f, 1.f, 0.25f, "Node 5 Y");
+        configParam(NODE_Y6_PARAM, 0.f, 1.f, 0.75f, "Node 6 Y");
+        configParam(NODE_Y7_PARAM, 0.f, 1.f, 0.75f, "Node 7 Y");
+        configParam(NODE_Y8_PARAM, 0.f, 1.f, 0.25f, "Node 8 Y");
+
         // Visible Q knob
         configParam(Q_PARAM, 0.5f, 10.f, 1.0f, "Resonance (Q)");
 
@@ -148,41 +203,45 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
         configOutput(SEND_R_OUTPUT, "Send Right");
 
         // Initialize display positions
-        for (int i = 0; i < 4; i++) {
+        for (int i = 0; i < MAX_NODES; i++) {
             displayX[i].store(0.5f);
             displayY[i].store(0.5f);
         }
 
-        // No mapParam/mapCVInput — we handle everything manually in process()
+        // Only the send is a Faust param (node positions and Q drive the C++ bank)
+        mapParam(SEND_PARAM, FP::SEND);
     }
 
-    void process(const ProcessArgs& args) override {
-        // Initialize DSP on first run
-        if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
-        }
+    void setNodeCount(int nodes) {
+        requestedNodes = nodes > 4 ? MAX_NODES : 4;
+    }
+
+    int getNodeCount() const {
+        return requestedNodes;
+    }
+
+    // Node positions (knob/drag + CV + LFO drift) into the bank and display
+    void updateNodes(float sampleRate) {
+        bank.setChannelCount(requestedNodes);
+        bank.setSampleRate(sampleRate);
+        int nodes = bank.getChannelCount();
+        displayNodes.store(nodes, std::memory_order_relaxed);
 
         // LFO global offsets: ±5V → ±0.25
         float lfoA = inputs[LFO_A_INPUT].getVoltage() * 0.05f;
         float lfoB = inputs[LFO_B_INPUT].getVoltage() * 0.05f;
 
-        // Param index arrays for iteration
-        static const int xParams[4] = {NODE_X1_PARAM, NODE_X2_PARAM, NODE_X3_PARAM, NODE_X4_PARAM};
-        static const int yParams[4] = {NODE_Y1_PARAM, NODE_Y2_PARAM, NODE_Y3_PARAM, NODE_Y4_PARAM};
-        static const int cvXInputs[4] = {CV_X1_INPUT, CV_X2_INPUT, CV_X3_INPUT, CV_X4_INPUT};
-        static const int cvYInputs[4] = {CV_Y1_INPUT, CV_Y2_INPUT, CV_Y3_INPUT, CV_Y4_INPUT};
-
-        float finalX[4], finalY[4];
+        float finalX[MAX_NODES], finalY[MAX_NODES];
 
-        for (int i = 0; i < 4; i++) {
+        for (int i = 0; i < nodes; i++) {
             // Base position from param (set by knob/drag)
-            float baseX = params[xParams[i]].getValue();
-            float baseY = params[yParams[i]].getValue();
+            float baseX = params[X_PARAMS[i]].getValue();
+            float baseY = params[Y_PARAMS[i]].getValue();
 
-            // Add CV (±10V → ±1.0 range)
-            float cvX = inputs[cvXInputs[i]].getVoltage() * 0.1f;
-            float cvY = inputs[cvYInputs[i]].getVoltage() * 0.1f;
+            // Add CV (±10V → ±1.0 range); nodes 5-8 read channel 2
+            int channel = i / 4;
+            float cvX = inputs[CV_X1_INPUT + i % 4].getPolyVoltage(channel) * 0.1f;
+            float cvY = inputs[CV_Y1_INPUT + i % 4].getPolyVoltage(channel) * 0.1f;
 
             // Add LFO global drift
             finalX[i] = clamp(baseX + cvX + lfoA, 0.f, 1.f);
@@ -193,57 +252,92 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
             displayY[i].store(finalY[i], std::memory_order_relaxed);
         }
 
-        // Set Faust parameters (alphabetical index order):
-        // 0=pan1, 1=pan2, 2=pan3, 3=pan4, 4=q, 5=tilt1, 6=tilt2, 7=tilt3, 8=tilt4
-        faustDsp.setParamValue(0, finalX[0]);  // pan1
-        faustDsp.setParamValue(1, finalX[1]);  // pan2
-        faustDsp.setParamValue(2, finalX[2]);  // pan3
-        faustDsp.setParamValue(3, finalX[3]);  // pan4
-        faustDsp.setParamValue(4, params[Q_PARAM].getValue());  // q
-        faustDsp.setParamValue(5, finalY[0]);  // tilt1
-        faustDsp.setParamValue(6, finalY[1]);  // tilt2
-        faustDsp.setParamValue(7, finalY[2]);  // tilt3
-        faustDsp.setParamValue(8, finalY[3]);  // tilt4
-
-        // Audio I/O — sum stereo inputs to mono (R optional, backward compatible)
-        float in1 = inputs[IN1_INPUT].getVoltage();
-        if (inputs[IN1_R_INPUT].isConnected())
-            in1 += inputs[IN1_R_INPUT].getVoltage();
-        in1 *= 0.2f;
-
-        float in2 = inputs[IN2_INPUT].getVoltage();
-        if (inputs[IN2_R_INPUT].isConnected())
-            in2 += inputs[IN2_R_INPUT].getVoltage();
-        in2 *= 0.2f;
-
-        float in3 = inputs[IN3_INPUT].getVoltage();
-        if (inputs[IN3_R_INPUT].isConnected())
-            in3 += inputs[IN3_R_INPUT].getVoltage();
-        in3 *= 0.2f;
-
-        float in4 = inputs[IN4_INPUT].getVoltage();
-        if (inputs[IN4_R_INPUT].isConnected())
-            in4 += inputs[IN4_R_INPUT].getVoltage();
-        in4 *= 0.2f;
-
-        float* inputPtrs[4] = {&in1, &in2, &in3, &in4};
-        float outL = 0.f, outR = 0.f;
-        float* outputPtrs[2] = {&outL, &outR};
-
-        faustDsp.compute(1, inputPtrs, outputPtrs);
-
-        // Send outputs (pre-limiter, raw Faust output)
+        float q = params[Q_PARAM].getValue();
+        for (int g = 0; g < bank.getGroupCount(); g++) {
+            simd::float_4 tilt = simd::float_4::load(&finalY[g * 4]);
+            simd::float_4 pan = simd::float_4::load(&finalX[g * 4]);
+            bank.setControls(g, tilt, pan, q, SMOOTH_INTERVAL);
+        }
+    }
+
+    void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
+        // Initialize DSP on first run
+        if (!initialized) {
+            initDsp(args.sampleRate);
+            initialized = true;
+        }
+
+        if (--smoothCounter <= 0) {
+            smoothCounter = SMOOTH_INTERVAL;
+            updateNodes(args.sampleRate);
+        }
+        updateFaustParams();
+
+        // Audio in: 4 nodes sum each stereo input to mono (R optional,
+        // backward compatible); 8 nodes give L and R their own node
+        float in[MAX_NODES];
+        bool split = bank.getChannelCount() > 4;
+        for (int i = 0; i < 4; i++) {
+            float left = inputs[IN1_INPUT + i].getVoltage();
+            Input& rightIn = inputs[IN1_R_INPUT + i];
+            if (split) {
+                in[i] = left * 0.2f;
+                in[i + 4] = (rightIn.isConnected() ? rightIn.getVoltage() : left) * 0.2f;
+            } else {
+                in[i] = (rightIn.isConnected() ? left + rightIn.getVoltage() : left) * 0.2f;
+            }
+        }
+
+        // Node filters and pan -> stereo bus
+        simd::float_4 busL = 0.f;
+        simd::float_4 busR = 0.f;
+        {
+            ScopedFlushDenormals noDenormals;
+            for (int g = 0; g < bank.getGroupCount(); g++) {
+                bank.process(g, simd::float_4::load(&in[g * 4]), busL, busR);
+            }
+        }
+        float outL = (busL[0] + busL[1] + busL[2] + busL[3]) * 0.5f;
+        float outR = (busR[0] + busR[1] + busR[2] + busR[3]) * 0.5f;
+
+        // Send outputs (pre-limiter bus)
         outputs[SEND_L_OUTPUT].setVoltage(outL * 5.f);
         outputs[SEND_R_OUTPUT].setVoltage(outR * 5.f);
 
-        // Mix return and apply limiter (tanh moved from Faust to C++)
-        float sendAmt = params[SEND_PARAM].getValue();
-        float retL = inputs[RETURN_L_INPUT].getVoltage() * 0.2f;
-        float retR = inputs[RETURN_R_INPUT].getVoltage() * 0.2f;
-        float finalL = std::tanh(outL + retL * sendAmt);
-        float finalR = std::tanh(outR + retR * sendAmt);
-        outputs[OUT_L_OUTPUT].setVoltage(finalL * 5.f);
-        outputs[OUT_R_OUTPUT].setVoltage(finalR * 5.f);
+        // Faust mixes the return and applies the limiter
+        float frameIn[4] = {
+            outL,
+            outR,
+            inputs[RETURN_L_INPUT].getVoltage() * 0.2f,
+            inputs[RETURN_R_INPUT].getVoltage() * 0.2f,
+        };
+        float frameOut[2] = {};
+        computeFrame(frameIn, frameOut);
+        outputs[OUT_L_OUTPUT].setVoltage(frameOut[0] * 5.f);
+        outputs[OUT_R_OUTPUT].setVoltage(frameOut[1] * 5.f);
+    }
+
+    void onReset() override {
+        FaustModule::onReset();
+        bank.reset();
+        smoothCounter = 0;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustModule::dataToJson();
+        json_object_set_new(rootJ, "nodes", json_integer(getNodeCount()));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        FaustModule::dataFromJson(rootJ);
+        // Block processing would delay OUT against SEND, so patches saved
+        // with a block size still run per sample
+        setBlockSize(1);
+        json_t* nodesJ = json_object_get(rootJ, "nodes");
+        if (nodesJ) setNodeCount(static_cast<int>(json_integer_value(nodesJ)));
     }
 };
 
@@ -251,7 +345,7 @@ struct SpectraHenge : FaustModule<VCVRackDSP> {
 // DISPLAY WIDGET (Interactive X/Y grid with 4 draggable nodes)
 // ============================================================================
 
-struct SpectraHengeDisplay : OpaqueWidget {
+struct SpectraHengeDisplay : WiggleRoom::CachedDisplay<OpaqueWidget> {
     SpectraHenge* module = nullptr;
     int dragNode = -1;  // Which node is being dragged (-1 = none)
     int hoverNode = -1; // Which node is being hovered
@@ -259,7 +353,9 @@ struct SpectraHengeDisplay : OpaqueWidget {
     static constexpr float NODE_RADIUS = 8.f;
     static constexpr float HIT_RADIUS = 16.f;
 
-    SpectraHengeDisplay() {}
+    SpectraHengeDisplay() {
+        staticLayer = 1;
+    }
 
     // Get node position in widget coordinates
     Vec getNodePos(int i) {
@@ -272,9 +368,13 @@ struct SpectraHengeDisplay : OpaqueWidget {
         return Vec(x * box.size.x, (1.f - y) * box.size.y);
     }
 
+    int nodeCount() {
+        return module ? module->displayNodes.load(std::memory_order_relaxed) : 4;
+    }
+
     // Hit-test: find closest node within radius
     int hitTestNode(Vec pos) {
-        for (int i = 0; i < 4; i++) {
+        for (int i = nodeCount() - 1; i >= 0; i--) {
             Vec nodePos = getNodePos(i);
             if (pos.minus(nodePos).norm() < HIT_RADIUS) {
                 return i;
@@ -307,8 +407,8 @@ struct SpectraHengeDisplay : OpaqueWidget {
         float dy = -e.mouseDelta.y / box.size.y;  // Y inverted
 
         // Get current param values and update
-        int xParamId = SpectraHenge::NODE_X1_PARAM + dragNode;
-        int yParamId = SpectraHenge::NODE_Y1_PARAM + dragNode;
+        int xParamId = SpectraHenge::X_PARAMS[dragNode];
+        int yParamId = SpectraHenge::Y_PARAMS[dragNode];
 
         float newX = clamp(module->params[xParamId].getValue() + dx, 0.f, 1.f);
         float newY = clamp(module->params[yParamId].getValue() + dy, 0.f, 1.f);
@@ -339,16 +439,24 @@ struct SpectraHengeDisplay : OpaqueWidget {
         nvgFillColor(args.vg, nvgRGB(10, 8, 20));
         nvgFill(args.vg);
 
-        OpaqueWidget::draw(args);
+        CachedDisplay::draw(args);
     }
 
-    // Layer 1: lit content (nodes, grid, labels)
-    void drawLayer(const DrawArgs& args, int layer) override {
-        if (layer != 1) {
-            OpaqueWidget::drawLayer(args, layer);
-            return;
+    // Nodes move with their params and CV; hover and drag resize them
+    uint64_t dataGeneration() override {
+        int nodes = nodeCount();
+        uint64_t key = mix(mix(mix(0, dragNode), hoverNode), nodes);
+        if (module) {
+            for (int i = 0; i < nodes; i++) {
+                key = mix(key, module->displayX[i].load(std::memory_order_relaxed));
+                key = mix(key, module->displayY[i].load(std::memory_order_relaxed));
+            }
         }
+        return key;
+    }
 
+    // Lit, cached: grid and zone labels
+    void drawStatic(const DrawArgs& args) override {
         float w = box.size.x;
         float h = box.size.y;
 
@@ -389,13 +497,18 @@ struct SpectraHengeDisplay : OpaqueWidget {
         nvgText(args.vg, 2.f, h - 2.f, "L", NULL);
         nvgTextAlign(args.vg, NVG_ALIGN_RIGHT | NVG_ALIGN_BOTTOM);
         nvgText(args.vg, w - 2.f, h - 2.f, "R", NULL);
+    }
+
+    // Lit: connection lines and nodes
+    void drawDynamic(const DrawArgs& args) override {
+        int nodes = nodeCount();
 
         // Draw connection lines between nodes (subtle)
         if (module) {
             nvgStrokeColor(args.vg, nvgRGBA(60, 50, 80, 30));
             nvgStrokeWidth(args.vg, 0.5f);
-            for (int i = 0; i < 4; i++) {
-                for (int j = i + 1; j < 4; j++) {
+            for (int i = 0; i < nodes; i++) {
+                for (int j = i + 1; j < nodes; j++) {
                     Vec a = getNodePos(i);
                     Vec b = getNodePos(j);
                     nvgBeginPath(args.vg);
@@ -407,7 +520,7 @@ struct SpectraHengeDisplay : OpaqueWidget {
         }
 
         // Draw nodes
-        for (int i = 0; i < 4; i++) {
+        for (int i = 0; i < nodes; i++) {
             Vec pos = getNodePos(i);
             bool isDragging = (dragNode == i);
             bool isHovering = (hoverNode == i);
@@ -461,8 +574,6 @@ struct SpectraHengeDisplay : OpaqueWidget {
                 nvgText(args.vg, pos.x, tooltipY, tooltip, NULL);
             }
         }
-
-        OpaqueWidget::drawLayer(args, layer);
     }
 };
 
@@ -556,6 +667,17 @@ struct SpectraHengeWidget : ModuleWidget {
         addInput(createInputCentered<PJ301MPort>(Vec(col3, jackRow6), module, SpectraHenge::RETURN_L_INPUT));
         addInput(createInputCentered<PJ301MPort>(Vec(col4, jackRow6), module, SpectraHenge::RETURN_R_INPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<SpectraHenge*>(this->module);
+        if (!m) return;
+
+        menu->addChild(createIndexSubmenuItem("Nodes", {"4 (stereo inputs summed)", "8 (left and right split)"},
+            [=]() { return (size_t)(m->getNodeCount() > 4 ? 1 : 0); },
+            [=](size_t index) { m->setNodeCount(index ? SpectraHenge::MAX_NODES : 4); }
+        ));
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -1,6 +1,6 @@
 /******************************************************************************
  * SPECTRAL RESONATOR
- * 6-band resonant filter bank for spectral chord processing
+ * 6 to 32-band resonant filter bank for spectral chord processing
  * Inspired by 4ms SMR and Mutable Instruments Rings
  * Built with Faust DSP
  ******************************************************************************/
@@ -8,8 +8,11 @@
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include "ResonatorBank.hpp"
+#include <atomic>
 #define FAUST_MODULE_NAME SpectralResonator
 #include "spectral_resonator.hpp"  // Generated by Faust
+#include "spectral_resonator_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,18 +20,24 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::spectral_resonator;
+
 /**
- * SpectralResonator - 6-Band Chord Resonator
+ * SpectralResonator - Chord Resonator
  *
- * A bank of 6 tuned resonant filters that transform noise, drums,
+ * A bank of tuned resonant filters that transform noise, drums,
  * or simple waves into lush, melodic chords.
  *
  * Features:
- *   - 6 parallel resonant bandpass filters
+ *   - 6, 12, 24 or 32 parallel resonant bandpass filters (context menu)
  *   - Spread control morphs between unison, fifths, octaves, and complex chords
- *   - Stereo output: odd bands (1,3,5) to left, even bands (2,4,6) to right
+ *   - Stereo output: odd bands (1,3,5...) to left, even bands (2,4,6...) to right
  *   - V/Oct pitch tracking
  *   - CV control over spread for "breathing" chord effects
+ *
+ * The bank runs in C++ (ResonatorBank, four bands per float_4); the Faust
+ * DSP only damps and clips its stereo sums. Pitch, spread and Q are smoothed
+ * at control rate and the bank is only retuned while one of them moves.
  */
 struct SpectralResonator : FaustModule<VCVRackDSP> {
     enum ParamId {
@@ -53,6 +62,20 @@ struct SpectralResonator : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int BAND_COUNTS[] = {6, 12, 24, 32};
+    static constexpr int SMOOTH_INTERVAL = 16;
+
+    ResonatorBank bank;
+    std::atomic<int> requestedBands{6};
+    float bandScale = 0.25f;
+
+    // Control-rate smoothing of the bank's tuning (primed on the first step)
+    float smoothVolts = 0.f;
+    float smoothSpread = 0.f;
+    float smoothQ = 0.f;
+    bool smoothPrimed = false;
+    int smoothCounter = 0;
+
     SpectralResonator() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -72,54 +95,117 @@ struct SpectralResonator : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): damp=0, q=1, spread=2, volts=3
-        mapParam(DAMP_PARAM, 0);
-        mapParam(Q_PARAM, 1);
-        mapParam(SPREAD_PARAM, 2);
-        mapParam(FREQ_PARAM, 3);
+        // Only damping is a Faust param (pitch, spread and Q drive the C++ bank)
+        mapParam(DAMP_PARAM, FP::DAMP);
     }
 
-    void process(const ProcessArgs& args) override {
-        // Initialize DSP on first run
-        if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
-            initialized = true;
+    void setBandCount(int bands) {
+        requestedBands = clamp(bands, 1, ResonatorBank::MAX_BANDS);
+    }
+
+    int getBandCount() const {
+        return requestedBands;
+    }
+
+    // One-pole step towards target, snapping once within epsilon so the
+    // bank stops retuning when the controls are still
+    static float smoothStep(float current, float target, float epsilon) {
+        // si.smoo's 0.999 pole, applied once per SMOOTH_INTERVAL samples
+        constexpr float COEFF = 0.0159f;   // 1 - 0.999^16
+        float next = current + (target - current) * COEFF;
+        return std::fabs(target - next) < epsilon ? target : next;
+    }
+
+    void updateBank(float sampleRate) {
+        int bands = requestedBands;
+        if (bands != bank.getBandCount()) {
+            bank.setBandCount(bands);
+            // Keep the level of the original 6-band bank (3 bands per side at 1/4)
+            bandScale = 0.25f * std::sqrt(6.f / bank.getBandCount());
         }
+        bank.setSampleRate(sampleRate);
 
-        // Calculate pitch (knob + V/Oct input)
+        // Pitch (knob + V/Oct input)
         float volts = params[FREQ_PARAM].getValue();
         if (inputs[VOCT_INPUT].isConnected()) {
             volts += inputs[VOCT_INPUT].getVoltage();
         }
         volts = clamp(volts, 0.f, 10.f);
 
-        // Calculate spread (knob + CV)
+        // Spread (knob + CV)
         float spread = params[SPREAD_PARAM].getValue();
         if (inputs[SPREAD_CV_INPUT].isConnected()) {
             spread += inputs[SPREAD_CV_INPUT].getVoltage() * 0.2f;  // +/-5V = +/-1.0
         }
         spread = clamp(spread, 1.001f, 3.0f);  // Prevent 0 or negative spread
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, params[DAMP_PARAM].getValue());  // damp
-        faustDsp.setParamValue(1, params[Q_PARAM].getValue());      // q
-        faustDsp.setParamValue(2, spread);                          // spread (with CV)
-        faustDsp.setParamValue(3, volts);                           // volts (with V/Oct)
+        float q = params[Q_PARAM].getValue();
+
+        if (!smoothPrimed) {
+            smoothVolts = volts;
+            smoothSpread = spread;
+            smoothQ = q;
+            smoothPrimed = true;
+        } else {
+            smoothVolts = smoothStep(smoothVolts, volts, 1e-4f);
+            smoothSpread = smoothStep(smoothSpread, spread, 1e-5f);
+            smoothQ = smoothStep(smoothQ, q, 1e-3f);
+        }
+
+        // Base is A2 (110Hz), each volt doubles frequency
+        bank.setChord(110.f * std::exp2(smoothVolts), smoothSpread, smoothQ);
+    }
+
+    void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
+        // Initialize DSP on first run
+        if (!initialized) {
+            initDsp(args.sampleRate);
+            initialized = true;
+        }
+
+        if (--smoothCounter <= 0) {
+            smoothCounter = SMOOTH_INTERVAL;
+            updateBank(args.sampleRate);
+        }
+        updateFaustParams();
 
         // Get mono input (normalize to Faust range)
         float input = inputs[AUDIO_INPUT].getVoltage() * 0.2f;  // 5V -> 1.0
 
-        float* inputPtrs[1] = { &input };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        // Resonator bank -> stereo band sums -> Faust damping and clip
+        float frameIn[2];
+        bank.process(input, frameIn[0], frameIn[1]);
+        frameIn[0] *= bandScale;
+        frameIn[1] *= bandScale;
 
-        // Process audio
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(frameIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output (back to VCV voltage range)
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
         outputs[RIGHT_OUTPUT].setVoltage(outputR * 5.0f);
     }
+
+    void onReset() override {
+        FaustModule::onReset();
+        bank.reset();
+        smoothPrimed = false;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = FaustModule::dataToJson();
+        json_object_set_new(rootJ, "bands", json_integer(getBandCount()));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        FaustModule::dataFromJson(rootJ);
+        json_t* bandsJ = json_object_get(rootJ, "bands");
+        if (bandsJ) setBandCount(static_cast<int>(json_integer_value(bandsJ)));
+    }
 };
 
 struct SpectralResonatorWidget : ModuleWidget {
@@ -167,6 +253,28 @@ struct SpectralResonatorWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xCenter + 20, 310), module, SpectralResonator::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<SpectralResonator*>(this->module);
+        if (!m) return;
+
+        appendBlockSizeMenu(menu, m);
+
+        std::vector<std::string> labels;
+        for (int bands : SpectralResonator::BAND_COUNTS) {
+            labels.push_back(std::to_string(bands) + " bands");
+        }
+        menu->addChild(createIndexSubmenuItem("Resonator bands", labels,
+            [=]() {
+                for (size_t i = 0; i < labels.size(); i++) {
+                    if (SpectralResonator::BAND_COUNTS[i] == m->getBandCount()) return i;
+                }
+                return (size_t)0;
+            },
+            [=](size_t index) { m->setBandCount(SpectralResonator::BAND_COUNTS[index]); }
+        ));
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
@@ -9,6 +9,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME TetanusCoil
 #include "tetanus_coil.hpp"  // Generated by Faust
+#include "tetanus_coil_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -16,6 +17,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::tetanus_coil;
+
 /**
  * TetanusCoil - Extreme Spring Reverb
  *
@@ -83,14 +86,20 @@ struct TetanusCoil : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params are alphabetical: darkness=0, feedback=1, grit=2, kick=3, tension=4, wobble=5
         // We don't use mapParam here since we need custom CV handling
+
+        setSilenceBypass(1.0f);
+
+        // The spring model costs scale with the engine rate; optionally run near 48 kHz
+        enableFixedRate(48000);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -108,6 +117,7 @@ struct TetanusCoil : FaustModule<VCVRackDSP> {
 
         float kickValue = kickPulse.process(args.sampleTime) ? 10.f : 0.f;
         lights[KICK_LIGHT].setBrightness(kickValue > 0.f ? 1.f : 0.f);
+        if (kickValue > 0.f) keepAwake();  // Kick excites the springs without input
 
         // Get parameter values with CV modulation
         float feedbackVal = params[FEEDBACK_PARAM].getValue();
@@ -122,24 +132,24 @@ struct TetanusCoil : FaustModule<VCVRackDSP> {
         }
         gritVal = clamp(gritVal, 0.f, 10.f);
 
-        // Set Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, params[DARKNESS_PARAM].getValue());  // darkness
-        faustDsp.setParamValue(1, feedbackVal);                         // feedback (with CV)
-        faustDsp.setParamValue(2, gritVal);                             // grit (with CV)
-        faustDsp.setParamValue(3, kickValue);                           // kick
-        faustDsp.setParamValue(4, params[TENSION_PARAM].getValue());   // tension
-        faustDsp.setParamValue(5, params[WOBBLE_PARAM].getValue());    // wobble
+        // Set Faust parameters
+        faustDsp.setParamValue(FP::DARKNESS, params[DARKNESS_PARAM].getValue());
+        faustDsp.setParamValue(FP::FEEDBACK, feedbackVal);  // with CV
+        faustDsp.setParamValue(FP::GRIT, gritVal);          // with CV
+        setGateParam(FP::KICK, kickValue);
+        faustDsp.setParamValue(FP::TENSION, params[TENSION_PARAM].getValue());
+        faustDsp.setParamValue(FP::WOBBLE, params[WOBBLE_PARAM].getValue());
 
         // Get audio input (mono to stereo if only one channel)
         float inputL = inputs[AUDIO_INPUT].getVoltage() * 0.2f;  // 5V -> 1.0
         float inputR = inputL;  // Mono input duplicated to stereo
 
-        float* inputPtrs[2] = { &inputL, &inputR };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
+        float frameIn[2] = { inputL, inputR };
+        float frameOut[2] = {};
 
         // Process audio
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        computeFrame(frameIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output (back to VCV voltage range)
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -204,6 +214,14 @@ struct TetanusCoilWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 335), module, TetanusCoil::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<TetanusCoil*>(this->module);
+        if (!m) return;
+        menu->addChild(new MenuSeparator());
+        appendFixedRateMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
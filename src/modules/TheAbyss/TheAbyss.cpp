@@ -8,8 +8,10 @@
 #include "rack.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include "BlockNoise.hpp"
 #define FAUST_MODULE_NAME TheAbyss
-#include "the_abyss.hpp"  // Generated by Faust
+#include "the_abyss_noise_in.hpp"  // Generated by Faust (noise_in entry point)
+#include "the_abyss_noise_in_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +19,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::the_abyss_noise_in;
+
 /**
  * TheAbyss - Waterphone
  *
@@ -51,6 +55,8 @@ struct TheAbyss : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    BlockNoise noise;
+
     TheAbyss() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -69,18 +75,24 @@ struct TheAbyss : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): decay=0, pressure=1, slosh=2, velocity=3, volts=4
-        mapParam(DECAY_PARAM, 0);
-        mapParam(PRESSURE_PARAM, 1);
-        mapParam(SLOSH_PARAM, 2);
-        // velocity=3 handled manually (from gate)
-        mapParam(PITCH_PARAM, 4);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(DECAY_PARAM, FP::DECAY);
+        mapParam(PRESSURE_PARAM, FP::PRESSURE);
+        mapParam(SLOSH_PARAM, FP::SLOSH);
+        // velocity handled manually (from gate)
+        mapParam(PITCH_PARAM, FP::VOLTS);
+
+        // The only input is the rosin noise: the bow gate keeps it awake
+        setSilenceBypass(1.0f);
+        setActivityInputs(0);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -97,6 +109,7 @@ struct TheAbyss : FaustModule<VCVRackDSP> {
         if (inputs[GATE_INPUT].isConnected()) {
             velocity = clamp(inputs[GATE_INPUT].getVoltage() / 10.0f, 0.f, 1.f);
         }
+        if (velocity > 0.f) keepAwake();
 
         // Get water slosh with CV modulation
         float slosh = params[SLOSH_PARAM].getValue();
@@ -109,19 +122,18 @@ struct TheAbyss : FaustModule<VCVRackDSP> {
         float pressure = params[PRESSURE_PARAM].getValue();
         float decay = params[DECAY_PARAM].getValue();
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, decay);      // decay
-        faustDsp.setParamValue(1, pressure);   // pressure
-        faustDsp.setParamValue(2, slosh);      // slosh
-        faustDsp.setParamValue(3, velocity);   // velocity
-        faustDsp.setParamValue(4, volts);      // volts
-
-        // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        // Update Faust parameters
+        faustDsp.setParamValue(FP::DECAY, decay);
+        faustDsp.setParamValue(FP::PRESSURE, pressure);
+        faustDsp.setParamValue(FP::SLOSH, slosh);
+        faustDsp.setParamValue(FP::VELOCITY, velocity);
+        faustDsp.setParamValue(FP::VOLTS, volts);
+
+        // Process audio (rosin noise in, stereo out)
+        float noiseIn = noise.next();
+        float frameOut[2] = {};
+        computeFrame(&noiseIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output - scale appropriately
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -71,13 +71,14 @@ hard_bow = os.sawtooth(bow_freq * 2) : fi.highpass(1, 500) : *(0.3);
 bow_blend = soft_bow * (1 - pressure) + medium_bow * pressure + hard_bow * pressure * pressure;
 
 // Rosin texture - subtle crackling that increases with pressure
-rosin = no.noise : fi.bandpass(2, 800, 3000) : *(0.03 + pressure * 0.05);
+// (white noise from the module's BlockNoise, or no.noise in process)
+rosin(noise) = noise : fi.bandpass(2, 800, 3000) : *(0.03 + pressure * 0.05);
 
 // Amplitude dynamics - bow "catches" and releases
 catch_release = 1 + (no.lfnoise(3) : fi.lowpass(1, 5) : *(0.2 * vel_smooth));
 
 // Final bow signal with all dynamics
-bow_excitation = (bow_blend + rosin) * vel_smooth * effective_pressure * catch_release * 0.4;
+bow_excitation(noise) = (bow_blend + rosin(noise)) * vel_smooth * effective_pressure * catch_release * 0.4;
 
 // ==========================================================
 // 4. THE WATER (Chaotic Hydro-Modulation)
@@ -156,7 +157,7 @@ stereo_spread = _ <: (stereo_left, stereo_right);
 
 // Signal chain: Bow -> Rods -> Bowl -> Output
 // Reduced boost to prevent clipping, added extra limiting
-process = bow_excitation
+waterphone(noise) = bow_excitation(noise)
         : rod_bank
         : bowl_resonator
         : *(0.8)  // Reduced boost to prevent clipping
@@ -164,3 +165,8 @@ process = bow_excitation
         : soft_limit
         : *(0.9)  // Final safety gain
         : stereo_spread;
+
+// The module feeds the rosin noise as the DSP's input (faust -pn noise_in)
+noise_in = waterphone;
+
+process = waterphone(no.noise);
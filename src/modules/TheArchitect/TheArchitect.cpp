@@ -8,7 +8,7 @@
  * Features:
  *   - Global Root (C to B) and Scale (34 scales, including all 12-TET scales from
  *     Ornament & Crime: modes, blues, bebop, exotic/world, jazz symmetric)
- *   - 8 mono V/Oct inputs → 8 quantized outputs
+ *   - 8 poly V/Oct inputs (up to 16 channels each) → 8 quantized outputs
  *   - Chord input → 4-voice poly output (Root, 3rd, 5th, 7th)
  *   - Chord inversions (0-3)
  *   - Transpose control
@@ -17,6 +17,7 @@
 
 #include "rack.hpp"
 #include "ImagePanel.hpp"
+#include "ScaleQuantizer.hpp"
 #include <cmath>
 #include <vector>
 #include <string>
@@ -27,73 +28,12 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
-// Scale definitions - each scale is a 12-bit mask indicating which notes are in the scale.
-// Bit n = 1 if semitone n above the root is in the scale (bit 0 = root).
-// Built via (1 << semitone) so a Major scale [0,2,4,5,7,9,11] is referenced by its intervals
-// rather than a hand-written binary literal (the previous literals had inverted bit order).
-//
-// Scale set covers all 12-TET scales from Ornament & Crime (braids_quantizer_scales) plus
-// common Western/exotic additions.
-static const int SCALES[] = {
-    // --- Diatonic modes ---
-    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 0  Major (Ionian)
-    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 1  Minor (Aeolian)
-    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<10),         // 2  Dorian
-    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 3  Phrygian
-    (1<<0)|(1<<2)|(1<<4)|(1<<6)|(1<<7)|(1<<9)|(1<<11),         // 4  Lydian
-    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<10),         // 5  Mixolydian
-    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<6)|(1<<8)|(1<<10),         // 6  Locrian
-    // --- Minor variants ---
-    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 7  Harmonic Minor
-    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 8  Melodic Minor (asc)
-    (1<<0)|(1<<2)|(1<<3)|(1<<6)|(1<<7)|(1<<8)|(1<<11),         // 9  Hungarian Minor
-    (1<<0)|(1<<2)|(1<<3)|(1<<6)|(1<<7)|(1<<9)|(1<<10),         // 10 Romanian Minor
-    // --- Pentatonic / blues ---
-    (1<<0)|(1<<2)|(1<<4)|(1<<7)|(1<<9),                        // 11 Pentatonic Major
-    (1<<0)|(1<<3)|(1<<5)|(1<<7)|(1<<10),                       // 12 Pentatonic Minor
-    (1<<0)|(1<<2)|(1<<3)|(1<<4)|(1<<7)|(1<<9),                 // 13 Blues Major
-    (1<<0)|(1<<3)|(1<<5)|(1<<6)|(1<<7)|(1<<10),                // 14 Blues Minor
-    // --- Symmetric ---
-    (1<<0)|(1<<2)|(1<<4)|(1<<6)|(1<<8)|(1<<10),                // 15 Whole Tone
-    (1<<0)|(1<<2)|(1<<3)|(1<<5)|(1<<6)|(1<<8)|(1<<9)|(1<<11),  // 16 Diminished (W-H)
-    (1<<0)|(1<<3)|(1<<4)|(1<<7)|(1<<8)|(1<<11),                // 17 Augmented
-    // --- Bebop / jazz ---
-    (1<<0)|(1<<2)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<9)|(1<<11),  // 18 Bebop Major
-    (1<<0)|(1<<2)|(1<<3)|(1<<4)|(1<<5)|(1<<7)|(1<<9)|(1<<10),  // 19 Bebop Dorian
-    // --- O_C exotic / world ---
-    (1<<0)|(1<<1)|(1<<3)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<10),  // 20 Folk
-    (1<<0)|(1<<2)|(1<<3)|(1<<7)|(1<<8),                        // 21 Hirajoshi
-    (1<<0)|(1<<1)|(1<<5)|(1<<7)|(1<<10),                       // 22 In Sen
-    (1<<0)|(1<<1)|(1<<5)|(1<<6)|(1<<10),                       // 23 Iwato
-    (1<<0)|(1<<2)|(1<<3)|(1<<7)|(1<<9),                        // 24 Kumoi
-    (1<<0)|(1<<1)|(1<<3)|(1<<7)|(1<<8),                        // 25 Pelog (Gamelan)
-    (1<<0)|(1<<1)|(1<<3)|(1<<4)|(1<<6)|(1<<8)|(1<<11),         // 26 Gypsy
-    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 27 Arabian (Double Harmonic)
-    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<7)|(1<<8)|(1<<10),         // 28 Flamenco (Phrygian Dom)
-    (1<<0)|(1<<1)|(1<<4)|(1<<5)|(1<<6)|(1<<8)|(1<<11),         // 29 Persian
-    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<8)|(1<<11),         // 30 Neapolitan Minor
-    (1<<0)|(1<<1)|(1<<3)|(1<<5)|(1<<7)|(1<<9)|(1<<11),         // 31 Neapolitan Major
-    (1<<0)|(1<<1)|(1<<4)|(1<<6)|(1<<8)|(1<<10)|(1<<11),        // 32 Enigmatic
-    // --- Catch-all ---
-    0xFFF                                                       // 33 Chromatic
-};
-
-static const std::vector<std::string> SCALE_NAMES = {
-    "Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian", "Locrian",
-    "Harm Min", "Mel Min", "Hung Min", "Rom Min",
-    "Pent Maj", "Pent Min", "Blues Maj", "Blues Min",
-    "Whole", "Dim W-H", "Augment",
-    "Bebop Maj", "Bebop Dor",
-    "Folk", "Hirajoshi", "In Sen", "Iwato", "Kumoi", "Pelog",
-    "Gypsy", "Arabian", "Flamenco", "Persian", "Neap Min", "Neap Maj", "Enigmatic",
-    "Chromatic"
-};
-
 static const std::vector<std::string> NOTE_NAMES = {
     "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
 };
 
-static const int NUM_SCALES = sizeof(SCALES) / sizeof(SCALES[0]);
+// Scale masks are relative to the root (bit 0 = root); see ScaleQuantizer.hpp
+static const int NUM_SCALES = Scales::NUM_SCALES;
 static const int NUM_TRACKS = 8;
 
 struct TheArchitect : Module {
@@ -123,6 +63,25 @@ struct TheArchitect : Module {
         LIGHTS_LEN
     };
 
+    ScaleQuantizer quantizer;
+
+    // Quantized outputs only change when an input crosses a semitone or
+    // the settings change, so each track keeps its last result per group
+    // of four channels and skips the lookup (and the write) otherwise.
+    struct TrackCache {
+        int channels = -1;              // -1 = nothing written yet
+        simd::float_4 semitone[4];
+        simd::float_4 out[4];
+    };
+    TrackCache trackCache[NUM_TRACKS];
+
+    // Chord output depends only on these; -1 = rebuild
+    int chordSemitone = 0;
+    int chordKey = -1;
+    float chordVoltages[4] = {};
+
+    int settingsKey = -1;
+
     TheArchitect() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -130,7 +89,7 @@ struct TheArchitect : Module {
         configSwitch(ROOT_PARAM, 0.f, 11.f, 0.f, "Root", NOTE_NAMES);
 
         // Scale type
-        configSwitch(SCALE_PARAM, 0.f, NUM_SCALES - 1, 0.f, "Scale", SCALE_NAMES);
+        configSwitch(SCALE_PARAM, 0.f, NUM_SCALES - 1, 0.f, "Scale", Scales::names());
 
         // Transpose (-24 to +24 semitones)
         auto* transposeParam = configParam(TRANSPOSE_PARAM, -24.f, 24.f, 0.f, "Transpose", " semitones");
@@ -141,7 +100,7 @@ struct TheArchitect : Module {
 
         // Configure track inputs/outputs
         for (int i = 0; i < NUM_TRACKS; i++) {
-            configInput(TRACK_INPUT + i, "Track " + std::to_string(i + 1) + " V/Oct");
+            configInput(TRACK_INPUT + i, "Track " + std::to_string(i + 1) + " V/Oct (poly)");
             configOutput(TRACK_OUTPUT + i, "Track " + std::to_string(i + 1) + " Quantized");
         }
 
@@ -158,54 +117,6 @@ struct TheArchitect : Module {
         configOutput(SCALE_BUS_OUTPUT, "Scale Bus (16ch poly)");
     }
 
-    // Quantize a chromatic note (0-11) to the nearest note in the scale.
-    // Returns a signed chroma that may fall outside 0-11 when the nearest
-    // in-scale note lies in the adjacent octave (e.g. B wrapping up to the
-    // next C in a sparse scale that omits both B and A#). The caller combines
-    // this with the octave, so the octave shift is carried correctly.
-    int quantizeToScale(int note, int scaleMask, int root) {
-        // Normalize note relative to root
-        int relNote = (note - root + 12) % 12;
-
-        // Check if note is already in scale
-        if ((scaleMask >> relNote) & 1) {
-            return note;
-        }
-
-        // Find nearest note in scale (prefer lower). Return note +/- offset
-        // without wrapping so an upward/downward cross-octave choice keeps
-        // its true pitch instead of collapsing back into the current octave.
-        for (int offset = 1; offset <= 6; offset++) {
-            int lower = (relNote - offset + 12) % 12;
-            int upper = (relNote + offset) % 12;
-
-            if ((scaleMask >> lower) & 1) {
-                return note - offset;
-            }
-            if ((scaleMask >> upper) & 1) {
-                return note + offset;
-            }
-        }
-
-        return note;  // Fallback
-    }
-
-    // Quantize a V/Oct voltage to the scale
-    float quantizeVoltage(float voltage, int root, int scaleMask, int transpose) {
-        // Convert voltage to MIDI note number (0V = C4 = 60)
-        float midiNote = voltage * 12.f + 60.f;
-        int octave = static_cast<int>(std::floor(midiNote / 12.f));
-        int chromaRaw = static_cast<int>(std::round(midiNote)) % 12;
-        int chroma = (chromaRaw + 12) % 12;  // Ensure positive
-
-        // Quantize to scale
-        int quantizedChroma = quantizeToScale(chroma, scaleMask, root);
-
-        // Rebuild voltage
-        float quantizedMidi = octave * 12.f + quantizedChroma + transpose;
-        return (quantizedMidi - 60.f) / 12.f;
-    }
-
     // Find the Nth scale degree above a note, returning the number of
     // semitones ascended (not the wrapped chroma). For short scales a high
     // degree such as the 7th spans more than one octave, so returning the
@@ -237,6 +148,23 @@ struct TheArchitect : Module {
         return rootJ;
     }
 
+    void onReset() override {
+        invalidateCaches();
+    }
+
+    // The engine writes our outputs while bypassed, so the caches no longer
+    // describe what is on them
+    void processBypass(const ProcessArgs& args) override {
+        invalidateCaches();
+        Module::processBypass(args);
+    }
+
+    void invalidateCaches() {
+        for (TrackCache& cache : trackCache) cache.channels = -1;
+        chordKey = -1;
+        settingsKey = -1;
+    }
+
     void fromJson(json_t* rootJ) override {
         // Restore params (and call dataFromJson if a "data" object exists).
         Module::fromJson(rootJ);
@@ -250,21 +178,74 @@ struct TheArchitect : Module {
         if (schema < 1) {
             // Map the original 13-scale index order onto the new 34-scale list.
             // Indices 0-8 are unchanged; only the tail moved.
-            static const int LEGACY_SCALE_REMAP[13] = {
-                0, 1, 2, 3, 4, 5, 6, 7, 8,
-                11,  // Pent Maj  (was 9)
-                12,  // Pent Min  (was 10)
-                15,  // Whole     (was 11)
-                33   // Chromatic (was 12)
-            };
             int oldIdx = static_cast<int>(std::round(params[SCALE_PARAM].getValue()));
             if (oldIdx >= 0 && oldIdx < 13) {
-                params[SCALE_PARAM].setValue(static_cast<float>(LEGACY_SCALE_REMAP[oldIdx]));
+                params[SCALE_PARAM].setValue(static_cast<float>(Scales::LEGACY_13[oldIdx]));
             }
         }
     }
 
-    void process(const ProcessArgs& args) override {
+    void processTrack(int t, bool settingsChanged, float transposeV) {
+        Input& in = inputs[TRACK_INPUT + t];
+        Output& out = outputs[TRACK_OUTPUT + t];
+        TrackCache& cache = trackCache[t];
+
+        int channels = in.isConnected() ? in.getChannels() : 0;
+        if (channels == 0) {
+            if (cache.channels != 0) {
+                out.setChannels(1);
+                out.setVoltage(0.f);
+                cache.channels = 0;
+            }
+            return;
+        }
+
+        bool rebuild = settingsChanged || channels != cache.channels;
+        if (channels != cache.channels) {
+            out.setChannels(channels);
+            cache.channels = channels;
+        }
+
+        for (int c = 0, g = 0; c < channels; c += 4, g++) {
+            simd::float_4 semitone = ScaleQuantizer::semitoneOf(in.getVoltageSimd<simd::float_4>(c));
+            if (!rebuild && simd::movemask(semitone != cache.semitone[g]) == 0) continue;
+            cache.semitone[g] = semitone;
+            cache.out[g] = quantizer.quantizeSemitone(semitone) + transposeV;
+            out.setVoltageSimd(cache.out[g], c);
+        }
+    }
+
+    void buildChord(int semitone, int scaleMask, int root, int transpose, int inversion) {
+        // Quantize root
+        float rootVoltage = quantizer.quantizeSemitone(static_cast<float>(semitone)) + transpose / 12.f;
+
+        // Convert to MIDI for chord building
+        float rootMidi = rootVoltage * 12.f + 60.f;
+        int rootChroma = static_cast<int>(std::round(rootMidi)) % 12;
+        if (rootChroma < 0) rootChroma += 12;
+        int rootOctave = static_cast<int>(std::floor(rootMidi / 12.f));
+
+        // Find chord tones as semitone offsets above the root (root, 3rd,
+        // 5th, 7th). Offsets carry full-octave spans, so chords stay
+        // strictly ascending even for short (e.g. pentatonic) scales.
+        int thirdSemi = findScaleDegree(rootChroma, 2, scaleMask, root);
+        int fifthSemi = findScaleDegree(rootChroma, 4, scaleMask, root);
+        int seventhSemi = findScaleDegree(rootChroma, 6, scaleMask, root);
+
+        // Build chord voltages
+        int rootMidiBase = rootOctave * 12 + rootChroma + transpose;
+        chordVoltages[0] = (rootMidiBase - 60.f) / 12.f;
+        chordVoltages[1] = (rootMidiBase + thirdSemi - 60.f) / 12.f;
+        chordVoltages[2] = (rootMidiBase + fifthSemi - 60.f) / 12.f;
+        chordVoltages[3] = (rootMidiBase + seventhSemi - 60.f) / 12.f;
+
+        // Apply inversions
+        if (inversion >= 1) chordVoltages[0] += 1.f;  // Root up an octave
+        if (inversion >= 2) chordVoltages[1] += 1.f;  // 3rd up an octave
+        if (inversion >= 3) chordVoltages[2] += 1.f;  // 5th up an octave
+    }
+
+    void process(const ProcessArgs&) override {
         // Get root with CV modulation
         int root = static_cast<int>(params[ROOT_PARAM].getValue());
         if (inputs[ROOT_CV_INPUT].isConnected()) {
@@ -278,7 +259,8 @@ struct TheArchitect : Module {
             scaleIdx += static_cast<int>(inputs[SCALE_CV_INPUT].getVoltage() * (NUM_SCALES * 0.1f));
         }
         scaleIdx = clamp(scaleIdx, 0, NUM_SCALES - 1);
-        int scaleMask = SCALES[scaleIdx];
+        int scaleMask = Scales::MASKS[scaleIdx];
+        quantizer.setScale(scaleMask, root);
 
         // Get transpose
         int transpose = static_cast<int>(params[TRANSPOSE_PARAM].getValue());
@@ -297,55 +279,33 @@ struct TheArchitect : Module {
             lights[SCALE_LIGHT + i].setBrightness(inScale ? 1.f : 0.1f);
         }
 
-        // Process 8 quantizer tracks
-        for (int i = 0; i < NUM_TRACKS; i++) {
-            if (inputs[TRACK_INPUT + i].isConnected()) {
-                float inVoltage = inputs[TRACK_INPUT + i].getVoltage();
-                float outVoltage = quantizeVoltage(inVoltage, root, scaleMask, transpose);
-                outputs[TRACK_OUTPUT + i].setVoltage(outVoltage);
-            } else {
-                outputs[TRACK_OUTPUT + i].setVoltage(0.f);
-            }
+        // Anything that changes every quantized value
+        int key = scaleMask | (root << 12) | ((transpose + 24) << 16);
+        bool settingsChanged = key != settingsKey;
+        settingsKey = key;
+
+        // Process 8 poly quantizer tracks, four channels at a time
+        float transposeV = transpose / 12.f;
+        for (int t = 0; t < NUM_TRACKS; t++) {
+            processTrack(t, settingsChanged, transposeV);
         }
 
         // Process chord generator
         if (inputs[CHORD_INPUT].isConnected()) {
             float chordIn = inputs[CHORD_INPUT].getVoltage();
-
-            // Quantize root
-            float rootVoltage = quantizeVoltage(chordIn, root, scaleMask, transpose);
-
-            // Convert to MIDI for chord building
-            float rootMidi = rootVoltage * 12.f + 60.f;
-            int rootChroma = static_cast<int>(std::round(rootMidi)) % 12;
-            if (rootChroma < 0) rootChroma += 12;
-            int rootOctave = static_cast<int>(std::floor(rootMidi / 12.f));
-
-            // Find chord tones as semitone offsets above the root (root, 3rd,
-            // 5th, 7th). Offsets carry full-octave spans, so chords stay
-            // strictly ascending even for short (e.g. pentatonic) scales.
-            int thirdSemi = findScaleDegree(rootChroma, 2, scaleMask, root);
-            int fifthSemi = findScaleDegree(rootChroma, 4, scaleMask, root);
-            int seventhSemi = findScaleDegree(rootChroma, 6, scaleMask, root);
-
-            // Build chord voltages
-            int rootMidiBase = rootOctave * 12 + rootChroma + transpose;
-            float v1 = (rootMidiBase - 60.f) / 12.f;
-            float v2 = (rootMidiBase + thirdSemi - 60.f) / 12.f;
-            float v3 = (rootMidiBase + fifthSemi - 60.f) / 12.f;
-            float v4 = (rootMidiBase + seventhSemi - 60.f) / 12.f;
-
-            // Apply inversions
-            if (inversion >= 1) v1 += 1.f;  // Root up an octave
-            if (inversion >= 2) v2 += 1.f;  // 3rd up an octave
-            if (inversion >= 3) v3 += 1.f;  // 5th up an octave
+            int semitone = static_cast<int>(ScaleQuantizer::semitoneOf(chordIn));
+            int chordState = key | (inversion << 22);
+            if (semitone != chordSemitone || chordState != chordKey) {
+                chordSemitone = semitone;
+                chordKey = chordState;
+                buildChord(semitone, scaleMask, root, transpose, inversion);
+            }
 
             // Output as 4-channel poly
             outputs[CHORD_OUTPUT].setChannels(4);
-            outputs[CHORD_OUTPUT].setVoltage(v1, 0);
-            outputs[CHORD_OUTPUT].setVoltage(v2, 1);
-            outputs[CHORD_OUTPUT].setVoltage(v3, 2);
-            outputs[CHORD_OUTPUT].setVoltage(v4, 3);
+            for (int v = 0; v < 4; v++) {
+                outputs[CHORD_OUTPUT].setVoltage(chordVoltages[v], v);
+            }
         } else {
             outputs[CHORD_OUTPUT].setChannels(0);
         }
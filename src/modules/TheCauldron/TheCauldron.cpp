@@ -20,6 +20,7 @@
 #include "FaustModule.hpp"
 #define FAUST_MODULE_NAME TheCauldron
 #include "the_cauldron.hpp"  // Generated by Faust
+#include "the_cauldron_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -27,6 +28,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::the_cauldron;
+
 // Mode names for display
 static const std::vector<std::string> MODE_LABELS = {
     "Mix", "Ring", "Peaks", "Valleys", "Diff", "Fold", "Morph"
@@ -108,15 +111,19 @@ struct TheCauldron : FaustModule<VCVRackDSP> {
         configOutput(MAIN_OUTPUT, "Main");
         configOutput(INV_OUTPUT, "Inverted");
 
-        // Faust params (alphabetical order): drive=0, mode=1, speed=2
-        // These are set dynamically in process(), not mapped directly
-        mapParam(MODE_PARAM, 1);
+        // Drive and speed are set dynamically in process(), not mapped directly
+        mapParam(MODE_PARAM, FP::MODE);
+
+        // Fold mode is a tanh(sin()) folder
+        enableOversampling();
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -158,10 +165,10 @@ struct TheCauldron : FaustModule<VCVRackDSP> {
         // For Fold mode, use rate as drive intensity (1-5)
         float drive = 1.0f + (rateIndex / (float)(RATE_VALUES.size() - 1)) * 4.0f;
 
-        // Update Faust parameters (alphabetical: drive=0, mode=1, speed=2)
-        faustDsp.setParamValue(0, drive);
-        faustDsp.setParamValue(1, static_cast<float>(modeInt));
-        faustDsp.setParamValue(2, speed);
+        // Update Faust parameters
+        faustDsp.setParamValue(FP::DRIVE, drive);
+        faustDsp.setParamValue(FP::MODE, static_cast<float>(modeInt));
+        faustDsp.setParamValue(FP::SPEED, speed);
 
         // Get inputs (scale from ±5V to ±1.0 for cleaner math)
         float a = inputs[IN_A].getVoltage() * 0.2f;
@@ -171,10 +178,8 @@ struct TheCauldron : FaustModule<VCVRackDSP> {
 
         // Process through Faust
         float output = 0.0f;
-        float* inputPtrs[4] = { &a, &b, &c, &d };
-        float* outputPtrs[1] = { &output };
-
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        float frameIn[4] = { a, b, c, d };
+        computeFrame(frameIn, &output);
 
         // Scale output back to modular level (±5V)
         float outVoltage = output * 5.0f;
@@ -332,6 +337,14 @@ struct TheCauldronWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             mm2px(Vec(30, 116)), module, TheCauldron::INV_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<TheCauldron*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        appendOversamplingMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
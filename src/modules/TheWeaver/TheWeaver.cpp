@@ -14,6 +14,7 @@
 
 #include "rack.hpp"
 #include "ImagePanel.hpp"
+#include "ScaleQuantizer.hpp"
 #include <algorithm>
 #include <array>
 #include <random>
@@ -143,14 +144,21 @@ struct TheWeaver : Module {
     std::vector<float> inputScratch;     // raw captured input channels
     std::vector<float> baseScratch;      // sorted/unique base for octave spread
 
+    // The pools only change with the held notes or these settings, so they
+    // are rebuilt on change rather than every sample. -1 = rebuild.
+    int poolKey = -1;                    // scale mask/root/bus + octave spread
+    bool scaleRunDirty = true;           // scaleRunPool lags sortedPool
+
     // ---- Scale bus state ----------------------------------------------------
     int scaleMask = 0xFFF;   // chromatic fallback (all 12 active)
     int scaleRoot = 0;       // 0 = C
     bool scaleBusActive = false;
+    ScaleQuantizer quantizer;   // follows scaleMask (absolute, root 0)
 
     // ---- Held notes (for Hold/Latch) ----------------------------------------
     std::vector<float> heldNotes;         // raw V/Oct, in poly-channel order
     bool hadActiveInput = false;
+    bool heldFromInput = false;           // false = auto-triad (or empty)
 
     // ---- Last output values -------------------------------------------------
     float lastCv = 0.f;
@@ -225,6 +233,7 @@ struct TheWeaver : Module {
 
         scaleMask = mask;
         scaleBusActive = true;
+        quantizer.setScale(scaleMask);
 
         if (ch >= 16) {
             float rootV = inputs[SCALE_BUS_INPUT].getVoltage(15);
@@ -236,31 +245,10 @@ struct TheWeaver : Module {
 
     // Quantize a V/Oct voltage to the nearest chroma active in `scaleMask`.
     // The mask uses absolute chromatic positions (bit 0 = C, bit 1 = C#, ...).
+    // With no scale on the bus, notes pass through unrounded.
     float quantizeToScale(float voltage) const {
         if (scaleMask == 0xFFF) return voltage;
-
-        float midi = voltage * 12.f + 60.f;
-        int octave = static_cast<int>(std::floor(midi / 12.f));
-        int chroma = static_cast<int>(std::round(midi)) - octave * 12;
-        if (chroma < 0) { chroma += 12; octave -= 1; }
-        if (chroma > 11) { chroma -= 12; octave += 1; }
-
-        if ((scaleMask >> chroma) & 1) {
-            return ((float)(octave * 12 + chroma) - 60.f) / 12.f;
-        }
-        for (int offset = 1; offset <= 6; offset++) {
-            int lo = (chroma - offset + 12) % 12;
-            int hi = (chroma + offset) % 12;
-            if ((scaleMask >> lo) & 1) {
-                int n = octave * 12 + chroma - offset;
-                return ((float)n - 60.f) / 12.f;
-            }
-            if ((scaleMask >> hi) & 1) {
-                int n = octave * 12 + chroma + offset;
-                return ((float)n - 60.f) / 12.f;
-            }
-        }
-        return voltage;
+        return quantizer.quantize(voltage);
     }
 
     // ------------------------------------------------------------------------
@@ -290,10 +278,12 @@ struct TheWeaver : Module {
     }
 
     // Build orderPool (raw poly-channel order) and sortedPool (ascending,
-    // octave-spread, scale-quantized).
+    // octave-spread, scale-quantized). The input is compared against the held
+    // notes every sample; quantizing, sorting and spreading only happen when
+    // the notes, the scale bus or the octave spread actually change.
     void buildPools(int octaveSpread, bool hold) {
-        orderPool.clear();
-        sortedPool.clear();
+        int key = scaleMask | (scaleRoot << 12) | (octaveSpread << 16) | ((int)scaleBusActive << 20);
+        bool settingsChanged = key != poolKey;
 
         // Detect note presence from the input's *channel count*, never from the
         // pitch value. 0 V is a valid note (C in V/Oct), so filtering on
@@ -310,22 +300,36 @@ struct TheWeaver : Module {
             }
         }
         bool inputHasNotes = !inputScratch.empty();
+        bool notesChanged = false;
 
         if (inputHasNotes) {
-            heldNotes = inputScratch;  // capacity-reserved: no realloc
+            if (!heldFromInput || heldNotes != inputScratch) {
+                heldNotes = inputScratch;  // capacity-reserved: no realloc
+                notesChanged = true;
+            }
+            heldFromInput = true;
             hadActiveInput = true;
-        }
-
-        if (!inputHasNotes && hold && hadActiveInput && !heldNotes.empty()) {
+        } else if (hold && hadActiveInput && !heldNotes.empty()) {
             // Notes released while Hold is engaged: latch the previous chord.
-        } else if (!inputHasNotes) {
-            heldNotes.clear();
-            hadActiveInput = false;
-            if (scaleBusActive) {
-                generateAutoTriad(heldNotes);
+        } else {
+            // The auto-triad only depends on the scale bus (part of the key)
+            if (heldFromInput || settingsChanged) {
+                heldNotes.clear();
+                if (scaleBusActive) {
+                    generateAutoTriad(heldNotes);
+                }
+                notesChanged = true;
             }
+            heldFromInput = false;
+            hadActiveInput = false;
         }
 
+        if (!notesChanged && !settingsChanged) return;
+        poolKey = key;
+        scaleRunDirty = true;
+
+        orderPool.clear();
+        sortedPool.clear();
         if (heldNotes.empty()) return;
 
         // Order-played pool (raw, quantized)
@@ -380,7 +384,10 @@ struct TheWeaver : Module {
     const std::vector<float>& activePool(int pattern) {
         if (pattern == PATTERN_ORDER_PLAYED && !orderPool.empty()) return orderPool;
         if (pattern == PATTERN_SCALE_RUN) {
-            buildScaleRunPool();
+            if (scaleRunDirty) {
+                buildScaleRunPool();
+                scaleRunDirty = false;
+            }
             return scaleRunPool;
         }
         return sortedPool;
@@ -788,6 +795,8 @@ struct TheWeaver : Module {
         }
         json_t* hadJ = json_object_get(rootJ, "hadActiveInput");
         if (hadJ) hadActiveInput = json_boolean_value(hadJ);
+        heldFromInput = hadActiveInput;
+        poolKey = -1;
     }
 };
 
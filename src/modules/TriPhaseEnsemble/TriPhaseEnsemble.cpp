@@ -6,10 +6,13 @@
  ******************************************************************************/
 
 #include "rack.hpp"
+#include "EnsembleBank.hpp"
 #include "FaustModule.hpp"
 #include "ImagePanel.hpp"
+#include <algorithm>
 #define FAUST_MODULE_NAME TriPhaseEnsemble
 #include "tri_phase_ensemble.hpp"  // Generated by Faust
+#include "tri_phase_ensemble_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -17,6 +20,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::tri_phase_ensemble;
+
 /**
  * TriPhaseEnsemble - Classic String Ensemble Effect
  *
@@ -26,6 +31,12 @@ namespace WiggleRoom {
  * Inputs:
  *   - L/R: Audio input (summed to mono internally)
  *
+ * Polyphonic cables (up to 16 channels) run each channel through its own
+ * ensemble in C++ (EnsembleBank, four channels per float_4) and give poly
+ * L/R outputs, so every voice keeps its stereo spread. The three-phase
+ * LFO and the delay taps are computed once and shared by all channels.
+ * Mono cables use the Faust DSP.
+ *
  * Parameters:
  *   - Depth: Modulation intensity
  *   - Rate: LFO speed scaling
@@ -55,6 +66,12 @@ struct TriPhaseEnsemble : FaustModule<VCVRackDSP> {
         LIGHTS_LEN
     };
 
+    static constexpr int SMOOTH_INTERVAL = 16;
+
+    EnsembleBank ensemble;
+    int smoothCounter = 0;
+    bool polyActive = false;
+
     TriPhaseEnsemble() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -73,17 +90,79 @@ struct TriPhaseEnsemble : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust params (alphabetical): depth=0, mix=1, rate=2, tone=3
-        mapParam(DEPTH_PARAM, 0);
-        mapParam(MIX_PARAM, 1);
-        mapParam(RATE_PARAM, 2);
-        mapParam(TONE_PARAM, 3);
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(DEPTH_PARAM, FP::DEPTH);
+        mapParam(MIX_PARAM, FP::MIX);
+        mapParam(RATE_PARAM, FP::RATE);
+        mapParam(TONE_PARAM, FP::TONE);
+    }
+
+    // Poly channels restart from the current controls
+    void resetEnsemble() {
+        ensemble.reset();
+        smoothCounter = 0;
+    }
+
+    // Shared controls and per-channel mix, the same mapping as the Faust path
+    void updateEnsemble(float sampleRate) {
+        ensemble.setSampleRate(sampleRate);
+        ensemble.setControls(params[DEPTH_PARAM].getValue(), params[RATE_PARAM].getValue(),
+            params[TONE_PARAM].getValue(), SMOOTH_INTERVAL);
+
+        float mixParam = params[MIX_PARAM].getValue();
+        Input& mixCV = inputs[MIX_CV_INPUT];
+        for (int g = 0; g < ensemble.getGroupCount(); g++) {
+            simd::float_4 mix = mixParam;
+            if (mixCV.isConnected()) {
+                mix += mixCV.getPolyVoltageSimd<simd::float_4>(g * 4) * 0.1f;  // ±10V = ±1.0
+            }
+            ensemble.setMix(g, simd::clamp(mix, 0.f, 1.f), SMOOTH_INTERVAL);
+        }
+    }
+
+    void processPoly(const ProcessArgs& args, int channels) {
+        WR_PROFILE_SCOPE(profile, "process");
+        polyActive = true;
+        ensemble.setChannelCount(channels);
+        if (--smoothCounter <= 0) {
+            smoothCounter = SMOOTH_INTERVAL;
+            updateEnsemble(args.sampleRate);
+        }
+
+        ScopedFlushDenormals noDenormals;
+        Input& inL = inputs[LEFT_INPUT];
+        Input& inR = inputs[RIGHT_INPUT];
+        bool stereoIn = inR.isConnected();
+        ensemble.tick();
+        for (int g = 0; g < ensemble.getGroupCount(); g++) {
+            int c = g * 4;
+            simd::float_4 left = inL.getPolyVoltageSimd<simd::float_4>(c);
+            simd::float_4 right = stereoIn ? inR.getPolyVoltageSimd<simd::float_4>(c) : left;
+            simd::float_4 outL, outR;
+            ensemble.process(g, (left + right) * 0.5f, outL, outR);
+            outputs[LEFT_OUTPUT].setVoltageSimd(outL, c);
+            outputs[RIGHT_OUTPUT].setVoltageSimd(outR, c);
+        }
+        outputs[LEFT_OUTPUT].setChannels(channels);
+        outputs[RIGHT_OUTPUT].setChannels(channels);
     }
 
     void process(const ProcessArgs& args) override {
+        int channels = std::max(inputs[LEFT_INPUT].getChannels(), inputs[RIGHT_INPUT].getChannels());
+        if (channels > 1) {
+            processPoly(args, channels);
+            return;
+        }
+        if (polyActive) {
+            resetEnsemble();
+            polyActive = false;
+        }
+
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -99,11 +178,11 @@ struct TriPhaseEnsemble : FaustModule<VCVRackDSP> {
         }
         mix = clamp(mix, 0.f, 1.f);
 
-        // Update Faust parameters (alphabetical order)
-        faustDsp.setParamValue(0, depth);  // depth
-        faustDsp.setParamValue(1, mix);    // mix
-        faustDsp.setParamValue(2, rate);   // rate
-        faustDsp.setParamValue(3, tone);   // tone
+        // Update Faust parameters
+        faustDsp.setParamValue(FP::DEPTH, depth);
+        faustDsp.setParamValue(FP::MIX, mix);
+        faustDsp.setParamValue(FP::RATE, rate);
+        faustDsp.setParamValue(FP::TONE, tone);
 
         // Get audio input (sum to mono)
         float inL = inputs[LEFT_INPUT].getVoltage();
@@ -111,16 +190,21 @@ struct TriPhaseEnsemble : FaustModule<VCVRackDSP> {
         float monoIn = (inL + inR) * 0.5f;
 
         // Process audio
-        float outputL = 0.0f, outputR = 0.0f;
-        float* inputPtrs[1] = { &monoIn };
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, inputPtrs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(&monoIn, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output
+        outputs[LEFT_OUTPUT].setChannels(1);
+        outputs[RIGHT_OUTPUT].setChannels(1);
         outputs[LEFT_OUTPUT].setVoltage(outputL);
         outputs[RIGHT_OUTPUT].setVoltage(outputR);
     }
+
+    void onReset() override {
+        FaustModule::onReset();
+        resetEnsemble();
+    }
 };
 
 struct TriPhaseEnsembleWidget : ModuleWidget {
@@ -170,6 +254,13 @@ struct TriPhaseEnsembleWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(
             Vec(xRight, 320), module, TriPhaseEnsemble::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        auto* m = dynamic_cast<TriPhaseEnsemble*>(this->module);
+        if (!m) return;
+        appendBlockSizeMenu(menu, m);
+        WR_PROFILE_MENU(menu, m);
+    }
 };
 
 } // namespace WiggleRoom
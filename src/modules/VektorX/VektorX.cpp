@@ -11,6 +11,7 @@
 #include "ImagePanel.hpp"
 #define FAUST_MODULE_NAME VektorX
 #include "vektorx.hpp"  // Generated by Faust
+#include "vektorx_params.hpp"  // Faust parameter indices
 
 using namespace rack;
 
@@ -18,6 +19,8 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+namespace FP = FaustParams::vektorx;
+
 /**
  * VektorX - Complex Drone Synthesizer (inspired by Forge TME VHIKK X)
  *
@@ -100,30 +103,29 @@ struct VektorX : FaustModule<VCVRackDSP> {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Faust parameter mapping (alphabetical order from vektorx.dsp):
-        // 0=algorithm, 1=decay, 2=delay_mix, 3=drive, 4=field,
-        // 5=gate, 6=morph, 7=resonance, 8=spread, 9=tilt,
-        // 10=vca, 11=volts, 12=warp, 13=width
-        mapParam(ALGORITHM_PARAM, 0);   // algorithm
-        mapParam(DECAY_PARAM, 1);       // decay
-        mapParam(DELAY_MIX_PARAM, 2);   // delay_mix
-        mapParam(DRIVE_PARAM, 3);       // drive
-        mapParam(FIELD_PARAM, 4);       // field
-        // gate (5) - handled manually
-        mapParam(MORPH_PARAM, 6);       // morph
-        mapParam(RESONANCE_PARAM, 7);   // resonance
-        mapParam(SPREAD_PARAM, 8);      // spread
-        mapParam(TILT_PARAM, 9);        // tilt
-        mapParam(VCA_PARAM, 10);        // vca
-        // volts (11) - handled manually
-        mapParam(WARP_PARAM, 12);       // warp
-        mapParam(WIDTH_PARAM, 13);      // width
+        // Map VCV parameters to Faust DSP parameters
+        mapParam(ALGORITHM_PARAM, FP::ALGORITHM);
+        mapParam(DECAY_PARAM, FP::DECAY);
+        mapParam(DELAY_MIX_PARAM, FP::DELAY_MIX);
+        mapParam(DRIVE_PARAM, FP::DRIVE);
+        mapParam(FIELD_PARAM, FP::FIELD);
+        // gate - handled manually
+        mapParam(MORPH_PARAM, FP::MORPH);
+        mapParam(RESONANCE_PARAM, FP::RESONANCE);
+        mapParam(SPREAD_PARAM, FP::SPREAD);
+        mapParam(TILT_PARAM, FP::TILT);
+        mapParam(VCA_PARAM, FP::VCA);
+        // volts - handled manually
+        mapParam(WARP_PARAM, FP::WARP);
+        mapParam(WIDTH_PARAM, FP::WIDTH);
     }
 
     void process(const ProcessArgs& args) override {
+        WR_PROFILE_SCOPE(profile, "process");
+
         // Initialize DSP on first run
         if (!initialized) {
-            faustDsp.init(static_cast<int>(args.sampleRate));
+            initDsp(args.sampleRate);
             initialized = true;
         }
 
@@ -132,18 +134,18 @@ struct VektorX : FaustModule<VCVRackDSP> {
 
         // Get V/Oct input
         float voct = inputs[VOCT_INPUT].getVoltage();
-        faustDsp.setParamValue(11, voct);  // volts
+        faustDsp.setParamValue(FP::VOLTS, voct);
 
         // Get Gate input
         float gate = inputs[GATE_INPUT].getVoltage();
-        faustDsp.setParamValue(5, gate);   // gate
+        faustDsp.setParamValue(FP::GATE, gate);
 
         // Apply CV modulation to morph
         if (inputs[MORPH_CV_INPUT].isConnected()) {
             float morph = params[MORPH_PARAM].getValue();
             morph += inputs[MORPH_CV_INPUT].getVoltage() * 0.1f;  // +10V = +1.0
             morph = clamp(morph, 0.f, 1.f);
-            faustDsp.setParamValue(6, morph);
+            faustDsp.setParamValue(FP::MORPH, morph);
         }
 
         // Apply CV modulation to spread
@@ -151,7 +153,7 @@ struct VektorX : FaustModule<VCVRackDSP> {
             float spread = params[SPREAD_PARAM].getValue();
             spread += inputs[SPREAD_CV_INPUT].getVoltage() * 0.1f;
             spread = clamp(spread, 0.f, 1.f);
-            faustDsp.setParamValue(8, spread);
+            faustDsp.setParamValue(FP::SPREAD, spread);
         }
 
         // Apply CV modulation to field (V/Oct style)
@@ -160,7 +162,7 @@ struct VektorX : FaustModule<VCVRackDSP> {
             float cvVoltage = inputs[FIELD_CV_INPUT].getVoltage();
             field *= std::pow(2.f, cvVoltage);  // V/Oct
             field = clamp(field, 20.f, 20000.f);
-            faustDsp.setParamValue(4, field);
+            faustDsp.setParamValue(FP::FIELD, field);
         }
 
         // Apply CV modulation to VCA (cascades to other params)
@@ -170,7 +172,7 @@ struct VektorX : FaustModule<VCVRackDSP> {
             // VCA level
             float vca = params[VCA_PARAM].getValue() + vcaCV;
             vca = clamp(vca, 0.f, 1.f);
-            faustDsp.setParamValue(10, vca);
+            faustDsp.setParamValue(FP::VCA, vca);
 
             // CV normalling: modulate other params slightly when VCA CV is connected
             float scaledCV = vcaCV * 0.3f;  // Reduced amount for subtle modulation
@@ -179,14 +181,14 @@ struct VektorX : FaustModule<VCVRackDSP> {
             if (!inputs[MORPH_CV_INPUT].isConnected()) {
                 float morph = params[MORPH_PARAM].getValue() + scaledCV;
                 morph = clamp(morph, 0.f, 1.f);
-                faustDsp.setParamValue(6, morph);
+                faustDsp.setParamValue(FP::MORPH, morph);
             }
 
             // Spread modulation (if no dedicated CV)
             if (!inputs[SPREAD_CV_INPUT].isConnected()) {
                 float spread = params[SPREAD_PARAM].getValue() + scaledCV;
                 spread = clamp(spread, 0.f, 1.f);
-                faustDsp.setParamValue(8, spread);
+                faustDsp.setParamValue(FP::SPREAD, spread);
             }
 
             // Field modulation (if no dedicated CV)
@@ -194,16 +196,14 @@ struct VektorX : FaustModule<VCVRackDSP> {
                 float field = params[FIELD_PARAM].getValue();
                 field *= std::pow(2.f, scaledCV * 2.f);  // Subtle V/Oct modulation
                 field = clamp(field, 20.f, 20000.f);
-                faustDsp.setParamValue(4, field);
+                faustDsp.setParamValue(FP::FIELD, field);
             }
         }
 
         // Process audio (no input, stereo output)
-        float* nullInputs[1] = { nullptr };
-        float outputL = 0.0f, outputR = 0.0f;
-        float* outputPtrs[2] = { &outputL, &outputR };
-
-        faustDsp.compute(1, nullInputs, outputPtrs);
+        float frameOut[2] = {};
+        computeFrame(nullptr, frameOut);
+        float outputL = frameOut[0], outputR = frameOut[1];
 
         // Output at 5V peak
         outputs[LEFT_OUTPUT].setVoltage(outputL * 5.0f);
@@ -1,5 +1,6 @@
 #include "rack.hpp"
 #include "ImagePanel.hpp"
+#include <algorithm>
 
 using namespace rack;
 
@@ -7,6 +8,14 @@ extern Plugin* pluginInstance;
 
 namespace WiggleRoom {
 
+/**
+ * CV crossfader / ring mod / folder
+ *
+ * Polyphonic: the output has as many channels as the widest of A, B and CV,
+ * and a mono input applies to every channel. Channels are processed four at
+ * a time in float_4, so one instance replaces a row of mono XFades for
+ * per-voice morphing.
+ */
 struct XFade : Module {
     enum ParamId {
         XFADE_PARAM,
@@ -50,71 +59,73 @@ struct XFade : Module {
         configOutput(OUT_OUTPUT, "Output");
     }
 
-    // Fold signal into ±limit range
-    float fold(float x, float limit) {
-        if (limit <= 0.f) return 0.f;
-
+    // Fold signal into ±limit range (limit > 0)
+    static simd::float_4 fold(simd::float_4 x, simd::float_4 limit) {
         // Normalize to ±1 range relative to limit
         x = x / limit;
 
         // Fold using triangle wave function
-        // This maps any value into -1 to 1 range
-        x = std::fmod(x + 1.f, 4.f);
-        if (x < 0.f) x += 4.f;
-        if (x < 2.f) {
-            x = x - 1.f;
-        } else {
-            x = 3.f - x;
-        }
+        // This maps any value into -1 to 1 range; floor() keeps the
+        // wrap into [0, 4) branch-free where fmod would need a sign fix
+        x = x + 1.f;
+        x = x - 4.f * simd::floor(x * 0.25f);
+        x = simd::ifelse(x < 2.f, x - 1.f, 3.f - x);
 
         return x * limit;
     }
 
     void process(const ProcessArgs& args) override {
-        float inA = inputs[IN_A_INPUT].getVoltage();
-        float inB = inputs[IN_B_INPUT].getVoltage();
-
-        // Get knob + CV
-        float knob = params[XFADE_PARAM].getValue();
-        if (inputs[XFADE_CV_INPUT].isConnected()) {
-            float cv = inputs[XFADE_CV_INPUT].getVoltage() / 10.f;
-            float cvAmt = params[XFADE_CV_AMT_PARAM].getValue();
-            knob += cv * cvAmt;
-        }
-        knob = clamp(knob, 0.f, 1.f);
-
+        Input& inA = inputs[IN_A_INPUT];
+        Input& inB = inputs[IN_B_INPUT];
+        Input& cvIn = inputs[XFADE_CV_INPUT];
+        int channels = std::max({inA.getChannels(), inB.getChannels(), cvIn.getChannels(), 1});
+
+        float knobParam = params[XFADE_PARAM].getValue();
+        float cvAmt = params[XFADE_CV_AMT_PARAM].getValue();
+        bool cvConnected = cvIn.isConnected();
         int mode = static_cast<int>(params[MODE_PARAM].getValue());
-        float out = 0.f;
-
-        switch (mode) {
-            case MODE_XFADE:
-                // Linear crossfade: A * (1-x) + B * x
-                out = inA * (1.f - knob) + inB * knob;
-                break;
-
-            case MODE_RING:
-                // Ring mod: A * B, normalized so ±5V * ±5V = ±5V
-                // Knob controls output level
-                out = (inA * inB / 5.f) * (knob * 2.f);  // knob 0.5 = unity
-                break;
-
-            case MODE_FOLD:
-                // Sum A + B, then fold within threshold
-                // Knob controls fold threshold: 0.1 = tight fold, 1.0 = 10V (no fold)
-                {
-                    float sum = inA + inB;
-                    float threshold = 1.f + knob * 9.f;  // 1V to 10V
-                    out = fold(sum, threshold);
-                }
-                break;
+        float offset = params[OFFSET_PARAM].getValue() > 0.5f ? 5.f : 0.f;
+
+        for (int c = 0; c < channels; c += 4) {
+            simd::float_4 a = inA.getPolyVoltageSimd<simd::float_4>(c);
+            simd::float_4 b = inB.getPolyVoltageSimd<simd::float_4>(c);
+
+            // Get knob + CV
+            simd::float_4 knob = knobParam;
+            if (cvConnected) {
+                simd::float_4 cv = cvIn.getPolyVoltageSimd<simd::float_4>(c) / 10.f;
+                knob += cv * cvAmt;
+            }
+            knob = simd::clamp(knob, 0.f, 1.f);
+
+            simd::float_4 out = 0.f;
+
+            switch (mode) {
+                case MODE_XFADE:
+                    // Linear crossfade: A * (1-x) + B * x
+                    out = a * (1.f - knob) + b * knob;
+                    break;
+
+                case MODE_RING:
+                    // Ring mod: A * B, normalized so ±5V * ±5V = ±5V
+                    // Knob controls output level
+                    out = (a * b / 5.f) * (knob * 2.f);  // knob 0.5 = unity
+                    break;
+
+                case MODE_FOLD:
+                    // Sum A + B, then fold within threshold
+                    // Knob controls fold threshold: 0.1 = tight fold, 1.0 = 10V (no fold)
+                    {
+                        simd::float_4 threshold = 1.f + knob * 9.f;  // 1V to 10V
+                        out = fold(a + b, threshold);
+                    }
+                    break;
+            }
+
+            // Apply +5V offset if enabled
+            outputs[OUT_OUTPUT].setVoltageSimd(out + offset, c);
         }
-
-        // Apply +5V offset if enabled
-        if (params[OFFSET_PARAM].getValue() > 0.5f) {
-            out += 5.f;
-        }
-
-        outputs[OUT_OUTPUT].setVoltage(out);
+        outputs[OUT_OUTPUT].setChannels(channels);
     }
 };
 
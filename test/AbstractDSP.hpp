@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 /**
  * Abstract interface for Faust DSP modules
  *
@@ -20,4 +24,36 @@ public:
     virtual float getParamMax(int index) const = 0;
     virtual float getParamInit(int index) const = 0;
     virtual int getParamIndex(const char* name) const = 0;
+
+    // Full state as a flat copy (see VCVRackDSP in faust/vcvrack.cpp): restore
+    // only into an instance of the same DSP initialized at the same rate
+    virtual size_t getStateSize() const = 0;
+    virtual void saveState(void* buffer) const = 0;
+    virtual void restoreState(const void* buffer) = 0;
+};
+
+/**
+ * Saved DSP state to fork renders from
+ *
+ * Warm a DSP up once, take() it, then restore() into any number of
+ * instances of the same module (on any thread) instead of rendering the
+ * warm-up again for each of them.
+ */
+struct DSPSnapshot {
+    std::vector<uint8_t> state;
+    int sampleRate = 0;
+
+    bool empty() const { return state.empty(); }
+
+    void take(const AbstractDSP& dsp, int rate) {
+        state.resize(dsp.getStateSize());
+        dsp.saveState(state.data());
+        sampleRate = rate;
+    }
+
+    // Re-inits `dsp` at the snapshot's rate (class tables), then copies the state in
+    void restore(AbstractDSP& dsp) const {
+        dsp.init(sampleRate);
+        dsp.restoreState(state.data());
+    }
 };
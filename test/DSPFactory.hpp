@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * Module registry shared by the test tools (faust_render, faust_bench)
+ *
+ * The createXxx() factories are defined in dsp_wrappers.cpp; the name
+ * lookup and test-config loading live in dsp_factory.cpp.
+ *
+ * Components are single libraries or effect units of a module, compiled
+ * on their own for benchmarking (e.g. "VektorX/dungeon"). createDSP()
+ * accepts their names as well.
+ */
+
+#include "AbstractDSP.hpp"
+#include "ModuleTestConfig.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Factory functions (one per Faust module, defined in dsp_wrappers.cpp)
+std::unique_ptr<AbstractDSP> createLadderLPF();
+std::unique_ptr<AbstractDSP> createBigReverb();
+std::unique_ptr<AbstractDSP> createSaturationEcho();
+std::unique_ptr<AbstractDSP> createSpectralResonator();
+std::unique_ptr<AbstractDSP> createModalBell();
+std::unique_ptr<AbstractDSP> createPluckedString();
+std::unique_ptr<AbstractDSP> createChaosFlute();
+std::unique_ptr<AbstractDSP> createTriPhaseEnsemble();
+std::unique_ptr<AbstractDSP> createInfiniteFolder();
+std::unique_ptr<AbstractDSP> createSpaceCello();
+std::unique_ptr<AbstractDSP> createTheAbyss();
+std::unique_ptr<AbstractDSP> createMatter();
+std::unique_ptr<AbstractDSP> createTheCauldron();
+std::unique_ptr<AbstractDSP> createVektorX();
+std::unique_ptr<AbstractDSP> createAnalogDrums();
+std::unique_ptr<AbstractDSP> createACID9Voice();
+std::unique_ptr<AbstractDSP> createTetanusCoil();
+std::unique_ptr<AbstractDSP> createNutShaker();
+std::unique_ptr<AbstractDSP> createPhysicalChoir();
+std::unique_ptr<AbstractDSP> createChaosPad();
+std::unique_ptr<AbstractDSP> createLinkage();
+std::unique_ptr<AbstractDSP> createSpectraHenge();
+
+// Create a component by "<Module>/<component>" name (nullptr if unknown)
+std::unique_ptr<AbstractDSP> createComponent(const std::string& name);
+
+// All registered component names, grouped by module
+std::vector<std::string> getComponentNames();
+
+// Create a DSP by module or component name (nullptr if unknown)
+std::unique_ptr<AbstractDSP> createDSP(const std::string& moduleName);
+
+// All registered module names, in registration order
+std::vector<std::string> getModuleNames();
+
+// Find the project root by looking for plugin.json
+std::string findProjectRoot();
+
+// Load src/modules/<name>/test_config.json (with legacy type defaults);
+// components get the defaults, as an effect when they take inputs
+WiggleRoom::TestConfig::ModuleTestConfig loadModuleConfig(const std::string& moduleName);
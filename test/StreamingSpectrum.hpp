@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * Streaming spectral analysis for rendered audio
+ *
+ * Takes the mono mix one sample at a time and runs a Hann-windowed
+ * 2048-point FFT every 512 samples, accumulating the magnitude spectrum, so
+ * a render of any length is summarized in constant memory. The summary
+ * uses the same definitions as audio_quality.py (average magnitude
+ * spectrum, rfft bins): centroid, spread, flatness, normalized entropy
+ * and the 85% rolloff. A render shorter than one frame is analyzed as a
+ * single zero-padded frame, as there.
+ */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+class StreamingSpectrum {
+public:
+    static constexpr int FFT_SIZE = 2048;
+    static constexpr int HOP = 512;
+    static constexpr int BINS = FFT_SIZE / 2 + 1;
+
+    struct Summary {
+        float centroidHz = 0.0f;
+        float spreadHz = 0.0f;
+        float flatness = 0.0f;
+        float entropy = 0.0f;     // 0..1
+        float rolloffHz = 0.0f;   // 85% of the magnitude sum below
+        int frames = 0;
+    };
+
+    StreamingSpectrum() {
+        const double pi = 3.14159265358979323846;
+        window.resize(FFT_SIZE);
+        for (int i = 0; i < FFT_SIZE; i++) {
+            // np.hanning: symmetric
+            window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * pi * i / (FFT_SIZE - 1)));
+        }
+        twiddles.resize(FFT_SIZE / 2);
+        for (int i = 0; i < FFT_SIZE / 2; i++) {
+            twiddles[i] = std::polar(1.0f, static_cast<float>(-2.0 * pi * i / FFT_SIZE));
+        }
+        bitReverse.resize(FFT_SIZE);
+        int bits = 0;
+        while ((1 << bits) < FFT_SIZE) bits++;
+        for (int i = 0; i < FFT_SIZE; i++) {
+            int r = 0;
+            for (int b = 0; b < bits; b++) r |= ((i >> b) & 1) << (bits - 1 - b);
+            bitReverse[i] = r;
+        }
+        history.assign(FFT_SIZE, 0.0f);
+        magnitudeSum.assign(BINS, 0.0);
+        buffer.resize(FFT_SIZE);
+    }
+
+    void push(float sample) {
+        history[writePos] = sample;
+        writePos = (writePos + 1) % FFT_SIZE;
+        count++;
+        if (count >= FFT_SIZE && (count - FFT_SIZE) % HOP == 0) {
+            analyzeFrame(writePos);
+        }
+    }
+
+    Summary summarize(float sampleRate) {
+        if (frames == 0 && count > 0) {
+            // Shorter than one frame: zero-pad what there is
+            std::vector<float> padded(FFT_SIZE, 0.0f);
+            for (long i = 0; i < count; i++) padded[i] = history[i];
+            history = padded;
+            analyzeFrame(0);
+        }
+
+        Summary s;
+        s.frames = frames;
+        if (frames == 0) return s;
+
+        const double eps = 1e-10;
+        double binHz = sampleRate / FFT_SIZE;
+        double total = 0.0, weighted = 0.0, logSum = 0.0;
+        std::vector<double> avg(BINS);
+        for (int k = 0; k < BINS; k++) {
+            avg[k] = magnitudeSum[k] / frames;
+            total += avg[k];
+            weighted += k * binHz * avg[k];
+            logSum += std::log(avg[k] + eps);
+        }
+        double centroid = weighted / (total + eps);
+        double spread = 0.0, entropy = 0.0;
+        for (int k = 0; k < BINS; k++) {
+            double d = k * binHz - centroid;
+            spread += d * d * avg[k];
+            double p = avg[k] / (total + eps);
+            entropy -= p * std::log2(p + eps);
+        }
+        double rolloff = 0.0, cumulative = 0.0;
+        for (int k = 0; k < BINS; k++) {
+            cumulative += avg[k];
+            if (cumulative >= 0.85 * total) {
+                rolloff = k * binHz;
+                break;
+            }
+        }
+
+        s.centroidHz = static_cast<float>(centroid);
+        s.spreadHz = static_cast<float>(std::sqrt(spread / (total + eps)));
+        s.flatness = static_cast<float>(std::exp(logSum / BINS) / (total / BINS + eps));
+        s.entropy = static_cast<float>(entropy / std::log2(static_cast<double>(BINS)));
+        s.rolloffHz = static_cast<float>(rolloff);
+        return s;
+    }
+
+private:
+    // Window the FFT_SIZE samples ending just before `start` and add the spectrum
+    void analyzeFrame(int start) {
+        for (int i = 0; i < FFT_SIZE; i++) {
+            buffer[bitReverse[i]] = history[(start + i) % FFT_SIZE] * window[i];
+        }
+        for (int size = 2; size <= FFT_SIZE; size *= 2) {
+            int half = size / 2;
+            int stride = FFT_SIZE / size;
+            for (int base = 0; base < FFT_SIZE; base += size) {
+                for (int j = 0; j < half; j++) {
+                    std::complex<float> t = twiddles[j * stride] * buffer[base + j + half];
+                    buffer[base + j + half] = buffer[base + j] - t;
+                    buffer[base + j] += t;
+                }
+            }
+        }
+        for (int k = 0; k < BINS; k++) magnitudeSum[k] += std::abs(buffer[k]);
+        frames++;
+    }
+
+    std::vector<float> window;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<int> bitReverse;
+    std::vector<float> history;   // Ring of the last FFT_SIZE samples
+    std::vector<std::complex<float>> buffer;
+    std::vector<double> magnitudeSum;
+    int writePos = 0;
+    long count = 0;
+    int frames = 0;
+};
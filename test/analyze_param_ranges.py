@@ -17,8 +17,6 @@ Usage:
 
 import argparse
 import json
-import re
-import subprocess
 import sys
 from dataclasses import dataclass, field
 from pathlib import Path
@@ -29,6 +27,7 @@ from utils import (
     get_project_root,
     get_render_executable,
     get_module_params as _get_module_params,
+    RenderServer,
 )
 
 
@@ -84,58 +83,35 @@ def get_module_params(module_name: str) -> list[ParamInfo]:
     ]
 
 
+_server: RenderServer | None = None
+
+
 def render_with_param(module_name: str, param_name: str, param_value: float,
                       duration: float = 1.5, gate_params: dict | None = None) -> SweepPoint:
     """Render audio with a specific parameter value and analyze."""
-    exe = get_render_executable()
-
-    args = [
-        str(exe),
-        "--module", module_name,
-        "--output", "/dev/null",
-        "--duration", str(duration),
-        "--param", f"{param_name}={param_value}"
-    ]
+    global _server
+    if _server is None:
+        _server = RenderServer()
 
-    # Add gate/trigger if needed
-    if gate_params:
-        for k, v in gate_params.items():
-            args.extend(["--param", f"{k}={v}"])
-    else:
-        # Default: try gate=5 for instruments
-        args.extend(["--param", "gate=5"])
+    # Add gate/trigger if needed (default: gate=5 for instruments)
+    params = dict(gate_params) if gate_params else {"gate": 5}
+    params[param_name] = param_value
 
     try:
-        result = subprocess.run(args, capture_output=True, text=True, timeout=30)
-        output = result.stdout + result.stderr
-
-        # Parse output
-        peak = 0.0
-        rms = 0.0
-        clipping = 0.0
-
-        peak_match = re.search(r'Peak amplitude:\s*([\d.]+)', output)
-        if peak_match:
-            peak = float(peak_match.group(1))
-
-        rms_match = re.search(r'RMS level:\s*([\d.]+)', output)
-        if rms_match:
-            rms = float(rms_match.group(1))
-
-        clip_match = re.search(r'Clipped samples:.*\(([\d.]+)%\)', output)
-        if clip_match:
-            clipping = float(clip_match.group(1))
-
-        is_silent = rms < 0.001  # Effectively silent
+        result = _server.analyze(module_name, duration=duration, params=params)
+        if not result.get("ok"):
+            raise RuntimeError(result.get("error", "render failed"))
 
+        rms = result["rms"]
         return SweepPoint(
             value=param_value,
-            peak_amplitude=peak,
+            peak_amplitude=result["peak"],
             rms_level=rms,
-            clipping_percent=clipping,
-            is_silent=is_silent
+            clipping_percent=result["clip_percent"],
+            is_silent=rms < 0.001  # Effectively silent
         )
     except Exception as e:
+        _server.close()
         return SweepPoint(
             value=param_value,
             peak_amplitude=0,
@@ -30,6 +30,7 @@ from utils import (
     run_faust_render,
     get_modules,
     get_module_params,
+    render_batch,
     SAMPLE_RATE,
 )
 
@@ -74,16 +75,6 @@ class AudioFeatures:
         ]
 
 
-def render_audio(module_name: str, params: dict[str, float],
-                 output_path: Path) -> bool:
-    """Render audio using shared utility."""
-    from utils import render_audio as _render_audio
-    success, _ = _render_audio(
-        module_name, params, output_path, DURATION, SAMPLE_RATE
-    )
-    return success
-
-
 def extract_features(audio_path: Path) -> AudioFeatures | None:
     """Extract audio features from a WAV file."""
     try:
@@ -193,17 +184,25 @@ def analyze_parameter(
     features_list = []
     wav_files = []
 
+    # Render every step in one batch (faust_render --jobs uses all cores)
+    jobs = []
     for i, value in enumerate(test_values):
         test_params = default_params.copy()
-        test_params[param_name] = value
-
-        wav_path = output_dir / f"{module_name}_{param_name}_{i:02d}.wav"
-
-        if render_audio(module_name, test_params, wav_path):
-            features = extract_features(wav_path)
+        test_params[param_name] = float(value)
+        jobs.append({
+            "module": module_name,
+            "output": str(output_dir / f"{module_name}_{param_name}_{i:02d}.wav"),
+            "duration": DURATION,
+            "sample_rate": SAMPLE_RATE,
+            "params": test_params,
+        })
+
+    for value, job, result in zip(test_values, jobs, render_batch(jobs)):
+        if result.get("ok"):
+            features = extract_features(Path(job["output"]))
             if features:
                 features_list.append((value, features))
-                wav_files.append(str(wav_path))
+                wav_files.append(job["output"])
 
     if len(features_list) < 2:
         return {"skipped": True, "reason": "insufficient valid renders"}
@@ -17,7 +17,6 @@ Usage:
 
 import argparse
 import json
-import subprocess
 import sys
 import tempfile
 from dataclasses import dataclass, field, asdict
@@ -28,6 +27,10 @@ import numpy as np
 from scipy import signal
 from scipy import ndimage
 
+from utils import get_render_executable, get_render_server
+from utils import get_modules as _get_modules
+from utils import render_audio as _render_audio
+
 # Try to import optional dependencies
 try:
     import librosa
@@ -193,46 +196,11 @@ def get_project_root() -> Path:
     return Path(__file__).parent.parent
 
 
-def get_render_executable() -> Path:
-    project_root = get_project_root()
-    exe = project_root / "build" / "test" / "faust_render"
-    if not exe.exists():
-        exe = project_root / "build" / "faust_render"
-    return exe
-
-
-def run_faust_render(args: list[str]) -> tuple[bool, str]:
-    exe = get_render_executable()
-    if not exe.exists():
-        return False, f"Executable not found: {exe}"
-
-    cmd = [str(exe)] + args
-    try:
-        result = subprocess.run(cmd, capture_output=True, text=True, timeout=60)
-        if result.returncode != 0:
-            return False, result.stderr
-        return True, result.stdout
-    except Exception as e:
-        return False, str(e)
-
-
 def render_audio(module_name: str, params: dict[str, float],
                  output_path: Path, duration: float = TEST_DURATION,
                  no_auto_gate: bool = False, scenario: str | None = None) -> bool:
-    args = [
-        "--module", module_name,
-        "--output", str(output_path),
-        "--duration", str(duration),
-        "--sample-rate", str(SAMPLE_RATE),
-    ]
-    if no_auto_gate:
-        args.append("--no-auto-gate")
-    if scenario:
-        args.extend(["--scenario", scenario])
-    for name, value in params.items():
-        args.extend(["--param", f"{name}={value}"])
-
-    success, _ = run_faust_render(args)
+    success, _ = _render_audio(module_name, params, output_path, duration, SAMPLE_RATE,
+                               no_auto_gate=no_auto_gate, scenario=scenario)
     return success
 
 
@@ -960,11 +928,7 @@ def analyze_audio_quality(audio: np.ndarray, sr: int = SAMPLE_RATE,
 
 def get_modules() -> list[str]:
     """Get list of available modules."""
-    success, output = run_faust_render(["--list-modules"])
-    if not success:
-        return []
-    return [line.strip() for line in output.strip().split("\n")
-            if line.strip() and not line.startswith("Available")]
+    return _get_modules()
 
 
 def test_module_quality(module_name: str, tmp_dir: Path,
@@ -974,7 +938,7 @@ def test_module_quality(module_name: str, tmp_dir: Path,
 
     Args:
         module_name: Name of the module
-        tmp_dir: Temporary directory for rendered audio
+        tmp_dir: Scratch directory (unused: the render stays in memory)
         thresholds: Optional dict with quality thresholds (overrides module config)
 
     Returns:
@@ -992,24 +956,23 @@ def test_module_quality(module_name: str, tmp_dir: Path,
         report.issues = [f"Audio tests skipped: {config.get('skip_reason', 'utility module')}"]
         return report
 
-    wav_path = tmp_dir / f"{module_name}_quality.wav"
-
     # Get first scenario if available (for trigger-based modules like drums)
     first_scenario = config.get("first_scenario")
+    job: dict[str, Any] = {"scenario": first_scenario} if first_scenario else {}
 
-    # Render with default parameters and scenario if available
-    if not render_audio(module_name, {}, wav_path, duration=3.0, scenario=first_scenario):
-        report = AudioQualityReport(module_name=module_name)
-        report.issues = ["Failed to render audio"]
-        return report
-
-    audio = load_audio(wav_path)
+    # Render with default parameters and scenario if available, straight
+    # into memory from the shared render server
+    try:
+        _, audio = get_render_server().render(
+            module_name, **job, duration=3.0, sample_rate=SAMPLE_RATE)
+    except (OSError, RuntimeError):
+        audio = None
     if audio is None:
         report = AudioQualityReport(module_name=module_name)
-        report.issues = ["Failed to load audio"]
+        report.issues = ["Failed to render audio"]
         return report
 
-    return analyze_audio_quality(audio, SAMPLE_RATE, module_name, thresholds)
+    return analyze_audio_quality(audio.mean(axis=0), SAMPLE_RATE, module_name, thresholds)
 
 
 def print_quality_report(report: AudioQualityReport, verbose: bool = False):
@@ -0,0 +1,117 @@
+/**
+ * Module registry for the test tools
+ *
+ * Maps module names to the factories in dsp_wrappers.cpp and loads each
+ * module's test_config.json. Shared by faust_render and faust_bench.
+ */
+
+#include "DSPFactory.hpp"
+
+#include <fstream>
+
+using namespace WiggleRoom::TestConfig;
+
+// ============================================================================
+// DSP Factory
+// ============================================================================
+
+std::unique_ptr<AbstractDSP> createDSP(const std::string& moduleName) {
+    if (moduleName == "LadderLPF") return createLadderLPF();
+    if (moduleName == "BigReverb") return createBigReverb();
+    if (moduleName == "SaturationEcho") return createSaturationEcho();
+    if (moduleName == "SpectralResonator") return createSpectralResonator();
+    if (moduleName == "ModalBell") return createModalBell();
+    if (moduleName == "PluckedString") return createPluckedString();
+    if (moduleName == "ChaosFlute") return createChaosFlute();
+    if (moduleName == "TriPhaseEnsemble") return createTriPhaseEnsemble();
+    if (moduleName == "InfiniteFolder") return createInfiniteFolder();
+    if (moduleName == "SpaceCello") return createSpaceCello();
+    if (moduleName == "TheAbyss") return createTheAbyss();
+    if (moduleName == "Matter") return createMatter();
+    if (moduleName == "TheCauldron") return createTheCauldron();
+    if (moduleName == "VektorX") return createVektorX();
+    if (moduleName == "AnalogDrums") return createAnalogDrums();
+    if (moduleName == "ACID9Voice") return createACID9Voice();
+    if (moduleName == "TetanusCoil") return createTetanusCoil();
+    if (moduleName == "NutShaker") return createNutShaker();
+    if (moduleName == "PhysicalChoir") return createPhysicalChoir();
+    if (moduleName == "ChaosPad") return createChaosPad();
+    if (moduleName == "Linkage") return createLinkage();
+    if (moduleName == "SpectraHenge") return createSpectraHenge();
+    return createComponent(moduleName);
+}
+
+std::vector<std::string> getModuleNames() {
+    return {"LadderLPF", "BigReverb", "SaturationEcho", "SpectralResonator",
+            "ModalBell", "PluckedString", "ChaosFlute", "TriPhaseEnsemble",
+            "InfiniteFolder", "SpaceCello", "TheAbyss", "Matter",
+            "TheCauldron", "VektorX", "AnalogDrums", "ACID9Voice", "TetanusCoil",
+            "NutShaker", "PhysicalChoir", "ChaosPad", "Linkage",
+            "SpectraHenge"};
+}
+
+// ============================================================================
+// Module Config Loading
+// ============================================================================
+
+// Find the project root by looking for CMakeLists.txt or plugin.json
+std::string findProjectRoot() {
+    // Try relative paths from where faust_render is typically located
+    std::vector<std::string> candidates = {
+        "..",           // build/test -> build -> project_root
+        "../..",        // build/test -> project_root
+        "../../..",     // nested build dirs
+        "."             // current directory
+    };
+
+    for (const auto& candidate : candidates) {
+        std::string test_path = candidate + "/plugin.json";
+        std::ifstream f(test_path);
+        if (f.good()) {
+            return candidate;
+        }
+    }
+    return ".";  // fallback to current directory
+}
+
+// Load module config from its directory
+ModuleTestConfig loadModuleConfig(const std::string& moduleName) {
+    if (moduleName.find('/') != std::string::npos) {
+        // Components have no test_config.json; feed program material to
+        // the ones that process an input
+        ModuleTestConfig config = ModuleTestConfig::defaultConfig(moduleName);
+        auto component = createComponent(moduleName);
+        if (component && component->getNumInputs() > 0) {
+            config.module_type = ModuleType::Effect;
+        }
+        return config;
+    }
+
+    std::string projectRoot = findProjectRoot();
+    std::string configPath = projectRoot + "/src/modules/" + moduleName + "/test_config.json";
+
+    ModuleTestConfig config = load_module_config(configPath, moduleName);
+
+    // If config file not found, use defaults based on legacy hardcoded rules
+    if (config.module_type == ModuleType::Instrument &&
+        config.test_scenarios.size() == 1 &&
+        config.test_scenarios[0].name == "default") {
+
+        // Apply legacy type detection for backwards compatibility
+        if (moduleName == "LadderLPF" || moduleName == "InfiniteFolder") {
+            config.module_type = ModuleType::Filter;
+        } else if (moduleName == "SpectralResonator") {
+            config.module_type = ModuleType::Resonator;
+        } else if (moduleName == "BigReverb" || moduleName == "SaturationEcho" ||
+                   moduleName == "TriPhaseEnsemble") {
+            config.module_type = ModuleType::Effect;
+        }
+
+        // Apply legacy hot signal detection
+        if (moduleName == "InfiniteFolder") {
+            config.thresholds.allow_hot_signal = true;
+        }
+    }
+
+    return config;
+}
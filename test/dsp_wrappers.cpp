@@ -9,6 +9,8 @@
 
 #include "AbstractDSP.hpp"
 #include <memory>
+#include <string>
+#include <vector>
 
 // Template wrapper that bridges Faust DSP to AbstractDSP interface
 template<typename DSP>
@@ -29,6 +31,9 @@ public:
     float getParamMax(int index) const override { return dsp.getParamMax(index); }
     float getParamInit(int index) const override { return dsp.getParamInit(index); }
     int getParamIndex(const char* name) const override { return dsp.getParamIndex(name); }
+    size_t getStateSize() const override { return dsp.getStateSize(); }
+    void saveState(void* buffer) const override { dsp.saveState(buffer); }
+    void restoreState(const void* buffer) override { dsp.restoreState(buffer); }
 };
 
 // Include each Faust header with its unique module name
@@ -230,3 +235,131 @@ std::unique_ptr<AbstractDSP> createLinkage() {
 std::unique_ptr<AbstractDSP> createSpectraHenge() {
     return std::make_unique<DSPWrapper<FaustGenerated::NS_SpectraHenge::VCVRackDSP>>();
 }
+
+#undef __mydsp_H__
+
+// ============================================================================
+// Components (single Faust libraries / effect units, see FAUST_COMPONENTS
+// in CMakeLists.txt)
+// ============================================================================
+
+template<typename DSP>
+std::unique_ptr<AbstractDSP> createWrapped() {
+    return std::make_unique<DSPWrapper<DSP>>();
+}
+
+struct ComponentEntry {
+    const char* name;
+    std::unique_ptr<AbstractDSP> (*create)();
+};
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_cluster_osc
+#include "component_vektorx_cluster_osc.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_dungeon
+#include "component_vektorx_dungeon.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_field_filter
+#include "component_vektorx_field_filter.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_freq_shifter
+#include "component_vektorx_freq_shifter.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_morph_osc
+#include "component_vektorx_morph_osc.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_reflekta
+#include "component_vektorx_reflekta.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME VektorX_soft_clip
+#include "component_vektorx_soft_clip.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ACID9Voice_tri_core_osc
+#include "component_acid9voice_tri_core_osc.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ACID9Voice_morph_osc
+#include "component_acid9voice_morph_osc.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ACID9Voice_acid_filter
+#include "component_acid9voice_acid_filter.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ACID9Voice_acid_delay
+#include "component_acid9voice_acid_delay.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_lpf
+#include "component_chaospad_lpf.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_bitcrush
+#include "component_chaospad_bitcrush.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_delay
+#include "component_chaospad_delay.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_grain
+#include "component_chaospad_grain.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_pitch
+#include "component_chaospad_pitch.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_reverb
+#include "component_chaospad_reverb.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_flanger
+#include "component_chaospad_flanger.hpp"
+
+#undef __mydsp_H__
+#define FAUST_MODULE_NAME ChaosPad_ringmod
+#include "component_chaospad_ringmod.hpp"
+
+static const ComponentEntry COMPONENTS[] = {
+    {"VektorX/cluster_osc", createWrapped<FaustGenerated::NS_VektorX_cluster_osc::VCVRackDSP>},
+    {"VektorX/dungeon", createWrapped<FaustGenerated::NS_VektorX_dungeon::VCVRackDSP>},
+    {"VektorX/field_filter", createWrapped<FaustGenerated::NS_VektorX_field_filter::VCVRackDSP>},
+    {"VektorX/freq_shifter", createWrapped<FaustGenerated::NS_VektorX_freq_shifter::VCVRackDSP>},
+    {"VektorX/morph_osc", createWrapped<FaustGenerated::NS_VektorX_morph_osc::VCVRackDSP>},
+    {"VektorX/reflekta", createWrapped<FaustGenerated::NS_VektorX_reflekta::VCVRackDSP>},
+    {"VektorX/soft_clip", createWrapped<FaustGenerated::NS_VektorX_soft_clip::VCVRackDSP>},
+    {"ACID9Voice/tri_core_osc", createWrapped<FaustGenerated::NS_ACID9Voice_tri_core_osc::VCVRackDSP>},
+    {"ACID9Voice/morph_osc", createWrapped<FaustGenerated::NS_ACID9Voice_morph_osc::VCVRackDSP>},
+    {"ACID9Voice/acid_filter", createWrapped<FaustGenerated::NS_ACID9Voice_acid_filter::VCVRackDSP>},
+    {"ACID9Voice/acid_delay", createWrapped<FaustGenerated::NS_ACID9Voice_acid_delay::VCVRackDSP>},
+    {"ChaosPad/lpf", createWrapped<FaustGenerated::NS_ChaosPad_lpf::VCVRackDSP>},
+    {"ChaosPad/bitcrush", createWrapped<FaustGenerated::NS_ChaosPad_bitcrush::VCVRackDSP>},
+    {"ChaosPad/delay", createWrapped<FaustGenerated::NS_ChaosPad_delay::VCVRackDSP>},
+    {"ChaosPad/grain", createWrapped<FaustGenerated::NS_ChaosPad_grain::VCVRackDSP>},
+    {"ChaosPad/pitch", createWrapped<FaustGenerated::NS_ChaosPad_pitch::VCVRackDSP>},
+    {"ChaosPad/reverb", createWrapped<FaustGenerated::NS_ChaosPad_reverb::VCVRackDSP>},
+    {"ChaosPad/flanger", createWrapped<FaustGenerated::NS_ChaosPad_flanger::VCVRackDSP>},
+    {"ChaosPad/ringmod", createWrapped<FaustGenerated::NS_ChaosPad_ringmod::VCVRackDSP>},
+};
+
+std::unique_ptr<AbstractDSP> createComponent(const std::string& name) {
+    for (const auto& entry : COMPONENTS) {
+        if (name == entry.name) return entry.create();
+    }
+    return nullptr;
+}
+
+std::vector<std::string> getComponentNames() {
+    std::vector<std::string> names;
+    for (const auto& entry : COMPONENTS) names.push_back(entry.name);
+    return names;
+}
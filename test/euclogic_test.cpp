@@ -159,7 +159,10 @@ int testEuclidean(int argc, char** argv) {
     WiggleRoom::EuclideanEngine engine;
     engine.configure(steps, hits, rotation);
 
-    std::vector<bool> pattern(engine.pattern.begin(), engine.pattern.end());
+    std::vector<bool> pattern;
+    for (int i = 0; i < engine.steps; i++) {
+        pattern.push_back(engine.getHit(i));
+    }
     printJsonArrayBool("pattern", pattern);
     return 0;
 }
@@ -200,10 +203,10 @@ int testEuclideanKnown(int argc, char** argv) {
         WiggleRoom::EuclideanEngine engine;
         engine.configure(tc.steps, tc.hits, 0);
 
-        bool match = (engine.pattern.size() == tc.expected.size());
+        bool match = ((size_t)engine.steps == tc.expected.size());
         if (match) {
             for (size_t i = 0; i < tc.expected.size(); i++) {
-                if (engine.pattern[i] != tc.expected[i]) {
+                if (engine.getHit(i) != tc.expected[i]) {
                     match = false;
                     break;
                 }
@@ -221,9 +224,9 @@ int testEuclideanKnown(int argc, char** argv) {
                 if (i < tc.expected.size() - 1) oss << ",";
             }
             oss << "], got [";
-            for (size_t i = 0; i < engine.pattern.size(); i++) {
-                oss << (engine.pattern[i] ? "1" : "0");
-                if (i < engine.pattern.size() - 1) oss << ",";
+            for (int i = 0; i < engine.steps; i++) {
+                oss << (engine.getHit(i) ? "1" : "0");
+                if (i < engine.steps - 1) oss << ",";
             }
             oss << "]";
             failures.push_back(oss.str());
@@ -343,6 +346,8 @@ int testTruthUndo(int argc, char** argv) {
     (void)argc; (void)argv;
 
     WiggleRoom::TruthTable table;
+    // Fixed seed: a randomize can redraw the original table, which would
+    // leave nothing for undo to restore
     table.setSeed(42);
 
     // Store original
@@ -351,6 +356,7 @@ int testTruthUndo(int argc, char** argv) {
     // Randomize (pushes undo)
     table.randomize();
     auto randomized = table.mapping;
+    bool changed = (randomized != original);
 
     // Undo
     table.undo();
@@ -358,8 +364,9 @@ int testTruthUndo(int argc, char** argv) {
     // Check if restored
     bool restored = (table.mapping == original);
 
-    std::cout << "{\"restored\": " << (restored ? "true" : "false") << "}" << std::endl;
-    return restored ? 0 : 1;
+    std::cout << "{\"changed\": " << (changed ? "true" : "false")
+              << ", \"restored\": " << (restored ? "true" : "false") << "}" << std::endl;
+    return (changed && restored) ? 0 : 1;
 }
 
 // Test: Probability gate
@@ -409,8 +416,28 @@ int testProbabilityDeterminism(int argc, char** argv) {
         if (r1 != r2) match = false;
     }
 
-    std::cout << "{\"seed\": " << seed << ", \"match\": " << (match ? "true" : "false") << "}" << std::endl;
-    return match ? 0 : 1;
+    // Same seed on another stream (e.g. the next channel) must not repeat stream 0
+    WiggleRoom::ProbabilityGate other;
+    other.setSeed(seed, 1);
+    other.setProbability(0.5f);
+    int sameAsStream0 = 0;
+    for (int i = 0; i < 100; i++) {
+        if (other.test() == seq1[i]) sameAsStream0++;
+    }
+    bool streamsDiffer = sameAsStream0 < 100;
+
+    // Counter-based streams can be read back in any order
+    WiggleRoom::CounterRng counter(seed, 3);
+    bool randomAccess = true;
+    for (uint64_t i = 0; i < 100; i++) {
+        if (counter.next() != counter.at(i)) randomAccess = false;
+    }
+
+    std::cout << "{\"seed\": " << seed << ", \"match\": " << (match ? "true" : "false")
+              << ", \"streams_differ\": " << (streamsDiffer ? "true" : "false")
+              << ", \"counter_random_access\": " << (randomAccess ? "true" : "false")
+              << "}" << std::endl;
+    return (match && streamsDiffer && randomAccess) ? 0 : 1;
 }
 
 // Test: Clock multiplier/divider phase accumulator
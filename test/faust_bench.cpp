@@ -0,0 +1,470 @@
+/**
+ * Faust DSP CPU Benchmark
+ *
+ * Times compute() for every registered Faust module over a grid of block
+ * sizes and sample rates, driving gates/triggers the same way faust_render
+ * does so voices are actually sounding while they are measured.
+ *
+ * --components times the single libraries and effect units VektorX,
+ * ACID9Voice and ChaosPad are built from (test/CMakeLists.txt,
+ * FAUST_COMPONENTS), to find which part of a module takes the time; one
+ * can also be named with --module, e.g. --module VektorX/dungeon.
+ *
+ * Results are written as JSON (one result per line, stable ordering) so
+ * two runs can be diffed between commits, or compared directly with
+ * --compare.
+ *
+ * Usage:
+ *   ./faust_bench --output bench.json
+ *   ./faust_bench --module ModalBell --block-sizes 1,32 --sample-rates 48000
+ *   ./faust_bench --components --block-sizes 64 --output components.json
+ *   ./faust_bench --compare baseline.json --output bench.json
+ */
+
+#include "DSPFactory.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace WiggleRoom::TestConfig;
+
+// ============================================================================
+// Options
+// ============================================================================
+
+struct Options {
+    std::vector<std::string> modules;       // Empty = all registered modules
+    bool components = false;                // Add every registered component
+    std::vector<int> blockSizes = {1, 16, 64, 256};
+    std::vector<int> sampleRates = {48000, 96000};
+    std::string scenario;                   // Named scenario from test_config.json
+    float seconds = 2.0f;                   // Audio rendered per timed run
+    float warmup = 0.5f;                    // Audio rendered before timing
+    int repeats = 5;                        // Timed runs per configuration
+    std::string outputFile;                 // Empty = stdout
+    std::string compareFile;                // Baseline JSON to compare against
+};
+
+std::vector<int> parseIntList(const std::string& s) {
+    std::vector<int> values;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::stoi(item));
+    }
+    return values;
+}
+
+void printUsage(const char* programName) {
+    std::cerr << "Usage: " << programName << " [options]\n"
+              << "\nOptions:\n"
+              << "  --module NAME          Module or Module/component to benchmark\n"
+              << "                         (repeatable, default: all modules)\n"
+              << "  --components           Benchmark every module component\n"
+              << "  --block-sizes LIST     Comma-separated block sizes (default: 1,16,64,256)\n"
+              << "  --sample-rates LIST    Comma-separated sample rates (default: 48000,96000)\n"
+              << "  --scenario NAME        Apply a named test scenario's parameters\n"
+              << "  --seconds SECS         Audio per timed run (default: 2.0)\n"
+              << "  --warmup SECS          Audio rendered before timing (default: 0.5)\n"
+              << "  --repeats N            Timed runs per configuration (default: 5)\n"
+              << "  --output FILE          Write JSON results to FILE (default: stdout)\n"
+              << "  --compare FILE         Print the change against a previous result file\n"
+              << "  --help                 Show this help\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return false;
+        }
+        if (arg == "--module" && i + 1 < argc) {
+            opts.modules.push_back(argv[++i]);
+            continue;
+        }
+        if (arg == "--components") {
+            opts.components = true;
+            continue;
+        }
+        if (arg == "--block-sizes" && i + 1 < argc) {
+            opts.blockSizes = parseIntList(argv[++i]);
+            continue;
+        }
+        if (arg == "--sample-rates" && i + 1 < argc) {
+            opts.sampleRates = parseIntList(argv[++i]);
+            continue;
+        }
+        if (arg == "--scenario" && i + 1 < argc) {
+            opts.scenario = argv[++i];
+            continue;
+        }
+        if (arg == "--seconds" && i + 1 < argc) {
+            opts.seconds = std::stof(argv[++i]);
+            continue;
+        }
+        if (arg == "--warmup" && i + 1 < argc) {
+            opts.warmup = std::stof(argv[++i]);
+            continue;
+        }
+        if (arg == "--repeats" && i + 1 < argc) {
+            opts.repeats = std::max(1, std::stoi(argv[++i]));
+            continue;
+        }
+        if (arg == "--output" && i + 1 < argc) {
+            opts.outputFile = argv[++i];
+            continue;
+        }
+        if (arg == "--compare" && i + 1 < argc) {
+            opts.compareFile = argv[++i];
+            continue;
+        }
+
+        std::cerr << "Unknown argument: " << arg << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Stimulus
+// ============================================================================
+
+/**
+ * Pre-rendered input signal and gate schedule for one benchmark run
+ *
+ * Inputs are generated up front so the timed loop only measures the DSP.
+ * Gates follow a 1 second cycle (on for the first 40%, matching
+ * faust_render) and triggers fire a 10ms pulse at the start of each cycle,
+ * so decaying voices are re-excited for the whole run.
+ */
+struct Stimulus {
+    std::vector<std::vector<float>> inputs;  // [channel][sample]
+
+    int gateIdx = -1;
+    int triggerIdx = -1;
+    int velocityIdx = -1;
+    std::vector<int> customTriggers;  // Scenario trigger params (e.g. bd_trig)
+
+    int cycleSamples = 0;
+    int gateOnSamples = 0;
+    int pulseSamples = 0;
+
+    void build(AbstractDSP& dsp, const ModuleTestConfig& config,
+               const TestScenario* scenario, int sampleRate, int numSamples) {
+        cycleSamples = sampleRate;
+        gateOnSamples = static_cast<int>(0.4f * sampleRate);
+        pulseSamples = static_cast<int>(0.01f * sampleRate);
+
+        gateIdx = dsp.getParamIndex("gate");
+        triggerIdx = dsp.getParamIndex("trigger");
+        velocityIdx = dsp.getParamIndex("velocity");
+
+        // Gate-driven modules (drums etc.) name their trigger per scenario;
+        // without an explicit scenario, fire every trigger the config knows
+        std::set<std::string> triggerNames;
+        if (scenario) {
+            if (!scenario->trigger_param.empty()) triggerNames.insert(scenario->trigger_param);
+        } else {
+            for (const auto& s : config.test_scenarios) {
+                if (!s.trigger_param.empty()) triggerNames.insert(s.trigger_param);
+            }
+            for (const auto& t : config.showcase.trigger_sequence) {
+                if (!t.param.empty()) triggerNames.insert(t.param);
+            }
+        }
+        customTriggers.clear();
+        for (const auto& name : triggerNames) {
+            int idx = dsp.getParamIndex(name.c_str());
+            if (idx >= 0) customTriggers.push_back(idx);
+        }
+        if (!customTriggers.empty()) {
+            gateIdx = -1;
+            triggerIdx = -1;
+        }
+
+        int numInputs = dsp.getNumInputs();
+        inputs.assign(numInputs, std::vector<float>(numSamples, 0.0f));
+        if (numInputs == 0) return;
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> noiseDist(-1.0f, 1.0f);
+        float sawPhase = 0.0f;
+        float sawFreq = 440.0f / sampleRate;
+        int burstPeriod = static_cast<int>(0.3f * sampleRate);
+        int burstLength = static_cast<int>(0.02f * sampleRate);
+
+        for (int i = 0; i < numSamples; i++) {
+            switch (config.module_type) {
+                case ModuleType::Filter:
+                    inputs[0][i] = sawPhase * 2.0f - 1.0f;
+                    break;
+                case ModuleType::Resonator:
+                    inputs[0][i] = (i % burstPeriod < burstLength) ? noiseDist(rng) * 0.8f : 0.0f;
+                    break;
+                case ModuleType::Effect:
+                    // Continuous program material: a silent tail would let the
+                    // benchmark measure an idle effect
+                    for (int ch = 0; ch < numInputs; ch++) {
+                        float phase = sawPhase + ch * 0.25f;
+                        if (phase >= 1.0f) phase -= 1.0f;
+                        inputs[ch][i] = (phase * 2.0f - 1.0f) * 0.5f + noiseDist(rng) * 0.05f;
+                    }
+                    break;
+                case ModuleType::Instrument:
+                case ModuleType::Utility:
+                    break;
+            }
+            sawPhase += sawFreq;
+            if (sawPhase >= 1.0f) sawPhase -= 1.0f;
+        }
+    }
+
+    // Set gate/trigger params for a block starting at sample `pos`
+    void apply(AbstractDSP& dsp, int pos) const {
+        int inCycle = pos % cycleSamples;
+        bool gateOn = inCycle < gateOnSamples;
+        bool pulse = inCycle < pulseSamples;
+
+        for (int idx : customTriggers) dsp.setParamValue(idx, pulse ? 10.0f : 0.0f);
+        if (gateIdx >= 0) dsp.setParamValue(gateIdx, gateOn ? 1.0f : 0.0f);
+        if (triggerIdx >= 0) dsp.setParamValue(triggerIdx, pulse ? 1.0f : 0.0f);
+        if (velocityIdx >= 0) dsp.setParamValue(velocityIdx, gateOn ? 1.0f : 0.0f);
+    }
+};
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+struct BenchResult {
+    std::string module;
+    int sampleRate = 0;
+    int blockSize = 0;
+    double nsPerSampleMean = 0.0;
+    double nsPerSampleMin = 0.0;
+    double nsPerSampleStddev = 0.0;
+    double cpuPercent48k = 0.0;  // Share of one core needed to run in real time at 48 kHz
+};
+
+// Keeps the compiler from discarding outputs that are never read
+static volatile float benchSink = 0.0f;
+
+// Render numSamples through dsp in blocks; returns elapsed nanoseconds
+double runBlocks(AbstractDSP& dsp, const Stimulus& stim, int start, int numSamples,
+                 int blockSize, std::vector<std::vector<float>>& outputs,
+                 std::vector<float*>& inPtrs, std::vector<float*>& outPtrs) {
+    int numInputs = static_cast<int>(stim.inputs.size());
+    int numOutputs = static_cast<int>(outputs.size());
+    float acc = 0.0f;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int pos = 0; pos < numSamples; pos += blockSize) {
+        int count = std::min(blockSize, numSamples - pos);
+        stim.apply(dsp, start + pos);
+        for (int ch = 0; ch < numInputs; ch++) inPtrs[ch] = const_cast<float*>(&stim.inputs[ch][pos]);
+        dsp.compute(count, inPtrs.data(), outPtrs.data());
+        for (int ch = 0; ch < numOutputs; ch++) acc += outputs[ch][count - 1];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    benchSink = benchSink + acc;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+BenchResult benchmark(const std::string& moduleName, const ModuleTestConfig& config,
+                      const TestScenario* scenario, int sampleRate, int blockSize,
+                      const Options& opts) {
+    auto dsp = createDSP(moduleName);
+    dsp->init(sampleRate);
+
+    if (scenario) {
+        for (const auto& kv : scenario->parameters) {
+            int idx = dsp->getParamIndex(kv.first.c_str());
+            if (idx >= 0) dsp->setParamValue(idx, kv.second);
+        }
+    }
+
+    int warmupSamples = static_cast<int>(opts.warmup * sampleRate);
+    int runSamples = std::max(blockSize, static_cast<int>(opts.seconds * sampleRate));
+
+    // One stimulus covers the warmup and a single run; every timed run
+    // replays the same input so runs are comparable
+    Stimulus stim;
+    stim.build(*dsp, config, scenario, sampleRate, std::max(warmupSamples, runSamples));
+
+    int numInputs = dsp->getNumInputs();
+    int numOutputs = dsp->getNumOutputs();
+    std::vector<std::vector<float>> outputs(numOutputs, std::vector<float>(blockSize, 0.0f));
+    std::vector<float*> inPtrs(numInputs);
+    std::vector<float*> outPtrs(numOutputs);
+    for (int ch = 0; ch < numOutputs; ch++) outPtrs[ch] = outputs[ch].data();
+
+    if (warmupSamples > 0) {
+        runBlocks(*dsp, stim, 0, warmupSamples, blockSize, outputs, inPtrs, outPtrs);
+    }
+
+    std::vector<double> nsPerSample;
+    for (int r = 0; r < opts.repeats; r++) {
+        double ns = runBlocks(*dsp, stim, 0, runSamples, blockSize, outputs, inPtrs, outPtrs);
+        nsPerSample.push_back(ns / runSamples);
+    }
+
+    double mean = 0.0;
+    for (double v : nsPerSample) mean += v;
+    mean /= nsPerSample.size();
+    double variance = 0.0;
+    for (double v : nsPerSample) variance += (v - mean) * (v - mean);
+    if (nsPerSample.size() > 1) variance /= (nsPerSample.size() - 1);
+
+    BenchResult result;
+    result.module = moduleName;
+    result.sampleRate = sampleRate;
+    result.blockSize = blockSize;
+    result.nsPerSampleMean = mean;
+    result.nsPerSampleMin = *std::min_element(nsPerSample.begin(), nsPerSample.end());
+    result.nsPerSampleStddev = std::sqrt(variance);
+    result.cpuPercent48k = mean * 48000.0 / 1e9 * 100.0;
+    return result;
+}
+
+// ============================================================================
+// JSON Output
+// ============================================================================
+
+std::string resultKey(const std::string& module, int sampleRate, int blockSize) {
+    return module + "@" + std::to_string(sampleRate) + "/" + std::to_string(blockSize);
+}
+
+void writeJson(std::ostream& out, const Options& opts, const std::vector<BenchResult>& results) {
+    char buf[512];
+    out << "{\n";
+    out << "  \"version\": 1,\n";
+    std::snprintf(buf, sizeof(buf),
+                  "  \"config\": {\"seconds\": %.3f, \"warmup\": %.3f, \"repeats\": %d, \"scenario\": \"%s\"},\n",
+                  opts.seconds, opts.warmup, opts.repeats, opts.scenario.c_str());
+    out << buf;
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        std::snprintf(buf, sizeof(buf),
+                      "    {\"module\": \"%s\", \"sample_rate\": %d, \"block_size\": %d, "
+                      "\"ns_per_sample\": %.3f, \"ns_per_sample_min\": %.3f, "
+                      "\"ns_per_sample_stddev\": %.3f, \"cpu_percent_48k\": %.4f}%s\n",
+                      r.module.c_str(), r.sampleRate, r.blockSize,
+                      r.nsPerSampleMean, r.nsPerSampleMin, r.nsPerSampleStddev,
+                      r.cpuPercent48k, (i + 1 < results.size()) ? "," : "");
+        out << buf;
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+// Print the ns/sample change for every configuration present in both runs
+bool compareWithBaseline(const std::string& path, const std::vector<BenchResult>& results) {
+    JsonValue baseline = load_json_file(path);
+    const JsonValue& rows = baseline["results"];
+    if (!rows.is_array()) {
+        std::cerr << "Error: No results in baseline file: " << path << "\n";
+        return false;
+    }
+
+    std::map<std::string, double> before;
+    for (const auto& row : rows.array_val) {
+        std::string key = resultKey(row["module"].get_string(),
+                                    static_cast<int>(row["sample_rate"].get_number()),
+                                    static_cast<int>(row["block_size"].get_number()));
+        before[key] = row["ns_per_sample"].get_number();
+    }
+
+    std::cerr << "\nChange vs " << path << " (ns/sample):\n";
+    for (const auto& r : results) {
+        auto it = before.find(resultKey(r.module, r.sampleRate, r.blockSize));
+        if (it == before.end() || it->second <= 0.0) continue;
+        double change = (r.nsPerSampleMean - it->second) / it->second * 100.0;
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "  %-20s %6d Hz  block %4d  %9.2f -> %9.2f  (%+.1f%%)\n",
+                      r.module.c_str(), r.sampleRate, r.blockSize,
+                      it->second, r.nsPerSampleMean, change);
+        std::cerr << buf;
+    }
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+
+    std::vector<std::string> modules = opts.modules;
+    if (opts.components) {
+        for (const auto& name : getComponentNames()) modules.push_back(name);
+    }
+    if (modules.empty()) modules = getModuleNames();
+    std::vector<BenchResult> results;
+
+    for (const auto& name : modules) {
+        if (!createDSP(name)) {
+            std::cerr << "Error: Unknown module: " << name << "\n";
+            return 1;
+        }
+
+        ModuleTestConfig config = loadModuleConfig(name);
+        const TestScenario* scenario = nullptr;
+        if (!opts.scenario.empty()) {
+            for (const auto& s : config.test_scenarios) {
+                if (s.name == opts.scenario) scenario = &s;
+            }
+            if (!scenario) {
+                std::cerr << "Warning: " << name << " has no scenario '" << opts.scenario
+                          << "', using defaults\n";
+            }
+        }
+
+        for (int sr : opts.sampleRates) {
+            for (int bs : opts.blockSizes) {
+                if (sr <= 0 || bs <= 0) continue;
+                BenchResult r = benchmark(name, config, scenario, sr, bs, opts);
+                char buf[256];
+                std::snprintf(buf, sizeof(buf), "%-24s %6d Hz  block %4d  %9.2f ns/sample  (%.2f%% @ 48k, sd %.2f)\n",
+                              name.c_str(), sr, bs, r.nsPerSampleMean, r.cpuPercent48k,
+                              r.nsPerSampleStddev);
+                std::cerr << buf;
+                results.push_back(r);
+            }
+        }
+    }
+
+    if (opts.outputFile.empty()) {
+        writeJson(std::cout, opts, results);
+    } else {
+        std::ofstream file(opts.outputFile);
+        if (!file) {
+            std::cerr << "Error: Cannot open file for writing: " << opts.outputFile << std::endl;
+            return 1;
+        }
+        writeJson(file, opts, results);
+        std::cerr << "Wrote " << opts.outputFile << "\n";
+    }
+
+    if (!opts.compareFile.empty() && !compareWithBaseline(opts.compareFile, results)) {
+        return 1;
+    }
+    return 0;
+}
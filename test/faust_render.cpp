@@ -8,193 +8,215 @@
  *   ./faust_render --module TheAbyss --output test.wav --duration 2.0 \
  *       --param decay=0.8 --param pressure=0.6
  *   ./faust_render --module LadderLPF --list-params
+ *   ./faust_render --jobs sweep.jsonl --workers 16
+ *   ./faust_render --serve        (JSON-lines requests on stdin, see runServer)
  */
 
-#include "AbstractDSP.hpp"
-#include "ModuleTestConfig.hpp"
+#include "DSPFactory.hpp"
+#include "StreamingSpectrum.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
-using namespace WiggleRoom::TestConfig;
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
-// Forward declarations for factory functions (defined in separate source files)
-std::unique_ptr<AbstractDSP> createLadderLPF();
-std::unique_ptr<AbstractDSP> createBigReverb();
-std::unique_ptr<AbstractDSP> createSaturationEcho();
-std::unique_ptr<AbstractDSP> createSpectralResonator();
-std::unique_ptr<AbstractDSP> createModalBell();
-std::unique_ptr<AbstractDSP> createPluckedString();
-std::unique_ptr<AbstractDSP> createChaosFlute();
-std::unique_ptr<AbstractDSP> createTriPhaseEnsemble();
-std::unique_ptr<AbstractDSP> createInfiniteFolder();
-std::unique_ptr<AbstractDSP> createSpaceCello();
-std::unique_ptr<AbstractDSP> createTheAbyss();
-std::unique_ptr<AbstractDSP> createMatter();
-std::unique_ptr<AbstractDSP> createTheCauldron();
-std::unique_ptr<AbstractDSP> createVektorX();
-std::unique_ptr<AbstractDSP> createAnalogDrums();
-std::unique_ptr<AbstractDSP> createACID9Voice();
-std::unique_ptr<AbstractDSP> createTetanusCoil();
-std::unique_ptr<AbstractDSP> createNutShaker();
-std::unique_ptr<AbstractDSP> createPhysicalChoir();
-std::unique_ptr<AbstractDSP> createChaosPad();
-std::unique_ptr<AbstractDSP> createLinkage();
-std::unique_ptr<AbstractDSP> createSpectraHenge();
+using namespace WiggleRoom::TestConfig;
 
 // ============================================================================
-// WAV File Writer (no external dependencies)
+// WAV Output (no external dependencies)
 // ============================================================================
 
-struct WavHeader {
-    char riff[4] = {'R', 'I', 'F', 'F'};
-    uint32_t fileSize;
-    char wave[4] = {'W', 'A', 'V', 'E'};
-    char fmt[4] = {'f', 'm', 't', ' '};
-    uint32_t fmtSize = 16;
-    uint16_t audioFormat = 1;  // PCM
-    uint16_t numChannels;
-    uint32_t sampleRate;
-    uint32_t byteRate;
-    uint16_t blockAlign;
-    uint16_t bitsPerSample = 16;
-    char data[4] = {'d', 'a', 't', 'a'};
-    uint32_t dataSize;
-};
-
-bool writeWav(const std::string& filename, const std::vector<float>& samples,
-              int sampleRate, int numChannels) {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Error: Cannot open file for writing: " << filename << std::endl;
-        return false;
-    }
-
-    uint32_t numSamples = samples.size();
-    uint32_t dataSize = numSamples * sizeof(int16_t);
-
-    WavHeader header;
-    header.numChannels = numChannels;
-    header.sampleRate = sampleRate;
-    header.byteRate = sampleRate * numChannels * sizeof(int16_t);
-    header.blockAlign = numChannels * sizeof(int16_t);
-    header.dataSize = dataSize;
-    header.fileSize = sizeof(WavHeader) - 8 + dataSize;
+/**
+ * Streaming WAV writer
+ *
+ * Samples are converted into a 64 KiB buffer and written in large chunks
+ * as rendering runs; close() patches the RIFF/data sizes into the header,
+ * so memory stays flat however long the render is. Writes 16-bit PCM or
+ * 32-bit IEEE float (WAVE_FORMAT_IEEE_FLOAT, with the fact chunk that
+ * non-PCM files require).
+ */
+class WavWriter {
+public:
+    enum class Format { Int16, Float32 };
 
-    file.write(reinterpret_cast<char*>(&header), sizeof(header));
+    ~WavWriter() { close(); }
 
-    // Convert float samples to 16-bit PCM
-    for (float sample : samples) {
-        // Clamp to [-1, 1]
-        sample = std::max(-1.0f, std::min(1.0f, sample));
-        int16_t pcmSample = static_cast<int16_t>(sample * 32767.0f);
-        file.write(reinterpret_cast<char*>(&pcmSample), sizeof(pcmSample));
+    bool open(const std::string& filename, int sampleRate, int numChannels, Format fmt) {
+        file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Error: Cannot open file for writing: " << filename << std::endl;
+            return false;
+        }
+        format = fmt;
+        channels = numChannels;
+        samplesWritten = 0;
+        buffer.clear();
+        buffer.reserve(BUFFER_BYTES);
+
+        bool isFloat = (format == Format::Float32);
+        uint16_t bytesPerSample = isFloat ? 4 : 2;
+        uint16_t fmtSize = isFloat ? 18 : 16;  // Non-PCM adds a cbSize field
+
+        putTag("RIFF"); put32(0);  // Size patched in close()
+        putTag("WAVE");
+        putTag("fmt "); put32(fmtSize);
+        put16(isFloat ? 3 : 1);    // WAVE_FORMAT_IEEE_FLOAT / PCM
+        put16(numChannels);
+        put32(sampleRate);
+        put32(sampleRate * numChannels * bytesPerSample);
+        put16(numChannels * bytesPerSample);
+        put16(bytesPerSample * 8);
+        if (isFloat) {
+            put16(0);              // cbSize
+            putTag("fact"); put32(4);
+            factOffset = buffer.size();
+            put32(0);              // Frame count patched in close()
+        }
+        putTag("data");
+        dataSizeOffset = buffer.size();
+        put32(0);                  // Size patched in close()
+        headerBytes = buffer.size();
+        return true;
     }
 
-    return true;
-}
-
-// ============================================================================
-// DSP Factory
-// ============================================================================
-
-std::unique_ptr<AbstractDSP> createDSP(const std::string& moduleName) {
-    if (moduleName == "LadderLPF") return createLadderLPF();
-    if (moduleName == "BigReverb") return createBigReverb();
-    if (moduleName == "SaturationEcho") return createSaturationEcho();
-    if (moduleName == "SpectralResonator") return createSpectralResonator();
-    if (moduleName == "ModalBell") return createModalBell();
-    if (moduleName == "PluckedString") return createPluckedString();
-    if (moduleName == "ChaosFlute") return createChaosFlute();
-    if (moduleName == "TriPhaseEnsemble") return createTriPhaseEnsemble();
-    if (moduleName == "InfiniteFolder") return createInfiniteFolder();
-    if (moduleName == "SpaceCello") return createSpaceCello();
-    if (moduleName == "TheAbyss") return createTheAbyss();
-    if (moduleName == "Matter") return createMatter();
-    if (moduleName == "TheCauldron") return createTheCauldron();
-    if (moduleName == "VektorX") return createVektorX();
-    if (moduleName == "AnalogDrums") return createAnalogDrums();
-    if (moduleName == "ACID9Voice") return createACID9Voice();
-    if (moduleName == "TetanusCoil") return createTetanusCoil();
-    if (moduleName == "NutShaker") return createNutShaker();
-    if (moduleName == "PhysicalChoir") return createPhysicalChoir();
-    if (moduleName == "ChaosPad") return createChaosPad();
-    if (moduleName == "Linkage") return createLinkage();
-    if (moduleName == "SpectraHenge") return createSpectraHenge();
-    return nullptr;
-}
-
-std::vector<std::string> getModuleNames() {
-    return {"LadderLPF", "BigReverb", "SaturationEcho", "SpectralResonator",
-            "ModalBell", "PluckedString", "ChaosFlute", "TriPhaseEnsemble",
-            "InfiniteFolder", "SpaceCello", "TheAbyss", "Matter",
-            "TheCauldron", "VektorX", "AnalogDrums", "ACID9Voice", "TetanusCoil",
-            "NutShaker", "PhysicalChoir", "ChaosPad", "Linkage",
-            "SpectraHenge"};
-}
-
-// ============================================================================
-// Module Config Loading
-// ============================================================================
-
-// Find the project root by looking for CMakeLists.txt or plugin.json
-std::string findProjectRoot() {
-    // Try relative paths from where faust_render is typically located
-    std::vector<std::string> candidates = {
-        "..",           // build/test -> build -> project_root
-        "../..",        // build/test -> project_root
-        "../../..",     // nested build dirs
-        "."             // current directory
-    };
-
-    for (const auto& candidate : candidates) {
-        std::string test_path = candidate + "/plugin.json";
-        std::ifstream f(test_path);
-        if (f.good()) {
-            return candidate;
+    // Append interleaved samples
+    void write(const float* samples, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            float sample = samples[i];
+            if (format == Format::Float32) {
+                uint32_t bits;
+                std::memcpy(&bits, &sample, sizeof(bits));
+                put32(bits);
+            } else {
+                // Clamp to [-1, 1]
+                sample = std::max(-1.0f, std::min(1.0f, sample));
+                put16(static_cast<uint16_t>(static_cast<int16_t>(sample * 32767.0f)));
+            }
+            if (buffer.size() >= BUFFER_BYTES) flush();
         }
+        samplesWritten += count;
     }
-    return ".";  // fallback to current directory
-}
 
-// Load module config from its directory
-ModuleTestConfig loadModuleConfig(const std::string& moduleName) {
-    std::string projectRoot = findProjectRoot();
-    std::string configPath = projectRoot + "/src/modules/" + moduleName + "/test_config.json";
+    // Flush remaining samples and patch the header sizes
+    bool close() {
+        if (!file.is_open()) return true;
+        flush();
 
-    ModuleTestConfig config = load_module_config(configPath, moduleName);
+        uint64_t dataBytes = samplesWritten * (format == Format::Float32 ? 4 : 2);
+        patch32(4, static_cast<uint32_t>(headerBytes - 8 + dataBytes));
+        patch32(dataSizeOffset, static_cast<uint32_t>(dataBytes));
+        if (format == Format::Float32) {
+            patch32(factOffset, static_cast<uint32_t>(samplesWritten / std::max(1, channels)));
+        }
 
-    // If config file not found, use defaults based on legacy hardcoded rules
-    if (config.module_type == ModuleType::Instrument &&
-        config.test_scenarios.size() == 1 &&
-        config.test_scenarios[0].name == "default") {
+        bool ok = file.good();
+        file.close();
+        return ok;
+    }
 
-        // Apply legacy type detection for backwards compatibility
-        if (moduleName == "LadderLPF" || moduleName == "InfiniteFolder") {
-            config.module_type = ModuleType::Filter;
-        } else if (moduleName == "SpectralResonator") {
-            config.module_type = ModuleType::Resonator;
-        } else if (moduleName == "BigReverb" || moduleName == "SaturationEcho" ||
-                   moduleName == "TriPhaseEnsemble") {
-            config.module_type = ModuleType::Effect;
+private:
+    static constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+    std::ofstream file;
+    std::vector<char> buffer;
+    Format format = Format::Int16;
+    int channels = 1;
+    uint64_t samplesWritten = 0;
+    size_t headerBytes = 0;
+    size_t dataSizeOffset = 0;
+    size_t factOffset = 0;
+
+    void flush() {
+        if (!buffer.empty()) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
         }
+    }
 
-        // Apply legacy hot signal detection
-        if (moduleName == "InfiniteFolder") {
-            config.thresholds.allow_hot_signal = true;
-        }
+    // Little-endian field writers (WAV is little-endian on every host)
+    void put16(uint16_t v) {
+        buffer.push_back(static_cast<char>(v & 0xFF));
+        buffer.push_back(static_cast<char>(v >> 8));
+    }
+    void put32(uint32_t v) {
+        put16(static_cast<uint16_t>(v & 0xFFFF));
+        put16(static_cast<uint16_t>(v >> 16));
     }
+    void putTag(const char* tag) {
+        buffer.insert(buffer.end(), tag, tag + 4);
+    }
+    void patch32(size_t offset, uint32_t v) {
+        char bytes[4] = {static_cast<char>(v & 0xFF), static_cast<char>((v >> 8) & 0xFF),
+                         static_cast<char>((v >> 16) & 0xFF), static_cast<char>(v >> 24)};
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(bytes, 4);
+    }
+};
 
-    return config;
-}
+/**
+ * Destination for rendered frames: streams them to the WAV writer and/or
+ * keeps them in memory (--serve), and accumulates the level/clipping
+ * statistics and the spectrum of the mono mix as the render runs, so the
+ * metrics never need the whole file
+ */
+struct AudioSink {
+    WavWriter* wav = nullptr;                // nullptr = no file
+    std::vector<float>* capture = nullptr;   // Interleaved frames, nullptr = not kept
+    float peak = 0.0f;
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    uint64_t clipCount = 0;
+    uint64_t silentCount = 0;
+    uint64_t nonFiniteCount = 0;
+    uint64_t samples = 0;
+    uint64_t zeroCrossings = 0;   // Of the mono mix
+    float lastMono = 0.0f;
+    StreamingSpectrum spectrum;
+
+    void writeFrame(const float* frame, int numChannels) {
+        const float clipThreshold = 0.99f;     // Consider clipped if >= 99% of max
+        const float silenceThreshold = 0.001f;
+        float mono = 0.0f;
+        for (int ch = 0; ch < numChannels; ch++) {
+            if (!std::isfinite(frame[ch])) {
+                nonFiniteCount++;
+                continue;
+            }
+            mono += frame[ch];
+            float absSample = std::abs(frame[ch]);
+            peak = std::max(peak, absSample);
+            sum += frame[ch];
+            sumSquares += frame[ch] * frame[ch];
+            if (absSample >= clipThreshold) clipCount++;
+            if (absSample < silenceThreshold) silentCount++;
+        }
+        samples += numChannels;
+        mono /= std::max(1, numChannels);
+        if ((mono >= 0.0f) != (lastMono >= 0.0f)) zeroCrossings++;
+        lastMono = mono;
+        spectrum.push(mono);
+        if (wav) wav->write(frame, numChannels);
+        if (capture) capture->insert(capture->end(), frame, frame + numChannels);
+    }
+};
 
 // List available scenarios for a module
 void listScenarios(const ModuleTestConfig& config) {
@@ -222,9 +244,9 @@ void listScenarios(const ModuleTestConfig& config) {
 // Audio Rendering
 // ============================================================================
 
-std::vector<float> renderAudio(AbstractDSP& dsp, int sampleRate, float duration,
-                               ModuleType type, bool noAutoGate = false,
-                               const TestScenario* scenario = nullptr) {
+void renderAudio(AbstractDSP& dsp, int sampleRate, float duration,
+                 ModuleType type, AudioSink& out, bool noAutoGate = false,
+                 const TestScenario* scenario = nullptr) {
     int numSamples = static_cast<int>(duration * sampleRate);
     int numInputs = dsp.getNumInputs();
     int numOutputs = dsp.getNumOutputs();
@@ -237,10 +259,6 @@ std::vector<float> renderAudio(AbstractDSP& dsp, int sampleRate, float duration,
     for (int i = 0; i < numInputs; i++) inputPtrs[i] = &inputBuffer[i];
     for (int i = 0; i < numOutputs; i++) outputPtrs[i] = &outputBuffer[i];
 
-    // Output samples (interleaved if stereo)
-    std::vector<float> output;
-    output.reserve(numSamples * numOutputs);
-
     // Random generator for noise
     std::mt19937 rng(42);
     std::uniform_real_distribution<float> noiseDist(-1.0f, 1.0f);
@@ -355,13 +373,9 @@ std::vector<float> renderAudio(AbstractDSP& dsp, int sampleRate, float duration,
         // Process one sample
         dsp.compute(1, inputPtrs.data(), outputPtrs.data());
 
-        // Collect output (interleave if stereo)
-        for (int ch = 0; ch < numOutputs; ch++) {
-            output.push_back(outputBuffer[ch]);
-        }
+        // Stream output (interleaved if stereo)
+        out.writeFrame(outputBuffer.data(), numOutputs);
     }
-
-    return output;
 }
 
 // ============================================================================
@@ -423,9 +437,9 @@ ShowcaseConfig getDefaultShowcaseConfig(ModuleType type) {
 }
 
 // Render showcase audio with multiple notes and parameter automations
-std::vector<float> renderShowcaseAudio(AbstractDSP& dsp, int sampleRate,
-                                        const ShowcaseConfig& showcase,
-                                        ModuleType type) {
+void renderShowcaseAudio(AbstractDSP& dsp, int sampleRate,
+                         const ShowcaseConfig& showcase,
+                         ModuleType type, AudioSink& out) {
     int numSamples = static_cast<int>(showcase.duration * sampleRate);
     int numInputs = dsp.getNumInputs();
     int numOutputs = dsp.getNumOutputs();
@@ -438,10 +452,6 @@ std::vector<float> renderShowcaseAudio(AbstractDSP& dsp, int sampleRate,
     for (int i = 0; i < numInputs; i++) inputPtrs[i] = &inputBuffer[i];
     for (int i = 0; i < numOutputs; i++) outputPtrs[i] = &outputBuffer[i];
 
-    // Output samples
-    std::vector<float> output;
-    output.reserve(numSamples * numOutputs);
-
     // Random generator for noise
     std::mt19937 rng(42);
     std::uniform_real_distribution<float> noiseDist(-1.0f, 1.0f);
@@ -609,13 +619,9 @@ std::vector<float> renderShowcaseAudio(AbstractDSP& dsp, int sampleRate,
         // Process one sample
         dsp.compute(1, inputPtrs.data(), outputPtrs.data());
 
-        // Collect output
-        for (int ch = 0; ch < numOutputs; ch++) {
-            output.push_back(outputBuffer[ch]);
-        }
+        // Stream output
+        out.writeFrame(outputBuffer.data(), numOutputs);
     }
-
-    return output;
 }
 
 // ============================================================================
@@ -629,6 +635,7 @@ void printUsage(const char* programName) {
               << "  --output FILE       Output WAV file (default: output.wav)\n"
               << "  --duration SECS     Duration in seconds (default: 2.0)\n"
               << "  --sample-rate RATE  Sample rate (default: 48000)\n"
+              << "  --format FORMAT     WAV sample format: int16 or float32 (default: int16)\n"
               << "  --param NAME=VALUE  Set parameter value (can repeat)\n"
               << "  --scenario NAME     Use a pre-defined test scenario\n"
               << "  --showcase          Render showcase audio with multiple notes and automations\n"
@@ -638,13 +645,22 @@ void printUsage(const char* programName) {
               << "  --list-scenarios    List test scenarios for module\n"
               << "  --show-config       Show module test configuration\n"
               << "  --no-auto-gate      Disable automatic gate/trigger handling\n"
+              << "  --json              Print the metrics as one JSON line (log to stderr)\n"
+              << "  --no-wav            Compute the metrics without writing a WAV file\n"
+              << "  --warmup SECS       Render and discard SECS seconds before the output starts\n"
+              << "  --jobs FILE         Render a JSON-lines job file (\"-\" = stdin), one result line per job\n"
+              << "  --workers N         Worker threads for --jobs (default: all cores)\n"
+              << "  --serve             Answer JSON-lines render/analyze requests on stdin/stdout\n"
               << "  --help              Show this help\n\n"
               << "Examples:\n"
               << "  " << programName << " --module LadderLPF --list-params\n"
               << "  " << programName << " --module ChaosFlute --list-scenarios\n"
               << "  " << programName << " --module ChaosFlute --scenario high_chaos\n"
               << "  " << programName << " --module ChaosFlute --showcase --output showcase.wav\n"
-              << "  " << programName << " --module TheAbyss --output test.wav --param decay=0.8\n";
+              << "  " << programName << " --module TheAbyss --output test.wav --param decay=0.8\n"
+              << "  " << programName << " --module TheAbyss --no-wav --json --param decay=0.8\n"
+              << "  " << programName << " --jobs sweep.jsonl --workers 16\n"
+              << "  " << programName << " --serve\n";
 }
 
 struct Options {
@@ -661,8 +677,27 @@ struct Options {
     bool showConfig = false;
     bool noAutoGate = false;  // Disable automatic gate/trigger handling
     bool showcase = false;    // Render showcase audio with multiple notes/automations
+    WavWriter::Format wavFormat = WavWriter::Format::Int16;
+    std::string jobsFile;     // Batch mode: JSON-lines job file ("-" = stdin)
+    int workers = 0;          // Batch mode worker threads (0 = all cores)
+    bool serve = false;       // Answer render requests on stdin/stdout
+    bool json = false;        // Print a JSON metrics summary (log goes to stderr)
+    bool noWav = false;       // Metrics only, no output file
+    float warmup = 0.0f;      // Seconds rendered (and discarded) before the job
+    std::map<std::string, float> warmupParams;  // Parameters during the warm-up
 };
 
+bool parseWavFormat(const std::string& name, WavWriter::Format& format) {
+    if (name == "int16") {
+        format = WavWriter::Format::Int16;
+    } else if (name == "float32" || name == "float") {
+        format = WavWriter::Format::Float32;
+    } else {
+        return false;
+    }
+    return true;
+}
+
 bool parseArgs(int argc, char** argv, Options& opts) {
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -699,6 +734,33 @@ bool parseArgs(int argc, char** argv, Options& opts) {
             opts.showcaseConfigFile = argv[++i];
             continue;
         }
+        if (arg == "--format" && i + 1 < argc) {
+            if (!parseWavFormat(argv[++i], opts.wavFormat)) {
+                std::cerr << "Unknown WAV format: " << argv[i] << " (use int16 or float32)\n";
+                return false;
+            }
+            continue;
+        }
+        if (arg == "--json") {
+            opts.json = true;
+            continue;
+        }
+        if (arg == "--no-wav") {
+            opts.noWav = true;
+            continue;
+        }
+        if (arg == "--serve") {
+            opts.serve = true;
+            continue;
+        }
+        if (arg == "--jobs" && i + 1 < argc) {
+            opts.jobsFile = argv[++i];
+            continue;
+        }
+        if (arg == "--workers" && i + 1 < argc) {
+            opts.workers = std::stoi(argv[++i]);
+            continue;
+        }
         if (arg == "--scenario" && i + 1 < argc) {
             opts.scenario = argv[++i];
             continue;
@@ -711,6 +773,10 @@ bool parseArgs(int argc, char** argv, Options& opts) {
             opts.outputFile = argv[++i];
             continue;
         }
+        if (arg == "--warmup" && i + 1 < argc) {
+            opts.warmup = std::stof(argv[++i]);
+            continue;
+        }
         if (arg == "--duration" && i + 1 < argc) {
             opts.duration = std::stof(argv[++i]);
             continue;
@@ -736,6 +802,662 @@ bool parseArgs(int argc, char** argv, Options& opts) {
     return true;
 }
 
+// ============================================================================
+// Rendering
+// ============================================================================
+
+struct RenderStats {
+    float peak = 0.0f;
+    float rms = 0.0f;
+    float crestFactor = 0.0f;
+    float dcOffset = 0.0f;
+    float clipPercent = 0.0f;
+    float silencePercent = 0.0f;
+    uint64_t nonFinite = 0;   // NaN / inf samples
+    float zeroCrossingRate = 0.0f;   // Crossings per sample of the mono mix
+    StreamingSpectrum::Summary spectral;
+    int frames = 0;
+    int channels = 0;
+};
+
+/**
+ * Render one module/parameter set into a sink
+ *
+ * dsp must already be initialized at opts.sampleRate. When the job has an
+ * output file the audio is streamed to it; sink.capture (if set) keeps it
+ * in memory as well. Progress and the audio analysis go to `log`; on
+ * failure `error` says why.
+ */
+bool renderJob(const Options& job, AbstractDSP& dsp, const ModuleTestConfig& config,
+               AudioSink& sink, std::ostream& log, RenderStats& stats, std::string& error) {
+    Options opts = job;
+
+    // Find the scenario to use (if any)
+    const TestScenario* scenario = nullptr;
+    if (!opts.scenario.empty()) {
+        for (const auto& s : config.test_scenarios) {
+            if (s.name == opts.scenario) {
+                scenario = &s;
+                break;
+            }
+        }
+        if (!scenario) {
+            error = "Unknown scenario: " + opts.scenario +
+                    " (use --list-scenarios to see available scenarios)";
+            return false;
+        }
+        log << "Using scenario: " << scenario->name;
+        if (!scenario->description.empty()) {
+            log << " (" << scenario->description << ")";
+        }
+        log << "\n";
+
+        // Apply scenario duration if not overridden
+        if (opts.duration == 2.0f && scenario->duration != 2.0f) {
+            opts.duration = scenario->duration;
+        }
+    }
+
+    // Apply scenario parameters first
+    if (scenario) {
+        for (const auto& kv : scenario->parameters) {
+            int idx = dsp.getParamIndex(kv.first.c_str());
+            if (idx >= 0) {
+                dsp.setParamValue(idx, kv.second);
+                log << "Set (scenario) " << kv.first << " = " << kv.second << "\n";
+            }
+        }
+    }
+
+    // Set command-line parameters (override scenario)
+    for (const auto& kv : opts.params) {
+        int idx = dsp.getParamIndex(kv.first.c_str());
+        if (idx >= 0) {
+            dsp.setParamValue(idx, kv.second);
+            log << "Set " << kv.first << " = " << kv.second << "\n";
+        } else {
+            std::cerr << "Warning: Unknown parameter: " << kv.first << "\n";
+        }
+    }
+
+    // Warn if this module skips audio tests
+    if (config.skip_audio_tests) {
+        log << "\nNote: This module has skip_audio_tests=true";
+        if (!config.skip_reason.empty()) {
+            log << " (" << config.skip_reason << ")";
+        }
+        log << "\n";
+    }
+
+    ModuleType type = config.module_type;
+
+    // Stream straight to the WAV file as rendering runs
+    int numChannels = dsp.getNumOutputs();
+    WavWriter wav;
+    if (!opts.outputFile.empty()) {
+        if (!wav.open(opts.outputFile, opts.sampleRate, numChannels, opts.wavFormat)) {
+            error = "Cannot write " + opts.outputFile;
+            return false;
+        }
+        sink.wav = &wav;
+    }
+
+    // Render using showcase mode or standard mode
+    if (opts.showcase) {
+        // Get showcase config (from custom file, test_config.json, or generate default)
+        ShowcaseConfig showcase;
+        if (!opts.showcaseConfigFile.empty()) {
+            // Load from custom config file
+            ModuleTestConfig customConfig = load_module_config(opts.showcaseConfigFile, opts.moduleName);
+            if (customConfig.showcase.enabled) {
+                showcase = customConfig.showcase;
+                type = customConfig.module_type;  // Also use the type from custom config
+                log << "Using showcase config from " << opts.showcaseConfigFile << "\n";
+            } else {
+                showcase = getDefaultShowcaseConfig(type);
+                log << "Custom config has no showcase, using default\n";
+            }
+        } else if (config.showcase.enabled) {
+            showcase = config.showcase;
+            log << "Using showcase config from test_config.json\n";
+        } else {
+            showcase = getDefaultShowcaseConfig(type);
+            log << "Using default showcase config for " << module_type_to_string(type) << "\n";
+        }
+
+        log << "Rendering showcase for " << opts.moduleName << " ("
+            << showcase.duration << "s at " << opts.sampleRate << "Hz)...\n";
+        log << "  Notes: " << showcase.notes.size() << "\n";
+        log << "  Automations: " << showcase.automations.size() << "\n";
+        log << "  Triggers: " << showcase.trigger_sequence.size() << "\n";
+
+        renderShowcaseAudio(dsp, opts.sampleRate, showcase, type, sink);
+    } else {
+        // Standard render
+        log << "Rendering " << opts.moduleName << " for " << opts.duration
+            << "s at " << opts.sampleRate << "Hz...\n";
+
+        renderAudio(dsp, opts.sampleRate, opts.duration, type, sink, opts.noAutoGate, scenario);
+    }
+
+    sink.wav = nullptr;
+    if (!opts.outputFile.empty() && !wav.close()) {
+        error = "Cannot write " + opts.outputFile;
+        return false;
+    }
+
+    // Analyze audio for distortion/clipping
+    float peakAbs = sink.peak;
+    uint64_t clipCount = sink.clipCount;
+    uint64_t numSamples = std::max<uint64_t>(1, sink.samples);
+    float rms = static_cast<float>(std::sqrt(sink.sumSquares / numSamples));
+    float crestFactor = (rms > 0.001f) ? (peakAbs / rms) : 0.0f;
+    float clipPercent = 100.0f * clipCount / numSamples;
+    if (sink.nonFiniteCount > 0) {
+        log << "WARNING: " << sink.nonFiniteCount << " NaN/inf samples!\n";
+    }
+
+    log << "\n=== Audio Analysis ===\n";
+    log << "Peak amplitude: " << peakAbs << " (" << (20.0f * std::log10(std::max(peakAbs, 0.0001f))) << " dB)\n";
+    log << "RMS level: " << rms << " (" << (20.0f * std::log10(std::max(rms, 0.0001f))) << " dB)\n";
+    log << "Crest factor: " << crestFactor << " (" << (20.0f * std::log10(std::max(crestFactor, 0.0001f))) << " dB)\n";
+    log << "Clipped samples: " << clipCount << " (" << clipPercent << "%)\n";
+    StreamingSpectrum::Summary spectral = sink.spectrum.summarize(static_cast<float>(opts.sampleRate));
+    log << "Spectral centroid: " << spectral.centroidHz << " Hz (rolloff " << spectral.rolloffHz
+        << " Hz, flatness " << spectral.flatness << ")\n";
+
+    float clipThresholdPercent = config.thresholds.effective_clipping_max();
+    if (clipPercent > clipThresholdPercent) {
+        log << "WARNING: Clipping exceeds threshold (" << clipPercent << "% > "
+            << clipThresholdPercent << "%)!\n";
+    } else if (peakAbs > 1.0f) {
+        log << "WARNING: Output exceeds unity gain (peak=" << peakAbs << ")!\n";
+    }
+    log << "Clipping threshold: " << clipThresholdPercent << "%";
+    if (config.thresholds.allow_hot_signal) {
+        log << " (hot signal module)";
+    }
+    log << "\n======================\n\n";
+
+    int frames = static_cast<int>(sink.samples / std::max(1, numChannels));
+    if (!opts.outputFile.empty()) {
+        log << "Wrote " << opts.outputFile << " ("
+            << frames << " samples, "
+            << numChannels << " channels"
+            << (opts.wavFormat == WavWriter::Format::Float32 ? ", 32-bit float" : "") << ")\n";
+    }
+
+    stats.peak = peakAbs;
+    stats.rms = rms;
+    stats.crestFactor = crestFactor;
+    stats.dcOffset = static_cast<float>(sink.sum / numSamples);
+    stats.clipPercent = clipPercent;
+    stats.silencePercent = 100.0f * sink.silentCount / numSamples;
+    stats.nonFinite = sink.nonFiniteCount;
+    stats.zeroCrossingRate = static_cast<float>(sink.zeroCrossings) / std::max(1, frames);
+    stats.spectral = spectral;
+    stats.frames = frames;
+    stats.channels = numChannels;
+    return true;
+}
+
+// Render one module/parameter set to its WAV file
+bool renderToFile(const Options& job, AbstractDSP& dsp, const ModuleTestConfig& config,
+                  std::ostream& log, RenderStats& stats, std::string& error) {
+    AudioSink sink;
+    return renderJob(job, dsp, config, sink, log, stats, error);
+}
+
+// ============================================================================
+// Warm Starts
+// ============================================================================
+
+// Jobs with the same key can start from the same warm-up snapshot
+std::string warmStartKey(const Options& job) {
+    std::ostringstream key;
+    key << job.moduleName << '|' << job.sampleRate << '|' << job.scenario << '|'
+        << job.noAutoGate << '|' << job.warmup;
+    for (const auto& kv : job.warmupParams) {
+        key << '|' << kv.first << '=' << kv.second;
+    }
+    return key.str();
+}
+
+/**
+ * Render a job's warm-up and snapshot the DSP state after it
+ *
+ * The warm-up is job.warmup seconds of the job's scenario with
+ * warmup_params in place of the job's own params, and writes nothing.
+ * Restoring the snapshot puts the DSP where the warm-up left it (reverb
+ * tails, envelopes, filter states), so a sweep renders the warm-up once
+ * instead of once per job. dsp is left in the warmed-up state.
+ */
+bool takeWarmStart(const Options& job, AbstractDSP& dsp, const ModuleTestConfig& config,
+                   DSPSnapshot& snapshot, std::string& error) {
+    Options warm = job;
+    warm.duration = job.warmup;
+    warm.params = job.warmupParams;
+    warm.outputFile.clear();
+    warm.showcase = false;
+
+    dsp.init(job.sampleRate);
+    AudioSink sink;
+    RenderStats stats;
+    std::ostream nullLog(nullptr);
+    if (!renderJob(warm, dsp, config, sink, nullLog, stats, error)) {
+        error = "warm-up: " + error;
+        return false;
+    }
+    snapshot.take(dsp, job.sampleRate);
+    return true;
+}
+
+// ============================================================================
+// Batch (Job File) Mode
+// ============================================================================
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) continue;
+                out += c;
+        }
+    }
+    return out;
+}
+
+/**
+ * Read one job object (the --jobs / --serve keys) on top of `defaults`
+ *
+ *   {"module": "LadderLPF", "output": "a.wav", "params": {"cutoff": 0.3}}
+ *
+ * Optional keys: duration, sample_rate, format, scenario, showcase,
+ * showcase_config, no_auto_gate, warmup (seconds), warmup_params. Anything
+ * not given falls back to `defaults`.
+ */
+bool parseJob(const JsonValue& json, const Options& defaults, Options& job, std::string& error) {
+    if (!json.is_object() || !json["module"].is_string()) {
+        error = "expected an object with \"module\"";
+        return false;
+    }
+
+    job = defaults;
+    job.moduleName = json["module"].get_string();
+    if (json.has("output")) job.outputFile = json["output"].get_string();
+    job.duration = static_cast<float>(json["duration"].get_number(job.duration));
+    job.sampleRate = static_cast<int>(json["sample_rate"].get_number(job.sampleRate));
+    if (json.has("scenario")) job.scenario = json["scenario"].get_string();
+    if (json.has("showcase_config")) job.showcaseConfigFile = json["showcase_config"].get_string();
+    job.showcase = json["showcase"].get_bool(job.showcase);
+    job.noAutoGate = json["no_auto_gate"].get_bool(job.noAutoGate);
+    if (json.has("format") && !parseWavFormat(json["format"].get_string(), job.wavFormat)) {
+        error = "unknown format";
+        return false;
+    }
+    for (const auto& kv : json["params"].object_val) {
+        job.params[kv.first] = static_cast<float>(kv.second.get_number());
+    }
+    job.warmup = static_cast<float>(json["warmup"].get_number(job.warmup));
+    for (const auto& kv : json["warmup_params"].object_val) {
+        job.warmupParams[kv.first] = static_cast<float>(kv.second.get_number());
+    }
+    return true;
+}
+
+// Parse a job file: one job object per line (blank lines skipped); a job
+// without "output" only reports its metrics
+bool loadJobs(const std::string& path, const Options& defaults,
+              std::vector<Options>& jobs) {
+    std::ifstream file;
+    std::istream* in = &std::cin;
+    if (path != "-") {
+        file.open(path);
+        if (!file) {
+            std::cerr << "Error: Cannot open job file: " << path << "\n";
+            return false;
+        }
+        in = &file;
+    }
+
+    Options jobDefaults = defaults;
+    jobDefaults.outputFile.clear();
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(*in, line)) {
+        lineNo++;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        JsonValue json = parse_json(line);
+        Options job;
+        std::string error;
+        if (!parseJob(json, jobDefaults, job, error)) {
+            std::cerr << "Error: " << path << ":" << lineNo << ": " << error << "\n";
+            return false;
+        }
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+// Result fields shared by --jobs and --serve (leading comma, no braces)
+std::string statsJson(const RenderStats& stats) {
+    char buf[640];
+    std::snprintf(buf, sizeof(buf),
+                  ", \"peak\": %.6f, \"rms\": %.6f, \"crest_factor\": %.4f"
+                  ", \"dc_offset\": %.6f, \"clip_percent\": %.4f, \"silence_percent\": %.4f"
+                  ", \"non_finite\": %llu, \"zero_crossing_rate\": %.5f"
+                  ", \"spectral_centroid\": %.1f, \"spectral_spread\": %.1f"
+                  ", \"spectral_rolloff\": %.1f, \"spectral_flatness\": %.5f"
+                  ", \"spectral_entropy\": %.5f, \"frames\": %d, \"channels\": %d",
+                  stats.peak, stats.rms, stats.crestFactor, stats.dcOffset,
+                  stats.clipPercent, stats.silencePercent,
+                  static_cast<unsigned long long>(stats.nonFinite), stats.zeroCrossingRate,
+                  stats.spectral.centroidHz, stats.spectral.spreadHz,
+                  stats.spectral.rolloffHz, stats.spectral.flatness,
+                  stats.spectral.entropy, stats.frames, stats.channels);
+    return buf;
+}
+
+/**
+ * Render every job in the file on a pool of worker threads
+ *
+ * Each worker keeps one DSP instance per module and re-inits it between
+ * jobs; module configs are loaded once up front. One JSON result line is
+ * printed to stdout per job as it finishes (in completion order, tagged
+ * with the job's index, counting non-blank lines from 0).
+ *
+ * Faust class-level tables are filled by classInit() at a given sample
+ * rate and shared by every instance, so init() is serialized and jobs run
+ * in one phase per sample rate.
+ *
+ * Jobs with a warmup are warm-started: each distinct warm-up (see
+ * warmStartKey()) is rendered once at the start of its phase, and every
+ * job that shares it restores the snapshot instead of re-initing.
+ */
+int runJobs(const std::string& path, const Options& defaults, int numWorkers) {
+    std::vector<Options> jobs;
+    if (!loadJobs(path, defaults, jobs)) {
+        return 1;
+    }
+
+    std::map<std::string, ModuleTestConfig> configs;
+    for (const auto& job : jobs) {
+        if (configs.count(job.moduleName)) continue;
+        if (!createDSP(job.moduleName)) {
+            std::cerr << "Error: Unknown module: " << job.moduleName << "\n";
+            return 1;
+        }
+        configs[job.moduleName] = loadModuleConfig(job.moduleName);
+    }
+
+    std::map<int, std::vector<size_t>> phases;  // sample rate -> job indices
+    for (size_t i = 0; i < jobs.size(); i++) {
+        phases[jobs[i].sampleRate].push_back(i);
+    }
+
+    if (numWorkers <= 0) {
+        numWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    numWorkers = std::min<int>(numWorkers, static_cast<int>(std::max<size_t>(1, jobs.size())));
+
+    std::mutex initMutex;
+    std::mutex outputMutex;
+    std::atomic<int> failures{0};
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (const auto& phase : phases) {
+        const std::vector<size_t>& indices = phase.second;
+        std::atomic<size_t> next{0};
+
+        std::map<std::string, DSPSnapshot> warmStarts;
+        std::map<std::string, std::string> warmStartErrors;
+        for (size_t index : indices) {
+            const Options& job = jobs[index];
+            if (job.warmup <= 0.0f) continue;
+            std::string key = warmStartKey(job);
+            if (warmStarts.count(key) || warmStartErrors.count(key)) continue;
+            auto dsp = createDSP(job.moduleName);
+            std::string error;
+            if (!takeWarmStart(job, *dsp, configs.at(job.moduleName), warmStarts[key], error)) {
+                warmStarts.erase(key);
+                warmStartErrors[key] = error;
+            }
+        }
+
+        auto worker = [&]() {
+            std::map<std::string, std::unique_ptr<AbstractDSP>> dsps;
+            std::ostream nullLog(nullptr);
+
+            for (size_t n = next++; n < indices.size(); n = next++) {
+                size_t index = indices[n];
+                const Options& job = jobs[index];
+                auto t0 = std::chrono::steady_clock::now();
+
+                auto& dsp = dsps[job.moduleName];
+                if (!dsp) dsp = createDSP(job.moduleName);
+
+                RenderStats stats;
+                std::string error;
+                bool ok = true;
+                if (job.warmup > 0.0f) {
+                    std::string key = warmStartKey(job);
+                    auto it = warmStarts.find(key);
+                    if (it == warmStarts.end()) {
+                        error = warmStartErrors.at(key);
+                        ok = false;
+                    } else {
+                        std::lock_guard<std::mutex> lock(initMutex);
+                        it->second.restore(*dsp);
+                    }
+                } else {
+                    std::lock_guard<std::mutex> lock(initMutex);
+                    dsp->init(job.sampleRate);
+                }
+                ok = ok && renderToFile(job, *dsp, configs.at(job.moduleName), nullLog, stats, error);
+                double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
+                if (!ok) failures++;
+
+                char buf[256];
+                std::ostringstream line;
+                line << "{\"index\": " << index
+                     << ", \"module\": \"" << jsonEscape(job.moduleName) << "\""
+                     << ", \"output\": \"" << jsonEscape(job.outputFile) << "\""
+                     << ", \"ok\": " << (ok ? "true" : "false");
+                if (ok) {
+                    line << statsJson(stats);
+                } else {
+                    line << ", \"error\": \"" << jsonEscape(error) << "\"";
+                }
+                std::snprintf(buf, sizeof(buf), ", \"ms\": %.1f}", ms);
+                line << buf;
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << line.str() << std::endl;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        int phaseWorkers = std::min<int>(numWorkers, static_cast<int>(indices.size()));
+        for (int w = 0; w < phaseWorkers; w++) threads.emplace_back(worker);
+        for (auto& t : threads) t.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cerr << "Rendered " << (jobs.size() - failures) << "/" << jobs.size() << " jobs in "
+              << seconds << "s on " << numWorkers << " workers\n";
+    return failures > 0 ? 1 : 0;
+}
+
+// ============================================================================
+// Server Mode
+// ============================================================================
+
+/**
+ * Answer render requests on stdin/stdout, one JSON object per line
+ *
+ *   {"cmd": "render", "id": 7, "module": "LadderLPF", "params": {"cutoff": 0.3}}
+ *   {"cmd": "analyze", "module": "TheAbyss", "duration": 1.0}
+ *   {"cmd": "params", "module": "LadderLPF"}
+ *   {"cmd": "modules"}
+ *   {"cmd": "quit"}
+ *
+ * render and analyze take the --jobs keys, with "output" optional: without
+ * it nothing touches the disk. Both reply with one line of metrics; render
+ * then sends the audio itself, "bytes" bytes of interleaved 32-bit floats
+ * in native byte order, right after the newline. Every reply has "ok" and
+ * echoes the request's "id"; a bad request gets "error" and the server
+ * carries on.
+ *
+ * DSP instances and module configs are created on first use and kept for
+ * the whole session. Each request re-inits its instance, so a render never
+ * depends on the requests before it. A request with a warmup restores a
+ * cached snapshot of that warm-up (rendered on first use) instead.
+ */
+int runServer(const Options& defaults) {
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    std::map<std::string, std::unique_ptr<AbstractDSP>> dsps;
+    std::map<std::string, ModuleTestConfig> configs;
+    std::ostream nullLog(nullptr);
+    std::vector<float> audio;
+    std::map<std::string, DSPSnapshot> warmStarts;
+    const size_t MAX_WARM_STARTS = 64;
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        JsonValue request = parse_json(line);
+        std::string cmd = request["cmd"].get_string("render");
+        std::ostringstream reply;
+        reply << "{\"id\": ";
+        if (request["id"].is_number()) {
+            reply << static_cast<long long>(request["id"].get_number());
+        } else if (request["id"].is_string()) {
+            reply << "\"" << jsonEscape(request["id"].get_string()) << "\"";
+        } else {
+            reply << "null";
+        }
+
+        auto fail = [&](const std::string& error) {
+            reply << ", \"ok\": false, \"error\": \"" << jsonEscape(error) << "\"}\n";
+            std::cout << reply.str() << std::flush;
+        };
+
+        if (!request.is_object()) {
+            fail("expected a JSON object");
+            continue;
+        }
+        if (cmd == "quit") {
+            reply << ", \"ok\": true}\n";
+            std::cout << reply.str() << std::flush;
+            break;
+        }
+        if (cmd == "modules") {
+            reply << ", \"ok\": true, \"modules\": [";
+            std::vector<std::string> names = getModuleNames();
+            for (size_t i = 0; i < names.size(); i++) {
+                reply << (i ? ", " : "") << "\"" << names[i] << "\"";
+            }
+            reply << "]}\n";
+            std::cout << reply.str() << std::flush;
+            continue;
+        }
+        if (cmd != "render" && cmd != "analyze" && cmd != "params") {
+            fail("unknown cmd: " + cmd);
+            continue;
+        }
+
+        Options job;
+        std::string error;
+        Options jobDefaults = defaults;
+        jobDefaults.outputFile.clear();
+        if (!parseJob(request, jobDefaults, job, error)) {
+            fail(error);
+            continue;
+        }
+
+        auto& dsp = dsps[job.moduleName];
+        if (!dsp) dsp = createDSP(job.moduleName);
+        if (!dsp) {
+            dsps.erase(job.moduleName);
+            fail("Unknown module: " + job.moduleName);
+            continue;
+        }
+        if (!configs.count(job.moduleName)) {
+            configs[job.moduleName] = loadModuleConfig(job.moduleName);
+        }
+        dsp->init(job.sampleRate);
+
+        if (cmd == "params") {
+            reply << ", \"ok\": true, \"inputs\": " << dsp->getNumInputs()
+                  << ", \"outputs\": " << dsp->getNumOutputs() << ", \"params\": [";
+            for (int i = 0; i < dsp->getNumParams(); i++) {
+                char buf[256];
+                std::snprintf(buf, sizeof(buf), "\"min\": %g, \"max\": %g, \"init\": %g}",
+                              dsp->getParamMin(i), dsp->getParamMax(i), dsp->getParamInit(i));
+                reply << (i ? ", " : "") << "{\"path\": \"" << jsonEscape(dsp->getParamPath(i))
+                      << "\", " << buf;
+            }
+            reply << "]}\n";
+            std::cout << reply.str() << std::flush;
+            continue;
+        }
+
+        if (job.warmup > 0.0f) {
+            std::string key = warmStartKey(job);
+            auto it = warmStarts.find(key);
+            if (it == warmStarts.end()) {
+                if (warmStarts.size() >= MAX_WARM_STARTS) warmStarts.clear();
+                DSPSnapshot snapshot;
+                if (!takeWarmStart(job, *dsp, configs.at(job.moduleName), snapshot, error)) {
+                    fail(error);
+                    continue;
+                }
+                it = warmStarts.emplace(key, std::move(snapshot)).first;
+            }
+            it->second.restore(*dsp);
+        }
+
+        bool sendAudio = cmd == "render";
+        audio.clear();
+        AudioSink sink;
+        if (sendAudio) sink.capture = &audio;
+
+        auto t0 = std::chrono::steady_clock::now();
+        RenderStats stats;
+        if (!renderJob(job, *dsp, configs.at(job.moduleName), sink, nullLog, stats, error)) {
+            fail(error);
+            continue;
+        }
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count();
+
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), ", \"sample_rate\": %d, \"ms\": %.1f",
+                      job.sampleRate, ms);
+        reply << ", \"ok\": true" << statsJson(stats) << buf;
+        if (sendAudio) reply << ", \"bytes\": " << audio.size() * sizeof(float);
+        reply << "}\n";
+        std::cout << reply.str();
+        if (sendAudio) {
+            std::cout.write(reinterpret_cast<const char*>(audio.data()),
+                            static_cast<std::streamsize>(audio.size() * sizeof(float)));
+        }
+        std::cout << std::flush;
+    }
+    return 0;
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -755,6 +1477,15 @@ int main(int argc, char** argv) {
         return 0;
     }
 
+    if (opts.serve) {
+        return runServer(opts);
+    }
+
+    // Batch mode
+    if (!opts.jobsFile.empty()) {
+        return runJobs(opts.jobsFile, opts, opts.workers);
+    }
+
     // Check module name
     if (opts.moduleName.empty()) {
         std::cerr << "Error: --module is required\n";
@@ -817,149 +1548,31 @@ int main(int argc, char** argv) {
         return 0;
     }
 
-    // Find the scenario to use (if any)
-    const TestScenario* scenario = nullptr;
-    if (!opts.scenario.empty()) {
-        for (const auto& s : config.test_scenarios) {
-            if (s.name == opts.scenario) {
-                scenario = &s;
-                break;
-            }
-        }
-        if (!scenario) {
-            std::cerr << "Error: Unknown scenario: " << opts.scenario << "\n";
-            std::cerr << "Use --list-scenarios to see available scenarios\n";
-            return 1;
-        }
-        std::cout << "Using scenario: " << scenario->name;
-        if (!scenario->description.empty()) {
-            std::cout << " (" << scenario->description << ")";
-        }
-        std::cout << "\n";
-
-        // Apply scenario duration if not overridden
-        if (opts.duration == 2.0f && scenario->duration != 2.0f) {
-            opts.duration = scenario->duration;
-        }
-    }
-
-    // Apply scenario parameters first
-    if (scenario) {
-        for (const auto& kv : scenario->parameters) {
-            int idx = dsp->getParamIndex(kv.first.c_str());
-            if (idx >= 0) {
-                dsp->setParamValue(idx, kv.second);
-                std::cout << "Set (scenario) " << kv.first << " = " << kv.second << "\n";
-            }
-        }
-    }
-
-    // Set command-line parameters (override scenario)
-    for (const auto& kv : opts.params) {
-        int idx = dsp->getParamIndex(kv.first.c_str());
-        if (idx >= 0) {
-            dsp->setParamValue(idx, kv.second);
-            std::cout << "Set " << kv.first << " = " << kv.second << "\n";
-        } else {
-            std::cerr << "Warning: Unknown parameter: " << kv.first << "\n";
-        }
+    if (opts.noWav) {
+        opts.outputFile.clear();
     }
 
-    // Warn if this module skips audio tests
-    if (config.skip_audio_tests) {
-        std::cout << "\nNote: This module has skip_audio_tests=true";
-        if (!config.skip_reason.empty()) {
-            std::cout << " (" << config.skip_reason << ")";
-        }
-        std::cout << "\n";
+    RenderStats stats;
+    std::string error;
+    bool ok = true;
+    if (opts.warmup > 0.0f) {
+        DSPSnapshot snapshot;
+        ok = takeWarmStart(opts, *dsp, config, snapshot, error);
     }
-
-    ModuleType type = config.module_type;
-    std::vector<float> samples;
-
-    // Render using showcase mode or standard mode
-    if (opts.showcase) {
-        // Get showcase config (from custom file, test_config.json, or generate default)
-        ShowcaseConfig showcase;
-        if (!opts.showcaseConfigFile.empty()) {
-            // Load from custom config file
-            ModuleTestConfig customConfig = load_module_config(opts.showcaseConfigFile, opts.moduleName);
-            if (customConfig.showcase.enabled) {
-                showcase = customConfig.showcase;
-                type = customConfig.module_type;  // Also use the type from custom config
-                std::cout << "Using showcase config from " << opts.showcaseConfigFile << "\n";
-            } else {
-                showcase = getDefaultShowcaseConfig(type);
-                std::cout << "Custom config has no showcase, using default\n";
-            }
-        } else if (config.showcase.enabled) {
-            showcase = config.showcase;
-            std::cout << "Using showcase config from test_config.json\n";
+    ok = ok && renderToFile(opts, *dsp, config, opts.json ? std::cerr : std::cout, stats, error);
+    if (opts.json) {
+        std::cout << "{\"module\": \"" << jsonEscape(opts.moduleName) << "\""
+                  << ", \"output\": \"" << jsonEscape(opts.outputFile) << "\""
+                  << ", \"ok\": " << (ok ? "true" : "false");
+        if (ok) {
+            std::cout << statsJson(stats);
         } else {
-            showcase = getDefaultShowcaseConfig(type);
-            std::cout << "Using default showcase config for " << module_type_to_string(type) << "\n";
-        }
-
-        std::cout << "Rendering showcase for " << opts.moduleName << " ("
-                  << showcase.duration << "s at " << opts.sampleRate << "Hz)...\n";
-        std::cout << "  Notes: " << showcase.notes.size() << "\n";
-        std::cout << "  Automations: " << showcase.automations.size() << "\n";
-        std::cout << "  Triggers: " << showcase.trigger_sequence.size() << "\n";
-
-        samples = renderShowcaseAudio(*dsp, opts.sampleRate, showcase, type);
-    } else {
-        // Standard render
-        std::cout << "Rendering " << opts.moduleName << " for " << opts.duration
-                  << "s at " << opts.sampleRate << "Hz...\n";
-
-        samples = renderAudio(*dsp, opts.sampleRate, opts.duration, type, opts.noAutoGate, scenario);
-    }
-
-    // Analyze audio for distortion/clipping
-    float peakAbs = 0.0f;
-    float sumSquares = 0.0f;
-    int clipCount = 0;
-    const float clipThreshold = 0.99f;  // Consider clipped if >= 99% of max
-
-    for (float sample : samples) {
-        float absSample = std::abs(sample);
-        peakAbs = std::max(peakAbs, absSample);
-        sumSquares += sample * sample;
-        if (absSample >= clipThreshold) {
-            clipCount++;
+            std::cout << ", \"error\": \"" << jsonEscape(error) << "\"";
         }
+        std::cout << "}" << std::endl;
     }
-
-    float rms = std::sqrt(sumSquares / samples.size());
-    float crestFactor = (rms > 0.001f) ? (peakAbs / rms) : 0.0f;
-    float clipPercent = 100.0f * clipCount / samples.size();
-
-    std::cout << "\n=== Audio Analysis ===\n";
-    std::cout << "Peak amplitude: " << peakAbs << " (" << (20.0f * std::log10(std::max(peakAbs, 0.0001f))) << " dB)\n";
-    std::cout << "RMS level: " << rms << " (" << (20.0f * std::log10(std::max(rms, 0.0001f))) << " dB)\n";
-    std::cout << "Crest factor: " << crestFactor << " (" << (20.0f * std::log10(std::max(crestFactor, 0.0001f))) << " dB)\n";
-    std::cout << "Clipped samples: " << clipCount << " (" << clipPercent << "%)\n";
-
-    float clipThresholdPercent = config.thresholds.effective_clipping_max();
-    if (clipPercent > clipThresholdPercent) {
-        std::cout << "WARNING: Clipping exceeds threshold (" << clipPercent << "% > "
-                  << clipThresholdPercent << "%)!\n";
-    } else if (peakAbs > 1.0f) {
-        std::cout << "WARNING: Output exceeds unity gain (peak=" << peakAbs << ")!\n";
-    }
-    std::cout << "Clipping threshold: " << clipThresholdPercent << "%";
-    if (config.thresholds.allow_hot_signal) {
-        std::cout << " (hot signal module)";
-    }
-    std::cout << "\n======================\n\n";
-
-    // Write WAV
-    int numChannels = dsp->getNumOutputs();
-    if (writeWav(opts.outputFile, samples, opts.sampleRate, numChannels)) {
-        std::cout << "Wrote " << opts.outputFile << " ("
-                  << samples.size() / numChannels << " samples, "
-                  << numChannels << " channels)\n";
-    } else {
+    if (!ok) {
+        std::cerr << "Error: " << error << "\n";
         return 1;
     }
 
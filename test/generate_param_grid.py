@@ -28,6 +28,8 @@ import hashlib
 
 import numpy as np
 
+from utils import render_batch
+
 # Load .env file if present
 def load_dotenv():
     """Load environment variables from .env file."""
@@ -322,38 +324,6 @@ def generate_grid(params: list[ModuleParam],
 # Audio Rendering
 # =============================================================================
 
-def render_grid_point(module_name: str, grid_point: GridPoint,
-                      output_path: Path, module_type: str = "instrument",
-                      duration: float = CLIP_DURATION) -> tuple[bool, str]:
-    """Render audio for a single grid point."""
-    exe = get_render_executable()
-    if not exe.exists():
-        return False, f"faust_render not found at {exe}"
-
-    # Build command
-    args = [
-        str(exe),
-        "--module", module_name,
-        "--output", str(output_path),
-        "--duration", str(duration),
-        "--sample-rate", str(SAMPLE_RATE),
-    ]
-
-    # Add parameter values
-    for param_name, value in grid_point.param_values.items():
-        args.extend(["--param", f"{param_name}={value}"])
-
-    try:
-        result = subprocess.run(args, capture_output=True, text=True, timeout=60)
-        if result.returncode != 0:
-            return False, result.stderr
-        return True, ""
-    except subprocess.TimeoutExpired:
-        return False, "Render timeout"
-    except Exception as e:
-        return False, str(e)
-
-
 def render_grid(module_name: str, grid_points: list[GridPoint],
                 output_dir: Path, module_type: str = "instrument",
                 parallel_workers: int = 8, use_cache: bool = True,
@@ -380,22 +350,17 @@ def render_grid(module_name: str, grid_points: list[GridPoint],
     if not jobs:
         return results
 
-    def render_job(job):
-        gp, wav_path = job
-        success, error = render_grid_point(module_name, gp, wav_path, module_type)
-        return gp, wav_path, success, error
-
-    with ThreadPoolExecutor(max_workers=parallel_workers) as executor:
-        futures = [executor.submit(render_job, job) for job in jobs]
-
-        iterator = as_completed(futures)
-        if HAS_TQDM:
-            iterator = tqdm(iterator, total=len(jobs), desc="Rendering",
-                          leave=False, ncols=80)
-
-        for future in iterator:
-            result = future.result()
-            results.append(result)
+    # One faust_render process renders the whole grid on its own worker pool
+    batch = [{
+        "module": module_name,
+        "output": str(wav_path),
+        "duration": CLIP_DURATION,
+        "sample_rate": SAMPLE_RATE,
+        "params": gp.param_values,
+    } for gp, wav_path in jobs]
+
+    for (gp, wav_path), result in zip(jobs, render_batch(batch, workers=parallel_workers)):
+        results.append((gp, wav_path, bool(result.get("ok")), result.get("error", "")))
 
     return results
 
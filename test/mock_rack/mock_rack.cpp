@@ -0,0 +1,45 @@
+/**
+ * Out-of-line parts of the headless Rack mock (see rack.hpp)
+ *
+ * The plugin instance, asset paths and clock the module sources link
+ * against, plus no-op ImageCache definitions so the panel code links
+ * without ImagePanel.cpp and its image decoder.
+ */
+
+#include "rack.hpp"
+#include "ImagePanel.hpp"
+
+#include <chrono>
+
+rack::plugin::Plugin* pluginInstance = nullptr;
+
+namespace rack {
+
+namespace settings {
+float sampleRate = 48000.f;
+}
+
+namespace system {
+double getTime() {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point start = Clock::now();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+}
+
+namespace asset {
+std::string plugin(plugin::Plugin*, const std::string& filename) { return filename; }
+std::string user(const std::string& filename) { return filename; }
+std::string system(const std::string& filename) { return filename; }
+}
+
+} // namespace rack
+
+namespace WiggleRoom {
+
+int ImageCache::acquire(NVGcontext*, const std::string&, int) { return -1; }
+void ImageCache::release(NVGcontext*, const std::string&, int) {}
+bool ImageCache::sourceSize(const std::string&, int&, int&) { return false; }
+int ImageCache::levelFor(const std::string&, float) { return 0; }
+
+} // namespace WiggleRoom
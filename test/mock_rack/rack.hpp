@@ -0,0 +1,1076 @@
+#pragma once
+
+/**
+ * Headless stand-in for the VCV Rack SDK (module_bench only)
+ *
+ * Lets module sources (src/modules/<Name>/<Name>.cpp) compile and run
+ * outside Rack so their process() can be timed: the hand-written modules
+ * always, the Faust modules in PGO training builds. The engine side is
+ * functional: Module with params, polyphonic inputs/outputs and lights,
+ * ProcessArgs, ParamQuantity, the rack::dsp helpers the modules use and a
+ * real rack::simd::float_4. createModel() returns a Model whose
+ * createModule() builds the module, as in Rack.
+ *
+ * Everything on the UI side (widgets, NanoVG, menus, jansson) only has to
+ * compile: the module widgets are never created, and the JSON functions
+ * don't store anything. Add to it when a benchmarked module needs more of
+ * the SDK; keep signatures as in Rack so the module code stays unchanged.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+#define INFO(format, ...) std::fprintf(stderr, "[info] " format "\n", ##__VA_ARGS__)
+#define WARN(format, ...) std::fprintf(stderr, "[warn] " format "\n", ##__VA_ARGS__)
+#define DEBUG(format, ...) do {} while (0)
+
+#define ENUMS(name, count) name, name##_LAST = name + (count) - 1
+
+// ============================================================================
+// jansson (patch state is not kept)
+// ============================================================================
+
+typedef struct json_t json_t;
+inline json_t* json_object() { return nullptr; }
+inline json_t* json_array() { return nullptr; }
+inline json_t* json_real(double) { return nullptr; }
+inline json_t* json_integer(long long) { return nullptr; }
+inline json_t* json_boolean(bool) { return nullptr; }
+inline json_t* json_string(const char*) { return nullptr; }
+inline json_t* json_true() { return nullptr; }
+inline json_t* json_false() { return nullptr; }
+inline int json_object_set_new(json_t*, const char*, json_t*) { return 0; }
+inline int json_array_append_new(json_t*, json_t*) { return 0; }
+inline json_t* json_object_get(const json_t*, const char*) { return nullptr; }
+inline json_t* json_array_get(const json_t*, size_t) { return nullptr; }
+inline size_t json_array_size(const json_t*) { return 0; }
+inline bool json_is_real(const json_t*) { return false; }
+inline bool json_is_integer(const json_t*) { return false; }
+inline bool json_is_number(const json_t*) { return false; }
+inline bool json_is_string(const json_t*) { return false; }
+inline bool json_is_array(const json_t*) { return false; }
+inline bool json_is_object(const json_t*) { return false; }
+inline bool json_is_boolean(const json_t*) { return false; }
+inline bool json_is_true(const json_t*) { return false; }
+inline bool json_boolean_value(const json_t*) { return false; }
+inline double json_real_value(const json_t*) { return 0.0; }
+inline double json_number_value(const json_t*) { return 0.0; }
+inline long long json_integer_value(const json_t*) { return 0; }
+inline const char* json_string_value(const json_t*) { return ""; }
+inline void json_decref(json_t*) {}
+
+// ============================================================================
+// NanoVG (drawing is never called)
+// ============================================================================
+
+struct NVGcontext;
+struct NVGcolor { float r, g, b, a; };
+struct NVGpaint { float data[16]; };
+enum NVGalign {
+    NVG_ALIGN_LEFT = 1, NVG_ALIGN_CENTER = 2, NVG_ALIGN_RIGHT = 4,
+    NVG_ALIGN_TOP = 8, NVG_ALIGN_MIDDLE = 16, NVG_ALIGN_BOTTOM = 32, NVG_ALIGN_BASELINE = 64
+};
+inline NVGcolor nvgRGBA(int r, int g, int b, int a) { return NVGcolor{r / 255.f, g / 255.f, b / 255.f, a / 255.f}; }
+inline NVGcolor nvgRGB(int r, int g, int b) { return nvgRGBA(r, g, b, 255); }
+inline NVGcolor nvgRGBAf(float r, float g, float b, float a) { return NVGcolor{r, g, b, a}; }
+inline NVGcolor nvgRGBf(float r, float g, float b) { return NVGcolor{r, g, b, 1.f}; }
+inline NVGcolor nvgHSLA(float, float, float, unsigned char a) { return NVGcolor{0.f, 0.f, 0.f, a / 255.f}; }
+inline NVGcolor nvgHSL(float h, float s, float l) { return nvgHSLA(h, s, l, 255); }
+inline NVGcolor nvgLerpRGBA(NVGcolor a, NVGcolor, float) { return a; }
+inline NVGcolor nvgTransRGBA(NVGcolor c, unsigned char a) { c.a = a / 255.f; return c; }
+inline NVGcolor nvgTransRGBAf(NVGcolor c, float a) { c.a = a; return c; }
+inline void nvgBeginPath(NVGcontext*) {}
+inline void nvgClosePath(NVGcontext*) {}
+inline void nvgMoveTo(NVGcontext*, float, float) {}
+inline void nvgLineTo(NVGcontext*, float, float) {}
+inline void nvgBezierTo(NVGcontext*, float, float, float, float, float, float) {}
+inline void nvgArc(NVGcontext*, float, float, float, float, float, int) {}
+inline void nvgRect(NVGcontext*, float, float, float, float) {}
+inline void nvgRoundedRect(NVGcontext*, float, float, float, float, float) {}
+inline void nvgCircle(NVGcontext*, float, float, float) {}
+inline void nvgEllipse(NVGcontext*, float, float, float, float) {}
+inline void nvgFill(NVGcontext*) {}
+inline void nvgStroke(NVGcontext*) {}
+inline void nvgFillColor(NVGcontext*, NVGcolor) {}
+inline void nvgFillPaint(NVGcontext*, NVGpaint) {}
+inline void nvgStrokeColor(NVGcontext*, NVGcolor) {}
+inline void nvgStrokeWidth(NVGcontext*, float) {}
+inline void nvgLineCap(NVGcontext*, int) {}
+inline void nvgLineJoin(NVGcontext*, int) {}
+inline void nvgGlobalAlpha(NVGcontext*, float) {}
+inline void nvgSave(NVGcontext*) {}
+inline void nvgRestore(NVGcontext*) {}
+inline void nvgTranslate(NVGcontext*, float, float) {}
+inline void nvgRotate(NVGcontext*, float) {}
+inline void nvgScale(NVGcontext*, float, float) {}
+inline void nvgScissor(NVGcontext*, float, float, float, float) {}
+inline void nvgResetScissor(NVGcontext*) {}
+inline void nvgCurrentTransform(NVGcontext*, float*) {}
+inline void nvgFontSize(NVGcontext*, float) {}
+inline void nvgFontFaceId(NVGcontext*, int) {}
+inline void nvgTextAlign(NVGcontext*, int) {}
+inline float nvgText(NVGcontext*, float x, float, const char*, const char* = nullptr) { return x; }
+inline NVGpaint nvgImagePattern(NVGcontext*, float, float, float, float, float, int, float) { return NVGpaint{}; }
+inline NVGpaint nvgLinearGradient(NVGcontext*, float, float, float, float, NVGcolor, NVGcolor) { return NVGpaint{}; }
+inline NVGpaint nvgRadialGradient(NVGcontext*, float, float, float, float, NVGcolor, NVGcolor) { return NVGpaint{}; }
+inline NVGpaint nvgBoxGradient(NVGcontext*, float, float, float, float, float, float, NVGcolor, NVGcolor) { return NVGpaint{}; }
+
+namespace rack {
+
+// ============================================================================
+// SIMD
+// ============================================================================
+
+namespace simd {
+
+struct float_4 {
+    __m128 v;
+
+    float_4() = default;
+    float_4(__m128 v) : v(v) {}
+    float_4(float x) : v(_mm_set1_ps(x)) {}
+    float_4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+    static float_4 zero() { return _mm_setzero_ps(); }
+    static float_4 mask() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static float_4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    float& operator[](int i) { return reinterpret_cast<float*>(&v)[i]; }
+    const float& operator[](int i) const { return reinterpret_cast<const float*>(&v)[i]; }
+};
+
+inline float_4 operator+(float_4 a, float_4 b) { return _mm_add_ps(a.v, b.v); }
+inline float_4 operator-(float_4 a, float_4 b) { return _mm_sub_ps(a.v, b.v); }
+inline float_4 operator*(float_4 a, float_4 b) { return _mm_mul_ps(a.v, b.v); }
+inline float_4 operator/(float_4 a, float_4 b) { return _mm_div_ps(a.v, b.v); }
+inline float_4 operator-(float_4 a) { return _mm_sub_ps(_mm_setzero_ps(), a.v); }
+inline float_4& operator+=(float_4& a, float_4 b) { return a = a + b; }
+inline float_4& operator-=(float_4& a, float_4 b) { return a = a - b; }
+inline float_4& operator*=(float_4& a, float_4 b) { return a = a * b; }
+inline float_4& operator/=(float_4& a, float_4 b) { return a = a / b; }
+inline float_4 operator&(float_4 a, float_4 b) { return _mm_and_ps(a.v, b.v); }
+inline float_4 operator|(float_4 a, float_4 b) { return _mm_or_ps(a.v, b.v); }
+inline float_4 operator^(float_4 a, float_4 b) { return _mm_xor_ps(a.v, b.v); }
+inline float_4 operator<(float_4 a, float_4 b) { return _mm_cmplt_ps(a.v, b.v); }
+inline float_4 operator>(float_4 a, float_4 b) { return _mm_cmpgt_ps(a.v, b.v); }
+inline float_4 operator<=(float_4 a, float_4 b) { return _mm_cmple_ps(a.v, b.v); }
+inline float_4 operator>=(float_4 a, float_4 b) { return _mm_cmpge_ps(a.v, b.v); }
+inline float_4 operator==(float_4 a, float_4 b) { return _mm_cmpeq_ps(a.v, b.v); }
+inline float_4 operator!=(float_4 a, float_4 b) { return _mm_cmpneq_ps(a.v, b.v); }
+
+inline float_4 fmin(float_4 a, float_4 b) { return _mm_min_ps(a.v, b.v); }
+inline float_4 fmax(float_4 a, float_4 b) { return _mm_max_ps(a.v, b.v); }
+inline float_4 clamp(float_4 x, float_4 a = 0.f, float_4 b = 1.f) { return fmin(fmax(x, a), b); }
+inline float_4 abs(float_4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a.v); }
+inline float_4 sqrt(float_4 a) { return _mm_sqrt_ps(a.v); }
+inline float_4 rcp(float_4 a) { return _mm_rcp_ps(a.v); }
+inline float_4 rsqrt(float_4 a) { return _mm_rsqrt_ps(a.v); }
+inline float_4 ifelse(float_4 mask, float_4 a, float_4 b) {
+    return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+}
+inline float_4 crossfade(float_4 a, float_4 b, float_4 p) { return a + (b - a) * p; }
+inline int movemask(float_4 a) { return _mm_movemask_ps(a.v); }
+
+// Lane-wise libm fallbacks (Rack uses sse_mathfun; exactness doesn't matter here)
+#define WR_MOCK_SIMD_LANEWISE(name)                                                     \
+    inline float_4 name(float_4 a) {                                                    \
+        return float_4(std::name(a[0]), std::name(a[1]), std::name(a[2]), std::name(a[3])); \
+    }
+WR_MOCK_SIMD_LANEWISE(sin)
+WR_MOCK_SIMD_LANEWISE(cos)
+WR_MOCK_SIMD_LANEWISE(tan)
+WR_MOCK_SIMD_LANEWISE(tanh)
+WR_MOCK_SIMD_LANEWISE(exp)
+WR_MOCK_SIMD_LANEWISE(log)
+WR_MOCK_SIMD_LANEWISE(log2)
+WR_MOCK_SIMD_LANEWISE(exp2)
+WR_MOCK_SIMD_LANEWISE(atan)
+WR_MOCK_SIMD_LANEWISE(floor)
+WR_MOCK_SIMD_LANEWISE(ceil)
+WR_MOCK_SIMD_LANEWISE(round)
+WR_MOCK_SIMD_LANEWISE(trunc)
+#undef WR_MOCK_SIMD_LANEWISE
+inline float_4 pow(float_4 a, float_4 b) {
+    return float_4(std::pow(a[0], b[0]), std::pow(a[1], b[1]), std::pow(a[2], b[2]), std::pow(a[3], b[3]));
+}
+inline float_4 fmod(float_4 a, float_4 b) { return a - trunc(a / b) * b; }
+inline float_4 atan2(float_4 a, float_4 b) {
+    return float_4(std::atan2(a[0], b[0]), std::atan2(a[1], b[1]), std::atan2(a[2], b[2]), std::atan2(a[3], b[3]));
+}
+
+} // namespace simd
+
+// ============================================================================
+// Math
+// ============================================================================
+
+namespace math {
+
+inline int clamp(int x, int a, int b) { return std::max(std::min(x, b), a); }
+inline float clamp(float x, float a = 0.f, float b = 1.f) { return std::fmax(std::fmin(x, b), a); }
+inline float rescale(float x, float xMin, float xMax, float yMin, float yMax) {
+    return yMin + (x - xMin) / (xMax - xMin) * (yMax - yMin);
+}
+inline float crossfade(float a, float b, float p) { return a + (b - a) * p; }
+inline float sgn(float x) { return x > 0.f ? 1.f : (x < 0.f ? -1.f : 0.f); }
+inline bool isNear(float a, float b, float epsilon = 1e-6f) { return std::fabs(a - b) <= epsilon; }
+inline float eucMod(float a, float b) {
+    float m = std::fmod(a, b);
+    return m < 0.f ? m + b : m;
+}
+inline int eucMod(int a, int b) {
+    int m = a % b;
+    return m < 0 ? m + b : m;
+}
+
+struct Vec {
+    float x = 0.f, y = 0.f;
+    Vec() {}
+    Vec(float x, float y) : x(x), y(y) {}
+    Vec plus(Vec b) const { return Vec(x + b.x, y + b.y); }
+    Vec minus(Vec b) const { return Vec(x - b.x, y - b.y); }
+    Vec mult(float s) const { return Vec(x * s, y * s); }
+    Vec mult(Vec b) const { return Vec(x * b.x, y * b.y); }
+    Vec div(float s) const { return Vec(x / s, y / s); }
+    Vec neg() const { return Vec(-x, -y); }
+    float dot(Vec b) const { return x * b.x + y * b.y; }
+    float square() const { return x * x + y * y; }
+    float norm() const { return std::hypot(x, y); }
+    bool equals(Vec b) const { return x == b.x && y == b.y; }
+    bool isEqual(Vec b) const { return equals(b); }
+};
+
+struct Rect {
+    Vec pos, size;
+    Rect() {}
+    Rect(Vec pos, Vec size) : pos(pos), size(size) {}
+    Rect(float x, float y, float w, float h) : pos(x, y), size(w, h) {}
+    bool contains(Vec v) const {
+        return v.x >= pos.x && v.x < pos.x + size.x && v.y >= pos.y && v.y < pos.y + size.y;
+    }
+};
+
+} // namespace math
+
+using math::clamp;
+using math::rescale;
+using math::crossfade;
+using math::Vec;
+using math::Rect;
+
+static constexpr float RACK_GRID_WIDTH = 15.f;
+static constexpr float RACK_GRID_HEIGHT = 380.f;
+inline float mm2px(float mm) { return mm * (75.f / 25.4f); }
+inline Vec mm2px(Vec mm) { return mm.mult(75.f / 25.4f); }
+
+// ============================================================================
+// Random (per-thread, seeded; benchmarks only need plausible values)
+// ============================================================================
+
+namespace random {
+
+inline std::mt19937& engine() {
+    thread_local std::mt19937 rng(0x5EED);
+    return rng;
+}
+inline uint32_t u32() { return engine()(); }
+inline uint64_t u64() { return (uint64_t(u32()) << 32) | u32(); }
+inline float uniform() { return std::uniform_real_distribution<float>(0.f, 1.f)(engine()); }
+inline float normal() { return std::normal_distribution<float>(0.f, 1.f)(engine()); }
+
+} // namespace random
+
+namespace system {
+
+double getTime();
+inline std::string getExtension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    return dot == std::string::npos ? "" : path.substr(dot + 1);
+}
+
+} // namespace system
+
+namespace string {
+
+inline std::string lowercase(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+} // namespace string
+
+// ============================================================================
+// rack::dsp helpers
+// ============================================================================
+
+namespace dsp {
+
+struct SchmittTrigger {
+    bool state = true;
+
+    void reset() { state = true; }
+
+    // True on the rising edge through `high`; re-arms below `low`
+    bool process(float in, float low = 0.f, float high = 1.f) {
+        if (state) {
+            if (in <= low) state = false;
+        } else if (in >= high) {
+            state = true;
+            return true;
+        }
+        return false;
+    }
+
+    bool isHigh() const { return state; }
+};
+
+struct BooleanTrigger {
+    bool state = true;
+
+    void reset() { state = true; }
+
+    bool process(bool in) {
+        bool triggered = in && !state;
+        state = in;
+        return triggered;
+    }
+};
+
+struct PulseGenerator {
+    float remaining = 0.f;
+
+    void reset() { remaining = 0.f; }
+
+    bool process(float deltaTime) {
+        if (remaining > 0.f) {
+            remaining -= deltaTime;
+            return true;
+        }
+        return false;
+    }
+
+    void trigger(float duration = 1e-3f) {
+        remaining = std::max(duration, remaining);
+    }
+};
+
+struct ClockDivider {
+    uint32_t clock = 0;
+    uint32_t division = 1;
+
+    void reset() { clock = 0; }
+    void setDivision(uint32_t d) { division = d; }
+    uint32_t getDivision() const { return division; }
+    uint32_t getClock() const { return clock; }
+
+    bool process() {
+        if (++clock >= division) {
+            clock = 0;
+            return true;
+        }
+        return false;
+    }
+};
+
+template<typename T = float>
+struct TSlewLimiter {
+    T out = 0.f;
+    T rise = 0.f;
+    T fall = 0.f;
+
+    void reset() { out = 0.f; }
+    void setRiseFall(T r, T f) { rise = r; fall = f; }
+
+    T process(T deltaTime, T in) {
+        out = std::min(std::max(in, out - fall * deltaTime), out + rise * deltaTime);
+        return out;
+    }
+};
+using SlewLimiter = TSlewLimiter<>;
+
+template<typename T = float>
+struct TExponentialFilter {
+    T out = 0.f;
+    T lambda = 0.f;
+
+    void reset() { out = 0.f; }
+    void setLambda(T l) { lambda = l; }
+    void setTau(T tau) { lambda = 1.f / tau; }
+
+    T process(T deltaTime, T in) {
+        out += (in - out) * lambda * deltaTime;
+        return out;
+    }
+};
+using ExponentialFilter = TExponentialFilter<>;
+
+} // namespace dsp
+
+// ============================================================================
+// Engine
+// ============================================================================
+
+namespace plugin {
+struct Model;
+struct Plugin {};
+}
+using plugin::Model;
+using plugin::Plugin;
+
+namespace engine {
+
+static constexpr int PORT_MAX_CHANNELS = 16;
+
+struct Module;
+
+struct Param {
+    float value = 0.f;
+    float getValue() const { return value; }
+    void setValue(float v) { value = v; }
+};
+
+struct Port {
+    float voltages[PORT_MAX_CHANNELS] = {};
+    uint8_t channels = 0;
+
+    float getVoltage(int c = 0) const { return voltages[c]; }
+    void setVoltage(float v, int c = 0) { voltages[c] = v; }
+    float getPolyVoltage(int c) const { return channels == 1 ? voltages[0] : voltages[c]; }
+    float getNormalVoltage(float normal, int c = 0) const { return channels > 0 ? voltages[c] : normal; }
+    float getNormalPolyVoltage(float normal, int c) const { return channels > 0 ? getPolyVoltage(c) : normal; }
+    float getVoltageSum() const {
+        float sum = 0.f;
+        for (int c = 0; c < channels; c++) sum += voltages[c];
+        return sum;
+    }
+    float* getVoltages(int firstChannel = 0) { return &voltages[firstChannel]; }
+    void readVoltages(float* v) const { std::copy(voltages, voltages + channels, v); }
+    void writeVoltages(const float* v) { std::copy(v, v + channels, voltages); }
+    void clearVoltages() { std::fill(voltages, voltages + PORT_MAX_CHANNELS, 0.f); }
+
+    template<typename T> T getVoltageSimd(int c) const { return T::load(&voltages[c]); }
+    template<typename T> T getPolyVoltageSimd(int c) const {
+        return channels == 1 ? T(voltages[0]) : T::load(&voltages[c]);
+    }
+    template<typename T> void setVoltageSimd(T v, int c) { v.store(&voltages[c]); }
+
+    int getChannels() const { return channels; }
+    bool isConnected() const { return channels > 0; }
+    bool isMonophonic() const { return channels == 1; }
+    bool isPolyphonic() const { return channels > 1; }
+};
+
+// Outputs connect with 1 channel; the module sets the count it produces
+struct Output : Port {
+    void setChannels(int c) { channels = static_cast<uint8_t>(channels == 0 ? 0 : std::max(1, c)); }
+};
+
+struct Input : Port {
+    void setChannels(int c) { channels = static_cast<uint8_t>(std::min(std::max(c, 0), PORT_MAX_CHANNELS)); }
+};
+
+struct Light {
+    float value = 0.f;
+    void setBrightness(float b) { value = b; }
+    float getBrightness() const { return value; }
+    void setBrightnessSmooth(float b, float) { value = b; }
+    void setSmoothBrightness(float b, float) { value = b; }
+};
+
+struct ParamQuantity {
+    Module* module = nullptr;
+    int paramId = -1;
+    float minValue = 0.f;
+    float maxValue = 1.f;
+    float defaultValue = 0.f;
+    std::string name;
+    std::string unit;
+    std::string description;
+    float displayBase = 0.f;
+    float displayMultiplier = 1.f;
+    float displayOffset = 0.f;
+    bool snapEnabled = false;
+    bool smoothEnabled = false;
+    bool randomizeEnabled = true;
+
+    virtual ~ParamQuantity() {}
+    Param* getParam();
+    virtual void setValue(float value);
+    virtual float getValue();
+    virtual float getMinValue() { return minValue; }
+    virtual float getMaxValue() { return maxValue; }
+    virtual float getDefaultValue() { return defaultValue; }
+    virtual float getDisplayValue() { return getValue() * displayMultiplier + displayOffset; }
+    virtual void setDisplayValue(float v) { setValue((v - displayOffset) / displayMultiplier); }
+    virtual std::string getDisplayValueString() { return std::to_string(getDisplayValue()); }
+    virtual void setDisplayValueString(std::string s) { setDisplayValue(std::strtof(s.c_str(), nullptr)); }
+    virtual std::string getLabel() { return name; }
+    virtual std::string getUnit() { return unit; }
+    virtual std::string getString() { return getLabel() + ": " + getDisplayValueString() + getUnit(); }
+};
+
+struct SwitchQuantity : ParamQuantity {
+    std::vector<std::string> labels;
+};
+
+struct PortInfo {
+    std::string name;
+    std::string description;
+};
+
+struct LightInfo {
+    std::string name;
+};
+
+struct Module {
+    plugin::Model* model = nullptr;
+    int64_t id = -1;
+
+    std::vector<Param> params;
+    std::vector<Input> inputs;
+    std::vector<Output> outputs;
+    std::vector<Light> lights;
+    std::vector<ParamQuantity*> paramQuantities;
+    std::vector<PortInfo*> inputInfos;
+    std::vector<PortInfo*> outputInfos;
+    std::vector<LightInfo*> lightInfos;
+
+    struct Expander {
+        int64_t moduleId = -1;
+        Module* module = nullptr;
+        void* producerMessage = nullptr;
+        void* consumerMessage = nullptr;
+        void requestMessageFlip() { std::swap(producerMessage, consumerMessage); }
+    };
+    Expander leftExpander;
+    Expander rightExpander;
+
+    struct ProcessArgs {
+        float sampleRate = 48000.f;
+        float sampleTime = 1.f / 48000.f;
+        int64_t frame = 0;
+    };
+    struct SampleRateChangeEvent {
+        float sampleRate;
+        float sampleTime;
+    };
+    struct ResetEvent {};
+    struct RandomizeEvent {};
+    struct AddEvent {};
+    struct RemoveEvent {};
+
+    Module() {}
+    Module(const Module&) = delete;
+    Module& operator=(const Module&) = delete;
+    virtual ~Module() {
+        for (ParamQuantity* q : paramQuantities) delete q;
+        for (PortInfo* info : inputInfos) delete info;
+        for (PortInfo* info : outputInfos) delete info;
+        for (LightInfo* info : lightInfos) delete info;
+    }
+
+    void config(int numParams, int numInputs, int numOutputs, int numLights = 0) {
+        params.resize(numParams);
+        inputs.resize(numInputs);
+        outputs.resize(numOutputs);
+        lights.resize(numLights);
+        paramQuantities.resize(numParams, nullptr);
+        inputInfos.resize(numInputs, nullptr);
+        outputInfos.resize(numOutputs, nullptr);
+        lightInfos.resize(numLights, nullptr);
+    }
+
+    template<class TParamQuantity = ParamQuantity>
+    TParamQuantity* configParam(int paramId, float minValue, float maxValue, float defaultValue,
+                                std::string name = "", std::string unit = "",
+                                float displayBase = 0.f, float displayMultiplier = 1.f,
+                                float displayOffset = 0.f) {
+        delete paramQuantities[paramId];
+        TParamQuantity* q = new TParamQuantity;
+        q->module = this;
+        q->paramId = paramId;
+        q->minValue = minValue;
+        q->maxValue = maxValue;
+        q->defaultValue = defaultValue;
+        q->name = name;
+        q->unit = unit;
+        q->displayBase = displayBase;
+        q->displayMultiplier = displayMultiplier;
+        q->displayOffset = displayOffset;
+        paramQuantities[paramId] = q;
+        params[paramId].value = defaultValue;
+        return q;
+    }
+
+    template<class TSwitchQuantity = SwitchQuantity>
+    TSwitchQuantity* configSwitch(int paramId, float minValue, float maxValue, float defaultValue,
+                                  std::string name = "", std::vector<std::string> labels = {}) {
+        TSwitchQuantity* q = configParam<TSwitchQuantity>(paramId, minValue, maxValue, defaultValue, name);
+        q->snapEnabled = true;
+        q->labels = labels;
+        return q;
+    }
+
+    template<class TSwitchQuantity = SwitchQuantity>
+    TSwitchQuantity* configButton(int paramId, std::string name = "") {
+        TSwitchQuantity* q = configParam<TSwitchQuantity>(paramId, 0.f, 1.f, 0.f, name);
+        q->randomizeEnabled = false;
+        return q;
+    }
+
+    PortInfo* configInput(int portId, std::string name = "") { return setInfo(inputInfos[portId], name); }
+    PortInfo* configOutput(int portId, std::string name = "") { return setInfo(outputInfos[portId], name); }
+    LightInfo* configLight(int lightId, std::string name = "") { return setInfo(lightInfos[lightId], name); }
+    void configBypass(int, int) {}
+
+    ParamQuantity* getParamQuantity(int paramId) { return paramQuantities[paramId]; }
+    Expander& getLeftExpander() { return leftExpander; }
+    Expander& getRightExpander() { return rightExpander; }
+    int getNumParams() const { return static_cast<int>(params.size()); }
+    int getNumInputs() const { return static_cast<int>(inputs.size()); }
+    int getNumOutputs() const { return static_cast<int>(outputs.size()); }
+
+    virtual void process(const ProcessArgs&) {}
+    virtual void processBypass(const ProcessArgs&) {}
+    virtual void onSampleRateChange(const SampleRateChangeEvent&) { onSampleRateChange(); }
+    virtual void onSampleRateChange() {}
+    virtual void onReset(const ResetEvent&) { onReset(); }
+    virtual void onReset() {}
+    virtual void onRandomize(const RandomizeEvent&) {}
+    virtual void onAdd(const AddEvent&) {}
+    virtual void onRemove(const RemoveEvent&) {}
+    virtual json_t* toJson() { return nullptr; }
+    virtual void fromJson(json_t*) {}
+    virtual json_t* dataToJson() { return nullptr; }
+    virtual void dataFromJson(json_t*) {}
+
+private:
+    template<typename T>
+    static T* setInfo(T*& info, const std::string& name) {
+        delete info;
+        info = new T;
+        info->name = name;
+        return info;
+    }
+};
+
+inline Param* ParamQuantity::getParam() {
+    return module ? &module->params[paramId] : nullptr;
+}
+inline void ParamQuantity::setValue(float value) {
+    if (Param* p = getParam()) p->setValue(math::clamp(value, minValue, maxValue));
+}
+inline float ParamQuantity::getValue() {
+    Param* p = getParam();
+    return p ? p->getValue() : 0.f;
+}
+
+} // namespace engine
+
+using engine::Module;
+using engine::Input;
+using engine::Output;
+using engine::Light;
+using engine::Param;
+using engine::ParamQuantity;
+using engine::SwitchQuantity;
+using engine::PORT_MAX_CHANNELS;
+
+// ============================================================================
+// Widgets (compile only)
+// ============================================================================
+
+#define GLFW_MOUSE_BUTTON_LEFT 0
+#define GLFW_MOUSE_BUTTON_RIGHT 1
+#define GLFW_RELEASE 0
+#define GLFW_PRESS 1
+
+// APP->engine for widgets that set params while dragging
+struct Context {
+    struct Engine {
+        void setParamValue(engine::Module* module, int paramId, float value);
+    };
+    Engine* engine = nullptr;
+};
+
+inline Context* contextGet() {
+    static Context::Engine engine;
+    static Context context{&engine};
+    return &context;
+}
+
+#define APP rack::contextGet()
+
+namespace event {
+struct Base {
+    void consume(void*) const {}
+    void* getTarget() const { return nullptr; }
+};
+struct PositionBase { math::Vec pos; };
+struct KeyBase { int key = 0; int scancode = 0; std::string keyName; int action = 0; int mods = 0; };
+struct Hover : Base, PositionBase { math::Vec mouseDelta; };
+struct Button : Base, PositionBase { int button = 0; int action = 0; int mods = 0; };
+struct DoubleClick : Base {};
+struct HoverKey : Base, PositionBase, KeyBase {};
+struct HoverScroll : Base, PositionBase { math::Vec scrollDelta; };
+struct Enter : Base {};
+struct Leave : Base {};
+struct SelectKey : Base, KeyBase {};
+struct DragStart : Base { int button = 0; };
+struct DragEnd : Base { int button = 0; };
+struct DragMove : Base { int button = 0; math::Vec mouseDelta; };
+struct DragHover : Base, PositionBase { int button = 0; math::Vec mouseDelta; };
+struct Action : Base {};
+struct Change : Base {};
+struct ContextCreate : Base { NVGcontext* vg = nullptr; };
+struct ContextDestroy : Base { NVGcontext* vg = nullptr; };
+}
+
+namespace widget {
+
+struct Widget {
+    math::Rect box;
+    Widget* parent = nullptr;
+    std::vector<Widget*> children;
+    bool visible = true;
+
+    struct DrawArgs {
+        NVGcontext* vg = nullptr;
+        math::Rect clipBox;
+        void* fb = nullptr;
+    };
+
+    using HoverEvent = event::Hover;
+    using ButtonEvent = event::Button;
+    using DoubleClickEvent = event::DoubleClick;
+    using HoverKeyEvent = event::HoverKey;
+    using HoverScrollEvent = event::HoverScroll;
+    using EnterEvent = event::Enter;
+    using LeaveEvent = event::Leave;
+    using SelectKeyEvent = event::SelectKey;
+    using DragStartEvent = event::DragStart;
+    using DragEndEvent = event::DragEnd;
+    using DragMoveEvent = event::DragMove;
+    using DragHoverEvent = event::DragHover;
+    using ActionEvent = event::Action;
+    using ChangeEvent = event::Change;
+    using ContextCreateEvent = event::ContextCreate;
+    using ContextDestroyEvent = event::ContextDestroy;
+
+    Widget() {}
+    Widget(const Widget&) = delete;
+    Widget& operator=(const Widget&) = delete;
+    virtual ~Widget() {
+        for (Widget* child : children) delete child;
+    }
+
+    void addChild(Widget* child) {
+        child->parent = this;
+        children.push_back(child);
+    }
+    void removeChild(Widget* child) {
+        children.erase(std::remove(children.begin(), children.end(), child), children.end());
+        child->parent = nullptr;
+    }
+    void show() { visible = true; }
+    void hide() { visible = false; }
+    bool isVisible() const { return visible; }
+
+    virtual void step() {}
+    virtual void draw(const DrawArgs&) {}
+    virtual void drawLayer(const DrawArgs&, int) {}
+    virtual void onHover(const HoverEvent&) {}
+    virtual void onButton(const ButtonEvent&) {}
+    virtual void onDoubleClick(const DoubleClickEvent&) {}
+    virtual void onHoverKey(const HoverKeyEvent&) {}
+    virtual void onHoverScroll(const HoverScrollEvent&) {}
+    virtual void onEnter(const EnterEvent&) {}
+    virtual void onLeave(const LeaveEvent&) {}
+    virtual void onSelectKey(const SelectKeyEvent&) {}
+    virtual void onDragStart(const DragStartEvent&) {}
+    virtual void onDragEnd(const DragEndEvent&) {}
+    virtual void onDragMove(const DragMoveEvent&) {}
+    virtual void onDragHover(const DragHoverEvent&) {}
+    virtual void onAction(const ActionEvent&) {}
+    virtual void onChange(const ChangeEvent&) {}
+    virtual void onContextCreate(const ContextCreateEvent&) {}
+    virtual void onContextDestroy(const ContextDestroyEvent&) {}
+};
+
+struct TransparentWidget : Widget {};
+struct OpaqueWidget : Widget {};
+struct FramebufferWidget : Widget {
+    bool dirty = true;
+    void setDirty(bool d = true) { dirty = d; }
+};
+struct SvgWidget : Widget {};
+
+} // namespace widget
+
+using widget::Widget;
+using widget::TransparentWidget;
+using widget::OpaqueWidget;
+using widget::FramebufferWidget;
+
+namespace ui {
+struct Menu : widget::Widget {};
+struct MenuEntry : widget::Widget {};
+struct MenuSeparator : MenuEntry {};
+struct MenuLabel : MenuEntry { std::string text; };
+struct MenuItem : MenuEntry {
+    std::string text;
+    std::string rightText;
+    bool disabled = false;
+    virtual Menu* createChildMenu() { return nullptr; }
+};
+}
+
+using ui::Menu;
+using ui::MenuItem;
+using ui::MenuLabel;
+using ui::MenuSeparator;
+
+namespace app {
+
+struct ParamWidget : widget::OpaqueWidget {
+    engine::Module* module = nullptr;
+    int paramId = -1;
+    engine::ParamQuantity* getParamQuantity() { return module ? module->paramQuantities[paramId] : nullptr; }
+};
+struct Knob : ParamWidget { bool snap = false; float minAngle = -0.83f * M_PI; float maxAngle = 0.83f * M_PI; };
+struct SvgKnob : Knob {};
+struct Switch : ParamWidget { bool momentary = false; };
+struct SvgSwitch : Switch {};
+struct SvgSlider : Knob {};
+struct PortWidget : widget::OpaqueWidget {
+    engine::Module* module = nullptr;
+    int portId = -1;
+};
+struct SvgPort : PortWidget {};
+struct LightWidget : widget::TransparentWidget {
+    NVGcolor color = {}, bgColor = {}, borderColor = {};
+};
+struct ModuleLightWidget : LightWidget {
+    engine::Module* module = nullptr;
+    int firstLightId = -1;
+    void addBaseColor(NVGcolor) {}
+};
+struct SvgPanel : widget::Widget {};
+struct ThemedSvgPanel : SvgPanel {};
+
+struct ModuleWidget : widget::OpaqueWidget {
+    engine::Module* module = nullptr;
+    void setModule(engine::Module* m) { module = m; }
+    engine::Module* getModule() { return module; }
+    void setPanel(widget::Widget* panel) { addChild(panel); }
+    void addParam(ParamWidget* w) { addChild(w); }
+    void addInput(PortWidget* w) { addChild(w); }
+    void addOutput(PortWidget* w) { addChild(w); }
+    virtual void appendContextMenu(ui::Menu*) {}
+};
+
+} // namespace app
+
+using app::ModuleWidget;
+using app::ParamWidget;
+using app::Knob;
+using app::SvgKnob;
+using app::Switch;
+using app::SvgSwitch;
+using app::SvgSlider;
+using app::PortWidget;
+using app::SvgPort;
+using app::ModuleLightWidget;
+using app::LightWidget;
+using app::SvgPanel;
+using app::ThemedSvgPanel;
+
+namespace componentlibrary {
+struct RoundKnob : app::SvgKnob {};
+struct RoundBlackKnob : RoundKnob {};
+struct RoundSmallBlackKnob : RoundKnob {};
+struct RoundLargeBlackKnob : RoundKnob {};
+struct RoundBigBlackKnob : RoundKnob {};
+struct RoundHugeBlackKnob : RoundKnob {};
+struct RoundBlackSnapKnob : RoundBlackKnob { RoundBlackSnapKnob() { snap = true; } };
+struct Trimpot : app::SvgKnob {};
+struct Rogan1PSWhite : app::SvgKnob {};
+struct Davies1900hBlackKnob : app::SvgKnob {};
+struct PJ301MPort : app::SvgPort {};
+struct CKSS : app::SvgSwitch {};
+struct CKSSThree : app::SvgSwitch {};
+struct VCVButton : app::SvgSwitch {};
+struct VCVLatch : VCVButton {};
+struct TL1105 : app::SvgSwitch {};
+struct LEDButton : app::SvgSwitch {};
+struct ScrewSilver : widget::SvgWidget {};
+struct ScrewBlack : widget::SvgWidget {};
+struct GrayModuleLightWidget : app::ModuleLightWidget {};
+struct WhiteLight : GrayModuleLightWidget {};
+struct RedLight : GrayModuleLightWidget {};
+struct GreenLight : GrayModuleLightWidget {};
+struct BlueLight : GrayModuleLightWidget {};
+struct YellowLight : GrayModuleLightWidget {};
+struct OrangeLight : GrayModuleLightWidget {};
+struct PurpleLight : GrayModuleLightWidget {};
+struct GreenRedLight : GrayModuleLightWidget {};
+struct RedGreenBlueLight : GrayModuleLightWidget {};
+template<typename TBase> struct TinyLight : TBase {};
+template<typename TBase> struct SmallLight : TBase {};
+template<typename TBase> struct MediumLight : TBase {};
+template<typename TBase> struct LargeLight : TBase {};
+template<typename TBase> struct LightButton : app::SvgSwitch {};
+template<typename TBase> struct VCVLightLatch : app::SvgSwitch {};
+struct VCVBezel : app::SvgSwitch {};
+}
+
+using namespace componentlibrary;
+
+// Widget factories: positioned like Rack's, nothing is drawn
+template<class TWidget>
+TWidget* createWidget(math::Vec pos) {
+    TWidget* w = new TWidget;
+    w->box.pos = pos;
+    return w;
+}
+template<class TWidget>
+TWidget* createWidgetCentered(math::Vec pos) {
+    TWidget* w = createWidget<TWidget>(pos);
+    w->box.pos = pos.minus(w->box.size.div(2));
+    return w;
+}
+template<class TParamWidget>
+TParamWidget* createParam(math::Vec pos, engine::Module* module, int paramId) {
+    TParamWidget* w = createWidget<TParamWidget>(pos);
+    w->module = module;
+    w->paramId = paramId;
+    return w;
+}
+template<class TParamWidget>
+TParamWidget* createParamCentered(math::Vec pos, engine::Module* module, int paramId) {
+    return createParam<TParamWidget>(pos, module, paramId);
+}
+template<class TPortWidget>
+TPortWidget* createInput(math::Vec pos, engine::Module* module, int inputId) {
+    TPortWidget* w = createWidget<TPortWidget>(pos);
+    w->module = module;
+    w->portId = inputId;
+    return w;
+}
+template<class TPortWidget>
+TPortWidget* createInputCentered(math::Vec pos, engine::Module* module, int inputId) {
+    return createInput<TPortWidget>(pos, module, inputId);
+}
+template<class TPortWidget>
+TPortWidget* createOutput(math::Vec pos, engine::Module* module, int outputId) {
+    return createInput<TPortWidget>(pos, module, outputId);
+}
+template<class TPortWidget>
+TPortWidget* createOutputCentered(math::Vec pos, engine::Module* module, int outputId) {
+    return createInput<TPortWidget>(pos, module, outputId);
+}
+template<class TModuleLightWidget>
+TModuleLightWidget* createLight(math::Vec pos, engine::Module* module, int firstLightId) {
+    TModuleLightWidget* w = createWidget<TModuleLightWidget>(pos);
+    w->module = module;
+    w->firstLightId = firstLightId;
+    return w;
+}
+template<class TModuleLightWidget>
+TModuleLightWidget* createLightCentered(math::Vec pos, engine::Module* module, int firstLightId) {
+    return createLight<TModuleLightWidget>(pos, module, firstLightId);
+}
+inline app::SvgPanel* createPanel(std::string) { return new app::SvgPanel; }
+
+template<class TMenuItem = ui::MenuItem>
+TMenuItem* createMenuItem(std::string text, std::string rightText = "",
+                          std::function<void()> = nullptr, bool disabled = false) {
+    TMenuItem* item = new TMenuItem;
+    item->text = text;
+    item->rightText = rightText;
+    item->disabled = disabled;
+    return item;
+}
+inline ui::MenuLabel* createMenuLabel(std::string text) {
+    ui::MenuLabel* label = new ui::MenuLabel;
+    label->text = text;
+    return label;
+}
+inline ui::MenuItem* createSubmenuItem(std::string text, std::string rightText,
+                                       std::function<void(ui::Menu*)>, bool disabled = false) {
+    return createMenuItem(text, rightText, nullptr, disabled);
+}
+inline ui::MenuItem* createIndexSubmenuItem(std::string text, std::vector<std::string>,
+                                            std::function<size_t()>, std::function<void(size_t)>,
+                                            bool disabled = false) {
+    return createMenuItem(text, "", nullptr, disabled);
+}
+inline ui::MenuItem* createBoolMenuItem(std::string text, std::string rightText,
+                                        std::function<bool()>, std::function<void(bool)>,
+                                        bool disabled = false) {
+    return createMenuItem(text, rightText, nullptr, disabled);
+}
+template<typename T>
+ui::MenuItem* createBoolPtrMenuItem(std::string text, std::string rightText, T*) {
+    return createMenuItem(text, rightText);
+}
+
+// ============================================================================
+// Plugin
+// ============================================================================
+
+namespace plugin {
+
+struct Model {
+    std::string slug;
+    virtual ~Model() {}
+    virtual engine::Module* createModule() = 0;
+};
+
+} // namespace plugin
+
+// Model whose createModule() builds a TModule; TModuleWidget is never built
+template<class TModule, class TModuleWidget>
+plugin::Model* createModel(std::string slug) {
+    struct TModel : plugin::Model {
+        engine::Module* createModule() override {
+            engine::Module* m = new TModule;
+            m->model = this;
+            return m;
+        }
+    };
+    TModel* model = new TModel;
+    model->slug = slug;
+    return model;
+}
+
+inline void Context::Engine::setParamValue(engine::Module* module, int paramId, float value) {
+    module->params[paramId].setValue(value);
+}
+
+namespace asset {
+std::string plugin(plugin::Plugin* p, const std::string& filename);
+std::string user(const std::string& filename);
+std::string system(const std::string& filename);
+}
+
+namespace settings {
+extern float sampleRate;
+}
+
+} // namespace rack
@@ -0,0 +1,493 @@
+/**
+ * Module CPU Benchmark (hand-written C++ modules)
+ *
+ * Times Module::process() for the sequencers, clocks and quantizers that
+ * have no Faust DSP, built against the headless Rack mock in mock_rack/
+ * instead of the SDK. Each module is driven the way a patch would drive
+ * it: inputs named "Clock" get a 120 BPM square wave, other inputs get a
+ * slow sine CV (4 channels on poly inputs, see --channels), and reset,
+ * trigger and bus inputs stay unpatched. Every output is patched.
+ *
+ * Configured with WIGGLEROOM_PGO=generate, it also runs the Faust modules,
+ * built from the headers their *_Module targets generate (the plugin's
+ * entry points and namespaces), as the PGO training workload. Their gate
+ * and trigger inputs get the clock and their audio inputs a 110 Hz
+ * saw, so the voices actually sound.
+ *
+ * Results use the faust_bench JSON format, with a block size of 1 as Rack
+ * calls process() once per sample, so module_bench and faust_bench
+ * results can be compared with the same tools.
+ *
+ * Usage:
+ *   ./module_bench --output modules.json
+ *   ./module_bench --module Cycloid --sample-rates 48000
+ *   ./module_bench --compare baseline.json --output modules.json
+ */
+
+#include "rack.hpp"
+#include "ModuleTestConfig.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace WiggleRoom::TestConfig;
+using rack::engine::Module;
+using rack::plugin::Model;
+
+extern Model* modelCycloid;
+extern Model* modelIntersect;
+extern Model* modelGravityClock;
+extern Model* modelTheWeaver;
+extern Model* modelTheArchitect;
+extern Model* modelPreFlightClock;
+
+// Faust modules in a PGO training build (module_bench_faust.inc is written
+// by test/CMakeLists.txt)
+#ifdef WR_MODULE_BENCH_FAUST
+#define WR_FAUST_BENCH_MODULE(name) extern Model* model##name;
+#include "module_bench_faust.inc"
+#undef WR_FAUST_BENCH_MODULE
+#endif
+
+// ============================================================================
+// Module Registry
+// ============================================================================
+
+struct BenchModule {
+    const char* name;
+    Model** model;
+    std::vector<std::string> pressParams;  // Buttons pressed once at the start (by label)
+    bool instrument = false;               // Feed gates, triggers and audio inputs
+};
+
+// Add a module here and its .cpp to module_bench in test/CMakeLists.txt
+const std::vector<BenchModule>& benchModules() {
+    static const std::vector<BenchModule> modules = {
+        {"Cycloid", &modelCycloid, {}},
+        {"Intersect", &modelIntersect, {}},
+        {"GravityClock", &modelGravityClock, {}},
+        {"TheWeaver", &modelTheWeaver, {}},
+        {"TheArchitect", &modelTheArchitect, {}},
+        {"PreFlightClock", &modelPreFlightClock, {"Play"}},
+#ifdef WR_MODULE_BENCH_FAUST
+#define WR_FAUST_BENCH_MODULE(name) {#name, &model##name, {}, true},
+#include "module_bench_faust.inc"
+#undef WR_FAUST_BENCH_MODULE
+#endif
+    };
+    return modules;
+}
+
+const BenchModule* findModule(const std::string& name) {
+    for (const auto& m : benchModules()) {
+        if (name == m.name) return &m;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Options
+// ============================================================================
+
+struct Options {
+    std::vector<std::string> modules;       // Empty = all registered modules
+    std::vector<int> sampleRates = {48000, 96000};
+    int channels = 4;                       // Channels on poly inputs
+    float seconds = 2.0f;                   // Audio rendered per timed run
+    float warmup = 0.5f;                    // Audio rendered before timing
+    int repeats = 5;                        // Timed runs per configuration
+    std::string outputFile;                 // Empty = stdout
+    std::string compareFile;                // Baseline JSON to compare against
+    bool list = false;
+};
+
+std::vector<int> parseIntList(const std::string& s) {
+    std::vector<int> values;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::stoi(item));
+    }
+    return values;
+}
+
+void printUsage(const char* programName) {
+    std::cerr << "Usage: " << programName << " [options]\n"
+              << "\nOptions:\n"
+              << "  --module NAME          Module to benchmark (repeatable, default: all)\n"
+              << "  --sample-rates LIST    Comma-separated sample rates (default: 48000,96000)\n"
+              << "  --channels N           Channels on poly inputs, 1-16 (default: 4)\n"
+              << "  --seconds SECS         Audio per timed run (default: 2.0)\n"
+              << "  --warmup SECS          Audio rendered before timing (default: 0.5)\n"
+              << "  --repeats N            Timed runs per configuration (default: 5)\n"
+              << "  --output FILE          Write JSON results to FILE (default: stdout)\n"
+              << "  --compare FILE         Print the change against a previous result file\n"
+              << "  --list                 List the modules and exit\n"
+              << "  --help                 Show this help\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& opts) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return false;
+        }
+        if (arg == "--list") {
+            opts.list = true;
+            continue;
+        }
+        if (arg == "--module" && i + 1 < argc) {
+            opts.modules.push_back(argv[++i]);
+            continue;
+        }
+        if (arg == "--sample-rates" && i + 1 < argc) {
+            opts.sampleRates = parseIntList(argv[++i]);
+            continue;
+        }
+        if (arg == "--channels" && i + 1 < argc) {
+            opts.channels = rack::math::clamp(std::stoi(argv[++i]), 1, rack::PORT_MAX_CHANNELS);
+            continue;
+        }
+        if (arg == "--seconds" && i + 1 < argc) {
+            opts.seconds = std::stof(argv[++i]);
+            continue;
+        }
+        if (arg == "--warmup" && i + 1 < argc) {
+            opts.warmup = std::stof(argv[++i]);
+            continue;
+        }
+        if (arg == "--repeats" && i + 1 < argc) {
+            opts.repeats = std::max(1, std::stoi(argv[++i]));
+            continue;
+        }
+        if (arg == "--output" && i + 1 < argc) {
+            opts.outputFile = argv[++i];
+            continue;
+        }
+        if (arg == "--compare" && i + 1 < argc) {
+            opts.compareFile = argv[++i];
+            continue;
+        }
+
+        std::cerr << "Unknown argument: " << arg << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Stimulus
+// ============================================================================
+
+enum class InputKind { Unpatched, Clock, CV, Audio };
+
+// Decide from the configInput() label how a patch would feed an input
+InputKind classifyInput(std::string name, bool instrument) {
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    auto has = [&](const char* word) { return name.find(word) != std::string::npos; };
+
+    if (has("cv")) return InputKind::CV;  // "Clock Div/Mult CV" is a CV
+    if (has("clock")) return InputKind::Clock;
+    if (instrument) {
+        if (has("gate") || has("trig") || has("accent")) return InputKind::Clock;
+        if (has("audio") || has("left") || has("right") || has("return") || has("signal")) {
+            return InputKind::Audio;
+        }
+    }
+    if (has("reset") || has("trig") || has("stop") || has("play") || has("bus")) {
+        return InputKind::Unpatched;
+    }
+    return InputKind::CV;
+}
+
+/**
+ * Pre-rendered clock and CV for one benchmark run
+ *
+ * The clock is a 10V square wave at 2 Hz (120 BPM, 50% duty). CV is a
+ * 0-2V sine at 0.13 Hz per channel, each channel a quarter cycle further
+ * on, so quantizers and pattern selectors keep crossing boundaries. Audio
+ * is a +/-5V saw at 110 Hz. All are generated up front so the timed loop
+ * only copies voltages.
+ */
+struct Stimulus {
+    std::vector<float> clock;  // [sample]
+    std::vector<float> audio;  // [sample]
+    std::vector<float> cv;     // [sample * PORT_MAX_CHANNELS + channel]
+
+    void build(int sampleRate, int numSamples, int channels) {
+        const float pi = 3.14159265358979f;
+        int period = sampleRate / 2;
+        clock.resize(numSamples);
+        audio.resize(numSamples);
+        cv.assign(static_cast<size_t>(numSamples) * rack::PORT_MAX_CHANNELS, 0.0f);
+        for (int i = 0; i < numSamples; i++) {
+            clock[i] = (i % period < period / 2) ? 10.0f : 0.0f;
+            float t = static_cast<float>(i) / sampleRate;
+            float saw = 110.0f * t;
+            audio[i] = 10.0f * (saw - std::floor(saw)) - 5.0f;
+            for (int c = 0; c < channels; c++) {
+                float phase = 2.0f * pi * (0.13f * t + 0.25f * c);
+                cv[static_cast<size_t>(i) * rack::PORT_MAX_CHANNELS + c] = 1.0f + std::sin(phase);
+            }
+        }
+    }
+};
+
+struct PatchedInput {
+    rack::engine::Input* input;
+    InputKind kind;
+};
+
+// Connect inputs and outputs as the stimulus expects; returns the fed inputs
+std::vector<PatchedInput> patchModule(Module& module, int polyChannels, bool instrument) {
+    std::vector<PatchedInput> patched;
+    for (size_t i = 0; i < module.inputs.size(); i++) {
+        std::string name = module.inputInfos[i] ? module.inputInfos[i]->name : "";
+        InputKind kind = classifyInput(name, instrument);
+        if (kind == InputKind::Unpatched) continue;
+
+        bool poly = name.find("poly") != std::string::npos;
+        module.inputs[i].setChannels(kind == InputKind::CV && poly ? polyChannels : 1);
+        patched.push_back({&module.inputs[i], kind});
+    }
+    for (auto& output : module.outputs) output.channels = 1;
+    return patched;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+struct BenchResult {
+    std::string module;
+    int sampleRate = 0;
+    int blockSize = 1;
+    double nsPerSampleMean = 0.0;
+    double nsPerSampleMin = 0.0;
+    double nsPerSampleStddev = 0.0;
+    double cpuPercent48k = 0.0;  // Share of one core needed to run in real time at 48 kHz
+};
+
+// Keeps the compiler from discarding outputs that are never read
+static volatile float benchSink = 0.0f;
+
+// Run process() numSamples times; returns elapsed nanoseconds
+double runSamples(Module& module, const std::vector<PatchedInput>& patched,
+                  const Stimulus& stim, Module::ProcessArgs& args, int numSamples) {
+    float acc = 0.0f;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < numSamples; i++) {
+        for (const auto& p : patched) {
+            if (p.kind == InputKind::Clock) {
+                p.input->voltages[0] = stim.clock[i];
+            } else if (p.kind == InputKind::Audio) {
+                p.input->voltages[0] = stim.audio[i];
+            } else {
+                const float* v = &stim.cv[static_cast<size_t>(i) * rack::PORT_MAX_CHANNELS];
+                std::memcpy(p.input->voltages, v, p.input->channels * sizeof(float));
+            }
+        }
+        module.process(args);
+        args.frame++;
+        for (const auto& output : module.outputs) acc += output.voltages[0];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    benchSink = benchSink + acc;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+BenchResult benchmark(const BenchModule& entry, int sampleRate, const Options& opts) {
+    std::unique_ptr<Module> module((*entry.model)->createModule());
+
+    Module::SampleRateChangeEvent e;
+    e.sampleRate = static_cast<float>(sampleRate);
+    e.sampleTime = 1.0f / sampleRate;
+    module->onSampleRateChange(e);
+
+    Module::ProcessArgs args;
+    args.sampleRate = e.sampleRate;
+    args.sampleTime = e.sampleTime;
+
+    std::vector<PatchedInput> patched = patchModule(*module, opts.channels, entry.instrument);
+
+    int warmupSamples = static_cast<int>(opts.warmup * sampleRate);
+    int numSamples = std::max(1, static_cast<int>(opts.seconds * sampleRate));
+
+    // One stimulus covers the warmup and a single run; every timed run
+    // replays the same input so runs are comparable
+    Stimulus stim;
+    stim.build(sampleRate, std::max(warmupSamples, numSamples), opts.channels);
+
+    // Press the start buttons for one sample, as a click would
+    std::vector<int> pressed;
+    for (const auto& label : entry.pressParams) {
+        for (size_t i = 0; i < module->paramQuantities.size(); i++) {
+            if (module->paramQuantities[i] && module->paramQuantities[i]->name == label) {
+                module->params[i].setValue(1.0f);
+                pressed.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    runSamples(*module, patched, stim, args, 1);
+    for (int idx : pressed) module->params[idx].setValue(0.0f);
+
+    if (warmupSamples > 0) {
+        runSamples(*module, patched, stim, args, warmupSamples);
+    }
+
+    std::vector<double> nsPerSample;
+    for (int r = 0; r < opts.repeats; r++) {
+        double ns = runSamples(*module, patched, stim, args, numSamples);
+        nsPerSample.push_back(ns / numSamples);
+    }
+
+    double mean = 0.0;
+    for (double v : nsPerSample) mean += v;
+    mean /= nsPerSample.size();
+    double variance = 0.0;
+    for (double v : nsPerSample) variance += (v - mean) * (v - mean);
+    if (nsPerSample.size() > 1) variance /= (nsPerSample.size() - 1);
+
+    BenchResult result;
+    result.module = entry.name;
+    result.sampleRate = sampleRate;
+    result.nsPerSampleMean = mean;
+    result.nsPerSampleMin = *std::min_element(nsPerSample.begin(), nsPerSample.end());
+    result.nsPerSampleStddev = std::sqrt(variance);
+    result.cpuPercent48k = mean * 48000.0 / 1e9 * 100.0;
+    return result;
+}
+
+// ============================================================================
+// JSON Output
+// ============================================================================
+
+std::string resultKey(const std::string& module, int sampleRate, int blockSize) {
+    return module + "@" + std::to_string(sampleRate) + "/" + std::to_string(blockSize);
+}
+
+void writeJson(std::ostream& out, const Options& opts, const std::vector<BenchResult>& results) {
+    char buf[512];
+    out << "{\n";
+    out << "  \"version\": 1,\n";
+    std::snprintf(buf, sizeof(buf),
+                  "  \"config\": {\"seconds\": %.3f, \"warmup\": %.3f, \"repeats\": %d, \"channels\": %d},\n",
+                  opts.seconds, opts.warmup, opts.repeats, opts.channels);
+    out << buf;
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        std::snprintf(buf, sizeof(buf),
+                      "    {\"module\": \"%s\", \"sample_rate\": %d, \"block_size\": %d, "
+                      "\"ns_per_sample\": %.3f, \"ns_per_sample_min\": %.3f, "
+                      "\"ns_per_sample_stddev\": %.3f, \"cpu_percent_48k\": %.4f}%s\n",
+                      r.module.c_str(), r.sampleRate, r.blockSize,
+                      r.nsPerSampleMean, r.nsPerSampleMin, r.nsPerSampleStddev,
+                      r.cpuPercent48k, (i + 1 < results.size()) ? "," : "");
+        out << buf;
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+// Print the ns/sample change for every configuration present in both runs
+bool compareWithBaseline(const std::string& path, const std::vector<BenchResult>& results) {
+    JsonValue baseline = load_json_file(path);
+    const JsonValue& rows = baseline["results"];
+    if (!rows.is_array()) {
+        std::cerr << "Error: No results in baseline file: " << path << "\n";
+        return false;
+    }
+
+    std::map<std::string, double> before;
+    for (const auto& row : rows.array_val) {
+        std::string key = resultKey(row["module"].get_string(),
+                                    static_cast<int>(row["sample_rate"].get_number()),
+                                    static_cast<int>(row["block_size"].get_number()));
+        before[key] = row["ns_per_sample"].get_number();
+    }
+
+    std::cerr << "\nChange vs " << path << " (ns/sample):\n";
+    for (const auto& r : results) {
+        auto it = before.find(resultKey(r.module, r.sampleRate, r.blockSize));
+        if (it == before.end() || it->second <= 0.0) continue;
+        double change = (r.nsPerSampleMean - it->second) / it->second * 100.0;
+        char buf[256];
+        std::snprintf(buf, sizeof(buf), "  %-20s %6d Hz  %9.2f -> %9.2f  (%+.1f%%)\n",
+                      r.module.c_str(), r.sampleRate, it->second, r.nsPerSampleMean, change);
+        std::cerr << buf;
+    }
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        return 1;
+    }
+    if (opts.list) {
+        for (const auto& m : benchModules()) std::cout << m.name << "\n";
+        return 0;
+    }
+
+    std::vector<const BenchModule*> modules;
+    for (const auto& name : opts.modules) {
+        const BenchModule* m = findModule(name);
+        if (!m) {
+            std::cerr << "Error: Unknown module: " << name << "\n";
+            return 1;
+        }
+        modules.push_back(m);
+    }
+    if (modules.empty()) {
+        for (const auto& m : benchModules()) modules.push_back(&m);
+    }
+    std::vector<BenchResult> results;
+
+    for (const BenchModule* m : modules) {
+        for (int sr : opts.sampleRates) {
+            if (sr <= 0) continue;
+            BenchResult r = benchmark(*m, sr, opts);
+            char buf[256];
+            std::snprintf(buf, sizeof(buf), "%-24s %6d Hz  %9.2f ns/sample  (%.2f%% @ 48k, sd %.2f)\n",
+                          m->name, sr, r.nsPerSampleMean, r.cpuPercent48k, r.nsPerSampleStddev);
+            std::cerr << buf;
+            results.push_back(r);
+        }
+    }
+
+    if (opts.outputFile.empty()) {
+        writeJson(std::cout, opts, results);
+    } else {
+        std::ofstream file(opts.outputFile);
+        if (!file) {
+            std::cerr << "Error: Cannot open file for writing: " << opts.outputFile << std::endl;
+            return 1;
+        }
+        writeJson(file, opts, results);
+        std::cerr << "Wrote " << opts.outputFile << "\n";
+    }
+
+    if (!opts.compareFile.empty() && !compareWithBaseline(opts.compareFile, results)) {
+        return 1;
+    }
+    return 0;
+}
@@ -22,6 +22,10 @@
 #include <cmath>
 #include <sstream>
 
+#include "DSP.hpp"
+#include "../src/modules/OctoLFO/LFOKernel.hpp"
+#include "ScopeRing.hpp"
+
 // We need to include the OctoLFO implementation
 // Define the necessary VCV Rack types as stubs for testing
 namespace rack {
@@ -220,11 +224,9 @@ struct OctoLFOTest : Module {
     // LFO state
     float phases[NUM_LFOS] = {};
 
-    // Scope buffers
-    float scopeBuffer[NUM_LFOS][SCOPE_BUFFER_SIZE] = {};
-    int scopeWriteIndex[NUM_LFOS] = {};
-    int scopeDownsample = 0;
+    // Scope history (min/max per frame)
     static constexpr int SCOPE_DOWNSAMPLE_RATE = 256;  // 4x zoom out from original 64
+    ScopeRing<SCOPE_BUFFER_SIZE, NUM_LFOS> scope;
 
     OctoLFOTest() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -244,45 +246,25 @@ struct OctoLFOTest : Module {
         configInput(CLOCK_INPUT, "Clock");
         configInput(RESET_INPUT, "Reset");
         configLight(CLOCK_LIGHT, "Clock Lock");
-    }
-
-    float applySkew(float phase, float skew) {
-        if (std::abs(skew) < 0.001f) return phase;
-        float power = std::pow(2.f, -skew * 2.f);
-        return std::pow(phase, power);
-    }
 
-    float applyCurve(float value, float curve) {
-        if (std::abs(curve) < 0.001f) return value;
-        float power = std::pow(3.f, curve);
-        return std::pow(value, power);
+        scope.setDecimation(SCOPE_DOWNSAMPLE_RATE);
     }
 
-    float applyFold(float value, int foldIndex) {
-        if (foldIndex <= 0 || foldIndex >= (int)FOLD_VALUES.size()) return value;
-        float foldAmount = FOLD_VALUES[foldIndex];
-        if (foldAmount < 0.001f) return value;
-        float gain = 1.f + foldAmount * 4.f;
-        float folded = value * gain;
-        folded = std::sin(folded * M_PI);
-        return folded;
+    // Scalar instance of the module's float_4 lane kernel (one LFO per call)
+    OctoLFOKernel::Shape<float> laneShape(int wave, float skew, float curve, int foldIndex) {
+        OctoLFOKernel::LaneShape lane;
+        lane.setWave(wave);
+        lane.setSkew(skew);
+        lane.setCurve(curve);
+        bool validFold = foldIndex > 0 && foldIndex < (int)FOLD_VALUES.size();
+        lane.setFold(validFold ? FOLD_VALUES[foldIndex] : 0.f);
+        OctoLFOKernel::Shape<float> shape;
+        OctoLFOKernel::storeLane(shape, 0, lane);
+        return shape;
     }
 
     float generateWave(float phase, WaveType wave) {
-        switch (wave) {
-            case WAVE_SINE:
-                return std::sin(phase * 2.f * M_PI);
-            case WAVE_TRIANGLE:
-                return (phase < 0.5f) ? (phase * 4.f - 1.f) : (3.f - phase * 4.f);
-            case WAVE_SAW_UP:
-                return phase * 2.f - 1.f;
-            case WAVE_SAW_DOWN:
-                return 1.f - phase * 2.f;
-            case WAVE_SQUARE:
-                return (phase < 0.5f) ? -1.f : 1.f;
-            default:
-                return 0.f;
-        }
+        return OctoLFOKernel::wave(phase, laneShape(wave, 0.f, 0.f, 0));
     }
 
     void process(float sampleTime) {
@@ -316,10 +298,7 @@ struct OctoLFOTest : Module {
 
         bool unipolar = params[BIPOLAR_PARAM].getValue() > 0.5f;
 
-        scopeDownsample++;
-        bool updateScope = (scopeDownsample >= SCOPE_DOWNSAMPLE_RATE);
-        if (updateScope) scopeDownsample = 0;
-
+        float scopeFrame[NUM_LFOS];
         for (int i = 0; i < NUM_LFOS; i++) {
             int lfoRateIndex = static_cast<int>(params[RATE_PARAM + i].getValue());
             lfoRateIndex = clamp(lfoRateIndex, 0, (int)CHANNEL_RATE_VALUES.size() - 1);
@@ -327,25 +306,14 @@ struct OctoLFOTest : Module {
             float combinedRate = masterRate * lfoRate;
             float freq = combinedRate / clockPeriod;
 
-            phases[i] += freq * dt;
-            while (phases[i] >= 1.f) phases[i] -= 1.f;
-            while (phases[i] < 0.f) phases[i] += 1.f;
+            phases[i] = OctoLFOKernel::advance(phases[i], freq * dt);
 
-            WaveType wave = static_cast<WaveType>(
-                static_cast<int>(params[WAVE_PARAM + i].getValue()));
+            int wave = static_cast<int>(params[WAVE_PARAM + i].getValue());
             float skew = params[SKEW_PARAM + i].getValue();
             float curve = params[CURVE_PARAM + i].getValue();
             int foldIndex = static_cast<int>(params[FOLD_PARAM + i].getValue());
 
-            float skewedPhase = applySkew(phases[i], skew);
-            float output = generateWave(skewedPhase, wave);
-
-            float normalized = (output + 1.f) * 0.5f;
-            normalized = applyCurve(normalized, curve);
-            output = normalized * 2.f - 1.f;
-
-            output = applyFold(output, foldIndex);
-            output = clamp(output, -1.f, 1.f);
+            float output = OctoLFOKernel::shape(phases[i], laneShape(wave, skew, curve, foldIndex));
 
             float voltage;
             if (unipolar) {
@@ -355,11 +323,9 @@ struct OctoLFOTest : Module {
             }
             outputs[LFO_OUTPUT + i].setVoltage(voltage);
 
-            if (updateScope) {
-                scopeBuffer[i][scopeWriteIndex[i]] = output;
-                scopeWriteIndex[i] = (scopeWriteIndex[i] + 1) % SCOPE_BUFFER_SIZE;
-            }
+            scopeFrame[i] = output;
         }
+        scope.push(scopeFrame);
     }
 };
 
@@ -443,6 +409,21 @@ int main(int argc, char** argv) {
         std::vector<std::pair<std::string, float>> result;
         result.push_back({"buffer_size", WiggleRoom::OctoLFOTest::SCOPE_BUFFER_SIZE});
         result.push_back({"downsample_rate", WiggleRoom::OctoLFOTest::SCOPE_DOWNSAMPLE_RATE});
+
+        // Run long enough to wrap the ring, then read LFO 1 back like the widget does
+        constexpr int size = WiggleRoom::OctoLFOTest::SCOPE_BUFFER_SIZE;
+        WiggleRoom::OctoLFOTest module;
+        for (int n = 0; n < 2 * size * WiggleRoom::OctoLFOTest::SCOPE_DOWNSAMPLE_RATE; n++) {
+            module.process(1.f / 48000.f);
+        }
+        float mins[size], maxs[size];
+        int frames = module.scope.snapshotChannel(0, mins, maxs, size);
+        bool ordered = true;
+        for (int i = 0; i < frames; i++) {
+            ordered = ordered && mins[i] <= maxs[i];
+        }
+        result.push_back({"snapshot_frames", (float)frames});
+        result.push_back({"envelope_ordered", ordered ? 1.f : 0.f});
         printJsonObject(result);
         return 0;
     }
@@ -134,6 +134,15 @@ class TestEuclideanRhythms:
         expected = original[1:] + original[:1]
         assert result["pattern"] == expected, f"Expected {expected}, got {result['pattern']}"
 
+    def test_euclidean_64_steps(self):
+        """64-step patterns (full bitmask width) keep their hit count under rotation"""
+        for hits, rotation in [(17, 0), (17, 63), (63, 5), (64, 31)]:
+            result = run_test(["--test-euclidean", "--steps=64", f"--hits={hits}",
+                               f"--rotation={rotation}"])
+            pattern = result["pattern"]
+            assert len(pattern) == 64, f"E({hits},64) r{rotation}: length {len(pattern)}"
+            assert sum(pattern) == hits, f"E({hits},64) r{rotation}: {sum(pattern)} hits"
+
     def test_euclidean_tick_sequence(self):
         """tick() should return correct sequence"""
         result = run_test(["--test-euclidean-tick", "--steps=8", "--hits=3", "--ticks=8"])
@@ -251,6 +260,7 @@ class TestTruthTable:
     def test_undo_restores_state(self):
         """Undo should restore previous state"""
         result = run_test(["--test-truth-undo"])
+        assert result["changed"] == True, "Randomize should change the mapping"
         assert result["restored"] == True, "Undo should restore previous state"
 
 
@@ -284,6 +294,12 @@ class TestProbabilityGate:
         result = run_test(["--test-probability-determinism", "--seed=42"])
         assert result["match"] == True, "Same seed should produce identical results"
 
+    def test_streams_independent(self):
+        """Same seed on different stream ids gives different sequences"""
+        result = run_test(["--test-probability-determinism", "--seed=42"])
+        assert result["streams_differ"] == True, "Stream 1 repeated stream 0"
+        assert result["counter_random_access"] == True, "CounterRng at(i) != i-th next()"
+
     def test_different_probabilities(self):
         """Different probabilities should produce different distributions"""
         result_25 = run_test(["--test-probability", "--prob=0.25", "--seed=99", "--trials=1000"])
@@ -210,6 +210,12 @@ class TestScopeBuffer:
         # This test expects the NEW rate (256), will FAIL initially
         assert result["downsample_rate"] == 256, f"Expected 256, got {result['downsample_rate']}"
 
+    def test_scope_snapshot(self):
+        """A wrapped scope ring should hand back a full, ordered min/max history."""
+        result = run_test(["--test-scope-buffer"])
+        assert result["snapshot_frames"] == 256, f"Expected 256 frames, got {result['snapshot_frames']}"
+        assert result["envelope_ordered"] == 1, "Scope frame with min > max"
+
 
 class TestCombinedRate:
     """Tests for combined rate calculation (master * channel)."""
@@ -0,0 +1,375 @@
+/******************************************************************************
+ * Unit tests for the C++ DSP banks that replaced Faust graphs
+ * LadderBank, MorphSvfBank, EnsembleBank (src/common) and ModalVoice
+ * (ModalBell), each against a per-sample double-precision reference of
+ * the Faust code it replaced
+ *
+ * Build: g++ -std=c++17 -O2 -Imock_rack -I../src/common -I../src/modules/ModalBell -o test_simd_banks test_simd_banks.cpp
+ * Run:   ./test_simd_banks
+ ******************************************************************************/
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "rack.hpp"
+#include "LadderBank.hpp"
+#include "MorphSvfBank.hpp"
+#include "EnsembleBank.hpp"
+#include "ModalVoice.hpp"
+
+using rack::simd::float_4;
+
+static const double SR = 48000.0;
+static const int INTERVAL = 16;   // Control interval used by the modules
+
+// si.smoo, one step per sample
+static void smoo(double& state, double target) {
+    state = 0.999 * state + 0.001 * target;
+}
+
+void test_smoo_step() {
+    WiggleRoom::SmooStep step;
+    assert(std::fabs(step.coefficient(16) - (1.0 - std::pow(0.999, 16))) < 1e-6);
+    assert(std::fabs(step.coefficient(1) - 0.001f) < 1e-6f);
+    assert(step.coefficient(0) == 0.f);
+    std::cout << "PASS: test_smoo_step\n";
+}
+
+void test_channel_count() {
+    WiggleRoom::LadderBank ladder;
+    ladder.setChannelCount(5);
+    assert(ladder.getChannelCount() == 5 && ladder.getGroupCount() == 2);
+    ladder.setChannelCount(0);
+    assert(ladder.getChannelCount() == 1 && ladder.getGroupCount() == 1);
+    ladder.setChannelCount(99);
+    assert(ladder.getChannelCount() == 16 && ladder.getGroupCount() == 4);
+
+    // A group coming back into use starts silent
+    ladder.setControls(3, float_4(1000.f), float_4(0.5f), INTERVAL);
+    for (int i = 0; i < 100; i++) ladder.process(3, float_4(1.f));
+    ladder.setChannelCount(4);
+    ladder.setChannelCount(16);
+    ladder.setControls(3, float_4(1000.f), float_4(0.5f), INTERVAL);
+    float_4 y = ladder.process(3, float_4(0.f));
+    for (int lane = 0; lane < 4; lane++) assert(y[lane] == 0.f);
+    std::cout << "PASS: test_channel_count\n";
+}
+
+// ve.moog_vcf_2bn: two tf2s sections, direct form I in double
+struct MoogReference {
+    struct Section {
+        double b0 = 0, a1 = 0, a2 = 0, x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        void tune(double a1s, double a0s, double c) {
+            double d = a0s + a1s * c + c * c;
+            b0 = 1 / d;
+            a1 = 2 * (a0s - c * c) / d;
+            a2 = (a0s - a1s * c + c * c) / d;
+        }
+        double process(double x) {
+            double y = b0 * (x + 2 * x1 + x2) - a1 * y1 - a2 * y2;
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            return y;
+        }
+    };
+    Section sections[2];
+    double cutoff = 0, resonance = 0;
+    bool primed = false;
+
+    double process(double x, double targetCutoff, double targetResonance) {
+        if (!primed) {
+            cutoff = targetCutoff;
+            resonance = targetResonance;
+            primed = true;
+        } else {
+            smoo(cutoff, targetCutoff);
+            smoo(resonance, targetResonance);
+        }
+        double fc = std::min(std::max(cutoff, 20.0), 10000.0);
+        double k = std::min(std::sqrt(2.0) * 0.99999, std::sqrt(2.0) * std::max(resonance, 0.0));
+        double s2k = std::sqrt(2.0) * k;
+        double c = 1 / std::tan(M_PI * fc / SR);
+        sections[0].tune(2 + s2k, 1 + s2k + k * k, c);
+        sections[1].tune(2 - s2k, 1 - s2k + k * k, c);
+        return sections[1].process(sections[0].process(x));
+    }
+};
+
+void test_ladder_matches_reference() {
+    WiggleRoom::LadderBank ladder;
+    ladder.setSampleRate(SR);
+    ladder.setChannelCount(4);
+
+    const float baseCutoff[4] = {50.f, 500.f, 3000.f, 9000.f};
+    const float resonance[4] = {0.f, 0.5f, 0.9f, 0.95f};
+    MoogReference reference[4];
+    double heldError = 0, sweptError = 0, peak = 0;
+    int counter = 0;
+    for (int n = 0; n < 96000; n++) {
+        // Held for a second, then swept by half an octave at 1.5 Hz
+        float sweep = n < 48000 ? 1.f : std::exp2(0.5f * std::sin(n * 2.f * float(M_PI) * 1.5f / 48000.f));
+        float cutoff[4];
+        for (int v = 0; v < 4; v++) cutoff[v] = baseCutoff[v] * sweep;
+        if (--counter <= 0) {
+            counter = INTERVAL;
+            ladder.setControls(0, float_4::load(cutoff), float_4::load(resonance), INTERVAL);
+        }
+
+        // 5 V square at 120 Hz
+        float x = (n % 400) < 200 ? 5.f : -5.f;
+        float_4 y = ladder.process(0, float_4(x));
+        for (int v = 0; v < 4; v++) {
+            double ref = reference[v].process(x, cutoff[v], resonance[v]);
+            double& error = n < 48000 ? heldError : sweptError;
+            error = std::max(error, std::fabs(ref - y[v]));
+            peak = std::max(peak, std::fabs(ref));
+        }
+    }
+    std::cout << "  ladder: max error " << heldError * 1000 << " mV held, " << sweptError * 1000
+              << " mV swept, peak " << peak << " V" << std::endl;
+    // Sweeping, the bank retunes every INTERVAL samples instead of every sample
+    assert(heldError < 0.001);
+    assert(sweptError < 0.020);
+    std::cout << "PASS: test_ladder_matches_reference\n";
+}
+
+// SpectraHenge's node graph: fi.svf lp/bp/hp morph and cos/sin pan per node
+struct SvfReference {
+    double ic1 = 0, ic2 = 0;
+    double tilt = 0, pan = 0, q = 0;
+    bool primed = false;
+
+    void process(double x, double targetTilt, double targetPan, double targetQ, double& left, double& right) {
+        if (!primed) {
+            tilt = targetTilt;
+            pan = targetPan;
+            q = targetQ;
+            primed = true;
+        } else {
+            smoo(tilt, targetTilt);
+            smoo(pan, targetPan);
+            smoo(q, targetQ);
+        }
+        double f = 80 * std::pow(2.0, tilt * 7.6439);
+        double g = std::tan(M_PI * f / SR);
+        double k = 1 / q;
+        double v1 = (ic1 + g * (x - ic2)) / (1 + g * (g + k));
+        double v2 = ic2 + g * v1;
+        ic1 = 2 * v1 - ic1;
+        ic2 = 2 * v2 - ic2;
+        double lp = v2, bp = v1, hp = x - k * v1 - v2;
+        double y = tilt < 0.5 ? lp * (1 - 2 * tilt) + bp * 2 * tilt
+                              : bp * (2 - 2 * tilt) + hp * (2 * tilt - 1);
+        left += y * std::cos(pan * M_PI / 2);
+        right += y * std::sin(pan * M_PI / 2);
+    }
+};
+
+void test_morph_svf_matches_reference() {
+    WiggleRoom::MorphSvfBank bank;
+    bank.setSampleRate(SR);
+    bank.setChannelCount(4);
+
+    SvfReference reference[4];
+    double maxError = 0, peak = 0;
+    int counter = 0;
+    float tilt[4], pan[4];
+    float q = 3.f;
+    for (int n = 0; n < 96000; n++) {
+        // Pan swept by an LFO, tilt drifting, Q stepped down halfway
+        for (int i = 0; i < 4; i++) {
+            pan[i] = std::min(1.f, std::max(0.f, 0.2f * (i + 1) + 0.4f * std::sin(n * 0.0002f)));
+            tilt[i] = 0.15f + 0.2f * i + 0.1f * std::sin(n * 0.00005f * (i + 1));
+        }
+        if (n == 48000) q = 0.7f;
+        if (--counter <= 0) {
+            counter = INTERVAL;
+            bank.setControls(0, float_4::load(tilt), float_4::load(pan), q, INTERVAL);
+        }
+
+        // Node inputs in volts, scaled by 0.2 as in SpectraHenge
+        float x[4];
+        for (int i = 0; i < 4; i++) {
+            x[i] = (5.f * std::sin(n * 0.01f * (i + 1) + i) + 2.f * std::sin(n * 0.37f * (i + 1))) * 0.2f;
+        }
+        float_4 left = 0.f, right = 0.f;
+        bank.process(0, float_4::load(x), left, right);
+
+        double refL = 0, refR = 0;
+        for (int i = 0; i < 4; i++) reference[i].process(x[i], tilt[i], pan[i], q, refL, refR);
+
+        // Send bus: half the node sum at 5 V
+        double busL = (left[0] + left[1] + left[2] + left[3]) * 2.5;
+        double busR = (right[0] + right[1] + right[2] + right[3]) * 2.5;
+        maxError = std::max(maxError, std::fabs(refL * 2.5 - busL) + std::fabs(refR * 2.5 - busR));
+        peak = std::max(peak, std::fabs(refL * 2.5));
+    }
+    std::cout << "  morph svf: max error " << maxError * 1000 << " mV, peak " << peak << " V" << std::endl;
+    assert(maxError < 0.010);
+    std::cout << "PASS: test_morph_svf_matches_reference\n";
+}
+
+// tri_phase_ensemble.dsp: three fdelay taps, one-pole lowpass, dry/wet mix
+struct EnsembleReference {
+    std::vector<double> line = std::vector<double>(4096, 0.0);
+    int pos = 0;
+    double slowPhase = 0, fastPhase = 0;
+    double lastL = 0, lastR = 0, lowL = 0, lowR = 0;
+
+    void process(double x, double depth, double rate, double tone, double mix, double& left, double& right) {
+        slowPhase += 0.6 * rate / SR;
+        slowPhase -= std::floor(slowPhase);
+        fastPhase += 6.0 * rate / SR;
+        fastPhase -= std::floor(fastPhase);
+        pos = (pos + 1) & 4095;
+        line[pos] = x;
+
+        double voice[3];
+        for (int v = 0; v < 3; v++) {
+            double mod = (std::sin(2 * M_PI * (slowPhase + v / 3.0))
+                        + 0.15 * std::sin(2 * M_PI * (fastPhase + v / 3.0))) * 0.008 * depth;
+            double time = std::max(1.0, 0.012 * SR * (1 + mod));
+            int whole = static_cast<int>(time);
+            double frac = time - whole;
+            voice[v] = line[(pos - whole) & 4095] * (1 - frac) + line[(pos - whole - 1) & 4095] * frac;
+        }
+
+        double c = 1 / std::tan(M_PI * tone / SR);
+        double b0 = 1 / (1 + c), a1 = (1 - c) / (1 + c);
+        double wetL = voice[0] + 0.5 * voice[1];
+        double wetR = voice[2] + 0.5 * voice[1];
+        double yL = b0 * (wetL + lastL) - a1 * lowL;
+        double yR = b0 * (wetR + lastR) - a1 * lowR;
+        lastL = wetL;
+        lastR = wetR;
+        lowL = yL;
+        lowR = yR;
+        left = yL * mix + x * (1 - mix);
+        right = yR * mix + x * (1 - mix);
+    }
+};
+
+void test_ensemble_matches_reference() {
+    WiggleRoom::EnsembleBank ensemble;
+    ensemble.setSampleRate(SR);
+    ensemble.setChannelCount(4);
+
+    EnsembleReference reference;
+    double maxError = 0, peak = 0, maxInverted = 0;
+    int counter = 0;
+    for (int n = 0; n < 96000; n++) {
+        if (--counter <= 0) {
+            counter = INTERVAL;
+            ensemble.setControls(1.6f, 1.f, 3000.f, INTERVAL);
+            ensemble.setMix(0, float_4(0.8f), INTERVAL);
+        }
+        double x = 3 * std::sin(n * 0.013) + std::sin(n * 0.21);
+
+        // Lane 3 carries the inverted signal: channels are independent
+        ensemble.tick();
+        float_4 left, right;
+        ensemble.process(0, float_4(x, x, x, -x), left, right);
+
+        double refL, refR;
+        reference.process(static_cast<float>(x), 1.6, 1.0, 3000.0, 0.8, refL, refR);
+        maxError = std::max(maxError, std::max(std::fabs(refL - left[0]), std::fabs(refR - right[1])));
+        maxInverted = std::max(maxInverted, static_cast<double>(std::fabs(left[3] + left[0])));
+        peak = std::max(peak, std::fabs(refL));
+    }
+    std::cout << "  ensemble: max error " << maxError * 1000 << " mV, peak " << peak << " V" << std::endl;
+    assert(maxError < 0.006);
+    assert(maxInverted < 1e-4);
+    std::cout << "PASS: test_ensemble_matches_reference\n";
+}
+
+// Culling against the same voice with every mode kept
+void test_modal_culling_matches_full_bank() {
+    using WiggleRoom::ModalVoice;
+    for (int count : {ModalVoice::STANDARD_MODES, ModalVoice::MAX_MODES}) {
+        for (float morph : {0.f, 0.5f, 1.f}) {
+            ModalVoice culled, full;
+            ModalVoice::Controls controls;
+            controls.morph = morph;
+            controls.volts = -1.f;
+            controls.brightness = 0.7f;
+            culled.setControls(controls, count, SR);
+            full.setControls(controls, count, SR);
+
+            double maxError = 0, peak = 0;
+            long work = 0;
+            unsigned seed = 7;
+            const int n = 48000 * 8;
+            for (int i = 0; i < n; i++) {
+                if (i % INTERVAL == 0) {
+                    culled.update();
+                    full.excited = true;   // Never culls
+                    full.update();
+                }
+                // A noise burst every 2 s
+                float x = 0.f;
+                if (i % 96000 < 200) {
+                    seed = seed * 1664525u + 1013904223u;
+                    x = ((seed >> 8) / 16777216.f - 0.5f) * 0.1f;
+                }
+                float a = culled.process(x);
+                float b = full.process(x);
+                maxError = std::max(maxError, static_cast<double>(std::fabs(a - b)));
+                peak = std::max(peak, static_cast<double>(std::fabs(b)));
+                work += culled.numActive;
+            }
+            double averageActive = work / static_cast<double>(n);
+            std::cout << "  modal " << count << " modes, morph " << morph << ": error "
+                      << 20 * std::log10(maxError / peak) << " dB, " << averageActive
+                      << " of " << full.numEnabled << " modes active" << std::endl;
+            assert(maxError < peak * 1e-3);   // -60 dB
+            assert(averageActive < 0.5 * full.numEnabled);
+        }
+    }
+    std::cout << "PASS: test_modal_culling_matches_full_bank\n";
+}
+
+// fi.resonbp tuning: the fundamental rings at the pitch, modes above SR / 2.2 are off
+void test_modal_tuning() {
+    using WiggleRoom::ModalVoice;
+    ModalVoice voice;
+    ModalVoice::Controls controls;
+    controls.morph = 0.5f;
+    controls.brightness = 0.f;   // Fundamental only after the strike
+    controls.strike = 0.5f;
+    voice.setControls(controls, ModalVoice::MAX_MODES, SR);
+
+    // Ring on a single impulse and count zero crossings after the upper modes fade
+    int crossings = 0;
+    float last = 0.f;
+    for (int i = 0; i < 48000; i++) {
+        if (i % INTERVAL == 0) voice.update();
+        float y = voice.process(i == 0 ? 0.01f : 0.f);
+        if (i >= 24000 && (last < 0.f) != (y < 0.f)) crossings++;
+        last = y;
+    }
+    double measured = crossings * 0.5 / 0.5;
+    std::cout << "  modal: fundamental " << measured << " Hz" << std::endl;
+    assert(std::fabs(measured / 261.62 - 1) < 0.01);
+
+    // Six octaves up most of the 16 modes pass SR / 2.2 and are disabled
+    controls.volts = 6.f;
+    voice.setControls(controls, ModalVoice::MAX_MODES, SR);
+    voice.retune();
+    assert(voice.numEnabled >= 1 && voice.numEnabled < ModalVoice::MAX_MODES);
+    std::cout << "PASS: test_modal_tuning\n";
+}
+
+int main() {
+    test_smoo_step();
+    test_channel_count();
+    test_ladder_matches_reference();
+    test_morph_svf_matches_reference();
+    test_ensemble_matches_reference();
+    test_modal_culling_matches_full_bank();
+    test_modal_tuning();
+    std::cout << "\nAll SIMD bank tests passed!\n";
+    return 0;
+}
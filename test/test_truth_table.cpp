@@ -9,6 +9,8 @@
 #include <cassert>
 #include <iostream>
 #include "../src/common/euclogic/TruthTable.hpp"
+#include "../src/common/euclogic/ExpanderMessage.hpp"
+#include "../src/common/euclogic/Snapshot.hpp"
 
 void test_undo_after_mutate() {
     WiggleRoom::TruthTable tt;
@@ -153,8 +155,12 @@ void test_undo_redo_interleaved() {
     tt.mutate();
     auto state1 = tt.serialize();
 
+    // mutate() may flip one cell twice and change nothing; seed
+    // this one to a sequence that does change the table
+    tt.setSeed(43);
     tt.mutate();
     auto state2 = tt.serialize();
+    assert(state2 != state1);
 
     // Undo to state1
     tt.undo();
@@ -208,6 +214,162 @@ void test_toggle_clears_redo() {
     std::cout << "PASS: test_toggle_clears_redo\n";
 }
 
+void test_history_bounded() {
+    WiggleRoom::TruthTable tt;
+    tt.setSeed(42);
+    tt.setHistoryDepth(3);
+    auto state0 = tt.serialize();
+
+    // Five edits with a depth of three: the two oldest snapshots fall off
+    std::array<uint8_t, 16> states[6];
+    states[0] = state0;
+    for (int i = 1; i <= 5; i++) {
+        tt.pushUndo();
+        tt.toggleBit(i, 0);
+        states[i] = tt.serialize();
+    }
+    assert(tt.undoHistory.size() == 3);
+
+    assert(tt.undo() && tt.serialize() == states[4]);
+    assert(tt.undo() && tt.serialize() == states[3]);
+    assert(tt.undo() && tt.serialize() == states[2]);
+    assert(!tt.undo());
+    assert(tt.serialize() == states[2]);
+
+    // Redo walks all the way forward again
+    assert(tt.redo() && tt.redo() && tt.redo());
+    assert(tt.serialize() == states[5]);
+    assert(!tt.redo());
+    std::cout << "PASS: test_history_bounded\n";
+}
+
+void test_history_wraps_at_capacity() {
+    WiggleRoom::TruthTable tt;
+    tt.setSeed(7);
+    // Far more mutations than the ring holds; the newest undo must still be exact
+    for (int i = 0; i < 1000; i++) tt.mutate();
+    auto before = tt.serialize();
+    tt.mutate();
+    assert(tt.undoHistory.size() == tt.getHistoryDepth());
+    assert(tt.undo());
+    assert(tt.serialize() == before);
+    std::cout << "PASS: test_history_wraps_at_capacity\n";
+}
+
+// Reference: one scalar evaluate() per input state
+template<typename Table>
+uint8_t scalarEvaluate(const Table& tt, int state) {
+    constexpr int N = Table::N_BITS;
+    bool in[N], out[N];
+    for (int c = 0; c < N; c++) in[c] = (state >> c) & 1;
+    tt.evaluate(in, out);
+    uint8_t mask = 0;
+    for (int c = 0; c < N; c++) mask |= out[c] << c;
+    return mask;
+}
+
+template<typename Table>
+void checkBatchMatchesScalar(Table& tt, int trials) {
+    constexpr int N = Table::N_BITS;
+    for (int t = 0; t < trials; t++) {
+        tt.randomize();
+        // Every state, 16 lanes at a time
+        for (int base = 0; base < Table::N_STATES; base += 16) {
+            uint8_t states[16], lanes[16];
+            uint16_t sliced[N] = {}, slicedOut[N];
+            for (int l = 0; l < 16; l++) {
+                states[l] = static_cast<uint8_t>((base + l) % Table::N_STATES);
+                for (int c = 0; c < N; c++) {
+                    if ((states[l] >> c) & 1) sliced[c] |= 1 << l;
+                }
+            }
+            tt.evaluateLanes(states, lanes, 16);
+            tt.evaluateSliced(sliced, slicedOut);
+            for (int l = 0; l < 16; l++) {
+                uint8_t expected = scalarEvaluate(tt, states[l]);
+                assert(lanes[l] == expected);
+                uint8_t fromSliced = 0;
+                for (int c = 0; c < N; c++) fromSliced |= ((slicedOut[c] >> l) & 1) << c;
+                assert(fromSliced == expected);
+            }
+        }
+    }
+}
+
+void test_batch_matches_scalar() {
+    WiggleRoom::TruthTable tt4;
+    tt4.setSeed(3);
+    checkBatchMatchesScalar(tt4, 200);
+
+    WiggleRoom::TruthTableT<8> tt8;
+    tt8.setSeed(5);
+    checkBatchMatchesScalar(tt8, 20);
+
+    // Partial lane counts only write the lanes asked for
+    uint8_t states[3] = {1, 2, 3};
+    uint8_t out[4] = {0xAA, 0xAA, 0xAA, 0xAA};
+    tt4.evaluateLanes(states, out, 3);
+    assert(out[3] == 0xAA);
+    for (int l = 0; l < 3; l++) assert(out[l] == tt4.getMapping(states[l]));
+
+    // Lanes outside the mask stay low
+    uint16_t in[4] = {0, 0, 0, 0}, slicedOut[4];
+    tt4.loadPreset("NOR");
+    tt4.evaluateSliced(in, slicedOut, 0x0003);
+    for (int c = 0; c < 4; c++) assert(slicedOut[c] == 0x0003);
+    std::cout << "PASS: test_batch_matches_scalar\n";
+}
+
+void test_expander_message_widths() {
+    using Msg8 = WiggleRoom::EuclogicExpanderMessage8;
+
+    // Default table in the message matches a fresh 8-channel truth table
+    Msg8 msg;
+    WiggleRoom::TruthTableT<8> tt8;
+    for (int s = 0; s < Msg8::N_STATES; s++) assert(msg.logic.truthTableMapping[s] == tt8.getMapping(s));
+
+    // Packed gate words: bit c is channel c
+    msg.hot.gates = 0x81;
+    assert(msg.hot.gate(0) && msg.hot.gate(7) && !msg.hot.gate(3));
+
+    // Cold sections are copied only when the generation differs
+    Msg8 src, dst;
+    src.hot.valid = true;
+    src.logic.truthTableMapping[200] = 0x0F;
+    src.logic.generation = Msg8::nextGeneration();
+    dst.forward(src);
+    assert(dst.usable() && dst.logic.truthTableMapping[200] == 0x0F);
+    dst.logic.truthTableMapping[200] = 0;        // Same stamp: left alone
+    dst.forward(src);
+    assert(dst.logic.truthTableMapping[200] == 0);
+
+    // A 4-channel reader never accepts an 8-channel message
+    const auto* narrow = reinterpret_cast<const WiggleRoom::EuclogicExpanderMessage*>(&src);
+    assert(!narrow->usable());
+    std::cout << "PASS: test_expander_message_widths\n";
+}
+
+void test_recall_mailbox() {
+    using Snapshot = WiggleRoom::EuclogicSnapshotT<4>;
+    WiggleRoom::EuclogicDetail::Mailbox<Snapshot> mailbox;
+    Snapshot in, out;
+
+    assert(!mailbox.take(out));
+
+    // Latest post wins
+    in.seq.steps[0] = 5;
+    assert(mailbox.post(in));
+    in.seq.steps[0] = 7;
+    in.logic.truthTableMapping[3] = 0x0C;
+    assert(mailbox.post(in));
+    assert(mailbox.take(out));
+    assert(out.seq.steps[0] == 7 && out.logic.truthTableMapping[3] == 0x0C);
+
+    // Each post is taken once
+    assert(!mailbox.take(out));
+    std::cout << "PASS: test_recall_mailbox\n";
+}
+
 int main() {
     test_undo_after_mutate();
     test_undo_multiple();
@@ -221,6 +383,11 @@ int main() {
     test_undo_redo_interleaved();
     test_undo_after_load_preset();
     test_toggle_clears_redo();
+    test_history_bounded();
+    test_history_wraps_at_capacity();
+    test_batch_matches_scalar();
+    test_expander_message_widths();
+    test_recall_mailbox();
     std::cout << "\nAll TruthTable tests passed!\n";
     return 0;
 }
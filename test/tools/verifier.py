@@ -9,13 +9,15 @@ Output: Structured test results for the Judge Agent
 
 import json
 import os
-import re
 import subprocess
 import sys
 from dataclasses import dataclass, field, asdict
 from pathlib import Path
 from typing import Any
 
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+from utils import get_render_server  # noqa: E402
+
 
 def load_module_config(module_name: str, project_root: Path) -> dict:
     """Load test configuration for a module from its test_config.json file."""
@@ -280,34 +282,15 @@ class VerifierAgent:
             return False, str(e)
 
     def _test_render(self, module_name: str) -> RenderMetrics:
-        """Run basic render and analyze."""
+        """Run basic render and analyze (on the shared render server)."""
         metrics = RenderMetrics()
 
         try:
-            result = subprocess.run(
-                [str(self.faust_render), "--module", module_name,
-                 "--output", "/dev/null", "--duration", "2.0",
-                 "--param", "gate=5"],
-                capture_output=True,
-                text=True,
-                timeout=30
-            )
-
-            output = result.stdout + result.stderr
-
-            # Parse metrics
-            peak_match = re.search(r'Peak amplitude:\s*([\d.]+)', output)
-            if peak_match:
-                metrics.peak_amplitude = float(peak_match.group(1))
-
-            rms_match = re.search(r'RMS level:\s*([\d.]+)', output)
-            if rms_match:
-                metrics.rms_level = float(rms_match.group(1))
-
-            clip_match = re.search(r'Clipped samples:.*\(([\d.]+)%\)', output)
-            if clip_match:
-                metrics.clipping_percent = float(clip_match.group(1))
-
+            reply = get_render_server().analyze(module_name, duration=2.0, params={"gate": 5})
+            if reply.get("ok"):
+                metrics.peak_amplitude = reply["peak"]
+                metrics.rms_level = reply["rms"]
+                metrics.clipping_percent = reply["clip_percent"]
             metrics.is_silent = metrics.rms_level < 0.001
 
         except Exception as e:
@@ -316,58 +299,39 @@ class VerifierAgent:
         return metrics
 
     def _run_quality_tests(self, module_name: str) -> QualityMetrics:
-        """Run audio quality analysis."""
+        """Run audio quality analysis (in process, sharing the render server)."""
         metrics = QualityMetrics()
 
         try:
-            result = subprocess.run(
-                ["python3", "test/audio_quality.py",
-                 "--module", module_name, "--json"],
-                cwd=self.project_root,
-                capture_output=True,
-                text=True,
-                timeout=60
-            )
+            import tempfile
+            from audio_quality import test_module_quality
 
-            if result.returncode == 0:
-                # Parse JSON output - extract JSON from mixed output
-                try:
-                    stdout = result.stdout
-                    # Find the start of JSON array or object
-                    json_start = -1
-                    for i, c in enumerate(stdout):
-                        if c in '[{':
-                            json_start = i
-                            break
-                    if json_start >= 0:
-                        data = json.loads(stdout[json_start:])
-                        if data:
-                            q = data[0] if isinstance(data, list) else data
-                            metrics.overall_score = int(q.get("overall_quality_score", 0))
-
-                            if "thd" in q:
-                                metrics.thd_percent = q["thd"].get("thd_percent", 0)
-                                metrics.thd_fundamental = q["thd"].get("fundamental_freq", 0)
-
-                            if "harmonics" in q:
-                                metrics.warmth_ratio = q["harmonics"].get("warmth_ratio", 1)
-                                metrics.harmonic_character = q["harmonics"].get("character", "neutral")
-
-                            if "spectral" in q:
-                                metrics.spectral_entropy = q["spectral"].get("spectral_entropy", 0)
-                                metrics.hnr_db = q["spectral"].get("harmonic_to_noise_ratio", 0)
-                                metrics.crest_factor = q["spectral"].get("crest_factor", 0)
-                                metrics.dynamic_range_db = q["spectral"].get("dynamic_range_db", 0)
-
-                            if "envelope" in q:
-                                metrics.attack_ms = q["envelope"].get("attack_time_ms")
-                                metrics.decay_ms = q["envelope"].get("decay_time_ms")
-                                metrics.release_ms = q["envelope"].get("release_time_ms")
-                                metrics.peak_amplitude = q["envelope"].get("peak_amplitude", 0)
-
-                            metrics.issues = q.get("issues", [])
-                except json.JSONDecodeError:
-                    pass
+            with tempfile.TemporaryDirectory() as tmp:
+                q = test_module_quality(module_name, Path(tmp)).to_dict()
+
+            metrics.overall_score = int(q.get("overall_quality_score", 0))
+
+            if "thd" in q:
+                metrics.thd_percent = q["thd"].get("thd_percent", 0)
+                metrics.thd_fundamental = q["thd"].get("fundamental_freq", 0)
+
+            if "harmonics" in q:
+                metrics.warmth_ratio = q["harmonics"].get("warmth_ratio", 1)
+                metrics.harmonic_character = q["harmonics"].get("character", "neutral")
+
+            if "spectral" in q:
+                metrics.spectral_entropy = q["spectral"].get("spectral_entropy", 0)
+                metrics.hnr_db = q["spectral"].get("harmonic_to_noise_ratio", 0)
+                metrics.crest_factor = q["spectral"].get("crest_factor", 0)
+                metrics.dynamic_range_db = q["spectral"].get("dynamic_range_db", 0)
+
+            if "envelope" in q:
+                metrics.attack_ms = q["envelope"].get("attack_time_ms")
+                metrics.decay_ms = q["envelope"].get("decay_time_ms")
+                metrics.release_ms = q["envelope"].get("release_time_ms")
+                metrics.peak_amplitude = q["envelope"].get("peak_amplitude", 0)
+
+            metrics.issues = q.get("issues", [])
 
         except Exception as e:
             pass
@@ -6,8 +6,12 @@ This module consolidates common functions used across multiple test scripts
 to reduce code duplication and provide a consistent interface.
 """
 
+import atexit
 import json
+import os
+import selectors
 import subprocess
+import time
 from pathlib import Path
 from typing import Any
 
@@ -85,18 +89,11 @@ def run_faust_render(args: list[str], timeout: int = 60) -> tuple[bool, str]:
 
 def get_modules() -> list[str]:
     """Get list of available Faust modules."""
-    success, output = run_faust_render(["--list-modules"])
-    if not success:
+    try:
+        return get_render_server().modules()
+    except (OSError, RuntimeError):
         return []
 
-    modules = []
-    for line in output.strip().split("\n"):
-        line = line.strip()
-        if line and not line.startswith("Available"):
-            modules.append(line)
-
-    return modules
-
 
 def get_module_params(module_name: str) -> list[dict[str, Any]]:
     """
@@ -151,10 +148,13 @@ def render_audio(
     duration: float = DEFAULT_DURATION,
     sample_rate: int = SAMPLE_RATE,
     no_auto_gate: bool = False,
+    scenario: str | None = None,
 ) -> tuple[bool, str]:
     """
     Render audio for a module with given parameters.
 
+    Goes through the shared faust_render --serve process (get_render_server()).
+
     Args:
         module_name: Name of the Faust module
         params: Dict of parameter name -> value
@@ -162,24 +162,220 @@ def render_audio(
         duration: Duration in seconds
         sample_rate: Sample rate in Hz
         no_auto_gate: If True, don't auto-trigger gate
+        scenario: Optional test scenario name
 
     Returns:
         Tuple of (success, error_message_if_failed)
     """
-    args = [
-        "--module", module_name,
-        "--output", str(output_path),
-        "--duration", str(duration),
-        "--sample-rate", str(sample_rate),
+    job: dict[str, Any] = {"scenario": scenario} if scenario else {}
+    try:
+        reply = get_render_server().analyze(
+            module_name, **job, output=output_path, duration=duration,
+            sample_rate=sample_rate, no_auto_gate=no_auto_gate,
+            params={name: float(value) for name, value in params.items()},
+        )
+    except (OSError, RuntimeError) as e:
+        return False, str(e)
+    if not reply.get("ok"):
+        return False, reply.get("error", "render failed")
+    return True, ""
+
+
+def render_batch(
+    jobs: list[dict[str, Any]],
+    workers: int = 0,
+    timeout: int = 3600,
+) -> list[dict[str, Any]]:
+    """
+    Render many jobs with a single faust_render process (--jobs mode).
+
+    Each job is a dict with "module" plus optional "output", "params",
+    "duration", "sample_rate", "scenario", "showcase", "no_auto_gate",
+    "warmup" and "warmup_params". A job without "output" writes no file and
+    only returns its metrics. Jobs sharing a warm-up render it only once.
+    faust_render spreads the jobs over a worker pool, so this replaces
+    spawning one process per render.
+
+    Args:
+        jobs: Render jobs
+        workers: Worker threads (0 = all cores)
+        timeout: Timeout in seconds for the whole batch
+
+    Returns:
+        One result dict per job, in job order. Each has "ok" plus either the
+        streaming metrics ("peak", "rms", "dc_offset", "spectral_centroid",
+        ...) or "error".
+    """
+    results: list[dict[str, Any]] = [
+        {"ok": False, "error": "not rendered"} for _ in jobs
     ]
+    if not jobs:
+        return results
 
-    if no_auto_gate:
-        args.append("--no-auto-gate")
+    exe = get_render_executable()
+    if not exe.exists():
+        return [{"ok": False, "error": f"Executable not found: {exe}"} for _ in jobs]
 
-    for name, value in params.items():
-        args.extend(["--param", f"{name}={value}"])
+    job_lines = "\n".join(
+        json.dumps({**job, "output": str(job["output"])} if "output" in job else job)
+        for job in jobs
+    )
+    cmd = [str(exe), "--jobs", "-", "--workers", str(workers)]
+    try:
+        proc = subprocess.run(cmd, input=job_lines, capture_output=True,
+                              text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return [{"ok": False, "error": "Timeout"} for _ in jobs]
+    except Exception as e:
+        return [{"ok": False, "error": str(e)} for _ in jobs]
+
+    for line in proc.stdout.splitlines():
+        try:
+            result = json.loads(line)
+        except json.JSONDecodeError:
+            continue
+        index = result.get("index")
+        if isinstance(index, int) and 0 <= index < len(jobs):
+            results[index] = result
+
+    # Job file rejected before rendering (e.g. unknown module)
+    if proc.returncode != 0 and proc.stderr:
+        for result in results:
+            if result.get("error") == "not rendered":
+                result["error"] = proc.stderr.strip()
+
+    return results
 
-    return run_faust_render(args)
+
+class RenderServer:
+    """
+    A long-running faust_render --serve process.
+
+    Keeps DSP instances warm across requests and returns metrics (and, for
+    render(), the audio as a numpy array) over a pipe, so sweeps don't pay
+    for a process spawn and a WAV round-trip per point. Requests take the
+    same keys as render_batch() jobs; "output" is optional.
+
+    Each reply has to arrive within `timeout` seconds; a server that hangs
+    is killed and the request raises RuntimeError. The next request starts
+    a new one.
+
+    Usage:
+        with RenderServer() as server:
+            stats = server.analyze("LadderLPF", params={"cutoff": 0.3})
+            stats, audio = server.render("TheAbyss", duration=1.0)  # (channels, frames)
+    """
+
+    def __init__(self, exe: Path | None = None, timeout: float = 120.0):
+        self.exe = Path(exe) if exe else get_render_executable()
+        self.timeout = timeout
+        self.proc: subprocess.Popen | None = None
+        self._next_id = 0
+        self._buffer = bytearray()
+        self._deadline = 0.0   # Of the current request, also covers render()'s audio
+
+    def __enter__(self) -> "RenderServer":
+        self.start()
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def start(self) -> None:
+        if self.proc is None or self.proc.poll() is not None:
+            self.proc = subprocess.Popen(
+                [str(self.exe), "--serve"],
+                stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0,
+            )
+            self._buffer.clear()
+
+    def close(self) -> None:
+        if self.proc is None:
+            return
+        if self.proc.poll() is None:
+            try:
+                self._request({"cmd": "quit"}, timeout=5)
+                self.proc.wait(timeout=5)
+            except (OSError, RuntimeError, subprocess.TimeoutExpired):
+                if self.proc is not None:
+                    self.proc.kill()
+        self.proc = None
+
+    def _read(self, size: int | None, deadline: float) -> bytes:
+        """Read `size` bytes, or up to a newline if None, before `deadline`."""
+        fd = self.proc.stdout.fileno()
+        with selectors.DefaultSelector() as selector:
+            selector.register(fd, selectors.EVENT_READ)
+            while True:
+                if size is None:
+                    end = self._buffer.find(b"\n")
+                    if end >= 0:
+                        size = end + 1
+                if size is not None and len(self._buffer) >= size:
+                    data = bytes(self._buffer[:size])
+                    del self._buffer[:size]
+                    return data
+
+                remaining = deadline - time.monotonic()
+                if remaining <= 0 or not selector.select(remaining):
+                    self.proc.kill()
+                    self.proc.wait()
+                    self.proc = None
+                    raise RuntimeError("faust_render --serve: no reply in time, killed it")
+                chunk = os.read(fd, 1 << 16)
+                if not chunk:
+                    raise RuntimeError("faust_render --serve exited")
+                self._buffer += chunk
+
+    def _request(self, request: dict[str, Any], timeout: float | None = None) -> dict[str, Any]:
+        self.start()
+        self._next_id += 1
+        request = {**request, "id": self._next_id}
+        if "output" in request:
+            request["output"] = str(request["output"])
+        self.proc.stdin.write((json.dumps(request) + "\n").encode())
+        self.proc.stdin.flush()
+        self._deadline = time.monotonic() + (self.timeout if timeout is None else timeout)
+        return json.loads(self._read(None, self._deadline))
+
+    def analyze(self, module: str, **job: Any) -> dict[str, Any]:
+        """Render and return the metrics only ("ok", "peak", "rms", ...)."""
+        return self._request({"cmd": "analyze", "module": module, **job})
+
+    def render(self, module: str, **job: Any) -> tuple[dict[str, Any], np.ndarray | None]:
+        """Render and return (metrics, audio[channels, frames]); audio is None on failure."""
+        reply = self._request({"cmd": "render", "module": module, **job})
+        if not reply.get("ok"):
+            return reply, None
+        data = self._read(reply["bytes"], self._deadline)
+        audio = np.frombuffer(data, dtype=np.float32)
+        return reply, audio.reshape(-1, max(1, reply["channels"])).T
+
+    def modules(self) -> list[str]:
+        """Names of the modules faust_render can render."""
+        return self._request({"cmd": "modules"}).get("modules", [])
+
+    def params(self, module: str) -> dict[str, Any]:
+        """Parameter list ("params": [{"path", "min", "max", "init"}], "inputs", "outputs")."""
+        return self._request({"cmd": "params", "module": module})
+
+
+_shared_server: RenderServer | None = None
+
+
+def get_render_server() -> RenderServer:
+    """
+    The process-wide RenderServer, started on first use and closed at exit.
+
+    Scripts that render one job after another share it instead of spawning
+    faust_render per render. Each process (e.g. a ProcessPoolExecutor
+    worker) gets its own.
+    """
+    global _shared_server
+    if _shared_server is None:
+        _shared_server = RenderServer()
+        atexit.register(_shared_server.close)
+    return _shared_server
 
 
 # =============================================================================
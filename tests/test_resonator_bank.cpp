@@ -0,0 +1,185 @@
+// Test for ResonatorBank (SpectralResonator's band-pass bank)
+// Build: g++ -std=c++17 -O2 -I../test/mock_rack -I../src/common test_resonator_bank.cpp -o test_resonator_bank
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "ResonatorBank.hpp"
+
+using WiggleRoom::ResonatorBank;
+
+static const float SR = 48000.f;
+
+// Band i at base * spread^(i - (N - 1) / 2), inside 20 Hz .. 20 kHz
+bool testBandFrequencies(int bands, float base, float spread) {
+    ResonatorBank bank;
+    bank.setBandCount(bands);
+    bank.setSampleRate(SR);
+    bank.setChord(base, spread, 50.f);
+
+    float top = std::min(ResonatorBank::MAX_FREQ, 0.45f * SR);
+    for (int i = 0; i < bands; i++) {
+        float f = bank.bandFrequency(i);
+        float unfolded = base * std::pow(spread, i - 0.5f * (bands - 1));
+        if (f < ResonatorBank::MIN_FREQ || f > top) {
+            std::cout << "  FAIL: band " << i << " at " << f << " Hz is out of range" << std::endl;
+            return false;
+        }
+        // In range: unchanged; out of range: folded by whole octaves
+        float octaves = std::log2(unfolded / f);
+        if (std::fabs(octaves - std::round(octaves)) > 1e-3f) {
+            std::cout << "  FAIL: band " << i << " at " << f << " Hz, expected "
+                      << unfolded << " Hz folded by octaves" << std::endl;
+            return false;
+        }
+        if (unfolded >= ResonatorBank::MIN_FREQ && unfolded <= top && std::fabs(octaves) > 1e-3f) {
+            std::cout << "  FAIL: band " << i << " folded although " << unfolded
+                      << " Hz is in range" << std::endl;
+            return false;
+        }
+    }
+    // Even band count: the middle pair brackets the base frequency
+    if (bands % 2 == 0 && bands <= 6) {
+        float centre = std::sqrt(bank.bandFrequency(bands / 2 - 1) * bank.bandFrequency(bands / 2));
+        if (std::fabs(centre / base - 1.f) > 1e-4f) {
+            std::cout << "  FAIL: bank centred on " << centre << " Hz, expected " << base << std::endl;
+            return false;
+        }
+    }
+    std::cout << "  PASS" << std::endl;
+    return true;
+}
+
+// One band: the impulse rings at the band frequency, decays with time
+// constant Q / (pi f), stays on the left output, and a sine at the band
+// frequency comes out at the peak gain of gain * Q
+bool testImpulseResponse(float freq, float q) {
+    ResonatorBank bank;
+    bank.setBandCount(1);
+    bank.setSampleRate(SR);
+    bank.setChord(freq, 1.5f, q);
+
+    const int n = static_cast<int>(SR);
+    int crossings = 0;
+    float prev = 0.f;
+    float early = 0.f, late = 0.f;
+    const int window = static_cast<int>(SR / freq) * 4;
+    const int lateStart = n / 4;
+    for (int i = 0; i < n; i++) {
+        float left = 0.f, right = 0.f;
+        bank.process(i == 0 ? 1.f : 0.f, left, right);
+        if (!std::isfinite(left) || right != 0.f) {
+            std::cout << "  FAIL: sample " << i << " L=" << left << " R=" << right << std::endl;
+            return false;
+        }
+        if (i >= lateStart && i < lateStart + 4800 && (prev < 0.f) != (left < 0.f)) crossings++;
+        if (i < window) early = std::max(early, std::fabs(left));
+        if (i >= lateStart && i < lateStart + window) late = std::max(late, std::fabs(left));
+        prev = left;
+    }
+
+    // Two crossings per cycle over 0.1 s
+    float measured = crossings * 0.5f / 0.1f;
+    if (std::fabs(measured / freq - 1.f) > 0.02f) {
+        std::cout << "  FAIL: rings at " << measured << " Hz, expected " << freq << std::endl;
+        return false;
+    }
+
+    float expectedDecay = std::exp(-float(M_PI) * freq * lateStart / (q * SR));
+    float decay = late / early;
+    if (std::fabs(std::log(decay / expectedDecay)) > 0.1f) {
+        std::cout << "  FAIL: decayed to " << decay << ", expected " << expectedDecay << std::endl;
+        return false;
+    }
+
+    // Steady-state sine at the band frequency
+    bank.reset();
+    float gain = 1.f / std::max(1.f, q * 0.1f);
+    float peak = 0.f;
+    for (int i = 0; i < n; i++) {
+        float left = 0.f, right = 0.f;
+        bank.process(std::sin(2.f * float(M_PI) * freq * i / SR), left, right);
+        if (i > n / 2) peak = std::max(peak, std::fabs(left));
+    }
+    if (std::fabs(peak / (gain * q) - 1.f) > 0.02f) {
+        std::cout << "  FAIL: peak gain " << peak << ", expected " << gain * q << std::endl;
+        return false;
+    }
+
+    std::cout << "  PASS (" << measured << " Hz, decay " << decay << ", peak " << peak << ")" << std::endl;
+    return true;
+}
+
+// Even bands go left, odd bands right; a shrunk bank drops the removed bands
+bool testRoutingAndBandCount() {
+    ResonatorBank bank;
+    bank.setSampleRate(SR);
+    bank.setBandCount(2);
+    bank.setChord(440.f, 2.f, 20.f);
+
+    // A sine at band 1 (odd) is far louder on the right
+    float energyL = 0.f, energyR = 0.f;
+    float f1 = bank.bandFrequency(1);
+    for (int i = 0; i < 24000; i++) {
+        float left = 0.f, right = 0.f;
+        bank.process(std::sin(2.f * float(M_PI) * f1 * i / SR), left, right);
+        energyL += left * left;
+        energyR += right * right;
+    }
+    if (energyR < 100.f * energyL) {
+        std::cout << "  FAIL: band 1 energy L=" << energyL << " R=" << energyR << std::endl;
+        return false;
+    }
+
+    // Shrinking to one band leaves the right output silent at once
+    bank.setBandCount(1);
+    bank.setChord(440.f, 2.f, 20.f);
+    float left = 0.f, right = 0.f;
+    bank.process(0.f, left, right);
+    if (right != 0.f) {
+        std::cout << "  FAIL: removed band still rings (R=" << right << ")" << std::endl;
+        return false;
+    }
+
+    std::cout << "  PASS" << std::endl;
+    return true;
+}
+
+int main() {
+    std::cout << "=== ResonatorBank Test ===" << std::endl;
+    int passed = 0, total = 0;
+
+    std::cout << "\n1. Band frequencies, 6 bands around 440 Hz:" << std::endl;
+    if (testBandFrequencies(6, 440.f, 1.5f)) passed++;
+    total++;
+
+    std::cout << "\n2. Band frequencies, 32 wide bands (folded):" << std::endl;
+    if (testBandFrequencies(32, 440.f, 3.f)) passed++;
+    total++;
+
+    std::cout << "\n3. Band frequencies, 12 bands at the bottom of the range:" << std::endl;
+    if (testBandFrequencies(12, 30.f, 1.5f)) passed++;
+    total++;
+
+    std::cout << "\n4. Impulse response, 1 kHz, Q=50:" << std::endl;
+    if (testImpulseResponse(1000.f, 50.f)) passed++;
+    total++;
+
+    std::cout << "\n5. Impulse response, 220 Hz, Q=8:" << std::endl;
+    if (testImpulseResponse(220.f, 8.f)) passed++;
+    total++;
+
+    std::cout << "\n6. Left/right routing and band count changes:" << std::endl;
+    if (testRoutingAndBandCount()) passed++;
+    total++;
+
+    std::cout << "\n=== Results: " << passed << "/" << total << " tests passed ===" << std::endl;
+
+    if (passed == total) {
+        std::cout << "\nSUCCESS: ResonatorBank is working correctly!" << std::endl;
+        return 0;
+    } else {
+        std::cout << "\nFAILURE: Some ResonatorBank checks failed." << std::endl;
+        return 1;
+    }
+}